@@ -0,0 +1,209 @@
+/**
+ * async_latency.cpp
+ * Demonstrates co_await on kernel calls from a request loop: latency of
+ * small and large requests under a mixed load, handled synchronously and
+ * as coroutines on the scheduler pool
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stop_token>
+#include <vector>
+#include "../include/simd_async.hpp"
+#include "../include/simd_ops.h"
+#include "../include/perf_test.h"
+
+using clock_type = std::chrono::steady_clock;
+
+// Fire-and-forget coroutine: starts at once, frees itself when it returns
+struct detached {
+    struct promise_type {
+        detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+struct workload {
+    int width;
+    int height;
+    int requests;
+    int interval_us;            // Between request arrivals
+    int large_every;            // Every Nth request converts a full frame
+    int drop_every;             // Every Nth large request is abandoned by its client
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> gray[16];
+    std::vector<float> a, b;
+};
+
+struct results {
+    std::vector<uint64_t> latency_ns;
+    std::vector<float> dots;
+    std::atomic<int> finished{ 0 };
+    std::atomic<int> cancelled{ 0 };
+};
+
+static bool is_large(const workload& w, int i) { return i % w.large_every == 0; }
+
+// One request: a gray conversion of the frame, or a 1024-element dot product
+static detached handle(workload& w, results& r, int i, clock_type::time_point arrival, std::stop_token stop) {
+    try {
+        if (is_large(w, i)) {
+            size_t pixels = (size_t)w.width * w.height;
+            simd::options frame{ .bytes = pixels * 4, .stop = stop };
+            co_await simd::async(frame, simd_rgb_to_gray, w.frame.data(), w.gray[(i / w.large_every) % 16].data(),
+                                 pixels);
+        } else {
+            simd::options dot{ .bytes = w.a.size() * 8 };
+            r.dots[i] = co_await simd::async(dot, simd_dot_product_f32, w.a.data(), w.b.data(), w.a.size());
+        }
+        r.latency_ns[i] = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - arrival).count();
+    } catch (const simd::cancelled&) {
+        r.cancelled.fetch_add(1);
+    }
+    r.finished.fetch_add(1, std::memory_order_release);
+}
+
+static void wait_until(clock_type::time_point t) {
+    while (clock_type::now() < t) {
+    }
+}
+
+// Synchronous handling: every request blocks the loop until its kernel returns
+static void run_sync(workload& w, results& r) {
+    auto start = clock_type::now();
+    for (int i = 0; i < w.requests; i++) {
+        auto arrival = start + std::chrono::microseconds((int64_t)i * w.interval_us);
+        wait_until(arrival);
+        if (is_large(w, i)) {
+            simd_rgb_to_gray(w.frame.data(), w.gray[(i / w.large_every) % 16].data(), (size_t)w.width * w.height);
+        } else {
+            r.dots[i] = simd_dot_product_f32(w.a.data(), w.b.data(), w.a.size());
+        }
+        r.latency_ns[i] = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - arrival).count();
+        r.finished.fetch_add(1);
+    }
+}
+
+// Coroutine handling: the loop only submits, completions resume on workers
+static void run_async(workload& w, results& r) {
+    std::vector<std::stop_source> clients((size_t)w.requests);
+    auto start = clock_type::now();
+    for (int i = 0; i < w.requests; i++) {
+        auto arrival = start + std::chrono::microseconds((int64_t)i * w.interval_us);
+        wait_until(arrival);
+        handle(w, r, i, arrival, clients[i].get_token());
+        if (is_large(w, i) && (i / w.large_every) % w.drop_every == w.drop_every - 1) clients[i].request_stop();
+    }
+    while (r.finished.load(std::memory_order_acquire) < w.requests) {
+    }
+}
+
+static void print_histogram(const char* name, const results& r, const workload& w, bool large) {
+    uint64_t buckets[SIMD_ASYNC_LATENCY_BUCKETS] = {};
+    std::vector<uint64_t> sorted;
+    for (int i = 0; i < w.requests; i++) {
+        if (is_large(w, i) != large || r.latency_ns[i] == 0) continue;
+        buckets[simd_async_latency_bucket(r.latency_ns[i])]++;
+        sorted.push_back(r.latency_ns[i]);
+    }
+    if (sorted.empty()) return;
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](double p) { return sorted[(size_t)(p * (double)(sorted.size() - 1))] / 1000.0; };
+    printf("\n%s, %s requests (%zu): p50 %.1f us, p99 %.1f us, max %.1f us\n", name, large ? "large" : "small",
+           sorted.size(), pct(0.5), pct(0.99), sorted.back() / 1000.0);
+
+    int last = SIMD_ASYNC_LATENCY_BUCKETS - 1;
+    while (last > 0 && buckets[last] == 0) last--;
+    for (int b = 0; b <= last; b++) {
+        int bar = (int)(50 * buckets[b] / sorted.size());
+        printf("  %8llu us %-8llu %.*s\n", b == 0 ? 0ull : 1ull << b, (unsigned long long)buckets[b], bar,
+               "##################################################");
+    }
+}
+
+int main(int argc, char** argv) {
+    // Default load: 2000 requests, one every 100 us, every 20th a 720p frame
+    workload w;
+    w.width = 1280;
+    w.requests = 2000;
+    w.interval_us = 100;
+    w.large_every = 20;
+    w.drop_every = 10;
+
+    // Allow overriding the frame width from command line (height keeps 16:9)
+    if (argc > 1) {
+        w.width = atoi(argv[1]);
+        if (w.width < 64) {
+            w.width = 1280;
+        }
+    }
+    w.height = w.width * 9 / 16;
+
+    printf("Async Latency Example\n");
+    printf("---------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    size_t pixels = (size_t)w.width * w.height;
+    w.frame.resize(pixels * 3);
+    fill_random_uint8(w.frame.data(), w.frame.size());
+    for (auto& g : w.gray) g.resize(pixels);
+    w.a.resize(1024);
+    w.b.resize(1024);
+    fill_random_float(w.a.data(), w.a.size(), -1.0f, 1.0f);
+    fill_random_float(w.b.data(), w.b.size(), -1.0f, 1.0f);
+
+    printf("\n%d requests every %d us; every %d converts a %dx%d frame, the rest are 1024-element dot products\n",
+           w.requests, w.interval_us, w.large_every, w.width, w.height);
+    printf("Pool workers: %d\n", simd_sched_workers());
+
+    results sync, async;
+    for (results* r : { &sync, &async }) {
+        r->latency_ns.assign((size_t)w.requests, 0);
+        r->dots.assign((size_t)w.requests, 0.0f);
+    }
+
+    run_sync(w, sync);
+    std::vector<uint8_t> expected = w.gray[0];
+
+    simd_async_reset_stats();
+    run_async(w, async);
+    simd_async_stats_t stats;
+    simd_async_get_stats(&stats);
+
+    int errors = 0;
+    for (int i = 0; i < w.requests; i++) {
+        if (!is_large(w, i) && async.dots[i] != sync.dots[i]) errors++;
+    }
+    errors += memcmp(w.gray[0].data(), expected.data(), pixels) != 0;
+
+    print_histogram("Synchronous", sync, w, false);
+    print_histogram("Coroutines", async, w, false);
+    print_histogram("Synchronous", sync, w, true);
+    print_histogram("Coroutines", async, w, true);
+
+    printf("\nCoroutines: %llu calls in %llu dispatches (%llu batched), %d abandoned requests cancelled\n",
+           (unsigned long long)stats.completed, (unsigned long long)stats.dispatches,
+           (unsigned long long)stats.batched, async.cancelled.load());
+    printf("Small requests no longer wait behind frame conversions once the pool has workers.\n");
+
+    simd_sched_shutdown();
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
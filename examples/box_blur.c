@@ -10,6 +10,7 @@
 #include <arm_neon.h>
 #include "../include/platform_detect.h"
 #include "../include/neon_utils.h"
+#include "../include/simd_io.h"
 #include "../include/perf_test.h"
 
 // Scalar (non-SIMD) implementation for comparison
@@ -112,19 +113,10 @@ void generate_test_image(uint8_t* gray, int width, int height) {
 
 // Function to save a grayscale image as PGM (for visualization)
 void save_pgm(const char* filename, const uint8_t* gray, int width, int height) {
-    FILE* file = fopen(filename, "wb");
-    if (!file) {
-        printf("ERROR: Could not open file %s for writing.\n", filename);
-        return;
+    simd_image_t image = simd_image_packed((void*)gray, width, height, 1, 1);
+    if (!simd_pnm_write(filename, &image)) {
+        printf("ERROR: Could not write file %s.\n", filename);
     }
-    
-    // Write PGM header
-    fprintf(file, "P5\n%d %d\n255\n", width, height);
-    
-    // Write image data
-    fwrite(gray, 1, width * height, file);
-    
-    fclose(file);
 }
 
 // Main function
@@ -0,0 +1,184 @@
+/**
+ * canny_edge.c
+ * Demonstrates Canny edge detection using NEON and band-parallel threads
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include "../include/simd_canny.h"
+#include "../include/simd_parallel.h"
+#include "../include/perf_test.h"
+
+// Previous pipeline: NEON gradient followed by scalar suppression and a
+// scalar stack-based hysteresis on a byte state map
+void scalar_nms_hysteresis(const uint8_t* src, uint8_t* out, int width, int height,
+                           uint16_t low, uint16_t high, uint16_t* mag, uint8_t* dir, int* stack) {
+    static const int offsets[4][4] = {
+        { -1, 0, 1, 0 }, { -1, -1, 1, 1 }, { 0, -1, 0, 1 }, { 1, -1, -1, 1 }
+    };
+    int top = 0;
+
+    simd_gradient(src, width, height, SIMD_GRADIENT_SOBEL, SIMD_BORDER_REPLICATE, 0,
+                  NULL, NULL, mag, SIMD_MAGNITUDE_L1, dir, 4);
+
+    // out doubles as the state map: 0 = none, 1 = candidate, 255 = edge
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int* o = offsets[dir[y * width + x]];
+            int bx = x + o[0], by = y + o[1], ax = x + o[2], ay = y + o[3];
+            int before = (bx < 0 || bx >= width || by < 0 || by >= height) ? 0 : mag[by * width + bx];
+            int after = (ax < 0 || ax >= width || ay < 0 || ay >= height) ? 0 : mag[ay * width + ax];
+            int m = mag[y * width + x];
+            uint8_t state = 0;
+            if (m > before && m >= after && m > low) {
+                state = m > high ? 255 : 1;
+                if (m > high) stack[top++] = y * width + x;
+            }
+            out[y * width + x] = state;
+        }
+    }
+
+    while (top > 0) {
+        int p = stack[--top];
+        int x = p % width, y = p / width;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = x + dx, ny = y + dy;
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                if (out[ny * width + nx] == 1) {
+                    out[ny * width + nx] = 255;
+                    stack[top++] = ny * width + nx;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < width * height; i++) {
+        if (out[i] == 1) out[i] = 0;
+    }
+}
+
+// Synthetic frame: concentric circles plus noise
+static void generate_frame(uint8_t* img, int width, int height) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int dx = x - width / 2;
+            int dy = y - height / 2;
+            int dist = (int)sqrt((double)(dx * dx + dy * dy));
+            int val = (dist % 48 < 24) ? 190 : 50;
+            img[y * width + x] = (uint8_t)(val + rand() % 30);
+        }
+    }
+}
+
+static double fps(const perf_timer_t* timer, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return iterations * 1e6 / (double)timer->total_time;
+}
+
+// Benchmark one resolution; returns the number of mismatching pixels
+static int benchmark_resolution(int width, int height, int iterations) {
+    size_t pixels = (size_t)width * height;
+    uint8_t* src = (uint8_t*)neon_malloc(pixels);
+    uint8_t* out_simd = (uint8_t*)neon_malloc(pixels);
+    uint8_t* out_ref = (uint8_t*)neon_malloc(pixels);
+    uint16_t* mag = (uint16_t*)neon_malloc(pixels * sizeof(uint16_t));
+    uint8_t* dir = (uint8_t*)neon_malloc(pixels);
+    int* stack = (int*)malloc(pixels * sizeof(int));
+
+    if (!src || !out_simd || !out_ref || !mag || !dir || !stack) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    generate_frame(src, width, height);
+    const uint16_t low = 150;
+    const uint16_t high = 400;
+
+    printf("\n%dx%d\n", width, height);
+    printf("%-34s %-10s %-10s\n", "Pipeline", "ms/frame", "fps");
+    printf("------------------------------------------------------\n");
+
+    perf_timer_t* timer = timer_create("scalar");
+    timer_start(timer);
+    for (int i = 0; i < iterations; i++) {
+        scalar_nms_hysteresis(src, out_ref, width, height, low, high, mag, dir, stack);
+    }
+    timer_stop(timer);
+    printf("%-34s %-10.2f %-10.1f\n", "NEON gradient + scalar NMS/hyst.",
+           timer->total_time / 1000.0 / iterations, fps(timer, iterations));
+    timer_destroy(timer);
+
+    int cpus = simd_parallel_cpu_count();
+    int thread_counts[3] = { 1, 2, cpus };
+    int runs = cpus > 2 ? 3 : (cpus == 2 ? 2 : 1);
+    int errors = 0;
+
+    for (int r = 0; r < runs; r++) {
+        timer = timer_create("simd_canny");
+        timer_start(timer);
+        for (int i = 0; i < iterations; i++) {
+            simd_canny(src, out_simd, width, height, low, high, SIMD_MAGNITUDE_L1, thread_counts[r]);
+        }
+        timer_stop(timer);
+
+        char label[64];
+        snprintf(label, sizeof(label), "simd_canny, %d thread%s", thread_counts[r], thread_counts[r] > 1 ? "s" : "");
+        printf("%-34s %-10.2f %-10.1f\n", label, timer->total_time / 1000.0 / iterations, fps(timer, iterations));
+        timer_destroy(timer);
+
+        for (size_t i = 0; i < pixels; i++) {
+            if (out_simd[i] != out_ref[i]) errors++;
+        }
+    }
+
+    size_t edges = 0;
+    for (size_t i = 0; i < pixels; i++) edges += out_simd[i] != 0;
+    printf("Edge pixels: %zu, mismatches: %d\n", edges, errors);
+
+    free(src);
+    free(out_simd);
+    free(out_ref);
+    free(mag);
+    free(dir);
+    free(stack);
+    return errors;
+}
+
+int main(int argc, char** argv) {
+    // Frames per measurement
+    int iterations = 10;
+
+    // Allow overriding the iteration count from command line
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            iterations = 10;
+        }
+    }
+
+    srand(42);  // Fixed seed for reproducibility
+
+    printf("Canny Edge Detection Example\n");
+    printf("----------------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+    printf("Online CPUs: %d\n", simd_parallel_cpu_count());
+
+    int errors = 0;
+    errors += benchmark_resolution(1920, 1080, iterations);
+    errors += benchmark_resolution(3840, 2160, iterations);
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+    return errors ? 1 : 0;
+}
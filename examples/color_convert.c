@@ -0,0 +1,182 @@
+/**
+ * color_convert.c
+ * Demonstrates color-space conversion throughput (RGB/BGRA, NV12/I420, HSV) using NEON
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_color.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementations for comparison, in floating point
+void scalar_rgb_to_i420(const uint8_t* rgb, int width, int height, uint8_t* y, uint8_t* u, uint8_t* v) {
+    int cw = (width + 1) / 2;
+    for (int row = 0; row < height; row++) {
+        for (int x = 0; x < width; x++) {
+            const uint8_t* p = rgb + ((size_t)row * width + x) * 3;
+            float yf = 0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2];
+            y[(size_t)row * width + x] = (uint8_t)lrintf(16.0f + yf * (219.0f / 255.0f));
+            if ((row & 1) == 0 && (x & 1) == 0) {
+                float cb = (p[2] - yf) / 1.772f;
+                float cr = (p[0] - yf) / 1.402f;
+                u[(size_t)(row / 2) * cw + x / 2] = (uint8_t)lrintf(128.0f + cb * (224.0f / 255.0f));
+                v[(size_t)(row / 2) * cw + x / 2] = (uint8_t)lrintf(128.0f + cr * (224.0f / 255.0f));
+            }
+        }
+    }
+}
+
+static uint8_t clamp_u8(float x) {
+    return x < 0.0f ? 0 : (x > 255.0f ? 255 : (uint8_t)lrintf(x));
+}
+
+void scalar_nv12_to_rgba(const uint8_t* y, const uint8_t* uv, uint8_t* rgba, int width, int height) {
+    int cw = (width + 1) / 2;
+    for (int row = 0; row < height; row++) {
+        for (int x = 0; x < width; x++) {
+            const uint8_t* c = uv + ((size_t)(row / 2) * cw + x / 2) * 2;
+            float yf = (y[(size_t)row * width + x] - 16) * (255.0f / 219.0f);
+            float cb = (c[0] - 128) * (255.0f / 224.0f);
+            float cr = (c[1] - 128) * (255.0f / 224.0f);
+            uint8_t* p = rgba + ((size_t)row * width + x) * 4;
+            p[0] = clamp_u8(yf + 1.402f * cr);
+            p[1] = clamp_u8(yf - 0.344136f * cb - 0.714136f * cr);
+            p[2] = clamp_u8(yf + 1.772f * cb);
+            p[3] = 255;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    // Default number of iterations per conversion
+    int iterations = 10;
+
+    // Allow overriding iteration count from command line
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            iterations = 10;
+        }
+    }
+
+    printf("Color Conversion Example\n");
+    printf("------------------------\n");
+    printf("Iterations: %d\n", iterations);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    static const int sizes[2][2] = { { 1920, 1080 }, { 3840, 2160 } };
+    static const char* size_names[2] = { "1080p", "4K" };
+
+    for (int s = 0; s < 2; s++) {
+        int width = sizes[s][0];
+        int height = sizes[s][1];
+        size_t pixels = (size_t)width * height;
+        size_t chroma = (size_t)((width + 1) / 2) * ((height + 1) / 2);
+
+        uint8_t* rgb = (uint8_t*)neon_malloc(pixels * 3);
+        uint8_t* bgra = (uint8_t*)neon_malloc(pixels * 4);
+        uint8_t* out = (uint8_t*)neon_malloc(pixels * 4);
+        uint8_t* y = (uint8_t*)neon_malloc(pixels);
+        uint8_t* u = (uint8_t*)neon_malloc(chroma);
+        uint8_t* v = (uint8_t*)neon_malloc(chroma);
+        uint8_t* uv = (uint8_t*)neon_malloc(chroma * 2);
+
+        if (!rgb || !bgra || !out || !y || !u || !v || !uv) {
+            printf("ERROR: Memory allocation failed.\n");
+            return 1;
+        }
+
+        fill_random_uint8(rgb, pixels * 3);
+        simd_convert_pixels(rgb, SIMD_PIXEL_RGB, bgra, SIMD_PIXEL_BGRA, pixels);
+        simd_rgb_to_nv12(rgb, SIMD_PIXEL_RGB, width, height, y, uv, SIMD_YUV_BT601, SIMD_YUV_LIMITED);
+
+        printf("\n%s (%dx%d)\n", size_names[s], width, height);
+        printf("%-28s %-12s %-10s\n", "Conversion", "Mpixel/s", "fps");
+        printf("----------------------------------------------------\n");
+
+        for (int kernel = 0; kernel < 10; kernel++) {
+            const char* name = "";
+            perf_timer_t* timer = timer_create("Color");
+
+            timer_start(timer);
+            for (int i = 0; i < iterations; i++) {
+                switch (kernel) {
+                    case 0:
+                        name = "BGRA -> RGB";
+                        simd_convert_pixels(bgra, SIMD_PIXEL_BGRA, out, SIMD_PIXEL_RGB, pixels);
+                        break;
+                    case 1:
+                        name = "BGRA -> gray";
+                        simd_convert_to_gray(bgra, SIMD_PIXEL_BGRA, out, pixels);
+                        break;
+                    case 2:
+                        name = "RGB -> I420 (601 limited)";
+                        simd_rgb_to_i420(rgb, SIMD_PIXEL_RGB, width, height, y, u, v,
+                                         SIMD_YUV_BT601, SIMD_YUV_LIMITED);
+                        break;
+                    case 3:
+                        name = "  scalar float";
+                        scalar_rgb_to_i420(rgb, width, height, y, u, v);
+                        break;
+                    case 4:
+                        name = "BGRA -> NV12 (709 full)";
+                        simd_rgb_to_nv12(bgra, SIMD_PIXEL_BGRA, width, height, y, uv,
+                                         SIMD_YUV_BT709, SIMD_YUV_FULL);
+                        break;
+                    case 5:
+                        name = "NV12 -> RGBA (601 limited)";
+                        simd_nv12_to_rgb(y, uv, out, SIMD_PIXEL_RGBA, width, height,
+                                         SIMD_YUV_BT601, SIMD_YUV_LIMITED);
+                        break;
+                    case 6:
+                        name = "  scalar float";
+                        scalar_nv12_to_rgba(y, uv, out, width, height);
+                        break;
+                    case 7:
+                        name = "I420 -> BGR (709 full)";
+                        simd_i420_to_rgb(y, u, v, out, SIMD_PIXEL_BGR, width, height,
+                                         SIMD_YUV_BT709, SIMD_YUV_FULL);
+                        break;
+                    case 8:
+                        name = "RGB -> HSV";
+                        simd_rgb_to_hsv(rgb, SIMD_PIXEL_RGB, out, pixels);
+                        break;
+                    default:
+                        name = "HSV -> RGB";
+                        simd_hsv_to_rgb(rgb, out, SIMD_PIXEL_RGB, pixels);
+                        break;
+                }
+            }
+            timer_stop(timer);
+
+            double seconds = timer->total_time / 1e6;
+            double mpix = seconds > 0.0 ? (double)pixels * iterations / (seconds * 1e6) : 0.0;
+            double fps = seconds > 0.0 ? iterations / seconds : 0.0;
+            printf("%-28s %-12.1f %-10.1f\n", name, mpix, fps);
+
+            timer_destroy(timer);
+        }
+
+        free(rgb);
+        free(bgra);
+        free(out);
+        free(y);
+        free(u);
+        free(v);
+        free(uv);
+    }
+
+    return 0;
+}
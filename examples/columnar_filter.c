@@ -0,0 +1,138 @@
+/**
+ * columnar_filter.c
+ * Demonstrates a vectorized predicate engine over columns using NEON bitmaps
+ *
+ * Query: (price > 50.0 AND quantity < 100) OR category == 3
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_bitmap.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementation for comparison: evaluate row by row
+size_t scalar_query(const float* price, const int32_t* quantity, const uint8_t* category,
+                    uint32_t* rows, size_t len) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        if ((price[i] > 50.0f && quantity[i] < 100) || category[i] == 3) {
+            rows[count++] = (uint32_t)i;
+        }
+    }
+    return count;
+}
+
+// NEON implementation: one bitmap per predicate, combined with bitwise algebra
+size_t bitmap_query(const float* price, const int32_t* quantity, const uint8_t* category,
+                    simd_bitmap_t* p0, simd_bitmap_t* p1, simd_bitmap_t* p2,
+                    uint32_t* rows) {
+    simd_bitmap_cmp_f32(p0, price, SIMD_CMP_GT, 50.0f);
+    simd_bitmap_cmp_s32(p1, quantity, SIMD_CMP_LT, 100);
+    simd_bitmap_cmp_u8(p2, category, SIMD_CMP_EQ, 3);
+
+    simd_bitmap_and(p0, p0, p1);
+    simd_bitmap_or(p0, p0, p2);
+
+    return simd_bitmap_to_indices(p0, rows);
+}
+
+int main(int argc, char** argv) {
+    // Default number of rows
+    size_t row_count = 4 * 1024 * 1024;
+
+    // Allow overriding row count from command line
+    if (argc > 1) {
+        row_count = atoi(argv[1]);
+        if (row_count <= 0) {
+            row_count = 4 * 1024 * 1024;
+        }
+    }
+
+    printf("Columnar Filter Example\n");
+    printf("----------------------\n");
+    printf("Rows: %zu\n", row_count);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    // Allocate columns and outputs
+    float* price = (float*)neon_malloc(row_count * sizeof(float));
+    int32_t* quantity = (int32_t*)neon_malloc(row_count * sizeof(int32_t));
+    uint8_t* category = (uint8_t*)neon_malloc(row_count);
+    uint32_t* rows_simd = (uint32_t*)neon_malloc(row_count * sizeof(uint32_t));
+    uint32_t* rows_scalar = (uint32_t*)neon_malloc(row_count * sizeof(uint32_t));
+    simd_bitmap_t* p0 = simd_bitmap_create(row_count);
+    simd_bitmap_t* p1 = simd_bitmap_create(row_count);
+    simd_bitmap_t* p2 = simd_bitmap_create(row_count);
+
+    if (!price || !quantity || !category || !rows_simd || !rows_scalar || !p0 || !p1 || !p2) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    // Generate random columns
+    srand(42);
+    fill_random_float(price, row_count, 0.0f, 100.0f);
+    fill_random_int32(quantity, row_count, 0, 200);
+    for (size_t i = 0; i < row_count; i++) {
+        category[i] = (uint8_t)(rand() % 16);
+    }
+
+    // Create comparison timer
+    perf_comparison_t* comp = comparison_create("Columnar Filter");
+
+    // Number of iterations for more accurate timing
+    const int iterations = 10;
+    size_t simd_count = 0;
+    size_t scalar_count = 0;
+
+    // Evaluate the query using bitmaps
+    timer_start(comp->simd_timer);
+    for (int i = 0; i < iterations; i++) {
+        simd_count = bitmap_query(price, quantity, category, p0, p1, p2, rows_simd);
+    }
+    timer_stop(comp->simd_timer);
+
+    // Evaluate the query using scalar code
+    timer_start(comp->scalar_timer);
+    for (int i = 0; i < iterations; i++) {
+        scalar_count = scalar_query(price, quantity, category, rows_scalar, row_count);
+    }
+    timer_stop(comp->scalar_timer);
+
+    // Verify results
+    int errors = simd_count != scalar_count;
+    for (size_t i = 0; !errors && i < simd_count; i++) {
+        if (rows_simd[i] != rows_scalar[i]) errors++;
+    }
+
+    printf("Selected rows: %zu (%.2f%%)\n", simd_count, 100.0 * simd_count / row_count);
+    printf("Predicate storage: %zu bytes per bitmap vs %zu bytes per uint32 mask\n",
+           p0->word_count * sizeof(uint64_t), row_count * sizeof(uint32_t));
+    printf("Verification: %s\n", errors ? "FAILED" : "OK");
+
+    // Print performance comparison
+    comparison_print(comp);
+
+    // Clean up
+    free(price);
+    free(quantity);
+    free(category);
+    free(rows_simd);
+    free(rows_scalar);
+    simd_bitmap_destroy(p0);
+    simd_bitmap_destroy(p1);
+    simd_bitmap_destroy(p2);
+    comparison_destroy(comp);
+
+    return errors ? 1 : 0;
+}
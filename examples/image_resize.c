@@ -0,0 +1,205 @@
+/**
+ * image_resize.c
+ * Demonstrates image resizing and Gaussian pyramids using NEON
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include "../include/simd_resize.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementations for comparison
+void scalar_resize_bilinear(const uint8_t* src, uint8_t* dst, int sw, int sh, int dw, int dh, int channels) {
+    float scale_x = (float)sw / dw;
+    float scale_y = (float)sh / dh;
+
+    for (int y = 0; y < dh; y++) {
+        float sy = (y + 0.5f) * scale_y - 0.5f;
+        if (sy < 0.0f) sy = 0.0f;
+        int y0 = (int)sy;
+        if (y0 > sh - 1) y0 = sh - 1;
+        int y1 = y0 + 1 < sh ? y0 + 1 : y0;
+        float fy = sy - y0;
+
+        for (int x = 0; x < dw; x++) {
+            float sx = (x + 0.5f) * scale_x - 0.5f;
+            if (sx < 0.0f) sx = 0.0f;
+            int x0 = (int)sx;
+            if (x0 > sw - 1) x0 = sw - 1;
+            int x1 = x0 + 1 < sw ? x0 + 1 : x0;
+            float fx = sx - x0;
+
+            for (int c = 0; c < channels; c++) {
+                float p00 = src[((size_t)y0 * sw + x0) * channels + c];
+                float p01 = src[((size_t)y0 * sw + x1) * channels + c];
+                float p10 = src[((size_t)y1 * sw + x0) * channels + c];
+                float p11 = src[((size_t)y1 * sw + x1) * channels + c];
+                float top = p00 + (p01 - p00) * fx;
+                float bottom = p10 + (p11 - p10) * fx;
+                dst[((size_t)y * dw + x) * channels + c] = (uint8_t)(top + (bottom - top) * fy + 0.5f);
+            }
+        }
+    }
+}
+
+void scalar_downsample2x(const uint8_t* src, uint8_t* dst, int width, int height, int channels) {
+    int dw = width / 2, dh = height / 2;
+    for (int y = 0; y < dh; y++) {
+        const uint8_t* r0 = src + (size_t)(2 * y) * width * channels;
+        const uint8_t* r1 = r0 + (size_t)width * channels;
+        for (int x = 0; x < dw; x++) {
+            for (int c = 0; c < channels; c++) {
+                int a = 2 * x * channels + c;
+                int b = a + channels;
+                dst[((size_t)y * dw + x) * channels + c] = (uint8_t)((r0[a] + r0[b] + r1[a] + r1[b] + 2) >> 2);
+            }
+        }
+    }
+}
+
+static double ms_per_frame(const perf_timer_t* timer, int iterations) {
+    return (double)timer->total_time / iterations / 1000.0;
+}
+
+int main(int argc, char** argv) {
+    // Default source dimensions (4K UHD)
+    int width = 3840;
+    int height = 2160;
+
+    // Allow overriding source width from command line (height keeps 16:9)
+    if (argc > 1) {
+        width = atoi(argv[1]);
+        if (width < 64) {
+            width = 3840;
+        }
+        height = width * 9 / 16;
+    }
+
+    printf("Image Resize Example\n");
+    printf("--------------------\n");
+    printf("Source: %dx%d\n", width, height);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    static const int channel_counts[] = { 1, 3, 4 };
+    static const char* channel_names[] = { "Gray", "RGB", "RGBA" };
+    // Output heights of the standard video ladder, scaled with the source
+    static const int targets[] = { 1080, 720, 360 };
+
+    size_t max_bytes = (size_t)width * height * 4;
+    uint8_t* src = (uint8_t*)neon_malloc(max_bytes);
+    // pyrUp of an odd-sized level can be one row and column larger
+    uint8_t* dst = (uint8_t*)neon_malloc((size_t)(width + 1) * (height + 1) * 4);
+    uint8_t* ref = (uint8_t*)neon_malloc(max_bytes);
+    uint8_t* pyr = (uint8_t*)neon_malloc(max_bytes);
+
+    if (!src || !dst || !ref || !pyr) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    fill_random_uint8(src, max_bytes);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 5;
+    int errors = 0;
+
+    printf("\n%-6s %-11s %-12s %-12s %-12s %-10s\n", "Format", "Target", "Scalar ms", "Bilinear ms", "Area ms", "Speedup");
+    printf("---------------------------------------------------------------------\n");
+
+    for (int k = 0; k < 3; k++) {
+        int ch = channel_counts[k];
+
+        for (int t = 0; t < 3; t++) {
+            int dh = (int)((long)targets[t] * height / 2160);
+            int dw = (int)((long)dh * width / height);
+            if (dw <= 0 || dh <= 0) continue;
+            size_t out_bytes = (size_t)dw * dh * ch;
+
+            perf_comparison_t* comp = comparison_create("Bilinear");
+            timer_start(comp->scalar_timer);
+            for (int i = 0; i < iterations; i++) scalar_resize_bilinear(src, ref, width, height, dw, dh, ch);
+            timer_stop(comp->scalar_timer);
+
+            timer_start(comp->simd_timer);
+            for (int i = 0; i < iterations; i++) simd_resize_u8(src, dst, width, height, dw, dh, ch, SIMD_RESIZE_BILINEAR);
+            timer_stop(comp->simd_timer);
+
+            // Fixed-point weights stay within 2 levels of the float result
+            for (size_t i = 0; i < out_bytes; i++) {
+                if (abs((int)dst[i] - (int)ref[i]) > 2) {
+                    errors++;
+                    break;
+                }
+            }
+
+            perf_timer_t* area_timer = timer_create("Area");
+            timer_start(area_timer);
+            for (int i = 0; i < iterations; i++) simd_resize_u8(src, dst, width, height, dw, dh, ch, SIMD_RESIZE_AREA);
+            timer_stop(area_timer);
+
+            char target[24];
+            snprintf(target, sizeof(target), "%dx%d", dw, dh);
+            double scalar_ms = ms_per_frame(comp->scalar_timer, iterations);
+            double simd_ms = ms_per_frame(comp->simd_timer, iterations);
+            printf("%-6s %-11s %-12.2f %-12.2f %-12.2f %.2fx\n", channel_names[k], target, scalar_ms, simd_ms,
+                   ms_per_frame(area_timer, iterations), simd_ms > 0.0 ? scalar_ms / simd_ms : 0.0);
+
+            timer_destroy(area_timer);
+            comparison_destroy(comp);
+        }
+    }
+
+    // 2x box reduction and pyramid levels on RGBA frames
+    printf("\n%-22s %-12s %-12s %-10s\n", "RGBA 2x kernels", "Scalar ms", "NEON ms", "Speedup");
+    printf("--------------------------------------------------------\n");
+
+    perf_comparison_t* comp = comparison_create("Downsample 2x");
+    timer_start(comp->scalar_timer);
+    for (int i = 0; i < iterations; i++) scalar_downsample2x(src, ref, width, height, 4);
+    timer_stop(comp->scalar_timer);
+    timer_start(comp->simd_timer);
+    for (int i = 0; i < iterations; i++) simd_downsample2x_u8(src, dst, width, height, 4);
+    timer_stop(comp->simd_timer);
+    if (memcmp(dst, ref, (size_t)(width / 2) * (height / 2) * 4) != 0) errors++;
+    double scalar_ms = ms_per_frame(comp->scalar_timer, iterations);
+    double simd_ms = ms_per_frame(comp->simd_timer, iterations);
+    printf("%-22s %-12.2f %-12.2f %.2fx\n", "Box downsample 2x", scalar_ms, simd_ms,
+           simd_ms > 0.0 ? scalar_ms / simd_ms : 0.0);
+    comparison_destroy(comp);
+
+    perf_timer_t* timer = timer_create("pyrDown");
+    timer_start(timer);
+    for (int i = 0; i < iterations; i++) simd_pyr_down_u8(src, pyr, width, height, 4);
+    timer_stop(timer);
+    printf("%-22s %-12s %-12.2f\n", "pyrDown", "-", ms_per_frame(timer, iterations));
+    timer_destroy(timer);
+
+    int half_w = (width + 1) / 2, half_h = (height + 1) / 2;
+    timer = timer_create("pyrUp");
+    timer_start(timer);
+    for (int i = 0; i < iterations; i++) simd_pyr_up_u8(pyr, dst, half_w, half_h, 4);
+    timer_stop(timer);
+    printf("%-22s %-12s %-12.2f\n", "pyrUp", "-", ms_per_frame(timer, iterations));
+    timer_destroy(timer);
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    // Clean up
+    free(src);
+    free(dst);
+    free(ref);
+    free(pyr);
+
+    return errors ? 1 : 0;
+}
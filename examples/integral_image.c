@@ -0,0 +1,207 @@
+/**
+ * integral_image.c
+ * Demonstrates integral images (summed-area tables) using NEON
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include "../include/simd_integral.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementations for comparison
+void scalar_integral_u8(const uint8_t* src, uint32_t* sum, uint64_t* sqsum, int width, int height) {
+    size_t stride = (size_t)width + 1;
+    memset(sum, 0, stride * sizeof(uint32_t));
+    if (sqsum) memset(sqsum, 0, stride * sizeof(uint64_t));
+
+    for (int y = 0; y < height; y++) {
+        uint32_t run = 0;
+        uint64_t sq_run = 0;
+        sum[(y + 1) * stride] = 0;
+        if (sqsum) sqsum[(y + 1) * stride] = 0;
+        for (int x = 0; x < width; x++) {
+            uint8_t v = src[y * width + x];
+            run += v;
+            sum[(y + 1) * stride + x + 1] = run + sum[y * stride + x + 1];
+            if (sqsum) {
+                sq_run += (uint32_t)v * v;
+                sqsum[(y + 1) * stride + x + 1] = sq_run + sqsum[y * stride + x + 1];
+            }
+        }
+    }
+}
+
+void scalar_integral_f32(const float* src, double* sum, double* sqsum, int width, int height) {
+    size_t stride = (size_t)width + 1;
+    memset(sum, 0, stride * sizeof(double));
+    if (sqsum) memset(sqsum, 0, stride * sizeof(double));
+
+    for (int y = 0; y < height; y++) {
+        double run = 0.0;
+        double sq_run = 0.0;
+        sum[(y + 1) * stride] = 0.0;
+        if (sqsum) sqsum[(y + 1) * stride] = 0.0;
+        for (int x = 0; x < width; x++) {
+            double v = src[y * width + x];
+            run += v;
+            sum[(y + 1) * stride + x + 1] = run + sum[y * stride + x + 1];
+            if (sqsum) {
+                sq_run += v * v;
+                sqsum[(y + 1) * stride + x + 1] = sq_run + sqsum[y * stride + x + 1];
+            }
+        }
+    }
+}
+
+static double mpix_per_s(const perf_timer_t* timer, size_t pixels, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)pixels * iterations / (double)timer->total_time;
+}
+
+static void print_row(const char* name, perf_comparison_t* comp, size_t pixels, int iterations) {
+    double scalar_rate = mpix_per_s(comp->scalar_timer, pixels, iterations);
+    double simd_rate = mpix_per_s(comp->simd_timer, pixels, iterations);
+    printf("%-22s %-14.1f %-14.1f %.2fx\n", name, scalar_rate, simd_rate,
+           scalar_rate > 0.0 ? simd_rate / scalar_rate : 0.0);
+}
+
+int main(int argc, char** argv) {
+    // Default image dimensions (4K UHD)
+    int width = 3840;
+    int height = 2160;
+
+    // Allow overriding image width from command line (height keeps 16:9)
+    if (argc > 1) {
+        width = atoi(argv[1]);
+        if (width <= 0) {
+            width = 3840;
+        }
+        height = width * 9 / 16;
+    }
+
+    printf("Integral Image Example\n");
+    printf("----------------------\n");
+    printf("Image: %dx%d\n", width, height);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    size_t pixels = (size_t)width * height;
+    size_t table = (size_t)(width + 1) * (height + 1);
+    uint8_t* src = (uint8_t*)neon_malloc(pixels);
+    float* fsrc = (float*)neon_malloc(pixels * sizeof(float));
+    uint32_t* sum = (uint32_t*)neon_malloc(table * sizeof(uint32_t));
+    uint32_t* sum_ref = (uint32_t*)neon_malloc(table * sizeof(uint32_t));
+    uint64_t* sqsum = (uint64_t*)neon_malloc(table * sizeof(uint64_t));
+    uint64_t* sqsum_ref = (uint64_t*)neon_malloc(table * sizeof(uint64_t));
+    double* fsum = (double*)neon_malloc(table * sizeof(double));
+    double* fsum_ref = (double*)neon_malloc(table * sizeof(double));
+
+    if (!src || !fsrc || !sum || !sum_ref || !sqsum || !sqsum_ref || !fsum || !fsum_ref) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    fill_random_uint8(src, pixels);
+    fill_random_float(fsrc, pixels, -1.0f, 1.0f);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 5;
+    int errors = 0;
+
+    printf("\n%-22s %-14s %-14s %-10s\n", "Table", "Scalar Mpx/s", "NEON Mpx/s", "Speedup");
+    printf("--------------------------------------------------------------\n");
+
+    perf_comparison_t* comp = comparison_create("Integral U8");
+    timer_start(comp->simd_timer);
+    for (int i = 0; i < iterations; i++) simd_integral_u8(src, sum, width, height);
+    timer_stop(comp->simd_timer);
+    timer_start(comp->scalar_timer);
+    for (int i = 0; i < iterations; i++) scalar_integral_u8(src, sum_ref, NULL, width, height);
+    timer_stop(comp->scalar_timer);
+    if (memcmp(sum, sum_ref, table * sizeof(uint32_t)) != 0) errors++;
+    print_row("u8 -> u32", comp, pixels, iterations);
+    comparison_destroy(comp);
+
+    comp = comparison_create("Integral U8 squared");
+    timer_start(comp->simd_timer);
+    for (int i = 0; i < iterations; i++) simd_integral_sq_u8(src, sum, sqsum, width, height);
+    timer_stop(comp->simd_timer);
+    timer_start(comp->scalar_timer);
+    for (int i = 0; i < iterations; i++) scalar_integral_u8(src, sum_ref, sqsum_ref, width, height);
+    timer_stop(comp->scalar_timer);
+    if (memcmp(sqsum, sqsum_ref, table * sizeof(uint64_t)) != 0) errors++;
+    print_row("u8 -> u32 + u64 sq", comp, pixels, iterations);
+    comparison_destroy(comp);
+
+    comp = comparison_create("Integral F32");
+    timer_start(comp->simd_timer);
+    for (int i = 0; i < iterations; i++) simd_integral_f32(fsrc, fsum, width, height);
+    timer_stop(comp->simd_timer);
+    timer_start(comp->scalar_timer);
+    for (int i = 0; i < iterations; i++) scalar_integral_f32(fsrc, fsum_ref, NULL, width, height);
+    timer_stop(comp->scalar_timer);
+    for (size_t i = 0; i < table; i++) {
+        if (fabs(fsum[i] - fsum_ref[i]) > 1e-6 * (1.0 + fabs(fsum_ref[i]))) {
+            errors++;
+            break;
+        }
+    }
+    print_row("f32 -> f64", comp, pixels, iterations);
+    comparison_destroy(comp);
+
+    // Constant-time queries: local variance over random windows
+    const int queries = 1000000;
+    uint32_t* rects = (uint32_t*)malloc((size_t)queries * 4 * sizeof(uint32_t));
+    if (!rects) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+    for (int q = 0; q < queries; q++) {
+        int w = 1 + rand() % 64;
+        int h = 1 + rand() % 64;
+        if (w > width) w = width;
+        if (h > height) h = height;
+        rects[4 * q] = (uint32_t)(rand() % (width - w + 1));
+        rects[4 * q + 1] = (uint32_t)(rand() % (height - h + 1));
+        rects[4 * q + 2] = (uint32_t)w;
+        rects[4 * q + 3] = (uint32_t)h;
+    }
+
+    simd_integral_sq_u8(src, sum, sqsum, width, height);
+    perf_timer_t* timer = timer_create("variance queries");
+    double checksum = 0.0;
+    timer_start(timer);
+    for (int q = 0; q < queries; q++) {
+        checksum += simd_integral_rect_variance_u8(sum, sqsum, width, (int)rects[4 * q], (int)rects[4 * q + 1],
+                                                   (int)rects[4 * q + 2], (int)rects[4 * q + 3]);
+    }
+    timer_stop(timer);
+    printf("\nRectangle variance queries: %.1f M/s (mean variance %.1f)\n",
+           timer->total_time > 0 ? (double)queries / timer->total_time : 0.0, checksum / queries);
+    timer_destroy(timer);
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    // Clean up
+    free(rects);
+    free(src);
+    free(fsrc);
+    free(sum);
+    free(sum_ref);
+    free(sqsum);
+    free(sqsum_ref);
+    free(fsum);
+    free(fsum_ref);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * lut_point_ops.c
+ * Demonstrates lookup tables and point operations using NEON
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_lut.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementation for comparison
+void scalar_lut(const uint8_t* src, const uint8_t* lut, uint8_t* dst, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+void scalar_lut_channels(const uint8_t* src, const uint8_t* luts, uint8_t* dst, size_t pixel_count, int channels) {
+    for (size_t i = 0; i < pixel_count; i++) {
+        for (int c = 0; c < channels; c++) {
+            dst[i * channels + c] = luts[c * 256 + src[i * channels + c]];
+        }
+    }
+}
+
+static double gb_per_s(const perf_timer_t* timer, size_t bytes, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)bytes * iterations / (double)timer->total_time / 1000.0;
+}
+
+int main(int argc, char** argv) {
+    // Default image dimensions (4K)
+    int width = 3840;
+    int height = 2160;
+
+    // Allow overriding image width from command line (height keeps 16:9)
+    if (argc > 1) {
+        width = atoi(argv[1]);
+        if (width <= 0) {
+            width = 3840;
+        }
+        height = width * 9 / 16;
+    }
+
+    printf("Lookup Table Example\n");
+    printf("--------------------\n");
+    printf("Image: %dx%d\n", width, height);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    size_t pixels = (size_t)width * height;
+    size_t bytes = pixels * 4;
+    uint8_t* src = (uint8_t*)neon_malloc(bytes);
+    uint8_t* simd_result = (uint8_t*)neon_malloc(bytes);
+    uint8_t* scalar_result = (uint8_t*)neon_malloc(bytes);
+
+    if (!src || !simd_result || !scalar_result) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    fill_random_uint8(src, bytes);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 10;
+    int errors = 0;
+
+    // Gray: lookup against a scalar loop and plain memcpy
+    uint8_t gamma[256];
+    simd_lut_gamma(gamma, 1.0f / 2.2f);
+
+    perf_comparison_t* comp = comparison_create("Gray LUT");
+    perf_timer_t* copy = timer_create("memcpy");
+
+    timer_start(comp->scalar_timer);
+    for (int i = 0; i < iterations; i++) scalar_lut(src, gamma, scalar_result, pixels);
+    timer_stop(comp->scalar_timer);
+
+    timer_start(comp->simd_timer);
+    for (int i = 0; i < iterations; i++) simd_lut_u8(src, gamma, simd_result, pixels);
+    timer_stop(comp->simd_timer);
+
+    if (memcmp(simd_result, scalar_result, pixels) != 0) errors++;
+
+    timer_start(copy);
+    for (int i = 0; i < iterations; i++) memcpy(simd_result, src, pixels);
+    timer_stop(copy);
+
+    printf("\n%-22s %-12s %-12s\n", "Gray (read + write)", "GB/s", "of memcpy");
+    printf("----------------------------------------------\n");
+    double copy_rate = gb_per_s(copy, 2 * pixels, iterations);
+    double scalar_rate = gb_per_s(comp->scalar_timer, 2 * pixels, iterations);
+    double simd_rate = gb_per_s(comp->simd_timer, 2 * pixels, iterations);
+    printf("%-22s %-12.2f %.0f%%\n", "memcpy", copy_rate, 100.0);
+    printf("%-22s %-12.2f %.0f%%\n", "Scalar lut[src[i]]", scalar_rate, copy_rate > 0.0 ? 100.0 * scalar_rate / copy_rate : 0.0);
+    printf("%-22s %-12.2f %.0f%%\n", "NEON vqtbl4q x4", simd_rate, copy_rate > 0.0 ? 100.0 * simd_rate / copy_rate : 0.0);
+
+    timer_destroy(copy);
+    comparison_destroy(comp);
+
+    // Per-channel tables (e.g. white balance plus gamma)
+    uint8_t luts[4 * 256];
+    simd_lut_linear(luts, 1.10f, 0.0f);
+    simd_lut_linear(luts + 256, 1.00f, 0.0f);
+    simd_lut_linear(luts + 512, 0.85f, 0.0f);
+    for (int i = 0; i < 256; i++) luts[768 + i] = (uint8_t)i;
+
+    printf("\n%-22s %-14s %-14s %-10s\n", "Per channel", "Scalar GB/s", "NEON GB/s", "Speedup");
+    printf("--------------------------------------------------------------\n");
+    for (int channels = 3; channels <= 4; channels++) {
+        comp = comparison_create("Channel LUT");
+        size_t len = pixels * channels;
+
+        timer_start(comp->scalar_timer);
+        for (int i = 0; i < iterations; i++) scalar_lut_channels(src, luts, scalar_result, pixels, channels);
+        timer_stop(comp->scalar_timer);
+
+        timer_start(comp->simd_timer);
+        for (int i = 0; i < iterations; i++) simd_lut_channels_u8(src, luts, simd_result, pixels, channels);
+        timer_stop(comp->simd_timer);
+
+        if (memcmp(simd_result, scalar_result, len) != 0) errors++;
+
+        scalar_rate = gb_per_s(comp->scalar_timer, 2 * len, iterations);
+        simd_rate = gb_per_s(comp->simd_timer, 2 * len, iterations);
+        printf("%-22s %-14.2f %-14.2f %.1fx\n", channels == 3 ? "RGB" : "RGBA", scalar_rate, simd_rate,
+               scalar_rate > 0.0 ? simd_rate / scalar_rate : 0.0);
+        comparison_destroy(comp);
+    }
+
+    // Histogram equalization: build the table once, apply it with NEON
+    uint32_t hist[256];
+    uint8_t equalize[256];
+    memset(hist, 0, sizeof(hist));
+    for (size_t i = 0; i < pixels; i++) src[i] = (uint8_t)(64 + src[i] / 4);
+    for (size_t i = 0; i < pixels; i++) hist[src[i]]++;
+    simd_lut_equalize(hist, equalize);
+    simd_lut_u8(src, equalize, simd_result, pixels);
+
+    uint8_t lo = 255, hi = 0;
+    for (size_t i = 0; i < pixels; i++) {
+        if (simd_result[i] < lo) lo = simd_result[i];
+        if (simd_result[i] > hi) hi = simd_result[i];
+    }
+    printf("\nEqualization: input 64..127 -> output %u..%u\n", lo, hi);
+    if (lo != 0 || hi != 255) errors++;
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    // Clean up
+    free(src);
+    free(simd_result);
+    free(scalar_result);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+/**
+ * matrix_transpose.c
+ * Demonstrates blocked matrix transpose using NEON register micro-transposes
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_transpose.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementations for comparison: naive double loop
+void scalar_transpose_f32(const float* src, float* dst, size_t rows, size_t cols) {
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            dst[c * rows + r] = src[r * cols + c];
+        }
+    }
+}
+
+void scalar_transpose_u16(const uint16_t* src, uint16_t* dst, size_t rows, size_t cols) {
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            dst[c * rows + r] = src[r * cols + c];
+        }
+    }
+}
+
+void scalar_transpose_u8(const uint8_t* src, uint8_t* dst, size_t rows, size_t cols) {
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            dst[c * rows + r] = src[r * cols + c];
+        }
+    }
+}
+
+// Convert a timer total into GB/s of data read + written
+static double gbps(const perf_timer_t* timer, size_t bytes_moved, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)bytes_moved * iterations / (timer->total_time * 1000.0);
+}
+
+int main(int argc, char** argv) {
+    // Default largest matrix edge
+    size_t max_size = 8192;
+
+    // Allow overriding the largest size from command line
+    if (argc > 1) {
+        max_size = atoi(argv[1]);
+        if (max_size <= 0) {
+            max_size = 8192;
+        }
+    }
+
+    printf("Matrix Transpose Example\n");
+    printf("------------------------\n");
+    printf("Sizes: 256x256 .. %zux%zu\n", max_size, max_size);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    // Buffers sized for the largest f32 matrix are reused for every case
+    size_t max_bytes = max_size * max_size * sizeof(float);
+    uint8_t* src = (uint8_t*)neon_malloc(max_bytes);
+    uint8_t* dst_simd = (uint8_t*)neon_malloc(max_bytes);
+    uint8_t* dst_scalar = (uint8_t*)neon_malloc(max_bytes);
+
+    if (!src || !dst_simd || !dst_scalar) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    fill_random_uint8(src, max_bytes);
+
+    int errors = 0;
+
+    printf("\n%-12s %-6s %-14s %-14s %-10s\n", "Size", "Type", "Naive GB/s", "NEON GB/s", "Speedup");
+    printf("------------------------------------------------------------\n");
+
+    for (size_t n = 256; n <= max_size; n *= 2) {
+        // Keep total work per size roughly constant
+        int iterations = (int)((64 * 1024 * 1024) / (n * n));
+        if (iterations < 1) iterations = 1;
+
+        // Odd shapes exercise the edge handling: n x (n - 3)
+        for (int type = 0; type < 3; type++) {
+            size_t rows = n;
+            size_t cols = n - 3;
+            const char* name = type == 0 ? "f32" : (type == 1 ? "u16" : "u8");
+            size_t elem = type == 0 ? sizeof(float) : (type == 1 ? sizeof(uint16_t) : 1);
+            size_t bytes = rows * cols * elem;
+
+            perf_comparison_t* comp = comparison_create("Transpose");
+
+            timer_start(comp->simd_timer);
+            for (int i = 0; i < iterations; i++) {
+                if (type == 0) simd_transpose_f32((const float*)src, (float*)dst_simd, rows, cols);
+                if (type == 1) simd_transpose_u16((const uint16_t*)src, (uint16_t*)dst_simd, rows, cols);
+                if (type == 2) simd_transpose_u8(src, dst_simd, rows, cols);
+            }
+            timer_stop(comp->simd_timer);
+
+            timer_start(comp->scalar_timer);
+            for (int i = 0; i < iterations; i++) {
+                if (type == 0) scalar_transpose_f32((const float*)src, (float*)dst_scalar, rows, cols);
+                if (type == 1) scalar_transpose_u16((const uint16_t*)src, (uint16_t*)dst_scalar, rows, cols);
+                if (type == 2) scalar_transpose_u8(src, dst_scalar, rows, cols);
+            }
+            timer_stop(comp->scalar_timer);
+
+            // Both implementations must produce identical bytes
+            if (memcmp(dst_simd, dst_scalar, bytes) != 0) errors++;
+
+            // Read + write traffic
+            double scalar_gbps = gbps(comp->scalar_timer, bytes * 2, iterations);
+            double simd_gbps = gbps(comp->simd_timer, bytes * 2, iterations);
+            char size_label[32];
+            snprintf(size_label, sizeof(size_label), "%zux%zu", rows, cols);
+            printf("%-12s %-6s %-14.2f %-14.2f %.2fx\n", size_label, name, scalar_gbps, simd_gbps,
+                   scalar_gbps > 0.0 ? simd_gbps / scalar_gbps : 0.0);
+
+            comparison_destroy(comp);
+        }
+    }
+
+    // In-place square transpose: applying it twice must restore the input
+    size_t n = max_size < 4096 ? max_size : 4096;
+    memcpy(dst_simd, src, n * n * sizeof(float));
+    perf_timer_t* inplace_timer = timer_create("In-place");
+    timer_start(inplace_timer);
+    simd_transpose_inplace_f32((float*)dst_simd, n);
+    simd_transpose_inplace_f32((float*)dst_simd, n);
+    timer_stop(inplace_timer);
+    if (memcmp(dst_simd, src, n * n * sizeof(float)) != 0) errors++;
+    printf("\nIn-place f32 %zux%zu: %.2f GB/s\n", n, n,
+           gbps(inplace_timer, n * n * sizeof(float) * 2, 2));
+    timer_destroy(inplace_timer);
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    // Clean up
+    free(src);
+    free(dst_simd);
+    free(dst_scalar);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * median_filter.c
+ * Demonstrates median filtering using NEON sorting networks and histograms
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_median.h"
+#include "../include/simd_parallel.h"
+#include "../include/perf_test.h"
+
+static int clamp_index(int i, int n) {
+    return i < 0 ? 0 : (i >= n ? n - 1 : i);
+}
+
+// Scalar (non-SIMD) implementation for comparison: Huang's running
+// histogram, which adds and removes one window column per pixel
+void scalar_median(const uint8_t* src, uint8_t* dst, int width, int height, int r) {
+    int n = 2 * r + 1;
+    int target = n * n / 2;
+    int hist[256];
+
+    for (int y = 0; y < height; y++) {
+        memset(hist, 0, sizeof(hist));
+        for (int j = y - r; j <= y + r; j++) {
+            const uint8_t* row = src + (size_t)clamp_index(j, height) * width;
+            for (int i = -r; i <= r; i++) hist[row[clamp_index(i, width)]]++;
+        }
+
+        for (int x = 0; x < width; x++) {
+            if (x > 0) {
+                int add = clamp_index(x + r, width);
+                int sub = clamp_index(x - r - 1, width);
+                for (int j = y - r; j <= y + r; j++) {
+                    const uint8_t* row = src + (size_t)clamp_index(j, height) * width;
+                    hist[row[add]]++;
+                    hist[row[sub]]--;
+                }
+            }
+
+            int v = 0;
+            int sum = hist[0];
+            while (sum <= target) sum += hist[++v];
+            dst[(size_t)y * width + x] = (uint8_t)v;
+        }
+    }
+}
+
+static double mpix_per_s(const perf_timer_t* timer, size_t pixels, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)pixels * iterations / (double)timer->total_time;
+}
+
+int main(int argc, char** argv) {
+    // Default image sizes: 1080p and 4K
+    int widths[2] = { 1920, 3840 };
+    int sizes = 2;
+
+    // Allow overriding image width from command line (height keeps 16:9)
+    if (argc > 1) {
+        widths[0] = atoi(argv[1]);
+        if (widths[0] <= 0) {
+            widths[0] = 1920;
+        }
+        sizes = 1;
+    }
+
+    printf("Median Filter Example\n");
+    printf("---------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+    int cpus = simd_parallel_cpu_count();
+    printf("Online CPUs: %d\n", cpus);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 3;
+    int errors = 0;
+
+    // Networks for 3x3 and 5x5, constant-time histograms above
+    static const int radii[] = { 1, 2, 3, 7, 15 };
+
+    for (int s = 0; s < sizes; s++) {
+        int width = widths[s];
+        int height = width * 9 / 16;
+        size_t pixels = (size_t)width * height;
+        uint8_t* src = (uint8_t*)neon_malloc(pixels);
+        uint8_t* simd_result = (uint8_t*)neon_malloc(pixels);
+        uint8_t* scalar_result = (uint8_t*)neon_malloc(pixels);
+
+        if (!src || !simd_result || !scalar_result) {
+            printf("ERROR: Memory allocation failed.\n");
+            return 1;
+        }
+
+        fill_random_uint8(src, pixels);
+
+        printf("\nImage: %dx%d\n", width, height);
+        printf("%-10s %-14s %-14s %-10s %-14s\n", "Window", "Scalar Mpx/s", "NEON Mpx/s", "Speedup", "Threaded Mpx/s");
+        printf("----------------------------------------------------------------\n");
+
+        for (int r = 0; r < 5; r++) {
+            int radius = radii[r];
+            perf_comparison_t* comp = comparison_create("Median");
+
+            timer_start(comp->scalar_timer);
+            scalar_median(src, scalar_result, width, height, radius);
+            timer_stop(comp->scalar_timer);
+
+            timer_start(comp->simd_timer);
+            for (int i = 0; i < iterations; i++) simd_median_u8(src, simd_result, width, height, radius, 1);
+            timer_stop(comp->simd_timer);
+
+            if (memcmp(simd_result, scalar_result, pixels) != 0) errors++;
+
+            // All CPUs
+            perf_timer_t* threaded = timer_create("Median threaded");
+            timer_start(threaded);
+            for (int i = 0; i < iterations; i++) simd_median_u8(src, simd_result, width, height, radius, 0);
+            timer_stop(threaded);
+
+            if (memcmp(simd_result, scalar_result, pixels) != 0) errors++;
+
+            double scalar_rate = mpix_per_s(comp->scalar_timer, pixels, 1);
+            double simd_rate = mpix_per_s(comp->simd_timer, pixels, iterations);
+            char window[32];
+            snprintf(window, sizeof(window), "%dx%d", 2 * radius + 1, 2 * radius + 1);
+            printf("%-10s %-14.1f %-14.1f %-10.1f %-14.1f\n", window, scalar_rate, simd_rate,
+                   scalar_rate > 0.0 ? simd_rate / scalar_rate : 0.0, mpix_per_s(threaded, pixels, iterations));
+
+            timer_destroy(threaded);
+            comparison_destroy(comp);
+        }
+
+        // Clean up
+        free(src);
+        free(simd_result);
+        free(scalar_result);
+    }
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * morphology.c
+ * Demonstrates erosion, dilation and derived morphology using NEON
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_morph.h"
+#include "../include/simd_parallel.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementation for comparison: scan the whole window
+void scalar_erode(const uint8_t* src, uint8_t* dst, int width, int height, int kw, int kh) {
+    for (int y = 0; y < height; y++) {
+        int y0 = y - kh / 2 < 0 ? 0 : y - kh / 2;
+        int y1 = y - kh / 2 + kh > height ? height : y - kh / 2 + kh;
+        for (int x = 0; x < width; x++) {
+            int x0 = x - kw / 2 < 0 ? 0 : x - kw / 2;
+            int x1 = x - kw / 2 + kw > width ? width : x - kw / 2 + kw;
+            uint8_t v = 255;
+            for (int j = y0; j < y1; j++) {
+                for (int i = x0; i < x1; i++) {
+                    if (src[j * width + i] < v) v = src[j * width + i];
+                }
+            }
+            dst[y * width + x] = v;
+        }
+    }
+}
+
+static double mpix_per_s(const perf_timer_t* timer, size_t pixels, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)pixels * iterations / (double)timer->total_time;
+}
+
+int main(int argc, char** argv) {
+    // Default image dimensions (1080p)
+    int width = 1920;
+    int height = 1080;
+
+    // Allow overriding image width from command line (height keeps 16:9)
+    if (argc > 1) {
+        width = atoi(argv[1]);
+        if (width <= 0) {
+            width = 1920;
+        }
+        height = width * 9 / 16;
+    }
+
+    printf("Morphology Example\n");
+    printf("------------------\n");
+    printf("Image: %dx%d\n", width, height);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+    int cpus = simd_parallel_cpu_count();
+    printf("Online CPUs: %d\n", cpus);
+
+    size_t pixels = (size_t)width * height;
+    uint8_t* src = (uint8_t*)neon_malloc(pixels);
+    uint8_t* simd_result = (uint8_t*)neon_malloc(pixels);
+    uint8_t* scalar_result = (uint8_t*)neon_malloc(pixels);
+
+    if (!src || !simd_result || !scalar_result) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    fill_random_uint8(src, pixels);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 5;
+    int errors = 0;
+
+    // The window scan grows with kw * kh; van Herk/Gil-Werman stays flat
+    static const int sizes[] = { 3, 7, 15, 31 };
+    printf("\nErosion, single thread\n");
+    printf("%-10s %-16s %-16s %-10s\n", "Element", "Scan Mpx/s", "NEON Mpx/s", "Speedup");
+    printf("------------------------------------------------------\n");
+
+    for (int s = 0; s < 4; s++) {
+        int k = sizes[s];
+        perf_comparison_t* comp = comparison_create("Erode");
+
+        timer_start(comp->scalar_timer);
+        scalar_erode(src, scalar_result, width, height, k, k);
+        timer_stop(comp->scalar_timer);
+
+        timer_start(comp->simd_timer);
+        for (int i = 0; i < iterations; i++) simd_erode_u8(src, simd_result, width, height, k, k, 1);
+        timer_stop(comp->simd_timer);
+
+        if (memcmp(simd_result, scalar_result, pixels) != 0) errors++;
+
+        double scalar_rate = mpix_per_s(comp->scalar_timer, pixels, 1);
+        double simd_rate = mpix_per_s(comp->simd_timer, pixels, iterations);
+        char element[16];
+        snprintf(element, sizeof(element), "%dx%d", k, k);
+        printf("%-10s %-16.1f %-16.1f %.1fx\n", element, scalar_rate, simd_rate,
+               scalar_rate > 0.0 ? simd_rate / scalar_rate : 0.0);
+        comparison_destroy(comp);
+    }
+
+    // Band-parallel scaling
+    printf("\n%-12s", "Threads");
+    static const char* op_names[] = { "Erode", "Open", "Gradient", "Top-hat" };
+    static const simd_morph_op_t ops[] = { SIMD_MORPH_ERODE, SIMD_MORPH_OPEN, SIMD_MORPH_GRADIENT, SIMD_MORPH_TOPHAT };
+    for (int o = 0; o < 4; o++) printf(" %-12s", op_names[o]);
+    printf("  (15x15, Mpx/s)\n");
+    printf("--------------------------------------------------------------\n");
+
+    int thread_counts[] = { 1, 2, 4, cpus };
+    int last = 0;
+    for (int t = 0; t < 4; t++) {
+        if (thread_counts[t] > cpus || thread_counts[t] <= last) continue;
+        last = thread_counts[t];
+        printf("%-12d", thread_counts[t]);
+        for (int o = 0; o < 4; o++) {
+            perf_timer_t* timer = timer_create(op_names[o]);
+            timer_start(timer);
+            for (int i = 0; i < iterations; i++) {
+                simd_morphology_u8(src, simd_result, width, height, ops[o], 15, 15, thread_counts[t]);
+            }
+            timer_stop(timer);
+            printf(" %-12.1f", mpix_per_s(timer, pixels, iterations));
+            timer_destroy(timer);
+        }
+        printf("\n");
+    }
+
+    // Multi-threaded output matches the scan
+    simd_erode_u8(src, simd_result, width, height, 31, 31, 0);
+    if (memcmp(simd_result, scalar_result, pixels) != 0) errors++;
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    // Clean up
+    free(src);
+    free(simd_result);
+    free(scalar_result);
+
+    return errors ? 1 : 0;
+}
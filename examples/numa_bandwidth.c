@@ -0,0 +1,153 @@
+/**
+ * numa_bandwidth.c
+ * Demonstrates node-local allocation and node-placed sweeps: a 16M-element
+ * add with all pages on one node against first-touch placement, and the
+ * bandwidth each node gets from its own and every other node's memory
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/simd_numa.h"
+#include "../include/simd_sched.h"
+#include "../include/simd_ops.h"
+#include "../include/benchmark_config.h"
+
+typedef struct {
+    float* a;
+    float* b;
+    float* c;
+} sweep_t;
+
+// c = a + b over [begin, end): two read streams, one write stream
+static void add_range(void* ctx, size_t begin, size_t end) {
+    sweep_t* s = (sweep_t*)ctx;
+    simd_add_f32(s->a + begin, s->b + begin, s->c + begin, end - begin);
+}
+
+// Inputs written by whichever thread runs each index
+static void fill_range(void* ctx, size_t begin, size_t end) {
+    sweep_t* s = (sweep_t*)ctx;
+    for (size_t i = begin; i < end; i++) {
+        s->a[i] = (float)(i & 1023);
+        s->b[i] = 0.5f;
+        s->c[i] = 0.0f;
+    }
+}
+
+static int verify(const sweep_t* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (s->c[i] != (float)(i & 1023) + 0.5f) return 1;
+    }
+    return 0;
+}
+
+static double gb_per_s(const perf_timer_t* timer, size_t bytes, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)bytes * iterations / (double)timer->total_time / 1000.0;
+}
+
+int main(int argc, char** argv) {
+    // Default sweep: the largest size of the standard benchmark configuration
+    benchmark_config_t bench = benchmark_config_default("NUMA add");
+    size_t n = bench.max_size;
+
+    // Allow overriding the element count from command line
+    if (argc > 1) {
+        n = (size_t)atol(argv[1]);
+        if (n < 1024) {
+            n = bench.max_size;
+        }
+    }
+    size_t bytes = n * sizeof(float);
+
+    printf("NUMA Bandwidth Example\n");
+    printf("----------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    // Node topology
+    simd_numa_node_t nodes[SIMD_NUMA_MAX_NODES];
+    int found = simd_numa_topology(NULL, nodes, SIMD_NUMA_MAX_NODES);
+    printf("\nNUMA nodes: %d\n", found);
+    for (int i = 0; i < found; i++) {
+        printf("  node%-3d %-4d CPUs  %.1f GiB\n", nodes[i].id, nodes[i].cpu_count,
+               nodes[i].memory / (1024.0 * 1024.0 * 1024.0));
+    }
+
+    simd_sched_config_t config = { 0, SIMD_AFFINITY_NUMA, NULL, NULL };
+    simd_sched_init(&config);
+    int placed = simd_sched_nodes();
+    printf("Pool: %d workers on %d node(s)\n", simd_sched_workers(), placed);
+
+    // Baseline: one thread initializes everything, so every page lands on its node
+    sweep_t plain = { (float*)neon_malloc(bytes), (float*)neon_malloc(bytes), (float*)neon_malloc(bytes) };
+    sweep_t local = { (float*)simd_numa_alloc(bytes), (float*)simd_numa_alloc(bytes), (float*)simd_numa_alloc(bytes) };
+    if (!plain.a || !plain.b || !plain.c || !local.a || !local.b || !local.c) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+    fill_range(&plain, 0, n);
+    simd_parallel_for_nodes(0, n, 0, fill_range, &local);
+
+    const int iterations = bench.iterations;
+    size_t traffic = 3 * bytes;
+    int errors = 0;
+
+    perf_comparison_t* comp = comparison_create("Add f32");
+    timer_start(comp->scalar_timer);
+    for (int i = 0; i < iterations; i++) simd_parallel_for(0, n, 0, add_range, &plain);
+    timer_stop(comp->scalar_timer);
+    errors += verify(&plain, n);
+
+    timer_start(comp->simd_timer);
+    for (int i = 0; i < iterations; i++) simd_parallel_for_nodes(0, n, 0, add_range, &local);
+    timer_stop(comp->simd_timer);
+    errors += verify(&local, n);
+
+    printf("\nc = a + b, %zu elements (%.0f MiB per array):\n", n, bytes / (1024.0 * 1024.0));
+    printf("  %-36s %.2f GB/s\n", "Serial first touch, any worker", gb_per_s(comp->scalar_timer, traffic, iterations));
+    printf("  %-36s %.2f GB/s\n", "Node-local first touch, node loops", gb_per_s(comp->simd_timer, traffic, iterations));
+    comparison_destroy(comp);
+
+    // Node k sweeping node j's part: the diagonal is local bandwidth
+    printf("\nPer-node GB/s (row: node running, column: node holding the data)\n  %-8s", "");
+    for (int j = 0; j < placed; j++) printf("mem %-6d", j);
+    printf("\n");
+    for (int k = 0; k < placed; k++) {
+        printf("  node %-3d", k);
+        for (int j = 0; j < placed; j++) {
+            size_t begin = simd_sched_node_start(n, j);
+            size_t end = simd_sched_node_start(n, j + 1);
+            perf_timer_t* timer = timer_create("Node sweep");
+            timer_start(timer);
+            for (int i = 0; i < iterations; i++) simd_parallel_for_node(k, begin, end, 0, add_range, &local);
+            timer_stop(timer);
+            printf("%-10.2f", gb_per_s(timer, 3 * (end - begin) * sizeof(float), iterations));
+            timer_destroy(timer);
+        }
+        printf("\n");
+    }
+    errors += verify(&local, n);
+    if (placed == 1) printf("\nSingle node: both placements see the same memory.\n");
+
+    // Clean up
+    simd_sched_shutdown();
+    free(plain.a);
+    free(plain.b);
+    free(plain.c);
+    simd_numa_free(local.a, bytes);
+    simd_numa_free(local.b, bytes);
+    simd_numa_free(local.c, bytes);
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
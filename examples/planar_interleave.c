@@ -0,0 +1,170 @@
+/**
+ * planar_interleave.c
+ * Demonstrates planar <-> interleaved conversion using NEON structure loads/stores
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_interleave.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementations for comparison
+void scalar_zip2_f32(const float* a, const float* b, float* out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out[i * 2] = a[i];
+        out[i * 2 + 1] = b[i];
+    }
+}
+
+void scalar_unzip2_f32(const float* in, float* a, float* b, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        a[i] = in[i * 2];
+        b[i] = in[i * 2 + 1];
+    }
+}
+
+void scalar_zip3_u8(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint8_t* out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out[i * 3] = a[i];
+        out[i * 3 + 1] = b[i];
+        out[i * 3 + 2] = c[i];
+    }
+}
+
+void scalar_unzip4_s16(const int16_t* in, int16_t* a, int16_t* b, int16_t* c, int16_t* d, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        a[i] = in[i * 4];
+        b[i] = in[i * 4 + 1];
+        c[i] = in[i * 4 + 2];
+        d[i] = in[i * 4 + 3];
+    }
+}
+
+// Convert a timer total into GB/s of data read + written
+static double gbps(const perf_timer_t* timer, size_t bytes_moved, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)bytes_moved * iterations / (timer->total_time * 1000.0);
+}
+
+int main(int argc, char** argv) {
+    // Default number of elements per channel
+    size_t len = 4 * 1024 * 1024;
+
+    // Allow overriding size from command line
+    if (argc > 1) {
+        len = atoi(argv[1]);
+        if (len <= 0) {
+            len = 4 * 1024 * 1024;
+        }
+    }
+
+    printf("Planar/Interleaved Conversion Example\n");
+    printf("------------------------------------\n");
+    printf("Elements per channel: %zu\n", len);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    // One pool of 16 bytes per element covers every layout below
+    uint8_t* planar = (uint8_t*)neon_malloc(len * 16);
+    uint8_t* packed = (uint8_t*)neon_malloc(len * 16);
+    uint8_t* copy = (uint8_t*)neon_malloc(len * 16);
+
+    if (!planar || !packed || !copy) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    fill_random_uint8(planar, len * 16);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 10;
+
+    float* fa = (float*)planar;
+    float* fb = fa + len;
+    int16_t* s16 = (int16_t*)planar;
+    int errors = 0;
+
+    printf("\n%-22s %-14s %-14s %-14s\n", "Kernel", "Scalar GB/s", "NEON GB/s", "memcpy GB/s");
+    printf("-----------------------------------------------------------------\n");
+
+    for (int kernel = 0; kernel < 4; kernel++) {
+        const char* name = "";
+        size_t bytes = 0;
+        perf_comparison_t* comp = comparison_create("Interleave");
+        perf_timer_t* memcpy_timer = timer_create("memcpy");
+
+        for (int pass = 0; pass < 2; pass++) {
+            perf_timer_t* timer = pass == 0 ? comp->simd_timer : comp->scalar_timer;
+            timer_start(timer);
+            for (int i = 0; i < iterations; i++) {
+                switch (kernel) {
+                    case 0:
+                        name = "zip2 f32 (IQ merge)";
+                        bytes = len * 2 * sizeof(float);
+                        if (pass == 0) simd_zip2_f32(fa, fb, (float*)packed, len);
+                        else scalar_zip2_f32(fa, fb, (float*)copy, len);
+                        break;
+                    case 1:
+                        name = "unzip2 f32 (IQ split)";
+                        bytes = len * 2 * sizeof(float);
+                        if (pass == 0) simd_unzip2_f32(fa, (float*)packed, (float*)packed + len, len);
+                        else scalar_unzip2_f32(fa, (float*)copy, (float*)copy + len, len);
+                        break;
+                    case 2:
+                        name = "zip3 u8 (RGB pack)";
+                        bytes = len * 3;
+                        if (pass == 0) simd_zip3_u8(planar, planar + len, planar + 2 * len, packed, len);
+                        else scalar_zip3_u8(planar, planar + len, planar + 2 * len, copy, len);
+                        break;
+                    default:
+                        name = "unzip4 s16 (4ch audio)";
+                        bytes = len * 4 * sizeof(int16_t);
+                        if (pass == 0) simd_unzip4_s16(s16, (int16_t*)packed, (int16_t*)packed + len,
+                                                       (int16_t*)packed + 2 * len, (int16_t*)packed + 3 * len, len);
+                        else scalar_unzip4_s16(s16, (int16_t*)copy, (int16_t*)copy + len,
+                                               (int16_t*)copy + 2 * len, (int16_t*)copy + 3 * len, len);
+                        break;
+                }
+            }
+            timer_stop(timer);
+        }
+
+        // Both implementations must produce identical bytes
+        if (memcmp(packed, copy, bytes) != 0) errors++;
+
+        // memcpy of the same byte count is the bandwidth ceiling
+        timer_start(memcpy_timer);
+        for (int i = 0; i < iterations; i++) {
+            memcpy(copy, planar, bytes);
+        }
+        timer_stop(memcpy_timer);
+
+        // Read + write traffic
+        printf("%-22s %-14.2f %-14.2f %-14.2f\n", name,
+               gbps(comp->scalar_timer, bytes * 2, iterations),
+               gbps(comp->simd_timer, bytes * 2, iterations),
+               gbps(memcpy_timer, bytes * 2, iterations));
+
+        comparison_destroy(comp);
+        timer_destroy(memcpy_timer);
+    }
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    // Clean up
+    free(planar);
+    free(packed);
+    free(copy);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * prefix_scan.c
+ * Demonstrates prefix sums (scans) using NEON and multiple threads
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_scan.h"
+#include "../include/simd_parallel.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementation for comparison
+void scalar_scan_s32(const int32_t* in, int32_t* out, size_t len) {
+    uint32_t run = 0;
+    for (size_t i = 0; i < len; i++) {
+        run += (uint32_t)in[i];
+        out[i] = (int32_t)run;
+    }
+}
+
+// GB/s counting one read and one write of every element
+static double gb_per_s(const perf_timer_t* timer, size_t bytes, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return 2.0 * (double)bytes * iterations / ((double)timer->total_time * 1000.0);
+}
+
+int main(int argc, char** argv) {
+    // Largest array in elements (default 32M int32 = 128 MB per buffer)
+    size_t max_len = (size_t)32 << 20;
+
+    // Allow overriding the largest size from command line
+    if (argc > 1) {
+        long n = atol(argv[1]);
+        if (n > 0) {
+            max_len = (size_t)n;
+        }
+    }
+
+    printf("Prefix Sum (Scan) Example\n");
+    printf("-------------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+    printf("Online CPUs: %d\n", simd_parallel_cpu_count());
+
+    int32_t* in = (int32_t*)neon_malloc(max_len * sizeof(int32_t));
+    int32_t* out = (int32_t*)neon_malloc(max_len * sizeof(int32_t));
+    int32_t* ref = (int32_t*)neon_malloc(max_len * sizeof(int32_t));
+
+    if (!in || !out || !ref) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    fill_random_int32(in, max_len, -1000, 1000);
+    memset(out, 0, max_len * sizeof(int32_t));
+    memset(ref, 0, max_len * sizeof(int32_t));
+
+    printf("\nInclusive S32 scan, GB/s (read + write)\n");
+    printf("%-12s %-10s %-10s %-10s %-10s %-10s\n", "Elements", "memcpy", "Scalar", "NEON", "Parallel", "vs memcpy");
+    printf("---------------------------------------------------------------------\n");
+
+    int errors = 0;
+    // Sizes grow 8x from L1-resident up to max_len (always measured last)
+    for (size_t len = 4096;; len *= 8) {
+        if (len > max_len) len = max_len;
+        size_t bytes = len * sizeof(int32_t);
+        int iterations = (int)(((size_t)256 << 20) / bytes);
+        if (iterations < 3) iterations = 3;
+
+        perf_timer_t* copy_timer = timer_create("memcpy");
+        timer_start(copy_timer);
+        for (int i = 0; i < iterations; i++) memcpy(out, in, bytes);
+        timer_stop(copy_timer);
+
+        perf_comparison_t* comp = comparison_create("Scan");
+        timer_start(comp->scalar_timer);
+        for (int i = 0; i < iterations; i++) scalar_scan_s32(in, ref, len);
+        timer_stop(comp->scalar_timer);
+
+        timer_start(comp->simd_timer);
+        for (int i = 0; i < iterations; i++) simd_scan_s32(in, out, len, SIMD_SCAN_INCLUSIVE);
+        timer_stop(comp->simd_timer);
+        if (memcmp(out, ref, bytes) != 0) errors++;
+
+        perf_timer_t* par_timer = timer_create("parallel");
+        timer_start(par_timer);
+        for (int i = 0; i < iterations; i++) simd_scan_parallel_s32(in, out, len, SIMD_SCAN_INCLUSIVE, 0);
+        timer_stop(par_timer);
+        if (memcmp(out, ref, bytes) != 0) errors++;
+
+        double copy_rate = gb_per_s(copy_timer, bytes, iterations);
+        double simd_rate = gb_per_s(comp->simd_timer, bytes, iterations);
+        double par_rate = gb_per_s(par_timer, bytes, iterations);
+        double best = simd_rate > par_rate ? simd_rate : par_rate;
+        printf("%-12zu %-10.2f %-10.2f %-10.2f %-10.2f %.0f%%\n", len, copy_rate,
+               gb_per_s(comp->scalar_timer, bytes, iterations), simd_rate, par_rate,
+               copy_rate > 0.0 ? 100.0 * best / copy_rate : 0.0);
+
+        timer_destroy(copy_timer);
+        timer_destroy(par_timer);
+        comparison_destroy(comp);
+
+        if (len == max_len) break;
+    }
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    // Clean up
+    free(in);
+    free(out);
+    free(ref);
+
+    return errors ? 1 : 0;
+}
@@ -20,7 +20,7 @@ void scalar_rgb_to_gray(const uint8_t* rgb, uint8_t* gray, size_t pixel_count) {
         uint32_t r = pixel[0];
         uint32_t g = pixel[1];
         uint32_t b = pixel[2];
-        gray[i] = (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);  // Fixed-point calculation
+        gray[i] = (uint8_t)((r * 77 + g * 150 + b * 29 + 128) >> 8);  // Fixed-point calculation, rounded
     }
 }
 
@@ -59,8 +59,8 @@ void neon_rgb_to_gray(const uint8_t* rgb, uint8_t* gray, size_t pixel_count) {
         uint16x8_t sum = vaddq_u16(r_contrib, g_contrib);
         sum = vaddq_u16(sum, b_contrib);
         
-        // Divide by 256 (shift right by 8)
-        uint8x8_t gray_pixels = vshrn_n_u16(sum, 8);
+        // Divide by 256 with rounding (shift right by 8)
+        uint8x8_t gray_pixels = vrshrn_n_u16(sum, 8);
         
         // Store the result
         vst1_u8(gray + i * 8, gray_pixels);
@@ -69,7 +69,7 @@ void neon_rgb_to_gray(const uint8_t* rgb, uint8_t* gray, size_t pixel_count) {
     // Handle remaining pixels
     for (size_t i = vec_size * 8; i < pixel_count; i++) {
         const uint8_t* pixel = rgb + i * 3;
-        uint16_t gray_val = (pixel[0] * r_coeff + pixel[1] * g_coeff + pixel[2] * b_coeff) >> 8;
+        uint16_t gray_val = (pixel[0] * r_coeff + pixel[1] * g_coeff + pixel[2] * b_coeff + 128) >> 8;
         gray[i] = (uint8_t)gray_val;
     }
 }
@@ -0,0 +1,195 @@
+/**
+ * sched_bench.c
+ * Microbenchmarks for the work-stealing scheduler: spawn and steal costs,
+ * loop dispatch against a thread per call, and a tiled kernel under each
+ * affinity policy
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "../include/simd_sched.h"
+#include "../include/simd_parallel.h"
+#include "../include/simd_tile.h"
+#include "../include/perf_test.h"
+
+/**
+ * Spawn overhead: naive Fibonacci, one task pair per call
+ */
+typedef struct {
+    int n;
+    long result;
+} fib_t;
+
+static long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+static void fib_task(void* arg) {
+    fib_t* f = (fib_t*)arg;
+    if (f->n < 2) {
+        f->result = f->n;
+        return;
+    }
+    fib_t a = { f->n - 1, 0 }, b = { f->n - 2, 0 };
+    simd_parallel_invoke(fib_task, &a, fib_task, &b);
+    f->result = a.result + b.result;
+}
+
+/**
+ * Dispatch overhead: an empty loop body, one chunk per thread
+ */
+static void empty_range(void* ctx, size_t begin, size_t end) {
+    (void)ctx;
+    (void)begin;
+    (void)end;
+}
+
+static void* empty_thread(void* arg) {
+    return arg;
+}
+
+// The per-call alternative: create and join THREADS threads
+static void dispatch_pthreads(int threads) {
+    pthread_t handles[SIMD_PARALLEL_MAX_THREADS];
+    for (int t = 0; t < threads; t++) pthread_create(&handles[t], NULL, empty_thread, NULL);
+    for (int t = 0; t < threads; t++) pthread_join(handles[t], NULL);
+}
+
+static double ns_per(const perf_timer_t* timer, uint64_t count) {
+    return count ? (double)timer->total_time * 1000.0 / (double)count : 0.0;
+}
+
+int main(int argc, char** argv) {
+    // Default Fibonacci depth and image width
+    int depth = 25;
+    int width = 1920;
+
+    // Allow overriding the image width from command line (height keeps 16:9)
+    if (argc > 1) {
+        width = atoi(argv[1]);
+        if (width < 64) {
+            width = 1920;
+        }
+    }
+    int height = width * 9 / 16;
+
+    printf("Work-Stealing Scheduler Benchmark\n");
+    printf("---------------------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    // CPU topology
+    simd_cpu_t cpus[SIMD_PARALLEL_MAX_THREADS];
+    int count = simd_cpu_topology(NULL, cpus, SIMD_PARALLEL_MAX_THREADS);
+    printf("\nCPUs: %d\n", count);
+    for (int i = 0; i < count; i++) {
+        printf("  cpu%-4d capacity %-8d %s\n", cpus[i].id, cpus[i].capacity, cpus[i].big ? "big" : "little");
+    }
+
+    int errors = 0;
+    printf("\nPool workers: %d (+ calling thread)\n", simd_sched_workers());
+
+    // Spawn and steal costs
+    perf_comparison_t* comp = comparison_create("Fibonacci");
+    timer_start(comp->scalar_timer);
+    long expected = fib_serial(depth);
+    timer_stop(comp->scalar_timer);
+
+    simd_sched_reset_stats();
+    fib_t f = { depth, 0 };
+    timer_start(comp->simd_timer);
+    fib_task(&f);
+    timer_stop(comp->simd_timer);
+    simd_sched_stats_t stats;
+    simd_sched_get_stats(&stats);
+    errors += f.result != expected;
+
+    uint64_t tasks = stats.spawned + stats.inline_runs;
+    printf("\nfib(%d), one spawn per call:\n", depth);
+    printf("  %-28s %.1f ms\n", "Serial recursion", comp->scalar_timer->total_time / 1000.0);
+    printf("  %-28s %.1f ms\n", "parallel_invoke", comp->simd_timer->total_time / 1000.0);
+    printf("  %-28s %llu (%llu inline)\n", "Tasks", (unsigned long long)tasks, (unsigned long long)stats.inline_runs);
+    printf("  %-28s %llu (%.3f%%), %llu failed attempts\n", "Stolen", (unsigned long long)stats.stolen,
+           tasks ? 100.0 * stats.stolen / tasks : 0.0, (unsigned long long)stats.steal_failures);
+    printf("  %-28s %.1f ns\n", "Overhead per spawn",
+           tasks ? ((double)comp->simd_timer->total_time - comp->scalar_timer->total_time) * 1000.0 / tasks : 0.0);
+    comparison_destroy(comp);
+
+    // Loop dispatch: scheduler against a thread per call
+    int threads = simd_sched_workers() + 1;
+    const int calls = 2000;
+    perf_timer_t* pool = timer_create("parallel_for");
+    timer_start(pool);
+    for (int i = 0; i < calls; i++) simd_parallel_for(0, (size_t)threads, 1, empty_range, NULL);
+    timer_stop(pool);
+
+    perf_timer_t* spawn = timer_create("pthread_create");
+    timer_start(spawn);
+    for (int i = 0; i < calls / 10; i++) dispatch_pthreads(threads);
+    timer_stop(spawn);
+
+    printf("\nEmpty loop over %d chunks:\n", threads);
+    printf("  %-28s %.0f ns per call\n", "simd_parallel_for", ns_per(pool, (uint64_t)calls));
+    printf("  %-28s %.0f ns per call\n", "pthread create + join", ns_per(spawn, (uint64_t)calls / 10));
+    timer_destroy(pool);
+    timer_destroy(spawn);
+
+    // Tiled Sobel under each affinity policy
+    size_t pixels = (size_t)width * height;
+    uint8_t* src = (uint8_t*)neon_malloc(pixels);
+    uint8_t* expected_edges = (uint8_t*)neon_malloc(pixels);
+    uint8_t* edges = (uint8_t*)neon_malloc(pixels);
+    if (!src || !expected_edges || !edges) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+    fill_random_uint8(src, pixels);
+
+    simd_tiling_t serial = { .halo = 1, .border = SIMD_BORDER_REPLICATE, .threads = 1 };
+    simd_tile_run(src, expected_edges, width, height, &serial, simd_tile_sobel_u8, NULL);
+
+    static const simd_affinity_t policies[] = { SIMD_AFFINITY_NONE, SIMD_AFFINITY_SPREAD, SIMD_AFFINITY_BIG,
+                                                SIMD_AFFINITY_LITTLE, SIMD_AFFINITY_NUMA };
+    static const char* policy_names[] = { "None", "Spread", "Big", "Little", "NUMA" };
+    const int iterations = 10;
+
+    printf("\nTiled Sobel %dx%d:\n", width, height);
+    printf("  %-10s %-10s %-12s %-10s\n", "Policy", "Workers", "Mpx/s", "Stolen");
+    for (int p = 0; p < 5; p++) {
+        simd_sched_config_t config = { 0, policies[p], NULL, NULL };
+        simd_sched_init(&config);
+        simd_tiling_t tiling = { .halo = 1, .border = SIMD_BORDER_REPLICATE, .threads = 0 };
+
+        simd_sched_reset_stats();
+        perf_timer_t* timer = timer_create(policy_names[p]);
+        timer_start(timer);
+        for (int i = 0; i < iterations; i++) simd_tile_run(src, edges, width, height, &tiling, simd_tile_sobel_u8, NULL);
+        timer_stop(timer);
+        simd_sched_get_stats(&stats);
+        errors += memcmp(edges, expected_edges, pixels) != 0;
+
+        printf("  %-10s %-10d %-12.1f %-10llu\n", policy_names[p], simd_sched_workers(),
+               timer->total_time ? (double)pixels * iterations / timer->total_time : 0.0,
+               (unsigned long long)stats.stolen);
+        timer_destroy(timer);
+    }
+
+    // Clean up
+    simd_sched_shutdown();
+    free(src);
+    free(expected_edges);
+    free(edges);
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
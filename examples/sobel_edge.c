@@ -11,6 +11,8 @@
 #include <arm_neon.h>
 #include "../include/platform_detect.h"
 #include "../include/neon_utils.h"
+#include "../include/simd_gradient.h"
+#include "../include/simd_io.h"
 #include "../include/perf_test.h"
 
 // Scalar (non-SIMD) implementation for comparison
@@ -206,19 +208,97 @@ void generate_test_image(uint8_t* gray, int width, int height) {
 
 // Function to save a grayscale image as PGM (for visualization)
 void save_pgm(const char* filename, const uint8_t* gray, int width, int height) {
-    FILE* file = fopen(filename, "wb");
-    if (!file) {
-        printf("ERROR: Could not open file %s for writing.\n", filename);
-        return;
+    simd_image_t image = simd_image_packed((void*)gray, width, height, 1, 1);
+    if (!simd_pnm_write(filename, &image)) {
+        printf("ERROR: Could not write file %s.\n", filename);
     }
-    
-    // Write PGM header
-    fprintf(file, "P5\n%d %d\n255\n", width, height);
-    
-    // Write image data
-    fwrite(gray, 1, width * height, file);
-    
-    fclose(file);
+}
+
+static double mpix_per_s(const perf_timer_t* timer, size_t pixels, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)pixels * iterations / (double)timer->total_time;
+}
+
+// Compare the gradient module against neon_sobel_edge; returns the number of
+// interior pixels whose L2 magnitude disagrees with the scalar reference
+int benchmark_gradient_module(const uint8_t* input, const uint8_t* reference,
+                              int width, int height, int iterations) {
+    size_t pixels = (size_t)width * height;
+    uint8_t* edges = (uint8_t*)neon_malloc(pixels);
+    int16_t* gx = (int16_t*)neon_malloc(pixels * sizeof(int16_t));
+    int16_t* gy = (int16_t*)neon_malloc(pixels * sizeof(int16_t));
+    uint16_t* mag = (uint16_t*)neon_malloc(pixels * sizeof(uint16_t));
+    uint8_t* dir = (uint8_t*)neon_malloc(pixels);
+
+    if (!edges || !gx || !gy || !mag || !dir) {
+        printf("ERROR: Memory allocation failed.\n");
+        free(edges);
+        free(gx);
+        free(gy);
+        free(mag);
+        free(dir);
+        return 1;
+    }
+
+    printf("\nGradient module (simd_gradient) vs neon_sobel_edge\n");
+    printf("%-40s %-12s\n", "Variant", "Mpixel/s");
+    printf("-----------------------------------------------------\n");
+
+    perf_timer_t* timer = timer_create("neon_sobel_edge");
+    timer_start(timer);
+    for (int i = 0; i < iterations; i++) {
+        neon_sobel_edge(input, edges, width, height);
+    }
+    timer_stop(timer);
+    printf("%-40s %-12.1f\n", "neon_sobel_edge (L1/2, no borders)", mpix_per_s(timer, pixels, iterations));
+    timer_destroy(timer);
+
+    static const struct {
+        const char* name;
+        simd_gradient_op_t op;
+        int planes;             // 1 = Gx/Gy, 2 = magnitude, 4 = orientation
+        simd_magnitude_t norm;
+    } variants[] = {
+        { "Sobel magnitude L1", SIMD_GRADIENT_SOBEL, 2, SIMD_MAGNITUDE_L1 },
+        { "Sobel magnitude L2", SIMD_GRADIENT_SOBEL, 2, SIMD_MAGNITUDE_L2 },
+        { "Sobel Gx/Gy planes", SIMD_GRADIENT_SOBEL, 1, SIMD_MAGNITUDE_L1 },
+        { "Sobel L2 + 4 orientation bins", SIMD_GRADIENT_SOBEL, 6, SIMD_MAGNITUDE_L2 },
+        { "Scharr Gx/Gy + L2 + 9 bins", SIMD_GRADIENT_SCHARR, 7, SIMD_MAGNITUDE_L2 }
+    };
+
+    for (int v = 0; v < 5; v++) {
+        int planes = variants[v].planes;
+        timer = timer_create(variants[v].name);
+        timer_start(timer);
+        for (int i = 0; i < iterations; i++) {
+            simd_gradient(input, width, height, variants[v].op, SIMD_BORDER_REPLICATE, 0,
+                          (planes & 1) ? gx : NULL, (planes & 1) ? gy : NULL,
+                          (planes & 2) ? mag : NULL, variants[v].norm,
+                          (planes & 4) ? dir : NULL, variants[v].op == SIMD_GRADIENT_SCHARR ? 9 : 4);
+        }
+        timer_stop(timer);
+        printf("%-40s %-12.1f\n", variants[v].name, mpix_per_s(timer, pixels, iterations));
+        timer_destroy(timer);
+    }
+
+    // Interior pixels: rounded L2 vs the truncated scalar sqrt
+    simd_gradient(input, width, height, SIMD_GRADIENT_SOBEL, SIMD_BORDER_REPLICATE, 0,
+                  NULL, NULL, mag, SIMD_MAGNITUDE_L2, NULL, 0);
+    int errors = 0;
+    for (int y = 1; y < height - 1; y++) {
+        for (int x = 1; x < width - 1; x++) {
+            int m = mag[y * width + x] > 255 ? 255 : mag[y * width + x];
+            if (abs(m - reference[y * width + x]) > 1) errors++;
+        }
+    }
+    printf("Gradient module verification: %d errors\n", errors);
+
+    free(edges);
+    free(gx);
+    free(gy);
+    free(mag);
+    free(dir);
+    return errors;
 }
 
 // Main function
@@ -313,11 +393,14 @@ int main(int argc, char** argv) {
     // Print performance comparison
     comparison_print(comp);
     
+    // Library gradient module against the hand-written kernel above
+    int gradient_errors = benchmark_gradient_module(input, output_scalar, width, height, iterations);
+    
     // Clean up
     free(input);
     free(output_neon);
     free(output_scalar);
     comparison_destroy(comp);
     
-    return 0;
+    return gradient_errors ? 1 : 0;
 }
@@ -0,0 +1,140 @@
+/**
+ * stream_compaction.c
+ * Demonstrates predicate-driven stream compaction using ARM NEON SIMD
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_filter.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementation for comparison: branch per element
+size_t scalar_filter_gt_f32(const float* a, float threshold, float* values, uint32_t* indices, size_t len) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (a[i] > threshold) {
+            values[count] = a[i];
+            indices[count] = (uint32_t)i;
+            count++;
+        }
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    // Default stream size
+    size_t stream_size = 4 * 1024 * 1024;  // 4M readings
+
+    // Allow overriding stream size from command line
+    if (argc > 1) {
+        stream_size = atoi(argv[1]);
+        if (stream_size <= 0) {
+            stream_size = 4 * 1024 * 1024;
+        }
+    }
+
+    printf("Stream Compaction Example\n");
+    printf("------------------------\n");
+    printf("Stream size: %zu elements\n", stream_size);
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    // Allocate aligned memory
+    float* readings = (float*)neon_malloc(stream_size * sizeof(float));
+    float* values = (float*)neon_malloc(stream_size * sizeof(float));
+    uint32_t* indices = (uint32_t*)neon_malloc(stream_size * sizeof(uint32_t));
+    uint64_t* bits = (uint64_t*)neon_malloc((stream_size + 63) / 64 * sizeof(uint64_t));
+
+    if (!readings || !values || !indices || !bits) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+
+    // Uniform readings in [0, 1) so a threshold of t selects (1 - t) of them
+    srand(42);
+    fill_random_float(readings, stream_size, 0.0f, 1.0f);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 10;
+    int errors = 0;
+
+    printf("\n%-12s %-12s %-14s %-14s %-14s %-10s\n",
+           "Selectivity", "Selected", "Scalar (ms)", "SIMD (ms)", "SIMD Melem/s", "Speedup");
+    printf("-------------------------------------------------------------------------------\n");
+
+    // Sweep selectivity from 0% to 100% in 10% steps
+    for (int pct = 0; pct <= 100; pct += 10) {
+        float threshold = 1.0f - pct / 100.0f;
+        if (pct == 100) threshold = -1.0f;
+
+        perf_comparison_t* comp = comparison_create("Filter GT");
+        size_t simd_count = 0;
+        size_t scalar_count = 0;
+
+        // Filter using SIMD (values and indices)
+        timer_start(comp->simd_timer);
+        for (int i = 0; i < iterations; i++) {
+            simd_count = simd_filter_gt_f32(readings, threshold, values, indices, stream_size);
+        }
+        timer_stop(comp->simd_timer);
+
+        // Filter using scalar code
+        timer_start(comp->scalar_timer);
+        for (int i = 0; i < iterations; i++) {
+            scalar_count = scalar_filter_gt_f32(readings, threshold, values, indices, stream_size);
+        }
+        timer_stop(comp->scalar_timer);
+
+        if (simd_count != scalar_count) {
+            errors++;
+        }
+
+        comparison_calculate(comp);
+        double simd_ms = comp->simd_timer->total_time / 1000.0 / iterations;
+        double scalar_ms = comp->scalar_timer->total_time / 1000.0 / iterations;
+        double throughput = simd_ms > 0.0 ? stream_size / (simd_ms * 1000.0) : 0.0;
+
+        printf("%-12d %-12zu %-14.3f %-14.3f %-14.1f %-10.2f\n",
+               pct, simd_count, scalar_ms, simd_ms, throughput, comp->speedup);
+
+        comparison_destroy(comp);
+    }
+
+    // Packed bitmask and popcount statistics at 50% selectivity
+    perf_timer_t* bits_timer = timer_create("Pack + popcount");
+    simd_filter_stats_t stats = { 0, 0, 0.0 };
+
+    timer_start(bits_timer);
+    for (int i = 0; i < iterations; i++) {
+        simd_cmpgt_n_bits_f32(readings, 0.5f, bits, stream_size);
+        stats = simd_selectivity_bits(bits, stream_size);
+    }
+    timer_stop(bits_timer);
+
+    printf("\nPacked bitmask: %zu bytes for %zu elements (vs %zu bytes as uint32 masks)\n",
+           (stream_size + 63) / 64 * sizeof(uint64_t), stream_size, stream_size * sizeof(uint32_t));
+    printf("Selectivity at threshold 0.5: %.4f (%zu of %zu)\n",
+           stats.selectivity, stats.selected, stats.total);
+    timer_print(bits_timer);
+
+    printf("\nVerification: %d mismatched counts\n", errors);
+
+    // Clean up
+    free(readings);
+    free(values);
+    free(indices);
+    free(bits);
+    timer_destroy(bits_timer);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * tiled_stencil.c
+ * Demonstrates tiled, multi-threaded stencil execution using NEON
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <string.h>
+#include "../include/simd_tile.h"
+#include "../include/simd_ops.h"
+#include "../include/simd_parallel.h"
+#include "../include/perf_test.h"
+
+// Scalar (non-SIMD) implementation for comparison: 3x3 box with replicated borders
+void scalar_box3x3(const uint8_t* src, uint8_t* dst, int width, int height) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int sum = 0;
+            for (int j = -1; j <= 1; j++) {
+                int yy = y + j < 0 ? 0 : (y + j >= height ? height - 1 : y + j);
+                for (int i = -1; i <= 1; i++) {
+                    int xx = x + i < 0 ? 0 : (x + i >= width ? width - 1 : x + i);
+                    sum += src[yy * width + xx];
+                }
+            }
+            dst[y * width + x] = (uint8_t)((2 * sum + 9) / 18);
+        }
+    }
+}
+
+static double mpix_per_s(const perf_timer_t* timer, size_t pixels, int iterations) {
+    if (timer->total_time == 0) return 0.0;
+    return (double)pixels * iterations / (double)timer->total_time;
+}
+
+int main(int argc, char** argv) {
+    // Default image sizes: 4K and 8K
+    int widths[2] = { 3840, 7680 };
+    int sizes = 2;
+
+    // Allow overriding image width from command line (height keeps 16:9)
+    if (argc > 1) {
+        widths[0] = atoi(argv[1]);
+        if (widths[0] <= 0) {
+            widths[0] = 3840;
+        }
+        sizes = 1;
+    }
+
+    printf("Tiled Stencil Example\n");
+    printf("---------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+    int cpus = simd_parallel_cpu_count();
+    printf("Online CPUs: %d, L2: %zu KiB\n", cpus, simd_tile_l2_size() / 1024);
+
+    // Number of iterations for more accurate timing
+    const int iterations = 5;
+    int errors = 0;
+
+    for (int s = 0; s < sizes; s++) {
+        int width = widths[s];
+        int height = width * 9 / 16;
+        size_t pixels = (size_t)width * height;
+        uint8_t* src = (uint8_t*)neon_malloc(pixels);
+        uint8_t* simd_result = (uint8_t*)neon_malloc(pixels);
+        uint8_t* scalar_result = (uint8_t*)neon_malloc(pixels);
+
+        if (!src || !simd_result || !scalar_result) {
+            printf("ERROR: Memory allocation failed.\n");
+            return 1;
+        }
+
+        fill_random_uint8(src, pixels);
+        printf("\nImage: %dx%d\n", width, height);
+
+        // Whole-image baselines
+        perf_comparison_t* comp = comparison_create("Box 3x3");
+        timer_start(comp->scalar_timer);
+        scalar_box3x3(src, scalar_result, width, height);
+        timer_stop(comp->scalar_timer);
+
+        timer_start(comp->simd_timer);
+        for (int i = 0; i < iterations; i++) simd_blur_gray_3x3(src, simd_result, width, height);
+        timer_stop(comp->simd_timer);
+
+        printf("%-36s %.1f Mpx/s\n", "Scalar box 3x3", mpix_per_s(comp->scalar_timer, pixels, 1));
+        printf("%-36s %.1f Mpx/s\n", "simd_blur_gray_3x3 (row by row)", mpix_per_s(comp->simd_timer, pixels, iterations));
+        comparison_destroy(comp);
+
+        // Tiled kernels from 1 to N workers
+        printf("\n%-10s %-14s %-10s %-14s %-10s\n", "Threads", "Box Mpx/s", "Scaling", "Sobel Mpx/s", "Scaling");
+        printf("------------------------------------------------------------\n");
+
+        double box_base = 0.0, sobel_base = 0.0;
+        for (int t = 1; t <= cpus; t = t < cpus && t * 2 > cpus ? cpus : t * 2) {
+            simd_tiling_t tiling = { .halo = 1, .border = SIMD_BORDER_REPLICATE, .threads = t };
+
+            perf_timer_t* box = timer_create("Tiled box");
+            timer_start(box);
+            for (int i = 0; i < iterations; i++) simd_tile_run(src, simd_result, width, height, &tiling, simd_tile_box3x3_u8, NULL);
+            timer_stop(box);
+            if (memcmp(simd_result, scalar_result, pixels) != 0) errors++;
+
+            perf_timer_t* sobel = timer_create("Tiled Sobel");
+            timer_start(sobel);
+            for (int i = 0; i < iterations; i++) simd_tile_run(src, simd_result, width, height, &tiling, simd_tile_sobel_u8, NULL);
+            timer_stop(sobel);
+
+            double box_rate = mpix_per_s(box, pixels, iterations);
+            double sobel_rate = mpix_per_s(sobel, pixels, iterations);
+            if (t == 1) {
+                box_base = box_rate;
+                sobel_base = sobel_rate;
+            }
+            printf("%-10d %-14.1f %-10.2f %-14.1f %-10.2f\n", t, box_rate, box_base > 0.0 ? box_rate / box_base : 0.0,
+                   sobel_rate, sobel_base > 0.0 ? sobel_rate / sobel_base : 0.0);
+
+            timer_destroy(box);
+            timer_destroy(sobel);
+            if (t == cpus) break;
+        }
+
+        // Clean up
+        free(src);
+        free(simd_result);
+        free(scalar_result);
+    }
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * video_pipeline.c
+ * Demonstrates overlapping frame reads with gray conversion, blur and
+ * Sobel by running them as pipeline stages on separate threads
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/simd_pipeline.h"
+#include "../include/simd_ops.h"
+#include "../include/simd_tile.h"
+#include "../include/perf_test.h"
+
+#define VIDEO_FILE "video_pipeline_input.rgb"
+
+/**
+ * Frame layout: RGB input, then gray, blurred and edge planes
+ */
+typedef struct {
+    int width;
+    int height;
+    FILE* file;                 // Read stage
+    int frames;
+    uint32_t* checksums;        // Per frame index, written by the sink
+} video_t;
+
+static uint8_t* plane(const video_t* v, simd_frame_t* f, int i) {
+    size_t pixels = (size_t)v->width * v->height;
+    return f->data + (i == 0 ? 0 : pixels * (2 + i));
+}
+
+static bool read_stage(void* ctx, simd_frame_t* f) {
+    video_t* v = (video_t*)ctx;
+    size_t bytes = (size_t)v->width * v->height * 3;
+    return fread(f->data, 1, bytes, v->file) == bytes;
+}
+
+static bool gray_stage(void* ctx, simd_frame_t* f) {
+    video_t* v = (video_t*)ctx;
+    simd_rgb_to_gray(plane(v, f, 0), plane(v, f, 1), (size_t)v->width * v->height);
+    return true;
+}
+
+static bool blur_stage(void* ctx, simd_frame_t* f) {
+    video_t* v = (video_t*)ctx;
+    simd_blur_gray_3x3(plane(v, f, 1), plane(v, f, 2), v->width, v->height);
+    return true;
+}
+
+static bool sobel_stage(void* ctx, simd_frame_t* f) {
+    video_t* v = (video_t*)ctx;
+    simd_tiling_t tiling = { .halo = 1, .threads = 1 };
+    simd_tile_run(plane(v, f, 2), plane(v, f, 3), v->width, v->height, &tiling, simd_tile_sobel_u8, NULL);
+    return true;
+}
+
+static bool sink_stage(void* ctx, simd_frame_t* f) {
+    video_t* v = (video_t*)ctx;
+    const uint8_t* edges = plane(v, f, 3);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < (size_t)v->width * v->height; i++) sum = sum * 31 + edges[i];
+    if (f->index < (uint64_t)v->frames) v->checksums[f->index] = sum;
+    return true;
+}
+
+// Run the five stages with the given fusion; returns false on failure
+static bool run_video(video_t* v, const bool fuse[5], simd_pipeline_stats_t* stats) {
+    simd_stage_t stages[5] = {
+        { "read", read_stage, v, fuse[0] },
+        { "rgb to gray", gray_stage, v, fuse[1] },
+        { "blur 3x3", blur_stage, v, fuse[2] },
+        { "sobel", sobel_stage, v, fuse[3] },
+        { "checksum", sink_stage, v, fuse[4] },
+    };
+    simd_pipeline_config_t config = { (size_t)v->width * v->height * 6, 0, 0 };
+    v->file = fopen(VIDEO_FILE, "rb");
+    if (!v->file) return false;
+    bool ok = simd_pipeline_run(stages, 5, &config, stats);
+    fclose(v->file);
+    return ok;
+}
+
+static void print_stages(const simd_pipeline_stats_t* stats) {
+    printf("  %-14s %-10s %-10s %-10s %-8s %-12s %-12s\n", "Stage", "Avg us", "Max us", "Queue avg", "max",
+           "Starved ms", "Blocked ms");
+    for (int s = 0; s < stats->stages; s++) {
+        const simd_stage_stats_t* st = &stats->stage[s];
+        printf("  %-14s %-10.1f %-10.1f %-10.2f %-8d %-12.1f %-12.1f\n", st->name, st->latency_avg_us,
+               st->latency_max_us, st->queue_avg, st->queue_max, st->starved_ms, st->blocked_ms);
+    }
+}
+
+int main(int argc, char** argv) {
+    // Default video: 60 frames of 1280x720 RGB
+    int width = 1280;
+    int frames = 60;
+
+    // Allow overriding frame width from command line (height keeps 16:9)
+    if (argc > 1) {
+        width = atoi(argv[1]);
+        if (width < 64) {
+            width = 1280;
+        }
+    }
+    int height = width * 9 / 16;
+    size_t frame_bytes = (size_t)width * height * 3;
+
+    printf("Video Pipeline Example\n");
+    printf("----------------------\n");
+
+    // Check if NEON is supported
+    if (!check_neon_support()) {
+        printf("ERROR: ARM NEON is not supported on this platform.\n");
+        return 1;
+    }
+
+    // Print platform information
+    print_platform_info();
+
+    // Input video: a moving random pattern, one raw RGB frame after another
+    uint8_t* pattern = (uint8_t*)neon_malloc(frame_bytes + (size_t)frames * 3);
+    uint32_t* expected = (uint32_t*)calloc((size_t)frames, sizeof(uint32_t));
+    uint32_t* checksums = (uint32_t*)calloc((size_t)frames, sizeof(uint32_t));
+    if (!pattern || !expected || !checksums) {
+        printf("ERROR: Memory allocation failed.\n");
+        return 1;
+    }
+    fill_random_uint8(pattern, frame_bytes + (size_t)frames * 3);
+    FILE* out = fopen(VIDEO_FILE, "wb");
+    for (int i = 0; out && i < frames; i++) fwrite(pattern + (size_t)i * 3, 1, frame_bytes, out);
+    if (!out || fclose(out) != 0) {
+        printf("ERROR: Could not write %s.\n", VIDEO_FILE);
+        return 1;
+    }
+
+    // Thread mappings: all stages on one thread is the sequential baseline
+    static const bool mappings[][5] = {
+        { false, true, true, true, true },
+        { false, false, true, true, true },
+        { false, false, false, false, false },
+    };
+    static const char* mapping_names[] = { "Sequential", "Read | compute", "Thread per stage" };
+
+    printf("\n%d frames of %dx%d RGB\n", frames, width, height);
+    printf("%-18s %-8s %-10s %-10s %-14s %-10s\n", "Mapping", "Threads", "FPS", "Speedup", "Latency avg us",
+           "max us");
+    printf("-------------------------------------------------------------------------\n");
+
+    int errors = 0;
+    double base_fps = 0.0;
+    simd_pipeline_stats_t stats[3];
+    video_t video = { width, height, NULL, frames, expected };
+    for (int m = 0; m < 3; m++) {
+        video.checksums = m == 0 ? expected : checksums;
+        memset(video.checksums, 0, (size_t)frames * sizeof(uint32_t));
+        if (!run_video(&video, mappings[m], &stats[m]) || stats[m].frames != (uint64_t)frames) {
+            printf("ERROR: Pipeline run failed.\n");
+            errors++;
+            continue;
+        }
+        if (m == 0) base_fps = stats[m].fps;
+        else errors += memcmp(checksums, expected, (size_t)frames * sizeof(uint32_t)) != 0;
+        printf("%-18s %-8d %-10.1f %-10.2f %-14.1f %-10.1f\n", mapping_names[m], stats[m].threads, stats[m].fps,
+               base_fps > 0.0 ? stats[m].fps / base_fps : 0.0, stats[m].latency_avg_us, stats[m].latency_max_us);
+    }
+
+    for (int m = 1; m < 3 && !errors; m++) {
+        printf("\n%s:\n", mapping_names[m]);
+        print_stages(&stats[m]);
+    }
+    printf("\nQueue depth of the first stage is the number of free frame buffers.\n");
+    printf("Blocked time is backpressure: a full queue downstream, or no free frame to read into.\n");
+
+    // Clean up
+    remove(VIDEO_FILE);
+    free(pattern);
+    free(expected);
+    free(checksums);
+
+    printf("\nVerification: %s\n", errors ? "FAILED" : "OK");
+
+    return errors ? 1 : 0;
+}
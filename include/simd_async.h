@@ -0,0 +1,91 @@
+/**
+ * simd_async.h
+ * Asynchronous kernel calls on the scheduler pool, with batching and
+ * cancellation (simd_async.hpp wraps them as C++20 awaitables)
+ */
+#ifndef SIMD_ASYNC_H
+#define SIMD_ASYNC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "simd_sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calls touching fewer bytes than this share dispatches with their neighbours
+#define SIMD_ASYNC_BATCH_BYTES (64 * 1024)
+
+// Most calls one dispatch runs
+#define SIMD_ASYNC_BATCH_MAX 32
+
+// Latency histogram buckets: [2^i, 2^(i+1)) microseconds, the first from 0
+// and the last open-ended
+#define SIMD_ASYNC_LATENCY_BUCKETS 24
+
+typedef enum {
+    SIMD_ASYNC_DONE,            // The call ran to completion
+    SIMD_ASYNC_CANCELLED        // The call was cancelled before it started
+} simd_async_status_t;
+
+// Runs once per call, on the thread that finished or cancelled it
+typedef void (*simd_async_done_fn_t)(void* ctx, simd_async_status_t status);
+
+/**
+ * One call in flight. The caller provides the storage, which must stay
+ * valid until the completion callback has started; the fields belong to
+ * simd_async_submit and simd_async_cancel.
+ */
+typedef struct simd_async_op {
+    simd_task_fn_t fn;
+    void* ctx;
+    size_t bytes;
+    simd_async_done_fn_t done;
+    void* done_ctx;
+    uint64_t submit_ns;
+    int queued;
+    struct simd_async_op* next;
+} simd_async_op_t;
+
+/**
+ * Submission
+ * Calls queue in submission order. A dispatch, posted to the pool when
+ * the queue becomes non-empty, takes either one call of at least
+ * SIMD_ASYNC_BATCH_BYTES or a run of smaller calls up to that many bytes
+ * and runs them back to back, so small calls arriving together cost one
+ * wake-up between them. A dispatch that leaves calls behind posts the
+ * next one before running its own, so large calls and batches proceed on
+ * several workers at once. Nothing waits for a batch to fill up.
+ */
+
+// Queue FN(ctx), which touches about BYTES of data; DONE(done_ctx, status)
+// follows exactly once. With no pool workers the call runs inline.
+void simd_async_submit(simd_async_op_t* op, simd_task_fn_t fn, void* ctx, size_t bytes,
+                       simd_async_done_fn_t done, void* done_ctx);
+
+// Cancel a call that has not started: its completion runs here with
+// SIMD_ASYNC_CANCELLED. Returns false once it has started (or finished).
+bool simd_async_cancel(simd_async_op_t* op);
+
+typedef struct {
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t cancelled;
+    uint64_t dispatches;        // Dispatches that ran at least one call
+    uint64_t batched;           // Calls that shared their dispatch
+    uint64_t latency[SIMD_ASYNC_LATENCY_BUCKETS];   // Submission to completion
+} simd_async_stats_t;
+
+void simd_async_get_stats(simd_async_stats_t* stats);
+void simd_async_reset_stats(void);
+
+// Histogram bucket of a latency in nanoseconds
+int simd_async_latency_bucket(uint64_t ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_ASYNC_H */
@@ -0,0 +1,126 @@
+/**
+ * simd_async.hpp
+ * C++20 coroutine interface to asynchronous kernel calls (simd_async.h)
+ *
+ *     co_await simd::async(simd_rgb_to_gray, rgb, gray, pixels);
+ *     simd::options dot{ .bytes = 8 * n, .stop = token };
+ *     float d = co_await simd::async(dot, simd_dot_product_f32, a, b, n);
+ *
+ * The call runs on the scheduler pool and the coroutine resumes on the
+ * worker that finished it (or inline when the pool has no workers). A
+ * stop request on options::stop cancels a call that has not started yet;
+ * co_await then throws simd::cancelled.
+ *
+ * Keep simd::options in a named local as above: GCC 12 mis-destroys
+ * temporaries with non-trivial destructors (std::stop_token) built inside
+ * a co_await expression.
+ */
+#ifndef SIMD_ASYNC_HPP
+#define SIMD_ASYNC_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "simd_async.h"
+
+namespace simd {
+
+// Thrown by co_await when the call was cancelled before it started
+struct cancelled : std::exception {
+    const char* what() const noexcept override { return "simd::async call cancelled"; }
+};
+
+struct options {
+    std::size_t bytes = 0;      // Data the call touches; small calls are batched
+    std::stop_token stop = {};  // Cancels the call while it is still queued
+};
+
+/**
+ * Awaitable for one call. It holds the function, its arguments and the
+ * result in the coroutine frame, so a call allocates nothing.
+ */
+template <typename F, typename... Args>
+class async_call {
+public:
+    using result_type = std::invoke_result_t<F&, Args&...>;
+
+    async_call(options opt, F fn, Args... args)
+        : opt_(std::move(opt)), fn_(std::move(fn)), args_(std::move(args)...) {}
+    async_call(const async_call&) = delete;
+    async_call& operator=(const async_call&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    // Returns false (resume at once) when the call completed before the
+    // coroutine could suspend: inline, or cancelled by an earlier stop
+    bool await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        if (opt_.stop.stop_requested()) {
+            status_ = SIMD_ASYNC_CANCELLED;
+            return false;
+        }
+        simd_async_submit(&op_, &async_call::run, this, opt_.bytes, &async_call::finish, this);
+        if (opt_.stop.stop_possible()) stop_.emplace(opt_.stop, canceller{ this });
+        return state_.exchange(suspended, std::memory_order_acq_rel) != completed;
+    }
+
+    result_type await_resume() {
+        if (status_ == SIMD_ASYNC_CANCELLED) throw cancelled();
+        if constexpr (!std::is_void_v<result_type>) return std::move(*result_);
+    }
+
+private:
+    enum state_t { arming, suspended, completed };
+
+    struct canceller {
+        async_call* call;
+        void operator()() const noexcept { simd_async_cancel(&call->op_); }
+    };
+
+    static void run(void* self) {
+        auto* call = static_cast<async_call*>(self);
+        if constexpr (std::is_void_v<result_type>) std::apply(call->fn_, call->args_);
+        else call->result_.emplace(std::apply(call->fn_, call->args_));
+    }
+
+    // Whichever of this and await_suspend comes second resumes the coroutine
+    static void finish(void* self, simd_async_status_t status) {
+        auto* call = static_cast<async_call*>(self);
+        call->status_ = status;
+        if (call->state_.exchange(completed, std::memory_order_acq_rel) == suspended) call->handle_.resume();
+    }
+
+    using stored_result = std::conditional_t<std::is_void_v<result_type>, char, result_type>;
+
+    options opt_;
+    F fn_;
+    std::tuple<Args...> args_;
+    std::optional<stored_result> result_;
+    simd_async_op_t op_ = {};
+    simd_async_status_t status_ = SIMD_ASYNC_DONE;
+    std::coroutine_handle<> handle_;
+    std::atomic<state_t> state_{ arming };
+    std::optional<std::stop_callback<canceller>> stop_;     // Last: destroyed first
+};
+
+template <typename F, typename... Args>
+    requires(!std::is_same_v<std::decay_t<F>, options>)
+async_call<std::decay_t<F>, std::decay_t<Args>...> async(F&& fn, Args&&... args) {
+    return { options{}, std::forward<F>(fn), std::forward<Args>(args)... };
+}
+
+template <typename F, typename... Args>
+async_call<std::decay_t<F>, std::decay_t<Args>...> async(options opt, F&& fn, Args&&... args) {
+    return { std::move(opt), std::forward<F>(fn), std::forward<Args>(args)... };
+}
+
+} // namespace simd
+
+#endif /* SIMD_ASYNC_HPP */
@@ -0,0 +1,86 @@
+/**
+ * simd_batch.h
+ * Batched kernels for many small vectors: many-to-many dot products,
+ * pointer-array add/mul/dot and a coalescer that buffers single calls
+ */
+#ifndef SIMD_BATCH_H
+#define SIMD_BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Many-to-Many Dot Products
+ * OUT[q * nd + d] = dot(QUERIES + q * dim, DB + d * dim) for nq row-major
+ * query vectors against nd row-major database vectors. Every result is
+ * summed in the same order as simd_dot_product_f32, so the two agree
+ * exactly; only the loads, the loop overhead and the horizontal
+ * reductions are shared between neighbouring results.
+ */
+void simd_dot_many_f32(const float* queries, const float* db, float* out,
+                       size_t nq, size_t nd, size_t dim);
+
+/**
+ * Pointer-Array Batches
+ * COUNT independent calls on vectors of LEN elements each: item i reads
+ * A[i] and B[i] and writes C[i] (or OUT[i] for dot products). Outputs may
+ * alias their own item's inputs, as with the single calls.
+ */
+
+void simd_dot_batch_f32(const float* const* a, const float* const* b, float* out,
+                        size_t count, size_t len);
+void simd_add_batch_f32(const float* const* a, const float* const* b, float* const* c,
+                        size_t count, size_t len);
+void simd_mul_batch_f32(const float* const* a, const float* const* b, float* const* c,
+                        size_t count, size_t len);
+
+/**
+ * Coalescer
+ * Buffers single calls on vectors of one fixed length and runs them as
+ * pointer-array batches when a buffer fills or on an explicit flush.
+ * Queued calls must be independent: none may read what another queued
+ * call writes, and no output is valid before the flush that runs it.
+ * A coalescer belongs to one thread.
+ */
+typedef struct simd_coalescer simd_coalescer_t;
+
+// Coalescer for LEN-element vectors buffering up to CAPACITY calls of
+// each kind (NULL on allocation failure)
+simd_coalescer_t* simd_coalescer_create(size_t len, size_t capacity);
+
+// Flushes pending calls, then frees the coalescer
+void simd_coalescer_destroy(simd_coalescer_t* co);
+
+// Queue *OUT = dot(A, B)
+void simd_coalescer_dot_f32(simd_coalescer_t* co, const float* a, const float* b, float* out);
+
+// Queue C = A + B and C = A * B
+void simd_coalescer_add_f32(simd_coalescer_t* co, const float* a, const float* b, float* c);
+void simd_coalescer_mul_f32(simd_coalescer_t* co, const float* a, const float* b, float* c);
+
+// Run every pending call; returns how many ran
+size_t simd_coalescer_flush(simd_coalescer_t* co);
+
+// Calls queued and not yet run
+size_t simd_coalescer_pending(const simd_coalescer_t* co);
+
+typedef struct {
+    uint64_t calls;             // Calls run
+    uint64_t flushes;           // Flushes that ran at least one call
+    uint64_t full;              // Of those, started by a full buffer
+} simd_coalescer_stats_t;
+
+void simd_coalescer_get_stats(const simd_coalescer_t* co, simd_coalescer_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_BATCH_H */
@@ -0,0 +1,121 @@
+/**
+ * simd_bitmap.h
+ * Packed bitmaps (1 bit per element) built from NEON comparisons, with
+ * bitwise predicate algebra for columnar filtering
+ */
+#ifndef SIMD_BITMAP_H
+#define SIMD_BITMAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bitmap Type
+ * Bit i lives in bit (i % 64) of words[i / 64]. Bits past len in the last
+ * word are always kept clear, so counts and NOT stay exact.
+ */
+typedef struct {
+    uint64_t* words;
+    size_t len;         // Number of bits (elements)
+    size_t word_count;  // (len + 63) / 64
+} simd_bitmap_t;
+
+// Comparison predicates used to build bitmaps
+typedef enum {
+    SIMD_CMP_GT,
+    SIMD_CMP_GE,
+    SIMD_CMP_LT,
+    SIMD_CMP_LE,
+    SIMD_CMP_EQ,
+    SIMD_CMP_NE
+} simd_cmp_op_t;
+
+// Create a zeroed bitmap with len bits (NULL on allocation failure)
+simd_bitmap_t* simd_bitmap_create(size_t len);
+
+// Free a bitmap
+void simd_bitmap_destroy(simd_bitmap_t* bm);
+
+// Clear all bits / set all bits
+void simd_bitmap_clear(simd_bitmap_t* bm);
+void simd_bitmap_fill(simd_bitmap_t* bm);
+
+// Single-bit access
+static inline int simd_bitmap_get(const simd_bitmap_t* bm, size_t i) {
+    return (int)((bm->words[i / 64] >> (i % 64)) & 1);
+}
+
+static inline void simd_bitmap_set(simd_bitmap_t* bm, size_t i) {
+    bm->words[i / 64] |= (uint64_t)1 << (i % 64);
+}
+
+static inline void simd_bitmap_reset(simd_bitmap_t* bm, size_t i) {
+    bm->words[i / 64] &= ~((uint64_t)1 << (i % 64));
+}
+
+/**
+ * Bitmaps From Comparisons
+ * bm[i] = (A[i] op value) for the first bm->len elements of A
+ */
+
+void simd_bitmap_cmp_f32(simd_bitmap_t* bm, const float* a, simd_cmp_op_t op, float value);
+void simd_bitmap_cmp_s32(simd_bitmap_t* bm, const int32_t* a, simd_cmp_op_t op, int32_t value);
+void simd_bitmap_cmp_u8(simd_bitmap_t* bm, const uint8_t* a, simd_cmp_op_t op, uint8_t value);
+
+/**
+ * Predicate Algebra
+ * All operands must have the same length; dst may alias either input.
+ */
+
+// dst = a & b
+void simd_bitmap_and(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b);
+
+// dst = a | b
+void simd_bitmap_or(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b);
+
+// dst = a ^ b
+void simd_bitmap_xor(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b);
+
+// dst = a & ~b
+void simd_bitmap_andnot(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b);
+
+// dst = ~a
+void simd_bitmap_not(simd_bitmap_t* dst, const simd_bitmap_t* a);
+
+/**
+ * Queries and Consumers
+ */
+
+// Number of set bits
+size_t simd_bitmap_count(const simd_bitmap_t* bm);
+
+// Write the index of every set bit in ascending order; returns how many were written
+size_t simd_bitmap_to_indices(const simd_bitmap_t* bm, uint32_t* indices);
+
+// Iterator over set bits
+typedef struct {
+    const simd_bitmap_t* bm;
+    size_t word;       // Index of the word being scanned
+    uint64_t pending;  // Bits of that word not yet returned
+} simd_bitmap_iter_t;
+
+void simd_bitmap_iter_init(simd_bitmap_iter_t* it, const simd_bitmap_t* bm);
+
+// Returns 1 and stores the next set bit in *index, or 0 when exhausted
+int simd_bitmap_iter_next(simd_bitmap_iter_t* it, size_t* index);
+
+// Masked blend: C[i] = bm[i] ? A[i] : B[i]
+void simd_bitmap_select_f32(const simd_bitmap_t* bm, const float* a, const float* b, float* c);
+void simd_bitmap_select_s32(const simd_bitmap_t* bm, const int32_t* a, const int32_t* b, int32_t* c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_BITMAP_H */
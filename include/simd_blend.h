@@ -0,0 +1,79 @@
+/**
+ * simd_blend.h
+ * Alpha blending and Porter-Duff compositing of 8-bit RGBA pixels
+ */
+#ifndef SIMD_BLEND_H
+#define SIMD_BLEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Porter-Duff operators: FG is the source (top) image, BG the destination
+typedef enum {
+    SIMD_COMPOSITE_CLEAR,       // 0
+    SIMD_COMPOSITE_SRC,         // FG
+    SIMD_COMPOSITE_DST,         // BG
+    SIMD_COMPOSITE_SRC_OVER,    // FG + BG * (1 - a_fg)
+    SIMD_COMPOSITE_DST_OVER,    // FG * (1 - a_bg) + BG
+    SIMD_COMPOSITE_SRC_IN,      // FG * a_bg
+    SIMD_COMPOSITE_DST_IN,      // BG * a_fg
+    SIMD_COMPOSITE_SRC_OUT,     // FG * (1 - a_bg)
+    SIMD_COMPOSITE_DST_OUT,     // BG * (1 - a_fg)
+    SIMD_COMPOSITE_SRC_ATOP,    // FG * a_bg + BG * (1 - a_fg)
+    SIMD_COMPOSITE_DST_ATOP,    // FG * (1 - a_bg) + BG * a_fg
+    SIMD_COMPOSITE_XOR,         // FG * (1 - a_bg) + BG * (1 - a_fg)
+    SIMD_COMPOSITE_PLUS         // min(FG + BG, 1)
+} simd_composite_op_t;
+
+/**
+ * Alpha Blending
+ * Four-byte pixels with alpha in the last byte (RGBA or BGRA). Every
+ * product is divided by 255 with exact rounding. DST may alias FG or BG.
+ */
+
+// Straight (non-premultiplied) alpha over: color = lerp(BG, FG, a_fg),
+// alpha = a_fg + a_bg * (1 - a_fg). The color is exact Porter-Duff over
+// when BG is opaque, e.g. an overlay on a camera frame
+void simd_blend_over_rgba(const uint8_t* fg, const uint8_t* bg, uint8_t* dst, size_t pixel_count);
+
+// Premultiplied alpha over: every channel = FG + BG * (1 - a_fg)
+void simd_blend_over_premul_rgba(const uint8_t* fg, const uint8_t* bg, uint8_t* dst, size_t pixel_count);
+
+// Constant-alpha cross-fade of all four channels: A * (1 - alpha) + B * alpha
+void simd_crossfade_rgba(const uint8_t* a, const uint8_t* b, uint8_t alpha, uint8_t* dst, size_t pixel_count);
+
+// Multiply color by alpha (straight to premultiplied); DST may be SRC
+void simd_premultiply_rgba(const uint8_t* src, uint8_t* dst, size_t pixel_count);
+
+/**
+ * Porter-Duff Compositing
+ * Premultiplied pixels; all four channels use the operator's factors
+ * and saturate at 255.
+ */
+
+void simd_composite_rgba(const uint8_t* fg, const uint8_t* bg, simd_composite_op_t op, uint8_t* dst, size_t pixel_count);
+
+/**
+ * Strided Views
+ * The same operations on 4-channel u8 views of equal size.
+ */
+
+void simd_blend_over_rgba_view(const simd_image_t* fg, const simd_image_t* bg, const simd_image_t* dst);
+void simd_blend_over_premul_rgba_view(const simd_image_t* fg, const simd_image_t* bg, const simd_image_t* dst);
+void simd_crossfade_rgba_view(const simd_image_t* a, const simd_image_t* b, uint8_t alpha, const simd_image_t* dst);
+void simd_premultiply_rgba_view(const simd_image_t* src, const simd_image_t* dst);
+void simd_composite_rgba_view(const simd_image_t* fg, const simd_image_t* bg, simd_composite_op_t op,
+                              const simd_image_t* dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_BLEND_H */
@@ -0,0 +1,51 @@
+/**
+ * simd_border.h
+ * Border (out-of-image) handling shared by the neighborhood image kernels
+ */
+#ifndef SIMD_BORDER_H
+#define SIMD_BORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Border modes, shown for a row "abcdef" extended by 3 on each side
+ */
+typedef enum {
+    SIMD_BORDER_REPLICATE,  // aaa|abcdef|fff
+    SIMD_BORDER_REFLECT,    // cba|abcdef|fed
+    SIMD_BORDER_CONSTANT,   // vvv|abcdef|vvv (caller-supplied value)
+    SIMD_BORDER_WRAP        // def|abcdef|abc
+} simd_border_t;
+
+/**
+ * Map coordinate i into [0, n) for the given border mode.
+ * Returns -1 for SIMD_BORDER_CONSTANT when i lies outside the image.
+ */
+static inline int simd_border_index(int i, int n, simd_border_t mode) {
+    if (i >= 0 && i < n) return i;
+
+    switch (mode) {
+        case SIMD_BORDER_REPLICATE:
+            return i < 0 ? 0 : n - 1;
+        case SIMD_BORDER_REFLECT:
+            // Mirror with period 2n until the index lands inside
+            while (i < 0 || i >= n) {
+                if (i < 0) i = -i - 1;
+                if (i >= n) i = 2 * n - i - 1;
+            }
+            return i;
+        case SIMD_BORDER_WRAP:
+            i %= n;
+            return i < 0 ? i + n : i;
+        default:
+            return -1;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_BORDER_H */
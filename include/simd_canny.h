@@ -0,0 +1,55 @@
+/**
+ * simd_canny.h
+ * Canny edge detection built on the NEON gradient path
+ */
+#ifndef SIMD_CANNY_H
+#define SIMD_CANNY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_gradient.h"
+#include "simd_bitmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Canny Edge Detection
+ * 1. Sobel gradient (replicate border) with L1 or L2 magnitude and the
+ *    direction quantized into 4 sectors
+ * 2. Non-maximum suppression along the gradient direction: a pixel survives
+ *    when its magnitude is > the neighbor before it (row above, or left on
+ *    the same row) and >= the neighbor after it; neighbors outside the
+ *    image count as 0
+ * 3. Double threshold: survivors with magnitude > high are strong edges,
+ *    those > low are candidates
+ * 4. Hysteresis: candidates 8-connected to a strong edge become edges
+ *
+ * Stages 1-3 and most of stage 4 run in `threads` horizontal bands
+ * (0 = one per CPU); the output does not depend on the thread count.
+ * Thresholds are in magnitude units of the chosen norm (Sobel L1 <= 2040).
+ */
+
+// Edge map as bytes: 255 for edges, 0 elsewhere
+void simd_canny(const uint8_t* src, uint8_t* edges, int width, int height,
+                uint16_t low_threshold, uint16_t high_threshold,
+                simd_magnitude_t norm, int threads);
+
+// Edge map as a packed bitmap: bit y * width + x (edges->len must be width * height)
+void simd_canny_bitmap(const uint8_t* src, simd_bitmap_t* edges, int width, int height,
+                       uint16_t low_threshold, uint16_t high_threshold,
+                       simd_magnitude_t norm, int threads);
+
+// simd_canny on strided u8 views of equal size
+void simd_canny_view(const simd_image_t* src, const simd_image_t* edges,
+                     uint16_t low_threshold, uint16_t high_threshold,
+                     simd_magnitude_t norm, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_CANNY_H */
@@ -0,0 +1,115 @@
+/**
+ * simd_color.h
+ * Color-space conversion: RGB/BGR/RGBA/BGRA, YUV 4:2:0 (NV12/I420), gray and HSV
+ */
+#ifndef SIMD_COLOR_H
+#define SIMD_COLOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Packed 8-bit pixel layouts (byte order in memory)
+typedef enum {
+    SIMD_PIXEL_RGB,
+    SIMD_PIXEL_BGR,
+    SIMD_PIXEL_RGBA,
+    SIMD_PIXEL_BGRA
+} simd_pixel_format_t;
+
+// YUV matrix coefficients
+typedef enum {
+    SIMD_YUV_BT601,
+    SIMD_YUV_BT709
+} simd_yuv_matrix_t;
+
+// YUV value range: limited (Y 16-235, UV 16-240) or full (0-255)
+typedef enum {
+    SIMD_YUV_LIMITED,
+    SIMD_YUV_FULL
+} simd_yuv_range_t;
+
+// Bytes per pixel of a packed format (3 or 4)
+size_t simd_pixel_size(simd_pixel_format_t format);
+
+/**
+ * Packed Format Conversion
+ * Reorders channels between any two packed layouts. Alpha is copied when
+ * both layouts have it and set to 255 when only the destination does.
+ */
+
+void simd_convert_pixels(const uint8_t* src, simd_pixel_format_t src_format,
+                         uint8_t* dst, simd_pixel_format_t dst_format, size_t pixel_count);
+
+/**
+ * Grayscale
+ * BT.601 luma (0.299 R + 0.587 G + 0.114 B), rounded to nearest.
+ */
+
+void simd_convert_to_gray(const uint8_t* src, simd_pixel_format_t format, uint8_t* gray, size_t pixel_count);
+
+/**
+ * YUV 4:2:0
+ * Y is width x height; chroma planes are ((width + 1) / 2) x ((height + 1) / 2).
+ * NV12 stores chroma as one interleaved UV plane, I420 as separate U and V
+ * planes. Encoding averages each 2x2 block before converting it; decoding
+ * replicates each chroma sample over its 2x2 block. All coefficients are
+ * rounded 13-bit fixed point and every result is rounded to nearest.
+ */
+
+void simd_rgb_to_nv12(const uint8_t* src, simd_pixel_format_t format, int width, int height,
+                      uint8_t* y, uint8_t* uv, simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+void simd_nv12_to_rgb(const uint8_t* y, const uint8_t* uv, uint8_t* dst, simd_pixel_format_t format,
+                      int width, int height, simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+
+void simd_rgb_to_i420(const uint8_t* src, simd_pixel_format_t format, int width, int height,
+                      uint8_t* y, uint8_t* u, uint8_t* v, simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+void simd_i420_to_rgb(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst,
+                      simd_pixel_format_t format, int width, int height,
+                      simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+
+/**
+ * HSV
+ * Packed 8-bit H, S, V triplets. H is in [0, 180) (2 degrees per step),
+ * S and V in [0, 255].
+ */
+
+void simd_rgb_to_hsv(const uint8_t* src, simd_pixel_format_t format, uint8_t* hsv, size_t pixel_count);
+void simd_hsv_to_rgb(const uint8_t* hsv, uint8_t* dst, simd_pixel_format_t format, size_t pixel_count);
+
+/**
+ * Strided Views
+ * Same conversions on simd_image_t views (u8 elements). Views are
+ * width x height pixels with the channel count of their format (gray 1,
+ * HSV 3, NV12 UV 2, I420 U and V 1); chroma views are half size, rounded
+ * up. Mismatched views are ignored.
+ */
+
+void simd_convert_pixels_view(const simd_image_t* src, simd_pixel_format_t src_format,
+                              const simd_image_t* dst, simd_pixel_format_t dst_format);
+void simd_convert_to_gray_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* gray);
+void simd_rgb_to_hsv_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* hsv);
+void simd_hsv_to_rgb_view(const simd_image_t* hsv, const simd_image_t* dst, simd_pixel_format_t format);
+
+void simd_rgb_to_nv12_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* y,
+                           const simd_image_t* uv, simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+void simd_nv12_to_rgb_view(const simd_image_t* y, const simd_image_t* uv, const simd_image_t* dst,
+                           simd_pixel_format_t format, simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+void simd_rgb_to_i420_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* y,
+                           const simd_image_t* u, const simd_image_t* v,
+                           simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+void simd_i420_to_rgb_view(const simd_image_t* y, const simd_image_t* u, const simd_image_t* v,
+                           const simd_image_t* dst, simd_pixel_format_t format,
+                           simd_yuv_matrix_t matrix, simd_yuv_range_t range);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_COLOR_H */
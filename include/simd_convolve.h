@@ -0,0 +1,84 @@
+/**
+ * simd_convolve.h
+ * General 2D convolution with automatic separable decomposition
+ */
+#ifndef SIMD_CONVOLVE_H
+#define SIMD_CONVOLVE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+#include "simd_border.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest supported kernel edge (kernels are ksize x ksize, ksize odd)
+#define SIMD_CONV_MAX_KSIZE 31
+
+/**
+ * Convolution (correlation form: the kernel is not flipped)
+ * DST[y][x] = sum_ij K[i][j] * SRC[y + i - r][x + j - r], r = ksize / 2.
+ * Kernels are row-major ksize x ksize. Rank-1 kernels are detected and run
+ * as a horizontal then a vertical 1D pass. Source rows are border-extended
+ * once into a ring of ksize rows that every output row reuses.
+ */
+
+// Float image and kernel
+void simd_convolve_f32(const float* src, float* dst, int width, int height,
+                       const float* kernel, int ksize, simd_border_t border, float border_value);
+
+// 8-bit image with fixed-point kernel: DST = sat_u8(round(sum / 2^shift))
+void simd_convolve_u8(const uint8_t* src, uint8_t* dst, int width, int height,
+                      const int16_t* kernel, int ksize, int shift,
+                      simd_border_t border, uint8_t border_value);
+
+/**
+ * Separable Convolution
+ * K[i][j] = ky[i] * kx[j]; each 1D kernel has ksize taps.
+ */
+
+void simd_convolve_sep_f32(const float* src, float* dst, int width, int height,
+                           const float* kx, const float* ky, int ksize,
+                           simd_border_t border, float border_value);
+
+void simd_convolve_sep_u8(const uint8_t* src, uint8_t* dst, int width, int height,
+                          const int16_t* kx, const int16_t* ky, int ksize, int shift,
+                          simd_border_t border, uint8_t border_value);
+
+/**
+ * Strided Views
+ * Same filters on single-channel simd_image_t views of equal size (f32 or
+ * u8 elements). SRC and DST must not overlap.
+ */
+
+void simd_convolve_f32_view(const simd_image_t* src, const simd_image_t* dst,
+                            const float* kernel, int ksize, simd_border_t border, float border_value);
+void simd_convolve_u8_view(const simd_image_t* src, const simd_image_t* dst,
+                           const int16_t* kernel, int ksize, int shift,
+                           simd_border_t border, uint8_t border_value);
+void simd_convolve_sep_f32_view(const simd_image_t* src, const simd_image_t* dst,
+                                const float* kx, const float* ky, int ksize,
+                                simd_border_t border, float border_value);
+void simd_convolve_sep_u8_view(const simd_image_t* src, const simd_image_t* dst,
+                               const int16_t* kx, const int16_t* ky, int ksize, int shift,
+                               simd_border_t border, uint8_t border_value);
+
+/**
+ * Separability Detection
+ * Return true and fill kx/ky when the kernel factors as ky * kx^T. The
+ * integer test is exact; the float test allows a relative error of 1e-6.
+ */
+
+bool simd_kernel_separable_f32(const float* kernel, int ksize, float* kx, float* ky);
+bool simd_kernel_separable_s16(const int16_t* kernel, int ksize, int16_t* kx, int16_t* ky);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_CONVOLVE_H */
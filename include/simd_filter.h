@@ -0,0 +1,82 @@
+/**
+ * simd_filter.h
+ * Predicate-driven stream compaction and packed comparison masks
+ */
+#ifndef SIMD_FILTER_H
+#define SIMD_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Stream Compaction (Filter) Functions
+ * Copies only the selected elements (and/or their indices) to the output,
+ * packed at the front. Either output pointer may be NULL. Both outputs must
+ * have room for len elements. Returns the number of selected elements.
+ * Indices are 32-bit, so len must not exceed UINT32_MAX when indices are used.
+ */
+
+// Select elements where A[i] > threshold
+size_t simd_filter_gt_f32(const float* a, float threshold, float* values, uint32_t* indices, size_t len);
+
+// Select elements where A[i] < threshold
+size_t simd_filter_lt_f32(const float* a, float threshold, float* values, uint32_t* indices, size_t len);
+
+// Select elements where A[i] == value
+size_t simd_filter_eq_f32(const float* a, float value, float* values, uint32_t* indices, size_t len);
+
+// Select elements where lo <= A[i] <= hi
+size_t simd_filter_range_f32(const float* a, float lo, float hi, float* values, uint32_t* indices, size_t len);
+
+// Select elements whose mask (as produced by simd_cmpgt_f32/simd_cmpeq_f32) is non-zero
+size_t simd_compact_f32(const float* a, const uint32_t* mask, float* values, uint32_t* indices, size_t len);
+
+/**
+ * Packed Comparison Masks
+ * One bit per element: bit (i % 64) of bits[i / 64] is set when the predicate
+ * holds for element i. The output needs (len + 63) / 64 words; unused bits of
+ * the last word are cleared.
+ */
+
+// bits[i] = (A > B)
+void simd_cmpgt_bits_f32(const float* a, const float* b, uint64_t* bits, size_t len);
+
+// bits[i] = (A == B)
+void simd_cmpeq_bits_f32(const float* a, const float* b, uint64_t* bits, size_t len);
+
+// bits[i] = (A > threshold)
+void simd_cmpgt_n_bits_f32(const float* a, float threshold, uint64_t* bits, size_t len);
+
+// bits[i] = (mask[i] != 0), packing the output of simd_cmpgt_f32/simd_cmpeq_f32
+void simd_mask_to_bits_u32(const uint32_t* mask, uint64_t* bits, size_t len);
+
+/**
+ * Selectivity Statistics
+ */
+
+typedef struct {
+    size_t total;        // Number of elements examined
+    size_t selected;     // Number of elements satisfying the predicate
+    double selectivity;  // selected / total (0.0 for empty input)
+} simd_filter_stats_t;
+
+// Count set bits among the first len bits of a packed mask
+size_t simd_popcount_bits(const uint64_t* bits, size_t len);
+
+// Selectivity of A[i] > threshold without materializing any output
+simd_filter_stats_t simd_selectivity_gt_f32(const float* a, float threshold, size_t len);
+
+// Selectivity of a packed mask
+simd_filter_stats_t simd_selectivity_bits(const uint64_t* bits, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_FILTER_H */
@@ -0,0 +1,99 @@
+/**
+ * simd_gradient.h
+ * Image gradients (Sobel/Scharr), gradient magnitude and orientation bins
+ */
+#ifndef SIMD_GRADIENT_H
+#define SIMD_GRADIENT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+#include "simd_border.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest supported number of orientation bins
+#define SIMD_GRADIENT_MAX_BINS 64
+
+/**
+ * Gradient operators. Both are separable: a smoothing column/row times
+ * the central difference [-1 0 1].
+ *   Sobel:  smoothing [1 2 1],  |Gx|, |Gy| <= 1020
+ *   Scharr: smoothing [3 10 3], |Gx|, |Gy| <= 4080
+ */
+typedef enum {
+    SIMD_GRADIENT_SOBEL,
+    SIMD_GRADIENT_SCHARR
+} simd_gradient_op_t;
+
+// Magnitude norms
+typedef enum {
+    SIMD_MAGNITUDE_L1,      // |Gx| + |Gy|, saturated to 65535
+    SIMD_MAGNITUDE_L2       // round(sqrt(Gx^2 + Gy^2)), exact
+} simd_magnitude_t;
+
+/**
+ * Fused Gradient
+ * One pass over the image: each source row is border-extended and filtered
+ * horizontally once, and the last three results are reused across y.
+ * Any of gx, gy, magnitude and orientation may be NULL to skip that plane.
+ *
+ * Orientation is unsigned (mod 180 degrees) and quantized into `bins`
+ * sectors centered on multiples of 180/bins, so with 4 bins:
+ *   0 = horizontal gradient (vertical edge), 1 = 45, 2 = 90, 3 = 135 degrees
+ * where angles are measured from +x towards +y (image rows grow downwards).
+ * Angles on a sector boundary go to the upper sector (wrapping to 0) and
+ * zero gradients fall into bin 0.
+ */
+void simd_gradient(const uint8_t* src, int width, int height,
+                   simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                   int16_t* gx, int16_t* gy,
+                   uint16_t* magnitude, simd_magnitude_t norm,
+                   uint8_t* orientation, int bins);
+
+// Rows [y0, y1) of simd_gradient; the output planes are still full-size
+// images. Lets callers split one image into bands across threads.
+void simd_gradient_rows(const uint8_t* src, int width, int height, int y0, int y1,
+                        simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                        int16_t* gx, int16_t* gy,
+                        uint16_t* magnitude, simd_magnitude_t norm,
+                        uint8_t* orientation, int bins);
+
+// simd_gradient on strided views: SRC is u8, GX/GY s16, MAGNITUDE u16 and
+// ORIENTATION u8, all single-channel and SRC-sized. NULL views are skipped.
+void simd_gradient_view(const simd_image_t* src,
+                        simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                        const simd_image_t* gx, const simd_image_t* gy,
+                        const simd_image_t* magnitude, simd_magnitude_t norm,
+                        const simd_image_t* orientation, int bins);
+void simd_gradient_rows_view(const simd_image_t* src, int y0, int y1,
+                             simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                             const simd_image_t* gx, const simd_image_t* gy,
+                             const simd_image_t* magnitude, simd_magnitude_t norm,
+                             const simd_image_t* orientation, int bins);
+
+/**
+ * Standalone Operations on Gx/Gy Planes
+ */
+
+// Gradient planes only
+void simd_gradient_xy(const uint8_t* src, int16_t* gx, int16_t* gy, int width, int height,
+                      simd_gradient_op_t op, simd_border_t border, uint8_t border_value);
+
+// Magnitude of len gradient pairs
+void simd_gradient_magnitude(const int16_t* gx, const int16_t* gy, uint16_t* magnitude,
+                             size_t len, simd_magnitude_t norm);
+
+// Quantized orientation of len gradient pairs (bins in [1, SIMD_GRADIENT_MAX_BINS])
+void simd_gradient_orientation(const int16_t* gx, const int16_t* gy, uint8_t* orientation,
+                               size_t len, int bins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_GRADIENT_H */
@@ -0,0 +1,73 @@
+/**
+ * simd_image.h
+ * Strided image views: padded frames and regions of interest without copies
+ */
+#ifndef SIMD_IMAGE_H
+#define SIMD_IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Image View
+ * Describes pixels owned elsewhere. Row y starts at data + y * stride
+ * bytes; each row holds width pixels of `channels` interleaved elements.
+ * The element type (u8, s16, f32, ...) is implied by the kernel the view
+ * is passed to. Stride may exceed the row size (capture padding, ROIs of
+ * a larger image), never be smaller.
+ */
+typedef struct {
+    uint8_t* data;              // First element of row 0
+    int width;                  // Pixels per row
+    int height;                 // Rows
+    size_t stride;              // Bytes between the starts of consecutive rows
+    int channels;               // Interleaved elements per pixel
+} simd_image_t;
+
+static inline simd_image_t simd_image_make(void* data, int width, int height, size_t stride, int channels) {
+    simd_image_t img = { (uint8_t*)data, width, height, stride, channels };
+    return img;
+}
+
+// View of a tightly packed buffer of ELEM_SIZE-byte elements
+static inline simd_image_t simd_image_packed(void* data, int width, int height, int channels, size_t elem_size) {
+    return simd_image_make(data, width, height, (size_t)width * channels * elem_size, channels);
+}
+
+// Sub-rectangle (x, y, width, height) of IMG; shares its pixels
+static inline simd_image_t simd_image_roi(const simd_image_t* img, int x, int y, int width, int height,
+                                          size_t elem_size) {
+    uint8_t* data = img->data + (size_t)y * img->stride + (size_t)x * img->channels * elem_size;
+    return simd_image_make(data, width, height, img->stride, img->channels);
+}
+
+static inline void* simd_image_row(const simd_image_t* img, int y) {
+    return img->data + (size_t)y * img->stride;
+}
+
+// Bytes of pixel data in one row
+static inline size_t simd_image_row_bytes(const simd_image_t* img, size_t elem_size) {
+    return (size_t)img->width * img->channels * elem_size;
+}
+
+// True when rows follow each other without padding (one linear run)
+static inline bool simd_image_is_packed(const simd_image_t* img, size_t elem_size) {
+    return img->stride == simd_image_row_bytes(img, elem_size);
+}
+
+// Valid view of at least one pixel with the given channel count (0 = any)
+static inline bool simd_image_valid(const simd_image_t* img, int channels, size_t elem_size) {
+    return img && img->data && img->width > 0 && img->height > 0 && img->channels > 0 &&
+           (channels == 0 || img->channels == channels) && img->stride >= simd_image_row_bytes(img, elem_size);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_IMAGE_H */
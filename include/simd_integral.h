@@ -0,0 +1,110 @@
+/**
+ * simd_integral.h
+ * Integral images (summed-area tables) and constant-time rectangle queries
+ */
+#ifndef SIMD_INTEGRAL_H
+#define SIMD_INTEGRAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Integral Images
+ * Outputs are (width + 1) x (height + 1) with a row stride of width + 1:
+ *   SUM[y][x] = sum of SRC[j][i] for j < y, i < x
+ * so row 0 and column 0 are zero and any rectangle needs four loads.
+ * The u32 table wraps past 2^32 (images above ~16.8M pixels); rectangle
+ * sums stay exact as long as the rectangle itself sums below 2^32.
+ */
+
+// 8-bit source, 32-bit sums
+void simd_integral_u8(const uint8_t* src, uint32_t* sum, int width, int height);
+
+// 8-bit source, sums and sums of squares
+void simd_integral_sq_u8(const uint8_t* src, uint32_t* sum, uint64_t* sqsum, int width, int height);
+
+// Float source, double sums
+void simd_integral_f32(const float* src, double* sum, int width, int height);
+
+// Float source, double sums and sums of squares
+void simd_integral_sq_f32(const float* src, double* sum, double* sqsum, int width, int height);
+
+// Strided single-channel source views; the tables stay packed with a
+// stride of src->width + 1 so the rectangle queries below apply unchanged
+void simd_integral_u8_view(const simd_image_t* src, uint32_t* sum);
+void simd_integral_sq_u8_view(const simd_image_t* src, uint32_t* sum, uint64_t* sqsum);
+void simd_integral_f32_view(const simd_image_t* src, double* sum);
+void simd_integral_sq_f32_view(const simd_image_t* src, double* sum, double* sqsum);
+
+/**
+ * Rectangle Queries
+ * Rectangle [x, x + w) x [y, y + h) of the source image; `width` is the
+ * source width (the table stride is width + 1). O(1) each.
+ */
+
+static inline uint32_t simd_integral_rect_sum_u32(const uint32_t* sum, int width,
+                                                  int x, int y, int w, int h) {
+    size_t stride = (size_t)width + 1;
+    const uint32_t* top = sum + (size_t)y * stride + x;
+    const uint32_t* bottom = top + (size_t)h * stride;
+    return bottom[w] - bottom[0] - top[w] + top[0];
+}
+
+static inline uint64_t simd_integral_rect_sum_u64(const uint64_t* sum, int width,
+                                                  int x, int y, int w, int h) {
+    size_t stride = (size_t)width + 1;
+    const uint64_t* top = sum + (size_t)y * stride + x;
+    const uint64_t* bottom = top + (size_t)h * stride;
+    return bottom[w] - bottom[0] - top[w] + top[0];
+}
+
+static inline double simd_integral_rect_sum_f64(const double* sum, int width,
+                                                int x, int y, int w, int h) {
+    size_t stride = (size_t)width + 1;
+    const double* top = sum + (size_t)y * stride + x;
+    const double* bottom = top + (size_t)h * stride;
+    return (bottom[w] - bottom[0]) - (top[w] - top[0]);
+}
+
+// Mean of a rectangle of an 8-bit image
+static inline double simd_integral_rect_mean_u8(const uint32_t* sum, int width,
+                                                int x, int y, int w, int h) {
+    return (double)simd_integral_rect_sum_u32(sum, width, x, y, w, h) / ((double)w * h);
+}
+
+// Population variance of a rectangle of an 8-bit image (exact up to the final division)
+static inline double simd_integral_rect_variance_u8(const uint32_t* sum, const uint64_t* sqsum, int width,
+                                                    int x, int y, int w, int h) {
+    uint64_t n = (uint64_t)w * h;
+    uint64_t s = simd_integral_rect_sum_u32(sum, width, x, y, w, h);
+    uint64_t sq = simd_integral_rect_sum_u64(sqsum, width, x, y, w, h);
+    return (double)(sq * n - s * s) / ((double)n * n);
+}
+
+// Mean of a rectangle of a float image
+static inline double simd_integral_rect_mean_f64(const double* sum, int width,
+                                                 int x, int y, int w, int h) {
+    return simd_integral_rect_sum_f64(sum, width, x, y, w, h) / ((double)w * h);
+}
+
+// Population variance of a rectangle of a float image (clamped at 0)
+static inline double simd_integral_rect_variance_f64(const double* sum, const double* sqsum, int width,
+                                                     int x, int y, int w, int h) {
+    double n = (double)w * h;
+    double mean = simd_integral_rect_sum_f64(sum, width, x, y, w, h) / n;
+    double var = simd_integral_rect_sum_f64(sqsum, width, x, y, w, h) / n - mean * mean;
+    return var > 0.0 ? var : 0.0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_INTEGRAL_H */
@@ -0,0 +1,74 @@
+/**
+ * simd_interleave.h
+ * Planar <-> interleaved conversion (zip/unzip) for 2, 3 and 4 channels
+ */
+#ifndef SIMD_INTERLEAVE_H
+#define SIMD_INTERLEAVE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Zip (planar -> interleaved)
+ * OUT = [A[0], B[0], ..., A[1], B[1], ...]; len is the number of elements
+ * per channel, so OUT holds len * channels elements.
+ */
+
+void simd_zip2_f32(const float* a, const float* b, float* out, size_t len);
+void simd_zip3_f32(const float* a, const float* b, const float* c, float* out, size_t len);
+void simd_zip4_f32(const float* a, const float* b, const float* c, const float* d, float* out, size_t len);
+
+void simd_zip2_s16(const int16_t* a, const int16_t* b, int16_t* out, size_t len);
+void simd_zip3_s16(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, size_t len);
+void simd_zip4_s16(const int16_t* a, const int16_t* b, const int16_t* c, const int16_t* d, int16_t* out, size_t len);
+
+void simd_zip2_u8(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t len);
+void simd_zip3_u8(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint8_t* out, size_t len);
+void simd_zip4_u8(const uint8_t* a, const uint8_t* b, const uint8_t* c, const uint8_t* d, uint8_t* out, size_t len);
+
+/**
+ * Unzip (interleaved -> planar)
+ * A[i] = IN[i * channels + 0], B[i] = IN[i * channels + 1], ...
+ */
+
+void simd_unzip2_f32(const float* in, float* a, float* b, size_t len);
+void simd_unzip3_f32(const float* in, float* a, float* b, float* c, size_t len);
+void simd_unzip4_f32(const float* in, float* a, float* b, float* c, float* d, size_t len);
+
+void simd_unzip2_s16(const int16_t* in, int16_t* a, int16_t* b, size_t len);
+void simd_unzip3_s16(const int16_t* in, int16_t* a, int16_t* b, int16_t* c, size_t len);
+void simd_unzip4_s16(const int16_t* in, int16_t* a, int16_t* b, int16_t* c, int16_t* d, size_t len);
+
+void simd_unzip2_u8(const uint8_t* in, uint8_t* a, uint8_t* b, size_t len);
+void simd_unzip3_u8(const uint8_t* in, uint8_t* a, uint8_t* b, uint8_t* c, size_t len);
+void simd_unzip4_u8(const uint8_t* in, uint8_t* a, uint8_t* b, uint8_t* c, uint8_t* d, size_t len);
+
+/**
+ * Complex (IQ) Conversions
+ * Interleaved complex data is [re0, im0, re1, im1, ...]; n is the number
+ * of complex samples.
+ */
+
+// Interleaved complex float -> split real/imaginary planes
+void simd_complex_split_f32(const float* iq, float* re, float* im, size_t n);
+
+// Split real/imaginary planes -> interleaved complex float
+void simd_complex_merge_f32(const float* re, const float* im, float* iq, size_t n);
+
+// Interleaved complex int16 (e.g. SDR samples) -> split float planes, scaled by scale
+void simd_complex_split_s16_f32(const int16_t* iq, float* re, float* im, float scale, size_t n);
+
+// Split float planes -> interleaved complex int16: round(x * scale), saturated
+void simd_complex_merge_f32_s16(const float* re, const float* im, int16_t* iq, float scale, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_INTERLEAVE_H */
@@ -0,0 +1,89 @@
+/**
+ * simd_io.h
+ * Memory-mapped image/array files and a double-buffered streaming reader
+ */
+#ifndef SIMD_IO_H
+#define SIMD_IO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Mapped Files
+ * The whole file is mapped copy-on-write with sequential access advice:
+ * kernels may read it directly and even write into it (for in-place
+ * operations) without the file itself changing. DATA is page aligned.
+ */
+typedef struct {
+    uint8_t* data;
+    size_t size;                // File size in bytes
+} simd_mapped_t;
+
+bool simd_map_file(const char* path, simd_mapped_t* file);
+void simd_unmap_file(simd_mapped_t* file);
+
+// Raw f32 array view of a mapping (NULL unless the size is a multiple of 4)
+static inline float* simd_mapped_f32(const simd_mapped_t* file, size_t* count) {
+    if (!file->data || file->size % sizeof(float)) return NULL;
+    *count = file->size / sizeof(float);
+    return (float*)file->data;
+}
+
+// Write LEN bytes as a raw array file
+bool simd_raw_write(const char* path, const void* data, size_t len);
+
+/**
+ * PGM/PPM (binary P5 gray and P6 RGB, maxval <= 255)
+ * Parsing yields a view of the pixels inside the given buffer, so a
+ * mapped file is processed without any copy.
+ */
+
+// Parse the header at DATA and point IMAGE at the pixel data; returns the
+// header size in bytes, or 0 when the header is invalid or the pixels do
+// not fit in SIZE bytes
+size_t simd_pnm_parse(const uint8_t* data, size_t size, simd_image_t* image);
+
+// Map a PGM/PPM file and view its pixels; unmap FILE when done
+bool simd_pnm_map(const char* path, simd_mapped_t* file, simd_image_t* image);
+
+// Write a 1-channel (P5) or 3-channel (P6) u8 view
+bool simd_pnm_write(const char* path, const simd_image_t* image);
+
+/**
+ * Streaming Reader
+ * Reads a file in fixed-size chunks on a background thread with two
+ * buffers: while the caller processes one chunk, the next is being read,
+ * so I/O overlaps with compute and memory use stays at two chunks however
+ * large the file is.
+ */
+typedef struct simd_stream simd_stream_t;
+
+// Stream the file from byte OFFSET in chunks of CHUNK_SIZE bytes (the last
+// one may be shorter); NULL on failure
+simd_stream_t* simd_stream_open(const char* path, uint64_t offset, size_t chunk_size);
+
+// Stream the pixels of a PGM/PPM file ROWS rows at a time. FORMAT receives
+// the image size, channels and row stride (its data pointer is NULL).
+// Bytes after the last row are ignored; NULL when the file is too short.
+simd_stream_t* simd_pnm_stream_open(const char* path, int rows, simd_image_t* format);
+
+// Next chunk, valid until the following call; NULL at the end of the file
+// or on a read error (see simd_stream_failed)
+const uint8_t* simd_stream_next(simd_stream_t* stream, size_t* len);
+
+bool simd_stream_failed(const simd_stream_t* stream);
+void simd_stream_close(simd_stream_t* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_IO_H */
@@ -0,0 +1,85 @@
+/**
+ * simd_knn.h
+ * Brute-force k-nearest-neighbor search: L2, inner-product and cosine
+ * scores over f32, f16 or int8 database storage
+ */
+#ifndef SIMD_KNN_H
+#define SIMD_KNN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Queries scanning the database together (one parallel task at most)
+#define SIMD_KNN_QUERY_BLOCK 32
+
+// Bytes of f32 database vectors each query block scores at a time
+#define SIMD_KNN_TILE_BYTES (32 * 1024)
+
+typedef enum {
+    SIMD_KNN_L2,                // Squared Euclidean distance, smallest first
+    SIMD_KNN_INNER_PRODUCT,     // Inner product, largest first
+    SIMD_KNN_COSINE             // Cosine similarity, largest first
+} simd_knn_metric_t;
+
+typedef enum {
+    SIMD_KNN_F32,               // 4 bytes per element, exact
+    SIMD_KNN_F16,               // 2 bytes per element, IEEE half precision
+    SIMD_KNN_INT8               // 1 byte per element plus a scale per vector
+} simd_knn_storage_t;
+
+/**
+ * Index
+ * A flat array of database vectors in the chosen storage. Vectors are
+ * numbered from 0 in the order they were added. Cosine indexes store
+ * vectors normalized; int8 storage keeps round(x / s) with s chosen per
+ * vector so that its largest element maps to 127.
+ */
+typedef struct simd_knn_index simd_knn_index_t;
+
+// Empty index of DIM-element vectors (NULL when DIM is 0 or on allocation failure)
+simd_knn_index_t* simd_knn_create(size_t dim, simd_knn_metric_t metric, simd_knn_storage_t storage);
+void simd_knn_destroy(simd_knn_index_t* index);
+
+// Append N row-major vectors; false on allocation failure (nothing added)
+bool simd_knn_add(simd_knn_index_t* index, const float* vectors, size_t n);
+
+// Vectors held, and the bytes their storage takes
+size_t simd_knn_size(const simd_knn_index_t* index);
+size_t simd_knn_bytes(const simd_knn_index_t* index);
+
+/**
+ * Search
+ * Writes the K best ids and scores of query q, best first, to IDS and
+ * SCORES at q * k. Scores are squared distances for L2 and similarities
+ * otherwise, computed from the stored (possibly quantized) vectors. Slots
+ * beyond the size of the index get id -1 and the worst possible score.
+ *
+ * Queries are scored in blocks of SIMD_KNN_QUERY_BLOCK against database
+ * tiles of SIMD_KNN_TILE_BYTES with simd_dot_many_f32, f16 and int8
+ * tiles being widened once per block; the blocks run in parallel on the
+ * scheduler pool. Results do not depend on the number of workers.
+ */
+bool simd_knn_search(const simd_knn_index_t* index, const float* queries, int64_t* ids, float* scores,
+                     size_t nq, size_t k);
+
+/**
+ * Top-k Selection
+ * The K smallest of N distances, ascending, with their indices, through a
+ * bounded max-heap: four candidates at a time are compared against the
+ * current k-th best and only those that beat it enter the heap. Slots
+ * beyond N get index -1 and INFINITY.
+ */
+void simd_knn_select(const float* distances, int64_t* ids, float* best, size_t n, size_t k);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_KNN_H */
@@ -0,0 +1,81 @@
+/**
+ * simd_lut.h
+ * 256-entry lookup tables and point operations on 8-bit images
+ */
+#ifndef SIMD_LUT_H
+#define SIMD_LUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Table Lookup
+ * DST[i] = LUT[SRC[i]] for a 256-entry table. The table is held in
+ * registers as four 64-byte vqtbl4q_u8 tables, so each 16-byte step is
+ * four lookups. DST may be SRC.
+ */
+
+void simd_lut_u8(const uint8_t* src, const uint8_t* lut, uint8_t* dst, size_t len);
+
+// Interleaved pixels with 1, 3 or 4 channels: LUTS holds channels
+// consecutive 256-entry tables, table c applied to channel c
+void simd_lut_channels_u8(const uint8_t* src, const uint8_t* luts, uint8_t* dst, size_t pixel_count, int channels);
+
+/**
+ * Table Builders
+ * Fill a 256-entry table; results are rounded and saturated to 0..255.
+ */
+
+// LUT[i] = 255 * (i / 255)^gamma
+void simd_lut_gamma(uint8_t* lut, float gamma);
+
+// LUT[i] = contrast * i + brightness
+void simd_lut_linear(uint8_t* lut, float contrast, float brightness);
+
+// LUT[i] = max_value if i > threshold, else 0
+void simd_lut_threshold(uint8_t* lut, uint8_t threshold, uint8_t max_value);
+
+// COUNT ascending thresholds split 0..255 into count + 1 levels:
+// LUT[i] = LEVELS[k], k = number of thresholds <= i
+void simd_lut_multi_threshold(uint8_t* lut, const uint8_t* thresholds, const uint8_t* levels, int count);
+
+// Histogram equalization from a 256-bin histogram (e.g. neon_histogram):
+// LUT[i] = 255 * (cdf[i] - cdf_min) / (total - cdf_min)
+void simd_lut_equalize(const uint32_t* histogram, uint8_t* lut);
+
+/**
+ * Point Operations
+ * A table builder followed by simd_lut_u8; DST may be SRC.
+ */
+
+void simd_gamma_u8(const uint8_t* src, float gamma, uint8_t* dst, size_t len);
+void simd_contrast_u8(const uint8_t* src, float contrast, float brightness, uint8_t* dst, size_t len);
+void simd_multi_threshold_u8(const uint8_t* src, const uint8_t* thresholds, const uint8_t* levels, int count,
+                             uint8_t* dst, size_t len);
+
+// Binary threshold is a single compare, so it skips the table
+void simd_threshold_u8(const uint8_t* src, uint8_t threshold, uint8_t max_value, uint8_t* dst, size_t len);
+
+/**
+ * Strided Views
+ * u8 views of equal size and channel count; DST may be SRC. The plain
+ * table applies to every channel, simd_lut_channels_u8_view takes one
+ * table per channel of SRC.
+ */
+
+void simd_lut_u8_view(const simd_image_t* src, const uint8_t* lut, const simd_image_t* dst);
+void simd_lut_channels_u8_view(const simd_image_t* src, const uint8_t* luts, const simd_image_t* dst);
+void simd_threshold_u8_view(const simd_image_t* src, uint8_t threshold, uint8_t max_value, const simd_image_t* dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_LUT_H */
@@ -0,0 +1,40 @@
+/**
+ * simd_median.h
+ * Median filtering of 8-bit images: sorting networks and constant-time histograms
+ */
+#ifndef SIMD_MEDIAN_H
+#define SIMD_MEDIAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest supported radius (window side 2 * radius + 1 = 255)
+#define SIMD_MEDIAN_MAX_RADIUS 127
+
+/**
+ * Median Filter
+ * Each output pixel is the median of the (2 * radius + 1)^2 window around
+ * it; borders are replicated. Radius 1 (3x3) and 2 (5x5) use min/max
+ * sorting networks on 16 pixels at once; larger radii use Perreault's
+ * constant-time histogram median, whose cost per pixel does not grow with
+ * the radius. Work is split into `threads` horizontal bands (0 = one per
+ * CPU). DST must not overlap SRC.
+ */
+
+void simd_median_u8(const uint8_t* src, uint8_t* dst, int width, int height, int radius, int threads);
+
+// simd_median_u8 on strided u8 views of equal size
+void simd_median_u8_view(const simd_image_t* src, const simd_image_t* dst, int radius, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_MEDIAN_H */
@@ -0,0 +1,56 @@
+/**
+ * simd_morph.h
+ * Grayscale morphology with rectangular structuring elements
+ */
+#ifndef SIMD_MORPH_H
+#define SIMD_MORPH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest structuring element side
+#define SIMD_MORPH_MAX_SIZE 31
+
+// Morphological operations
+typedef enum {
+    SIMD_MORPH_ERODE,       // Window minimum
+    SIMD_MORPH_DILATE,      // Window maximum
+    SIMD_MORPH_OPEN,        // Dilate(erode(src))
+    SIMD_MORPH_CLOSE,       // Erode(dilate(src))
+    SIMD_MORPH_GRADIENT,    // Dilate(src) - erode(src)
+    SIMD_MORPH_TOPHAT,      // Src - open(src)
+    SIMD_MORPH_BLACKHAT     // Close(src) - src
+} simd_morph_op_t;
+
+/**
+ * Morphology
+ * The structuring element is a kw x kh rectangle (1..SIMD_MORPH_MAX_SIZE
+ * each) anchored at (kw / 2, kh / 2): output (x, y) covers source columns
+ * x - kw / 2 .. x - kw / 2 + kw - 1 and the matching rows. Pixels outside
+ * the image are ignored. The van Herk/Gil-Werman running min/max makes the
+ * cost per pixel independent of the element size. Work is split into
+ * `threads` horizontal bands (0 = one per CPU). DST must not overlap SRC.
+ */
+
+void simd_erode_u8(const uint8_t* src, uint8_t* dst, int width, int height, int kw, int kh, int threads);
+void simd_dilate_u8(const uint8_t* src, uint8_t* dst, int width, int height, int kw, int kh, int threads);
+
+void simd_morphology_u8(const uint8_t* src, uint8_t* dst, int width, int height,
+                        simd_morph_op_t op, int kw, int kh, int threads);
+
+// simd_morphology_u8 on strided u8 views of equal size
+void simd_morphology_u8_view(const simd_image_t* src, const simd_image_t* dst,
+                             simd_morph_op_t op, int kw, int kh, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_MORPH_H */
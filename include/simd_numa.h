@@ -0,0 +1,57 @@
+/**
+ * simd_numa.h
+ * NUMA topology and node-local allocation for multi-socket systems
+ */
+#ifndef SIMD_NUMA_H
+#define SIMD_NUMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Limits of what simd_numa_topology reports
+#define SIMD_NUMA_MAX_NODES 8
+#define SIMD_NUMA_MAX_CPUS 256
+
+/**
+ * Topology
+ * Read from /sys/devices/system/node (or a copy of its layout for tests):
+ * the online node list, then each node's cpulist and the MemTotal line of
+ * its meminfo. Nodes may have no CPUs (memory-only nodes).
+ */
+typedef struct {
+    int id;                             // Node number
+    int cpu_count;
+    int cpus[SIMD_NUMA_MAX_CPUS];       // Logical CPUs of the node, ascending
+    uint64_t memory;                    // Bytes (0 when meminfo is missing)
+} simd_numa_node_t;
+
+// Fill up to MAX entries in node order; ROOT NULL = the live system.
+// Returns the number of nodes found (0 when the list cannot be read).
+int simd_numa_topology(const char* root, simd_numa_node_t* nodes, int max);
+
+/**
+ * Node-Local Allocation
+ * Linux places a page on the node of the thread that first touches it.
+ * simd_numa_alloc maps SIZE bytes and has the scheduler's workers of each
+ * node zero that node's part (simd_sched_node_start over the bytes), so
+ * a later simd_parallel_for_nodes over N elements of the buffer touches
+ * local memory on every node. The pool must already be placed with
+ * SIMD_AFFINITY_NUMA; otherwise the pages are left for the first writer.
+ */
+
+// Page-aligned, zeroed; NULL on failure
+void* simd_numa_alloc(size_t size);
+
+// Release a buffer from simd_numa_alloc (SIZE as allocated)
+void simd_numa_free(void* ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_NUMA_H */
@@ -9,6 +9,7 @@
 #include <stddef.h>
 #include "platform_detect.h"
 #include "neon_utils.h"
+#include "simd_image.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -104,6 +105,12 @@ void simd_rgb_to_gray(const uint8_t* rgb, uint8_t* gray, size_t pixel_count);
 // Simple box blur (3x3) for grayscale image
 void simd_blur_gray_3x3(const uint8_t* input, uint8_t* output, int width, int height);
 
+// simd_rgb_to_gray on strided views: 3-channel SRC, 1-channel DST of equal size
+void simd_rgb_to_gray_view(const simd_image_t* src, const simd_image_t* dst);
+
+// simd_blur_gray_3x3 on strided views: 1-channel SRC and DST of equal size
+void simd_blur_gray_3x3_view(const simd_image_t* src, const simd_image_t* dst);
+
 #ifdef __cplusplus
 }
 #endif
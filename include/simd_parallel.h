@@ -0,0 +1,45 @@
+/**
+ * simd_parallel.h
+ * Minimal multi-threading helpers for splitting image kernels into bands
+ */
+#ifndef SIMD_PARALLEL_H
+#define SIMD_PARALLEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Upper bound on the number of bands (and threads) used by one call
+#define SIMD_PARALLEL_MAX_THREADS 64
+
+// Processes rows [y0, y1) of band `band`
+typedef void (*simd_band_fn_t)(void* ctx, int band, int y0, int y1);
+
+// Number of online CPUs (at least 1)
+int simd_parallel_cpu_count(void);
+
+// Number of bands a call with `threads` (0 = all CPUs) uses for `rows` rows
+int simd_parallel_band_count(int rows, int threads);
+
+// First row of band i out of `bands` (band i covers [start(i), start(i + 1)))
+static inline int simd_parallel_band_start(int rows, int bands, int i) {
+    return (int)((int64_t)rows * i / bands);
+}
+
+/**
+ * Run fn over simd_parallel_band_count(rows, threads) equal horizontal
+ * bands as tasks on the work-stealing scheduler (simd_sched.h); the
+ * calling thread takes part unless the pool is placed by NUMA node, when
+ * each node runs its share (simd_parallel_for_nodes). Returns when every
+ * band has finished. Returns the number of bands used.
+ */
+int simd_parallel_bands(int rows, int threads, simd_band_fn_t fn, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_PARALLEL_H */
@@ -0,0 +1,133 @@
+/**
+ * simd_pipeline.h
+ * Multi-stage frame pipeline over lock-free single-producer queues
+ */
+#ifndef SIMD_PIPELINE_H
+#define SIMD_PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Upper bound on the number of stages in one pipeline
+#define SIMD_PIPELINE_MAX_STAGES 16
+
+/**
+ * SPSC Queue
+ * Bounded lock-free FIFO of non-NULL pointers between exactly one
+ * producer thread and one consumer thread. Push and pop never block;
+ * they fail when the queue is full or empty.
+ */
+typedef struct simd_spsc simd_spsc_t;
+
+// Queue holding at least CAPACITY items (rounded up to a power of two)
+simd_spsc_t* simd_spsc_create(size_t capacity);
+void simd_spsc_destroy(simd_spsc_t* queue);
+
+size_t simd_spsc_capacity(const simd_spsc_t* queue);
+
+// False when full (producer only)
+bool simd_spsc_push(simd_spsc_t* queue, void* item);
+
+// Oldest item, or NULL when empty (consumer only)
+void* simd_spsc_pop(simd_spsc_t* queue);
+
+// Items queued; exact from either end while the other end is idle
+size_t simd_spsc_size(const simd_spsc_t* queue);
+
+/**
+ * Frames
+ * Frame buffers come from a pool allocated once per run and circulate
+ * from the first stage to the last and back, so no memory is allocated
+ * per frame. A buffer's contents are whatever the previous frame left.
+ */
+typedef struct {
+    uint8_t* data;              // frame_size bytes, NEON aligned
+    size_t size;
+    uint64_t index;             // Sequence number assigned by the pipeline
+    uint64_t start_ns;          // When the first stage took the frame
+    bool dropped;               // Set when a stage rejected the frame
+} simd_frame_t;
+
+/**
+ * Stages
+ * The first stage produces frames: it fills the buffer and returns false
+ * at the end of the stream (that buffer is discarded). Later stages
+ * return false to drop a frame; the stages after it skip it and it is
+ * recycled. A stage only ever runs on one thread, so its CTX needs no
+ * locking.
+ */
+typedef bool (*simd_stage_fn_t)(void* ctx, simd_frame_t* frame);
+
+typedef struct {
+    const char* name;
+    simd_stage_fn_t fn;
+    void* ctx;
+    bool fuse;                  // Run on the previous stage's thread, without a queue in between
+} simd_stage_t;
+
+/**
+ * Pipeline parameters. Zero-initialized fields select the defaults.
+ */
+typedef struct {
+    size_t frame_size;          // Bytes per frame buffer
+    int frames;                 // Buffers in the pool (0 = two per thread)
+    int queue_capacity;         // Slots per queue between threads (0 = frames)
+} simd_pipeline_config_t;
+
+/**
+ * Statistics
+ * Wait times belong to threads and are reported on the first stage of a
+ * fused group (starved: waiting for input) and on its last stage
+ * (blocked: downstream queue full, or no free frame for the first stage,
+ * i.e. backpressure). Queue depth is that of the group's input queue,
+ * sampled at each frame taken; for the first stage it is the number of
+ * free frames.
+ */
+typedef struct {
+    const char* name;
+    uint64_t frames;            // Frames processed (drops from earlier stages excluded)
+    double busy_ms;             // Time inside the stage function
+    double latency_avg_us;      // Time per frame inside the stage
+    double latency_max_us;
+    double starved_ms;
+    double blocked_ms;
+    double queue_avg;
+    int queue_max;
+} simd_stage_stats_t;
+
+typedef struct {
+    int stages;
+    int threads;
+    simd_stage_stats_t stage[SIMD_PIPELINE_MAX_STAGES];
+    uint64_t frames;            // Frames that completed every stage
+    uint64_t dropped;
+    double seconds;             // Wall time of the run
+    double fps;                 // Completed frames per second
+    double latency_avg_us;      // First stage start to last stage end
+    double latency_max_us;
+} simd_pipeline_stats_t;
+
+/**
+ * Run STAGES until the first stage ends the stream. Each group of fused
+ * stages gets a thread (the first group runs on the calling thread) and
+ * consecutive groups are connected by SPSC queues. Stages that run
+ * concurrently overlap I/O with compute; a stage that is itself parallel
+ * (simd_parallel_bands, simd_tile_run) can be given a thread of its own.
+ * STATS may be NULL. Returns false for invalid arguments or when buffers
+ * or threads cannot be created.
+ */
+bool simd_pipeline_run(const simd_stage_t* stages, int count, const simd_pipeline_config_t* config,
+                       simd_pipeline_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_PIPELINE_H */
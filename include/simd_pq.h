@@ -0,0 +1,93 @@
+/**
+ * simd_pq.h
+ * Product quantization: k-means codebooks, 4-bit codes and fast-scan
+ * distance estimation with in-register table lookups
+ */
+#ifndef SIMD_PQ_H
+#define SIMD_PQ_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "simd_knn.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Centroids per subquantizer: every code is 4 bits
+#define SIMD_PQ_CENTROIDS 16
+
+// Vectors per fast-scan block: two table lookups of 16 codes each
+#define SIMD_PQ_BLOCK 32
+
+// Fast-scan candidates kept per result for re-ranking
+#define SIMD_PQ_RERANK 4
+
+/**
+ * Quantizer
+ * DIM-element vectors are split into M subvectors of DIM / M elements and
+ * each subvector is replaced by the nearest of 16 centroids trained for
+ * its position, so a vector costs M / 2 bytes. Scores follow the
+ * simd_knn conventions for SIMD_KNN_L2 and SIMD_KNN_INNER_PRODUCT.
+ */
+typedef struct simd_pq simd_pq_t;
+
+// NULL unless M divides DIM, M <= 256 and METRIC is L2 or inner product
+simd_pq_t* simd_pq_create(size_t dim, size_t m, simd_knn_metric_t metric);
+void simd_pq_destroy(simd_pq_t* pq);
+
+// k-means++ seeding and ITERATIONS rounds of k-means per subquantizer over
+// N >= 16 vectors, subquantizers in parallel on the scheduler pool; false
+// on bad arguments or allocation failure
+bool simd_pq_train(simd_pq_t* pq, const float* vectors, size_t n, int iterations);
+
+// Centroid C of subquantizer J (DIM / M floats), NULL before training
+const float* simd_pq_centroid(const simd_pq_t* pq, size_t j, size_t c);
+
+/**
+ * Codes
+ * Codes are laid out in fast-scan blocks of 32 vectors: 16 bytes per
+ * subquantizer, byte i holding the code of vector i of the block in its
+ * low nibble and that of vector 16 + i in its high nibble. The last block
+ * is padded with code 0.
+ */
+
+// Bytes of codes for N vectors
+size_t simd_pq_code_bytes(const simd_pq_t* pq, size_t n);
+
+// Encode N vectors into simd_pq_code_bytes(pq, n) bytes of CODES; false
+// before training or on allocation failure
+bool simd_pq_encode(const simd_pq_t* pq, const float* vectors, uint8_t* codes, size_t n);
+
+// Reconstruct vector I from its codes
+void simd_pq_decode(const simd_pq_t* pq, const uint8_t* codes, float* vector, size_t i);
+
+/**
+ * Distance Tables
+ * TABLE[j * 16 + c] is the distance from subvector j of QUERY to centroid
+ * c: squared L2, or the negated inner product, so smaller is better for
+ * both. The byte table LUT approximates it as
+ * distance = sum of LUT entries * SCALE + BIAS.
+ */
+void simd_pq_table(const simd_pq_t* pq, const float* query, float* table);
+void simd_pq_lut_u8(const float* table, uint8_t* lut, float* scale, float* bias, size_t m);
+
+// OUT[i] = sum over j of LUT[j * 16 + code(i, j)] for N vectors
+void simd_pq_scan_u8(const uint8_t* lut, const uint8_t* codes, uint16_t* out, size_t m, size_t n);
+
+/**
+ * Search
+ * Fast-scans the N encoded vectors for each query, keeps the
+ * k * SIMD_PQ_RERANK smallest byte-table sums and re-ranks those with the
+ * float table. Writes ids and scores as simd_knn_search does. Queries
+ * run in parallel on the scheduler pool.
+ */
+bool simd_pq_search(const simd_pq_t* pq, const uint8_t* codes, const float* queries, int64_t* ids,
+                    float* scores, size_t n, size_t nq, size_t k);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_PQ_H */
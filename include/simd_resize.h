@@ -0,0 +1,74 @@
+/**
+ * simd_resize.h
+ * Image resizing: 2x box downsampling, Gaussian pyramids, bilinear and area resize
+ */
+#ifndef SIMD_RESIZE_H
+#define SIMD_RESIZE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * All functions take packed 8-bit images with 1, 3 or 4 interleaved
+ * channels (gray, RGB, RGBA); other channel counts are ignored.
+ */
+
+// Arbitrary-ratio interpolation
+typedef enum {
+    SIMD_RESIZE_BILINEAR,   // 2x2 neighborhood around each pixel center
+    SIMD_RESIZE_AREA        // Exact pixel-area average (bilinear when enlarging)
+} simd_resize_mode_t;
+
+/**
+ * 2x Downsampling and Pyramids
+ */
+
+// Average each 2x2 block, rounded; DST is (width / 2) x (height / 2)
+void simd_downsample2x_u8(const uint8_t* src, uint8_t* dst, int width, int height, int channels);
+
+// Gaussian blur ([1 4 6 4 1] / 16 per axis) then drop odd rows and columns;
+// DST is ((width + 1) / 2) x ((height + 1) / 2). Borders are reflected.
+void simd_pyr_down_u8(const uint8_t* src, uint8_t* dst, int width, int height, int channels);
+
+// Insert zero rows and columns and smooth with 4 x the same kernel;
+// DST is (2 * width) x (2 * height). Borders are reflected.
+void simd_pyr_up_u8(const uint8_t* src, uint8_t* dst, int width, int height, int channels);
+
+/**
+ * Arbitrary Resize
+ * Pixel centers are aligned ((x + 0.5) * scale - 0.5). Interpolation
+ * weights are precomputed once per call as fixed-point tables (8 bits for
+ * bilinear, 12 bits for area), so results are within 1-2 levels of
+ * floating-point interpolation. An exact 2x area reduction is handled by
+ * simd_downsample2x_u8. Both passes are NEON; the horizontal one gathers
+ * taps with table lookups and falls back to scalar code when shrinking by
+ * more than about 8x.
+ */
+
+void simd_resize_u8(const uint8_t* src, uint8_t* dst, int src_width, int src_height,
+                    int dst_width, int dst_height, int channels, simd_resize_mode_t mode);
+
+/**
+ * Strided Views
+ * Same operations on simd_image_t views; channels come from SRC and DST
+ * must have the same count and the output size stated above (for resize,
+ * DST's own size is the target).
+ */
+
+void simd_downsample2x_u8_view(const simd_image_t* src, const simd_image_t* dst);
+void simd_pyr_down_u8_view(const simd_image_t* src, const simd_image_t* dst);
+void simd_pyr_up_u8_view(const simd_image_t* src, const simd_image_t* dst);
+void simd_resize_u8_view(const simd_image_t* src, const simd_image_t* dst, simd_resize_mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_RESIZE_H */
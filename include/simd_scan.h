@@ -0,0 +1,67 @@
+/**
+ * simd_scan.h
+ * Prefix sums (scans): inclusive/exclusive, multi-threaded and segmented
+ */
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Scan flavors
+typedef enum {
+    SIMD_SCAN_INCLUSIVE,    // OUT[i] = IN[0] + ... + IN[i]
+    SIMD_SCAN_EXCLUSIVE     // OUT[i] = IN[0] + ... + IN[i - 1], OUT[0] = 0
+} simd_scan_kind_t;
+
+/**
+ * Prefix Sums
+ * OUT may alias IN (except for the widening u8 -> u32 scan). Each returns
+ * the total of all len elements. Integer scans wrap on overflow; float
+ * scans add in a different order than a sequential loop, so the last bits
+ * may differ from one.
+ */
+
+uint32_t simd_scan_u8_u32(const uint8_t* in, uint32_t* out, size_t len, simd_scan_kind_t kind);
+int32_t simd_scan_s32(const int32_t* in, int32_t* out, size_t len, simd_scan_kind_t kind);
+float simd_scan_f32(const float* in, float* out, size_t len, simd_scan_kind_t kind);
+double simd_scan_f64(const double* in, double* out, size_t len, simd_scan_kind_t kind);
+
+/**
+ * Multi-threaded Prefix Sums
+ * Two-pass block scan over `threads` equal ranges (0 = one per CPU): each
+ * range is first reduced, the range totals are scanned, then every range is
+ * scanned from its offset. Small arrays run on the calling thread.
+ */
+
+uint32_t simd_scan_parallel_u8_u32(const uint8_t* in, uint32_t* out, size_t len,
+                                   simd_scan_kind_t kind, int threads);
+int32_t simd_scan_parallel_s32(const int32_t* in, int32_t* out, size_t len,
+                               simd_scan_kind_t kind, int threads);
+float simd_scan_parallel_f32(const float* in, float* out, size_t len,
+                             simd_scan_kind_t kind, int threads);
+double simd_scan_parallel_f64(const double* in, double* out, size_t len,
+                              simd_scan_kind_t kind, int threads);
+
+/**
+ * Segmented Prefix Sums
+ * A nonzero FLAGS[i] starts a new segment at i: the running sum restarts
+ * there, so each segment is scanned independently.
+ */
+
+void simd_segmented_scan_s32(const int32_t* in, const uint8_t* flags, int32_t* out,
+                             size_t len, simd_scan_kind_t kind);
+void simd_segmented_scan_f32(const float* in, const uint8_t* flags, float* out,
+                             size_t len, simd_scan_kind_t kind);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_SCAN_H */
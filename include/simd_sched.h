@@ -0,0 +1,171 @@
+/**
+ * simd_sched.h
+ * Work-stealing task scheduler for multi-threaded kernels
+ */
+#ifndef SIMD_SCHED_H
+#define SIMD_SCHED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Deque slots reserved for threads outside the pool that call into it
+#define SIMD_SCHED_EXTERNAL_SLOTS 8
+
+/**
+ * CPU Topology
+ * Read from /sys/devices/system/cpu (or a copy of its layout for tests):
+ * the online list, then each CPU's cpu_capacity, falling back to
+ * cpufreq/cpuinfo_max_freq. On big.LITTLE parts, CPUs above the midpoint
+ * between the smallest and largest capacity are big; on homogeneous
+ * systems every CPU is big.
+ */
+typedef struct {
+    int id;                     // Logical CPU number
+    int capacity;               // Relative performance (cpu_capacity, or max kHz)
+    bool big;
+} simd_cpu_t;
+
+// Fill up to MAX entries in CPU order; ROOT NULL = the live system.
+// Returns the number of CPUs found (0 when the list cannot be read).
+int simd_cpu_topology(const char* root, simd_cpu_t* cpus, int max);
+
+/**
+ * Scheduler
+ * A process-wide pool of workers, each owning a Chase-Lev deque: the
+ * owner pushes and pops tasks at the bottom without contention, idle
+ * workers steal the oldest (largest) task from the top of a random
+ * victim. Threads calling into the scheduler borrow one of
+ * SIMD_SCHED_EXTERNAL_SLOTS deques for the duration of the call and work
+ * alongside the pool. The pool starts on first use with the defaults.
+ */
+typedef enum {
+    SIMD_AFFINITY_NONE,         // Workers float; the OS places them
+    SIMD_AFFINITY_SPREAD,       // One worker pinned per CPU, big cores first
+    SIMD_AFFINITY_BIG,          // Pinned to big cores only
+    SIMD_AFFINITY_LITTLE,       // Pinned to little cores only (background work)
+    SIMD_AFFINITY_NUMA          // Pinned per CPU, shared evenly across NUMA nodes
+} simd_affinity_t;
+
+typedef struct {
+    int threads;                // Pool workers (0 = selected CPUs - 1, for the caller)
+    simd_affinity_t affinity;
+    const char* topology_root;  // For simd_cpu_topology (NULL = live system)
+    const char* numa_root;      // For simd_numa_topology (NULL = live system)
+} simd_sched_config_t;
+
+// (Re)start the pool; must not be called while parallel work is running.
+// Returns false when no worker could be started (work then runs inline).
+bool simd_sched_init(const simd_sched_config_t* config);
+
+// Stop and join the workers (the next parallel call restarts the defaults)
+void simd_sched_shutdown(void);
+
+// Pool workers (starts the pool)
+int simd_sched_workers(void);
+
+// Deque slot of the calling thread while it runs scheduler work, else -1.
+// Slots are below SIMD_PARALLEL_MAX_THREADS, for per-slot scratch.
+int simd_sched_slot(void);
+
+typedef struct {
+    uint64_t spawned;           // Tasks pushed onto a deque
+    uint64_t stolen;            // Tasks taken by another thread
+    uint64_t steal_failures;    // Empty or lost steal attempts
+    uint64_t inline_runs;       // Spawns run inline (deque full or no slot)
+} simd_sched_stats_t;
+
+void simd_sched_get_stats(simd_sched_stats_t* stats);
+void simd_sched_reset_stats(void);
+
+/**
+ * Parallel Primitives
+ * All return once every piece of work has finished, and may be nested.
+ */
+typedef void (*simd_task_fn_t)(void* ctx);
+
+// Run A and B, B possibly on another thread (fork-join of two tasks)
+void simd_parallel_invoke(simd_task_fn_t a, void* ctx_a, simd_task_fn_t b, void* ctx_b);
+
+// Processes indices [begin, end)
+typedef void (*simd_range_fn_t)(void* ctx, size_t begin, size_t end);
+
+/**
+ * Run FN over [begin, end) in chunks of at least GRAIN indices (0 =
+ * adaptive). Splitting is lazy: a worker halves its remaining range only
+ * while its own deque is empty, i.e. when thieves would find nothing, so
+ * chunks stay large under full load and shrink when cores go idle.
+ */
+void simd_parallel_for(size_t begin, size_t end, size_t grain, simd_range_fn_t fn, void* ctx);
+
+// Largest accumulator simd_parallel_reduce splits (larger ones run serially)
+#define SIMD_PARALLEL_REDUCE_MAX 256
+
+// Accumulate [begin, end) into ACC; merge OTHER (the following range) into ACC
+typedef void (*simd_reduce_fn_t)(void* ctx, size_t begin, size_t end, void* acc);
+typedef void (*simd_combine_fn_t)(void* ctx, void* acc, const void* other);
+
+/**
+ * Reduce [begin, end) into RESULT (SIZE bytes, preset by the caller to the
+ * identity, which also seeds every split-off range). Partial results are
+ * combined in index order, so COMBINE need only be associative; where
+ * the ranges split varies between runs, so floating-point sums may differ
+ * in the last bits.
+ */
+void simd_parallel_reduce(size_t begin, size_t end, size_t grain, void* result, size_t size,
+                          simd_reduce_fn_t fn, simd_combine_fn_t combine, void* ctx);
+
+/**
+ * Detached Jobs
+ * A posted job runs later on a pool worker and the poster does not wait
+ * for it. Idle workers take posted jobs, oldest first, before stealing.
+ * With no pool workers the job runs inline, before simd_sched_post
+ * returns; jobs still queued at shutdown run on the stopping thread.
+ */
+typedef struct simd_job {
+    simd_task_fn_t fn;
+    void* ctx;
+    struct simd_job* next;      // Queue link, the scheduler's while posted
+} simd_job_t;
+
+// JOB must stay valid until its function has started
+void simd_sched_post(simd_job_t* job);
+
+/**
+ * NUMA Placement
+ * With SIMD_AFFINITY_NUMA the workers of each node occupy consecutive
+ * slots, numbered by node index 0 .. simd_sched_nodes() - 1 (nodes with
+ * CPUs, in node order). Work handed to a node stays there: its tasks are
+ * stolen only by workers of the same node, while workers of other nodes
+ * balance everything else. Without node placement there is one node.
+ */
+
+// Nodes the pool is placed on (starts the pool)
+int simd_sched_nodes(void);
+
+// Node index of the calling worker, else -1
+int simd_sched_node(void);
+
+// First index of NODE's part of [0, n), in proportion to its workers;
+// node i covers [start(n, i), start(n, i + 1))
+size_t simd_sched_node_start(size_t n, int node);
+
+// simd_parallel_for on the workers of NODE only; the caller waits
+void simd_parallel_for_node(int node, size_t begin, size_t end, size_t grain, simd_range_fn_t fn, void* ctx);
+
+/**
+ * Split [begin, end) by simd_sched_node_start and run each part on its
+ * node, matching simd_numa_alloc's first-touch partition. Inside node
+ * work, or with a single node, this is simd_parallel_for.
+ */
+void simd_parallel_for_nodes(size_t begin, size_t end, size_t grain, simd_range_fn_t fn, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_SCHED_H */
@@ -0,0 +1,93 @@
+/**
+ * simd_tile.h
+ * Tiled execution of stencil kernels with halo and border handling
+ */
+#ifndef SIMD_TILE_H
+#define SIMD_TILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+#include "simd_image.h"
+#include "simd_border.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest supported halo (apron) width in pixels
+#define SIMD_TILE_MAX_HALO 64
+
+/**
+ * Tiling parameters. Zero-initialized fields select the defaults, so
+ * `simd_tiling_t t = { .halo = 1 };` is a valid 8-bit, 3x3-stencil setup.
+ */
+typedef struct {
+    int pixel_size;             // Bytes per pixel (0 = 1)
+    int halo;                   // Source pixels a kernel may read around its tile
+    simd_border_t border;       // How the halo is filled outside the image
+    uint8_t border_value;       // Byte value for SIMD_BORDER_CONSTANT
+    int tile_width;             // Output tile size in pixels (0 = sized for L2)
+    int tile_height;
+    int threads;                // Parallelism (0 = scheduler pool, 1 = calling thread only)
+} simd_tiling_t;
+
+/**
+ * One tile as seen by a kernel. SRC points at source pixel (x0, y0) and
+ * rows/columns -halo .. width/height + halo - 1 around it are readable,
+ * already border-extended; it either aliases the source image or a
+ * per-worker staging copy. DST points at destination pixel (x0, y0).
+ */
+typedef struct {
+    const uint8_t* src;
+    size_t src_stride;          // Bytes between source rows
+    uint8_t* dst;
+    size_t dst_stride;          // Bytes between destination rows
+    int x0;                     // Tile origin in the image
+    int y0;
+    int width;                  // Tile size in pixels
+    int height;
+    int halo;
+    int worker;                 // Scheduler slot of the executing thread, < SIMD_PARALLEL_MAX_THREADS (for scratch)
+} simd_tile_t;
+
+// Tile kernel: fill tile->dst from tile->src
+typedef void (*simd_tile_fn_t)(void* ctx, const simd_tile_t* tile);
+
+/**
+ * Tiled Execution
+ * Splits the width x height destination into tiles and runs them as a
+ * parallel loop on the work-stealing scheduler, where idle cores steal
+ * runs of tiles from busy ones. SRC and DST are packed images (stride =
+ * width * pixel_size) and must not overlap. Returns the number of tiles,
+ * or 0 for invalid arguments or allocation failure.
+ */
+int simd_tile_run(const uint8_t* src, uint8_t* dst, int width, int height,
+                  const simd_tiling_t* tiling, simd_tile_fn_t fn, void* ctx);
+
+// simd_tile_run on strided views of equal size (tiling->pixel_size bytes
+// per pixel). Interior tiles read the source view in place, so a padded
+// frame or an ROI runs without a packed copy; edge tiles are staged with
+// the border of the view itself, not of the image around it.
+int simd_tile_run_view(const simd_image_t* src, const simd_image_t* dst,
+                       const simd_tiling_t* tiling, simd_tile_fn_t fn, void* ctx);
+
+// L2 cache size in bytes used for automatic tile sizing
+size_t simd_tile_l2_size(void);
+
+/**
+ * Stencil Tile Kernels (8-bit, halo >= 1, CTX unused)
+ */
+
+// 3x3 box blur, exactly rounded
+void simd_tile_box3x3_u8(void* ctx, const simd_tile_t* tile);
+
+// Sobel edge strength (|Gx| + |Gy|) / 2, saturated to 255
+void simd_tile_sobel_u8(void* ctx, const simd_tile_t* tile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_TILE_H */
@@ -0,0 +1,42 @@
+/**
+ * simd_transpose.h
+ * Matrix transpose kernels built from in-register NEON micro-transposes
+ */
+#ifndef SIMD_TRANSPOSE_H
+#define SIMD_TRANSPOSE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_detect.h"
+#include "neon_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Out-of-place Transpose
+ * SRC is a rows x cols row-major matrix; DST receives the cols x rows
+ * transpose (DST[c * rows + r] = SRC[r * cols + c]). Any shape is accepted.
+ * The matrix is split recursively (cache-oblivious) down to cache-resident
+ * tiles, which are transposed with 4x4 (f32), 8x8 (u16) or 16x16 (u8)
+ * register blocks.
+ */
+
+void simd_transpose_f32(const float* src, float* dst, size_t rows, size_t cols);
+void simd_transpose_u16(const uint16_t* src, uint16_t* dst, size_t rows, size_t cols);
+void simd_transpose_u8(const uint8_t* src, uint8_t* dst, size_t rows, size_t cols);
+
+/**
+ * In-place Transpose (square n x n matrices)
+ */
+
+void simd_transpose_inplace_f32(float* data, size_t n);
+void simd_transpose_inplace_u16(uint16_t* data, size_t n);
+void simd_transpose_inplace_u8(uint8_t* data, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMD_TRANSPOSE_H */
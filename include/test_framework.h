@@ -14,7 +14,7 @@
 
 // Test result structure
 typedef struct {
-    const char* name;
+    char name[128];
     bool passed;
     char message[256];
 } test_result_t;
@@ -63,7 +63,8 @@ static inline void test_suite_add_result(test_suite_t* suite, const char* name,
     }
     
     test_result_t* result = &suite->results[suite->count++];
-    result->name = name;
+    strncpy(result->name, name, sizeof(result->name) - 1);
+    result->name[sizeof(result->name) - 1] = '\0';
     result->passed = passed;
     strncpy(result->message, message, sizeof(result->message) - 1);
     result->message[sizeof(result->message) - 1] = '\0';
@@ -0,0 +1,178 @@
+/**
+ * simd_async.c
+ * Asynchronous kernel calls: a submission queue drained by pool dispatches
+ *
+ * Calls wait in one mutex-protected FIFO and are run by dispatch jobs
+ * posted to the scheduler. At most one dispatch is queued at a time:
+ * submitting to a queue that already has a dispatch on its way costs one
+ * lock and no wake-up, which is where the batching comes from under load,
+ * while a lone call is picked up as soon as a worker is free.
+ *
+ * Cancellation only ever removes a call from the queue, under the same
+ * lock the dispatches take calls with, so a call either runs exactly once
+ * or is cancelled exactly once and never touched by a worker afterwards.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "simd_async.h"
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+static void dispatch(void* arg);
+
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static simd_async_op_t* queue_head;
+static simd_async_op_t* queue_tail;
+static bool dispatch_queued;
+static simd_job_t dispatch_job = { dispatch, NULL, NULL };
+
+static atomic_ullong submitted;
+static atomic_ullong completed;
+static atomic_ullong cancelled;
+static atomic_ullong dispatches;
+static atomic_ullong batched;
+static atomic_ullong latency[SIMD_ASYNC_LATENCY_BUCKETS];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int simd_async_latency_bucket(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    int bucket = 0;
+    while (us >= 2 && bucket < SIMD_ASYNC_LATENCY_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// Count the call, then hand it back; OP is the caller's again afterwards
+static void complete(simd_async_op_t* op, simd_async_status_t status) {
+    if (status == SIMD_ASYNC_DONE) {
+        int bucket = simd_async_latency_bucket(now_ns() - op->submit_ns);
+        atomic_fetch_add_explicit(&latency[bucket], 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&completed, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&cancelled, 1, memory_order_relaxed);
+    }
+    if (op->done) op->done(op->done_ctx, status);
+}
+
+/*
+ * Dispatch
+ */
+
+static void dispatch(void* arg) {
+    (void)arg;
+    simd_async_op_t* batch[SIMD_ASYNC_BATCH_MAX];
+    int count = 0;
+    size_t bytes = 0;
+
+    // One large call, or small calls up to the byte budget
+    pthread_mutex_lock(&queue_lock);
+    dispatch_queued = false;
+    while (queue_head && count < SIMD_ASYNC_BATCH_MAX) {
+        simd_async_op_t* op = queue_head;
+        bool large = op->bytes >= SIMD_ASYNC_BATCH_BYTES;
+        if (count > 0 && (large || bytes + op->bytes > SIMD_ASYNC_BATCH_BYTES)) break;
+        queue_head = op->next;
+        if (!queue_head) queue_tail = NULL;
+        op->queued = 0;
+        batch[count++] = op;
+        bytes += op->bytes;
+        if (large) break;
+    }
+    bool more = queue_head && !dispatch_queued;
+    if (more) dispatch_queued = true;
+    pthread_mutex_unlock(&queue_lock);
+
+    // Let another worker start on the rest while this batch runs
+    if (more) simd_sched_post(&dispatch_job);
+
+    if (count == 0) return;
+    atomic_fetch_add_explicit(&dispatches, 1, memory_order_relaxed);
+    if (count > 1) atomic_fetch_add_explicit(&batched, (unsigned long long)count, memory_order_relaxed);
+    for (int i = 0; i < count; i++) {
+        batch[i]->fn(batch[i]->ctx);
+        complete(batch[i], SIMD_ASYNC_DONE);
+    }
+}
+
+/*
+ * Submission
+ */
+
+void simd_async_submit(simd_async_op_t* op, simd_task_fn_t fn, void* ctx, size_t bytes,
+                       simd_async_done_fn_t done, void* done_ctx) {
+    if (!op || !fn) return;
+    op->fn = fn;
+    op->ctx = ctx;
+    op->bytes = bytes;
+    op->done = done;
+    op->done_ctx = done_ctx;
+    op->submit_ns = now_ns();
+    op->queued = 0;
+    op->next = NULL;
+    atomic_fetch_add_explicit(&submitted, 1, memory_order_relaxed);
+
+    if (simd_sched_workers() == 0) {
+        fn(ctx);
+        complete(op, SIMD_ASYNC_DONE);
+        return;
+    }
+
+    pthread_mutex_lock(&queue_lock);
+    op->queued = 1;
+    if (queue_tail) queue_tail->next = op;
+    else queue_head = op;
+    queue_tail = op;
+    bool post = !dispatch_queued;
+    dispatch_queued = true;
+    pthread_mutex_unlock(&queue_lock);
+
+    if (post) simd_sched_post(&dispatch_job);
+}
+
+bool simd_async_cancel(simd_async_op_t* op) {
+    if (!op) return false;
+
+    pthread_mutex_lock(&queue_lock);
+    bool found = op->queued;
+    if (found) {
+        simd_async_op_t* prev = NULL;
+        for (simd_async_op_t* p = queue_head; p != op; p = p->next) prev = p;
+        if (prev) prev->next = op->next;
+        else queue_head = op->next;
+        if (queue_tail == op) queue_tail = prev;
+        op->queued = 0;
+    }
+    pthread_mutex_unlock(&queue_lock);
+
+    if (found) complete(op, SIMD_ASYNC_CANCELLED);
+    return found;
+}
+
+void simd_async_get_stats(simd_async_stats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->submitted = atomic_load_explicit(&submitted, memory_order_relaxed);
+    stats->completed = atomic_load_explicit(&completed, memory_order_relaxed);
+    stats->cancelled = atomic_load_explicit(&cancelled, memory_order_relaxed);
+    stats->dispatches = atomic_load_explicit(&dispatches, memory_order_relaxed);
+    stats->batched = atomic_load_explicit(&batched, memory_order_relaxed);
+    for (int i = 0; i < SIMD_ASYNC_LATENCY_BUCKETS; i++) {
+        stats->latency[i] = atomic_load_explicit(&latency[i], memory_order_relaxed);
+    }
+}
+
+void simd_async_reset_stats(void) {
+    atomic_store(&submitted, 0);
+    atomic_store(&completed, 0);
+    atomic_store(&cancelled, 0);
+    atomic_store(&dispatches, 0);
+    atomic_store(&batched, 0);
+    for (int i = 0; i < SIMD_ASYNC_LATENCY_BUCKETS; i++) atomic_store(&latency[i], 0);
+}
@@ -0,0 +1,318 @@
+/**
+ * simd_batch.c
+ * Implementation of batched small-vector kernels using NEON
+ *
+ * A single simd_dot_product_f32 on a 32-256 element vector spends much of
+ * its time outside the multiply-accumulate loop: the call itself, the
+ * dependent chain through its one accumulator, and the horizontal
+ * reduction at the end. The kernels here work on four results at once so
+ * that there are four (or sixteen) independent accumulator chains, and
+ * reduce four accumulators together with one 4x4 transpose instead of
+ * four separate pairwise adds. The transpose adds lanes in the order
+ * (l0 + l2) + (l1 + l3) and tails are added afterwards element by element,
+ * exactly as the single call does, so batched and single results match.
+ *
+ * The many-to-many kernel holds a 4x4 block of accumulators: every step
+ * loads four query and four database vectors and issues sixteen
+ * multiply-accumulates. Queries are walked in tiles that stay in L1 while
+ * each group of four database vectors passes over them.
+ */
+#include "simd_batch.h"
+#include "simd_ops.h"
+#include <stdlib.h>
+#include <string.h>
+#include <arm_neon.h>
+
+// Bytes of query vectors revisited by each group of database vectors
+#define QUERY_TILE_BYTES (16 * 1024)
+
+/*
+ * Reduction
+ */
+
+// Lane j of the result is the sum of the lanes of S[j]
+static inline float32x4_t reduce4(float32x4_t s0, float32x4_t s1, float32x4_t s2, float32x4_t s3) {
+    // vtrnq pairs lanes 0/2 and 1/3 of two accumulators in each half
+    float32x4x2_t p = vtrnq_f32(s0, s1);
+    float32x4x2_t q = vtrnq_f32(s2, s3);
+    float32x2_t lo = vadd_f32(vadd_f32(vget_low_f32(p.val[0]), vget_high_f32(p.val[0])),
+                              vadd_f32(vget_low_f32(p.val[1]), vget_high_f32(p.val[1])));
+    float32x2_t hi = vadd_f32(vadd_f32(vget_low_f32(q.val[0]), vget_high_f32(q.val[0])),
+                              vadd_f32(vget_low_f32(q.val[1]), vget_high_f32(q.val[1])));
+    return vcombine_f32(lo, hi);
+}
+
+// Add the elements past the last full vector to a reduced sum
+static inline float dot_tail(const float* a, const float* b, size_t from, size_t len, float sum) {
+    for (size_t i = from; i < len; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+/*
+ * Micro-kernels
+ */
+
+// OUT[j] = dot(A[j], B[j]) for four pairs
+static void dot_4(const float* const* a, const float* const* b, size_t len, float* out) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    float32x4_t acc2 = vdupq_n_f32(0.0f);
+    float32x4_t acc3 = vdupq_n_f32(0.0f);
+    size_t vec_len = len & ~(size_t)3;
+
+    for (size_t i = 0; i < vec_len; i += 4) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a[0] + i), vld1q_f32(b[0] + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a[1] + i), vld1q_f32(b[1] + i));
+        acc2 = vmlaq_f32(acc2, vld1q_f32(a[2] + i), vld1q_f32(b[2] + i));
+        acc3 = vmlaq_f32(acc3, vld1q_f32(a[3] + i), vld1q_f32(b[3] + i));
+    }
+
+    float sums[4];
+    vst1q_f32(sums, reduce4(acc0, acc1, acc2, acc3));
+    for (int j = 0; j < 4; j++) {
+        out[j] = dot_tail(a[j], b[j], vec_len, len, sums[j]);
+    }
+}
+
+// OUT[r * ldo + c] = dot(Q + r * dim, D + c * dim) for a 4x4 block
+static void dot_4x4(const float* q, const float* d, size_t dim, float* out, size_t ldo) {
+    float32x4_t acc[4][4];
+    size_t vec_len = dim & ~(size_t)3;
+
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) acc[r][c] = vdupq_n_f32(0.0f);
+    }
+
+    for (size_t i = 0; i < vec_len; i += 4) {
+        float32x4_t vq[4], vd[4];
+        for (int r = 0; r < 4; r++) vq[r] = vld1q_f32(q + r * dim + i);
+        for (int c = 0; c < 4; c++) vd[c] = vld1q_f32(d + c * dim + i);
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 4; c++) acc[r][c] = vmlaq_f32(acc[r][c], vq[r], vd[c]);
+        }
+    }
+
+    for (int r = 0; r < 4; r++) {
+        float sums[4];
+        vst1q_f32(sums, reduce4(acc[r][0], acc[r][1], acc[r][2], acc[r][3]));
+        for (int c = 0; c < 4; c++) {
+            out[r * ldo + c] = dot_tail(q + r * dim, d + c * dim, vec_len, dim, sums[c]);
+        }
+    }
+}
+
+/*
+ * Many-to-Many Dot Products
+ */
+
+void simd_dot_many_f32(const float* queries, const float* db, float* out,
+                       size_t nq, size_t nd, size_t dim) {
+    if (!queries || !db || !out) return;
+
+    size_t tile = dim > 0 ? QUERY_TILE_BYTES / (dim * sizeof(float)) : nq;
+    tile = tile < 4 ? 4 : tile & ~(size_t)3;
+
+    for (size_t q0 = 0; q0 < nq; q0 += tile) {
+        size_t q1 = q0 + tile < nq ? q0 + tile : nq;
+        size_t d = 0;
+
+        for (; d + 4 <= nd; d += 4) {
+            const float* dv = db + d * dim;
+            size_t q = q0;
+            for (; q + 4 <= q1; q += 4) {
+                dot_4x4(queries + q * dim, dv, dim, out + q * nd + d, nd);
+            }
+
+            // Leftover queries: one query against the four database vectors
+            for (; q < q1; q++) {
+                const float* qv = queries + q * dim;
+                const float* a[4] = { qv, qv, qv, qv };
+                const float* b[4] = { dv, dv + dim, dv + 2 * dim, dv + 3 * dim };
+                dot_4(a, b, dim, out + q * nd + d);
+            }
+        }
+
+        // Leftover database vectors
+        for (; d < nd; d++) {
+            for (size_t q = q0; q < q1; q++) {
+                out[q * nd + d] = simd_dot_product_f32(queries + q * dim, db + d * dim, dim);
+            }
+        }
+    }
+}
+
+/*
+ * Pointer-Array Batches
+ */
+
+void simd_dot_batch_f32(const float* const* a, const float* const* b, float* out,
+                        size_t count, size_t len) {
+    if (!a || !b || !out) return;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        dot_4(a + i, b + i, len, out + i);
+    }
+    for (; i < count; i++) {
+        out[i] = simd_dot_product_f32(a[i], b[i], len);
+    }
+}
+
+// C = A + B, or C = A * B when MUL; inlined with MUL constant
+static inline void binary_f32(const float* a, const float* b, float* c, size_t len, bool mul) {
+    size_t i = 0;
+
+    // Process 16 elements at a time: four independent vectors in flight
+    for (; i + 16 <= len; i += 16) {
+        float32x4_t a0 = vld1q_f32(a + i), a1 = vld1q_f32(a + i + 4);
+        float32x4_t a2 = vld1q_f32(a + i + 8), a3 = vld1q_f32(a + i + 12);
+        float32x4_t b0 = vld1q_f32(b + i), b1 = vld1q_f32(b + i + 4);
+        float32x4_t b2 = vld1q_f32(b + i + 8), b3 = vld1q_f32(b + i + 12);
+        vst1q_f32(c + i, mul ? vmulq_f32(a0, b0) : vaddq_f32(a0, b0));
+        vst1q_f32(c + i + 4, mul ? vmulq_f32(a1, b1) : vaddq_f32(a1, b1));
+        vst1q_f32(c + i + 8, mul ? vmulq_f32(a2, b2) : vaddq_f32(a2, b2));
+        vst1q_f32(c + i + 12, mul ? vmulq_f32(a3, b3) : vaddq_f32(a3, b3));
+    }
+    for (; i + 4 <= len; i += 4) {
+        float32x4_t va = vld1q_f32(a + i);
+        float32x4_t vb = vld1q_f32(b + i);
+        vst1q_f32(c + i, mul ? vmulq_f32(va, vb) : vaddq_f32(va, vb));
+    }
+    for (; i < len; i++) {
+        c[i] = mul ? a[i] * b[i] : a[i] + b[i];
+    }
+}
+
+void simd_add_batch_f32(const float* const* a, const float* const* b, float* const* c,
+                        size_t count, size_t len) {
+    if (!a || !b || !c) return;
+    for (size_t i = 0; i < count; i++) {
+        binary_f32(a[i], b[i], c[i], len, false);
+    }
+}
+
+void simd_mul_batch_f32(const float* const* a, const float* const* b, float* const* c,
+                        size_t count, size_t len) {
+    if (!a || !b || !c) return;
+    for (size_t i = 0; i < count; i++) {
+        binary_f32(a[i], b[i], c[i], len, true);
+    }
+}
+
+/*
+ * Coalescer
+ */
+
+typedef struct {
+    const float** a;
+    const float** b;
+    float** out;
+    size_t count;
+} queue_t;
+
+struct simd_coalescer {
+    size_t len;
+    size_t capacity;
+    queue_t dot;
+    queue_t add;
+    queue_t mul;
+    float* results;             // Dot products before they are scattered
+    simd_coalescer_stats_t stats;
+};
+
+simd_coalescer_t* simd_coalescer_create(size_t len, size_t capacity) {
+    if (capacity == 0) return NULL;
+
+    simd_coalescer_t* co = (simd_coalescer_t*)calloc(1, sizeof(simd_coalescer_t));
+    if (!co) return NULL;
+
+    // One block: three pointer arrays per queue, then the dot results
+    void** block = (void**)malloc(9 * capacity * sizeof(void*) + capacity * sizeof(float));
+    if (!block) {
+        free(co);
+        return NULL;
+    }
+    queue_t* queues[3] = { &co->dot, &co->add, &co->mul };
+    for (int i = 0; i < 3; i++) {
+        queues[i]->a = (const float**)(block + (3 * i) * capacity);
+        queues[i]->b = (const float**)(block + (3 * i + 1) * capacity);
+        queues[i]->out = (float**)(block + (3 * i + 2) * capacity);
+    }
+    co->results = (float*)(block + 9 * capacity);
+    co->len = len;
+    co->capacity = capacity;
+    return co;
+}
+
+void simd_coalescer_destroy(simd_coalescer_t* co) {
+    if (!co) return;
+    simd_coalescer_flush(co);
+    free((void*)co->dot.a);
+    free(co);
+}
+
+static size_t run_pending(simd_coalescer_t* co) {
+    size_t ran = co->dot.count + co->add.count + co->mul.count;
+
+    if (co->dot.count) {
+        simd_dot_batch_f32(co->dot.a, co->dot.b, co->results, co->dot.count, co->len);
+        for (size_t i = 0; i < co->dot.count; i++) {
+            *co->dot.out[i] = co->results[i];
+        }
+    }
+    if (co->add.count) {
+        simd_add_batch_f32(co->add.a, co->add.b, co->add.out, co->add.count, co->len);
+    }
+    if (co->mul.count) {
+        simd_mul_batch_f32(co->mul.a, co->mul.b, co->mul.out, co->mul.count, co->len);
+    }
+    co->dot.count = co->add.count = co->mul.count = 0;
+
+    co->stats.calls += ran;
+    if (ran) co->stats.flushes++;
+    return ran;
+}
+
+static void push(simd_coalescer_t* co, queue_t* q, const float* a, const float* b, float* out) {
+    q->a[q->count] = a;
+    q->b[q->count] = b;
+    q->out[q->count] = out;
+
+    // A full buffer runs everything pending, not just its own kind
+    if (++q->count == co->capacity) {
+        co->stats.full++;
+        run_pending(co);
+    }
+}
+
+void simd_coalescer_dot_f32(simd_coalescer_t* co, const float* a, const float* b, float* out) {
+    if (!co || !a || !b || !out) return;
+    push(co, &co->dot, a, b, out);
+}
+
+void simd_coalescer_add_f32(simd_coalescer_t* co, const float* a, const float* b, float* c) {
+    if (!co || !a || !b || !c) return;
+    push(co, &co->add, a, b, c);
+}
+
+void simd_coalescer_mul_f32(simd_coalescer_t* co, const float* a, const float* b, float* c) {
+    if (!co || !a || !b || !c) return;
+    push(co, &co->mul, a, b, c);
+}
+
+size_t simd_coalescer_flush(simd_coalescer_t* co) {
+    if (!co) return 0;
+    return run_pending(co);
+}
+
+size_t simd_coalescer_pending(const simd_coalescer_t* co) {
+    if (!co) return 0;
+    return co->dot.count + co->add.count + co->mul.count;
+}
+
+void simd_coalescer_get_stats(const simd_coalescer_t* co, simd_coalescer_stats_t* stats) {
+    if (!co || !stats) return;
+    *stats = co->stats;
+}
@@ -0,0 +1,413 @@
+/**
+ * simd_bitmap.c
+ * Implementation of packed bitmaps and predicate algebra using NEON
+ */
+#include "simd_bitmap.h"
+#include "simd_filter.h"
+#include <stdlib.h>
+#include <arm_neon.h>
+
+// Per-byte bit weights: byte j of each 8-byte half contributes bit j
+static const uint8_t byte_bit_weights[16] = {
+    1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+};
+static const uint32_t lane_bits_u32[4] = { 1, 2, 4, 8 };
+
+/*
+ * Bitmap Lifetime
+ */
+
+simd_bitmap_t* simd_bitmap_create(size_t len) {
+    simd_bitmap_t* bm = (simd_bitmap_t*)malloc(sizeof(simd_bitmap_t));
+    if (!bm) return NULL;
+
+    bm->len = len;
+    bm->word_count = (len + 63) / 64;
+
+    // Always allocate at least one word so empty bitmaps stay valid
+    size_t alloc_words = bm->word_count > 0 ? bm->word_count : 1;
+    bm->words = (uint64_t*)neon_malloc(alloc_words * sizeof(uint64_t));
+    if (!bm->words) {
+        free(bm);
+        return NULL;
+    }
+
+    memset(bm->words, 0, alloc_words * sizeof(uint64_t));
+    return bm;
+}
+
+void simd_bitmap_destroy(simd_bitmap_t* bm) {
+    if (bm) {
+        free(bm->words);
+        free(bm);
+    }
+}
+
+// Clear the unused bits past len in the last word
+static inline void clear_tail(simd_bitmap_t* bm) {
+    if (bm->len % 64) {
+        bm->words[bm->word_count - 1] &= ((uint64_t)1 << (bm->len % 64)) - 1;
+    }
+}
+
+void simd_bitmap_clear(simd_bitmap_t* bm) {
+    memset(bm->words, 0, bm->word_count * sizeof(uint64_t));
+}
+
+void simd_bitmap_fill(simd_bitmap_t* bm) {
+    memset(bm->words, 0xFF, bm->word_count * sizeof(uint64_t));
+    clear_tail(bm);
+}
+
+/*
+ * Bitmaps From Comparisons
+ */
+
+// Collapse four 16-lane byte masks (0x00/0xFF) into one 64-bit word.
+// Weighting each byte by its bit and pairwise-adding three times ORs the
+// disjoint bits together, leaving 8 bytes = 64 bits in the low half.
+static inline uint64_t byte_masks_to_word(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+    uint8x16_t weights = vld1q_u8(byte_bit_weights);
+
+    uint8x16_t t0 = vpaddq_u8(vandq_u8(m0, weights), vandq_u8(m1, weights));
+    uint8x16_t t1 = vpaddq_u8(vandq_u8(m2, weights), vandq_u8(m3, weights));
+    uint8x16_t t2 = vpaddq_u8(t0, t1);
+    uint8x16_t t3 = vpaddq_u8(t2, t2);
+
+    return vgetq_lane_u64(vreinterpretq_u64_u8(t3), 0);
+}
+
+// Narrow four 32-bit lane masks to one 16-lane byte mask with vshrn
+static inline uint8x16_t narrow_masks_u32(uint32x4_t m0, uint32x4_t m1, uint32x4_t m2, uint32x4_t m3) {
+    uint16x8_t m01 = vcombine_u16(vshrn_n_u32(m0, 16), vshrn_n_u32(m1, 16));
+    uint16x8_t m23 = vcombine_u16(vshrn_n_u32(m2, 16), vshrn_n_u32(m3, 16));
+    return vcombine_u8(vshrn_n_u16(m01, 8), vshrn_n_u16(m23, 8));
+}
+
+#define BITMAP_INLINE static inline __attribute__((always_inline))
+
+BITMAP_INLINE uint32x4_t cmp_f32(float32x4_t a, float32x4_t v, simd_cmp_op_t op) {
+    switch (op) {
+        case SIMD_CMP_GT: return vcgtq_f32(a, v);
+        case SIMD_CMP_GE: return vcgeq_f32(a, v);
+        case SIMD_CMP_LT: return vcltq_f32(a, v);
+        case SIMD_CMP_LE: return vcleq_f32(a, v);
+        case SIMD_CMP_EQ: return vceqq_f32(a, v);
+        default:          return vmvnq_u32(vceqq_f32(a, v));
+    }
+}
+
+BITMAP_INLINE uint32x4_t cmp_s32(int32x4_t a, int32x4_t v, simd_cmp_op_t op) {
+    switch (op) {
+        case SIMD_CMP_GT: return vcgtq_s32(a, v);
+        case SIMD_CMP_GE: return vcgeq_s32(a, v);
+        case SIMD_CMP_LT: return vcltq_s32(a, v);
+        case SIMD_CMP_LE: return vcleq_s32(a, v);
+        case SIMD_CMP_EQ: return vceqq_s32(a, v);
+        default:          return vmvnq_u32(vceqq_s32(a, v));
+    }
+}
+
+BITMAP_INLINE uint8x16_t cmp_u8(uint8x16_t a, uint8x16_t v, simd_cmp_op_t op) {
+    switch (op) {
+        case SIMD_CMP_GT: return vcgtq_u8(a, v);
+        case SIMD_CMP_GE: return vcgeq_u8(a, v);
+        case SIMD_CMP_LT: return vcltq_u8(a, v);
+        case SIMD_CMP_LE: return vcleq_u8(a, v);
+        case SIMD_CMP_EQ: return vceqq_u8(a, v);
+        default:          return vmvnq_u8(vceqq_u8(a, v));
+    }
+}
+
+// Scalar predicate for the remaining elements (works for any arithmetic type)
+#define CMP_SCALAR(x, op, v) \
+    ((op) == SIMD_CMP_GT ? (x) > (v) : \
+     (op) == SIMD_CMP_GE ? (x) >= (v) : \
+     (op) == SIMD_CMP_LT ? (x) < (v) : \
+     (op) == SIMD_CMP_LE ? (x) <= (v) : \
+     (op) == SIMD_CMP_EQ ? (x) == (v) : (x) != (v))
+
+BITMAP_INLINE void bitmap_cmp_f32(simd_bitmap_t* bm, const float* a, simd_cmp_op_t op, float value) {
+    float32x4_t v = vdupq_n_f32(value);
+    size_t full_words = bm->len / 64;
+
+    // Produce one 64-bit word (64 elements) per iteration
+    for (size_t w = 0; w < full_words; w++) {
+        const float* p = a + w * 64;
+        uint8x16_t m[4];
+
+        for (int g = 0; g < 4; g++) {
+            m[g] = narrow_masks_u32(cmp_f32(vld1q_f32(p + g * 16), v, op),
+                                    cmp_f32(vld1q_f32(p + g * 16 + 4), v, op),
+                                    cmp_f32(vld1q_f32(p + g * 16 + 8), v, op),
+                                    cmp_f32(vld1q_f32(p + g * 16 + 12), v, op));
+        }
+
+        bm->words[w] = byte_masks_to_word(m[0], m[1], m[2], m[3]);
+    }
+
+    // Handle remaining elements
+    if (full_words < bm->word_count) {
+        uint64_t word = 0;
+        for (size_t i = full_words * 64; i < bm->len; i++) {
+            if (CMP_SCALAR(a[i], op, value)) word |= (uint64_t)1 << (i % 64);
+        }
+        bm->words[full_words] = word;
+    }
+}
+
+BITMAP_INLINE void bitmap_cmp_s32(simd_bitmap_t* bm, const int32_t* a, simd_cmp_op_t op, int32_t value) {
+    int32x4_t v = vdupq_n_s32(value);
+    size_t full_words = bm->len / 64;
+
+    // Produce one 64-bit word (64 elements) per iteration
+    for (size_t w = 0; w < full_words; w++) {
+        const int32_t* p = a + w * 64;
+        uint8x16_t m[4];
+
+        for (int g = 0; g < 4; g++) {
+            m[g] = narrow_masks_u32(cmp_s32(vld1q_s32(p + g * 16), v, op),
+                                    cmp_s32(vld1q_s32(p + g * 16 + 4), v, op),
+                                    cmp_s32(vld1q_s32(p + g * 16 + 8), v, op),
+                                    cmp_s32(vld1q_s32(p + g * 16 + 12), v, op));
+        }
+
+        bm->words[w] = byte_masks_to_word(m[0], m[1], m[2], m[3]);
+    }
+
+    // Handle remaining elements
+    if (full_words < bm->word_count) {
+        uint64_t word = 0;
+        for (size_t i = full_words * 64; i < bm->len; i++) {
+            if (CMP_SCALAR(a[i], op, value)) word |= (uint64_t)1 << (i % 64);
+        }
+        bm->words[full_words] = word;
+    }
+}
+
+BITMAP_INLINE void bitmap_cmp_u8(simd_bitmap_t* bm, const uint8_t* a, simd_cmp_op_t op, uint8_t value) {
+    uint8x16_t v = vdupq_n_u8(value);
+    size_t full_words = bm->len / 64;
+
+    // Produce one 64-bit word (64 elements) per iteration
+    for (size_t w = 0; w < full_words; w++) {
+        const uint8_t* p = a + w * 64;
+        bm->words[w] = byte_masks_to_word(cmp_u8(vld1q_u8(p), v, op),
+                                          cmp_u8(vld1q_u8(p + 16), v, op),
+                                          cmp_u8(vld1q_u8(p + 32), v, op),
+                                          cmp_u8(vld1q_u8(p + 48), v, op));
+    }
+
+    // Handle remaining elements
+    if (full_words < bm->word_count) {
+        uint64_t word = 0;
+        for (size_t i = full_words * 64; i < bm->len; i++) {
+            if (CMP_SCALAR(a[i], op, value)) word |= (uint64_t)1 << (i % 64);
+        }
+        bm->words[full_words] = word;
+    }
+}
+
+// Dispatch once per call so each predicate gets its own specialized loop
+#define BITMAP_DISPATCH(fn, bm, a, op, value) do { \
+    switch (op) { \
+        case SIMD_CMP_GT: fn(bm, a, SIMD_CMP_GT, value); break; \
+        case SIMD_CMP_GE: fn(bm, a, SIMD_CMP_GE, value); break; \
+        case SIMD_CMP_LT: fn(bm, a, SIMD_CMP_LT, value); break; \
+        case SIMD_CMP_LE: fn(bm, a, SIMD_CMP_LE, value); break; \
+        case SIMD_CMP_EQ: fn(bm, a, SIMD_CMP_EQ, value); break; \
+        default:          fn(bm, a, SIMD_CMP_NE, value); break; \
+    } \
+} while (0)
+
+void simd_bitmap_cmp_f32(simd_bitmap_t* bm, const float* a, simd_cmp_op_t op, float value) {
+    BITMAP_DISPATCH(bitmap_cmp_f32, bm, a, op, value);
+}
+
+void simd_bitmap_cmp_s32(simd_bitmap_t* bm, const int32_t* a, simd_cmp_op_t op, int32_t value) {
+    BITMAP_DISPATCH(bitmap_cmp_s32, bm, a, op, value);
+}
+
+void simd_bitmap_cmp_u8(simd_bitmap_t* bm, const uint8_t* a, simd_cmp_op_t op, uint8_t value) {
+    BITMAP_DISPATCH(bitmap_cmp_u8, bm, a, op, value);
+}
+
+/*
+ * Predicate Algebra
+ */
+
+enum {
+    BITOP_AND,
+    BITOP_OR,
+    BITOP_XOR,
+    BITOP_ANDNOT
+};
+
+BITMAP_INLINE void bitmap_binary(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b, int op) {
+    // Process 2 words (128 bits) at a time using NEON
+    size_t vec_size = dst->word_count / 2;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint64x2_t va = vld1q_u64(a->words + i * 2);
+        uint64x2_t vb = vld1q_u64(b->words + i * 2);
+        uint64x2_t vc;
+
+        switch (op) {
+            case BITOP_AND: vc = vandq_u64(va, vb); break;
+            case BITOP_OR:  vc = vorrq_u64(va, vb); break;
+            case BITOP_XOR: vc = veorq_u64(va, vb); break;
+            default:        vc = vbicq_u64(va, vb); break;
+        }
+
+        vst1q_u64(dst->words + i * 2, vc);
+    }
+
+    // Handle remaining word
+    for (size_t i = vec_size * 2; i < dst->word_count; i++) {
+        switch (op) {
+            case BITOP_AND: dst->words[i] = a->words[i] & b->words[i]; break;
+            case BITOP_OR:  dst->words[i] = a->words[i] | b->words[i]; break;
+            case BITOP_XOR: dst->words[i] = a->words[i] ^ b->words[i]; break;
+            default:        dst->words[i] = a->words[i] & ~b->words[i]; break;
+        }
+    }
+}
+
+void simd_bitmap_and(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b) {
+    bitmap_binary(dst, a, b, BITOP_AND);
+}
+
+void simd_bitmap_or(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b) {
+    bitmap_binary(dst, a, b, BITOP_OR);
+}
+
+void simd_bitmap_xor(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b) {
+    bitmap_binary(dst, a, b, BITOP_XOR);
+}
+
+void simd_bitmap_andnot(simd_bitmap_t* dst, const simd_bitmap_t* a, const simd_bitmap_t* b) {
+    bitmap_binary(dst, a, b, BITOP_ANDNOT);
+}
+
+void simd_bitmap_not(simd_bitmap_t* dst, const simd_bitmap_t* a) {
+    // Process 2 words (128 bits) at a time using NEON
+    size_t vec_size = dst->word_count / 2;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint32x4_t va = vreinterpretq_u32_u64(vld1q_u64(a->words + i * 2));
+        vst1q_u64(dst->words + i * 2, vreinterpretq_u64_u32(vmvnq_u32(va)));
+    }
+
+    // Handle remaining word
+    for (size_t i = vec_size * 2; i < dst->word_count; i++) {
+        dst->words[i] = ~a->words[i];
+    }
+
+    // Keep bits past len clear
+    clear_tail(dst);
+}
+
+/*
+ * Queries and Consumers
+ */
+
+size_t simd_bitmap_count(const simd_bitmap_t* bm) {
+    // vcntq_u8-based popcount shared with the filter module
+    return simd_popcount_bits(bm->words, bm->len);
+}
+
+size_t simd_bitmap_to_indices(const simd_bitmap_t* bm, uint32_t* indices) {
+    size_t count = 0;
+
+    // Test 2 words at a time so empty 128-bit runs are skipped with one compare
+    size_t vec_size = bm->word_count / 2;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint32x4_t v = vreinterpretq_u32_u64(vld1q_u64(bm->words + i * 2));
+        if (vmaxvq_u32(v) == 0) continue;
+
+        for (size_t w = i * 2; w < i * 2 + 2; w++) {
+            uint64_t word = bm->words[w];
+            while (word) {
+                indices[count++] = (uint32_t)(w * 64 + __builtin_ctzll(word));
+                word &= word - 1;  // Clear lowest set bit
+            }
+        }
+    }
+
+    // Handle remaining word
+    for (size_t w = vec_size * 2; w < bm->word_count; w++) {
+        uint64_t word = bm->words[w];
+        while (word) {
+            indices[count++] = (uint32_t)(w * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+
+    return count;
+}
+
+void simd_bitmap_iter_init(simd_bitmap_iter_t* it, const simd_bitmap_t* bm) {
+    it->bm = bm;
+    it->word = 0;
+    it->pending = bm->word_count > 0 ? bm->words[0] : 0;
+}
+
+int simd_bitmap_iter_next(simd_bitmap_iter_t* it, size_t* index) {
+    // Advance to the next word with set bits
+    while (it->pending == 0) {
+        if (++it->word >= it->bm->word_count) {
+            it->word = it->bm->word_count;
+            return 0;
+        }
+        it->pending = it->bm->words[it->word];
+    }
+
+    *index = it->word * 64 + (size_t)__builtin_ctzll(it->pending);
+    it->pending &= it->pending - 1;
+    return 1;
+}
+
+// Expand 4 bits of the bitmap into a 4-lane select mask
+static inline uint32x4_t bits_to_lane_mask(uint64_t word, size_t i) {
+    uint32x4_t nibble = vdupq_n_u32((uint32_t)(word >> (i % 64)) & 0xF);
+    return vtstq_u32(nibble, vld1q_u32(lane_bits_u32));
+}
+
+void simd_bitmap_select_f32(const simd_bitmap_t* bm, const float* a, const float* b, float* c) {
+    // Process 4 elements at a time using NEON
+    size_t vec_size = bm->len / 4;
+
+    for (size_t v = 0; v < vec_size; v++) {
+        size_t i = v * 4;
+        uint32x4_t mask = bits_to_lane_mask(bm->words[i / 64], i);
+
+        float32x4_t va = vld1q_f32(a + i);
+        float32x4_t vb = vld1q_f32(b + i);
+        vst1q_f32(c + i, vbslq_f32(mask, va, vb));
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < bm->len; i++) {
+        c[i] = simd_bitmap_get(bm, i) ? a[i] : b[i];
+    }
+}
+
+void simd_bitmap_select_s32(const simd_bitmap_t* bm, const int32_t* a, const int32_t* b, int32_t* c) {
+    // Process 4 elements at a time using NEON
+    size_t vec_size = bm->len / 4;
+
+    for (size_t v = 0; v < vec_size; v++) {
+        size_t i = v * 4;
+        uint32x4_t mask = bits_to_lane_mask(bm->words[i / 64], i);
+
+        int32x4_t va = vld1q_s32(a + i);
+        int32x4_t vb = vld1q_s32(b + i);
+        vst1q_s32(c + i, vbslq_s32(mask, va, vb));
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < bm->len; i++) {
+        c[i] = simd_bitmap_get(bm, i) ? a[i] : b[i];
+    }
+}
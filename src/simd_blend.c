@@ -0,0 +1,301 @@
+/**
+ * simd_blend.c
+ * Implementation of alpha blending and compositing using NEON
+ *
+ * Pixels are loaded 16 at a time with vld4q_u8, so each channel (and the
+ * alpha that weights it) is a full vector. Products are 16-bit (vmull_u8 /
+ * vmlal_u8) and divided by 255 with exact rounding:
+ *
+ *     x / 255 = (x + 128 + ((x + 128) >> 8)) >> 8
+ *
+ * which is one vrshrq_n_u16, one add and one narrowing vrshrn_n_u16.
+ */
+#include "simd_blend.h"
+#include <stdlib.h>
+#include <string.h>
+#include <arm_neon.h>
+
+/*
+ * Divide by 255
+ */
+
+static inline uint8_t div255(uint32_t x) {
+    x += 128;
+    return (uint8_t)((x + (x >> 8)) >> 8);
+}
+
+static inline uint8x8_t div255_u16x8(uint16x8_t x) {
+    return vrshrn_n_u16(vaddq_u16(x, vrshrq_n_u16(x, 8)), 8);
+}
+
+// A * B / 255
+static inline uint8x16_t mul255_u8x16(uint8x16_t a, uint8x16_t b) {
+    uint16x8_t lo = vmull_u8(vget_low_u8(a), vget_low_u8(b));
+    uint16x8_t hi = vmull_high_u8(a, b);
+    return vcombine_u8(div255_u16x8(lo), div255_u16x8(hi));
+}
+
+// (A * (255 - T) + B * T) / 255
+static inline uint8x16_t lerp255_u8x16(uint8x16_t a, uint8x16_t b, uint8x16_t t) {
+    uint8x16_t it = vmvnq_u8(t);
+    uint16x8_t lo = vmull_u8(vget_low_u8(a), vget_low_u8(it));
+    uint16x8_t hi = vmull_high_u8(a, it);
+    lo = vmlal_u8(lo, vget_low_u8(b), vget_low_u8(t));
+    hi = vmlal_high_u8(hi, b, t);
+    return vcombine_u8(div255_u16x8(lo), div255_u16x8(hi));
+}
+
+/*
+ * Alpha Blending
+ */
+
+void simd_blend_over_rgba(const uint8_t* fg, const uint8_t* bg, uint8_t* dst, size_t pixel_count) {
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 64;
+        uint8x16x4_t f = vld4q_u8(fg + j);
+        uint8x16x4_t b = vld4q_u8(bg + j);
+        uint8x16_t a = f.val[3];
+        uint8x16x4_t out;
+        out.val[0] = lerp255_u8x16(b.val[0], f.val[0], a);
+        out.val[1] = lerp255_u8x16(b.val[1], f.val[1], a);
+        out.val[2] = lerp255_u8x16(b.val[2], f.val[2], a);
+        out.val[3] = vaddq_u8(a, mul255_u8x16(b.val[3], vmvnq_u8(a)));
+        vst4q_u8(dst + j, out);
+    }
+
+    // Handle remaining pixels
+    for (size_t j = vec_size * 64; j < pixel_count * 4; j += 4) {
+        uint32_t a = fg[j + 3];
+        for (int c = 0; c < 3; c++) dst[j + c] = div255(bg[j + c] * (255 - a) + fg[j + c] * a);
+        dst[j + 3] = (uint8_t)(a + div255(bg[j + 3] * (255 - a)));
+    }
+}
+
+void simd_blend_over_premul_rgba(const uint8_t* fg, const uint8_t* bg, uint8_t* dst, size_t pixel_count) {
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 64;
+        uint8x16x4_t f = vld4q_u8(fg + j);
+        uint8x16x4_t b = vld4q_u8(bg + j);
+        uint8x16_t ia = vmvnq_u8(f.val[3]);
+        uint8x16x4_t out;
+        for (int c = 0; c < 4; c++) out.val[c] = vqaddq_u8(f.val[c], mul255_u8x16(b.val[c], ia));
+        vst4q_u8(dst + j, out);
+    }
+
+    // Handle remaining pixels
+    for (size_t j = vec_size * 64; j < pixel_count * 4; j += 4) {
+        uint32_t ia = 255 - fg[j + 3];
+        for (int c = 0; c < 4; c++) {
+            uint32_t v = fg[j + c] + div255(bg[j + c] * ia);
+            dst[j + c] = (uint8_t)(v > 255 ? 255 : v);
+        }
+    }
+}
+
+void simd_crossfade_rgba(const uint8_t* a, const uint8_t* b, uint8_t alpha, uint8_t* dst, size_t pixel_count) {
+    // Every channel uses the same weight, so no deinterleave is needed
+    size_t len = pixel_count * 4;
+    uint8x16_t t = vdupq_n_u8(alpha);
+
+    // Process 16 bytes at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 16;
+        vst1q_u8(dst + j, lerp255_u8x16(vld1q_u8(a + j), vld1q_u8(b + j), t));
+    }
+
+    // Handle remaining bytes
+    for (size_t j = vec_size * 16; j < len; j++) {
+        dst[j] = div255(a[j] * (255u - alpha) + b[j] * (uint32_t)alpha);
+    }
+}
+
+void simd_premultiply_rgba(const uint8_t* src, uint8_t* dst, size_t pixel_count) {
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 64;
+        uint8x16x4_t p = vld4q_u8(src + j);
+        for (int c = 0; c < 3; c++) p.val[c] = mul255_u8x16(p.val[c], p.val[3]);
+        vst4q_u8(dst + j, p);
+    }
+
+    // Handle remaining pixels
+    for (size_t j = vec_size * 64; j < pixel_count * 4; j += 4) {
+        uint32_t a = src[j + 3];
+        for (int c = 0; c < 3; c++) dst[j + c] = div255(src[j + c] * a);
+        dst[j + 3] = (uint8_t)a;
+    }
+}
+
+/*
+ * Porter-Duff Compositing
+ */
+
+// Weight applied to FG or BG
+typedef enum {
+    FACTOR_ZERO,
+    FACTOR_ONE,
+    FACTOR_FG_ALPHA,
+    FACTOR_INV_FG_ALPHA,
+    FACTOR_BG_ALPHA,
+    FACTOR_INV_BG_ALPHA
+} blend_factor_t;
+
+// FG and BG factors, indexed by simd_composite_op_t
+static const blend_factor_t composite_factors[][2] = {
+    { FACTOR_ZERO, FACTOR_ZERO },                   // Clear
+    { FACTOR_ONE, FACTOR_ZERO },                    // Src
+    { FACTOR_ZERO, FACTOR_ONE },                    // Dst
+    { FACTOR_ONE, FACTOR_INV_FG_ALPHA },            // Src over
+    { FACTOR_INV_BG_ALPHA, FACTOR_ONE },            // Dst over
+    { FACTOR_BG_ALPHA, FACTOR_ZERO },               // Src in
+    { FACTOR_ZERO, FACTOR_FG_ALPHA },               // Dst in
+    { FACTOR_INV_BG_ALPHA, FACTOR_ZERO },           // Src out
+    { FACTOR_ZERO, FACTOR_INV_FG_ALPHA },           // Dst out
+    { FACTOR_BG_ALPHA, FACTOR_INV_FG_ALPHA },       // Src atop
+    { FACTOR_INV_BG_ALPHA, FACTOR_FG_ALPHA },       // Dst atop
+    { FACTOR_INV_BG_ALPHA, FACTOR_INV_FG_ALPHA },   // Xor
+    { FACTOR_ONE, FACTOR_ONE }                      // Plus
+};
+
+static inline uint8x16_t factor_u8x16(blend_factor_t f, uint8x16_t fg_alpha, uint8x16_t bg_alpha) {
+    switch (f) {
+        case FACTOR_ZERO: return vdupq_n_u8(0);
+        case FACTOR_ONE: return vdupq_n_u8(255);
+        case FACTOR_FG_ALPHA: return fg_alpha;
+        case FACTOR_INV_FG_ALPHA: return vmvnq_u8(fg_alpha);
+        case FACTOR_BG_ALPHA: return bg_alpha;
+        default: return vmvnq_u8(bg_alpha);
+    }
+}
+
+static inline uint32_t factor_scalar(blend_factor_t f, uint32_t fg_alpha, uint32_t bg_alpha) {
+    switch (f) {
+        case FACTOR_ZERO: return 0;
+        case FACTOR_ONE: return 255;
+        case FACTOR_FG_ALPHA: return fg_alpha;
+        case FACTOR_INV_FG_ALPHA: return 255 - fg_alpha;
+        case FACTOR_BG_ALPHA: return bg_alpha;
+        default: return 255 - bg_alpha;
+    }
+}
+
+// (FG * FA + BG * FB) / 255, saturated: the sum is clamped to 255 * 255
+// (only Plus and invalid premultiplied input can exceed it)
+static inline uint8x8_t weighted_sum_u8x8(uint8x8_t s, uint8x8_t fa, uint8x8_t d, uint8x8_t fb) {
+    uint16x8_t sum = vqaddq_u16(vmull_u8(s, fa), vmull_u8(d, fb));
+    return div255_u16x8(vminq_u16(sum, vdupq_n_u16(255 * 255)));
+}
+
+void simd_composite_rgba(const uint8_t* fg, const uint8_t* bg, simd_composite_op_t op, uint8_t* dst, size_t pixel_count) {
+    if ((unsigned)op > SIMD_COMPOSITE_PLUS) return;
+    blend_factor_t fa = composite_factors[op][0];
+    blend_factor_t fb = composite_factors[op][1];
+
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 64;
+        uint8x16x4_t s = vld4q_u8(fg + j);
+        uint8x16x4_t d = vld4q_u8(bg + j);
+        uint8x16_t va = factor_u8x16(fa, s.val[3], d.val[3]);
+        uint8x16_t vb = factor_u8x16(fb, s.val[3], d.val[3]);
+        uint8x16x4_t out;
+        for (int c = 0; c < 4; c++) {
+            uint8x8_t lo = weighted_sum_u8x8(vget_low_u8(s.val[c]), vget_low_u8(va),
+                                             vget_low_u8(d.val[c]), vget_low_u8(vb));
+            uint8x8_t hi = weighted_sum_u8x8(vget_high_u8(s.val[c]), vget_high_u8(va),
+                                             vget_high_u8(d.val[c]), vget_high_u8(vb));
+            out.val[c] = vcombine_u8(lo, hi);
+        }
+        vst4q_u8(dst + j, out);
+    }
+
+    // Handle remaining pixels
+    for (size_t j = vec_size * 64; j < pixel_count * 4; j += 4) {
+        uint32_t a = factor_scalar(fa, fg[j + 3], bg[j + 3]);
+        uint32_t b = factor_scalar(fb, fg[j + 3], bg[j + 3]);
+        for (int c = 0; c < 4; c++) {
+            uint32_t sum = fg[j + c] * a + bg[j + c] * b;
+            dst[j + c] = div255(sum > 255 * 255 ? 255 * 255 : sum);
+        }
+    }
+}
+
+/*
+ * Strided Views
+ */
+
+// 4-channel views of A's size (B may be NULL)
+static bool rgba_views_match(const simd_image_t* a, const simd_image_t* b, const simd_image_t* dst) {
+    return simd_image_valid(a, 4, 1) && simd_image_valid(dst, 4, 1) &&
+           dst->width == a->width && dst->height == a->height &&
+           (!b || (simd_image_valid(b, 4, 1) && b->width == a->width && b->height == a->height));
+}
+
+// Packed views run as one span of pixels, others row by row
+static int span_rows(const simd_image_t* a, const simd_image_t* b, const simd_image_t* dst, size_t* pixels) {
+    bool packed = simd_image_is_packed(a, 1) && (!b || simd_image_is_packed(b, 1)) && simd_image_is_packed(dst, 1);
+    *pixels = packed ? (size_t)a->width * a->height : (size_t)a->width;
+    return packed ? 1 : a->height;
+}
+
+void simd_blend_over_rgba_view(const simd_image_t* fg, const simd_image_t* bg, const simd_image_t* dst) {
+    if (!rgba_views_match(fg, bg, dst)) return;
+    size_t n;
+    int rows = span_rows(fg, bg, dst, &n);
+    for (int y = 0; y < rows; y++) {
+        simd_blend_over_rgba((const uint8_t*)simd_image_row(fg, y), (const uint8_t*)simd_image_row(bg, y),
+                             (uint8_t*)simd_image_row(dst, y), n);
+    }
+}
+
+void simd_blend_over_premul_rgba_view(const simd_image_t* fg, const simd_image_t* bg, const simd_image_t* dst) {
+    if (!rgba_views_match(fg, bg, dst)) return;
+    size_t n;
+    int rows = span_rows(fg, bg, dst, &n);
+    for (int y = 0; y < rows; y++) {
+        simd_blend_over_premul_rgba((const uint8_t*)simd_image_row(fg, y), (const uint8_t*)simd_image_row(bg, y),
+                                    (uint8_t*)simd_image_row(dst, y), n);
+    }
+}
+
+void simd_crossfade_rgba_view(const simd_image_t* a, const simd_image_t* b, uint8_t alpha, const simd_image_t* dst) {
+    if (!rgba_views_match(a, b, dst)) return;
+    size_t n;
+    int rows = span_rows(a, b, dst, &n);
+    for (int y = 0; y < rows; y++) {
+        simd_crossfade_rgba((const uint8_t*)simd_image_row(a, y), (const uint8_t*)simd_image_row(b, y), alpha,
+                            (uint8_t*)simd_image_row(dst, y), n);
+    }
+}
+
+void simd_premultiply_rgba_view(const simd_image_t* src, const simd_image_t* dst) {
+    if (!rgba_views_match(src, NULL, dst)) return;
+    size_t n;
+    int rows = span_rows(src, NULL, dst, &n);
+    for (int y = 0; y < rows; y++) {
+        simd_premultiply_rgba((const uint8_t*)simd_image_row(src, y), (uint8_t*)simd_image_row(dst, y), n);
+    }
+}
+
+void simd_composite_rgba_view(const simd_image_t* fg, const simd_image_t* bg, simd_composite_op_t op,
+                              const simd_image_t* dst) {
+    if (!rgba_views_match(fg, bg, dst)) return;
+    size_t n;
+    int rows = span_rows(fg, bg, dst, &n);
+    for (int y = 0; y < rows; y++) {
+        simd_composite_rgba((const uint8_t*)simd_image_row(fg, y), (const uint8_t*)simd_image_row(bg, y), op,
+                            (uint8_t*)simd_image_row(dst, y), n);
+    }
+}
@@ -0,0 +1,411 @@
+/**
+ * simd_canny.c
+ * Implementation of Canny edge detection using NEON
+ *
+ * Non-maximum suppression works on 16 pixels at a time: the four direction
+ * sectors become lane masks that select the two neighbor magnitudes to
+ * compare against, and the double threshold is collapsed straight into two
+ * packed bit-planes (candidates and edges, one row-padded bitmap each).
+ * Hysteresis then floods from the strong bits with an explicit stack,
+ * testing 3-pixel neighbor windows with word operations. The stack is
+ * allocated up front: a flood holds its seed plus pixels it promoted, each
+ * promoted once, so rows [y0, y1) never need more than their pixel count. Each band floods
+ * on its own; chains crossing a band boundary are completed afterwards by
+ * reseeding from the boundary rows.
+ */
+#include "simd_canny.h"
+#include "simd_parallel.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <arm_neon.h>
+
+// Per-byte bit weights: byte j of each 8-byte half contributes bit j
+static const uint8_t byte_bit_weights[16] = {
+    1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+};
+
+typedef struct {
+    const uint8_t* src;
+    size_t src_stride;
+    int width;
+    int height;
+    uint16_t low;
+    uint16_t high;
+    simd_magnitude_t norm;
+    uint16_t* mag;
+    uint8_t* dir;
+    uint16_t* zero_row;     // Magnitudes outside the image
+    uint64_t* cand;         // NMS survivors above low (includes strong)
+    uint64_t* edge;         // Strong pixels, grown by hysteresis
+    uint32_t* stack;        // Hysteresis stack, one entry per pixel
+    size_t row_words;       // Words per bitmap row
+    uint8_t* out;
+    size_t out_stride;
+} canny_ctx_t;
+
+/*
+ * Packed Bit Helpers
+ */
+
+// Collapse four 16-lane byte masks (0x00/0xFF) into one 64-bit word
+static inline uint64_t byte_masks_to_word(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+    uint8x16_t weights = vld1q_u8(byte_bit_weights);
+
+    uint8x16_t t0 = vpaddq_u8(vandq_u8(m0, weights), vandq_u8(m1, weights));
+    uint8x16_t t1 = vpaddq_u8(vandq_u8(m2, weights), vandq_u8(m3, weights));
+    uint8x16_t t2 = vpaddq_u8(t0, t1);
+    uint8x16_t t3 = vpaddq_u8(t2, t2);
+
+    return vgetq_lane_u64(vreinterpretq_u64_u8(t3), 0);
+}
+
+static inline bool bit_get(const uint64_t* row, int x) {
+    return (row[x / 64] >> (x % 64)) & 1;
+}
+
+static inline void bit_set(uint64_t* row, int x) {
+    row[x / 64] |= (uint64_t)1 << (x % 64);
+}
+
+// Bits x-1, x, x+1 of a row as bits 0..2 (bits outside the row read as 0)
+static inline uint64_t window3(const uint64_t* row, int x, size_t row_words) {
+    if (x == 0) return (row[0] & 3) << 1;
+    size_t b = (size_t)x - 1;
+    size_t w = b / 64;
+    unsigned o = (unsigned)(b % 64);
+    uint64_t bits = row[w] >> o;
+    if (o > 61 && w + 1 < row_words) bits |= row[w + 1] << (64 - o);
+    return bits & 7;
+}
+
+/*
+ * Gradient
+ */
+
+static void gradient_band(void* arg, int band, int y0, int y1) {
+    canny_ctx_t* c = (canny_ctx_t*)arg;
+    (void)band;
+    simd_image_t src = simd_image_make((void*)c->src, c->width, c->height, c->src_stride, 1);
+    simd_image_t mag = simd_image_packed(c->mag, c->width, c->height, 1, sizeof(uint16_t));
+    simd_image_t dir = simd_image_packed(c->dir, c->width, c->height, 1, 1);
+    simd_gradient_rows_view(&src, y0, y1, SIMD_GRADIENT_SOBEL, SIMD_BORDER_REPLICATE, 0,
+                            NULL, NULL, &mag, c->norm, &dir, 4);
+}
+
+/*
+ * Non-Maximum Suppression and Double Threshold
+ */
+
+// Row magnitudes at x - 1, x, x + 1 for 8 lanes (0 outside the row)
+static inline void load_neighbors(const uint16_t* row, int x, int width,
+                                  uint16x8_t* left, uint16x8_t* center, uint16x8_t* right) {
+    uint16x8_t zero = vdupq_n_u16(0);
+    *center = vld1q_u16(row + x);
+    *left = x > 0 ? vld1q_u16(row + x - 1) : vextq_u16(zero, *center, 7);
+    *right = x + 9 <= width ? vld1q_u16(row + x + 1) : vextq_u16(*center, zero, 1);
+}
+
+// Suppression for 8 lanes; sector masks s1..s3 select the neighbor pair
+static inline void nms8(const uint16_t* mp, const uint16_t* mc, const uint16_t* mn, int x, int width,
+                        uint16x8_t s1, uint16x8_t s2, uint16x8_t s3, uint16x8_t low, uint16x8_t high,
+                        uint16x8_t* cand, uint16x8_t* strong) {
+    uint16x8_t pl, pc, pr, cl, cc, cr, nl, nc, nr;
+    load_neighbors(mp, x, width, &pl, &pc, &pr);
+    load_neighbors(mc, x, width, &cl, &cc, &cr);
+    load_neighbors(mn, x, width, &nl, &nc, &nr);
+
+    // Sector 0: left/right, 1: up-left/down-right, 2: up/down, 3: up-right/down-left
+    uint16x8_t before = vbslq_u16(s1, pl, vbslq_u16(s2, pc, vbslq_u16(s3, pr, cl)));
+    uint16x8_t after = vbslq_u16(s1, nr, vbslq_u16(s2, nc, vbslq_u16(s3, nl, cr)));
+    uint16x8_t keep = vandq_u16(vcgtq_u16(cc, before), vcgeq_u16(cc, after));
+
+    *cand = vandq_u16(keep, vcgtq_u16(cc, low));
+    *strong = vandq_u16(keep, vcgtq_u16(cc, high));
+}
+
+// Widen 8 byte masks to 16-bit lane masks
+static inline uint16x8_t widen_mask(uint8x8_t m) {
+    return vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(m)));
+}
+
+// Suppression for 16 pixels starting at x, as byte masks
+static inline void nms16(const uint16_t* mp, const uint16_t* mc, const uint16_t* mn, const uint8_t* dir,
+                         int x, int width, uint16x8_t low, uint16x8_t high,
+                         uint8x16_t* cand, uint8x16_t* strong) {
+    uint8x16_t d = vld1q_u8(dir + x);
+    uint8x16_t s1 = vceqq_u8(d, vdupq_n_u8(1));
+    uint8x16_t s2 = vceqq_u8(d, vdupq_n_u8(2));
+    uint8x16_t s3 = vceqq_u8(d, vdupq_n_u8(3));
+
+    uint16x8_t cand_lo, cand_hi, strong_lo, strong_hi;
+    nms8(mp, mc, mn, x, width, widen_mask(vget_low_u8(s1)), widen_mask(vget_low_u8(s2)),
+         widen_mask(vget_low_u8(s3)), low, high, &cand_lo, &strong_lo);
+    nms8(mp, mc, mn, x + 8, width, widen_mask(vget_high_u8(s1)), widen_mask(vget_high_u8(s2)),
+         widen_mask(vget_high_u8(s3)), low, high, &cand_hi, &strong_hi);
+
+    *cand = vcombine_u8(vmovn_u16(cand_lo), vmovn_u16(cand_hi));
+    *strong = vcombine_u8(vmovn_u16(strong_lo), vmovn_u16(strong_hi));
+}
+
+static inline uint16_t mag_at(const uint16_t* row, int x, int width) {
+    return (x < 0 || x >= width) ? 0 : row[x];
+}
+
+static void nms_row(const canny_ctx_t* c, int y) {
+    int width = c->width;
+    const uint16_t* mp = y > 0 ? c->mag + (size_t)(y - 1) * width : c->zero_row;
+    const uint16_t* mc = c->mag + (size_t)y * width;
+    const uint16_t* mn = y + 1 < c->height ? c->mag + (size_t)(y + 1) * width : c->zero_row;
+    const uint8_t* dir = c->dir + (size_t)y * width;
+    uint64_t* cand = c->cand + (size_t)y * c->row_words;
+    uint64_t* edge = c->edge + (size_t)y * c->row_words;
+    uint16x8_t low = vdupq_n_u16(c->low);
+    uint16x8_t high = vdupq_n_u16(c->high);
+
+    memset(cand, 0, c->row_words * sizeof(uint64_t));
+    memset(edge, 0, c->row_words * sizeof(uint64_t));
+
+    // Process 64 pixels (one bitmap word) at a time using NEON
+    size_t vec_size = (size_t)width / 64;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        int x = (int)(i * 64);
+        uint8x16_t c0, c1, c2, c3, s0, s1, s2, s3;
+        nms16(mp, mc, mn, dir, x, width, low, high, &c0, &s0);
+        nms16(mp, mc, mn, dir, x + 16, width, low, high, &c1, &s1);
+        nms16(mp, mc, mn, dir, x + 32, width, low, high, &c2, &s2);
+        nms16(mp, mc, mn, dir, x + 48, width, low, high, &c3, &s3);
+        cand[i] = byte_masks_to_word(c0, c1, c2, c3);
+        edge[i] = byte_masks_to_word(s0, s1, s2, s3);
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 64); x < width; x++) {
+        uint16_t m = mc[x];
+        uint16_t before, after;
+        switch (dir[x]) {
+            case 0:  before = mag_at(mc, x - 1, width); after = mag_at(mc, x + 1, width); break;
+            case 1:  before = mag_at(mp, x - 1, width); after = mag_at(mn, x + 1, width); break;
+            case 2:  before = mp[x]; after = mn[x]; break;
+            default: before = mag_at(mp, x + 1, width); after = mag_at(mn, x - 1, width); break;
+        }
+        if (m > before && m >= after) {
+            if (m > c->low) bit_set(cand, x);
+            if (m > c->high) bit_set(edge, x);
+        }
+    }
+}
+
+static void nms_band(void* arg, int band, int y0, int y1) {
+    canny_ctx_t* c = (canny_ctx_t*)arg;
+    (void)band;
+    for (int y = y0; y < y1; y++) nms_row(c, y);
+}
+
+/*
+ * Hysteresis
+ */
+
+// Room for every pixel of the rows being flooded, so pushes cannot fail
+typedef struct {
+    uint32_t* items;
+    size_t count;
+} pixel_stack_t;
+
+// Promote candidates 8-connected to the pixels on the stack, within rows [y0, y1)
+static void flood(const canny_ctx_t* c, pixel_stack_t* stack, int y0, int y1) {
+    int width = c->width;
+
+    while (stack->count) {
+        uint32_t p = stack->items[--stack->count];
+        int y = (int)(p / (uint32_t)width);
+        int x = (int)(p % (uint32_t)width);
+        int ny0 = y - 1 < y0 ? y0 : y - 1;
+        int ny1 = y + 1 >= y1 ? y1 - 1 : y + 1;
+
+        for (int ny = ny0; ny <= ny1; ny++) {
+            const uint64_t* cand = c->cand + (size_t)ny * c->row_words;
+            uint64_t* edge = c->edge + (size_t)ny * c->row_words;
+            uint64_t pending = window3(cand, x, c->row_words) & ~window3(edge, x, c->row_words);
+
+            while (pending) {
+                int nx = x - 1 + __builtin_ctzll(pending);
+                pending &= pending - 1;
+                bit_set(edge, nx);
+                stack->items[stack->count++] = (uint32_t)ny * (uint32_t)width + (uint32_t)nx;
+            }
+        }
+    }
+}
+
+// Flood from every edge pixel of row y
+static void flood_from_row(const canny_ctx_t* c, pixel_stack_t* stack, int y, int y0, int y1) {
+    const uint64_t* edge = c->edge + (size_t)y * c->row_words;
+
+    for (size_t w = 0; w < c->row_words; w++) {
+        uint64_t bits = edge[w];
+        while (bits) {
+            int x = (int)(w * 64) + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            stack->items[stack->count++] = (uint32_t)y * (uint32_t)c->width + (uint32_t)x;
+            flood(c, stack, y0, y1);
+        }
+    }
+}
+
+static void hysteresis_band(void* arg, int band, int y0, int y1) {
+    canny_ctx_t* c = (canny_ctx_t*)arg;
+    // The band's own slice of the stack
+    pixel_stack_t stack = { c->stack + (size_t)y0 * c->width, 0 };
+    (void)band;
+
+    for (int y = y0; y < y1; y++) flood_from_row(c, &stack, y, y0, y1);
+}
+
+// Complete chains that cross band boundaries: the first crossing of any
+// such chain starts from a pixel already promoted inside its own band
+static void hysteresis_seams(const canny_ctx_t* c, int bands) {
+    pixel_stack_t stack = { c->stack, 0 };
+
+    for (int b = 1; b < bands; b++) {
+        int y = simd_parallel_band_start(c->height, bands, b);
+        flood_from_row(c, &stack, y - 1, 0, c->height);
+        flood_from_row(c, &stack, y, 0, c->height);
+    }
+}
+
+/*
+ * Output
+ */
+
+static void expand_band(void* arg, int band, int y0, int y1) {
+    canny_ctx_t* c = (canny_ctx_t*)arg;
+    uint8x16_t weights = vld1q_u8(byte_bit_weights);
+    int width = c->width;
+    (void)band;
+
+    for (int y = y0; y < y1; y++) {
+        const uint64_t* edge = c->edge + (size_t)y * c->row_words;
+        uint8_t* out = c->out + (size_t)y * c->out_stride;
+
+        // Process 16 pixels at a time using NEON
+        size_t vec_size = (size_t)width / 16;
+
+        for (size_t i = 0; i < vec_size; i++) {
+            uint16_t bits = (uint16_t)(edge[i / 4] >> ((i % 4) * 16));
+            uint8x16_t spread = vcombine_u8(vdup_n_u8((uint8_t)bits), vdup_n_u8((uint8_t)(bits >> 8)));
+            vst1q_u8(out + i * 16, vtstq_u8(spread, weights));
+        }
+
+        // Handle remaining pixels
+        for (int x = (int)(vec_size * 16); x < width; x++) {
+            out[x] = bit_get(edge, x) ? 255 : 0;
+        }
+    }
+}
+
+/*
+ * Driver
+ */
+
+// Runs all stages; the edge bits are left in ctx->edge
+static bool canny_run(canny_ctx_t* c, int threads) {
+    size_t pixels = (size_t)c->width * c->height;
+    c->row_words = ((size_t)c->width + 63) / 64;
+    c->mag = (uint16_t*)neon_malloc(pixels * sizeof(uint16_t));
+    c->dir = (uint8_t*)neon_malloc(pixels);
+    c->zero_row = (uint16_t*)neon_malloc((size_t)c->width * sizeof(uint16_t));
+    c->cand = (uint64_t*)neon_malloc(c->row_words * c->height * sizeof(uint64_t));
+    c->edge = (uint64_t*)neon_malloc(c->row_words * c->height * sizeof(uint64_t));
+    c->stack = (uint32_t*)malloc(pixels * sizeof(uint32_t));
+
+    bool ok = c->mag && c->dir && c->zero_row && c->cand && c->edge && c->stack;
+    if (ok) {
+        memset(c->zero_row, 0, (size_t)c->width * sizeof(uint16_t));
+        simd_parallel_bands(c->height, threads, gradient_band, c);
+        simd_parallel_bands(c->height, threads, nms_band, c);
+        int bands = simd_parallel_bands(c->height, threads, hysteresis_band, c);
+        hysteresis_seams(c, bands);
+    }
+
+    free(c->mag);
+    free(c->dir);
+    free(c->zero_row);
+    free(c->cand);
+    free(c->stack);
+    if (!ok) free(c->edge);
+    return ok;
+}
+
+static void canny_init(canny_ctx_t* c, const uint8_t* src, size_t src_stride, int width, int height,
+                       uint16_t low, uint16_t high, simd_magnitude_t norm) {
+    memset(c, 0, sizeof(*c));
+    c->src = src;
+    c->src_stride = src_stride;
+    c->width = width;
+    c->height = height;
+    c->low = low < high ? low : high;
+    c->high = low < high ? high : low;
+    c->norm = norm;
+}
+
+void simd_canny(const uint8_t* src, uint8_t* edges, int width, int height,
+                uint16_t low_threshold, uint16_t high_threshold,
+                simd_magnitude_t norm, int threads) {
+    if (width <= 0 || height <= 0) return;
+
+    canny_ctx_t c;
+    canny_init(&c, src, (size_t)width, width, height, low_threshold, high_threshold, norm);
+    if (!canny_run(&c, threads)) return;
+
+    c.out = edges;
+    c.out_stride = (size_t)width;
+    simd_parallel_bands(height, threads, expand_band, &c);
+    free(c.edge);
+}
+
+void simd_canny_bitmap(const uint8_t* src, simd_bitmap_t* edges, int width, int height,
+                       uint16_t low_threshold, uint16_t high_threshold,
+                       simd_magnitude_t norm, int threads) {
+    if (width <= 0 || height <= 0 || edges->len != (size_t)width * height) return;
+
+    canny_ctx_t c;
+    canny_init(&c, src, (size_t)width, width, height, low_threshold, high_threshold, norm);
+    if (!canny_run(&c, threads)) return;
+
+    // Concatenate the row-padded rows into one flat bitmap
+    simd_bitmap_clear(edges);
+    for (int y = 0; y < height; y++) {
+        const uint64_t* row = c.edge + (size_t)y * c.row_words;
+        size_t base = (size_t)y * width;
+        for (size_t w = 0; w < c.row_words; w++) {
+            uint64_t bits = row[w];
+            if (!bits) continue;
+            size_t pos = base + w * 64;
+            unsigned o = (unsigned)(pos % 64);
+            edges->words[pos / 64] |= bits << o;
+            if (o) {
+                uint64_t spill = bits >> (64 - o);
+                if (spill) edges->words[pos / 64 + 1] |= spill;
+            }
+        }
+    }
+    free(c.edge);
+}
+
+void simd_canny_view(const simd_image_t* src, const simd_image_t* edges,
+                     uint16_t low_threshold, uint16_t high_threshold,
+                     simd_magnitude_t norm, int threads) {
+    if (!simd_image_valid(src, 1, 1) || !simd_image_valid(edges, 1, 1) ||
+        src->width != edges->width || src->height != edges->height) return;
+
+    canny_ctx_t c;
+    canny_init(&c, src->data, src->stride, src->width, src->height, low_threshold, high_threshold, norm);
+    if (!canny_run(&c, threads)) return;
+
+    c.out = edges->data;
+    c.out_stride = edges->stride;
+    simd_parallel_bands(src->height, threads, expand_band, &c);
+    free(c.edge);
+}
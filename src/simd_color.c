@@ -0,0 +1,755 @@
+/**
+ * simd_color.c
+ * Implementation of color-space conversion using NEON
+ *
+ * Pixels are processed 16 at a time: vld3q_u8/vld4q_u8 split a packed row
+ * into R, G, B (and A) planes, and vst3q_u8/vst4q_u8 write them back in
+ * the destination order. Linear transforms (gray, YUV) widen the channels
+ * to 16 bits and accumulate in 32 bits against 13-bit fixed-point
+ * coefficients; vqrshrun then rounds, shifts and saturates in one step.
+ */
+#include "simd_color.h"
+#include <math.h>
+#include <arm_neon.h>
+
+// Fixed-point precision of all linear color coefficients
+#define COLOR_SHIFT 13
+#define COLOR_ONE (1 << COLOR_SHIFT)
+#define COLOR_HALF (1 << (COLOR_SHIFT - 1))
+
+// RGB -> YUV: each output is bias + c[0] * R + c[1] * G + c[2] * B
+typedef struct {
+    int16_t y[3];
+    int16_t u[3];
+    int16_t v[3];
+    int32_t y_bias;
+    int32_t uv_bias;
+} rgb_to_yuv_coeffs_t;
+
+// YUV -> RGB: R = y * Y + r_v * V + r_bias, G = y * Y + g_u * U + g_v * V + g_bias, ...
+typedef struct {
+    int16_t y;
+    int16_t r_v;
+    int16_t g_u;
+    int16_t g_v;
+    int16_t b_u;
+    int32_t r_bias;
+    int32_t g_bias;
+    int32_t b_bias;
+} yuv_to_rgb_coeffs_t;
+
+/*
+ * Coefficient Tables
+ */
+
+static int16_t fixed_coeff(double x) {
+    return (int16_t)lrint(x * COLOR_ONE);
+}
+
+static void yuv_matrix_weights(simd_yuv_matrix_t matrix, double* kr, double* kb) {
+    if (matrix == SIMD_YUV_BT709) {
+        *kr = 0.2126;
+        *kb = 0.0722;
+    } else {
+        *kr = 0.299;
+        *kb = 0.114;
+    }
+}
+
+static void rgb_to_yuv_coeffs(simd_yuv_matrix_t matrix, simd_yuv_range_t range, rgb_to_yuv_coeffs_t* c) {
+    double kr, kb;
+    yuv_matrix_weights(matrix, &kr, &kb);
+
+    double y_scale = range == SIMD_YUV_FULL ? 1.0 : 219.0 / 255.0;
+    double c_scale = range == SIMD_YUV_FULL ? 1.0 : 224.0 / 255.0;
+    int y_offset = range == SIMD_YUV_FULL ? 0 : 16;
+
+    // The middle weight absorbs the rounding of the other two so each row
+    // sums exactly: white maps to the top of the Y range, grays to U = V = 128
+    c->y[0] = fixed_coeff(kr * y_scale);
+    c->y[2] = fixed_coeff(kb * y_scale);
+    c->y[1] = (int16_t)(fixed_coeff(y_scale) - c->y[0] - c->y[2]);
+
+    c->u[0] = fixed_coeff(-kr / (2.0 * (1.0 - kb)) * c_scale);
+    c->u[2] = fixed_coeff(0.5 * c_scale);
+    c->u[1] = (int16_t)(-c->u[0] - c->u[2]);
+
+    c->v[0] = fixed_coeff(0.5 * c_scale);
+    c->v[2] = fixed_coeff(-kb / (2.0 * (1.0 - kr)) * c_scale);
+    c->v[1] = (int16_t)(-c->v[0] - c->v[2]);
+
+    c->y_bias = y_offset * COLOR_ONE;
+    c->uv_bias = 128 * COLOR_ONE;
+}
+
+static void yuv_to_rgb_coeffs(simd_yuv_matrix_t matrix, simd_yuv_range_t range, yuv_to_rgb_coeffs_t* c) {
+    double kr, kb;
+    yuv_matrix_weights(matrix, &kr, &kb);
+    double kg = 1.0 - kr - kb;
+
+    double y_scale = range == SIMD_YUV_FULL ? 1.0 : 255.0 / 219.0;
+    double c_scale = range == SIMD_YUV_FULL ? 1.0 : 255.0 / 224.0;
+    int y_offset = range == SIMD_YUV_FULL ? 0 : 16;
+
+    c->y = fixed_coeff(y_scale);
+    c->r_v = fixed_coeff(2.0 * (1.0 - kr) * c_scale);
+    c->g_u = fixed_coeff(-2.0 * kb * (1.0 - kb) / kg * c_scale);
+    c->g_v = fixed_coeff(-2.0 * kr * (1.0 - kr) / kg * c_scale);
+    c->b_u = fixed_coeff(2.0 * (1.0 - kb) * c_scale);
+
+    // Fold the Y and chroma offsets into one constant per channel
+    c->r_bias = -(c->y * y_offset + c->r_v * 128);
+    c->g_bias = -(c->y * y_offset + (c->g_u + c->g_v) * 128);
+    c->b_bias = -(c->y * y_offset + c->b_u * 128);
+}
+
+/*
+ * Fixed-point Helpers
+ */
+
+// Scalar equivalent of vqrshrun_n_s32 + vqmovn_u16
+static inline uint8_t fixed_to_u8(int32_t acc) {
+    acc += COLOR_HALF;
+    if (acc < 0) return 0;
+    acc >>= COLOR_SHIFT;
+    return acc > 255 ? 255 : (uint8_t)acc;
+}
+
+static inline int16x8_t widen_u8(uint8x8_t x) {
+    return vreinterpretq_s16_u16(vmovl_u8(x));
+}
+
+// Round, shift and saturate two 32-bit accumulators to 8 bytes
+static inline uint8x8_t narrow_fixed(int32x4_t lo, int32x4_t hi) {
+    uint16x8_t n = vcombine_u16(vqrshrun_n_s32(lo, COLOR_SHIFT), vqrshrun_n_s32(hi, COLOR_SHIFT));
+    return vqmovn_u16(n);
+}
+
+// sat_u8(round((bias + c0 * x0 + c1 * x1) / 2^13)) for 8 lanes
+static inline uint8x8_t linear2_u8x8(int16x8_t x0, int16x8_t x1, int16_t c0, int16_t c1, int32_t bias) {
+    int32x4_t b = vdupq_n_s32(bias);
+    int32x4_t lo = vmlal_n_s16(b, vget_low_s16(x0), c0);
+    int32x4_t hi = vmlal_n_s16(b, vget_high_s16(x0), c0);
+    lo = vmlal_n_s16(lo, vget_low_s16(x1), c1);
+    hi = vmlal_n_s16(hi, vget_high_s16(x1), c1);
+    return narrow_fixed(lo, hi);
+}
+
+// sat_u8(round((bias + c0 * x0 + c1 * x1 + c2 * x2) / 2^13)) for 8 lanes
+static inline uint8x8_t linear3_u8x8(int16x8_t x0, int16x8_t x1, int16x8_t x2,
+                                     int16_t c0, int16_t c1, int16_t c2, int32_t bias) {
+    int32x4_t b = vdupq_n_s32(bias);
+    int32x4_t lo = vmlal_n_s16(b, vget_low_s16(x0), c0);
+    int32x4_t hi = vmlal_n_s16(b, vget_high_s16(x0), c0);
+    lo = vmlal_n_s16(lo, vget_low_s16(x1), c1);
+    hi = vmlal_n_s16(hi, vget_high_s16(x1), c1);
+    lo = vmlal_n_s16(lo, vget_low_s16(x2), c2);
+    hi = vmlal_n_s16(hi, vget_high_s16(x2), c2);
+    return narrow_fixed(lo, hi);
+}
+
+// linear3_u8x8 over 16 lanes of unsigned bytes
+static inline uint8x16_t linear3_u8x16(uint8x16_t x0, uint8x16_t x1, uint8x16_t x2, const int16_t c[3], int32_t bias) {
+    uint8x8_t lo = linear3_u8x8(widen_u8(vget_low_u8(x0)), widen_u8(vget_low_u8(x1)),
+                                widen_u8(vget_low_u8(x2)), c[0], c[1], c[2], bias);
+    uint8x8_t hi = linear3_u8x8(widen_u8(vget_high_u8(x0)), widen_u8(vget_high_u8(x1)),
+                                widen_u8(vget_high_u8(x2)), c[0], c[1], c[2], bias);
+    return vcombine_u8(lo, hi);
+}
+
+/*
+ * Pixel Load / Store
+ */
+
+size_t simd_pixel_size(simd_pixel_format_t format) {
+    return (format == SIMD_PIXEL_RGBA || format == SIMD_PIXEL_BGRA) ? 4 : 3;
+}
+
+static inline void load_pixels16(const uint8_t* p, simd_pixel_format_t format,
+                                 uint8x16_t* r, uint8x16_t* g, uint8x16_t* b, uint8x16_t* a) {
+    if (format == SIMD_PIXEL_RGB || format == SIMD_PIXEL_BGR) {
+        uint8x16x3_t v = vld3q_u8(p);
+        *r = format == SIMD_PIXEL_RGB ? v.val[0] : v.val[2];
+        *g = v.val[1];
+        *b = format == SIMD_PIXEL_RGB ? v.val[2] : v.val[0];
+        *a = vdupq_n_u8(255);
+    } else {
+        uint8x16x4_t v = vld4q_u8(p);
+        *r = format == SIMD_PIXEL_RGBA ? v.val[0] : v.val[2];
+        *g = v.val[1];
+        *b = format == SIMD_PIXEL_RGBA ? v.val[2] : v.val[0];
+        *a = v.val[3];
+    }
+}
+
+static inline void store_pixels16(uint8_t* p, simd_pixel_format_t format,
+                                  uint8x16_t r, uint8x16_t g, uint8x16_t b, uint8x16_t a) {
+    if (format == SIMD_PIXEL_RGB || format == SIMD_PIXEL_BGR) {
+        uint8x16x3_t v;
+        v.val[0] = format == SIMD_PIXEL_RGB ? r : b;
+        v.val[1] = g;
+        v.val[2] = format == SIMD_PIXEL_RGB ? b : r;
+        vst3q_u8(p, v);
+    } else {
+        uint8x16x4_t v;
+        v.val[0] = format == SIMD_PIXEL_RGBA ? r : b;
+        v.val[1] = g;
+        v.val[2] = format == SIMD_PIXEL_RGBA ? b : r;
+        v.val[3] = a;
+        vst4q_u8(p, v);
+    }
+}
+
+static inline void load_pixel(const uint8_t* p, simd_pixel_format_t format,
+                              uint8_t* r, uint8_t* g, uint8_t* b, uint8_t* a) {
+    int swap = format == SIMD_PIXEL_BGR || format == SIMD_PIXEL_BGRA;
+    *r = swap ? p[2] : p[0];
+    *g = p[1];
+    *b = swap ? p[0] : p[2];
+    *a = simd_pixel_size(format) == 4 ? p[3] : 255;
+}
+
+static inline void store_pixel(uint8_t* p, simd_pixel_format_t format,
+                               uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    int swap = format == SIMD_PIXEL_BGR || format == SIMD_PIXEL_BGRA;
+    p[0] = swap ? b : r;
+    p[1] = g;
+    p[2] = swap ? r : b;
+    if (simd_pixel_size(format) == 4) p[3] = a;
+}
+
+/*
+ * Packed Format Conversion
+ */
+
+void simd_convert_pixels(const uint8_t* src, simd_pixel_format_t src_format,
+                         uint8_t* dst, simd_pixel_format_t dst_format, size_t pixel_count) {
+    size_t src_size = simd_pixel_size(src_format);
+    size_t dst_size = simd_pixel_size(dst_format);
+
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint8x16_t r, g, b, a;
+        load_pixels16(src + i * 16 * src_size, src_format, &r, &g, &b, &a);
+        store_pixels16(dst + i * 16 * dst_size, dst_format, r, g, b, a);
+    }
+
+    // Handle remaining pixels
+    for (size_t i = vec_size * 16; i < pixel_count; i++) {
+        uint8_t r, g, b, a;
+        load_pixel(src + i * src_size, src_format, &r, &g, &b, &a);
+        store_pixel(dst + i * dst_size, dst_format, r, g, b, a);
+    }
+}
+
+/*
+ * Grayscale
+ */
+
+void simd_convert_to_gray(const uint8_t* src, simd_pixel_format_t format, uint8_t* gray, size_t pixel_count) {
+    rgb_to_yuv_coeffs_t c;
+    rgb_to_yuv_coeffs(SIMD_YUV_BT601, SIMD_YUV_FULL, &c);
+    size_t pixel_size = simd_pixel_size(format);
+
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint8x16_t r, g, b, a;
+        load_pixels16(src + i * 16 * pixel_size, format, &r, &g, &b, &a);
+        vst1q_u8(gray + i * 16, linear3_u8x16(r, g, b, c.y, c.y_bias));
+    }
+
+    // Handle remaining pixels
+    for (size_t i = vec_size * 16; i < pixel_count; i++) {
+        uint8_t r, g, b, a;
+        load_pixel(src + i * pixel_size, format, &r, &g, &b, &a);
+        gray[i] = fixed_to_u8(c.y_bias + c.y[0] * r + c.y[1] * g + c.y[2] * b);
+    }
+}
+
+/*
+ * RGB -> YUV 4:2:0
+ */
+
+// Average the available pixels of one 2x2 block and write its chroma sample
+static void chroma_block_scalar(const uint8_t* row0, const uint8_t* row1, simd_pixel_format_t format,
+                                int x, int width, const rgb_to_yuv_coeffs_t* c, uint8_t* u, uint8_t* v) {
+    size_t pixel_size = simd_pixel_size(format);
+    int sr = 0, sg = 0, sb = 0, n = 0;
+
+    for (int dy = 0; dy < 2; dy++) {
+        const uint8_t* row = dy == 0 ? row0 : row1;
+        if (!row) continue;
+        for (int dx = 0; dx < 2 && x + dx < width; dx++) {
+            uint8_t r, g, b, a;
+            load_pixel(row + (size_t)(x + dx) * pixel_size, format, &r, &g, &b, &a);
+            sr += r;
+            sg += g;
+            sb += b;
+            n++;
+        }
+    }
+
+    // Rounded average, matching vrshrn_n_u16(sum, 2) for full blocks
+    int r = (sr + n / 2) / n;
+    int g = (sg + n / 2) / n;
+    int b = (sb + n / 2) / n;
+    *u = fixed_to_u8(c->uv_bias + c->u[0] * r + c->u[1] * g + c->u[2] * b);
+    *v = fixed_to_u8(c->uv_bias + c->v[0] * r + c->v[1] * g + c->v[2] * b);
+}
+
+// Shared NV12/I420 encoder; chroma samples are chroma_step bytes apart
+static void rgb_to_yuv420(const uint8_t* src, size_t src_stride, simd_pixel_format_t format, int width, int height,
+                          uint8_t* y, size_t y_stride, uint8_t* u, size_t u_stride, uint8_t* v, size_t v_stride,
+                          size_t chroma_step, simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    rgb_to_yuv_coeffs_t c;
+    rgb_to_yuv_coeffs(matrix, range, &c);
+
+    size_t pixel_size = simd_pixel_size(format);
+
+    for (int row = 0; row < height; row += 2) {
+        const uint8_t* row0 = src + (size_t)row * src_stride;
+        const uint8_t* row1 = row + 1 < height ? row0 + src_stride : NULL;
+        uint8_t* y0 = y + (size_t)row * y_stride;
+        uint8_t* y1 = y0 + y_stride;
+        uint8_t* u_row = u + (size_t)(row / 2) * u_stride;
+        uint8_t* v_row = v + (size_t)(row / 2) * v_stride;
+
+        // Process 16 pixels (8 chroma samples) of both rows at a time
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            uint8x16_t r0, g0, b0, a0, r1, g1, b1, a1;
+            load_pixels16(row0 + (size_t)x * pixel_size, format, &r0, &g0, &b0, &a0);
+            vst1q_u8(y0 + x, linear3_u8x16(r0, g0, b0, c.y, c.y_bias));
+
+            if (row1) {
+                load_pixels16(row1 + (size_t)x * pixel_size, format, &r1, &g1, &b1, &a1);
+                vst1q_u8(y1 + x, linear3_u8x16(r1, g1, b1, c.y, c.y_bias));
+            } else {
+                // Odd height: the last row stands in for the missing one
+                r1 = r0;
+                g1 = g0;
+                b1 = b0;
+            }
+
+            // Rounded 2x2 average: pairwise-add each row, sum rows, shift by 2
+            int16x8_t r = widen_u8(vrshrn_n_u16(vaddq_u16(vpaddlq_u8(r0), vpaddlq_u8(r1)), 2));
+            int16x8_t g = widen_u8(vrshrn_n_u16(vaddq_u16(vpaddlq_u8(g0), vpaddlq_u8(g1)), 2));
+            int16x8_t b = widen_u8(vrshrn_n_u16(vaddq_u16(vpaddlq_u8(b0), vpaddlq_u8(b1)), 2));
+
+            uint8x8_t cu = linear3_u8x8(r, g, b, c.u[0], c.u[1], c.u[2], c.uv_bias);
+            uint8x8_t cv = linear3_u8x8(r, g, b, c.v[0], c.v[1], c.v[2], c.uv_bias);
+
+            if (chroma_step == 2) {
+                uint8x8x2_t uv;
+                uv.val[0] = cu;
+                uv.val[1] = cv;
+                vst2_u8(u_row + x, uv);
+            } else {
+                vst1_u8(u_row + x / 2, cu);
+                vst1_u8(v_row + x / 2, cv);
+            }
+        }
+
+        // Handle remaining pixels
+        for (int xi = x; xi < width; xi++) {
+            uint8_t r, g, b, a;
+            load_pixel(row0 + (size_t)xi * pixel_size, format, &r, &g, &b, &a);
+            y0[xi] = fixed_to_u8(c.y_bias + c.y[0] * r + c.y[1] * g + c.y[2] * b);
+            if (row1) {
+                load_pixel(row1 + (size_t)xi * pixel_size, format, &r, &g, &b, &a);
+                y1[xi] = fixed_to_u8(c.y_bias + c.y[0] * r + c.y[1] * g + c.y[2] * b);
+            }
+        }
+        for (int xi = x; xi < width; xi += 2) {
+            size_t ci = (size_t)(xi / 2) * chroma_step;
+            chroma_block_scalar(row0, row1, format, xi, width, &c, u_row + ci, v_row + ci);
+        }
+    }
+}
+
+void simd_rgb_to_nv12(const uint8_t* src, simd_pixel_format_t format, int width, int height,
+                      uint8_t* y, uint8_t* uv, simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    size_t chroma_stride = (size_t)(width + 1) / 2 * 2;
+    rgb_to_yuv420(src, (size_t)width * simd_pixel_size(format), format, width, height, y, (size_t)width,
+                  uv, chroma_stride, uv + 1, chroma_stride, 2, matrix, range);
+}
+
+void simd_rgb_to_i420(const uint8_t* src, simd_pixel_format_t format, int width, int height,
+                      uint8_t* y, uint8_t* u, uint8_t* v, simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    size_t chroma_stride = (size_t)(width + 1) / 2;
+    rgb_to_yuv420(src, (size_t)width * simd_pixel_size(format), format, width, height, y, (size_t)width,
+                  u, chroma_stride, v, chroma_stride, 1, matrix, range);
+}
+
+/*
+ * YUV 4:2:0 -> RGB
+ */
+
+// Shared NV12/I420 decoder; chroma samples are chroma_step bytes apart
+static void yuv420_to_rgb(const uint8_t* y, size_t y_stride, const uint8_t* u, size_t u_stride,
+                          const uint8_t* v, size_t v_stride, size_t chroma_step,
+                          uint8_t* dst, size_t dst_stride, simd_pixel_format_t format, int width, int height,
+                          simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    yuv_to_rgb_coeffs_t c;
+    yuv_to_rgb_coeffs(matrix, range, &c);
+
+    size_t pixel_size = simd_pixel_size(format);
+    uint8x16_t alpha = vdupq_n_u8(255);
+
+    for (int row = 0; row < height; row++) {
+        const uint8_t* y_row = y + (size_t)row * y_stride;
+        const uint8_t* u_row = u + (size_t)(row / 2) * u_stride;
+        const uint8_t* v_row = v + (size_t)(row / 2) * v_stride;
+        uint8_t* out = dst + (size_t)row * dst_stride;
+
+        // Process 16 pixels (8 chroma samples) at a time
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            uint8x8_t cu, cv;
+            if (chroma_step == 2) {
+                uint8x8x2_t uv = vld2_u8(u_row + x);
+                cu = uv.val[0];
+                cv = uv.val[1];
+            } else {
+                cu = vld1_u8(u_row + x / 2);
+                cv = vld1_u8(v_row + x / 2);
+            }
+
+            // Replicate each chroma sample over two pixels: u0 u0 u1 u1 ...
+            uint8x16_t cu2 = vcombine_u8(cu, cu);
+            uint8x16_t cv2 = vcombine_u8(cv, cv);
+            int16x8_t u_lo = widen_u8(vget_low_u8(vzip1q_u8(cu2, cu2)));
+            int16x8_t u_hi = widen_u8(vget_high_u8(vzip1q_u8(cu2, cu2)));
+            int16x8_t v_lo = widen_u8(vget_low_u8(vzip1q_u8(cv2, cv2)));
+            int16x8_t v_hi = widen_u8(vget_high_u8(vzip1q_u8(cv2, cv2)));
+
+            uint8x16_t luma = vld1q_u8(y_row + x);
+            int16x8_t y_lo = widen_u8(vget_low_u8(luma));
+            int16x8_t y_hi = widen_u8(vget_high_u8(luma));
+
+            uint8x16_t r = vcombine_u8(linear2_u8x8(y_lo, v_lo, c.y, c.r_v, c.r_bias),
+                                       linear2_u8x8(y_hi, v_hi, c.y, c.r_v, c.r_bias));
+            uint8x16_t g = vcombine_u8(linear3_u8x8(y_lo, u_lo, v_lo, c.y, c.g_u, c.g_v, c.g_bias),
+                                       linear3_u8x8(y_hi, u_hi, v_hi, c.y, c.g_u, c.g_v, c.g_bias));
+            uint8x16_t b = vcombine_u8(linear2_u8x8(y_lo, u_lo, c.y, c.b_u, c.b_bias),
+                                       linear2_u8x8(y_hi, u_hi, c.y, c.b_u, c.b_bias));
+
+            store_pixels16(out + (size_t)x * pixel_size, format, r, g, b, alpha);
+        }
+
+        // Handle remaining pixels
+        for (; x < width; x++) {
+            int yy = y_row[x];
+            int uu = u_row[(size_t)(x / 2) * chroma_step];
+            int vv = v_row[(size_t)(x / 2) * chroma_step];
+            store_pixel(out + (size_t)x * pixel_size, format,
+                        fixed_to_u8(c.r_bias + c.y * yy + c.r_v * vv),
+                        fixed_to_u8(c.g_bias + c.y * yy + c.g_u * uu + c.g_v * vv),
+                        fixed_to_u8(c.b_bias + c.y * yy + c.b_u * uu),
+                        255);
+        }
+    }
+}
+
+void simd_nv12_to_rgb(const uint8_t* y, const uint8_t* uv, uint8_t* dst, simd_pixel_format_t format,
+                      int width, int height, simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    size_t chroma_stride = (size_t)(width + 1) / 2 * 2;
+    yuv420_to_rgb(y, (size_t)width, uv, chroma_stride, uv + 1, chroma_stride, 2,
+                  dst, (size_t)width * simd_pixel_size(format), format, width, height, matrix, range);
+}
+
+void simd_i420_to_rgb(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst,
+                      simd_pixel_format_t format, int width, int height,
+                      simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    size_t chroma_stride = (size_t)(width + 1) / 2;
+    yuv420_to_rgb(y, (size_t)width, u, chroma_stride, v, chroma_stride, 1,
+                  dst, (size_t)width * simd_pixel_size(format), format, width, height, matrix, range);
+}
+
+/*
+ * HSV
+ */
+
+// Hue numerator scaled so that H = 30 * n / delta lands in [-30, 150]
+static inline void rgb_to_hsv_pixel(uint8_t r, uint8_t g, uint8_t b, uint8_t* hsv) {
+    int max = r > g ? r : g;
+    max = max > b ? max : b;
+    int min = r < g ? r : g;
+    min = min < b ? min : b;
+    int delta = max - min;
+
+    int n;
+    if (max == r) n = g - b;
+    else if (max == g) n = b - r + 2 * delta;
+    else n = r - g + 4 * delta;
+
+    uint8_t h = 0;
+    uint8_t s = 0;
+    if (delta) {
+        float hf = (30.0f * (float)n) / (float)delta;
+        if (hf < 0.0f) hf += 180.0f;
+        long hi = lrintf(hf);
+        h = hi >= 180 ? 0 : (uint8_t)hi;
+        s = (uint8_t)lrintf((255.0f * (float)delta) / (float)max);
+    }
+
+    hsv[0] = h;
+    hsv[1] = s;
+    hsv[2] = (uint8_t)max;
+}
+
+// Hue and saturation for 4 lanes; lanes with delta == 0 are zeroed by the caller
+static inline void hsv_hue_sat4(int16x4_t n, int16x4_t delta, int16x4_t max,
+                                uint32x4_t* h, uint32x4_t* s) {
+    float32x4_t fn = vcvtq_f32_s32(vmovl_s16(n));
+    float32x4_t fd = vcvtq_f32_s32(vmovl_s16(delta));
+    float32x4_t fm = vcvtq_f32_s32(vmovl_s16(max));
+
+    float32x4_t hf = vdivq_f32(vmulq_f32(vdupq_n_f32(30.0f), fn), fd);
+    uint32x4_t negative = vcltq_f32(hf, vdupq_n_f32(0.0f));
+    hf = vbslq_f32(negative, vaddq_f32(hf, vdupq_n_f32(180.0f)), hf);
+    uint32x4_t hi = vreinterpretq_u32_s32(vcvtnq_s32_f32(hf));
+    *h = vbslq_u32(vceqq_u32(hi, vdupq_n_u32(180)), vdupq_n_u32(0), hi);
+
+    float32x4_t sf = vdivq_f32(vmulq_f32(vdupq_n_f32(255.0f), fd), fm);
+    *s = vcvtnq_u32_f32(sf);
+}
+
+void simd_rgb_to_hsv(const uint8_t* src, simd_pixel_format_t format, uint8_t* hsv, size_t pixel_count) {
+    size_t pixel_size = simd_pixel_size(format);
+
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint8x16_t r, g, b, a;
+        load_pixels16(src + i * 16 * pixel_size, format, &r, &g, &b, &a);
+
+        uint8x16_t vmax = vmaxq_u8(vmaxq_u8(r, g), b);
+        uint8x16_t vmin = vminq_u8(vminq_u8(r, g), b);
+        uint8x16_t is_r = vceqq_u8(vmax, r);
+        uint8x16_t is_g = vandq_u8(vceqq_u8(vmax, g), vmvnq_u8(is_r));
+        uint8x16_t flat = vceqq_u8(vmax, vmin);
+
+        uint8x16x3_t out;
+        out.val[2] = vmax;
+
+        uint8x8_t r_half[2] = { vget_low_u8(r), vget_high_u8(r) };
+        uint8x8_t g_half[2] = { vget_low_u8(g), vget_high_u8(g) };
+        uint8x8_t b_half[2] = { vget_low_u8(b), vget_high_u8(b) };
+        uint8x8_t max_half[2] = { vget_low_u8(vmax), vget_high_u8(vmax) };
+        uint8x8_t min_half[2] = { vget_low_u8(vmin), vget_high_u8(vmin) };
+        uint8x8_t is_r_half[2] = { vget_low_u8(is_r), vget_high_u8(is_r) };
+        uint8x8_t is_g_half[2] = { vget_low_u8(is_g), vget_high_u8(is_g) };
+
+        uint8x8_t hue[2], sat[2];
+        for (int half = 0; half < 2; half++) {
+            int16x8_t rs = widen_u8(r_half[half]);
+            int16x8_t gs = widen_u8(g_half[half]);
+            int16x8_t bs = widen_u8(b_half[half]);
+            int16x8_t mx = widen_u8(max_half[half]);
+            int16x8_t delta = vsubq_s16(mx, widen_u8(min_half[half]));
+
+            // Select the hue numerator by which channel holds the maximum
+            int16x8_t n_r = vsubq_s16(gs, bs);
+            int16x8_t n_g = vaddq_s16(vsubq_s16(bs, rs), vshlq_n_s16(delta, 1));
+            int16x8_t n_b = vaddq_s16(vsubq_s16(rs, gs), vshlq_n_s16(delta, 2));
+            uint16x8_t sel_r = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(is_r_half[half])));
+            uint16x8_t sel_g = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(is_g_half[half])));
+            int16x8_t n = vbslq_s16(sel_r, n_r, vbslq_s16(sel_g, n_g, n_b));
+
+            uint32x4_t h_lo, h_hi, s_lo, s_hi;
+            hsv_hue_sat4(vget_low_s16(n), vget_low_s16(delta), vget_low_s16(mx), &h_lo, &s_lo);
+            hsv_hue_sat4(vget_high_s16(n), vget_high_s16(delta), vget_high_s16(mx), &h_hi, &s_hi);
+
+            hue[half] = vqmovn_u16(vcombine_u16(vqmovn_u32(h_lo), vqmovn_u32(h_hi)));
+            sat[half] = vqmovn_u16(vcombine_u16(vqmovn_u32(s_lo), vqmovn_u32(s_hi)));
+        }
+
+        // Gray pixels (including black) have no hue or saturation
+        out.val[0] = vbicq_u8(vcombine_u8(hue[0], hue[1]), flat);
+        out.val[1] = vbicq_u8(vcombine_u8(sat[0], sat[1]), flat);
+        vst3q_u8(hsv + i * 48, out);
+    }
+
+    // Handle remaining pixels
+    for (size_t i = vec_size * 16; i < pixel_count; i++) {
+        uint8_t r, g, b, a;
+        load_pixel(src + i * pixel_size, format, &r, &g, &b, &a);
+        rgb_to_hsv_pixel(r, g, b, hsv + i * 3);
+    }
+}
+
+// Channel n of HSV -> RGB: V - V * S * clamp(min(k, 4 - k), 0, 1), k = (n + H / 30) mod 6
+static inline uint8_t hsv_channel(float n, float hh, float v, float vs) {
+    float k = n + hh;
+    if (k >= 6.0f) k -= 6.0f;
+    float t = fminf(k, 4.0f - k);
+    t = fminf(t, 1.0f);
+    t = fmaxf(t, 0.0f);
+    return (uint8_t)lrintf(v - vs * t);
+}
+
+static inline uint32x4_t hsv_channel4(float n, float32x4_t hh, float32x4_t v, float32x4_t vs) {
+    float32x4_t six = vdupq_n_f32(6.0f);
+    float32x4_t k = vaddq_f32(vdupq_n_f32(n), hh);
+    k = vbslq_f32(vcgeq_f32(k, six), vsubq_f32(k, six), k);
+    float32x4_t t = vminq_f32(k, vsubq_f32(vdupq_n_f32(4.0f), k));
+    t = vminq_f32(t, vdupq_n_f32(1.0f));
+    t = vmaxq_f32(t, vdupq_n_f32(0.0f));
+    return vcvtnq_u32_f32(vsubq_f32(v, vmulq_f32(vs, t)));
+}
+
+void simd_hsv_to_rgb(const uint8_t* hsv, uint8_t* dst, simd_pixel_format_t format, size_t pixel_count) {
+    size_t pixel_size = simd_pixel_size(format);
+    float32x4_t thirty = vdupq_n_f32(30.0f);
+    float32x4_t inv_255 = vdupq_n_f32(1.0f / 255.0f);
+
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = pixel_count / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint8x16x3_t in = vld3q_u8(hsv + i * 48);
+        uint16x8_t h16[2] = { vmovl_u8(vget_low_u8(in.val[0])), vmovl_u8(vget_high_u8(in.val[0])) };
+        uint16x8_t s16[2] = { vmovl_u8(vget_low_u8(in.val[1])), vmovl_u8(vget_high_u8(in.val[1])) };
+        uint16x8_t v16[2] = { vmovl_u8(vget_low_u8(in.val[2])), vmovl_u8(vget_high_u8(in.val[2])) };
+
+        uint16x4_t rq[4], gq[4], bq[4];
+        for (int q = 0; q < 4; q++) {
+            uint16x8_t hw = h16[q / 2], sw = s16[q / 2], vw = v16[q / 2];
+            uint16x4_t hq = (q & 1) ? vget_high_u16(hw) : vget_low_u16(hw);
+            uint16x4_t sq = (q & 1) ? vget_high_u16(sw) : vget_low_u16(sw);
+            uint16x4_t vq = (q & 1) ? vget_high_u16(vw) : vget_low_u16(vw);
+
+            float32x4_t hh = vdivq_f32(vcvtq_f32_u32(vmovl_u16(hq)), thirty);
+            float32x4_t v = vcvtq_f32_u32(vmovl_u16(vq));
+            float32x4_t vs = vmulq_f32(v, vmulq_f32(vcvtq_f32_u32(vmovl_u16(sq)), inv_255));
+
+            rq[q] = vqmovn_u32(hsv_channel4(5.0f, hh, v, vs));
+            gq[q] = vqmovn_u32(hsv_channel4(3.0f, hh, v, vs));
+            bq[q] = vqmovn_u32(hsv_channel4(1.0f, hh, v, vs));
+        }
+
+        uint8x16_t r = vcombine_u8(vqmovn_u16(vcombine_u16(rq[0], rq[1])), vqmovn_u16(vcombine_u16(rq[2], rq[3])));
+        uint8x16_t g = vcombine_u8(vqmovn_u16(vcombine_u16(gq[0], gq[1])), vqmovn_u16(vcombine_u16(gq[2], gq[3])));
+        uint8x16_t b = vcombine_u8(vqmovn_u16(vcombine_u16(bq[0], bq[1])), vqmovn_u16(vcombine_u16(bq[2], bq[3])));
+        store_pixels16(dst + i * 16 * pixel_size, format, r, g, b, vdupq_n_u8(255));
+    }
+
+    // Handle remaining pixels
+    for (size_t i = vec_size * 16; i < pixel_count; i++) {
+        const uint8_t* p = hsv + i * 3;
+        float hh = (float)p[0] / 30.0f;
+        float v = (float)p[2];
+        float vs = v * ((float)p[1] * (1.0f / 255.0f));
+        store_pixel(dst + i * pixel_size, format,
+                    hsv_channel(5.0f, hh, v, vs),
+                    hsv_channel(3.0f, hh, v, vs),
+                    hsv_channel(1.0f, hh, v, vs),
+                    255);
+    }
+}
+
+/*
+ * Strided Views
+ */
+
+// Both views hold width x height pixels of the given sizes
+static bool views_match(const simd_image_t* a, size_t a_pixel, const simd_image_t* b, size_t b_pixel) {
+    return simd_image_valid(a, (int)a_pixel, 1) && simd_image_valid(b, (int)b_pixel, 1) &&
+           a->width == b->width && a->height == b->height;
+}
+
+// Packed views are converted as one run of pixels, others row by row
+static bool views_packed(const simd_image_t* a, const simd_image_t* b) {
+    return simd_image_is_packed(a, 1) && simd_image_is_packed(b, 1);
+}
+
+void simd_convert_pixels_view(const simd_image_t* src, simd_pixel_format_t src_format,
+                              const simd_image_t* dst, simd_pixel_format_t dst_format) {
+    if (!views_match(src, simd_pixel_size(src_format), dst, simd_pixel_size(dst_format))) return;
+    if (views_packed(src, dst)) {
+        simd_convert_pixels(src->data, src_format, dst->data, dst_format, (size_t)src->width * src->height);
+        return;
+    }
+    for (int y = 0; y < src->height; y++) {
+        simd_convert_pixels((const uint8_t*)simd_image_row(src, y), src_format,
+                            (uint8_t*)simd_image_row(dst, y), dst_format, (size_t)src->width);
+    }
+}
+
+void simd_convert_to_gray_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* gray) {
+    if (!views_match(src, simd_pixel_size(format), gray, 1)) return;
+    if (views_packed(src, gray)) {
+        simd_convert_to_gray(src->data, format, gray->data, (size_t)src->width * src->height);
+        return;
+    }
+    for (int y = 0; y < src->height; y++) {
+        simd_convert_to_gray((const uint8_t*)simd_image_row(src, y), format,
+                             (uint8_t*)simd_image_row(gray, y), (size_t)src->width);
+    }
+}
+
+void simd_rgb_to_hsv_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* hsv) {
+    if (!views_match(src, simd_pixel_size(format), hsv, 3)) return;
+    if (views_packed(src, hsv)) {
+        simd_rgb_to_hsv(src->data, format, hsv->data, (size_t)src->width * src->height);
+        return;
+    }
+    for (int y = 0; y < src->height; y++) {
+        simd_rgb_to_hsv((const uint8_t*)simd_image_row(src, y), format,
+                        (uint8_t*)simd_image_row(hsv, y), (size_t)src->width);
+    }
+}
+
+void simd_hsv_to_rgb_view(const simd_image_t* hsv, const simd_image_t* dst, simd_pixel_format_t format) {
+    if (!views_match(hsv, 3, dst, simd_pixel_size(format))) return;
+    if (views_packed(hsv, dst)) {
+        simd_hsv_to_rgb(hsv->data, dst->data, format, (size_t)hsv->width * hsv->height);
+        return;
+    }
+    for (int y = 0; y < hsv->height; y++) {
+        simd_hsv_to_rgb((const uint8_t*)simd_image_row(hsv, y), (uint8_t*)simd_image_row(dst, y),
+                        format, (size_t)hsv->width);
+    }
+}
+
+// Chroma plane of a width x height image: (width + 1) / 2 x (height + 1) / 2
+static bool chroma_matches(const simd_image_t* luma, const simd_image_t* chroma, int channels) {
+    return simd_image_valid(chroma, channels, 1) &&
+           chroma->width == (luma->width + 1) / 2 && chroma->height == (luma->height + 1) / 2;
+}
+
+void simd_rgb_to_nv12_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* y,
+                           const simd_image_t* uv, simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    if (!views_match(src, simd_pixel_size(format), y, 1) || !chroma_matches(y, uv, 2)) return;
+    rgb_to_yuv420(src->data, src->stride, format, src->width, src->height, y->data, y->stride,
+                  uv->data, uv->stride, uv->data + 1, uv->stride, 2, matrix, range);
+}
+
+void simd_nv12_to_rgb_view(const simd_image_t* y, const simd_image_t* uv, const simd_image_t* dst,
+                           simd_pixel_format_t format, simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    if (!views_match(y, 1, dst, simd_pixel_size(format)) || !chroma_matches(y, uv, 2)) return;
+    yuv420_to_rgb(y->data, y->stride, uv->data, uv->stride, uv->data + 1, uv->stride, 2,
+                  dst->data, dst->stride, format, y->width, y->height, matrix, range);
+}
+
+void simd_rgb_to_i420_view(const simd_image_t* src, simd_pixel_format_t format, const simd_image_t* y,
+                           const simd_image_t* u, const simd_image_t* v,
+                           simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    if (!views_match(src, simd_pixel_size(format), y, 1) || !chroma_matches(y, u, 1) || !chroma_matches(y, v, 1)) return;
+    rgb_to_yuv420(src->data, src->stride, format, src->width, src->height, y->data, y->stride,
+                  u->data, u->stride, v->data, v->stride, 1, matrix, range);
+}
+
+void simd_i420_to_rgb_view(const simd_image_t* y, const simd_image_t* u, const simd_image_t* v,
+                           const simd_image_t* dst, simd_pixel_format_t format,
+                           simd_yuv_matrix_t matrix, simd_yuv_range_t range) {
+    if (!views_match(y, 1, dst, simd_pixel_size(format)) || !chroma_matches(y, u, 1) || !chroma_matches(y, v, 1)) return;
+    yuv420_to_rgb(y->data, y->stride, u->data, u->stride, v->data, v->stride, 1,
+                  dst->data, dst->stride, format, y->width, y->height, matrix, range);
+}
@@ -0,0 +1,559 @@
+/**
+ * simd_convolve.c
+ * Implementation of 2D convolution using NEON
+ *
+ * Each source row is border-extended (and, for 8-bit images, widened to
+ * int16) exactly once into a ring of ksize rows; output row y reads ring
+ * slots y - r .. y + r, so moving to the next row costs one new row
+ * instead of ksize fresh loads. Separable kernels keep the horizontal
+ * pass results in the ring instead and finish with a vertical pass.
+ */
+#include "simd_convolve.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <arm_neon.h>
+
+/*
+ * Separability Detection
+ */
+
+static int gcd_int(int a, int b) {
+    while (b) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+bool simd_kernel_separable_f32(const float* kernel, int ksize, float* kx, float* ky) {
+    // Pivot on the largest coefficient
+    int pr = 0, pc = 0;
+    float max_abs = 0.0f;
+    for (int i = 0; i < ksize; i++) {
+        for (int j = 0; j < ksize; j++) {
+            if (fabsf(kernel[i * ksize + j]) > max_abs) {
+                max_abs = fabsf(kernel[i * ksize + j]);
+                pr = i;
+                pc = j;
+            }
+        }
+    }
+
+    float pivot = kernel[pr * ksize + pc];
+    for (int j = 0; j < ksize; j++) kx[j] = kernel[pr * ksize + j];
+    for (int i = 0; i < ksize; i++) ky[i] = max_abs > 0.0f ? kernel[i * ksize + pc] / pivot : 0.0f;
+
+    float tolerance = 1e-6f * max_abs;
+    for (int i = 0; i < ksize; i++) {
+        for (int j = 0; j < ksize; j++) {
+            if (fabsf(kernel[i * ksize + j] - ky[i] * kx[j]) > tolerance) return false;
+        }
+    }
+    return true;
+}
+
+bool simd_kernel_separable_s16(const int16_t* kernel, int ksize, int16_t* kx, int16_t* ky) {
+    // First row with a nonzero coefficient
+    int pr = -1;
+    for (int i = 0; i < ksize * ksize && pr < 0; i++) {
+        if (kernel[i]) pr = i / ksize;
+    }
+    if (pr < 0) {
+        for (int i = 0; i < ksize; i++) kx[i] = ky[i] = 0;
+        return true;
+    }
+
+    // Dividing that row by its gcd makes ky integral whenever an integer
+    // factorization exists
+    int g = 0;
+    for (int j = 0; j < ksize; j++) g = gcd_int(g, abs(kernel[pr * ksize + j]));
+
+    int pc = -1;
+    for (int j = 0; j < ksize; j++) {
+        kx[j] = (int16_t)(kernel[pr * ksize + j] / g);
+        if (pc < 0 && kx[j]) pc = j;
+    }
+
+    for (int i = 0; i < ksize; i++) {
+        int num = kernel[i * ksize + pc];
+        if (num % kx[pc]) return false;
+        ky[i] = (int16_t)(num / kx[pc]);
+    }
+
+    for (int i = 0; i < ksize; i++) {
+        for (int j = 0; j < ksize; j++) {
+            if (kernel[i * ksize + j] != ky[i] * kx[j]) return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Row Ring Helpers
+ */
+
+// Ring slot holding virtual row v (v may be negative)
+static inline size_t ring_slot(int v, int ksize) {
+    int s = v % ksize;
+    return (size_t)(s < 0 ? s + ksize : s);
+}
+
+static inline bool valid_ksize(int ksize, int width, int height) {
+    return ksize >= 1 && (ksize & 1) && ksize <= SIMD_CONV_MAX_KSIZE && width > 0 && height > 0;
+}
+
+// Copy virtual row v into OUT with r border pixels on each side
+static void extend_row_f32(const float* src, size_t stride, int width, int height, int v, int r,
+                           simd_border_t border, float value, float* out) {
+    int sy = simd_border_index(v, height, border);
+    if (sy < 0) {
+        for (int x = 0; x < width + 2 * r; x++) out[x] = value;
+        return;
+    }
+
+    const float* row = (const float*)((const uint8_t*)src + (size_t)sy * stride);
+    memcpy(out + r, row, (size_t)width * sizeof(float));
+    for (int x = 1; x <= r; x++) {
+        int left = simd_border_index(-x, width, border);
+        int right = simd_border_index(width - 1 + x, width, border);
+        out[r - x] = left < 0 ? value : row[left];
+        out[r + width - 1 + x] = right < 0 ? value : row[right];
+    }
+}
+
+// Widen virtual row v to int16 into OUT with r border pixels on each side
+static void extend_row_u8(const uint8_t* src, size_t stride, int width, int height, int v, int r,
+                          simd_border_t border, uint8_t value, int16_t* out) {
+    int sy = simd_border_index(v, height, border);
+    if (sy < 0) {
+        for (int x = 0; x < width + 2 * r; x++) out[x] = value;
+        return;
+    }
+
+    const uint8_t* row = src + (size_t)sy * stride;
+    int16_t* mid = out + r;
+
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+    for (size_t i = 0; i < vec_size; i++) {
+        vst1q_s16(mid + i * 8, vreinterpretq_s16_u16(vmovl_u8(vld1_u8(row + i * 8))));
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) mid[x] = row[x];
+
+    for (int x = 1; x <= r; x++) {
+        int left = simd_border_index(-x, width, border);
+        int right = simd_border_index(width - 1 + x, width, border);
+        out[r - x] = left < 0 ? value : row[left];
+        out[r + width - 1 + x] = right < 0 ? value : row[right];
+    }
+}
+
+// sat_u8(round(acc / 2^shift)) for 8 lanes; neg_shift holds -shift
+static inline uint8x8_t narrow_shift_u8(int32x4_t lo, int32x4_t hi, int32x4_t neg_shift) {
+    lo = vrshlq_s32(lo, neg_shift);
+    hi = vrshlq_s32(hi, neg_shift);
+    return vqmovn_u16(vcombine_u16(vqmovun_s32(lo), vqmovun_s32(hi)));
+}
+
+static inline uint8_t shift_to_u8(int32_t acc, int shift) {
+    if (shift > 0) acc = (acc + (1 << (shift - 1))) >> shift;
+    return acc < 0 ? 0 : (acc > 255 ? 255 : (uint8_t)acc);
+}
+
+/*
+ * Float Row Kernels
+ */
+
+// OUT[x] = sum_j k[j] * IN[x + j]
+static void filter_row_f32(const float* in, float* out, int width, const float* k, int ksize) {
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        const float* p = in + i * 8;
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        for (int j = 0; j < ksize; j++) {
+            float32x4_t kj = vdupq_n_f32(k[j]);
+            acc0 = vfmaq_f32(acc0, vld1q_f32(p + j), kj);
+            acc1 = vfmaq_f32(acc1, vld1q_f32(p + j + 4), kj);
+        }
+        vst1q_f32(out + i * 8, acc0);
+        vst1q_f32(out + i * 8 + 4, acc1);
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) {
+        float sum = 0.0f;
+        for (int j = 0; j < ksize; j++) sum += k[j] * in[x + j];
+        out[x] = sum;
+    }
+}
+
+// OUT[x] = sum_i k[i] * ROWS[i][x]
+static void combine_rows_f32(const float* const* rows, float* out, int width, const float* k, int ksize) {
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        for (int t = 0; t < ksize; t++) {
+            float32x4_t kt = vdupq_n_f32(k[t]);
+            acc0 = vfmaq_f32(acc0, vld1q_f32(rows[t] + i * 8), kt);
+            acc1 = vfmaq_f32(acc1, vld1q_f32(rows[t] + i * 8 + 4), kt);
+        }
+        vst1q_f32(out + i * 8, acc0);
+        vst1q_f32(out + i * 8 + 4, acc1);
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) {
+        float sum = 0.0f;
+        for (int t = 0; t < ksize; t++) sum += k[t] * rows[t][x];
+        out[x] = sum;
+    }
+}
+
+// OUT[x] = sum_ij K[i][j] * ROWS[i][x + j]
+static void direct_row_f32(const float* const* rows, float* out, int width, const float* kernel, int ksize) {
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        for (int t = 0; t < ksize; t++) {
+            const float* p = rows[t] + i * 8;
+            const float* k = kernel + t * ksize;
+            for (int j = 0; j < ksize; j++) {
+                if (k[j] == 0.0f) continue;
+                float32x4_t kj = vdupq_n_f32(k[j]);
+                acc0 = vfmaq_f32(acc0, vld1q_f32(p + j), kj);
+                acc1 = vfmaq_f32(acc1, vld1q_f32(p + j + 4), kj);
+            }
+        }
+        vst1q_f32(out + i * 8, acc0);
+        vst1q_f32(out + i * 8 + 4, acc1);
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) {
+        float sum = 0.0f;
+        for (int t = 0; t < ksize; t++) {
+            for (int j = 0; j < ksize; j++) sum += kernel[t * ksize + j] * rows[t][x + j];
+        }
+        out[x] = sum;
+    }
+}
+
+/*
+ * Integer Row Kernels
+ */
+
+// OUT[x] = sum_j k[j] * IN[x + j], int16 in, int32 out
+static void filter_row_s16(const int16_t* in, int32_t* out, int width, const int16_t* k, int ksize) {
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        const int16_t* p = in + i * 8;
+        int32x4_t lo = vdupq_n_s32(0);
+        int32x4_t hi = vdupq_n_s32(0);
+        for (int j = 0; j < ksize; j++) {
+            if (!k[j]) continue;
+            int16x8_t v = vld1q_s16(p + j);
+            lo = vmlal_n_s16(lo, vget_low_s16(v), k[j]);
+            hi = vmlal_n_s16(hi, vget_high_s16(v), k[j]);
+        }
+        vst1q_s32(out + i * 8, lo);
+        vst1q_s32(out + i * 8 + 4, hi);
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) {
+        int32_t sum = 0;
+        for (int j = 0; j < ksize; j++) sum += k[j] * in[x + j];
+        out[x] = sum;
+    }
+}
+
+// OUT[x] = sat_u8(round(sum_i k[i] * ROWS[i][x] / 2^shift))
+static void combine_rows_s32_u8(const int32_t* const* rows, uint8_t* out, int width,
+                                const int16_t* k, int ksize, int shift) {
+    int32x4_t neg_shift = vdupq_n_s32(-shift);
+
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        int32x4_t lo = vdupq_n_s32(0);
+        int32x4_t hi = vdupq_n_s32(0);
+        for (int t = 0; t < ksize; t++) {
+            if (!k[t]) continue;
+            lo = vmlaq_n_s32(lo, vld1q_s32(rows[t] + i * 8), k[t]);
+            hi = vmlaq_n_s32(hi, vld1q_s32(rows[t] + i * 8 + 4), k[t]);
+        }
+        vst1_u8(out + i * 8, narrow_shift_u8(lo, hi, neg_shift));
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) {
+        int32_t sum = 0;
+        for (int t = 0; t < ksize; t++) sum += k[t] * rows[t][x];
+        out[x] = shift_to_u8(sum, shift);
+    }
+}
+
+// OUT[x] = sat_u8(round(sum_ij K[i][j] * ROWS[i][x + j] / 2^shift))
+static void direct_row_u8(const int16_t* const* rows, uint8_t* out, int width,
+                          const int16_t* kernel, int ksize, int shift) {
+    int32x4_t neg_shift = vdupq_n_s32(-shift);
+
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        int32x4_t lo = vdupq_n_s32(0);
+        int32x4_t hi = vdupq_n_s32(0);
+        for (int t = 0; t < ksize; t++) {
+            const int16_t* p = rows[t] + i * 8;
+            const int16_t* k = kernel + t * ksize;
+            for (int j = 0; j < ksize; j++) {
+                if (!k[j]) continue;
+                int16x8_t v = vld1q_s16(p + j);
+                lo = vmlal_n_s16(lo, vget_low_s16(v), k[j]);
+                hi = vmlal_n_s16(hi, vget_high_s16(v), k[j]);
+            }
+        }
+        vst1_u8(out + i * 8, narrow_shift_u8(lo, hi, neg_shift));
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) {
+        int32_t sum = 0;
+        for (int t = 0; t < ksize; t++) {
+            for (int j = 0; j < ksize; j++) sum += kernel[t * ksize + j] * rows[t][x + j];
+        }
+        out[x] = shift_to_u8(sum, shift);
+    }
+}
+
+/*
+ * Float Convolution
+ */
+
+static void convolve_direct_f32(const float* src, size_t src_stride, float* dst, size_t dst_stride, int width, int height,
+                                const float* kernel, int ksize, simd_border_t border, float border_value) {
+    int r = ksize / 2;
+    size_t padded = (size_t)width + 2 * r;
+    float* ring = (float*)neon_malloc((size_t)ksize * padded * sizeof(float));
+    if (!ring) return;
+
+    const float* rows[SIMD_CONV_MAX_KSIZE];
+
+    // Prime the ring with virtual rows -r .. r - 1
+    for (int v = -r; v < r; v++) {
+        extend_row_f32(src, src_stride, width, height, v, r, border, border_value, ring + ring_slot(v, ksize) * padded);
+    }
+
+    for (int y = 0; y < height; y++) {
+        // Only the newest row enters the ring
+        extend_row_f32(src, src_stride, width, height, y + r, r, border, border_value,
+                       ring + ring_slot(y + r, ksize) * padded);
+        for (int t = 0; t < ksize; t++) rows[t] = ring + ring_slot(y - r + t, ksize) * padded;
+        direct_row_f32(rows, (float*)((uint8_t*)dst + (size_t)y * dst_stride), width, kernel, ksize);
+    }
+
+    free(ring);
+}
+
+static void convolve_sep_f32(const float* src, size_t src_stride, float* dst, size_t dst_stride, int width, int height,
+                             const float* kx, const float* ky, int ksize,
+                             simd_border_t border, float border_value) {
+    int r = ksize / 2;
+    size_t padded = (size_t)width + 2 * r;
+    float* line = (float*)neon_malloc(padded * sizeof(float));
+    float* ring = (float*)neon_malloc((size_t)ksize * width * sizeof(float));
+    if (!line || !ring) {
+        free(line);
+        free(ring);
+        return;
+    }
+
+    const float* rows[SIMD_CONV_MAX_KSIZE];
+
+    // Prime the ring with the horizontal pass of virtual rows -r .. r - 1
+    for (int v = -r; v < r; v++) {
+        extend_row_f32(src, src_stride, width, height, v, r, border, border_value, line);
+        filter_row_f32(line, ring + ring_slot(v, ksize) * width, width, kx, ksize);
+    }
+
+    for (int y = 0; y < height; y++) {
+        extend_row_f32(src, src_stride, width, height, y + r, r, border, border_value, line);
+        filter_row_f32(line, ring + ring_slot(y + r, ksize) * width, width, kx, ksize);
+        for (int t = 0; t < ksize; t++) rows[t] = ring + ring_slot(y - r + t, ksize) * width;
+        combine_rows_f32(rows, (float*)((uint8_t*)dst + (size_t)y * dst_stride), width, ky, ksize);
+    }
+
+    free(line);
+    free(ring);
+}
+
+static void convolve_f32(const float* src, size_t src_stride, float* dst, size_t dst_stride, int width, int height,
+                         const float* kernel, int ksize, simd_border_t border, float border_value) {
+    float kx[SIMD_CONV_MAX_KSIZE], ky[SIMD_CONV_MAX_KSIZE];
+    if (ksize > 1 && simd_kernel_separable_f32(kernel, ksize, kx, ky)) {
+        convolve_sep_f32(src, src_stride, dst, dst_stride, width, height, kx, ky, ksize, border, border_value);
+    } else {
+        convolve_direct_f32(src, src_stride, dst, dst_stride, width, height, kernel, ksize, border, border_value);
+    }
+}
+
+void simd_convolve_sep_f32(const float* src, float* dst, int width, int height,
+                           const float* kx, const float* ky, int ksize,
+                           simd_border_t border, float border_value) {
+    if (!valid_ksize(ksize, width, height)) return;
+    size_t stride = (size_t)width * sizeof(float);
+    convolve_sep_f32(src, stride, dst, stride, width, height, kx, ky, ksize, border, border_value);
+}
+
+void simd_convolve_f32(const float* src, float* dst, int width, int height,
+                       const float* kernel, int ksize, simd_border_t border, float border_value) {
+    if (!valid_ksize(ksize, width, height)) return;
+    size_t stride = (size_t)width * sizeof(float);
+    convolve_f32(src, stride, dst, stride, width, height, kernel, ksize, border, border_value);
+}
+
+/*
+ * 8-bit Convolution
+ */
+
+static void convolve_direct_u8(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride, int width, int height,
+                               const int16_t* kernel, int ksize, int shift,
+                               simd_border_t border, uint8_t border_value) {
+    int r = ksize / 2;
+    size_t padded = (size_t)width + 2 * r;
+    int16_t* ring = (int16_t*)neon_malloc((size_t)ksize * padded * sizeof(int16_t));
+    if (!ring) return;
+
+    const int16_t* rows[SIMD_CONV_MAX_KSIZE];
+
+    // Prime the ring with virtual rows -r .. r - 1
+    for (int v = -r; v < r; v++) {
+        extend_row_u8(src, src_stride, width, height, v, r, border, border_value, ring + ring_slot(v, ksize) * padded);
+    }
+
+    for (int y = 0; y < height; y++) {
+        // Only the newest row enters the ring
+        extend_row_u8(src, src_stride, width, height, y + r, r, border, border_value,
+                      ring + ring_slot(y + r, ksize) * padded);
+        for (int t = 0; t < ksize; t++) rows[t] = ring + ring_slot(y - r + t, ksize) * padded;
+        direct_row_u8(rows, dst + (size_t)y * dst_stride, width, kernel, ksize, shift);
+    }
+
+    free(ring);
+}
+
+static void convolve_sep_u8(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride, int width, int height,
+                            const int16_t* kx, const int16_t* ky, int ksize, int shift,
+                            simd_border_t border, uint8_t border_value) {
+    int r = ksize / 2;
+    size_t padded = (size_t)width + 2 * r;
+    int16_t* line = (int16_t*)neon_malloc(padded * sizeof(int16_t));
+    int32_t* ring = (int32_t*)neon_malloc((size_t)ksize * width * sizeof(int32_t));
+    if (!line || !ring) {
+        free(line);
+        free(ring);
+        return;
+    }
+
+    const int32_t* rows[SIMD_CONV_MAX_KSIZE];
+
+    // Prime the ring with the horizontal pass of virtual rows -r .. r - 1
+    for (int v = -r; v < r; v++) {
+        extend_row_u8(src, src_stride, width, height, v, r, border, border_value, line);
+        filter_row_s16(line, ring + ring_slot(v, ksize) * width, width, kx, ksize);
+    }
+
+    for (int y = 0; y < height; y++) {
+        extend_row_u8(src, src_stride, width, height, y + r, r, border, border_value, line);
+        filter_row_s16(line, ring + ring_slot(y + r, ksize) * width, width, kx, ksize);
+        for (int t = 0; t < ksize; t++) rows[t] = ring + ring_slot(y - r + t, ksize) * width;
+        combine_rows_s32_u8(rows, dst + (size_t)y * dst_stride, width, ky, ksize, shift);
+    }
+
+    free(line);
+    free(ring);
+}
+
+static void convolve_u8(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride, int width, int height,
+                        const int16_t* kernel, int ksize, int shift,
+                        simd_border_t border, uint8_t border_value) {
+    // Integer factorization is exact, so both paths give identical results
+    int16_t kx[SIMD_CONV_MAX_KSIZE], ky[SIMD_CONV_MAX_KSIZE];
+    if (ksize > 1 && simd_kernel_separable_s16(kernel, ksize, kx, ky)) {
+        convolve_sep_u8(src, src_stride, dst, dst_stride, width, height, kx, ky, ksize, shift, border, border_value);
+    } else {
+        convolve_direct_u8(src, src_stride, dst, dst_stride, width, height, kernel, ksize, shift, border, border_value);
+    }
+}
+
+void simd_convolve_sep_u8(const uint8_t* src, uint8_t* dst, int width, int height,
+                          const int16_t* kx, const int16_t* ky, int ksize, int shift,
+                          simd_border_t border, uint8_t border_value) {
+    if (!valid_ksize(ksize, width, height)) return;
+    convolve_sep_u8(src, (size_t)width, dst, (size_t)width, width, height, kx, ky, ksize, shift, border, border_value);
+}
+
+void simd_convolve_u8(const uint8_t* src, uint8_t* dst, int width, int height,
+                      const int16_t* kernel, int ksize, int shift,
+                      simd_border_t border, uint8_t border_value) {
+    if (!valid_ksize(ksize, width, height)) return;
+    convolve_u8(src, (size_t)width, dst, (size_t)width, width, height, kernel, ksize, shift, border, border_value);
+}
+
+/*
+ * Strided Views
+ */
+
+// Single-channel views of the same size with ELEM_SIZE-byte elements
+static bool views_match(const simd_image_t* src, const simd_image_t* dst, size_t elem_size, int ksize) {
+    return simd_image_valid(src, 1, elem_size) && simd_image_valid(dst, 1, elem_size) &&
+           src->width == dst->width && src->height == dst->height && valid_ksize(ksize, src->width, src->height);
+}
+
+void simd_convolve_f32_view(const simd_image_t* src, const simd_image_t* dst,
+                            const float* kernel, int ksize, simd_border_t border, float border_value) {
+    if (!views_match(src, dst, sizeof(float), ksize)) return;
+    convolve_f32((const float*)src->data, src->stride, (float*)dst->data, dst->stride, src->width, src->height,
+                 kernel, ksize, border, border_value);
+}
+
+void simd_convolve_u8_view(const simd_image_t* src, const simd_image_t* dst,
+                           const int16_t* kernel, int ksize, int shift,
+                           simd_border_t border, uint8_t border_value) {
+    if (!views_match(src, dst, 1, ksize)) return;
+    convolve_u8(src->data, src->stride, dst->data, dst->stride, src->width, src->height,
+                kernel, ksize, shift, border, border_value);
+}
+
+void simd_convolve_sep_f32_view(const simd_image_t* src, const simd_image_t* dst,
+                                const float* kx, const float* ky, int ksize,
+                                simd_border_t border, float border_value) {
+    if (!views_match(src, dst, sizeof(float), ksize)) return;
+    convolve_sep_f32((const float*)src->data, src->stride, (float*)dst->data, dst->stride, src->width, src->height,
+                     kx, ky, ksize, border, border_value);
+}
+
+void simd_convolve_sep_u8_view(const simd_image_t* src, const simd_image_t* dst,
+                               const int16_t* kx, const int16_t* ky, int ksize, int shift,
+                               simd_border_t border, uint8_t border_value) {
+    if (!views_match(src, dst, 1, ksize)) return;
+    convolve_sep_u8(src->data, src->stride, dst->data, dst->stride, src->width, src->height,
+                    kx, ky, ksize, shift, border, border_value);
+}
@@ -0,0 +1,364 @@
+/**
+ * simd_filter.c
+ * Implementation of predicate-driven stream compaction using NEON
+ */
+#include "simd_filter.h"
+#include <arm_neon.h>
+
+/*
+ * Lookup tables
+ */
+
+// Byte shuffle for vqtbl1q_u8 indexed by a 4-bit lane mask: moves the selected
+// 32-bit lanes to the front of the vector (0x80 lanes read as zero)
+static const uint8_t compact_shuffle_lut[16][16] = {
+    { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // ----
+    {  0,  1,  2,  3, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // 0---
+    {  4,  5,  6,  7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // -1--
+    {  0,  1,  2,  3,  4,  5,  6,  7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // 01--
+    {  8,  9, 10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // --2-
+    {  0,  1,  2,  3,  8,  9, 10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // 0-2-
+    {  4,  5,  6,  7,  8,  9, 10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // -12-
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 0x80, 0x80, 0x80, 0x80 },  // 012-
+    { 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // ---3
+    {  0,  1,  2,  3, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // 0--3
+    {  4,  5,  6,  7, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // -1-3
+    {  0,  1,  2,  3,  4,  5,  6,  7, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80 },  // 01-3
+    {  8,  9, 10, 11, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },  // --23
+    {  0,  1,  2,  3,  8,  9, 10, 11, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80 },  // 0-23
+    {  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80 },  // -123
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },  // 0123
+};
+
+// Number of selected lanes for each 4-bit lane mask
+static const uint8_t compact_count_lut[16] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+// Bit weights used to collapse comparison masks into integers
+static const uint32_t lane_bits_u32[4] = { 1, 2, 4, 8 };
+static const uint8_t lane_bits_u8[16] = {
+    1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+};
+static const uint32_t lane_index_u32[4] = { 0, 1, 2, 3 };
+
+/*
+ * Predicate helpers
+ */
+
+enum {
+    FILTER_GT,
+    FILTER_LT,
+    FILTER_EQ,
+    FILTER_RANGE
+};
+
+static inline uint32x4_t filter_compare(float32x4_t v, float32x4_t lo, float32x4_t hi, int op) {
+    switch (op) {
+        case FILTER_GT: return vcgtq_f32(v, lo);
+        case FILTER_LT: return vcltq_f32(v, lo);
+        case FILTER_EQ: return vceqq_f32(v, lo);
+        default:        return vandq_u32(vcgeq_f32(v, lo), vcleq_f32(v, hi));
+    }
+}
+
+static inline int filter_compare_scalar(float v, float lo, float hi, int op) {
+    switch (op) {
+        case FILTER_GT: return v > lo;
+        case FILTER_LT: return v < lo;
+        case FILTER_EQ: return v == lo;
+        default:        return v >= lo && v <= hi;
+    }
+}
+
+// Collapse a 4-lane comparison mask into a 4-bit integer (lane i -> bit i)
+static inline uint32_t movemask_u32(uint32x4_t mask) {
+    return vaddvq_u32(vandq_u32(mask, vld1q_u32(lane_bits_u32)));
+}
+
+// Collapse four 4-lane comparison masks into a 16-bit integer
+static inline uint32_t movemask16_u32(uint32x4_t m0, uint32x4_t m1, uint32x4_t m2, uint32x4_t m3) {
+    // Narrow 32-bit masks to bytes: 0xFFFFFFFF -> 0xFF
+    uint16x8_t m01 = vcombine_u16(vmovn_u32(m0), vmovn_u32(m1));
+    uint16x8_t m23 = vcombine_u16(vmovn_u32(m2), vmovn_u32(m3));
+    uint8x16_t m = vcombine_u8(vmovn_u16(m01), vmovn_u16(m23));
+
+    // Keep one weighted bit per byte and sum each half horizontally
+    uint8x16_t weighted = vandq_u8(m, vld1q_u8(lane_bits_u8));
+    uint32_t lo = vaddv_u8(vget_low_u8(weighted));
+    uint32_t hi = vaddv_u8(vget_high_u8(weighted));
+
+    return lo | (hi << 8);
+}
+
+/*
+ * Stream Compaction
+ */
+
+// One compaction step. Each step stores a full vector at the current output
+// position; since count never exceeds the input position, the store stays
+// within the len elements the caller provided.
+static inline size_t compact_step(float32x4_t va, uint32x4_t vidx, uint32_t m,
+                                  float* values, uint32_t* indices, size_t count) {
+    uint8x16_t shuffle = vld1q_u8(compact_shuffle_lut[m]);
+
+    if (values) {
+        uint8x16_t packed = vqtbl1q_u8(vreinterpretq_u8_f32(va), shuffle);
+        vst1q_f32(values + count, vreinterpretq_f32_u8(packed));
+    }
+    if (indices) {
+        uint8x16_t packed = vqtbl1q_u8(vreinterpretq_u8_u32(vidx), shuffle);
+        vst1q_u32(indices + count, vreinterpretq_u32_u8(packed));
+    }
+
+    return count + compact_count_lut[m];
+}
+
+static inline size_t filter_f32(const float* a, float lo, float hi, int op,
+                                float* values, uint32_t* indices, size_t len) {
+    float32x4_t vlo = vdupq_n_f32(lo);
+    float32x4_t vhi = vdupq_n_f32(hi);
+    uint32x4_t vidx = vld1q_u32(lane_index_u32);
+    uint32x4_t vfour = vdupq_n_u32(4);
+    size_t count = 0;
+
+    // Process 4 elements at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        float32x4_t va = vld1q_f32(a + i * 4);
+
+        // Evaluate the predicate and turn it into a shuffle selector
+        uint32_t m = movemask_u32(filter_compare(va, vlo, vhi, op));
+        count = compact_step(va, vidx, m, values, indices, count);
+
+        vidx = vaddq_u32(vidx, vfour);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        if (filter_compare_scalar(a[i], lo, hi, op)) {
+            if (values) values[count] = a[i];
+            if (indices) indices[count] = (uint32_t)i;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+size_t simd_filter_gt_f32(const float* a, float threshold, float* values, uint32_t* indices, size_t len) {
+    return filter_f32(a, threshold, threshold, FILTER_GT, values, indices, len);
+}
+
+size_t simd_filter_lt_f32(const float* a, float threshold, float* values, uint32_t* indices, size_t len) {
+    return filter_f32(a, threshold, threshold, FILTER_LT, values, indices, len);
+}
+
+size_t simd_filter_eq_f32(const float* a, float value, float* values, uint32_t* indices, size_t len) {
+    return filter_f32(a, value, value, FILTER_EQ, values, indices, len);
+}
+
+size_t simd_filter_range_f32(const float* a, float lo, float hi, float* values, uint32_t* indices, size_t len) {
+    return filter_f32(a, lo, hi, FILTER_RANGE, values, indices, len);
+}
+
+size_t simd_compact_f32(const float* a, const uint32_t* mask, float* values, uint32_t* indices, size_t len) {
+    uint32x4_t vidx = vld1q_u32(lane_index_u32);
+    uint32x4_t vfour = vdupq_n_u32(4);
+    size_t count = 0;
+
+    // Process 4 elements at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        float32x4_t va = vld1q_f32(a + i * 4);
+        uint32x4_t vmask = vld1q_u32(mask + i * 4);
+
+        // Any non-zero mask word selects the lane
+        uint32_t m = movemask_u32(vtstq_u32(vmask, vmask));
+        count = compact_step(va, vidx, m, values, indices, count);
+
+        vidx = vaddq_u32(vidx, vfour);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        if (mask[i]) {
+            if (values) values[count] = a[i];
+            if (indices) indices[count] = (uint32_t)i;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Packed Comparison Masks
+ */
+
+enum {
+    BITS_GT,
+    BITS_EQ,
+    BITS_GT_N,
+    BITS_MASK
+};
+
+static inline uint32x4_t bits_compare(const float* a, const float* b, float32x4_t vthreshold,
+                                      const uint32_t* mask, size_t i, int op) {
+    switch (op) {
+        case BITS_GT:   return vcgtq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+        case BITS_EQ:   return vceqq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+        case BITS_GT_N: return vcgtq_f32(vld1q_f32(a + i), vthreshold);
+        default: {
+            uint32x4_t vmask = vld1q_u32(mask + i);
+            return vtstq_u32(vmask, vmask);
+        }
+    }
+}
+
+static inline int bits_compare_scalar(const float* a, const float* b, float threshold,
+                                      const uint32_t* mask, size_t i, int op) {
+    switch (op) {
+        case BITS_GT:   return a[i] > b[i];
+        case BITS_EQ:   return a[i] == b[i];
+        case BITS_GT_N: return a[i] > threshold;
+        default:        return mask[i] != 0;
+    }
+}
+
+static inline void pack_bits(const float* a, const float* b, float threshold, const uint32_t* mask,
+                             int op, uint64_t* bits, size_t len) {
+    float32x4_t vthreshold = vdupq_n_f32(threshold);
+
+    // Produce one 64-bit word (64 elements) per iteration
+    size_t word_count = len / 64;
+
+    for (size_t w = 0; w < word_count; w++) {
+        uint64_t word = 0;
+
+        for (int g = 0; g < 4; g++) {
+            size_t base = w * 64 + g * 16;
+            uint32x4_t m0 = bits_compare(a, b, vthreshold, mask, base, op);
+            uint32x4_t m1 = bits_compare(a, b, vthreshold, mask, base + 4, op);
+            uint32x4_t m2 = bits_compare(a, b, vthreshold, mask, base + 8, op);
+            uint32x4_t m3 = bits_compare(a, b, vthreshold, mask, base + 12, op);
+
+            word |= (uint64_t)movemask16_u32(m0, m1, m2, m3) << (g * 16);
+        }
+
+        bits[w] = word;
+    }
+
+    // Handle remaining elements (partial last word, unused bits cleared)
+    if (word_count * 64 < len) {
+        uint64_t word = 0;
+        for (size_t i = word_count * 64; i < len; i++) {
+            if (bits_compare_scalar(a, b, threshold, mask, i, op)) {
+                word |= (uint64_t)1 << (i % 64);
+            }
+        }
+        bits[word_count] = word;
+    }
+}
+
+void simd_cmpgt_bits_f32(const float* a, const float* b, uint64_t* bits, size_t len) {
+    pack_bits(a, b, 0.0f, NULL, BITS_GT, bits, len);
+}
+
+void simd_cmpeq_bits_f32(const float* a, const float* b, uint64_t* bits, size_t len) {
+    pack_bits(a, b, 0.0f, NULL, BITS_EQ, bits, len);
+}
+
+void simd_cmpgt_n_bits_f32(const float* a, float threshold, uint64_t* bits, size_t len) {
+    pack_bits(a, NULL, threshold, NULL, BITS_GT_N, bits, len);
+}
+
+void simd_mask_to_bits_u32(const uint32_t* mask, uint64_t* bits, size_t len) {
+    pack_bits(NULL, NULL, 0.0f, mask, BITS_MASK, bits, len);
+}
+
+/*
+ * Selectivity Statistics
+ */
+
+static inline size_t popcount_u64(uint64_t x) {
+    return vaddv_u8(vcnt_u8(vcreate_u8(x)));
+}
+
+size_t simd_popcount_bits(const uint64_t* bits, size_t len) {
+    size_t full_words = len / 64;
+    size_t total = 0;
+
+    // Process 2 words (16 bytes) at a time; each u16 lane gains at most 16
+    // per step (two bytes of 8 bits), so flush every 2048 steps
+    size_t vec_size = full_words / 2;
+    size_t i = 0;
+
+    while (i < vec_size) {
+        size_t block_end = i + 2048 < vec_size ? i + 2048 : vec_size;
+        uint16x8_t acc = vdupq_n_u16(0);
+
+        for (; i < block_end; i++) {
+            uint8x16_t v = vld1q_u8((const uint8_t*)(bits + i * 2));
+            acc = vpadalq_u8(acc, vcntq_u8(v));
+        }
+
+        total += vaddlvq_u16(acc);
+    }
+
+    // Handle remaining full word
+    for (size_t w = vec_size * 2; w < full_words; w++) {
+        total += popcount_u64(bits[w]);
+    }
+
+    // Handle the partial last word
+    if (len % 64) {
+        uint64_t keep = ((uint64_t)1 << (len % 64)) - 1;
+        total += popcount_u64(bits[full_words] & keep);
+    }
+
+    return total;
+}
+
+static inline simd_filter_stats_t make_stats(size_t total, size_t selected) {
+    simd_filter_stats_t stats;
+    stats.total = total;
+    stats.selected = selected;
+    stats.selectivity = total > 0 ? (double)selected / (double)total : 0.0;
+    return stats;
+}
+
+simd_filter_stats_t simd_selectivity_gt_f32(const float* a, float threshold, size_t len) {
+    float32x4_t vthreshold = vdupq_n_f32(threshold);
+    size_t selected = 0;
+
+    // Process 4 elements at a time using NEON; lanes accumulate -mask (0 or 1)
+    // and are flushed before they could overflow
+    size_t vec_size = len / 4;
+    size_t i = 0;
+
+    while (i < vec_size) {
+        size_t block_end = i + (1u << 30) < vec_size ? i + (1u << 30) : vec_size;
+        uint32x4_t acc = vdupq_n_u32(0);
+
+        for (; i < block_end; i++) {
+            uint32x4_t mask = vcgtq_f32(vld1q_f32(a + i * 4), vthreshold);
+            acc = vsubq_u32(acc, mask);
+        }
+
+        selected += vaddlvq_u32(acc);
+    }
+
+    // Handle remaining elements
+    for (size_t j = vec_size * 4; j < len; j++) {
+        if (a[j] > threshold) selected++;
+    }
+
+    return make_stats(len, selected);
+}
+
+simd_filter_stats_t simd_selectivity_bits(const uint64_t* bits, size_t len) {
+    return make_stats(len, simd_popcount_bits(bits, len));
+}
@@ -0,0 +1,404 @@
+/**
+ * simd_gradient.c
+ * Implementation of Sobel/Scharr gradients using NEON
+ *
+ * Both operators factor into a smoothing pass along one axis and a central
+ * difference along the other. Every source row is widened, border-extended
+ * and filtered horizontally exactly once into two ring buffers (smoothed and
+ * differenced); output row y then combines ring slots y - 1 .. y + 1, and
+ * magnitude/orientation are derived from the Gx/Gy registers before they
+ * are stored, so the image is read once regardless of the planes requested.
+ */
+#include "simd_gradient.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <arm_neon.h>
+
+/*
+ * Helpers
+ */
+
+// Ring slot holding virtual row v (v may be negative)
+static inline size_t ring_slot(int v) {
+    int s = v % 3;
+    return (size_t)(s < 0 ? s + 3 : s);
+}
+
+// Widen virtual row v to int16 into OUT with one border pixel on each side
+static void extend_row(const uint8_t* src, size_t stride, int width, int height, int v,
+                       simd_border_t border, uint8_t value, int16_t* out) {
+    int sy = simd_border_index(v, height, border);
+    if (sy < 0) {
+        for (int x = 0; x < width + 2; x++) out[x] = value;
+        return;
+    }
+
+    const uint8_t* row = src + (size_t)sy * stride;
+    int16_t* mid = out + 1;
+
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+    for (size_t i = 0; i < vec_size; i++) {
+        vst1q_s16(mid + i * 8, vreinterpretq_s16_u16(vmovl_u8(vld1_u8(row + i * 8))));
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) mid[x] = row[x];
+
+    int left = simd_border_index(-1, width, border);
+    int right = simd_border_index(width, width, border);
+    out[0] = left < 0 ? value : row[left];
+    out[width + 1] = right < 0 ? value : row[right];
+}
+
+// Horizontal pass: SMOOTH = w*IN[x] + c*(IN[x-1] + IN[x+1]), DIFF = IN[x+1] - IN[x-1]
+static void filter_row(const int16_t* in, int16_t* smooth, int16_t* diff, int width, bool scharr) {
+    // Process 8 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        const int16_t* p = in + i * 8;
+        int16x8_t a = vld1q_s16(p);
+        int16x8_t b = vld1q_s16(p + 1);
+        int16x8_t c = vld1q_s16(p + 2);
+        int16x8_t ac = vaddq_s16(a, c);
+        int16x8_t s = scharr ? vmlaq_n_s16(vmulq_n_s16(ac, 3), b, 10) : vaddq_s16(ac, vshlq_n_s16(b, 1));
+        vst1q_s16(smooth + i * 8, s);
+        vst1q_s16(diff + i * 8, vsubq_s16(c, a));
+    }
+
+    // Handle remaining pixels
+    for (int x = (int)(vec_size * 8); x < width; x++) {
+        int ac = in[x] + in[x + 2];
+        smooth[x] = (int16_t)(scharr ? 3 * ac + 10 * in[x + 1] : ac + 2 * in[x + 1]);
+        diff[x] = (int16_t)(in[x + 2] - in[x]);
+    }
+}
+
+/*
+ * Magnitude
+ */
+
+// round(sqrt(n)) for n <= 2^31: the float estimate is off by at most one
+// and is corrected with k^2 - k < n <= k^2 + k
+static inline uint32x4_t rounded_sqrt_u32(uint32x4_t n) {
+    uint32x4_t k = vcvtnq_u32_f32(vsqrtq_f32(vcvtq_f32_u32(n)));
+    uint32x4_t kk = vmulq_u32(k, k);
+    uint32x4_t up = vcgtq_u32(n, vaddq_u32(kk, k));
+    uint32x4_t down = vandq_u32(vcleq_u32(vaddq_u32(n, k), kk), vtstq_u32(k, k));
+    // Masks are all-ones (-1): subtracting adds one, adding subtracts one
+    return vaddq_u32(vsubq_u32(k, up), down);
+}
+
+static inline uint16_t rounded_sqrt_scalar(uint32_t n) {
+    uint32_t k = (uint32_t)lrintf(sqrtf((float)n));
+    if (n > k * k + k) k++;
+    else if (k > 0 && n + k <= k * k) k--;
+    return (uint16_t)k;
+}
+
+static inline uint16x8_t magnitude8(int16x8_t gx, int16x8_t gy, simd_magnitude_t norm) {
+    if (norm == SIMD_MAGNITUDE_L1) {
+        // |-32768| wraps to 0x8000, which is right once read as unsigned
+        return vqaddq_u16(vreinterpretq_u16_s16(vabsq_s16(gx)), vreinterpretq_u16_s16(vabsq_s16(gy)));
+    }
+
+    // Square the magnitudes unsigned: two 2^30 squares at -32768 overflow int32
+    uint16x8_t ax = vreinterpretq_u16_s16(vabsq_s16(gx));
+    uint16x8_t ay = vreinterpretq_u16_s16(vabsq_s16(gy));
+    uint32x4_t lo = vmull_u16(vget_low_u16(ax), vget_low_u16(ax));
+    uint32x4_t hi = vmull_high_u16(ax, ax);
+    lo = vmlal_u16(lo, vget_low_u16(ay), vget_low_u16(ay));
+    hi = vmlal_high_u16(hi, ay, ay);
+    uint32x4_t rlo = rounded_sqrt_u32(lo);
+    uint32x4_t rhi = rounded_sqrt_u32(hi);
+    return vcombine_u16(vmovn_u32(rlo), vmovn_u32(rhi));
+}
+
+static inline uint16_t magnitude1(int gx, int gy, simd_magnitude_t norm) {
+    if (norm == SIMD_MAGNITUDE_L1) {
+        int sum = abs(gx) + abs(gy);
+        return (uint16_t)(sum > UINT16_MAX ? UINT16_MAX : sum);
+    }
+    // Up to 2^31 for -32768: past int, so sum the squares unsigned
+    return rounded_sqrt_scalar((uint32_t)(gx * gx) + (uint32_t)(gy * gy));
+}
+
+/*
+ * Orientation
+ */
+
+// Sector boundaries at (b + 0.5) * 180 / bins degrees, b = 0 .. bins - 1
+typedef struct {
+    int bins;
+    float cos_b[SIMD_GRADIENT_MAX_BINS];
+    float sin_b[SIMD_GRADIENT_MAX_BINS];
+} orientation_table_t;
+
+static void orientation_table_init(orientation_table_t* t, int bins) {
+    const double pi = 3.14159265358979323846;
+    t->bins = bins;
+    for (int b = 0; b < bins; b++) {
+        double phi = (b + 0.5) * pi / bins;
+        double c = cos(phi);
+        double s = sin(phi);
+        // Snap the exactly representable directions (45, 90, 135 degrees)
+        // so gradients lying on them compare as ties
+        if (fabs(c) < 1e-12) c = 0.0;
+        if (fabs(fabs(c) - s) < 1e-12) c = copysign(s, c);
+        t->cos_b[b] = (float)c;
+        t->sin_b[b] = (float)s;
+    }
+}
+
+// After folding (gx, gy) into the upper half plane, the angle reaches
+// boundary phi exactly when gy * cos(phi) >= gx * sin(phi); the bin is the
+// number of boundaries reached (ties go to the upper sector), with a full
+// count wrapping back to 0. A zero gradient reaches every boundary.
+static inline void fold_upper(int32x4_t* x, int32x4_t* y) {
+    uint32x4_t neg = vcltq_s32(*y, vdupq_n_s32(0));
+    *x = vbslq_s32(neg, vnegq_s32(*x), *x);
+    *y = vbslq_s32(neg, vnegq_s32(*y), *y);
+}
+
+static inline uint8x8_t orientation8(int16x8_t gx, int16x8_t gy, const orientation_table_t* t) {
+    // Fold in 32 bits: negating -32768 in 16 bits would wrap
+    int32x4_t gx_lo = vmovl_s16(vget_low_s16(gx));
+    int32x4_t gx_hi = vmovl_high_s16(gx);
+    int32x4_t gy_lo = vmovl_s16(vget_low_s16(gy));
+    int32x4_t gy_hi = vmovl_high_s16(gy);
+    fold_upper(&gx_lo, &gy_lo);
+    fold_upper(&gx_hi, &gy_hi);
+
+    float32x4_t x_lo = vcvtq_f32_s32(gx_lo);
+    float32x4_t x_hi = vcvtq_f32_s32(gx_hi);
+    float32x4_t y_lo = vcvtq_f32_s32(gy_lo);
+    float32x4_t y_hi = vcvtq_f32_s32(gy_hi);
+
+    uint32x4_t count_lo = vdupq_n_u32(0);
+    uint32x4_t count_hi = vdupq_n_u32(0);
+    for (int b = 0; b < t->bins; b++) {
+        float c = t->cos_b[b];
+        float s = t->sin_b[b];
+        count_lo = vsubq_u32(count_lo, vcgeq_f32(vmulq_n_f32(y_lo, c), vmulq_n_f32(x_lo, s)));
+        count_hi = vsubq_u32(count_hi, vcgeq_f32(vmulq_n_f32(y_hi, c), vmulq_n_f32(x_hi, s)));
+    }
+
+    uint16x8_t count = vcombine_u16(vmovn_u32(count_lo), vmovn_u32(count_hi));
+    count = vbicq_u16(count, vceqq_u16(count, vdupq_n_u16((uint16_t)t->bins)));
+    return vmovn_u16(count);
+}
+
+static inline uint8_t orientation1(int gx, int gy, const orientation_table_t* t) {
+    if (gy < 0) {
+        gx = -gx;
+        gy = -gy;
+    }
+    float fx = (float)gx;
+    float fy = (float)gy;
+    int count = 0;
+    for (int b = 0; b < t->bins; b++) {
+        if (fy * t->cos_b[b] >= fx * t->sin_b[b]) count++;
+    }
+    return (uint8_t)(count == t->bins ? 0 : count);
+}
+
+/*
+ * Fused Gradient
+ */
+
+// Output planes with their row strides in bytes; NULL planes are skipped
+typedef struct {
+    uint8_t* gx;
+    size_t gx_stride;
+    uint8_t* gy;
+    size_t gy_stride;
+    uint8_t* magnitude;
+    size_t magnitude_stride;
+    uint8_t* orientation;
+    size_t orientation_stride;
+} gradient_planes_t;
+
+static gradient_planes_t packed_planes(int16_t* gx, int16_t* gy, uint16_t* magnitude, uint8_t* orientation, int width) {
+    gradient_planes_t p = {
+        (uint8_t*)gx, (size_t)width * sizeof(int16_t), (uint8_t*)gy, (size_t)width * sizeof(int16_t),
+        (uint8_t*)magnitude, (size_t)width * sizeof(uint16_t), orientation, (size_t)width
+    };
+    return p;
+}
+
+static void gradient_rows(const uint8_t* src, size_t src_stride, int width, int height, int y0, int y1,
+                          simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                          const gradient_planes_t* planes, simd_magnitude_t norm, int bins) {
+    if (width <= 0 || height <= 0) return;
+    if (y0 < 0) y0 = 0;
+    if (y1 > height) y1 = height;
+    if (y0 >= y1) return;
+    if (planes->orientation && (bins < 1 || bins > SIMD_GRADIENT_MAX_BINS)) return;
+
+    orientation_table_t table;
+    if (planes->orientation) orientation_table_init(&table, bins);
+
+    // Extended row followed by the smoothed and differenced rings
+    int16_t* ext = (int16_t*)neon_malloc(((size_t)width + 2 + 6 * (size_t)width) * sizeof(int16_t));
+    if (!ext) return;
+    int16_t* smooth[3];
+    int16_t* diff[3];
+    for (int i = 0; i < 3; i++) {
+        smooth[i] = ext + width + 2 + (size_t)(2 * i) * width;
+        diff[i] = smooth[i] + width;
+    }
+
+    bool scharr = op == SIMD_GRADIENT_SCHARR;
+    int16_t center = scharr ? 10 : 2;
+    int16_t side = scharr ? 3 : 1;
+
+    // Prime rows y0 - 1 and y0
+    for (int v = y0 - 1; v <= y0; v++) {
+        extend_row(src, src_stride, width, height, v, border, border_value, ext);
+        filter_row(ext, smooth[ring_slot(v)], diff[ring_slot(v)], width, scharr);
+    }
+
+    for (int y = y0; y < y1; y++) {
+        extend_row(src, src_stride, width, height, y + 1, border, border_value, ext);
+        filter_row(ext, smooth[ring_slot(y + 1)], diff[ring_slot(y + 1)], width, scharr);
+
+        const int16_t* s0 = smooth[ring_slot(y - 1)];
+        const int16_t* s2 = smooth[ring_slot(y + 1)];
+        const int16_t* d0 = diff[ring_slot(y - 1)];
+        const int16_t* d1 = diff[ring_slot(y)];
+        const int16_t* d2 = diff[ring_slot(y + 1)];
+        int16_t* gx = planes->gx ? (int16_t*)(planes->gx + (size_t)y * planes->gx_stride) : NULL;
+        int16_t* gy = planes->gy ? (int16_t*)(planes->gy + (size_t)y * planes->gy_stride) : NULL;
+        uint16_t* magnitude = planes->magnitude ?
+            (uint16_t*)(planes->magnitude + (size_t)y * planes->magnitude_stride) : NULL;
+        uint8_t* orientation = planes->orientation ?
+            planes->orientation + (size_t)y * planes->orientation_stride : NULL;
+
+        // Process 8 pixels at a time using NEON
+        size_t vec_size = (size_t)width / 8;
+
+        for (size_t i = 0; i < vec_size; i++) {
+            size_t x = i * 8;
+            int16x8_t outer = vaddq_s16(vld1q_s16(d0 + x), vld1q_s16(d2 + x));
+            int16x8_t vgx = vmlaq_n_s16(vmulq_n_s16(outer, side), vld1q_s16(d1 + x), center);
+            int16x8_t vgy = vsubq_s16(vld1q_s16(s2 + x), vld1q_s16(s0 + x));
+
+            if (gx) vst1q_s16(gx + x, vgx);
+            if (gy) vst1q_s16(gy + x, vgy);
+            if (magnitude) vst1q_u16(magnitude + x, magnitude8(vgx, vgy, norm));
+            if (orientation) vst1_u8(orientation + x, orientation8(vgx, vgy, &table));
+        }
+
+        // Handle remaining pixels
+        for (int x = (int)(vec_size * 8); x < width; x++) {
+            int sgx = side * (d0[x] + d2[x]) + center * d1[x];
+            int sgy = s2[x] - s0[x];
+
+            if (gx) gx[x] = (int16_t)sgx;
+            if (gy) gy[x] = (int16_t)sgy;
+            if (magnitude) magnitude[x] = magnitude1(sgx, sgy, norm);
+            if (orientation) orientation[x] = orientation1(sgx, sgy, &table);
+        }
+    }
+
+    free(ext);
+}
+
+void simd_gradient(const uint8_t* src, int width, int height,
+                   simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                   int16_t* gx, int16_t* gy,
+                   uint16_t* magnitude, simd_magnitude_t norm,
+                   uint8_t* orientation, int bins) {
+    simd_gradient_rows(src, width, height, 0, height, op, border, border_value,
+                       gx, gy, magnitude, norm, orientation, bins);
+}
+
+void simd_gradient_rows(const uint8_t* src, int width, int height, int y0, int y1,
+                        simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                        int16_t* gx, int16_t* gy,
+                        uint16_t* magnitude, simd_magnitude_t norm,
+                        uint8_t* orientation, int bins) {
+    gradient_planes_t planes = packed_planes(gx, gy, magnitude, orientation, width);
+    gradient_rows(src, (size_t)width, width, height, y0, y1, op, border, border_value, &planes, norm, bins);
+}
+
+// NULL output views are skipped; others must match SRC in size
+static bool plane_matches(const simd_image_t* src, const simd_image_t* plane, size_t elem_size) {
+    return !plane || (simd_image_valid(plane, 1, elem_size) &&
+                      plane->width == src->width && plane->height == src->height);
+}
+
+void simd_gradient_view(const simd_image_t* src,
+                        simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                        const simd_image_t* gx, const simd_image_t* gy,
+                        const simd_image_t* magnitude, simd_magnitude_t norm,
+                        const simd_image_t* orientation, int bins) {
+    if (!src) return;
+    simd_gradient_rows_view(src, 0, src->height, op, border, border_value, gx, gy, magnitude, norm, orientation, bins);
+}
+
+void simd_gradient_rows_view(const simd_image_t* src, int y0, int y1,
+                             simd_gradient_op_t op, simd_border_t border, uint8_t border_value,
+                             const simd_image_t* gx, const simd_image_t* gy,
+                             const simd_image_t* magnitude, simd_magnitude_t norm,
+                             const simd_image_t* orientation, int bins) {
+    if (!simd_image_valid(src, 1, 1) || !plane_matches(src, gx, sizeof(int16_t)) ||
+        !plane_matches(src, gy, sizeof(int16_t)) || !plane_matches(src, magnitude, sizeof(uint16_t)) ||
+        !plane_matches(src, orientation, 1)) return;
+
+    gradient_planes_t planes = {
+        gx ? gx->data : NULL, gx ? gx->stride : 0,
+        gy ? gy->data : NULL, gy ? gy->stride : 0,
+        magnitude ? magnitude->data : NULL, magnitude ? magnitude->stride : 0,
+        orientation ? orientation->data : NULL, orientation ? orientation->stride : 0
+    };
+    gradient_rows(src->data, src->stride, src->width, src->height, y0, y1,
+                  op, border, border_value, &planes, norm, bins);
+}
+
+/*
+ * Standalone Operations
+ */
+
+void simd_gradient_xy(const uint8_t* src, int16_t* gx, int16_t* gy, int width, int height,
+                      simd_gradient_op_t op, simd_border_t border, uint8_t border_value) {
+    simd_gradient(src, width, height, op, border, border_value, gx, gy, NULL, SIMD_MAGNITUDE_L1, NULL, 0);
+}
+
+void simd_gradient_magnitude(const int16_t* gx, const int16_t* gy, uint16_t* magnitude,
+                             size_t len, simd_magnitude_t norm) {
+    // Process 8 elements at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        vst1q_u16(magnitude + i * 8, magnitude8(vld1q_s16(gx + i * 8), vld1q_s16(gy + i * 8), norm));
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        magnitude[i] = magnitude1(gx[i], gy[i], norm);
+    }
+}
+
+void simd_gradient_orientation(const int16_t* gx, const int16_t* gy, uint8_t* orientation,
+                               size_t len, int bins) {
+    if (bins < 1 || bins > SIMD_GRADIENT_MAX_BINS) return;
+
+    orientation_table_t table;
+    orientation_table_init(&table, bins);
+
+    // Process 8 elements at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        vst1_u8(orientation + i * 8, orientation8(vld1q_s16(gx + i * 8), vld1q_s16(gy + i * 8), &table));
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        orientation[i] = orientation1(gx[i], gy[i], &table);
+    }
+}
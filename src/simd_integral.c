@@ -0,0 +1,266 @@
+/**
+ * simd_integral.c
+ * Implementation of integral images using NEON
+ *
+ * Each row is prefix-summed in registers with log-step shifts: adding the
+ * vector to itself shifted by 1, 2 and 4 lanes (vextq against zero) turns
+ * 8 lanes into their inclusive scan in three adds. Blocks are chained by a
+ * carried lane broadcast from the previous block, and the vertical pass is
+ * folded in by adding the row above before the store, so the table is
+ * written once and each source pixel is read once.
+ */
+#include "simd_integral.h"
+#include <string.h>
+#include <arm_neon.h>
+
+/*
+ * In-Register Scans
+ */
+
+// Inclusive prefix sum of 8 u16 lanes
+static inline uint16x8_t scan_u16x8(uint16x8_t v) {
+    uint16x8_t zero = vdupq_n_u16(0);
+    v = vaddq_u16(v, vextq_u16(zero, v, 7));
+    v = vaddq_u16(v, vextq_u16(zero, v, 6));
+    v = vaddq_u16(v, vextq_u16(zero, v, 4));
+    return v;
+}
+
+// Inclusive prefix sum of 4 u32 lanes
+static inline uint32x4_t scan_u32x4(uint32x4_t v) {
+    uint32x4_t zero = vdupq_n_u32(0);
+    v = vaddq_u32(v, vextq_u32(zero, v, 3));
+    v = vaddq_u32(v, vextq_u32(zero, v, 2));
+    return v;
+}
+
+// Inclusive prefix sum of 2 f64 lanes
+static inline float64x2_t scan_f64x2(float64x2_t v) {
+    return vaddq_f64(v, vextq_f64(vdupq_n_f64(0.0), v, 1));
+}
+
+// Zero row 0 of a table and return its stride
+static size_t clear_first_row(void* table, size_t elem_size, int width) {
+    size_t stride = (size_t)width + 1;
+    memset(table, 0, stride * elem_size);
+    return stride;
+}
+
+/*
+ * 8-bit Integral Images
+ */
+
+// Table row OUT (width + 1 values) from the row above it, PREV
+static void integral_row_u8(const uint8_t* src, const uint32_t* prev, uint32_t* out, int width) {
+    uint32x4_t carry = vdupq_n_u32(0);
+    out[0] = 0;
+    prev++;
+    out++;
+
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t x = i * 16;
+        uint8x16_t p = vld1q_u8(src + x);
+
+        // Block prefix fits in 16 bits (16 * 255)
+        uint16x8_t lo = scan_u16x8(vmovl_u8(vget_low_u8(p)));
+        uint16x8_t hi = scan_u16x8(vmovl_high_u8(p));
+        hi = vaddq_u16(hi, vdupq_laneq_u16(lo, 7));
+
+        uint32x4_t s0 = vaddw_u16(carry, vget_low_u16(lo));
+        uint32x4_t s1 = vaddw_high_u16(carry, lo);
+        uint32x4_t s2 = vaddw_u16(carry, vget_low_u16(hi));
+        uint32x4_t s3 = vaddw_high_u16(carry, hi);
+        carry = vdupq_laneq_u32(s3, 3);
+
+        vst1q_u32(out + x, vaddq_u32(s0, vld1q_u32(prev + x)));
+        vst1q_u32(out + x + 4, vaddq_u32(s1, vld1q_u32(prev + x + 4)));
+        vst1q_u32(out + x + 8, vaddq_u32(s2, vld1q_u32(prev + x + 8)));
+        vst1q_u32(out + x + 12, vaddq_u32(s3, vld1q_u32(prev + x + 12)));
+    }
+
+    // Handle remaining pixels
+    uint32_t run = vgetq_lane_u32(carry, 0);
+    for (int x = (int)(vec_size * 16); x < width; x++) {
+        run += src[x];
+        out[x] = run + prev[x];
+    }
+}
+
+// Squared-sum row: squares (<= 65025) are scanned in u32 per block and
+// widened into the u64 running total
+static void integral_sq_row_u8(const uint8_t* src, const uint64_t* prev, uint64_t* out, int width) {
+    uint64x2_t carry = vdupq_n_u64(0);
+    out[0] = 0;
+    prev++;
+    out++;
+
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t x = i * 16;
+        uint8x16_t p = vld1q_u8(src + x);
+        uint16x8_t sq_lo = vmull_u8(vget_low_u8(p), vget_low_u8(p));
+        uint16x8_t sq_hi = vmull_high_u8(p, p);
+
+        uint32x4_t q[4];
+        q[0] = scan_u32x4(vmovl_u16(vget_low_u16(sq_lo)));
+        q[1] = vaddq_u32(scan_u32x4(vmovl_high_u16(sq_lo)), vdupq_laneq_u32(q[0], 3));
+        q[2] = vaddq_u32(scan_u32x4(vmovl_u16(vget_low_u16(sq_hi))), vdupq_laneq_u32(q[1], 3));
+        q[3] = vaddq_u32(scan_u32x4(vmovl_high_u16(sq_hi)), vdupq_laneq_u32(q[2], 3));
+
+        for (int k = 0; k < 4; k++) {
+            uint64x2_t a = vaddw_u32(carry, vget_low_u32(q[k]));
+            uint64x2_t b = vaddw_high_u32(carry, q[k]);
+            vst1q_u64(out + x + 4 * k, vaddq_u64(a, vld1q_u64(prev + x + 4 * k)));
+            vst1q_u64(out + x + 4 * k + 2, vaddq_u64(b, vld1q_u64(prev + x + 4 * k + 2)));
+        }
+        carry = vaddw_u32(carry, vdup_laneq_u32(q[3], 3));
+    }
+
+    // Handle remaining pixels
+    uint64_t run = vgetq_lane_u64(carry, 0);
+    for (int x = (int)(vec_size * 16); x < width; x++) {
+        run += (uint32_t)src[x] * src[x];
+        out[x] = run + prev[x];
+    }
+}
+
+static void integral_u8(const uint8_t* src, size_t src_stride, uint32_t* sum, int width, int height) {
+    size_t stride = clear_first_row(sum, sizeof(uint32_t), width);
+    for (int y = 0; y < height; y++) {
+        integral_row_u8(src + (size_t)y * src_stride, sum + (size_t)y * stride, sum + (size_t)(y + 1) * stride, width);
+    }
+}
+
+static void integral_sq_u8(const uint8_t* src, size_t src_stride, uint32_t* sum, uint64_t* sqsum, int width, int height) {
+    size_t stride = clear_first_row(sum, sizeof(uint32_t), width);
+    clear_first_row(sqsum, sizeof(uint64_t), width);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = src + (size_t)y * src_stride;
+        integral_row_u8(row, sum + (size_t)y * stride, sum + (size_t)(y + 1) * stride, width);
+        integral_sq_row_u8(row, sqsum + (size_t)y * stride, sqsum + (size_t)(y + 1) * stride, width);
+    }
+}
+
+/*
+ * Float Integral Images
+ */
+
+// Sum row (and squared-sum row when sq_out is not NULL) in double precision
+static void integral_row_f32(const float* src, const double* prev, double* out,
+                             const double* sq_prev, double* sq_out, int width) {
+    float64x2_t carry = vdupq_n_f64(0.0);
+    float64x2_t sq_carry = vdupq_n_f64(0.0);
+    out[0] = 0.0;
+    prev++;
+    out++;
+    if (sq_out) {
+        sq_out[0] = 0.0;
+        sq_prev++;
+        sq_out++;
+    }
+
+    // Process 4 pixels at a time using NEON
+    size_t vec_size = (size_t)width / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t x = i * 4;
+        float32x4_t p = vld1q_f32(src + x);
+        float64x2_t d0 = vcvt_f64_f32(vget_low_f32(p));
+        float64x2_t d1 = vcvt_high_f64_f32(p);
+
+        if (sq_out) {
+            float64x2_t q0 = scan_f64x2(vmulq_f64(d0, d0));
+            float64x2_t q1 = scan_f64x2(vmulq_f64(d1, d1));
+            q0 = vaddq_f64(q0, sq_carry);
+            q1 = vaddq_f64(q1, vdupq_laneq_f64(q0, 1));
+            sq_carry = vdupq_laneq_f64(q1, 1);
+            vst1q_f64(sq_out + x, vaddq_f64(q0, vld1q_f64(sq_prev + x)));
+            vst1q_f64(sq_out + x + 2, vaddq_f64(q1, vld1q_f64(sq_prev + x + 2)));
+        }
+
+        d0 = vaddq_f64(scan_f64x2(d0), carry);
+        d1 = vaddq_f64(scan_f64x2(d1), vdupq_laneq_f64(d0, 1));
+        carry = vdupq_laneq_f64(d1, 1);
+        vst1q_f64(out + x, vaddq_f64(d0, vld1q_f64(prev + x)));
+        vst1q_f64(out + x + 2, vaddq_f64(d1, vld1q_f64(prev + x + 2)));
+    }
+
+    // Handle remaining pixels
+    double run = vgetq_lane_f64(carry, 0);
+    double sq_run = vgetq_lane_f64(sq_carry, 0);
+    for (int x = (int)(vec_size * 4); x < width; x++) {
+        double v = src[x];
+        run += v;
+        out[x] = run + prev[x];
+        if (sq_out) {
+            sq_run += v * v;
+            sq_out[x] = sq_run + sq_prev[x];
+        }
+    }
+}
+
+static void integral_f32(const uint8_t* src, size_t src_stride, double* sum, int width, int height) {
+    size_t stride = clear_first_row(sum, sizeof(double), width);
+    for (int y = 0; y < height; y++) {
+        integral_row_f32((const float*)(src + (size_t)y * src_stride), sum + (size_t)y * stride,
+                         sum + (size_t)(y + 1) * stride, NULL, NULL, width);
+    }
+}
+
+static void integral_sq_f32(const uint8_t* src, size_t src_stride, double* sum, double* sqsum, int width, int height) {
+    size_t stride = clear_first_row(sum, sizeof(double), width);
+    clear_first_row(sqsum, sizeof(double), width);
+    for (int y = 0; y < height; y++) {
+        integral_row_f32((const float*)(src + (size_t)y * src_stride), sum + (size_t)y * stride,
+                         sum + (size_t)(y + 1) * stride, sqsum + (size_t)y * stride, sqsum + (size_t)(y + 1) * stride, width);
+    }
+}
+
+/*
+ * Public Entry Points
+ */
+
+void simd_integral_u8(const uint8_t* src, uint32_t* sum, int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    integral_u8(src, (size_t)width, sum, width, height);
+}
+
+void simd_integral_sq_u8(const uint8_t* src, uint32_t* sum, uint64_t* sqsum, int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    integral_sq_u8(src, (size_t)width, sum, sqsum, width, height);
+}
+
+void simd_integral_f32(const float* src, double* sum, int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    integral_f32((const uint8_t*)src, (size_t)width * sizeof(float), sum, width, height);
+}
+
+void simd_integral_sq_f32(const float* src, double* sum, double* sqsum, int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    integral_sq_f32((const uint8_t*)src, (size_t)width * sizeof(float), sum, sqsum, width, height);
+}
+
+void simd_integral_u8_view(const simd_image_t* src, uint32_t* sum) {
+    if (!simd_image_valid(src, 1, 1)) return;
+    integral_u8(src->data, src->stride, sum, src->width, src->height);
+}
+
+void simd_integral_sq_u8_view(const simd_image_t* src, uint32_t* sum, uint64_t* sqsum) {
+    if (!simd_image_valid(src, 1, 1)) return;
+    integral_sq_u8(src->data, src->stride, sum, sqsum, src->width, src->height);
+}
+
+void simd_integral_f32_view(const simd_image_t* src, double* sum) {
+    if (!simd_image_valid(src, 1, sizeof(float))) return;
+    integral_f32(src->data, src->stride, sum, src->width, src->height);
+}
+
+void simd_integral_sq_f32_view(const simd_image_t* src, double* sum, double* sqsum) {
+    if (!simd_image_valid(src, 1, sizeof(float))) return;
+    integral_sq_f32(src->data, src->stride, sum, sqsum, src->width, src->height);
+}
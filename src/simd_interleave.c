@@ -0,0 +1,497 @@
+/**
+ * simd_interleave.c
+ * Implementation of zip/unzip kernels using NEON structure loads/stores
+ *
+ * vldNq/vstNq de-interleave or interleave N channels as part of the memory
+ * access itself, so each kernel is one structured load/store per vector.
+ */
+#include "simd_interleave.h"
+#include <math.h>
+#include <arm_neon.h>
+
+/*
+ * Zip / Unzip
+ */
+
+void simd_zip2_f32(const float* a, const float* b, float* out, size_t len) {
+    // Process 4 elements per channel at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 4 elements from each plane
+        float32x4x2_t v;
+        v.val[0] = vld1q_f32(a + i * 4);
+        v.val[1] = vld1q_f32(b + i * 4);
+
+        // Interleaving store: a[i], b[i], ...
+        vst2q_f32(out + i * 8, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        out[i * 2] = a[i];
+        out[i * 2 + 1] = b[i];
+    }
+}
+
+void simd_unzip2_f32(const float* in, float* a, float* b, size_t len) {
+    // Process 4 elements per channel at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        float32x4x2_t v = vld2q_f32(in + i * 8);
+
+        // Store each plane
+        vst1q_f32(a + i * 4, v.val[0]);
+        vst1q_f32(b + i * 4, v.val[1]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        a[i] = in[i * 2];
+        b[i] = in[i * 2 + 1];
+    }
+}
+
+void simd_zip3_f32(const float* a, const float* b, const float* c, float* out, size_t len) {
+    // Process 4 elements per channel at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 4 elements from each plane
+        float32x4x3_t v;
+        v.val[0] = vld1q_f32(a + i * 4);
+        v.val[1] = vld1q_f32(b + i * 4);
+        v.val[2] = vld1q_f32(c + i * 4);
+
+        // Interleaving store: a[i], b[i], c[i], ...
+        vst3q_f32(out + i * 12, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        out[i * 3] = a[i];
+        out[i * 3 + 1] = b[i];
+        out[i * 3 + 2] = c[i];
+    }
+}
+
+void simd_unzip3_f32(const float* in, float* a, float* b, float* c, size_t len) {
+    // Process 4 elements per channel at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        float32x4x3_t v = vld3q_f32(in + i * 12);
+
+        // Store each plane
+        vst1q_f32(a + i * 4, v.val[0]);
+        vst1q_f32(b + i * 4, v.val[1]);
+        vst1q_f32(c + i * 4, v.val[2]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        a[i] = in[i * 3];
+        b[i] = in[i * 3 + 1];
+        c[i] = in[i * 3 + 2];
+    }
+}
+
+void simd_zip4_f32(const float* a, const float* b, const float* c, const float* d, float* out, size_t len) {
+    // Process 4 elements per channel at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 4 elements from each plane
+        float32x4x4_t v;
+        v.val[0] = vld1q_f32(a + i * 4);
+        v.val[1] = vld1q_f32(b + i * 4);
+        v.val[2] = vld1q_f32(c + i * 4);
+        v.val[3] = vld1q_f32(d + i * 4);
+
+        // Interleaving store: a[i], b[i], c[i], d[i], ...
+        vst4q_f32(out + i * 16, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        out[i * 4] = a[i];
+        out[i * 4 + 1] = b[i];
+        out[i * 4 + 2] = c[i];
+        out[i * 4 + 3] = d[i];
+    }
+}
+
+void simd_unzip4_f32(const float* in, float* a, float* b, float* c, float* d, size_t len) {
+    // Process 4 elements per channel at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        float32x4x4_t v = vld4q_f32(in + i * 16);
+
+        // Store each plane
+        vst1q_f32(a + i * 4, v.val[0]);
+        vst1q_f32(b + i * 4, v.val[1]);
+        vst1q_f32(c + i * 4, v.val[2]);
+        vst1q_f32(d + i * 4, v.val[3]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 4; i < len; i++) {
+        a[i] = in[i * 4];
+        b[i] = in[i * 4 + 1];
+        c[i] = in[i * 4 + 2];
+        d[i] = in[i * 4 + 3];
+    }
+}
+
+void simd_zip2_s16(const int16_t* a, const int16_t* b, int16_t* out, size_t len) {
+    // Process 8 elements per channel at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 8 elements from each plane
+        int16x8x2_t v;
+        v.val[0] = vld1q_s16(a + i * 8);
+        v.val[1] = vld1q_s16(b + i * 8);
+
+        // Interleaving store: a[i], b[i], ...
+        vst2q_s16(out + i * 16, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        out[i * 2] = a[i];
+        out[i * 2 + 1] = b[i];
+    }
+}
+
+void simd_unzip2_s16(const int16_t* in, int16_t* a, int16_t* b, size_t len) {
+    // Process 8 elements per channel at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        int16x8x2_t v = vld2q_s16(in + i * 16);
+
+        // Store each plane
+        vst1q_s16(a + i * 8, v.val[0]);
+        vst1q_s16(b + i * 8, v.val[1]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        a[i] = in[i * 2];
+        b[i] = in[i * 2 + 1];
+    }
+}
+
+void simd_zip3_s16(const int16_t* a, const int16_t* b, const int16_t* c, int16_t* out, size_t len) {
+    // Process 8 elements per channel at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 8 elements from each plane
+        int16x8x3_t v;
+        v.val[0] = vld1q_s16(a + i * 8);
+        v.val[1] = vld1q_s16(b + i * 8);
+        v.val[2] = vld1q_s16(c + i * 8);
+
+        // Interleaving store: a[i], b[i], c[i], ...
+        vst3q_s16(out + i * 24, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        out[i * 3] = a[i];
+        out[i * 3 + 1] = b[i];
+        out[i * 3 + 2] = c[i];
+    }
+}
+
+void simd_unzip3_s16(const int16_t* in, int16_t* a, int16_t* b, int16_t* c, size_t len) {
+    // Process 8 elements per channel at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        int16x8x3_t v = vld3q_s16(in + i * 24);
+
+        // Store each plane
+        vst1q_s16(a + i * 8, v.val[0]);
+        vst1q_s16(b + i * 8, v.val[1]);
+        vst1q_s16(c + i * 8, v.val[2]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        a[i] = in[i * 3];
+        b[i] = in[i * 3 + 1];
+        c[i] = in[i * 3 + 2];
+    }
+}
+
+void simd_zip4_s16(const int16_t* a, const int16_t* b, const int16_t* c, const int16_t* d, int16_t* out, size_t len) {
+    // Process 8 elements per channel at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 8 elements from each plane
+        int16x8x4_t v;
+        v.val[0] = vld1q_s16(a + i * 8);
+        v.val[1] = vld1q_s16(b + i * 8);
+        v.val[2] = vld1q_s16(c + i * 8);
+        v.val[3] = vld1q_s16(d + i * 8);
+
+        // Interleaving store: a[i], b[i], c[i], d[i], ...
+        vst4q_s16(out + i * 32, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        out[i * 4] = a[i];
+        out[i * 4 + 1] = b[i];
+        out[i * 4 + 2] = c[i];
+        out[i * 4 + 3] = d[i];
+    }
+}
+
+void simd_unzip4_s16(const int16_t* in, int16_t* a, int16_t* b, int16_t* c, int16_t* d, size_t len) {
+    // Process 8 elements per channel at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        int16x8x4_t v = vld4q_s16(in + i * 32);
+
+        // Store each plane
+        vst1q_s16(a + i * 8, v.val[0]);
+        vst1q_s16(b + i * 8, v.val[1]);
+        vst1q_s16(c + i * 8, v.val[2]);
+        vst1q_s16(d + i * 8, v.val[3]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 8; i < len; i++) {
+        a[i] = in[i * 4];
+        b[i] = in[i * 4 + 1];
+        c[i] = in[i * 4 + 2];
+        d[i] = in[i * 4 + 3];
+    }
+}
+
+void simd_zip2_u8(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t len) {
+    // Process 16 elements per channel at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 16 elements from each plane
+        uint8x16x2_t v;
+        v.val[0] = vld1q_u8(a + i * 16);
+        v.val[1] = vld1q_u8(b + i * 16);
+
+        // Interleaving store: a[i], b[i], ...
+        vst2q_u8(out + i * 32, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 16; i < len; i++) {
+        out[i * 2] = a[i];
+        out[i * 2 + 1] = b[i];
+    }
+}
+
+void simd_unzip2_u8(const uint8_t* in, uint8_t* a, uint8_t* b, size_t len) {
+    // Process 16 elements per channel at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        uint8x16x2_t v = vld2q_u8(in + i * 32);
+
+        // Store each plane
+        vst1q_u8(a + i * 16, v.val[0]);
+        vst1q_u8(b + i * 16, v.val[1]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 16; i < len; i++) {
+        a[i] = in[i * 2];
+        b[i] = in[i * 2 + 1];
+    }
+}
+
+void simd_zip3_u8(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint8_t* out, size_t len) {
+    // Process 16 elements per channel at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 16 elements from each plane
+        uint8x16x3_t v;
+        v.val[0] = vld1q_u8(a + i * 16);
+        v.val[1] = vld1q_u8(b + i * 16);
+        v.val[2] = vld1q_u8(c + i * 16);
+
+        // Interleaving store: a[i], b[i], c[i], ...
+        vst3q_u8(out + i * 48, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 16; i < len; i++) {
+        out[i * 3] = a[i];
+        out[i * 3 + 1] = b[i];
+        out[i * 3 + 2] = c[i];
+    }
+}
+
+void simd_unzip3_u8(const uint8_t* in, uint8_t* a, uint8_t* b, uint8_t* c, size_t len) {
+    // Process 16 elements per channel at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        uint8x16x3_t v = vld3q_u8(in + i * 48);
+
+        // Store each plane
+        vst1q_u8(a + i * 16, v.val[0]);
+        vst1q_u8(b + i * 16, v.val[1]);
+        vst1q_u8(c + i * 16, v.val[2]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 16; i < len; i++) {
+        a[i] = in[i * 3];
+        b[i] = in[i * 3 + 1];
+        c[i] = in[i * 3 + 2];
+    }
+}
+
+void simd_zip4_u8(const uint8_t* a, const uint8_t* b, const uint8_t* c, const uint8_t* d, uint8_t* out, size_t len) {
+    // Process 16 elements per channel at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // Load 16 elements from each plane
+        uint8x16x4_t v;
+        v.val[0] = vld1q_u8(a + i * 16);
+        v.val[1] = vld1q_u8(b + i * 16);
+        v.val[2] = vld1q_u8(c + i * 16);
+        v.val[3] = vld1q_u8(d + i * 16);
+
+        // Interleaving store: a[i], b[i], c[i], d[i], ...
+        vst4q_u8(out + i * 64, v);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 16; i < len; i++) {
+        out[i * 4] = a[i];
+        out[i * 4 + 1] = b[i];
+        out[i * 4 + 2] = c[i];
+        out[i * 4 + 3] = d[i];
+    }
+}
+
+void simd_unzip4_u8(const uint8_t* in, uint8_t* a, uint8_t* b, uint8_t* c, uint8_t* d, size_t len) {
+    // Process 16 elements per channel at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleaving load: val[j] holds channel j
+        uint8x16x4_t v = vld4q_u8(in + i * 64);
+
+        // Store each plane
+        vst1q_u8(a + i * 16, v.val[0]);
+        vst1q_u8(b + i * 16, v.val[1]);
+        vst1q_u8(c + i * 16, v.val[2]);
+        vst1q_u8(d + i * 16, v.val[3]);
+    }
+
+    // Handle remaining elements
+    for (size_t i = vec_size * 16; i < len; i++) {
+        a[i] = in[i * 4];
+        b[i] = in[i * 4 + 1];
+        c[i] = in[i * 4 + 2];
+        d[i] = in[i * 4 + 3];
+    }
+}
+/*
+ * Complex (IQ) Conversions
+ */
+
+void simd_complex_split_f32(const float* iq, float* re, float* im, size_t n) {
+    simd_unzip2_f32(iq, re, im, n);
+}
+
+void simd_complex_merge_f32(const float* re, const float* im, float* iq, size_t n) {
+    simd_zip2_f32(re, im, iq, n);
+}
+
+void simd_complex_split_s16_f32(const int16_t* iq, float* re, float* im, float scale, size_t n) {
+    float32x4_t vscale = vdupq_n_f32(scale);
+
+    // Process 8 complex samples at a time using NEON
+    size_t vec_size = n / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleave 8 I/Q pairs
+        int16x8x2_t v = vld2q_s16(iq + i * 16);
+
+        // Widen to 32-bit, convert to float and scale
+        for (int j = 0; j < 2; j++) {
+            float* dst = (j == 0) ? re : im;
+            float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v.val[j])));
+            float32x4_t hi = vcvtq_f32_s32(vmovl_high_s16(v.val[j]));
+
+            vst1q_f32(dst + i * 8, vmulq_f32(lo, vscale));
+            vst1q_f32(dst + i * 8 + 4, vmulq_f32(hi, vscale));
+        }
+    }
+
+    // Handle remaining samples
+    for (size_t i = vec_size * 8; i < n; i++) {
+        re[i] = iq[i * 2] * scale;
+        im[i] = iq[i * 2 + 1] * scale;
+    }
+}
+
+// Round to nearest and saturate to int16 (scalar tail)
+static inline int16_t saturate_s16(float x) {
+    long v = lrintf(x);
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)v;
+}
+
+void simd_complex_merge_f32_s16(const float* re, const float* im, int16_t* iq, float scale, size_t n) {
+    float32x4_t vscale = vdupq_n_f32(scale);
+
+    // Process 8 complex samples at a time using NEON
+    size_t vec_size = n / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        int16x8x2_t v;
+
+        for (int j = 0; j < 2; j++) {
+            const float* src = (j == 0) ? re : im;
+            float32x4_t lo = vmulq_f32(vld1q_f32(src + i * 8), vscale);
+            float32x4_t hi = vmulq_f32(vld1q_f32(src + i * 8 + 4), vscale);
+
+            // Round to nearest, then narrow with saturation
+            int16x4_t lo16 = vqmovn_s32(vcvtnq_s32_f32(lo));
+            int16x4_t hi16 = vqmovn_s32(vcvtnq_s32_f32(hi));
+            v.val[j] = vcombine_s16(lo16, hi16);
+        }
+
+        // Interleave I/Q on store
+        vst2q_s16(iq + i * 16, v);
+    }
+
+    // Handle remaining samples
+    for (size_t i = vec_size * 8; i < n; i++) {
+        iq[i * 2] = saturate_s16(re[i] * scale);
+        iq[i * 2 + 1] = saturate_s16(im[i] * scale);
+    }
+}
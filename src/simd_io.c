@@ -0,0 +1,332 @@
+/**
+ * simd_io.c
+ * Memory-mapped file access and double-buffered streaming reads
+ *
+ * Whole files are mapped MAP_PRIVATE with PROT_WRITE so kernels can work
+ * in place on copy-on-write pages, and are advised sequential so the
+ * kernel reads ahead aggressively and drops pages behind the cursor.
+ *
+ * Files too large to map comfortably go through the streaming reader: a
+ * reader thread fills two chunk buffers alternately with pread() while the
+ * caller consumes the other one. Buffers change hands under one mutex and
+ * condition variable; each buffer is either being filled, ready, or held
+ * by the caller, so no chunk is copied after it has been read.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "simd_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Mapped Files
+ */
+
+bool simd_map_file(const char* path, simd_mapped_t* file) {
+    file->data = NULL;
+    file->size = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping keeps its own reference to the file
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    file->data = (uint8_t*)map;
+    file->size = (size_t)st.st_size;
+    return true;
+}
+
+void simd_unmap_file(simd_mapped_t* file) {
+    if (file->data) munmap(file->data, file->size);
+    file->data = NULL;
+    file->size = 0;
+}
+
+bool simd_raw_write(const char* path, const void* data, size_t len) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(data, 1, len, f) == len;
+    return fclose(f) == 0 && ok;
+}
+
+/*
+ * PGM/PPM
+ */
+
+// Skip whitespace and '#' comments; false at the end of the buffer
+static bool skip_space(const uint8_t* data, size_t size, size_t* pos) {
+    while (*pos < size) {
+        uint8_t c = data[*pos];
+        if (c == '#') {
+            while (*pos < size && data[*pos] != '\n') (*pos)++;
+        } else if (isspace(c)) {
+            (*pos)++;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool read_uint(const uint8_t* data, size_t size, size_t* pos, int* value) {
+    if (!skip_space(data, size, pos) || data[*pos] < '0' || data[*pos] > '9') return false;
+    long v = 0;
+    while (*pos < size && data[*pos] >= '0' && data[*pos] <= '9') {
+        v = v * 10 + (data[*pos] - '0');
+        if (v > 0x7fffffff) return false;
+        (*pos)++;
+    }
+    *value = (int)v;
+    return true;
+}
+
+// Header fields and size; 0 when invalid (pixel data not checked)
+static size_t pnm_header(const uint8_t* data, size_t size, int* width, int* height, int* channels) {
+    if (size < 2 || data[0] != 'P' || (data[1] != '5' && data[1] != '6')) return 0;
+    size_t pos = 2;
+    int maxval;
+    if (!read_uint(data, size, &pos, width) || !read_uint(data, size, &pos, height) ||
+        !read_uint(data, size, &pos, &maxval)) return 0;
+    if (*width <= 0 || *height <= 0 || maxval <= 0 || maxval > 255) return 0;
+
+    // Exactly one whitespace byte separates the header from the pixels
+    if (pos >= size || !isspace(data[pos])) return 0;
+    *channels = data[1] == '5' ? 1 : 3;
+    return pos + 1;
+}
+
+size_t simd_pnm_parse(const uint8_t* data, size_t size, simd_image_t* image) {
+    int width, height, channels;
+    size_t header = pnm_header(data, size, &width, &height, &channels);
+    if (!header) return 0;
+
+    size_t stride = (size_t)width * channels;
+    if ((size - header) / stride < (size_t)height) return 0;
+    *image = simd_image_make((void*)(data + header), width, height, stride, channels);
+    return header;
+}
+
+bool simd_pnm_map(const char* path, simd_mapped_t* file, simd_image_t* image) {
+    if (!simd_map_file(path, file)) return false;
+    if (simd_pnm_parse(file->data, file->size, image)) return true;
+    simd_unmap_file(file);
+    return false;
+}
+
+bool simd_pnm_write(const char* path, const simd_image_t* image) {
+    if (!simd_image_valid(image, 0, 1) || (image->channels != 1 && image->channels != 3)) return false;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    bool ok = fprintf(f, "P%c\n%d %d\n255\n", image->channels == 1 ? '5' : '6', image->width, image->height) > 0;
+    size_t row_bytes = simd_image_row_bytes(image, 1);
+    if (ok && simd_image_is_packed(image, 1)) {
+        ok = fwrite(image->data, row_bytes, (size_t)image->height, f) == (size_t)image->height;
+    } else {
+        for (int y = 0; ok && y < image->height; y++) {
+            ok = fwrite(simd_image_row(image, y), 1, row_bytes, f) == row_bytes;
+        }
+    }
+    return fclose(f) == 0 && ok;
+}
+
+/*
+ * Streaming Reader
+ */
+
+struct simd_stream {
+    int fd;
+    uint64_t pos;               // Next file offset to read
+    uint64_t end;               // End of the streamed range
+    size_t chunk;
+    uint8_t* buf[2];
+    size_t len[2];
+    bool ready[2];              // Filled and not yet handed out
+    int held;                   // Buffer held by the caller (-1 = none)
+    int next;                   // Buffer the caller receives next
+    bool done;                  // Reader finished (end of file or error)
+    bool failed;
+    bool stop;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t reader;
+};
+
+// Read LEN bytes at OFFSET, retrying short reads
+static bool read_fully(int fd, uint8_t* buf, size_t len, uint64_t offset) {
+    while (len > 0) {
+        ssize_t n = pread(fd, buf, len, (off_t)offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        buf += n;
+        len -= (size_t)n;
+        offset += (uint64_t)n;
+    }
+    return true;
+}
+
+static void* stream_reader(void* arg) {
+    simd_stream_t* s = (simd_stream_t*)arg;
+    int slot = 0;
+
+    pthread_mutex_lock(&s->lock);
+    while (!s->stop && s->pos < s->end) {
+        // Wait until the caller has handed this buffer back
+        while (!s->stop && (s->ready[slot] || s->held == slot)) pthread_cond_wait(&s->cond, &s->lock);
+        if (s->stop) break;
+
+        uint64_t offset = s->pos;
+        size_t len = s->end - offset < s->chunk ? (size_t)(s->end - offset) : s->chunk;
+        s->pos += len;
+        pthread_mutex_unlock(&s->lock);
+
+        bool ok = read_fully(s->fd, s->buf[slot], len, offset);
+
+        pthread_mutex_lock(&s->lock);
+        if (!ok) {
+            s->failed = true;
+            break;
+        }
+        s->len[slot] = len;
+        s->ready[slot] = true;
+        pthread_cond_broadcast(&s->cond);
+        slot ^= 1;
+    }
+    s->done = true;
+    pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+// Stream LENGTH bytes from OFFSET (STREAM_TO_END: the rest of the file);
+// NULL when the file is shorter than a given length
+#define STREAM_TO_END UINT64_MAX
+
+static simd_stream_t* stream_open(const char* path, uint64_t offset, uint64_t length, size_t chunk_size) {
+    if (chunk_size == 0) return NULL;
+
+    simd_stream_t* s = (simd_stream_t*)calloc(1, sizeof(simd_stream_t));
+    if (!s) return NULL;
+    s->fd = open(path, O_RDONLY);
+    struct stat st;
+    if (s->fd < 0 || fstat(s->fd, &st) != 0 ||
+        (length != STREAM_TO_END && (offset > (uint64_t)st.st_size || (uint64_t)st.st_size - offset < length))) {
+        if (s->fd >= 0) close(s->fd);
+        free(s);
+        return NULL;
+    }
+
+    s->pos = offset;
+    s->end = length == STREAM_TO_END ? (uint64_t)st.st_size : offset + length;
+    s->chunk = chunk_size;
+    s->held = -1;
+    s->buf[0] = (uint8_t*)neon_malloc(chunk_size);
+    s->buf[1] = (uint8_t*)neon_malloc(chunk_size);
+    posix_fadvise(s->fd, (off_t)offset, 0, POSIX_FADV_SEQUENTIAL);
+
+    bool ok = s->buf[0] && s->buf[1];
+    if (ok) {
+        pthread_mutex_init(&s->lock, NULL);
+        pthread_cond_init(&s->cond, NULL);
+        if (pthread_create(&s->reader, NULL, stream_reader, s) != 0) {
+            pthread_mutex_destroy(&s->lock);
+            pthread_cond_destroy(&s->cond);
+            ok = false;
+        }
+    }
+    if (!ok) {
+        free(s->buf[0]);
+        free(s->buf[1]);
+        close(s->fd);
+        free(s);
+        return NULL;
+    }
+    return s;
+}
+
+simd_stream_t* simd_stream_open(const char* path, uint64_t offset, size_t chunk_size) {
+    return stream_open(path, offset, STREAM_TO_END, chunk_size);
+}
+
+simd_stream_t* simd_pnm_stream_open(const char* path, int rows, simd_image_t* format) {
+    if (rows <= 0) return NULL;
+
+    // Headers are short; comments beyond the first 4 KiB are not supported
+    uint8_t head[4096];
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    size_t n = fread(head, 1, sizeof(head), f);
+    fclose(f);
+
+    int width, height, channels;
+    size_t header = pnm_header(head, n, &width, &height, &channels);
+    if (!header) return NULL;
+
+    // Exactly the pixel rows: bytes after them (another image, junk) are not
+    // streamed, and a file too short for them is rejected
+    *format = simd_image_make(NULL, width, height, (size_t)width * channels, channels);
+    return stream_open(path, header, (uint64_t)height * format->stride, (size_t)rows * format->stride);
+}
+
+const uint8_t* simd_stream_next(simd_stream_t* s, size_t* len) {
+    pthread_mutex_lock(&s->lock);
+
+    // Hand the previous chunk back to the reader
+    if (s->held >= 0) {
+        s->held = -1;
+        pthread_cond_broadcast(&s->cond);
+    }
+
+    int slot = s->next;
+    while (!s->ready[slot] && !s->done) pthread_cond_wait(&s->cond, &s->lock);
+
+    const uint8_t* data = NULL;
+    if (s->ready[slot]) {
+        s->ready[slot] = false;
+        s->held = slot;
+        s->next = slot ^ 1;
+        *len = s->len[slot];
+        data = s->buf[slot];
+    }
+    pthread_mutex_unlock(&s->lock);
+    return data;
+}
+
+bool simd_stream_failed(const simd_stream_t* s) {
+    return s->failed;
+}
+
+void simd_stream_close(simd_stream_t* s) {
+    if (!s) return;
+
+    pthread_mutex_lock(&s->lock);
+    s->stop = true;
+    pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+    pthread_join(s->reader, NULL);
+
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->cond);
+    free(s->buf[0]);
+    free(s->buf[1]);
+    close(s->fd);
+    free(s);
+}
@@ -0,0 +1,396 @@
+/**
+ * simd_knn.c
+ * Implementation of brute-force k-nearest-neighbor search using NEON
+ *
+ * Every metric is reduced to dot products: cosine indexes hold normalized
+ * vectors and divide by the query norm, and L2 uses
+ * |q - x|^2 = |q|^2 + |x|^2 - 2 q.x with |x|^2 kept per stored vector.
+ * A block of queries then scores the database tile by tile with the
+ * register-blocked simd_dot_many_f32, so each database element is loaded
+ * once per block rather than once per query. Quantized tiles are widened
+ * to f32 into a scratch buffer that stays in L1 for the whole block.
+ *
+ * Each query keeps a bounded max-heap of its k best candidates. Scores are
+ * turned into distances four at a time and compared against the heap's
+ * root; after the first few tiles almost every group of four fails that
+ * test together and costs one compare, so the heap is rarely touched.
+ */
+#include "simd_knn.h"
+#include "simd_batch.h"
+#include "simd_ops.h"
+#include "simd_sched.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <arm_neon.h>
+
+struct simd_knn_index {
+    size_t dim;
+    simd_knn_metric_t metric;
+    simd_knn_storage_t storage;
+    size_t count;
+    size_t capacity;
+    void* data;                 // count x dim elements of the storage type
+    float* scales;              // Int8: the scale of each vector
+    float* norms;               // Squared norm of each stored vector, for L2
+};
+
+static size_t element_bytes(simd_knn_storage_t storage) {
+    return storage == SIMD_KNN_F32 ? 4 : storage == SIMD_KNN_F16 ? 2 : 1;
+}
+
+/*
+ * Bounded Heap
+ * Max-heap on distance: the root is the k-th best so far.
+ */
+
+typedef struct {
+    float* dist;
+    int64_t* id;
+    size_t size;
+    size_t k;
+} heap_t;
+
+static inline float heap_worst(const heap_t* h) {
+    return h->size < h->k ? INFINITY : h->dist[0];
+}
+
+static void sift_down(heap_t* h, size_t i, size_t size) {
+    float d = h->dist[i];
+    int64_t id = h->id[i];
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= size) break;
+        if (child + 1 < size && h->dist[child + 1] > h->dist[child]) child++;
+        if (h->dist[child] <= d) break;
+        h->dist[i] = h->dist[child];
+        h->id[i] = h->id[child];
+        i = child;
+    }
+    h->dist[i] = d;
+    h->id[i] = id;
+}
+
+// Insert a candidate known to beat heap_worst
+static void heap_push(heap_t* h, float d, int64_t id) {
+    if (h->size < h->k) {
+        size_t i = h->size++;
+        while (i > 0 && h->dist[(i - 1) / 2] < d) {
+            h->dist[i] = h->dist[(i - 1) / 2];
+            h->id[i] = h->id[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        h->dist[i] = d;
+        h->id[i] = id;
+    } else {
+        h->dist[0] = d;
+        h->id[0] = id;
+        sift_down(h, 0, h->size);
+    }
+}
+
+// Offer the four distances in D, numbered from ID
+static inline void heap_offer4(heap_t* h, float32x4_t d, int64_t id) {
+    uint32x4_t better = vcltq_f32(d, vdupq_n_f32(heap_worst(h)));
+    if (vmaxvq_u32(better) == 0) return;
+
+    float lanes[4];
+    vst1q_f32(lanes, d);
+    for (int j = 0; j < 4; j++) {
+        if (lanes[j] < heap_worst(h)) heap_push(h, lanes[j], id + j);
+    }
+}
+
+// Sort in place, ascending, and pad to k
+static void heap_finish(heap_t* h, float pad) {
+    for (size_t end = h->size; end > 1; end--) {
+        float d = h->dist[0];
+        int64_t id = h->id[0];
+        h->dist[0] = h->dist[end - 1];
+        h->id[0] = h->id[end - 1];
+        h->dist[end - 1] = d;
+        h->id[end - 1] = id;
+        sift_down(h, 0, end - 1);
+    }
+    for (size_t i = h->size; i < h->k; i++) {
+        h->dist[i] = pad;
+        h->id[i] = -1;
+    }
+}
+
+void simd_knn_select(const float* distances, int64_t* ids, float* best, size_t n, size_t k) {
+    if (!distances || !ids || !best || k == 0) return;
+
+    heap_t h = { best, ids, 0, k };
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        heap_offer4(&h, vld1q_f32(distances + i), (int64_t)i);
+    }
+    for (; i < n; i++) {
+        if (distances[i] < heap_worst(&h)) heap_push(&h, distances[i], (int64_t)i);
+    }
+    heap_finish(&h, INFINITY);
+}
+
+/*
+ * Storage
+ */
+
+simd_knn_index_t* simd_knn_create(size_t dim, simd_knn_metric_t metric, simd_knn_storage_t storage) {
+    if (dim == 0) return NULL;
+    simd_knn_index_t* index = (simd_knn_index_t*)calloc(1, sizeof(simd_knn_index_t));
+    if (!index) return NULL;
+    index->dim = dim;
+    index->metric = metric;
+    index->storage = storage;
+    return index;
+}
+
+void simd_knn_destroy(simd_knn_index_t* index) {
+    if (!index) return;
+    free(index->data);
+    free(index->scales);
+    free(index->norms);
+    free(index);
+}
+
+size_t simd_knn_size(const simd_knn_index_t* index) {
+    return index ? index->count : 0;
+}
+
+size_t simd_knn_bytes(const simd_knn_index_t* index) {
+    if (!index) return 0;
+    size_t bytes = index->count * index->dim * element_bytes(index->storage);
+    if (index->storage == SIMD_KNN_INT8) bytes += index->count * sizeof(float);
+    return bytes;
+}
+
+// Move the arrays to room for CAPACITY vectors
+static bool reserve(simd_knn_index_t* index, size_t capacity) {
+    size_t row = index->dim * element_bytes(index->storage);
+    void* data = neon_malloc(capacity * row);
+    float* scales = (float*)neon_malloc(capacity * sizeof(float));
+    float* norms = (float*)neon_malloc(capacity * sizeof(float));
+    if (!data || !scales || !norms) {
+        free(data);
+        free(scales);
+        free(norms);
+        return false;
+    }
+    if (index->count) {
+        memcpy(data, index->data, index->count * row);
+        memcpy(scales, index->scales, index->count * sizeof(float));
+        memcpy(norms, index->norms, index->count * sizeof(float));
+    }
+    free(index->data);
+    free(index->scales);
+    free(index->norms);
+    index->data = data;
+    index->scales = scales;
+    index->norms = norms;
+    index->capacity = capacity;
+    return true;
+}
+
+// Widen N stored vectors starting at FIRST into OUT
+static void load_f32(const simd_knn_index_t* index, size_t first, size_t n, float* out) {
+    size_t dim = index->dim;
+
+    if (index->storage == SIMD_KNN_F16) {
+        // Rows are contiguous, so the tile is one flat run of halves
+        const float16_t* src = (const float16_t*)index->data + first * dim;
+        size_t len = n * dim, i = 0;
+        for (; i + 8 <= len; i += 8) {
+            vst1q_f32(out + i, vcvt_f32_f16(vld1_f16(src + i)));
+            vst1q_f32(out + i + 4, vcvt_f32_f16(vld1_f16(src + i + 4)));
+        }
+        for (; i < len; i++) out[i] = (float)src[i];
+        return;
+    }
+
+    for (size_t r = 0; r < n; r++) {
+        const int8_t* src = (const int8_t*)index->data + (first + r) * dim;
+        float* dst = out + r * dim;
+        float scale = index->scales[first + r];
+        size_t i = 0;
+        for (; i + 16 <= dim; i += 16) {
+            int8x16_t v = vld1q_s8(src + i);
+            int16x8_t lo = vmovl_s8(vget_low_s8(v));
+            int16x8_t hi = vmovl_s8(vget_high_s8(v));
+            vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(lo))), scale));
+            vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(lo))), scale));
+            vst1q_f32(dst + i + 8, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(hi))), scale));
+            vst1q_f32(dst + i + 12, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(hi))), scale));
+        }
+        for (; i < dim; i++) dst[i] = (float)src[i] * scale;
+    }
+}
+
+// Quantize one vector into slot SLOT
+static void store(simd_knn_index_t* index, const float* v, size_t slot) {
+    size_t dim = index->dim, i = 0;
+
+    if (index->storage == SIMD_KNN_F32) {
+        memcpy((float*)index->data + slot * dim, v, dim * sizeof(float));
+    } else if (index->storage == SIMD_KNN_F16) {
+        float16_t* dst = (float16_t*)index->data + slot * dim;
+        for (; i + 4 <= dim; i += 4) vst1_f16(dst + i, vcvt_f16_f32(vld1q_f32(v + i)));
+        for (; i < dim; i++) dst[i] = (float16_t)v[i];
+    } else {
+        int8_t* dst = (int8_t*)index->data + slot * dim;
+        float32x4_t vmax = vdupq_n_f32(0.0f);
+        for (; i + 4 <= dim; i += 4) vmax = vmaxq_f32(vmax, vabsq_f32(vld1q_f32(v + i)));
+        float max = vmaxvq_f32(vmax);
+        for (; i < dim; i++) max = fabsf(v[i]) > max ? fabsf(v[i]) : max;
+
+        float scale = max / 127.0f;
+        float inv = max > 0.0f ? 127.0f / max : 0.0f;
+        index->scales[slot] = scale;
+        for (i = 0; i + 8 <= dim; i += 8) {
+            int32x4_t lo = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(v + i), inv));
+            int32x4_t hi = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(v + i + 4), inv));
+            vst1_s8(dst + i, vqmovn_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi))));
+        }
+        for (; i < dim; i++) dst[i] = (int8_t)lrintf(v[i] * inv);
+    }
+}
+
+bool simd_knn_add(simd_knn_index_t* index, const float* vectors, size_t n) {
+    if (!index || (!vectors && n > 0)) return false;
+    size_t dim = index->dim;
+
+    if (index->count + n > index->capacity) {
+        size_t capacity = index->capacity ? index->capacity : 1024;
+        while (capacity < index->count + n) capacity *= 2;
+        if (!reserve(index, capacity)) return false;
+    }
+
+    float* row = (float*)neon_malloc(dim * sizeof(float));
+    if (!row) return false;
+
+    for (size_t r = 0; r < n; r++) {
+        const float* v = vectors + r * dim;
+        size_t slot = index->count + r;
+        if (index->metric == SIMD_KNN_COSINE) {
+            float norm = sqrtf(simd_dot_product_f32(v, v, dim));
+            float inv = norm > 0.0f ? 1.0f / norm : 0.0f;
+            for (size_t i = 0; i < dim; i++) row[i] = v[i] * inv;
+            v = row;
+        }
+        store(index, v, slot);
+
+        // Norms of what will be scored, after quantization
+        if (index->storage != SIMD_KNN_F32) {
+            load_f32(index, slot, 1, row);
+            v = row;
+        }
+        index->norms[slot] = simd_dot_product_f32(v, v, dim);
+    }
+    index->count += n;
+    free(row);
+    return true;
+}
+
+/*
+ * Search
+ */
+
+typedef struct {
+    const simd_knn_index_t* index;
+    const float* queries;
+    int64_t* ids;
+    float* scores;
+    size_t k;
+    size_t tile;                // Database vectors per tile
+    atomic_int failed;
+} search_t;
+
+// Score one tile row for query R of the block and offer it to its heap
+static void offer_row(const search_t* s, heap_t* h, const float* dots, size_t first, size_t n,
+                      float qnorm, float qscale) {
+    const float* norms = s->index->norms + first;
+    bool l2 = s->index->metric == SIMD_KNN_L2;
+    float32x4_t vqn = vdupq_n_f32(qnorm);
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    size_t j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        float32x4_t dot = vld1q_f32(dots + j);
+        float32x4_t d = l2 ? vmaxq_f32(vmlsq_n_f32(vaddq_f32(vld1q_f32(norms + j), vqn), dot, 2.0f), zero) :
+                             vnegq_f32(vmulq_n_f32(dot, qscale));
+        heap_offer4(h, d, (int64_t)(first + j));
+    }
+    for (; j < n; j++) {
+        float d = l2 ? fmaxf(norms[j] + qnorm - 2.0f * dots[j], 0.0f) : -(dots[j] * qscale);
+        if (d < heap_worst(h)) heap_push(h, d, (int64_t)(first + j));
+    }
+}
+
+static void search_block(const search_t* s, size_t q0, size_t nb, float* tile, float* dots) {
+    const simd_knn_index_t* index = s->index;
+    size_t dim = index->dim;
+    const float* block = s->queries + q0 * dim;
+    float qnorm[SIMD_KNN_QUERY_BLOCK];
+    float qscale[SIMD_KNN_QUERY_BLOCK];
+    heap_t heaps[SIMD_KNN_QUERY_BLOCK];
+
+    // Each heap lives in its query's slice of the outputs
+    for (size_t r = 0; r < nb; r++) {
+        qnorm[r] = simd_dot_product_f32(block + r * dim, block + r * dim, dim);
+        qscale[r] = 1.0f;
+        if (index->metric == SIMD_KNN_COSINE) qscale[r] = qnorm[r] > 0.0f ? 1.0f / sqrtf(qnorm[r]) : 0.0f;
+        heaps[r].dist = s->scores + (q0 + r) * s->k;
+        heaps[r].id = s->ids + (q0 + r) * s->k;
+        heaps[r].size = 0;
+        heaps[r].k = s->k;
+    }
+
+    for (size_t first = 0; first < index->count; first += s->tile) {
+        size_t n = index->count - first < s->tile ? index->count - first : s->tile;
+        const float* vectors = tile;
+        if (index->storage == SIMD_KNN_F32) vectors = (const float*)index->data + first * dim;
+        else load_f32(index, first, n, tile);
+
+        simd_dot_many_f32(block, vectors, dots, nb, n, dim);
+        for (size_t r = 0; r < nb; r++) {
+            offer_row(s, &heaps[r], dots + r * n, first, n, qnorm[r], qscale[r]);
+        }
+    }
+
+    // Distances back to scores: negated again for the similarity metrics
+    for (size_t r = 0; r < nb; r++) {
+        heap_finish(&heaps[r], INFINITY);
+        if (index->metric == SIMD_KNN_L2) continue;
+        for (size_t i = 0; i < s->k; i++) heaps[r].dist[i] = -heaps[r].dist[i];
+    }
+}
+
+static void search_range(void* ctx, size_t begin, size_t end) {
+    search_t* s = (search_t*)ctx;
+    size_t dim = s->index->dim;
+    float* tile = (float*)neon_malloc(s->tile * dim * sizeof(float));
+    float* dots = (float*)neon_malloc(SIMD_KNN_QUERY_BLOCK * s->tile * sizeof(float));
+    if (!tile || !dots) {
+        atomic_store(&s->failed, 1);
+    } else {
+        for (size_t q0 = begin; q0 < end; q0 += SIMD_KNN_QUERY_BLOCK) {
+            size_t nb = end - q0 < SIMD_KNN_QUERY_BLOCK ? end - q0 : SIMD_KNN_QUERY_BLOCK;
+            search_block(s, q0, nb, tile, dots);
+        }
+    }
+    free(tile);
+    free(dots);
+}
+
+bool simd_knn_search(const simd_knn_index_t* index, const float* queries, int64_t* ids, float* scores,
+                     size_t nq, size_t k) {
+    if (!index || !queries || !ids || !scores || k == 0) return false;
+
+    size_t tile = SIMD_KNN_TILE_BYTES / (index->dim * sizeof(float));
+    tile = tile < 4 ? 4 : tile & ~(size_t)3;
+
+    search_t s = { index, queries, ids, scores, k, tile, 0 };
+    simd_parallel_for(0, nq, SIMD_KNN_QUERY_BLOCK, search_range, &s);
+    return atomic_load(&s.failed) == 0;
+}
@@ -0,0 +1,264 @@
+/**
+ * simd_lut.c
+ * Implementation of lookup tables and point operations using NEON
+ *
+ * A 256-byte table fits in sixteen q registers, which vqtbl4q_u8 indexes
+ * 64 bytes at a time. The first lookup uses vqtbl4q (out-of-range indices
+ * give 0); each later quarter subtracts 64 from the indices and uses
+ * vqtbx4q, which leaves out-of-range lanes untouched, so every byte picks
+ * up exactly one table entry.
+ *
+ * Per-channel tables would need 48 registers for RGB, so interleaved
+ * pixels are deinterleaved into an L1-resident planar block, each plane is
+ * mapped with its own table held in registers, and the block is
+ * reinterleaved.
+ */
+#include "simd_lut.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <arm_neon.h>
+
+// Pixels per planar block of the per-channel lookup
+#define LUT_BLOCK 256
+
+/*
+ * Table Lookup
+ */
+
+typedef struct {
+    uint8x16x4_t q[4];
+} lut_tables_t;
+
+static inline lut_tables_t lut_load(const uint8_t* lut) {
+    lut_tables_t t;
+    for (int i = 0; i < 4; i++) t.q[i] = vld1q_u8_x4(lut + i * 64);
+    return t;
+}
+
+static inline uint8x16_t lut_lookup(const lut_tables_t* t, uint8x16_t idx) {
+    const uint8x16_t step = vdupq_n_u8(64);
+    uint8x16_t r = vqtbl4q_u8(t->q[0], idx);
+    idx = vsubq_u8(idx, step);
+    r = vqtbx4q_u8(r, t->q[1], idx);
+    idx = vsubq_u8(idx, step);
+    r = vqtbx4q_u8(r, t->q[2], idx);
+    idx = vsubq_u8(idx, step);
+    return vqtbx4q_u8(r, t->q[3], idx);
+}
+
+void simd_lut_u8(const uint8_t* src, const uint8_t* lut, uint8_t* dst, size_t len) {
+    lut_tables_t t = lut_load(lut);
+
+    // Process 16 bytes at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 16;
+        vst1q_u8(dst + j, lut_lookup(&t, vld1q_u8(src + j)));
+    }
+
+    // Handle remaining bytes
+    for (size_t j = vec_size * 16; j < len; j++) {
+        dst[j] = lut[src[j]];
+    }
+}
+
+void simd_lut_channels_u8(const uint8_t* src, const uint8_t* luts, uint8_t* dst, size_t pixel_count, int channels) {
+    if (channels == 1) {
+        simd_lut_u8(src, luts, dst, pixel_count);
+        return;
+    }
+    if (channels != 3 && channels != 4) return;
+
+    uint8_t planes[4][LUT_BLOCK];
+    size_t vec_pixels = pixel_count / 16 * 16;
+
+    for (size_t p0 = 0; p0 < vec_pixels; p0 += LUT_BLOCK) {
+        size_t n = vec_pixels - p0 < LUT_BLOCK ? vec_pixels - p0 : LUT_BLOCK;
+        const uint8_t* in = src + p0 * channels;
+        uint8_t* out = dst + p0 * channels;
+
+        // Deinterleave the block
+        for (size_t j = 0; j < n; j += 16) {
+            if (channels == 3) {
+                uint8x16x3_t v = vld3q_u8(in + j * 3);
+                for (int c = 0; c < 3; c++) vst1q_u8(planes[c] + j, v.val[c]);
+            } else {
+                uint8x16x4_t v = vld4q_u8(in + j * 4);
+                for (int c = 0; c < 4; c++) vst1q_u8(planes[c] + j, v.val[c]);
+            }
+        }
+
+        // Map each plane with its own table
+        for (int c = 0; c < channels; c++) {
+            lut_tables_t t = lut_load(luts + c * 256);
+            for (size_t j = 0; j < n; j += 16) {
+                vst1q_u8(planes[c] + j, lut_lookup(&t, vld1q_u8(planes[c] + j)));
+            }
+        }
+
+        // Reinterleave
+        for (size_t j = 0; j < n; j += 16) {
+            if (channels == 3) {
+                uint8x16x3_t v;
+                for (int c = 0; c < 3; c++) v.val[c] = vld1q_u8(planes[c] + j);
+                vst3q_u8(out + j * 3, v);
+            } else {
+                uint8x16x4_t v;
+                for (int c = 0; c < 4; c++) v.val[c] = vld1q_u8(planes[c] + j);
+                vst4q_u8(out + j * 4, v);
+            }
+        }
+    }
+
+    // Handle remaining pixels
+    for (size_t i = vec_pixels * channels; i < pixel_count * channels; i++) {
+        dst[i] = luts[(i % channels) * 256 + src[i]];
+    }
+}
+
+/*
+ * Table Builders
+ */
+
+static inline uint8_t saturate_u8(float v) {
+    if (v <= 0.0f) return 0;
+    if (v >= 255.0f) return 255;
+    return (uint8_t)(v + 0.5f);
+}
+
+void simd_lut_gamma(uint8_t* lut, float gamma) {
+    for (int i = 0; i < 256; i++) {
+        lut[i] = saturate_u8(255.0f * powf((float)i / 255.0f, gamma));
+    }
+}
+
+void simd_lut_linear(uint8_t* lut, float contrast, float brightness) {
+    for (int i = 0; i < 256; i++) {
+        lut[i] = saturate_u8(contrast * (float)i + brightness);
+    }
+}
+
+void simd_lut_threshold(uint8_t* lut, uint8_t threshold, uint8_t max_value) {
+    for (int i = 0; i < 256; i++) {
+        lut[i] = i > threshold ? max_value : 0;
+    }
+}
+
+void simd_lut_multi_threshold(uint8_t* lut, const uint8_t* thresholds, const uint8_t* levels, int count) {
+    int k = 0;
+    for (int i = 0; i < 256; i++) {
+        while (k < count && thresholds[k] <= i) k++;
+        lut[i] = levels[k];
+    }
+}
+
+void simd_lut_equalize(const uint32_t* histogram, uint8_t* lut) {
+    uint64_t total = 0;
+    for (int i = 0; i < 256; i++) total += histogram[i];
+
+    // First occupied bin maps to 0 and the last to 255
+    int first = 0;
+    while (first < 256 && histogram[first] == 0) first++;
+    if (first == 256 || histogram[first] == total) {
+        for (int i = 0; i < 256; i++) lut[i] = (uint8_t)i;
+        return;
+    }
+
+    uint64_t cdf_min = histogram[first];
+    uint64_t range = total - cdf_min;
+    uint64_t cdf = 0;
+    for (int i = 0; i < 256; i++) {
+        cdf += histogram[i];
+        lut[i] = cdf <= cdf_min ? 0 : (uint8_t)(((cdf - cdf_min) * 255 + range / 2) / range);
+    }
+}
+
+/*
+ * Point Operations
+ */
+
+void simd_gamma_u8(const uint8_t* src, float gamma, uint8_t* dst, size_t len) {
+    uint8_t lut[256];
+    simd_lut_gamma(lut, gamma);
+    simd_lut_u8(src, lut, dst, len);
+}
+
+void simd_contrast_u8(const uint8_t* src, float contrast, float brightness, uint8_t* dst, size_t len) {
+    uint8_t lut[256];
+    simd_lut_linear(lut, contrast, brightness);
+    simd_lut_u8(src, lut, dst, len);
+}
+
+void simd_multi_threshold_u8(const uint8_t* src, const uint8_t* thresholds, const uint8_t* levels, int count,
+                             uint8_t* dst, size_t len) {
+    if (count < 0 || count > 255) return;
+    uint8_t lut[256];
+    simd_lut_multi_threshold(lut, thresholds, levels, count);
+    simd_lut_u8(src, lut, dst, len);
+}
+
+void simd_threshold_u8(const uint8_t* src, uint8_t threshold, uint8_t max_value, uint8_t* dst, size_t len) {
+    uint8x16_t vt = vdupq_n_u8(threshold);
+    uint8x16_t vmax = vdupq_n_u8(max_value);
+
+    // Process 16 bytes at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 16;
+        vst1q_u8(dst + j, vandq_u8(vcgtq_u8(vld1q_u8(src + j), vt), vmax));
+    }
+
+    // Handle remaining bytes
+    for (size_t j = vec_size * 16; j < len; j++) {
+        dst[j] = src[j] > threshold ? max_value : 0;
+    }
+}
+
+/*
+ * Strided Views
+ */
+
+// Views of equal size and channel count (CHANNELS = 0 accepts any)
+static bool views_match(const simd_image_t* src, const simd_image_t* dst, int channels) {
+    return simd_image_valid(src, channels, 1) && simd_image_valid(dst, src->channels, 1) &&
+           src->width == dst->width && src->height == dst->height;
+}
+
+void simd_lut_u8_view(const simd_image_t* src, const uint8_t* lut, const simd_image_t* dst) {
+    if (!views_match(src, dst, 0)) return;
+    if (simd_image_is_packed(src, 1) && simd_image_is_packed(dst, 1)) {
+        simd_lut_u8(src->data, lut, dst->data, simd_image_row_bytes(src, 1) * src->height);
+        return;
+    }
+    for (int y = 0; y < src->height; y++) {
+        simd_lut_u8((const uint8_t*)simd_image_row(src, y), lut, (uint8_t*)simd_image_row(dst, y),
+                    simd_image_row_bytes(src, 1));
+    }
+}
+
+void simd_lut_channels_u8_view(const simd_image_t* src, const uint8_t* luts, const simd_image_t* dst) {
+    if (!views_match(src, dst, 0)) return;
+    if (simd_image_is_packed(src, 1) && simd_image_is_packed(dst, 1)) {
+        simd_lut_channels_u8(src->data, luts, dst->data, (size_t)src->width * src->height, src->channels);
+        return;
+    }
+    for (int y = 0; y < src->height; y++) {
+        simd_lut_channels_u8((const uint8_t*)simd_image_row(src, y), luts, (uint8_t*)simd_image_row(dst, y),
+                             (size_t)src->width, src->channels);
+    }
+}
+
+void simd_threshold_u8_view(const simd_image_t* src, uint8_t threshold, uint8_t max_value, const simd_image_t* dst) {
+    if (!views_match(src, dst, 0)) return;
+    if (simd_image_is_packed(src, 1) && simd_image_is_packed(dst, 1)) {
+        simd_threshold_u8(src->data, threshold, max_value, dst->data, simd_image_row_bytes(src, 1) * src->height);
+        return;
+    }
+    for (int y = 0; y < src->height; y++) {
+        simd_threshold_u8((const uint8_t*)simd_image_row(src, y), threshold, max_value,
+                          (uint8_t*)simd_image_row(dst, y), simd_image_row_bytes(src, 1));
+    }
+}
@@ -0,0 +1,381 @@
+/**
+ * simd_median.c
+ * Implementation of median filtering using NEON
+ *
+ * Small windows use sorting networks of vminq_u8/vmaxq_u8 pairs, each
+ * vector holding the same window tap for 16 neighbouring pixels. The 3x3
+ * filter sorts every column triple once per row and finishes with the
+ * max-of-lows / median-of-mids / min-of-highs reduction; the 5x5 filter
+ * runs Devillard's 99-exchange median network over all 25 taps.
+ *
+ * Larger windows use Perreault and Hebert's constant-time median: one
+ * 256-bin histogram per column is slid down the band, and the window
+ * histogram is slid along the row by adding one column histogram and
+ * removing another. Histograms are split into 16 coarse bins (the high
+ * nibble) and 16 fine segments; only the coarse bins are kept up to date
+ * for every pixel, while a fine segment is brought forward lazily when the
+ * median lands in it. All histogram arithmetic is vaddq_u16/vsubq_u16 on
+ * 16-bin blocks.
+ */
+#include "simd_median.h"
+#include "simd_parallel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <arm_neon.h>
+
+typedef struct {
+    const uint8_t* src;
+    size_t src_stride;
+    uint8_t* dst;
+    size_t dst_stride;
+    int width;
+    int height;
+    int radius;
+    uint8_t* scratch[SIMD_PARALLEL_MAX_THREADS];
+} median_ctx_t;
+
+static inline int clamp_index(int i, int n) {
+    return i < 0 ? 0 : (i >= n ? n - 1 : i);
+}
+
+// Copy source row clamp(y) into DST with R replicated pixels on each side
+static void pad_row(const median_ctx_t* c, int y, uint8_t* dst) {
+    int r = c->radius;
+    const uint8_t* row = c->src + (size_t)clamp_index(y, c->height) * c->src_stride;
+    memset(dst, row[0], (size_t)r);
+    memcpy(dst + r, row, (size_t)c->width);
+    memset(dst + r + c->width, row[c->width - 1], (size_t)r);
+}
+
+// Ring slot holding padded row Y (rows y - r .. y + r are resident)
+static inline uint8_t* ring_row(uint8_t* ring, int y, int n, size_t pitch) {
+    return ring + (size_t)(((y % n) + n) % n) * pitch;
+}
+
+// Median of the window at padded column X, used for images under 16 pixels wide
+static uint8_t median_scalar(uint8_t* const* rows, int r, int x) {
+    uint8_t v[25];
+    int n = 2 * r + 1;
+    int count = 0;
+
+    for (int j = 0; j < n; j++) {
+        for (int i = 0; i < n; i++) {
+            uint8_t p = rows[j][x + i];
+            int k = count++;
+            while (k > 0 && v[k - 1] > p) {
+                v[k] = v[k - 1];
+                k--;
+            }
+            v[k] = p;
+        }
+    }
+    return v[count / 2];
+}
+
+/*
+ * 3x3 Sorting Network
+ */
+
+#define SORT2(a, b) do { uint8x16_t t_ = vminq_u8(a, b); b = vmaxq_u8(a, b); a = t_; } while (0)
+
+static inline uint8x16_t med3_u8x16(uint8x16_t a, uint8x16_t b, uint8x16_t c) {
+    return vmaxq_u8(vminq_u8(a, b), vminq_u8(vmaxq_u8(a, b), c));
+}
+
+static inline uint8_t med3_u8(uint8_t a, uint8_t b, uint8_t c) {
+    uint8_t lo = a < b ? a : b;
+    uint8_t hi = a < b ? b : a;
+    return hi < c ? hi : (lo > c ? lo : c);
+}
+
+static void median3_band(void* arg, int band, int y0, int y1) {
+    median_ctx_t* c = (median_ctx_t*)arg;
+    int w = c->width;
+    size_t pitch = (size_t)w + 2;
+
+    // Three padded rows, then the sorted column triples of the current row
+    uint8_t* ring = c->scratch[band];
+    uint8_t* lo = ring + 3 * pitch;
+    uint8_t* mid = lo + pitch;
+    uint8_t* hi = mid + pitch;
+
+    pad_row(c, y0 - 1, ring_row(ring, y0 - 1, 3, pitch));
+    pad_row(c, y0, ring_row(ring, y0, 3, pitch));
+
+    for (int y = y0; y < y1; y++) {
+        pad_row(c, y + 1, ring_row(ring, y + 1, 3, pitch));
+        const uint8_t* a = ring_row(ring, y - 1, 3, pitch);
+        const uint8_t* b = ring_row(ring, y, 3, pitch);
+        const uint8_t* d = ring_row(ring, y + 1, 3, pitch);
+        uint8_t* out = c->dst + (size_t)y * c->dst_stride;
+
+        // Sort each column: process 16 columns at a time using NEON
+        size_t vec_size = pitch / 16;
+
+        for (size_t i = 0; i < vec_size; i++) {
+            size_t j = i * 16;
+            uint8x16_t p0 = vld1q_u8(a + j);
+            uint8x16_t p1 = vld1q_u8(b + j);
+            uint8x16_t p2 = vld1q_u8(d + j);
+            SORT2(p0, p1);
+            SORT2(p1, p2);
+            SORT2(p0, p1);
+            vst1q_u8(lo + j, p0);
+            vst1q_u8(mid + j, p1);
+            vst1q_u8(hi + j, p2);
+        }
+
+        // Handle remaining columns
+        for (size_t j = vec_size * 16; j < pitch; j++) {
+            uint8_t p0 = a[j] < b[j] ? a[j] : b[j];
+            uint8_t p1 = a[j] < b[j] ? b[j] : a[j];
+            uint8_t p2 = d[j];
+            lo[j] = p0 < p2 ? p0 : p2;
+            hi[j] = p1 > p2 ? p1 : p2;
+            mid[j] = med3_u8(a[j], b[j], d[j]);
+        }
+
+        if (w < 16) {
+            for (int x = 0; x < w; x++) {
+                uint8_t l = lo[x] > lo[x + 1] ? lo[x] : lo[x + 1];
+                l = l > lo[x + 2] ? l : lo[x + 2];
+                uint8_t h = hi[x] < hi[x + 1] ? hi[x] : hi[x + 1];
+                h = h < hi[x + 2] ? h : hi[x + 2];
+                out[x] = med3_u8(l, med3_u8(mid[x], mid[x + 1], mid[x + 2]), h);
+            }
+            continue;
+        }
+
+        // Median = med3(max of lows, median of mids, min of highs); the
+        // last block overlaps the previous one instead of a scalar tail
+        for (int x = 0; x < w; x += 16) {
+            int j = x + 16 <= w ? x : w - 16;
+            uint8x16_t l = vmaxq_u8(vmaxq_u8(vld1q_u8(lo + j), vld1q_u8(lo + j + 1)), vld1q_u8(lo + j + 2));
+            uint8x16_t h = vminq_u8(vminq_u8(vld1q_u8(hi + j), vld1q_u8(hi + j + 1)), vld1q_u8(hi + j + 2));
+            uint8x16_t m = med3_u8x16(vld1q_u8(mid + j), vld1q_u8(mid + j + 1), vld1q_u8(mid + j + 2));
+            vst1q_u8(out + j, med3_u8x16(l, m, h));
+        }
+    }
+}
+
+/*
+ * 5x5 Sorting Network
+ */
+
+// Devillard's opt_med25: leaves the median of P[0..24] in P[12]
+static inline uint8x16_t median25_u8x16(uint8x16_t* p) {
+    SORT2(p[0], p[1]); SORT2(p[3], p[4]); SORT2(p[2], p[4]); SORT2(p[2], p[3]); SORT2(p[6], p[7]);
+    SORT2(p[5], p[7]); SORT2(p[5], p[6]); SORT2(p[9], p[10]); SORT2(p[8], p[10]); SORT2(p[8], p[9]);
+    SORT2(p[12], p[13]); SORT2(p[11], p[13]); SORT2(p[11], p[12]); SORT2(p[15], p[16]); SORT2(p[14], p[16]);
+    SORT2(p[14], p[15]); SORT2(p[18], p[19]); SORT2(p[17], p[19]); SORT2(p[17], p[18]); SORT2(p[21], p[22]);
+    SORT2(p[20], p[22]); SORT2(p[20], p[21]); SORT2(p[23], p[24]); SORT2(p[2], p[5]); SORT2(p[3], p[6]);
+    SORT2(p[0], p[6]); SORT2(p[0], p[3]); SORT2(p[4], p[7]); SORT2(p[1], p[7]); SORT2(p[1], p[4]);
+    SORT2(p[11], p[14]); SORT2(p[8], p[14]); SORT2(p[8], p[11]); SORT2(p[12], p[15]); SORT2(p[9], p[15]);
+    SORT2(p[9], p[12]); SORT2(p[13], p[16]); SORT2(p[10], p[16]); SORT2(p[10], p[13]); SORT2(p[20], p[23]);
+    SORT2(p[17], p[23]); SORT2(p[17], p[20]); SORT2(p[21], p[24]); SORT2(p[18], p[24]); SORT2(p[18], p[21]);
+    SORT2(p[19], p[22]); SORT2(p[8], p[17]); SORT2(p[9], p[18]); SORT2(p[0], p[18]); SORT2(p[0], p[9]);
+    SORT2(p[10], p[19]); SORT2(p[1], p[19]); SORT2(p[1], p[10]); SORT2(p[11], p[20]); SORT2(p[2], p[20]);
+    SORT2(p[2], p[11]); SORT2(p[12], p[21]); SORT2(p[3], p[21]); SORT2(p[3], p[12]); SORT2(p[13], p[22]);
+    SORT2(p[4], p[22]); SORT2(p[4], p[13]); SORT2(p[14], p[23]); SORT2(p[5], p[23]); SORT2(p[5], p[14]);
+    SORT2(p[15], p[24]); SORT2(p[6], p[24]); SORT2(p[6], p[15]); SORT2(p[7], p[16]); SORT2(p[7], p[19]);
+    SORT2(p[13], p[21]); SORT2(p[15], p[23]); SORT2(p[7], p[13]); SORT2(p[7], p[15]); SORT2(p[1], p[9]);
+    SORT2(p[3], p[11]); SORT2(p[5], p[17]); SORT2(p[11], p[17]); SORT2(p[9], p[17]); SORT2(p[4], p[10]);
+    SORT2(p[6], p[12]); SORT2(p[7], p[14]); SORT2(p[4], p[6]); SORT2(p[4], p[7]); SORT2(p[12], p[14]);
+    SORT2(p[10], p[14]); SORT2(p[6], p[7]); SORT2(p[10], p[12]); SORT2(p[6], p[10]); SORT2(p[6], p[17]);
+    SORT2(p[12], p[17]); SORT2(p[7], p[17]); SORT2(p[7], p[10]); SORT2(p[12], p[18]); SORT2(p[7], p[12]);
+    SORT2(p[10], p[18]); SORT2(p[12], p[20]); SORT2(p[10], p[20]); SORT2(p[10], p[12]);
+    return p[12];
+}
+
+static void median5_band(void* arg, int band, int y0, int y1) {
+    median_ctx_t* c = (median_ctx_t*)arg;
+    int w = c->width;
+    size_t pitch = (size_t)w + 4;
+    uint8_t* ring = c->scratch[band];
+
+    for (int y = y0 - 2; y < y0 + 2; y++) pad_row(c, y, ring_row(ring, y, 5, pitch));
+
+    for (int y = y0; y < y1; y++) {
+        pad_row(c, y + 2, ring_row(ring, y + 2, 5, pitch));
+        uint8_t* rows[5];
+        for (int j = 0; j < 5; j++) rows[j] = ring_row(ring, y - 2 + j, 5, pitch);
+        uint8_t* out = c->dst + (size_t)y * c->dst_stride;
+
+        if (w < 16) {
+            for (int x = 0; x < w; x++) out[x] = median_scalar(rows, 2, x);
+            continue;
+        }
+
+        // Process 16 pixels at a time; the last block overlaps the previous one
+        for (int x = 0; x < w; x += 16) {
+            int j = x + 16 <= w ? x : w - 16;
+            uint8x16_t p[25];
+            for (int r = 0; r < 5; r++) {
+                for (int i = 0; i < 5; i++) p[r * 5 + i] = vld1q_u8(rows[r] + j + i);
+            }
+            vst1q_u8(out + j, median25_u8x16(p));
+        }
+    }
+}
+
+/*
+ * Constant-Time Histogram Median (Perreault)
+ */
+
+typedef struct {
+    uint16x8_t lo;
+    uint16x8_t hi;
+} hist16_t;
+
+static inline hist16_t hist16_load(const uint16_t* h) {
+    hist16_t v = { vld1q_u16(h), vld1q_u16(h + 8) };
+    return v;
+}
+
+static inline void hist16_store(uint16_t* h, hist16_t v) {
+    vst1q_u16(h, v.lo);
+    vst1q_u16(h + 8, v.hi);
+}
+
+// V + A - B (the window count never exceeds 255 * 255, so adding first is safe)
+static inline hist16_t hist16_slide(hist16_t v, const uint16_t* a, const uint16_t* b) {
+    v.lo = vsubq_u16(vaddq_u16(v.lo, vld1q_u16(a)), vld1q_u16(b));
+    v.hi = vsubq_u16(vaddq_u16(v.hi, vld1q_u16(a + 8)), vld1q_u16(b + 8));
+    return v;
+}
+
+static inline void hist16_add(hist16_t* v, const uint16_t* a) {
+    v->lo = vaddq_u16(v->lo, vld1q_u16(a));
+    v->hi = vaddq_u16(v->hi, vld1q_u16(a + 8));
+}
+
+// Add (sign 1) or remove (sign -1) source row Y from the column histograms
+static void column_update(const median_ctx_t* c, uint16_t* fine, uint16_t* coarse, int y, int sign) {
+    const uint8_t* row = c->src + (size_t)clamp_index(y, c->height) * c->src_stride;
+    uint16_t delta = (uint16_t)sign;
+    for (int x = 0; x < c->width; x++) {
+        uint8_t p = row[x];
+        fine[(size_t)x * 256 + p] += delta;
+        coarse[(size_t)x * 16 + (p >> 4)] += delta;
+    }
+}
+
+static void histogram_band(void* arg, int band, int y0, int y1) {
+    median_ctx_t* c = (median_ctx_t*)arg;
+    int w = c->width;
+    int r = c->radius;
+    int n = 2 * r + 1;
+    int target = n * n / 2;
+
+    // Per-column fine (256 bins) and coarse (16 bins) histograms
+    uint16_t* fine = (uint16_t*)c->scratch[band];
+    uint16_t* coarse = fine + (size_t)w * 256;
+    memset(fine, 0, (size_t)w * 272 * sizeof(uint16_t));
+
+    for (int y = y0 - r; y <= y0 + r; y++) column_update(c, fine, coarse, y, 1);
+
+    // Window fine segments and the column each was last brought up to
+    uint16_t seg[16][16];
+    int seg_x[16];
+
+    for (int y = y0; y < y1; y++) {
+        if (y > y0) {
+            column_update(c, fine, coarse, y - r - 1, -1);
+            column_update(c, fine, coarse, y + r, 1);
+        }
+
+        hist16_t window = { vdupq_n_u16(0), vdupq_n_u16(0) };
+        for (int i = -r; i <= r; i++) hist16_add(&window, coarse + (size_t)clamp_index(i, w) * 16);
+        for (int s = 0; s < 16; s++) seg_x[s] = -1;
+
+        uint8_t* out = c->dst + (size_t)y * c->dst_stride;
+        for (int x = 0; x < w; x++) {
+            if (x > 0) {
+                window = hist16_slide(window, coarse + (size_t)clamp_index(x + r, w) * 16,
+                                      coarse + (size_t)clamp_index(x - r - 1, w) * 16);
+            }
+
+            // Coarse bin holding the median
+            uint16_t counts[16];
+            hist16_store(counts, window);
+            int s = 0;
+            int sum = 0;
+            while (sum + counts[s] <= target) sum += counts[s++];
+
+            // Bring that fine segment forward to column x: slide when it
+            // is close, otherwise rebuild it from the 2r+1 columns
+            int off = s * 16;
+            hist16_t h;
+            if (seg_x[s] < 0 || 2 * (x - seg_x[s]) > n) {
+                h.lo = vdupq_n_u16(0);
+                h.hi = vdupq_n_u16(0);
+                for (int i = x - r; i <= x + r; i++) hist16_add(&h, fine + (size_t)clamp_index(i, w) * 256 + off);
+            } else {
+                h = hist16_load(seg[s]);
+                for (int i = seg_x[s] + 1; i <= x; i++) {
+                    h = hist16_slide(h, fine + (size_t)clamp_index(i + r, w) * 256 + off,
+                                     fine + (size_t)clamp_index(i - r - 1, w) * 256 + off);
+                }
+            }
+            hist16_store(seg[s], h);
+            seg_x[s] = x;
+
+            int b = 0;
+            while (sum + seg[s][b] <= target) sum += seg[s][b++];
+            out[x] = (uint8_t)(off + b);
+        }
+    }
+}
+
+/*
+ * Public API
+ */
+
+static void median(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                   int width, int height, int radius, int threads) {
+    if (width <= 0 || height <= 0 || radius < 1 || radius > SIMD_MEDIAN_MAX_RADIUS) return;
+
+    median_ctx_t c;
+    memset(&c, 0, sizeof(c));
+    c.src = src;
+    c.src_stride = src_stride;
+    c.dst = dst;
+    c.dst_stride = dst_stride;
+    c.width = width;
+    c.height = height;
+    c.radius = radius;
+
+    simd_band_fn_t fn;
+    size_t bytes;
+    if (radius == 1) {
+        fn = median3_band;
+        bytes = 6 * ((size_t)width + 2);
+    } else if (radius == 2) {
+        fn = median5_band;
+        bytes = 5 * ((size_t)width + 4);
+    } else {
+        fn = histogram_band;
+        bytes = (size_t)width * 272 * sizeof(uint16_t);
+    }
+
+    int bands = simd_parallel_band_count(height, threads);
+    int ok = 1;
+    for (int i = 0; i < bands; i++) {
+        c.scratch[i] = (uint8_t*)neon_malloc(bytes);
+        if (!c.scratch[i]) ok = 0;
+    }
+
+    if (ok) simd_parallel_bands(height, threads, fn, &c);
+
+    for (int i = 0; i < bands; i++) free(c.scratch[i]);
+}
+
+void simd_median_u8(const uint8_t* src, uint8_t* dst, int width, int height, int radius, int threads) {
+    median(src, (size_t)width, dst, (size_t)width, width, height, radius, threads);
+}
+
+void simd_median_u8_view(const simd_image_t* src, const simd_image_t* dst, int radius, int threads) {
+    if (!simd_image_valid(src, 1, 1) || !simd_image_valid(dst, 1, 1) ||
+        src->width != dst->width || src->height != dst->height) return;
+    median(src->data, src->stride, dst->data, dst->stride, src->width, src->height, radius, threads);
+}
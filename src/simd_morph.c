@@ -0,0 +1,384 @@
+/**
+ * simd_morph.c
+ * Implementation of grayscale morphology using NEON
+ *
+ * A rectangular element is separable: a horizontal window min/max followed
+ * by a vertical one. Both use the van Herk/Gil-Werman scheme - prefix and
+ * suffix extrema within blocks of k lines, merged with one more vminq/vmaxq
+ * - so each pixel costs three ops whatever the element size. The vertical
+ * pass treats whole rows (in L1-sized column stripes) as lines; the
+ * horizontal pass transposes 16-row strips so that its lines become 16-lane
+ * vectors as well, then transposes the result back.
+ */
+#include "simd_morph.h"
+#include "simd_parallel.h"
+#include "simd_transpose.h"
+#include <stdlib.h>
+#include <string.h>
+#include <arm_neon.h>
+
+// Column stripe width of the vertical pass
+#define MORPH_STRIPE 256
+
+/*
+ * Running Min/Max (van Herk/Gil-Werman)
+ */
+
+static inline uint8x16_t minmax_u8x16(uint8x16_t a, uint8x16_t b, int dilate) {
+    return dilate ? vmaxq_u8(a, b) : vminq_u8(a, b);
+}
+
+// DST = min(A, B) or max(A, B) over span bytes
+static void minmax_line(const uint8_t* a, const uint8_t* b, uint8_t* dst, size_t span, int dilate) {
+    // Process 16 bytes at a time using NEON
+    size_t vec_size = span / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 16;
+        vst1q_u8(dst + j, minmax_u8x16(vld1q_u8(a + j), vld1q_u8(b + j), dilate));
+    }
+
+    // Handle remaining bytes
+    for (size_t j = vec_size * 16; j < span; j++) {
+        if (dilate) {
+            dst[j] = a[j] > b[j] ? a[j] : b[j];
+        } else {
+            dst[j] = a[j] < b[j] ? a[j] : b[j];
+        }
+    }
+}
+
+// OUT line x = extremum of IN lines x .. x + k - 1 for x < n (IN holds
+// n + k - 1 lines of span bytes). G and H receive the prefix and suffix
+// extrema within blocks of k lines; every window spans at most two blocks,
+// so it is the suffix of one and the prefix of the next.
+static void vhgw_lines(const uint8_t* const* in, int n, int k, uint8_t* out, size_t out_stride,
+                       size_t span, int dilate, uint8_t* g, uint8_t* h) {
+    int len = n + k - 1;
+
+    for (int i = 0; i < len; i++) {
+        if (i % k == 0) {
+            memcpy(g + (size_t)i * span, in[i], span);
+        } else {
+            minmax_line(g + (size_t)(i - 1) * span, in[i], g + (size_t)i * span, span, dilate);
+        }
+    }
+
+    for (int i = len - 1; i >= 0; i--) {
+        if (i == len - 1 || (i + 1) % k == 0) {
+            memcpy(h + (size_t)i * span, in[i], span);
+        } else {
+            minmax_line(h + (size_t)(i + 1) * span, in[i], h + (size_t)i * span, span, dilate);
+        }
+    }
+
+    for (int x = 0; x < n; x++) {
+        minmax_line(h + (size_t)x * span, g + (size_t)(x + k - 1) * span, out + (size_t)x * out_stride, span, dilate);
+    }
+}
+
+/*
+ * Separable Passes
+ */
+
+typedef struct {
+    uint8_t* buf;
+    const uint8_t** lines;
+} morph_scratch_t;
+
+typedef struct {
+    int width;
+    int height;
+    int kw;
+    int kh;
+    int threads;
+    int bands;
+    uint8_t* tmp;                   // Horizontal pass result
+    uint8_t* tmp2;                  // Intermediate image of composite ops
+    uint8_t* low;                   // Row of 0 (dilation padding)
+    uint8_t* high;                  // Row of 255 (erosion padding)
+    morph_scratch_t scratch[SIMD_PARALLEL_MAX_THREADS];
+
+    // Current pass
+    const uint8_t* src;
+    size_t src_stride;
+    uint8_t* dst;
+    size_t dst_stride;
+    int dilate;
+} morph_ctx_t;
+
+static void horizontal_band(void* arg, int band, int y0, int y1) {
+    morph_ctx_t* c = (morph_ctx_t*)arg;
+    int w = c->width;
+    int k = c->kw;
+    int a = k / 2;
+    int len = w + k - 1;
+
+    if (k == 1) {
+        for (int y = y0; y < y1; y++) {
+            memcpy(c->dst + (size_t)y * c->dst_stride, c->src + (size_t)y * c->src_stride, (size_t)w);
+        }
+        return;
+    }
+
+    // Transposed strip (len lines of 16 rows, padded by the identity),
+    // block extrema, transposed result and a staging strip for short strips
+    uint8_t* col = c->scratch[band].buf;
+    uint8_t* g = col + (size_t)len * 16;
+    uint8_t* h = g + (size_t)len * 16;
+    uint8_t* out = h + (size_t)len * 16;
+    uint8_t* strip = out + (size_t)w * 16;
+    const uint8_t** lines = c->scratch[band].lines;
+
+    for (int i = 0; i < len; i++) lines[i] = col + (size_t)i * 16;
+    int identity = c->dilate ? 0 : 255;
+    memset(col, identity, (size_t)a * 16);
+    memset(col + (size_t)(a + w) * 16, identity, (size_t)(len - a - w) * 16);
+
+    // Full strips of packed images are transposed in place; short strips
+    // and padded rows go through the staging strip
+    bool src_packed = c->src_stride == (size_t)w;
+    bool dst_packed = c->dst_stride == (size_t)w;
+
+    for (int y = y0; y < y1; y += 16) {
+        int rows = y1 - y < 16 ? y1 - y : 16;
+        const uint8_t* in = c->src + (size_t)y * c->src_stride;
+        if (rows < 16 || !src_packed) {
+            for (int r = 0; r < rows; r++) memcpy(strip + (size_t)r * w, in + (size_t)r * c->src_stride, (size_t)w);
+            memset(strip + (size_t)rows * w, 0, (size_t)(16 - rows) * w);
+            in = strip;
+        }
+
+        simd_transpose_u8(in, col + (size_t)a * 16, 16, (size_t)w);
+        vhgw_lines(lines, w, k, out, 16, 16, c->dilate, g, h);
+
+        uint8_t* dst = c->dst + (size_t)y * c->dst_stride;
+        if (rows == 16 && dst_packed) {
+            simd_transpose_u8(out, dst, (size_t)w, 16);
+        } else {
+            simd_transpose_u8(out, strip, (size_t)w, 16);
+            for (int r = 0; r < rows; r++) memcpy(dst + (size_t)r * c->dst_stride, strip + (size_t)r * w, (size_t)w);
+        }
+    }
+}
+
+static void vertical_band(void* arg, int band, int y0, int y1) {
+    morph_ctx_t* c = (morph_ctx_t*)arg;
+    int w = c->width;
+    int k = c->kh;
+    int a = k / 2;
+    int n = y1 - y0;
+    int len = n + k - 1;
+
+    if (k == 1) {
+        for (int y = y0; y < y1; y++) {
+            memcpy(c->dst + (size_t)y * c->dst_stride, c->src + (size_t)y * c->src_stride, (size_t)w);
+        }
+        return;
+    }
+
+    uint8_t* g = c->scratch[band].buf;
+    uint8_t* h = g + (size_t)len * MORPH_STRIPE;
+    const uint8_t** lines = c->scratch[band].lines;
+    const uint8_t* pad = c->dilate ? c->low : c->high;
+
+    for (int x0 = 0; x0 < w; x0 += MORPH_STRIPE) {
+        size_t span = w - x0 < MORPH_STRIPE ? (size_t)(w - x0) : MORPH_STRIPE;
+        for (int i = 0; i < len; i++) {
+            int y = y0 - a + i;
+            lines[i] = (y < 0 || y >= c->height) ? pad : c->src + (size_t)y * c->src_stride + x0;
+        }
+        vhgw_lines(lines, n, k, c->dst + (size_t)y0 * c->dst_stride + x0, c->dst_stride, span, c->dilate, g, h);
+    }
+}
+
+// DST = erode or dilate SRC (DST may be SRC)
+static void morph_run(morph_ctx_t* c, const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                      int dilate) {
+    c->dilate = dilate;
+    c->src = src;
+    c->src_stride = src_stride;
+    c->dst = c->tmp;
+    c->dst_stride = (size_t)c->width;
+    simd_parallel_bands(c->height, c->threads, horizontal_band, c);
+    c->src = c->tmp;
+    c->src_stride = (size_t)c->width;
+    c->dst = dst;
+    c->dst_stride = dst_stride;
+    simd_parallel_bands(c->height, c->threads, vertical_band, c);
+}
+
+/*
+ * Difference Images
+ */
+
+typedef struct {
+    const uint8_t* a;
+    size_t a_stride;
+    const uint8_t* b;
+    size_t b_stride;
+    uint8_t* dst;
+    size_t dst_stride;
+    int width;
+} morph_sub_t;
+
+// DST = A - B over len pixels (never negative for the ops using it; saturating anyway)
+static void subtract_span(const uint8_t* a, const uint8_t* b, uint8_t* dst, size_t len) {
+    // Process 16 pixels at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 16;
+        vst1q_u8(dst + j, vqsubq_u8(vld1q_u8(a + j), vld1q_u8(b + j)));
+    }
+
+    // Handle remaining pixels
+    for (size_t j = vec_size * 16; j < len; j++) {
+        dst[j] = a[j] > b[j] ? (uint8_t)(a[j] - b[j]) : 0;
+    }
+}
+
+static void subtract_band(void* arg, int band, int y0, int y1) {
+    morph_sub_t* s = (morph_sub_t*)arg;
+    size_t w = (size_t)s->width;
+    (void)band;
+
+    // Packed images form one span per band
+    if (s->a_stride == w && s->b_stride == w && s->dst_stride == w) {
+        size_t start = (size_t)y0 * w;
+        subtract_span(s->a + start, s->b + start, s->dst + start, (size_t)(y1 - y0) * w);
+        return;
+    }
+    for (int y = y0; y < y1; y++) {
+        subtract_span(s->a + (size_t)y * s->a_stride, s->b + (size_t)y * s->b_stride,
+                      s->dst + (size_t)y * s->dst_stride, w);
+    }
+}
+
+static void morph_subtract(morph_ctx_t* c, const uint8_t* a, size_t a_stride, const uint8_t* b, size_t b_stride,
+                           uint8_t* dst, size_t dst_stride) {
+    morph_sub_t s = { a, a_stride, b, b_stride, dst, dst_stride, c->width };
+    simd_parallel_bands(c->height, c->threads, subtract_band, &s);
+}
+
+/*
+ * Public API
+ */
+
+static void morph_free(morph_ctx_t* c) {
+    free(c->tmp);
+    free(c->tmp2);
+    free(c->low);
+    free(c->high);
+    for (int i = 0; i < SIMD_PARALLEL_MAX_THREADS; i++) {
+        free(c->scratch[i].buf);
+        free((void*)c->scratch[i].lines);
+    }
+}
+
+static int morph_init(morph_ctx_t* c, int width, int height, int kw, int kh, int threads, int composite) {
+    memset(c, 0, sizeof(*c));
+    c->width = width;
+    c->height = height;
+    c->kw = kw;
+    c->kh = kh;
+    c->threads = threads;
+    c->bands = simd_parallel_band_count(height, threads);
+
+    size_t pixels = (size_t)width * height;
+    size_t row = (size_t)(width > 16 ? width : 16);
+    c->tmp = (uint8_t*)neon_malloc(pixels);
+    c->tmp2 = composite ? (uint8_t*)neon_malloc(pixels) : NULL;
+    c->low = (uint8_t*)neon_malloc(row);
+    c->high = (uint8_t*)neon_malloc(row);
+    if (!c->tmp || (composite && !c->tmp2) || !c->low || !c->high) return 0;
+    memset(c->low, 0, row);
+    memset(c->high, 255, row);
+
+    // Scratch sized for the larger of the two passes of the tallest band
+    int band_rows = 0;
+    for (int i = 0; i < c->bands; i++) {
+        int rows = simd_parallel_band_start(height, c->bands, i + 1) - simd_parallel_band_start(height, c->bands, i);
+        if (rows > band_rows) band_rows = rows;
+    }
+    size_t h_len = (size_t)width + kw - 1;
+    size_t v_len = (size_t)band_rows + kh - 1;
+    size_t h_bytes = 3 * h_len * 16 + 2 * (size_t)width * 16;
+    size_t v_bytes = 2 * v_len * MORPH_STRIPE;
+    size_t lines = h_len > v_len ? h_len : v_len;
+
+    for (int i = 0; i < c->bands; i++) {
+        c->scratch[i].buf = (uint8_t*)neon_malloc(h_bytes > v_bytes ? h_bytes : v_bytes);
+        c->scratch[i].lines = (const uint8_t**)malloc(lines * sizeof(const uint8_t*));
+        if (!c->scratch[i].buf || !c->scratch[i].lines) return 0;
+    }
+    return 1;
+}
+
+static void morphology(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                       int width, int height, simd_morph_op_t op, int kw, int kh, int threads) {
+    if (kw < 1 || kh < 1 || kw > SIMD_MORPH_MAX_SIZE || kh > SIMD_MORPH_MAX_SIZE) return;
+
+    int composite = op == SIMD_MORPH_GRADIENT || op == SIMD_MORPH_TOPHAT || op == SIMD_MORPH_BLACKHAT;
+    morph_ctx_t c;
+    if (!morph_init(&c, width, height, kw, kh, threads, composite)) {
+        morph_free(&c);
+        return;
+    }
+
+    size_t w = (size_t)width;
+    switch (op) {
+        case SIMD_MORPH_ERODE:
+            morph_run(&c, src, src_stride, dst, dst_stride, 0);
+            break;
+        case SIMD_MORPH_DILATE:
+            morph_run(&c, src, src_stride, dst, dst_stride, 1);
+            break;
+        case SIMD_MORPH_OPEN:
+            morph_run(&c, src, src_stride, dst, dst_stride, 0);
+            morph_run(&c, dst, dst_stride, dst, dst_stride, 1);
+            break;
+        case SIMD_MORPH_CLOSE:
+            morph_run(&c, src, src_stride, dst, dst_stride, 1);
+            morph_run(&c, dst, dst_stride, dst, dst_stride, 0);
+            break;
+        case SIMD_MORPH_GRADIENT:
+            morph_run(&c, src, src_stride, dst, dst_stride, 0);
+            morph_run(&c, src, src_stride, c.tmp2, w, 1);
+            morph_subtract(&c, c.tmp2, w, dst, dst_stride, dst, dst_stride);
+            break;
+        case SIMD_MORPH_TOPHAT:
+            morph_run(&c, src, src_stride, c.tmp2, w, 0);
+            morph_run(&c, c.tmp2, w, c.tmp2, w, 1);
+            morph_subtract(&c, src, src_stride, c.tmp2, w, dst, dst_stride);
+            break;
+        case SIMD_MORPH_BLACKHAT:
+            morph_run(&c, src, src_stride, c.tmp2, w, 1);
+            morph_run(&c, c.tmp2, w, c.tmp2, w, 0);
+            morph_subtract(&c, c.tmp2, w, src, src_stride, dst, dst_stride);
+            break;
+    }
+
+    morph_free(&c);
+}
+
+void simd_morphology_u8(const uint8_t* src, uint8_t* dst, int width, int height,
+                        simd_morph_op_t op, int kw, int kh, int threads) {
+    if (width <= 0 || height <= 0) return;
+    morphology(src, (size_t)width, dst, (size_t)width, width, height, op, kw, kh, threads);
+}
+
+void simd_erode_u8(const uint8_t* src, uint8_t* dst, int width, int height, int kw, int kh, int threads) {
+    simd_morphology_u8(src, dst, width, height, SIMD_MORPH_ERODE, kw, kh, threads);
+}
+
+void simd_dilate_u8(const uint8_t* src, uint8_t* dst, int width, int height, int kw, int kh, int threads) {
+    simd_morphology_u8(src, dst, width, height, SIMD_MORPH_DILATE, kw, kh, threads);
+}
+
+void simd_morphology_u8_view(const simd_image_t* src, const simd_image_t* dst,
+                             simd_morph_op_t op, int kw, int kh, int threads) {
+    if (!simd_image_valid(src, 1, 1) || !simd_image_valid(dst, 1, 1) ||
+        src->width != dst->width || src->height != dst->height) return;
+    morphology(src->data, src->stride, dst->data, dst->stride, src->width, src->height, op, kw, kh, threads);
+}
@@ -0,0 +1,120 @@
+/**
+ * simd_numa.c
+ * NUMA topology discovery and first-touch node-local allocation
+ *
+ * There is no libnuma dependency: the topology comes straight from sysfs
+ * and placement relies on the kernel's default first-touch policy. The
+ * scheduler pins each node's workers to that node's CPUs, so zeroing a
+ * fresh mapping through simd_parallel_for_nodes puts every page on the
+ * node whose workers will later sweep it. Only one byte per page is
+ * written; the rest of the page is zero-filled by the kernel anyway.
+ */
+#define _GNU_SOURCE
+#include "simd_numa.h"
+#include "simd_sched.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/*
+ * Topology
+ */
+
+// Parse a sysfs list ("0-3,8,10-11") into up to MAX ascending ids
+static int parse_list(const char* list, int* ids, int max) {
+    int count = 0;
+    const char* p = list;
+    while (count < max) {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0) break;
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first) break;
+            p = end;
+        }
+        for (long id = first; id <= last && count < max; id++) ids[count++] = (int)id;
+        if (*p != ',') break;
+        p++;
+    }
+    return count;
+}
+
+static bool read_line(const char* path, char* line, size_t size) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    bool ok = fgets(line, (int)size, f) != NULL;
+    fclose(f);
+    return ok;
+}
+
+// MemTotal from a node's meminfo ("Node 0 MemTotal:  65536000 kB")
+static uint64_t read_memory(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    char line[256];
+    uint64_t bytes = 0;
+    while (fgets(line, sizeof(line), f)) {
+        const char* field = strstr(line, "MemTotal:");
+        if (field) {
+            bytes = strtoull(field + 9, NULL, 10) * 1024;
+            break;
+        }
+    }
+    fclose(f);
+    return bytes;
+}
+
+int simd_numa_topology(const char* root, simd_numa_node_t* nodes, int max) {
+    if (!root) root = "/sys/devices/system/node";
+    char path[256], list[4096];
+
+    snprintf(path, sizeof(path), "%s/online", root);
+    if (!read_line(path, list, sizeof(list))) return 0;
+
+    int ids[SIMD_NUMA_MAX_NODES];
+    int count = parse_list(list, ids, max < SIMD_NUMA_MAX_NODES ? max : SIMD_NUMA_MAX_NODES);
+    for (int i = 0; i < count; i++) {
+        simd_numa_node_t* node = &nodes[i];
+        node->id = ids[i];
+        snprintf(path, sizeof(path), "%s/node%d/cpulist", root, ids[i]);
+        node->cpu_count = read_line(path, list, sizeof(list)) ? parse_list(list, node->cpus, SIMD_NUMA_MAX_CPUS) : 0;
+        snprintf(path, sizeof(path), "%s/node%d/meminfo", root, ids[i]);
+        node->memory = read_memory(path);
+    }
+    return count;
+}
+
+/*
+ * Node-Local Allocation
+ */
+
+typedef struct {
+    unsigned char* data;
+    size_t page;
+} touch_t;
+
+// Write the first byte of every page that starts in [begin, end)
+static void touch_pages(void* ctx, size_t begin, size_t end) {
+    const touch_t* t = (const touch_t*)ctx;
+    for (size_t p = (begin + t->page - 1) / t->page * t->page; p < end; p += t->page) t->data[p] = 0;
+}
+
+void* simd_numa_alloc(size_t size) {
+    if (size == 0) return NULL;
+    void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) return NULL;
+
+    long page = sysconf(_SC_PAGESIZE);
+    touch_t t = { (unsigned char*)ptr, page > 0 ? (size_t)page : 4096 };
+    if (simd_sched_nodes() > 1) simd_parallel_for_nodes(0, size, 64 * t.page, touch_pages, &t);
+    return ptr;
+}
+
+void simd_numa_free(void* ptr, size_t size) {
+    if (ptr && size) munmap(ptr, size);
+}
@@ -381,76 +381,52 @@ void simd_sqrt_f32(const float* a, float* c, size_t len) {
 }
 
 void simd_interleave_even_f32(const float* a, const float* b, float* c, size_t len) {
-    // Handle pairs of even elements (0, 2, 4, ...)
-    size_t vec_pairs = len / 4;  // Process 2 pairs at a time
+    // Process 8 input elements (4 even pairs) at a time using NEON
+    size_t vec_size = len / 8;
     
-    for (size_t i = 0; i < vec_pairs; i++) {
-        // Load elements from a and b
-        float32x4_t va = vld1q_f32(a + i * 4);  // Load a[4i:4i+3]
-        float32x4_t vb = vld1q_f32(b + i * 4);  // Load b[4i:4i+3]
-        
-        // Extract even elements (0, 2)
-        float32x2_t va_even = vget_low_f32(va);  // a[4i], a[4i+1]
-        float32x2_t vb_even = vget_low_f32(vb);  // b[4i], b[4i+1]
-        
-        // Interleave first elements
-        float32x2_t va_0 = vdup_lane_f32(va_even, 0);  // a[4i], a[4i]
-        float32x2_t vb_0 = vdup_lane_f32(vb_even, 0);  // b[4i], b[4i]
-        float32x2_t vinterleave_0 = vzip1_f32(va_0, vb_0);  // a[4i], b[4i]
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleave on load: val[0] = even elements, val[1] = odd elements
+        float32x4x2_t va = vld2q_f32(a + i * 8);  // a[8i], a[8i+2], a[8i+4], a[8i+6]
+        float32x4x2_t vb = vld2q_f32(b + i * 8);  // b[8i], b[8i+2], b[8i+4], b[8i+6]
         
-        // Interleave third elements
-        float32x2_t va_2 = vdup_lane_f32(va_even, 1);  // a[4i+1], a[4i+1]
-        float32x2_t vb_2 = vdup_lane_f32(vb_even, 1);  // b[4i+1], b[4i+1]
-        float32x2_t vinterleave_2 = vzip1_f32(va_2, vb_2);  // a[4i+1], b[4i+1]
+        // Re-interleave the even elements: a[8i], b[8i], a[8i+2], b[8i+2], ...
+        float32x4x2_t vc;
+        vc.val[0] = va.val[0];
+        vc.val[1] = vb.val[0];
         
         // Store the results
-        vst1_f32(c + i * 4, vinterleave_0);
-        vst1_f32(c + i * 4 + 2, vinterleave_2);
+        vst2q_f32(c + i * 8, vc);
     }
     
-    // Handle remaining elements (if len is not a multiple of 4)
-    size_t remaining_start = vec_pairs * 4;
-    for (size_t i = remaining_start / 2; i < len / 2; i++) {
-        c[i * 2] = a[i];
-        c[i * 2 + 1] = b[i];
+    // Handle remaining pairs (if len is not a multiple of 8)
+    for (size_t k = vec_size * 4; k < len / 2; k++) {
+        c[k * 2] = a[k * 2];
+        c[k * 2 + 1] = b[k * 2];
     }
 }
 
 void simd_interleave_odd_f32(const float* a, const float* b, float* c, size_t len) {
-    // Handle pairs of odd elements (1, 3, 5, ...)
-    size_t vec_pairs = len / 4;  // Process 2 pairs at a time
+    // Process 8 input elements (4 odd pairs) at a time using NEON
+    size_t vec_size = len / 8;
     
-    for (size_t i = 0; i < vec_pairs; i++) {
-        // Load elements from a and b
-        float32x4_t va = vld1q_f32(a + i * 4);  // Load a[4i:4i+3]
-        float32x4_t vb = vld1q_f32(b + i * 4);  // Load b[4i:4i+3]
-        
-        // Extract odd elements (1, 3)
-        float32x2_t va_odd = vget_high_f32(va);  // a[4i+2], a[4i+3]
-        float32x2_t vb_odd = vget_high_f32(vb);  // b[4i+2], b[4i+3]
-        
-        // Interleave second elements
-        float32x2_t va_1 = vdup_lane_f32(va_odd, 0);  // a[4i+2], a[4i+2]
-        float32x2_t vb_1 = vdup_lane_f32(vb_odd, 0);  // b[4i+2], b[4i+2]
-        float32x2_t vinterleave_1 = vzip1_f32(va_1, vb_1);  // a[4i+2], b[4i+2]
+    for (size_t i = 0; i < vec_size; i++) {
+        // De-interleave on load: val[0] = even elements, val[1] = odd elements
+        float32x4x2_t va = vld2q_f32(a + i * 8);  // a[8i+1], a[8i+3], a[8i+5], a[8i+7]
+        float32x4x2_t vb = vld2q_f32(b + i * 8);  // b[8i+1], b[8i+3], b[8i+5], b[8i+7]
         
-        // Interleave fourth elements
-        float32x2_t va_3 = vdup_lane_f32(va_odd, 1);  // a[4i+3], a[4i+3]
-        float32x2_t vb_3 = vdup_lane_f32(vb_odd, 1);  // b[4i+3], b[4i+3]
-        float32x2_t vinterleave_3 = vzip1_f32(va_3, vb_3);  // a[4i+3], b[4i+3]
+        // Re-interleave the odd elements: a[8i+1], b[8i+1], a[8i+3], b[8i+3], ...
+        float32x4x2_t vc;
+        vc.val[0] = va.val[1];
+        vc.val[1] = vb.val[1];
         
         // Store the results
-        vst1_f32(c + i * 4, vinterleave_1);
-        vst1_f32(c + i * 4 + 2, vinterleave_3);
+        vst2q_f32(c + i * 8, vc);
     }
     
-    // Handle remaining elements (if len is not a multiple of 4)
-    size_t remaining_start = vec_pairs * 4;
-    for (size_t i = remaining_start / 2; i < len / 2; i++) {
-        if (2 * i + 1 < len) {
-            c[i * 2] = a[2 * i + 1];
-            c[i * 2 + 1] = b[2 * i + 1];
-        }
+    // Handle remaining pairs (if len is not a multiple of 8)
+    for (size_t k = vec_size * 4; k < len / 2; k++) {
+        c[k * 2] = a[k * 2 + 1];
+        c[k * 2 + 1] = b[k * 2 + 1];
     }
 }
 
@@ -492,8 +468,8 @@ void simd_rgb_to_gray(const uint8_t* rgb, uint8_t* gray, size_t pixel_count) {
         uint16x8_t sum = vaddq_u16(r_contrib, g_contrib);
         sum = vaddq_u16(sum, b_contrib);
         
-        // Divide by 256 (shift right by 8)
-        uint8x8_t gray_pixels = vshrn_n_u16(sum, 8);
+        // Divide by 256 with rounding (shift right by 8)
+        uint8x8_t gray_pixels = vrshrn_n_u16(sum, 8);
         
         // Store the result
         vst1_u8(gray + i * 8, gray_pixels);
@@ -502,12 +478,13 @@ void simd_rgb_to_gray(const uint8_t* rgb, uint8_t* gray, size_t pixel_count) {
     // Handle remaining pixels
     for (size_t i = vec_size * 8; i < pixel_count; i++) {
         const uint8_t* pixel = rgb + i * 3;
-        uint16_t gray_val = (pixel[0] * r_coeff + pixel[1] * g_coeff + pixel[2] * b_coeff) >> 8;
+        uint16_t gray_val = (pixel[0] * r_coeff + pixel[1] * g_coeff + pixel[2] * b_coeff + 128) >> 8;
         gray[i] = (uint8_t)gray_val;
     }
 }
 
-void simd_blur_gray_3x3(const uint8_t* input, uint8_t* output, int width, int height) {
+static void blur_gray_3x3(const uint8_t* input, size_t in_stride, uint8_t* output, size_t out_stride,
+                          int width, int height) {
     // 3x3 Box blur (simple average filter)
     // Skip the border pixels for simplicity
     
@@ -523,7 +500,7 @@ void simd_blur_gray_3x3(const uint8_t* input, uint8_t* output, int width, int he
             // Accumulate 3x3 neighborhood for 8 adjacent pixels
             for (int ky = -1; ky <= 1; ky++) {
                 for (int kx = -1; kx <= 1; kx++) {
-                    uint8x8_t neighborhood = vld1_u8(input + (y + ky) * width + (x + kx));
+                    uint8x8_t neighborhood = vld1_u8(input + (y + ky) * in_stride + (x + kx));
                     sum = vaddw_u8(sum, neighborhood);
                 }
             }
@@ -534,7 +511,7 @@ void simd_blur_gray_3x3(const uint8_t* input, uint8_t* output, int width, int he
             uint8x8_t result = vshrn_n_u16(scaled, 8);
             
             // Store the result
-            vst1_u8(output + y * width + x, result);
+            vst1_u8(output + y * out_stride + x, result);
         }
         
         // Handle remaining pixels
@@ -542,21 +519,45 @@ void simd_blur_gray_3x3(const uint8_t* input, uint8_t* output, int width, int he
             uint16_t sum = 0;
             for (int ky = -1; ky <= 1; ky++) {
                 for (int kx = -1; kx <= 1; kx++) {
-                    sum += input[(y + ky) * width + (x + kx)];
+                    sum += input[(y + ky) * in_stride + (x + kx)];
                 }
             }
-            output[y * width + x] = (uint8_t)(sum / 9);
+            output[y * out_stride + x] = (uint8_t)(sum / 9);
         }
     }
     
     // Handle border pixels (just copy from input)
     for (int x = 0; x < width; x++) {
         output[x] = input[x];  // Top row
-        output[(height - 1) * width + x] = input[(height - 1) * width + x];  // Bottom row
+        output[(height - 1) * out_stride + x] = input[(height - 1) * in_stride + x];  // Bottom row
     }
     
     for (int y = 1; y < height - 1; y++) {
-        output[y * width] = input[y * width];  // Left column
-        output[y * width + width - 1] = input[y * width + width - 1];  // Right column
+        output[y * out_stride] = input[y * in_stride];  // Left column
+        output[y * out_stride + width - 1] = input[y * in_stride + width - 1];  // Right column
+    }
+}
+
+void simd_blur_gray_3x3(const uint8_t* input, uint8_t* output, int width, int height) {
+    blur_gray_3x3(input, (size_t)width, output, (size_t)width, width, height);
+}
+
+void simd_blur_gray_3x3_view(const simd_image_t* src, const simd_image_t* dst) {
+    if (!simd_image_valid(src, 1, 1) || !simd_image_valid(dst, 1, 1)) return;
+    if (dst->width != src->width || dst->height != src->height) return;
+    blur_gray_3x3(src->data, src->stride, dst->data, dst->stride, src->width, src->height);
+}
+
+void simd_rgb_to_gray_view(const simd_image_t* src, const simd_image_t* dst) {
+    if (!simd_image_valid(src, 3, 1) || !simd_image_valid(dst, 1, 1)) return;
+    if (dst->width != src->width || dst->height != src->height) return;
+
+    // Packed images are one run of pixels; otherwise convert row by row
+    if (simd_image_is_packed(src, 1) && simd_image_is_packed(dst, 1)) {
+        simd_rgb_to_gray(src->data, dst->data, (size_t)src->width * src->height);
+        return;
+    }
+    for (int y = 0; y < src->height; y++) {
+        simd_rgb_to_gray((const uint8_t*)simd_image_row(src, y), (uint8_t*)simd_image_row(dst, y), (size_t)src->width);
     }
 }
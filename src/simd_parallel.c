@@ -0,0 +1,58 @@
+/**
+ * simd_parallel.c
+ * Band-parallel execution on the work-stealing scheduler
+ *
+ * Band boundaries depend only on the row and band counts, so kernels can
+ * keep per-band scratch and per-band partial results (the two-pass scan
+ * relies on this); the bands themselves run as a parallel loop with a
+ * grain of one band, so idle cores pick up whichever bands remain. With
+ * the pool placed by NUMA node, each node takes a contiguous run of bands,
+ * the rows a simd_numa_alloc'd image keeps on that node.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "simd_parallel.h"
+#include "simd_sched.h"
+#include <unistd.h>
+
+typedef struct {
+    simd_band_fn_t fn;
+    void* ctx;
+    int rows;
+    int bands;
+} band_job_t;
+
+static void band_range(void* arg, size_t begin, size_t end) {
+    band_job_t* job = (band_job_t*)arg;
+    for (size_t i = begin; i < end; i++) {
+        int band = (int)i;
+        job->fn(job->ctx, band, simd_parallel_band_start(job->rows, job->bands, band),
+                simd_parallel_band_start(job->rows, job->bands, band + 1));
+    }
+}
+
+int simd_parallel_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+int simd_parallel_band_count(int rows, int threads) {
+    if (rows <= 0) return 0;
+    if (threads <= 0) threads = simd_parallel_cpu_count();
+    if (threads > SIMD_PARALLEL_MAX_THREADS) threads = SIMD_PARALLEL_MAX_THREADS;
+    return threads < rows ? threads : rows;
+}
+
+int simd_parallel_bands(int rows, int threads, simd_band_fn_t fn, void* ctx) {
+    int bands = simd_parallel_band_count(rows, threads);
+    if (bands == 0) return 0;
+
+    // A single band runs inline without touching the scheduler
+    if (bands == 1) {
+        fn(ctx, 0, 0, rows);
+        return 1;
+    }
+
+    band_job_t job = { fn, ctx, rows, bands };
+    simd_parallel_for_nodes(0, (size_t)bands, 1, band_range, &job);
+    return bands;
+}
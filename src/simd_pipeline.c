@@ -0,0 +1,333 @@
+/**
+ * simd_pipeline.c
+ * Frame pipeline: stage threads connected by lock-free SPSC queues
+ *
+ * Every queue has exactly one producer and one consumer, so a push or pop
+ * is a load, a store and one release/acquire pair on the index the other
+ * side reads; the two indices live on separate cache lines. Frames move
+ * through the queues as pointers, and the last thread hands each finished
+ * frame back to the first through a pool queue of the same kind, so the
+ * buffers form a closed loop: the first stage can only run ahead of the
+ * last by the number of buffers, which is the backpressure.
+ *
+ * Waits are frame-length, so a blocked thread spins briefly, then yields,
+ * then sleeps in short steps rather than parking on a condition variable.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "simd_pipeline.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+/*
+ * SPSC Queue
+ */
+
+struct simd_spsc {
+    atomic_size_t head;         // Next slot to pop, written by the consumer
+    char pad0[56];
+    atomic_size_t tail;         // Next slot to push, written by the producer
+    char pad1[56];
+    size_t mask;
+    void** slots;
+};
+
+simd_spsc_t* simd_spsc_create(size_t capacity) {
+    if (capacity == 0 || capacity > ((size_t)1 << 30)) return NULL;
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+
+    simd_spsc_t* q = (simd_spsc_t*)calloc(1, sizeof(simd_spsc_t));
+    if (!q) return NULL;
+    q->slots = (void**)calloc(size, sizeof(void*));
+    if (!q->slots) {
+        free(q);
+        return NULL;
+    }
+    q->mask = size - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    return q;
+}
+
+void simd_spsc_destroy(simd_spsc_t* q) {
+    if (!q) return;
+    free(q->slots);
+    free(q);
+}
+
+size_t simd_spsc_capacity(const simd_spsc_t* q) {
+    return q->mask + 1;
+}
+
+bool simd_spsc_push(simd_spsc_t* q, void* item) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&q->head, memory_order_acquire) > q->mask) return false;
+    q->slots[tail & q->mask] = item;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+void* simd_spsc_pop(simd_spsc_t* q) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == atomic_load_explicit(&q->tail, memory_order_acquire)) return NULL;
+    void* item = q->slots[head & q->mask];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return item;
+}
+
+size_t simd_spsc_size(const simd_spsc_t* q) {
+    size_t head = atomic_load_explicit(&((simd_spsc_t*)q)->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&((simd_spsc_t*)q)->tail, memory_order_acquire);
+    return tail - head;
+}
+
+/*
+ * Executor
+ */
+
+// Queued behind the last frame to stop each thread in turn
+static simd_frame_t end_of_stream;
+
+typedef struct {
+    uint64_t frames;
+    uint64_t busy_ns;
+    uint64_t max_ns;
+} stage_acc_t;
+
+typedef struct pipeline pipeline_t;
+
+// One thread: stages [first, last] fused, fed by IN, feeding OUT
+typedef struct {
+    pipeline_t* p;
+    int first;
+    int last;
+    simd_spsc_t* in;
+    simd_spsc_t* out;
+    uint64_t starved_ns;
+    uint64_t blocked_ns;
+    uint64_t queue_sum;
+    uint64_t taken;
+    int queue_max;
+    char pad[64];
+} stage_group_t;
+
+struct pipeline {
+    const simd_stage_t* stages;
+    stage_acc_t acc[SIMD_PIPELINE_MAX_STAGES];
+    stage_group_t groups[SIMD_PIPELINE_MAX_STAGES];
+    simd_spsc_t* pool;          // Free frames, from the last group back to the first
+    uint64_t next_index;        // First group only
+    uint64_t frames;            // Last group only
+    uint64_t dropped;
+    uint64_t latency_ns;
+    uint64_t latency_max_ns;
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Spin briefly, then yield, then sleep
+static void backoff(int* spins) {
+    int n = (*spins)++;
+    if (n < 64) return;
+    if (n < 128) {
+        sched_yield();
+        return;
+    }
+    struct timespec ts = { 0, 20000 };
+    nanosleep(&ts, NULL);
+}
+
+static simd_frame_t* take(stage_group_t* g) {
+    simd_frame_t* f = (simd_frame_t*)simd_spsc_pop(g->in);
+    if (!f) {
+        uint64_t t0 = now_ns();
+        int spins = 0;
+        while (!(f = (simd_frame_t*)simd_spsc_pop(g->in))) backoff(&spins);
+
+        // Waiting for a free frame is backpressure, not starvation
+        uint64_t waited = now_ns() - t0;
+        if (g->first == 0) g->blocked_ns += waited;
+        else g->starved_ns += waited;
+    }
+
+    int depth = (int)simd_spsc_size(g->in) + 1;
+    g->queue_sum += (uint64_t)depth;
+    g->taken++;
+    if (depth > g->queue_max) g->queue_max = depth;
+    return f;
+}
+
+static void give(stage_group_t* g, simd_frame_t* f) {
+    if (simd_spsc_push(g->out, f)) return;
+    uint64_t t0 = now_ns();
+    int spins = 0;
+    while (!simd_spsc_push(g->out, f)) backoff(&spins);
+    g->blocked_ns += now_ns() - t0;
+}
+
+static void* group_thread(void* arg) {
+    stage_group_t* g = (stage_group_t*)arg;
+    pipeline_t* p = g->p;
+    bool last_group = g->out == p->pool;
+
+    for (;;) {
+        simd_frame_t* f = take(g);
+        if (f == &end_of_stream) {
+            if (!last_group) give(g, f);
+            break;
+        }
+
+        uint64_t t = now_ns();
+        if (g->first == 0) {
+            f->index = p->next_index++;
+            f->start_ns = t;
+            f->dropped = false;
+        }
+
+        bool ended = false;
+        for (int s = g->first; s <= g->last && !f->dropped; s++) {
+            bool keep = p->stages[s].fn(p->stages[s].ctx, f);
+            if (s == 0 && !keep) {
+                ended = true;
+                break;
+            }
+            uint64_t t1 = now_ns();
+            stage_acc_t* a = &p->acc[s];
+            a->frames++;
+            a->busy_ns += t1 - t;
+            if (t1 - t > a->max_ns) a->max_ns = t1 - t;
+            t = t1;
+            f->dropped = !keep;
+        }
+
+        // The buffer that ended the stream leaves the loop
+        if (ended) {
+            if (!last_group) give(g, &end_of_stream);
+            break;
+        }
+
+        if (last_group) {
+            if (f->dropped) {
+                p->dropped++;
+            } else {
+                uint64_t latency = t - f->start_ns;
+                p->frames++;
+                p->latency_ns += latency;
+                if (latency > p->latency_max_ns) p->latency_max_ns = latency;
+            }
+        }
+        give(g, f);
+    }
+    return NULL;
+}
+
+static void fill_stats(const pipeline_t* p, const simd_stage_t* stages, int count, int groups, uint64_t wall_ns,
+                       simd_pipeline_stats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->stages = count;
+    stats->threads = groups;
+    for (int s = 0; s < count; s++) {
+        const stage_acc_t* a = &p->acc[s];
+        simd_stage_stats_t* st = &stats->stage[s];
+        st->name = stages[s].name;
+        st->frames = a->frames;
+        st->busy_ms = a->busy_ns / 1e6;
+        st->latency_avg_us = a->frames ? a->busy_ns / 1e3 / a->frames : 0.0;
+        st->latency_max_us = a->max_ns / 1e3;
+    }
+    for (int i = 0; i < groups; i++) {
+        const stage_group_t* g = &p->groups[i];
+        stats->stage[g->first].starved_ms = g->starved_ns / 1e6;
+        stats->stage[g->first].queue_avg = g->taken ? (double)g->queue_sum / g->taken : 0.0;
+        stats->stage[g->first].queue_max = g->queue_max;
+        stats->stage[g->last].blocked_ms = g->blocked_ns / 1e6;
+    }
+    stats->frames = p->frames;
+    stats->dropped = p->dropped;
+    stats->seconds = wall_ns / 1e9;
+    stats->fps = wall_ns ? p->frames * 1e9 / wall_ns : 0.0;
+    stats->latency_avg_us = p->frames ? p->latency_ns / 1e3 / p->frames : 0.0;
+    stats->latency_max_us = p->latency_max_ns / 1e3;
+}
+
+bool simd_pipeline_run(const simd_stage_t* stages, int count, const simd_pipeline_config_t* config,
+                       simd_pipeline_stats_t* stats) {
+    if (!stages || count <= 0 || count > SIMD_PIPELINE_MAX_STAGES || !config || config->frame_size == 0 ||
+        config->frames < 0 || config->queue_capacity < 0) return false;
+    for (int s = 0; s < count; s++) {
+        if (!stages[s].fn) return false;
+    }
+
+    pipeline_t* p = (pipeline_t*)calloc(1, sizeof(pipeline_t));
+    if (!p) return false;
+    p->stages = stages;
+
+    // A new group starts at every stage that is not fused to its predecessor
+    int groups = 0;
+    for (int s = 0; s < count; s++) {
+        if (s == 0 || !stages[s].fuse) p->groups[groups++].first = s;
+        p->groups[groups - 1].last = s;
+    }
+
+    int frames = config->frames ? config->frames : 2 * groups;
+    int capacity = config->queue_capacity ? config->queue_capacity : frames;
+
+    // Buffers on separate cache lines, in one allocation
+    size_t stride = (config->frame_size + 63) & ~(size_t)63;
+    simd_frame_t* frame = (simd_frame_t*)calloc((size_t)frames, sizeof(simd_frame_t));
+    uint8_t* block = (uint8_t*)neon_malloc(stride * frames);
+    simd_spsc_t* queues[SIMD_PIPELINE_MAX_STAGES] = { NULL };
+    p->pool = simd_spsc_create((size_t)frames);
+    bool ok = frame && block && p->pool;
+    for (int i = 0; ok && i < groups - 1; i++) {
+        queues[i] = simd_spsc_create((size_t)capacity);
+        ok = queues[i] != NULL;
+    }
+
+    if (ok) {
+        for (int i = 0; i < frames; i++) {
+            frame[i].data = block + stride * i;
+            frame[i].size = config->frame_size;
+            simd_spsc_push(p->pool, &frame[i]);
+        }
+        for (int i = 0; i < groups; i++) {
+            stage_group_t* g = &p->groups[i];
+            g->p = p;
+            g->in = i == 0 ? p->pool : queues[i - 1];
+            g->out = i == groups - 1 ? p->pool : queues[i];
+        }
+
+        uint64_t t0 = now_ns();
+        pthread_t handles[SIMD_PIPELINE_MAX_STAGES];
+        int started = 1;
+        while (started < groups && pthread_create(&handles[started], NULL, group_thread, &p->groups[started]) == 0) {
+            started++;
+        }
+
+        // Every stage needs its thread; without one, stop those running
+        if (started < groups) {
+            simd_spsc_push(queues[0], &end_of_stream);
+            ok = false;
+        } else {
+            group_thread(&p->groups[0]);
+        }
+        for (int i = 1; i < started; i++) pthread_join(handles[i], NULL);
+
+        if (ok && stats) fill_stats(p, stages, count, groups, now_ns() - t0, stats);
+    }
+
+    for (int i = 0; i < groups - 1; i++) simd_spsc_destroy(queues[i]);
+    simd_spsc_destroy(p->pool);
+    free(block);
+    free(frame);
+    free(p);
+    return ok;
+}
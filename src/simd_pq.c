@@ -0,0 +1,557 @@
+/**
+ * simd_pq.c
+ * Implementation of product quantization and 4-bit fast scan using NEON
+ *
+ * Training and encoding both come down to nearest-centroid assignment:
+ * with |x - c|^2 = |x|^2 + |c|^2 - 2 x.c and |x|^2 the same for every
+ * centroid, a block of subvectors is scored against all 16 centroids of
+ * its subquantizer with simd_dot_many_f32 and the minimum of |c|^2 - 2 x.c
+ * is taken four lanes at a time. Subquantizers train independently, so
+ * they run in parallel.
+ *
+ * Fast scan keeps the whole distance table of one subquantizer, quantized
+ * to bytes, in a single register. One vqtbl1q_u8 then looks up 16 codes
+ * at once; a block of 32 vectors stores its codes as nibbles so that the
+ * same 16 bytes feed the low and the high lookup. Sums are widened into
+ * 16-bit lanes, which holds 256 subquantizers of up to 255. The byte
+ * sums only rank candidates: the best few per result are re-scored with
+ * the float table, which removes most of the rounding of the byte table.
+ */
+#include "simd_pq.h"
+#include "simd_batch.h"
+#include "simd_ops.h"
+#include "simd_sched.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <arm_neon.h>
+
+// Subvectors assigned per simd_dot_many_f32 call
+#define ASSIGN_ROWS 256
+
+// Vectors fast-scanned between top-k updates (a multiple of SIMD_PQ_BLOCK)
+#define SCAN_CHUNK 1024
+
+// Relative nudge separating a split centroid from the one it copies
+#define SPLIT_EPS (1.0f / 1024.0f)
+
+struct simd_pq {
+    size_t dim;
+    size_t m;
+    size_t dsub;
+    simd_knn_metric_t metric;
+    float* centroids;           // m x 16 x dsub
+    float* norms;               // m x 16 squared centroid norms
+    bool trained;
+};
+
+simd_pq_t* simd_pq_create(size_t dim, size_t m, simd_knn_metric_t metric) {
+    if (m == 0 || m > 256 || dim % m != 0) return NULL;
+    if (metric != SIMD_KNN_L2 && metric != SIMD_KNN_INNER_PRODUCT) return NULL;
+
+    simd_pq_t* pq = (simd_pq_t*)calloc(1, sizeof(simd_pq_t));
+    if (!pq) return NULL;
+    pq->dim = dim;
+    pq->m = m;
+    pq->dsub = dim / m;
+    pq->metric = metric;
+    pq->centroids = (float*)neon_malloc(dim * SIMD_PQ_CENTROIDS * sizeof(float));
+    pq->norms = (float*)neon_malloc(m * SIMD_PQ_CENTROIDS * sizeof(float));
+    if (!pq->centroids || !pq->norms) {
+        simd_pq_destroy(pq);
+        return NULL;
+    }
+    return pq;
+}
+
+void simd_pq_destroy(simd_pq_t* pq) {
+    if (!pq) return;
+    free(pq->centroids);
+    free(pq->norms);
+    free(pq);
+}
+
+const float* simd_pq_centroid(const simd_pq_t* pq, size_t j, size_t c) {
+    if (!pq || !pq->trained || j >= pq->m || c >= SIMD_PQ_CENTROIDS) return NULL;
+    return pq->centroids + (j * SIMD_PQ_CENTROIDS + c) * pq->dsub;
+}
+
+size_t simd_pq_code_bytes(const simd_pq_t* pq, size_t n) {
+    if (!pq) return 0;
+    return (n + SIMD_PQ_BLOCK - 1) / SIMD_PQ_BLOCK * pq->m * 16;
+}
+
+static inline int code_at(const uint8_t* codes, size_t m, size_t i, size_t j) {
+    uint8_t byte = codes[(i / SIMD_PQ_BLOCK) * m * 16 + j * 16 + i % 16];
+    return i % SIMD_PQ_BLOCK < 16 ? byte & 0x0F : byte >> 4;
+}
+
+/*
+ * Assignment
+ */
+
+// Index of the smallest |c|^2 - 2 x.c over the 16 centroids
+static inline uint8_t nearest(const float* dots, const float* norms) {
+    float32x4_t d0 = vmlsq_n_f32(vld1q_f32(norms), vld1q_f32(dots), 2.0f);
+    float32x4_t d1 = vmlsq_n_f32(vld1q_f32(norms + 4), vld1q_f32(dots + 4), 2.0f);
+    float32x4_t d2 = vmlsq_n_f32(vld1q_f32(norms + 8), vld1q_f32(dots + 8), 2.0f);
+    float32x4_t d3 = vmlsq_n_f32(vld1q_f32(norms + 12), vld1q_f32(dots + 12), 2.0f);
+    float best = vminvq_f32(vminq_f32(vminq_f32(d0, d1), vminq_f32(d2, d3)));
+
+    float lanes[16];
+    vst1q_f32(lanes, d0);
+    vst1q_f32(lanes + 4, d1);
+    vst1q_f32(lanes + 8, d2);
+    vst1q_f32(lanes + 12, d3);
+    for (uint8_t c = 0; c < 16; c++) {
+        if (lanes[c] == best) return c;
+    }
+    return 0;
+}
+
+// CODES[i] = nearest centroid to row i of the N contiguous subvectors SUB
+static void assign(const float* sub, const float* centroids, const float* norms, uint8_t* codes,
+                   float* dots, size_t n, size_t dsub) {
+    for (size_t r0 = 0; r0 < n; r0 += ASSIGN_ROWS) {
+        size_t rows = n - r0 < ASSIGN_ROWS ? n - r0 : ASSIGN_ROWS;
+        simd_dot_many_f32(sub + r0 * dsub, centroids, dots, rows, SIMD_PQ_CENTROIDS, dsub);
+        for (size_t r = 0; r < rows; r++) {
+            codes[r0 + r] = nearest(dots + r * SIMD_PQ_CENTROIDS, norms);
+        }
+    }
+}
+
+static void update_norms(const float* centroids, float* norms, size_t dsub) {
+    for (int c = 0; c < SIMD_PQ_CENTROIDS; c++) {
+        norms[c] = simd_dot_product_f32(centroids + c * dsub, centroids + c * dsub, dsub);
+    }
+}
+
+// Copy subvector J of N vectors into contiguous rows
+static void gather(const simd_pq_t* pq, const float* vectors, size_t j, size_t n, float* sub) {
+    for (size_t i = 0; i < n; i++) {
+        memcpy(sub + i * pq->dsub, vectors + i * pq->dim + j * pq->dsub, pq->dsub * sizeof(float));
+    }
+}
+
+/*
+ * Training
+ */
+
+typedef struct {
+    simd_pq_t* pq;
+    const float* vectors;
+    size_t n;
+    int iterations;
+    atomic_int failed;
+} train_t;
+
+// Refill empty cluster C from the largest one, nudged apart
+static void split(float* centroids, size_t* counts, size_t c, size_t dsub) {
+    size_t largest = 0;
+    for (size_t i = 1; i < SIMD_PQ_CENTROIDS; i++) {
+        if (counts[i] > counts[largest]) largest = i;
+    }
+    float* from = centroids + largest * dsub;
+    float* to = centroids + c * dsub;
+    for (size_t e = 0; e < dsub; e++) {
+        float nudge = e % 2 == 0 ? SPLIT_EPS : -SPLIT_EPS;
+        to[e] = from[e] * (1.0f + nudge);
+        from[e] = from[e] * (1.0f - nudge);
+    }
+    counts[c] = counts[largest] / 2;
+    counts[largest] -= counts[c];
+}
+
+static inline float squared_distance(const float* a, const float* b, size_t len) {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        float32x4_t d = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+        acc = vmlaq_f32(acc, d, d);
+    }
+    float sum = vaddvq_f32(acc);
+    for (; i < len; i++) sum += (a[i] - b[i]) * (a[i] - b[i]);
+    return sum;
+}
+
+// k-means++ seeding: each centroid is a training subvector drawn with
+// probability proportional to its squared distance from the nearest
+// centroid chosen so far (from a fixed seed, so training is repeatable)
+static void seed(const float* sub, float* centroids, float* dist, size_t n, size_t dsub) {
+    uint32_t state = 0x9E3779B9u;
+    size_t pick = 0;
+
+    for (size_t c = 0; c < SIMD_PQ_CENTROIDS; c++) {
+        if (c > 0) {
+            double total = 0.0;
+            for (size_t i = 0; i < n; i++) total += dist[i];
+            state = state * 1664525u + 1013904223u;
+            double target = total * (double)(state >> 8) / 16777216.0;
+            for (pick = 0; pick + 1 < n && target >= dist[pick]; pick++) target -= dist[pick];
+        }
+        memcpy(centroids + c * dsub, sub + pick * dsub, dsub * sizeof(float));
+        for (size_t i = 0; i < n; i++) {
+            float d = squared_distance(sub + i * dsub, centroids + c * dsub, dsub);
+            if (c == 0 || d < dist[i]) dist[i] = d;
+        }
+    }
+}
+
+static bool train_subspace(train_t* t, size_t j) {
+    simd_pq_t* pq = t->pq;
+    size_t n = t->n, dsub = pq->dsub;
+    float* centroids = pq->centroids + j * SIMD_PQ_CENTROIDS * dsub;
+    float* norms = pq->norms + j * SIMD_PQ_CENTROIDS;
+
+    float* sub = (float*)neon_malloc(n * dsub * sizeof(float));
+    float* dots = (float*)neon_malloc(ASSIGN_ROWS * SIMD_PQ_CENTROIDS * sizeof(float));
+    float* sums = (float*)neon_malloc(SIMD_PQ_CENTROIDS * dsub * sizeof(float));
+    float* dist = (float*)malloc(n * sizeof(float));
+    uint8_t* codes = (uint8_t*)malloc(n);
+    bool ok = sub && dots && sums && dist && codes;
+
+    if (ok) {
+        gather(pq, t->vectors, j, n, sub);
+
+        seed(sub, centroids, dist, n, dsub);
+
+        for (int it = 0; it < t->iterations; it++) {
+            size_t counts[SIMD_PQ_CENTROIDS] = { 0 };
+            update_norms(centroids, norms, dsub);
+            assign(sub, centroids, norms, codes, dots, n, dsub);
+
+            memset(sums, 0, SIMD_PQ_CENTROIDS * dsub * sizeof(float));
+            for (size_t i = 0; i < n; i++) {
+                float* sum = sums + codes[i] * dsub;
+                simd_add_f32(sum, sub + i * dsub, sum, dsub);
+                counts[codes[i]]++;
+            }
+            for (size_t c = 0; c < SIMD_PQ_CENTROIDS; c++) {
+                if (counts[c] == 0) continue;
+                float inv = 1.0f / (float)counts[c];
+                for (size_t e = 0; e < dsub; e++) centroids[c * dsub + e] = sums[c * dsub + e] * inv;
+            }
+            for (size_t c = 0; c < SIMD_PQ_CENTROIDS; c++) {
+                if (counts[c] == 0) split(centroids, counts, c, dsub);
+            }
+        }
+        update_norms(centroids, norms, dsub);
+    }
+
+    free(sub);
+    free(dots);
+    free(sums);
+    free(dist);
+    free(codes);
+    return ok;
+}
+
+static void train_range(void* ctx, size_t begin, size_t end) {
+    train_t* t = (train_t*)ctx;
+    for (size_t j = begin; j < end; j++) {
+        if (!train_subspace(t, j)) atomic_store(&t->failed, 1);
+    }
+}
+
+bool simd_pq_train(simd_pq_t* pq, const float* vectors, size_t n, int iterations) {
+    if (!pq || !vectors || n < SIMD_PQ_CENTROIDS || iterations < 0) return false;
+
+    train_t t = { pq, vectors, n, iterations, 0 };
+    simd_parallel_for(0, pq->m, 1, train_range, &t);
+    pq->trained = atomic_load(&t.failed) == 0;
+    return pq->trained;
+}
+
+/*
+ * Encoding
+ */
+
+typedef struct {
+    const simd_pq_t* pq;
+    const float* vectors;
+    uint8_t* codes;
+    size_t n;
+    atomic_int failed;
+} encode_t;
+
+static void encode_range(void* ctx, size_t begin, size_t end) {
+    encode_t* e = (encode_t*)ctx;
+    const simd_pq_t* pq = e->pq;
+    size_t dsub = pq->dsub;
+    float dots[SIMD_PQ_BLOCK * SIMD_PQ_CENTROIDS];
+    float* rows = (float*)neon_malloc(SIMD_PQ_BLOCK * dsub * sizeof(float));
+    if (!rows) {
+        atomic_store(&e->failed, 1);
+        return;
+    }
+
+    for (size_t b = begin; b < end; b++) {
+        size_t first = b * SIMD_PQ_BLOCK;
+        size_t count = e->n - first < SIMD_PQ_BLOCK ? e->n - first : SIMD_PQ_BLOCK;
+        uint8_t* out = e->codes + b * pq->m * 16;
+
+        for (size_t j = 0; j < pq->m; j++) {
+            uint8_t codes[SIMD_PQ_BLOCK] = { 0 };
+            gather(pq, e->vectors + first * pq->dim, j, count, rows);
+            assign(rows, pq->centroids + j * SIMD_PQ_CENTROIDS * dsub, pq->norms + j * SIMD_PQ_CENTROIDS,
+                   codes, dots, count, dsub);
+            for (int i = 0; i < 16; i++) out[j * 16 + i] = (uint8_t)(codes[i] | codes[16 + i] << 4);
+        }
+    }
+    free(rows);
+}
+
+bool simd_pq_encode(const simd_pq_t* pq, const float* vectors, uint8_t* codes, size_t n) {
+    if (!pq || !pq->trained || (!vectors && n > 0) || !codes) return false;
+
+    encode_t e = { pq, vectors, codes, n, 0 };
+    simd_parallel_for(0, (n + SIMD_PQ_BLOCK - 1) / SIMD_PQ_BLOCK, 0, encode_range, &e);
+    return atomic_load(&e.failed) == 0;
+}
+
+void simd_pq_decode(const simd_pq_t* pq, const uint8_t* codes, float* vector, size_t i) {
+    if (!pq || !pq->trained || !codes || !vector) return;
+    for (size_t j = 0; j < pq->m; j++) {
+        const float* c = simd_pq_centroid(pq, j, (size_t)code_at(codes, pq->m, i, j));
+        memcpy(vector + j * pq->dsub, c, pq->dsub * sizeof(float));
+    }
+}
+
+/*
+ * Distance Tables
+ */
+
+void simd_pq_table(const simd_pq_t* pq, const float* query, float* table) {
+    if (!pq || !pq->trained || !query || !table) return;
+    size_t dsub = pq->dsub;
+
+    for (size_t j = 0; j < pq->m; j++) {
+        const float* q = query + j * dsub;
+        float* t = table + j * SIMD_PQ_CENTROIDS;
+        simd_dot_many_f32(q, pq->centroids + j * SIMD_PQ_CENTROIDS * dsub, t, 1, SIMD_PQ_CENTROIDS, dsub);
+
+        const float* norms = pq->norms + j * SIMD_PQ_CENTROIDS;
+        float32x4_t qn = vdupq_n_f32(simd_dot_product_f32(q, q, dsub));
+        for (int c = 0; c < SIMD_PQ_CENTROIDS; c += 4) {
+            float32x4_t dot = vld1q_f32(t + c);
+            float32x4_t d = pq->metric == SIMD_KNN_L2 ? vmlsq_n_f32(vaddq_f32(qn, vld1q_f32(norms + c)), dot, 2.0f) :
+                                                        vnegq_f32(dot);
+            vst1q_f32(t + c, d);
+        }
+    }
+}
+
+void simd_pq_lut_u8(const float* table, uint8_t* lut, float* scale, float* bias, size_t m) {
+    if (!table || !lut || !scale || !bias) return;
+
+    // One scale for all subquantizers (so byte sums stay comparable), one offset each
+    float range = 0.0f, offset = 0.0f;
+    for (size_t j = 0; j < m; j++) {
+        const float* t = table + j * SIMD_PQ_CENTROIDS;
+        float32x4_t lo = vminq_f32(vminq_f32(vld1q_f32(t), vld1q_f32(t + 4)), vminq_f32(vld1q_f32(t + 8), vld1q_f32(t + 12)));
+        float32x4_t hi = vmaxq_f32(vmaxq_f32(vld1q_f32(t), vld1q_f32(t + 4)), vmaxq_f32(vld1q_f32(t + 8), vld1q_f32(t + 12)));
+        float min = vminvq_f32(lo), max = vmaxvq_f32(hi);
+        range = max - min > range ? max - min : range;
+        offset += min;
+    }
+    *scale = range > 0.0f ? range / 255.0f : 1.0f;
+    *bias = offset;
+
+    float inv = 1.0f / *scale;
+    for (size_t j = 0; j < m; j++) {
+        const float* t = table + j * SIMD_PQ_CENTROIDS;
+        float32x4_t lo = vminq_f32(vminq_f32(vld1q_f32(t), vld1q_f32(t + 4)), vminq_f32(vld1q_f32(t + 8), vld1q_f32(t + 12)));
+        float32x4_t min = vdupq_n_f32(vminvq_f32(lo));
+        uint32x4_t q[4];
+        for (int c = 0; c < 4; c++) q[c] = vcvtnq_u32_f32(vmulq_n_f32(vsubq_f32(vld1q_f32(t + 4 * c), min), inv));
+        uint16x8_t q01 = vcombine_u16(vqmovn_u32(q[0]), vqmovn_u32(q[1]));
+        uint16x8_t q23 = vcombine_u16(vqmovn_u32(q[2]), vqmovn_u32(q[3]));
+        vst1q_u8(lut + j * SIMD_PQ_CENTROIDS, vcombine_u8(vqmovn_u16(q01), vqmovn_u16(q23)));
+    }
+}
+
+/*
+ * Fast Scan
+ */
+
+void simd_pq_scan_u8(const uint8_t* lut, const uint8_t* codes, uint16_t* out, size_t m, size_t n) {
+    if (!lut || !codes || !out) return;
+    uint8x16_t low = vdupq_n_u8(0x0F);
+
+    for (size_t first = 0; first < n; first += SIMD_PQ_BLOCK) {
+        const uint8_t* block = codes + first / SIMD_PQ_BLOCK * m * 16;
+        uint16x8_t acc0 = vdupq_n_u16(0);
+        uint16x8_t acc1 = vdupq_n_u16(0);
+        uint16x8_t acc2 = vdupq_n_u16(0);
+        uint16x8_t acc3 = vdupq_n_u16(0);
+
+        for (size_t j = 0; j < m; j++) {
+            uint8x16_t table = vld1q_u8(lut + j * 16);
+            uint8x16_t c = vld1q_u8(block + j * 16);
+
+            // Vectors 0-15 from the low nibbles, 16-31 from the high ones
+            uint8x16_t d_lo = vqtbl1q_u8(table, vandq_u8(c, low));
+            uint8x16_t d_hi = vqtbl1q_u8(table, vshrq_n_u8(c, 4));
+            acc0 = vaddw_u8(acc0, vget_low_u8(d_lo));
+            acc1 = vaddw_u8(acc1, vget_high_u8(d_lo));
+            acc2 = vaddw_u8(acc2, vget_low_u8(d_hi));
+            acc3 = vaddw_u8(acc3, vget_high_u8(d_hi));
+        }
+
+        if (n - first >= SIMD_PQ_BLOCK) {
+            vst1q_u16(out + first, acc0);
+            vst1q_u16(out + first + 8, acc1);
+            vst1q_u16(out + first + 16, acc2);
+            vst1q_u16(out + first + 24, acc3);
+        } else {
+            uint16_t sums[SIMD_PQ_BLOCK];
+            vst1q_u16(sums, acc0);
+            vst1q_u16(sums + 8, acc1);
+            vst1q_u16(sums + 16, acc2);
+            vst1q_u16(sums + 24, acc3);
+            memcpy(out + first, sums, (n - first) * sizeof(uint16_t));
+        }
+    }
+}
+
+/*
+ * Search
+ * Candidates are kept in a bounded max-heap on the byte sums.
+ */
+
+typedef struct {
+    uint16_t* key;
+    int64_t* id;
+    size_t size;
+    size_t cap;
+} candidates_t;
+
+static void cand_sift_down(candidates_t* h, size_t i) {
+    uint16_t key = h->key[i];
+    int64_t id = h->id[i];
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= h->size) break;
+        if (child + 1 < h->size && h->key[child + 1] > h->key[child]) child++;
+        if (h->key[child] <= key) break;
+        h->key[i] = h->key[child];
+        h->id[i] = h->id[child];
+        i = child;
+    }
+    h->key[i] = key;
+    h->id[i] = id;
+}
+
+static void cand_push(candidates_t* h, uint16_t key, int64_t id) {
+    if (h->size < h->cap) {
+        size_t i = h->size++;
+        while (i > 0 && h->key[(i - 1) / 2] < key) {
+            h->key[i] = h->key[(i - 1) / 2];
+            h->id[i] = h->id[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        h->key[i] = key;
+        h->id[i] = id;
+    } else if (key < h->key[0]) {
+        h->key[0] = key;
+        h->id[0] = id;
+        cand_sift_down(h, 0);
+    }
+}
+
+typedef struct {
+    const simd_pq_t* pq;
+    const uint8_t* codes;
+    const float* queries;
+    int64_t* ids;
+    float* scores;
+    size_t n;
+    size_t k;
+    atomic_int failed;
+} search_t;
+
+typedef struct {
+    float* table;
+    uint8_t* lut;
+    uint16_t* sums;
+    candidates_t cand;
+    float* dist;
+    int64_t* pick;
+} scratch_t;
+
+static void search_query(const search_t* s, scratch_t* w, size_t q) {
+    const simd_pq_t* pq = s->pq;
+    float scale, bias;
+    simd_pq_table(pq, s->queries + q * pq->dim, w->table);
+    simd_pq_lut_u8(w->table, w->lut, &scale, &bias, pq->m);
+
+    // Fast scan, dropping groups of eight that cannot enter a full heap
+    w->cand.size = 0;
+    for (size_t first = 0; first < s->n; first += SCAN_CHUNK) {
+        size_t rows = s->n - first < SCAN_CHUNK ? s->n - first : SCAN_CHUNK;
+        simd_pq_scan_u8(w->lut, s->codes + first / SIMD_PQ_BLOCK * pq->m * 16, w->sums, pq->m, rows);
+
+        size_t i = 0;
+        for (; i + 8 <= rows; i += 8) {
+            if (w->cand.size == w->cand.cap) {
+                uint16x8_t better = vcltq_u16(vld1q_u16(w->sums + i), vdupq_n_u16(w->cand.key[0]));
+                if (vmaxvq_u16(better) == 0) continue;
+            }
+            for (size_t l = i; l < i + 8; l++) cand_push(&w->cand, w->sums[l], (int64_t)(first + l));
+        }
+        for (; i < rows; i++) cand_push(&w->cand, w->sums[i], (int64_t)(first + i));
+    }
+
+    // Re-rank the candidates with the float table
+    for (size_t c = 0; c < w->cand.size; c++) {
+        size_t id = (size_t)w->cand.id[c];
+        float d = 0.0f;
+        for (size_t j = 0; j < pq->m; j++) d += w->table[j * SIMD_PQ_CENTROIDS + code_at(s->codes, pq->m, id, j)];
+        w->dist[c] = d;
+    }
+    int64_t* ids = s->ids + q * s->k;
+    float* scores = s->scores + q * s->k;
+    simd_knn_select(w->dist, w->pick, scores, w->cand.size, s->k);
+    for (size_t r = 0; r < s->k; r++) {
+        ids[r] = w->pick[r] < 0 ? -1 : w->cand.id[w->pick[r]];
+        if (pq->metric != SIMD_KNN_L2) scores[r] = -scores[r];
+    }
+}
+
+static void search_range(void* ctx, size_t begin, size_t end) {
+    search_t* s = (search_t*)ctx;
+    size_t m = s->pq->m, cap = s->k * SIMD_PQ_RERANK;
+    scratch_t w;
+    w.table = (float*)neon_malloc(m * SIMD_PQ_CENTROIDS * sizeof(float));
+    w.lut = (uint8_t*)neon_malloc(m * SIMD_PQ_CENTROIDS);
+    w.sums = (uint16_t*)neon_malloc(SCAN_CHUNK * sizeof(uint16_t));
+    w.cand.key = (uint16_t*)malloc(cap * sizeof(uint16_t));
+    w.cand.id = (int64_t*)malloc(cap * sizeof(int64_t));
+    w.cand.cap = cap;
+    w.dist = (float*)malloc(cap * sizeof(float));
+    w.pick = (int64_t*)malloc(s->k * sizeof(int64_t));
+
+    if (w.table && w.lut && w.sums && w.cand.key && w.cand.id && w.dist && w.pick) {
+        for (size_t q = begin; q < end; q++) search_query(s, &w, q);
+    } else {
+        atomic_store(&s->failed, 1);
+    }
+    free(w.table);
+    free(w.lut);
+    free(w.sums);
+    free(w.cand.key);
+    free(w.cand.id);
+    free(w.dist);
+    free(w.pick);
+}
+
+bool simd_pq_search(const simd_pq_t* pq, const uint8_t* codes, const float* queries, int64_t* ids,
+                    float* scores, size_t n, size_t nq, size_t k) {
+    if (!pq || !pq->trained || (!codes && n > 0) || !queries || !ids || !scores || k == 0) return false;
+
+    search_t s = { pq, codes, queries, ids, scores, n, k, 0 };
+    simd_parallel_for(0, nq, 1, search_range, &s);
+    return atomic_load(&s.failed) == 0;
+}
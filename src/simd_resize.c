@@ -0,0 +1,907 @@
+/**
+ * simd_resize.c
+ * Implementation of image resizing using NEON
+ *
+ * Multi-channel pixels are split into channel planes with vld3/vld4 so the
+ * same lane arithmetic serves gray, RGB and RGBA, and the 2x kernels pick
+ * even and odd pixels with pairwise adds or vuzp instead of gathers.
+ * Arbitrary ratios are separable: interpolation offsets and fixed-point
+ * weights are tabulated once per call, every source row that is needed is
+ * filtered horizontally exactly once, and the vertical blend of those rows
+ * - which touches every output value - runs 16 values at a time. The
+ * horizontal pass gathers its taps with table lookups into a short window
+ * of the source row, so it too runs 16 (or 8) output values at a time.
+ */
+#include "simd_resize.h"
+#include "simd_border.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <arm_neon.h>
+
+static inline int valid_channels(int channels) {
+    return channels == 1 || channels == 3 || channels == 4;
+}
+
+/*
+ * Channel Planes
+ */
+
+// Load 16 pixels as one 16-lane plane per channel
+static inline void load_planes_u8x16(const uint8_t* p, int channels, uint8x16_t* planes) {
+    if (channels == 1) {
+        planes[0] = vld1q_u8(p);
+    } else if (channels == 3) {
+        uint8x16x3_t t = vld3q_u8(p);
+        planes[0] = t.val[0];
+        planes[1] = t.val[1];
+        planes[2] = t.val[2];
+    } else {
+        uint8x16x4_t t = vld4q_u8(p);
+        planes[0] = t.val[0];
+        planes[1] = t.val[1];
+        planes[2] = t.val[2];
+        planes[3] = t.val[3];
+    }
+}
+
+// Load 8 pixels as one 8-lane plane per channel
+static inline void load_planes_u16x8(const uint16_t* p, int channels, uint16x8_t* planes) {
+    if (channels == 1) {
+        planes[0] = vld1q_u16(p);
+    } else if (channels == 3) {
+        uint16x8x3_t t = vld3q_u16(p);
+        planes[0] = t.val[0];
+        planes[1] = t.val[1];
+        planes[2] = t.val[2];
+    } else {
+        uint16x8x4_t t = vld4q_u16(p);
+        planes[0] = t.val[0];
+        planes[1] = t.val[1];
+        planes[2] = t.val[2];
+        planes[3] = t.val[3];
+    }
+}
+
+// Store 8 pixels from 8-lane planes
+static inline void store_planes_u8x8(uint8_t* p, int channels, const uint8x8_t* planes) {
+    if (channels == 1) {
+        vst1_u8(p, planes[0]);
+    } else if (channels == 3) {
+        uint8x8x3_t t = { { planes[0], planes[1], planes[2] } };
+        vst3_u8(p, t);
+    } else {
+        uint8x8x4_t t = { { planes[0], planes[1], planes[2], planes[3] } };
+        vst4_u8(p, t);
+    }
+}
+
+// Store 16 pixels from 16-lane planes
+static inline void store_planes_u8x16(uint8_t* p, int channels, const uint8x16_t* planes) {
+    if (channels == 1) {
+        vst1q_u8(p, planes[0]);
+    } else if (channels == 3) {
+        uint8x16x3_t t = { { planes[0], planes[1], planes[2] } };
+        vst3q_u8(p, t);
+    } else {
+        uint8x16x4_t t = { { planes[0], planes[1], planes[2], planes[3] } };
+        vst4q_u8(p, t);
+    }
+}
+
+/*
+ * 2x Box Downsampling
+ */
+
+static void downsample2x(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                         int width, int height, int channels) {
+    int dst_width = width / 2;
+    int dst_height = height / 2;
+
+    for (int y = 0; y < dst_height; y++) {
+        const uint8_t* r0 = src + (size_t)(2 * y) * src_stride;
+        const uint8_t* r1 = r0 + src_stride;
+        uint8_t* out = dst + (size_t)y * dst_stride;
+
+        // Process 8 output pixels at a time using NEON: pairwise-add the
+        // top row, accumulate the bottom row and round (a + b + c + d + 2) / 4.
+        // vrhadd of vrhadd would round twice and bias the result upwards.
+        size_t vec_size = (size_t)dst_width / 8;
+
+        for (size_t i = 0; i < vec_size; i++) {
+            size_t x = i * 8;
+            uint8x16_t top[4], bottom[4];
+            uint8x8_t o[4];
+            load_planes_u8x16(r0 + 2 * x * channels, channels, top);
+            load_planes_u8x16(r1 + 2 * x * channels, channels, bottom);
+            for (int c = 0; c < channels; c++) {
+                uint16x8_t s = vpadalq_u8(vpaddlq_u8(top[c]), bottom[c]);
+                o[c] = vrshrn_n_u16(s, 2);
+            }
+            store_planes_u8x8(out + x * channels, channels, o);
+        }
+
+        // Handle remaining pixels
+        for (size_t x = vec_size * 8; x < (size_t)dst_width; x++) {
+            for (int c = 0; c < channels; c++) {
+                size_t a = 2 * x * channels + c;
+                size_t b = a + channels;
+                out[x * channels + c] = (uint8_t)((r0[a] + r0[b] + r1[a] + r1[b] + 2) >> 2);
+            }
+        }
+    }
+}
+
+void simd_downsample2x_u8(const uint8_t* src, uint8_t* dst, int width, int height, int channels) {
+    if (!valid_channels(channels) || width / 2 <= 0 || height / 2 <= 0) return;
+    downsample2x(src, (size_t)width * channels, dst, (size_t)(width / 2) * channels, width, height, channels);
+}
+
+/*
+ * Gaussian Pyramid
+ */
+
+// Copy border pixels of a widened row from the reflected interior pixels;
+// ROW points at pixel 0 and has `left` / `right` pixels of padding
+static void reflect_row_border_u16(uint16_t* row, int width, int channels, int left, int right) {
+    for (int p = -left; p < width + right; p++) {
+        if (p == 0) p = width;
+        int q = simd_border_index(p, width, SIMD_BORDER_REFLECT);
+        for (int c = 0; c < channels; c++) {
+            row[p * channels + c] = row[q * channels + c];
+        }
+    }
+}
+
+// Even (E) and odd (O) pixels of 16 consecutive pixels starting at P
+static inline void load_even_odd_u16(const uint16_t* p, int channels, uint16x8_t* even, uint16x8_t* odd) {
+    uint16x8_t a[4], b[4];
+    load_planes_u16x8(p, channels, a);
+    load_planes_u16x8(p + 8 * channels, channels, b);
+    for (int c = 0; c < channels; c++) {
+        even[c] = vuzp1q_u16(a[c], b[c]);
+        if (odd) odd[c] = vuzp2q_u16(a[c], b[c]);
+    }
+}
+
+static void pyr_down(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                     int width, int height, int channels) {
+    int dst_width = (width + 1) / 2;
+    int dst_height = (height + 1) / 2;
+    size_t n = (size_t)width * channels;
+
+    // Vertically filtered row with 2 reflected pixels on each side
+    uint16_t* vrow = (uint16_t*)neon_malloc((size_t)(width + 4) * channels * sizeof(uint16_t));
+    if (!vrow) return;
+    uint16_t* v = vrow + 2 * channels;
+    const uint8x8_t six = vdup_n_u8(6);
+
+    for (int y = 0; y < dst_height; y++) {
+        const uint8_t* r[5];
+        for (int k = 0; k < 5; k++) {
+            r[k] = src + (size_t)simd_border_index(2 * y - 2 + k, height, SIMD_BORDER_REFLECT) * src_stride;
+        }
+
+        // Vertical [1 4 6 4 1]: at most 16 * 255, so it stays in 16 bits
+        size_t vec_size = n / 16;
+
+        for (size_t i = 0; i < vec_size; i++) {
+            size_t j = i * 16;
+            uint8x16_t a = vld1q_u8(r[0] + j);
+            uint8x16_t b = vld1q_u8(r[1] + j);
+            uint8x16_t c = vld1q_u8(r[2] + j);
+            uint8x16_t d = vld1q_u8(r[3] + j);
+            uint8x16_t e = vld1q_u8(r[4] + j);
+
+            uint16x8_t lo = vaddl_u8(vget_low_u8(a), vget_low_u8(e));
+            uint16x8_t hi = vaddl_high_u8(a, e);
+            lo = vaddq_u16(lo, vshlq_n_u16(vaddl_u8(vget_low_u8(b), vget_low_u8(d)), 2));
+            hi = vaddq_u16(hi, vshlq_n_u16(vaddl_high_u8(b, d), 2));
+            lo = vmlal_u8(lo, vget_low_u8(c), six);
+            hi = vmlal_high_u8(hi, c, vcombine_u8(six, six));
+            vst1q_u16(v + j, lo);
+            vst1q_u16(v + j + 8, hi);
+        }
+
+        // Handle remaining values
+        for (size_t j = vec_size * 16; j < n; j++) {
+            v[j] = (uint16_t)(r[0][j] + r[4][j] + 4 * (r[1][j] + r[3][j]) + 6 * r[2][j]);
+        }
+
+        reflect_row_border_u16(v, width, channels, 2, 2);
+
+        // Horizontal [1 4 6 4 1] at even pixels only: at most 256 * 255
+        uint8_t* out = dst + (size_t)y * dst_stride;
+        int x = 0;
+
+        // Process 8 output pixels at a time using NEON
+        for (; 2 * x + 16 <= width; x += 8) {
+            const uint16_t* p = v + (ptrdiff_t)(2 * x - 2) * channels;
+            uint16x8_t em[4], om[4], e0[4], o0[4], ep[4];
+            uint8x8_t o[4];
+            load_even_odd_u16(p, channels, em, om);
+            load_even_odd_u16(p + 2 * channels, channels, e0, o0);
+            load_even_odd_u16(p + 4 * channels, channels, ep, NULL);
+            for (int c = 0; c < channels; c++) {
+                uint16x8_t s = vaddq_u16(em[c], ep[c]);
+                s = vaddq_u16(s, vshlq_n_u16(vaddq_u16(om[c], o0[c]), 2));
+                s = vmlaq_n_u16(s, e0[c], 6);
+                o[c] = vrshrn_n_u16(s, 8);
+            }
+            store_planes_u8x8(out + (size_t)x * channels, channels, o);
+        }
+
+        // Handle remaining pixels
+        for (; x < dst_width; x++) {
+            const uint16_t* p = v + (ptrdiff_t)(2 * x) * channels;
+            for (int c = 0; c < channels; c++) {
+                uint32_t s = p[c - 2 * channels] + p[c + 2 * channels] +
+                             4 * (p[c - channels] + p[c + channels]) + 6 * p[c];
+                out[(size_t)x * channels + c] = (uint8_t)((s + 128) >> 8);
+            }
+        }
+    }
+
+    free(vrow);
+}
+
+void simd_pyr_down_u8(const uint8_t* src, uint8_t* dst, int width, int height, int channels) {
+    if (!valid_channels(channels) || width <= 0 || height <= 0) return;
+    pyr_down(src, (size_t)width * channels, dst, (size_t)((width + 1) / 2) * channels, width, height, channels);
+}
+
+// Horizontal pyrUp pass: even outputs [1 6 1] / 8, odd outputs [4 4] / 8
+// around source pixel x, applied to a vertically filtered row (also / 8)
+static void pyr_up_row(const uint16_t* v, uint8_t* out, int width, int channels) {
+    int x = 0;
+
+    // Process 8 source pixels (16 output pixels) at a time using NEON
+    for (; x + 8 <= width; x += 8) {
+        const uint16_t* p = v + (size_t)x * channels;
+        uint16x8_t vm[4], v0[4], vp[4];
+        uint8x16_t o[4];
+        load_planes_u16x8(p - channels, channels, vm);
+        load_planes_u16x8(p, channels, v0);
+        load_planes_u16x8(p + channels, channels, vp);
+        for (int c = 0; c < channels; c++) {
+            uint16x8_t even = vmlaq_n_u16(vaddq_u16(vm[c], vp[c]), v0[c], 6);
+            uint16x8_t odd = vshlq_n_u16(vaddq_u16(v0[c], vp[c]), 2);
+            o[c] = vcombine_u8(vrshrn_n_u16(vzip1q_u16(even, odd), 6),
+                               vrshrn_n_u16(vzip2q_u16(even, odd), 6));
+        }
+        store_planes_u8x16(out + (size_t)(2 * x) * channels, channels, o);
+    }
+
+    // Handle remaining pixels
+    for (; x < width; x++) {
+        const uint16_t* p = v + (size_t)x * channels;
+        uint8_t* q = out + (size_t)(2 * x) * channels;
+        for (int c = 0; c < channels; c++) {
+            uint32_t even = p[c - channels] + p[c + channels] + 6 * p[c];
+            uint32_t odd = 4 * (p[c] + p[c + channels]);
+            q[c] = (uint8_t)((even + 32) >> 6);
+            q[c + channels] = (uint8_t)((odd + 32) >> 6);
+        }
+    }
+}
+
+static void pyr_up(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                   int width, int height, int channels) {
+    size_t n = (size_t)width * channels;
+
+    // Vertically filtered even and odd output rows, 1 reflected pixel each side
+    size_t padded = (size_t)(width + 2) * channels;
+    uint16_t* buf = (uint16_t*)neon_malloc(2 * padded * sizeof(uint16_t));
+    if (!buf) return;
+    uint16_t* ve = buf + channels;
+    uint16_t* vo = buf + padded + channels;
+    const uint8x8_t six = vdup_n_u8(6);
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* rm = src + (size_t)simd_border_index(y - 1, height, SIMD_BORDER_REFLECT) * src_stride;
+        const uint8_t* r0 = src + (size_t)y * src_stride;
+        const uint8_t* rp = src + (size_t)simd_border_index(y + 1, height, SIMD_BORDER_REFLECT) * src_stride;
+
+        // Process 16 values at a time using NEON
+        size_t vec_size = n / 16;
+
+        for (size_t i = 0; i < vec_size; i++) {
+            size_t j = i * 16;
+            uint8x16_t a = vld1q_u8(rm + j);
+            uint8x16_t b = vld1q_u8(r0 + j);
+            uint8x16_t c = vld1q_u8(rp + j);
+
+            uint16x8_t e_lo = vmlal_u8(vaddl_u8(vget_low_u8(a), vget_low_u8(c)), vget_low_u8(b), six);
+            uint16x8_t e_hi = vmlal_high_u8(vaddl_high_u8(a, c), b, vcombine_u8(six, six));
+            vst1q_u16(ve + j, e_lo);
+            vst1q_u16(ve + j + 8, e_hi);
+            vst1q_u16(vo + j, vshlq_n_u16(vaddl_u8(vget_low_u8(b), vget_low_u8(c)), 2));
+            vst1q_u16(vo + j + 8, vshlq_n_u16(vaddl_high_u8(b, c), 2));
+        }
+
+        // Handle remaining values
+        for (size_t j = vec_size * 16; j < n; j++) {
+            ve[j] = (uint16_t)(rm[j] + rp[j] + 6 * r0[j]);
+            vo[j] = (uint16_t)(4 * (r0[j] + rp[j]));
+        }
+
+        reflect_row_border_u16(ve, width, channels, 1, 1);
+        reflect_row_border_u16(vo, width, channels, 1, 1);
+
+        uint8_t* out = dst + (size_t)(2 * y) * dst_stride;
+        pyr_up_row(ve, out, width, channels);
+        pyr_up_row(vo, out + dst_stride, width, channels);
+    }
+
+    free(buf);
+}
+
+void simd_pyr_up_u8(const uint8_t* src, uint8_t* dst, int width, int height, int channels) {
+    if (!valid_channels(channels) || width <= 0 || height <= 0) return;
+    pyr_up(src, (size_t)width * channels, dst, (size_t)(2 * width) * channels, width, height, channels);
+}
+
+/*
+ * Horizontal Gathers
+ */
+
+// Output values of a horizontal pass are taken in groups of 16, or 8 when
+// shrinking too far for 16 to fit. Each group reads one window of at most
+// 64 source bytes and picks tap 0 of every value out of it with a single
+// table lookup; tap k lies k pixels further right, so it reuses the same
+// indexes on the window moved by k * channels. Groups whose window would
+// run past the row are left, with the tail, to the scalar loop.
+typedef struct {
+    int values;         // Values per group: 16, 8, or 0 for scalar only
+    int tables;         // 16-byte registers per window (1 to 4)
+    size_t groups;      // Leading groups served by table lookups
+    int32_t* base;      // Window start per group
+    uint8_t* index;     // 16 window indexes per group, 255 past VALUES
+} gather_plan_t;
+
+static void gather_plan_free(gather_plan_t* g) {
+    free(g->base);
+    free(g->index);
+}
+
+// OFFSET[j] is the source byte of tap 0 for output value j; later taps
+// read up to SHIFT bytes past the window. Returns 0 on allocation failure.
+static int gather_plan_init(gather_plan_t* g, const int32_t* offset, size_t n, size_t row_bytes, size_t shift) {
+    memset(g, 0, sizeof(*g));
+
+    for (int values = 16; values >= 8 && !g->values; values /= 2) {
+        int32_t span = 0;
+        for (size_t j = 0; j + values <= n; j += values) {
+            int32_t lo = offset[j], hi = offset[j];
+            for (int v = 1; v < values; v++) {
+                if (offset[j + v] < lo) lo = offset[j + v];
+                if (offset[j + v] > hi) hi = offset[j + v];
+            }
+            if (hi - lo + 1 > span) span = hi - lo + 1;
+        }
+        if (span > 0 && span <= 64) {
+            g->values = values;
+            g->tables = (span + 15) / 16;
+        }
+    }
+    if (!g->values) return 1;
+
+    size_t total = n / g->values;
+    size_t window = (size_t)g->tables * 16;
+    g->base = (int32_t*)malloc(total * sizeof(int32_t));
+    g->index = (uint8_t*)malloc(total * 16);
+    if (!g->base || !g->index) {
+        gather_plan_free(g);
+        return 0;
+    }
+
+    for (size_t i = 0; i < total; i++) {
+        const int32_t* o = offset + i * g->values;
+        int32_t lo = o[0];
+        for (int v = 1; v < g->values; v++) {
+            if (o[v] < lo) lo = o[v];
+        }
+        if ((size_t)lo + shift + window > row_bytes) break;
+
+        g->base[i] = lo;
+        for (int v = 0; v < 16; v++) {
+            g->index[i * 16 + v] = (uint8_t)(v < g->values ? o[v] - lo : 255);
+        }
+        g->groups++;
+    }
+    return 1;
+}
+
+// Look INDEX up in the window of TABLES registers at P; out of range gives 0
+static inline uint8x16_t window_lookup(const uint8_t* p, int tables, uint8x16_t index) {
+    if (tables == 1) return vqtbl1q_u8(vld1q_u8(p), index);
+    if (tables == 2) {
+        uint8x16x2_t t = { { vld1q_u8(p), vld1q_u8(p + 16) } };
+        return vqtbl2q_u8(t, index);
+    }
+    if (tables == 3) {
+        uint8x16x3_t t = { { vld1q_u8(p), vld1q_u8(p + 16), vld1q_u8(p + 32) } };
+        return vqtbl3q_u8(t, index);
+    }
+    uint8x16x4_t t = { { vld1q_u8(p), vld1q_u8(p + 16), vld1q_u8(p + 32), vld1q_u8(p + 48) } };
+    return vqtbl4q_u8(t, index);
+}
+
+/*
+ * Bilinear Resize
+ */
+
+#define BILINEAR_BITS 8
+#define BILINEAR_ONE (1 << BILINEAR_BITS)
+
+// Source offsets and weights of one output coordinate
+typedef struct {
+    int32_t ofs0;
+    int32_t ofs1;
+    uint16_t w0;
+    uint16_t w1;
+} bilinear_tap_t;
+
+// Taps for every output coordinate; offsets are source index * step
+static void bilinear_taps(int src_n, int dst_n, int step, bilinear_tap_t* taps) {
+    double scale = (double)src_n / dst_n;
+
+    for (int i = 0; i < dst_n; i++) {
+        double s = (i + 0.5) * scale - 0.5;
+        if (s < 0.0) s = 0.0;
+
+        int i0 = (int)s;
+        int f = (int)lround((s - i0) * BILINEAR_ONE);
+        if (f == BILINEAR_ONE) {
+            i0++;
+            f = 0;
+        }
+        if (i0 >= src_n - 1) {
+            i0 = src_n - 1;
+            f = 0;
+        }
+        int i1 = i0 + 1 < src_n ? i0 + 1 : i0;
+
+        taps[i].ofs0 = i0 * step;
+        taps[i].ofs1 = i1 * step;
+        taps[i].w0 = (uint16_t)(BILINEAR_ONE - f);
+        taps[i].w1 = (uint16_t)f;
+    }
+}
+
+// Horizontal pass of one source row; results carry 8 fraction bits.
+// WEIGHTS holds w1 (< 256) for the 16 lanes of each gather group.
+static void bilinear_row(const uint8_t* src, uint16_t* out, const bilinear_tap_t* taps,
+                         const gather_plan_t* g, const uint8_t* weights, int dst_width, int channels) {
+    // Process 16 (or 8) values at a time using NEON: a * (256 - w1) + b * w1
+    // as (a << 8) - a * w1 + b * w1, so the weights fit in bytes. Where the
+    // right tap is clamped to the left one, w1 is 0.
+    for (size_t i = 0; i < g->groups; i++) {
+        const uint8_t* p = src + g->base[i];
+        uint8x16_t index = vld1q_u8(g->index + i * 16);
+        uint8x16_t a = window_lookup(p, g->tables, index);
+        uint8x16_t b = window_lookup(p + channels, g->tables, index);
+        uint8x16_t w = vld1q_u8(weights + i * 16);
+        uint16_t* o = out + i * g->values;
+
+        uint16x8_t lo = vshll_n_u8(vget_low_u8(a), BILINEAR_BITS);
+        lo = vmlal_u8(vmlsl_u8(lo, vget_low_u8(a), vget_low_u8(w)), vget_low_u8(b), vget_low_u8(w));
+        vst1q_u16(o, lo);
+        if (g->values == 16) {
+            uint16x8_t hi = vshll_high_n_u8(a, BILINEAR_BITS);
+            hi = vmlal_high_u8(vmlsl_high_u8(hi, a, w), b, w);
+            vst1q_u16(o + 8, hi);
+        }
+    }
+
+    // Handle remaining values
+    size_t n = (size_t)dst_width * channels;
+    for (size_t j = g->groups * g->values; j < n; j++) {
+        const bilinear_tap_t* t = &taps[j / channels];
+        int c = (int)(j % channels);
+        out[j] = (uint16_t)(src[t->ofs0 + c] * t->w0 + src[t->ofs1 + c] * t->w1);
+    }
+}
+
+// Vertical pass: OUT = (R0 * w0 + R1 * w1) / 2^16, rounded
+static void bilinear_blend(const uint16_t* r0, const uint16_t* r1, uint16_t w0, uint16_t w1,
+                           uint8_t* out, size_t n) {
+    // Process 16 values at a time using NEON
+    size_t vec_size = n / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 16;
+        uint16x8_t a0 = vld1q_u16(r0 + j);
+        uint16x8_t a1 = vld1q_u16(r0 + j + 8);
+        uint16x8_t b0 = vld1q_u16(r1 + j);
+        uint16x8_t b1 = vld1q_u16(r1 + j + 8);
+
+        uint32x4_t s0 = vmlal_n_u16(vmull_n_u16(vget_low_u16(a0), w0), vget_low_u16(b0), w1);
+        uint32x4_t s1 = vmlal_n_u16(vmull_n_u16(vget_high_u16(a0), w0), vget_high_u16(b0), w1);
+        uint32x4_t s2 = vmlal_n_u16(vmull_n_u16(vget_low_u16(a1), w0), vget_low_u16(b1), w1);
+        uint32x4_t s3 = vmlal_n_u16(vmull_n_u16(vget_high_u16(a1), w0), vget_high_u16(b1), w1);
+
+        uint16x8_t lo = vcombine_u16(vrshrn_n_u32(s0, 16), vrshrn_n_u32(s1, 16));
+        uint16x8_t hi = vcombine_u16(vrshrn_n_u32(s2, 16), vrshrn_n_u32(s3, 16));
+        vst1q_u8(out + j, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+
+    // Handle remaining values
+    for (size_t j = vec_size * 16; j < n; j++) {
+        out[j] = (uint8_t)(((uint32_t)r0[j] * w0 + (uint32_t)r1[j] * w1 + 32768) >> 16);
+    }
+}
+
+// Gather groups for the bilinear horizontal pass and their per-lane w1
+static uint8_t* bilinear_plan_init(gather_plan_t* plan, const bilinear_tap_t* xtaps, int src_width, int dst_width,
+                                   int channels) {
+    size_t n = (size_t)dst_width * channels;
+    int32_t* offset = (int32_t*)malloc(n * sizeof(int32_t));
+    if (!offset) return NULL;
+    for (size_t j = 0; j < n; j++) offset[j] = xtaps[j / channels].ofs0 + (int32_t)(j % channels);
+    int planned = gather_plan_init(plan, offset, n, (size_t)src_width * channels, (size_t)channels);
+    free(offset);
+    if (!planned) return NULL;
+
+    // One spare byte so that no groups still allocates
+    uint8_t* weights = (uint8_t*)malloc(plan->groups * 16 + 1);
+    if (!weights) {
+        gather_plan_free(plan);
+        return NULL;
+    }
+    for (size_t i = 0; i < plan->groups; i++) {
+        for (int v = 0; v < 16; v++) {
+            size_t j = i * plan->values + (size_t)v;
+            weights[i * 16 + v] = (uint8_t)(v < plan->values ? xtaps[j / channels].w1 : 0);
+        }
+    }
+    return weights;
+}
+
+static void resize_bilinear(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                            int src_width, int src_height, int dst_width, int dst_height, int channels) {
+    size_t n = (size_t)dst_width * channels;
+
+    bilinear_tap_t* xtaps = (bilinear_tap_t*)malloc((size_t)dst_width * sizeof(bilinear_tap_t));
+    bilinear_tap_t* ytaps = (bilinear_tap_t*)malloc((size_t)dst_height * sizeof(bilinear_tap_t));
+    uint16_t* rows = (uint16_t*)neon_malloc(2 * n * sizeof(uint16_t));
+    if (!xtaps || !ytaps || !rows) {
+        free(xtaps);
+        free(ytaps);
+        free(rows);
+        return;
+    }
+
+    bilinear_taps(src_width, dst_width, channels, xtaps);
+    bilinear_taps(src_height, dst_height, 1, ytaps);
+
+    gather_plan_t plan;
+    uint8_t* weights = bilinear_plan_init(&plan, xtaps, src_width, dst_width, channels);
+    if (!weights) {
+        free(xtaps);
+        free(ytaps);
+        free(rows);
+        return;
+    }
+
+    // Two cached horizontally filtered rows; consecutive output rows
+    // usually share one or both source rows
+    int cached[2] = { -1, -1 };
+
+    for (int y = 0; y < dst_height; y++) {
+        int y0 = ytaps[y].ofs0;
+        int y1 = ytaps[y].ofs1;
+
+        int s0 = cached[0] == y0 ? 0 : cached[1] == y0 ? 1 : -1;
+        if (s0 < 0) {
+            s0 = cached[0] == y1 ? 1 : 0;
+            bilinear_row(src + (size_t)y0 * src_stride, rows + s0 * n, xtaps, &plan, weights, dst_width, channels);
+            cached[s0] = y0;
+        }
+        int s1 = cached[s0] == y1 ? s0 : cached[1 - s0] == y1 ? 1 - s0 : -1;
+        if (s1 < 0) {
+            s1 = 1 - s0;
+            bilinear_row(src + (size_t)y1 * src_stride, rows + s1 * n, xtaps, &plan, weights, dst_width, channels);
+            cached[s1] = y1;
+        }
+
+        bilinear_blend(rows + s0 * n, rows + s1 * n, ytaps[y].w0, ytaps[y].w1, dst + (size_t)y * dst_stride, n);
+    }
+
+    gather_plan_free(&plan);
+    free(weights);
+    free(xtaps);
+    free(ytaps);
+    free(rows);
+}
+
+/*
+ * Area Resize
+ */
+
+#define AREA_BITS 12
+#define AREA_ONE (1 << AREA_BITS)
+
+// Source cells overlapped by each output cell when shrinking src_n to dst_n
+typedef struct {
+    int* start;         // First source index
+    int* count;         // Number of source indices
+    uint32_t* weight;   // max_taps weights per output, summing to AREA_ONE
+    int max_taps;
+} area_taps_t;
+
+static void area_taps_free(area_taps_t* t) {
+    free(t->start);
+    free(t->count);
+    free(t->weight);
+}
+
+static int area_taps_init(area_taps_t* t, int src_n, int dst_n) {
+    double scale = (double)src_n / dst_n;
+    t->max_taps = (int)ceil(scale) + 1;
+    t->start = (int*)malloc((size_t)dst_n * sizeof(int));
+    t->count = (int*)malloc((size_t)dst_n * sizeof(int));
+    t->weight = (uint32_t*)malloc((size_t)dst_n * t->max_taps * sizeof(uint32_t));
+    if (!t->start || !t->count || !t->weight) {
+        area_taps_free(t);
+        return 0;
+    }
+
+    for (int i = 0; i < dst_n; i++) {
+        double a = i * scale;
+        double b = i + 1 == dst_n ? src_n : (i + 1) * scale;
+        int j0 = (int)a;
+        int j1 = (int)ceil(b);
+        if (j1 > src_n) j1 = src_n;
+        if (j1 - j0 > t->max_taps) j1 = j0 + t->max_taps;
+
+        uint32_t* w = t->weight + (size_t)i * t->max_taps;
+        int32_t sum = 0;
+        int largest = 0;
+        for (int k = 0; k < j1 - j0; k++) {
+            double lo = a > j0 + k ? a : j0 + k;
+            double hi = b < j0 + k + 1 ? b : j0 + k + 1;
+            w[k] = (uint32_t)lround((hi - lo) / scale * AREA_ONE);
+            sum += (int32_t)w[k];
+            if (w[k] > w[largest]) largest = k;
+        }
+        // Absorb rounding so that a flat image stays flat
+        w[largest] = (uint32_t)((int32_t)w[largest] + AREA_ONE - sum);
+
+        t->start[i] = j0;
+        t->count[i] = j1 - j0;
+    }
+    return 1;
+}
+
+// Horizontal pass of one source row; results carry 12 fraction bits.
+// WEIGHTS holds max_taps rows of 16 lane weights per gather group, 0 for
+// taps a value does not have.
+static void area_row(const uint8_t* src, uint32_t* out, const area_taps_t* xt, const gather_plan_t* g,
+                     const uint16_t* weights, int dst_width, int channels) {
+    // Process 16 (or 8) values at a time using NEON, one lookup per tap
+    for (size_t i = 0; i < g->groups; i++) {
+        const uint8_t* p = src + g->base[i];
+        uint8x16_t index = vld1q_u8(g->index + i * 16);
+        const uint16_t* w = weights + i * xt->max_taps * 16;
+        uint32_t* o = out + i * g->values;
+        uint32x4_t acc0 = vdupq_n_u32(0);
+        uint32x4_t acc1 = vdupq_n_u32(0);
+        uint32x4_t acc2 = vdupq_n_u32(0);
+        uint32x4_t acc3 = vdupq_n_u32(0);
+
+        for (int k = 0; k < xt->max_taps; k++) {
+            uint8x16_t v = window_lookup(p + k * channels, g->tables, index);
+            uint16x8_t v0 = vmovl_u8(vget_low_u8(v));
+            uint16x8_t w0 = vld1q_u16(w + k * 16);
+            acc0 = vmlal_u16(acc0, vget_low_u16(v0), vget_low_u16(w0));
+            acc1 = vmlal_high_u16(acc1, v0, w0);
+            if (g->values == 16) {
+                uint16x8_t v1 = vmovl_high_u8(v);
+                uint16x8_t w1 = vld1q_u16(w + k * 16 + 8);
+                acc2 = vmlal_u16(acc2, vget_low_u16(v1), vget_low_u16(w1));
+                acc3 = vmlal_high_u16(acc3, v1, w1);
+            }
+        }
+
+        vst1q_u32(o, acc0);
+        vst1q_u32(o + 4, acc1);
+        if (g->values == 16) {
+            vst1q_u32(o + 8, acc2);
+            vst1q_u32(o + 12, acc3);
+        }
+    }
+
+    // Handle remaining values
+    size_t n = (size_t)dst_width * channels;
+    for (size_t j = g->groups * g->values; j < n; j++) {
+        int x = (int)(j / channels);
+        const uint8_t* p = src + (size_t)xt->start[x] * channels + j % channels;
+        const uint32_t* w = xt->weight + (size_t)x * xt->max_taps;
+        uint32_t acc = 0;
+        for (int k = 0; k < xt->count[x]; k++) {
+            acc += p[k * channels] * w[k];
+        }
+        out[j] = acc;
+    }
+}
+
+// Gather groups for the area horizontal pass and their per-lane weights
+static uint16_t* area_plan_init(gather_plan_t* plan, const area_taps_t* xt, int src_width, int dst_width,
+                                int channels) {
+    size_t n = (size_t)dst_width * channels;
+    int32_t* offset = (int32_t*)malloc(n * sizeof(int32_t));
+    if (!offset) return NULL;
+    for (size_t j = 0; j < n; j++) offset[j] = xt->start[j / channels] * channels + (int32_t)(j % channels);
+    int planned = gather_plan_init(plan, offset, n, (size_t)src_width * channels,
+                                   (size_t)(xt->max_taps - 1) * channels);
+    free(offset);
+    if (!planned) return NULL;
+
+    // One spare byte so that no groups still allocates
+    uint16_t* weights = (uint16_t*)malloc(plan->groups * xt->max_taps * 16 * sizeof(uint16_t) + 1);
+    if (!weights) {
+        gather_plan_free(plan);
+        return NULL;
+    }
+    for (size_t i = 0; i < plan->groups; i++) {
+        for (int k = 0; k < xt->max_taps; k++) {
+            for (int v = 0; v < 16; v++) {
+                size_t j = i * plan->values + (size_t)v;
+                int x = (int)(j / channels);
+                uint16_t w = 0;
+                if (v < plan->values && k < xt->count[x]) w = (uint16_t)xt->weight[(size_t)x * xt->max_taps + k];
+                weights[(i * xt->max_taps + k) * 16 + v] = w;
+            }
+        }
+    }
+    return weights;
+}
+
+// ACC = H * w (first row) or ACC += H * w; at most 255 * 2^24, so u32 holds it
+static void area_accumulate(const uint32_t* h, uint32_t* acc, uint32_t w, size_t n, int first) {
+    // Process 8 values at a time using NEON
+    size_t vec_size = n / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 8;
+        uint32x4_t h0 = vld1q_u32(h + j);
+        uint32x4_t h1 = vld1q_u32(h + j + 4);
+        if (first) {
+            vst1q_u32(acc + j, vmulq_n_u32(h0, w));
+            vst1q_u32(acc + j + 4, vmulq_n_u32(h1, w));
+        } else {
+            vst1q_u32(acc + j, vmlaq_n_u32(vld1q_u32(acc + j), h0, w));
+            vst1q_u32(acc + j + 4, vmlaq_n_u32(vld1q_u32(acc + j + 4), h1, w));
+        }
+    }
+
+    // Handle remaining values
+    for (size_t j = vec_size * 8; j < n; j++) {
+        acc[j] = (first ? 0 : acc[j]) + h[j] * w;
+    }
+}
+
+// Drop the 24 fraction bits with rounding
+static void area_store(const uint32_t* acc, uint8_t* out, size_t n) {
+    // Process 16 values at a time using NEON
+    size_t vec_size = n / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        size_t j = i * 16;
+        uint16x8_t lo = vcombine_u16(vmovn_u32(vrshrq_n_u32(vld1q_u32(acc + j), 24)),
+                                     vmovn_u32(vrshrq_n_u32(vld1q_u32(acc + j + 4), 24)));
+        uint16x8_t hi = vcombine_u16(vmovn_u32(vrshrq_n_u32(vld1q_u32(acc + j + 8), 24)),
+                                     vmovn_u32(vrshrq_n_u32(vld1q_u32(acc + j + 12), 24)));
+        vst1q_u8(out + j, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+
+    // Handle remaining values
+    for (size_t j = vec_size * 16; j < n; j++) {
+        out[j] = (uint8_t)((acc[j] + (1u << 23)) >> 24);
+    }
+}
+
+static void resize_area(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                        int src_width, int src_height, int dst_width, int dst_height, int channels) {
+    size_t n = (size_t)dst_width * channels;
+
+    area_taps_t xt, yt;
+    if (!area_taps_init(&xt, src_width, dst_width)) return;
+    if (!area_taps_init(&yt, src_height, dst_height)) {
+        area_taps_free(&xt);
+        return;
+    }
+
+    gather_plan_t plan;
+    uint16_t* weights = area_plan_init(&plan, &xt, src_width, dst_width, channels);
+    uint32_t* h = (uint32_t*)neon_malloc(n * sizeof(uint32_t));
+    uint32_t* acc = (uint32_t*)neon_malloc(n * sizeof(uint32_t));
+    if (weights && h && acc) {
+        // The last source row of an output row is often the first of the
+        // next one, so the horizontal pass result is kept between rows
+        int cached = -1;
+
+        for (int y = 0; y < dst_height; y++) {
+            const uint32_t* w = yt.weight + (size_t)y * yt.max_taps;
+            for (int k = 0; k < yt.count[y]; k++) {
+                int row = yt.start[y] + k;
+                if (row != cached) {
+                    area_row(src + (size_t)row * src_stride, h, &xt, &plan, weights, dst_width, channels);
+                    cached = row;
+                }
+                area_accumulate(h, acc, w[k], n, k == 0);
+            }
+            area_store(acc, dst + (size_t)y * dst_stride, n);
+        }
+    }
+
+    if (weights) gather_plan_free(&plan);
+    free(weights);
+    free(h);
+    free(acc);
+    area_taps_free(&xt);
+    area_taps_free(&yt);
+}
+
+static void resize(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride,
+                   int src_width, int src_height, int dst_width, int dst_height,
+                   int channels, simd_resize_mode_t mode) {
+    if (src_width == dst_width && src_height == dst_height) {
+        for (int y = 0; y < src_height; y++) {
+            memcpy(dst + (size_t)y * dst_stride, src + (size_t)y * src_stride, (size_t)src_width * channels);
+        }
+        return;
+    }
+
+    if (mode == SIMD_RESIZE_AREA && dst_width <= src_width && dst_height <= src_height) {
+        if (2 * dst_width == src_width && 2 * dst_height == src_height) {
+            downsample2x(src, src_stride, dst, dst_stride, src_width, src_height, channels);
+        } else {
+            resize_area(src, src_stride, dst, dst_stride, src_width, src_height, dst_width, dst_height, channels);
+        }
+        return;
+    }
+
+    resize_bilinear(src, src_stride, dst, dst_stride, src_width, src_height, dst_width, dst_height, channels);
+}
+
+void simd_resize_u8(const uint8_t* src, uint8_t* dst, int src_width, int src_height,
+                    int dst_width, int dst_height, int channels, simd_resize_mode_t mode) {
+    if (!valid_channels(channels)) return;
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) return;
+
+    resize(src, (size_t)src_width * channels, dst, (size_t)dst_width * channels,
+           src_width, src_height, dst_width, dst_height, channels, mode);
+}
+
+/*
+ * Strided Views
+ */
+
+// Valid views with the same supported channel count; DST of the given size
+static bool views_match(const simd_image_t* src, const simd_image_t* dst, int dst_width, int dst_height) {
+    return simd_image_valid(src, 0, 1) && valid_channels(src->channels) &&
+           simd_image_valid(dst, src->channels, 1) && dst->width == dst_width && dst->height == dst_height;
+}
+
+void simd_downsample2x_u8_view(const simd_image_t* src, const simd_image_t* dst) {
+    if (!src || !views_match(src, dst, src->width / 2, src->height / 2)) return;
+    downsample2x(src->data, src->stride, dst->data, dst->stride, src->width, src->height, src->channels);
+}
+
+void simd_pyr_down_u8_view(const simd_image_t* src, const simd_image_t* dst) {
+    if (!src || !views_match(src, dst, (src->width + 1) / 2, (src->height + 1) / 2)) return;
+    pyr_down(src->data, src->stride, dst->data, dst->stride, src->width, src->height, src->channels);
+}
+
+void simd_pyr_up_u8_view(const simd_image_t* src, const simd_image_t* dst) {
+    if (!src || !views_match(src, dst, 2 * src->width, 2 * src->height)) return;
+    pyr_up(src->data, src->stride, dst->data, dst->stride, src->width, src->height, src->channels);
+}
+
+void simd_resize_u8_view(const simd_image_t* src, const simd_image_t* dst, simd_resize_mode_t mode) {
+    if (!src || !dst || !views_match(src, dst, dst->width, dst->height)) return;
+    resize(src->data, src->stride, dst->data, dst->stride, src->width, src->height,
+           dst->width, dst->height, src->channels, mode);
+}
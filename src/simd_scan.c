@@ -0,0 +1,536 @@
+/**
+ * simd_scan.c
+ * Implementation of prefix sums using NEON
+ *
+ * Every vector is scanned in registers with log-step shifts (vextq against
+ * zero: 1 then 2 lanes for 32-bit, 1 for 64-bit), then offset by a carried
+ * lane that holds the running total broadcast from the previous vector.
+ * Exclusive results are the inclusive ones shifted by one lane with vextq,
+ * which keeps float scans exact with respect to their inclusive form.
+ * Segmented scans apply the same steps with the segment-start flags turned
+ * into lane masks that block the shifted partial sums from crossing a
+ * segment boundary.
+ */
+#include "simd_scan.h"
+#include "simd_parallel.h"
+#include <stdbool.h>
+#include <string.h>
+#include <arm_neon.h>
+
+/*
+ * In-Register Scans
+ */
+
+static inline uint16x8_t scan_u16x8(uint16x8_t v) {
+    uint16x8_t zero = vdupq_n_u16(0);
+    v = vaddq_u16(v, vextq_u16(zero, v, 7));
+    v = vaddq_u16(v, vextq_u16(zero, v, 6));
+    v = vaddq_u16(v, vextq_u16(zero, v, 4));
+    return v;
+}
+
+static inline int32x4_t scan_s32x4(int32x4_t v) {
+    int32x4_t zero = vdupq_n_s32(0);
+    v = vaddq_s32(v, vextq_s32(zero, v, 3));
+    v = vaddq_s32(v, vextq_s32(zero, v, 2));
+    return v;
+}
+
+static inline float32x4_t scan_f32x4(float32x4_t v) {
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    v = vaddq_f32(v, vextq_f32(zero, v, 3));
+    v = vaddq_f32(v, vextq_f32(zero, v, 2));
+    return v;
+}
+
+static inline float64x2_t scan_f64x2(float64x2_t v) {
+    return vaddq_f64(v, vextq_f64(vdupq_n_f64(0.0), v, 1));
+}
+
+/*
+ * Range Scans
+ * Scan LEN elements starting from running total CARRY; return the new total.
+ */
+
+static uint32_t scan_range_u8_u32(const uint8_t* in, uint32_t* out, size_t len, bool exclusive, uint32_t carry_in) {
+    uint32x4_t carry = vdupq_n_u32(carry_in);
+
+    // Process 16 elements at a time using NEON
+    size_t vec_size = len / 16;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint8x16_t v = vld1q_u8(in + i * 16);
+
+        // Block prefix fits in 16 bits (16 * 255)
+        uint16x8_t lo = scan_u16x8(vmovl_u8(vget_low_u8(v)));
+        uint16x8_t hi = scan_u16x8(vmovl_high_u8(v));
+        hi = vaddq_u16(hi, vdupq_laneq_u16(lo, 7));
+
+        uint32x4_t s0 = vaddw_u16(carry, vget_low_u16(lo));
+        uint32x4_t s1 = vaddw_high_u16(carry, lo);
+        uint32x4_t s2 = vaddw_u16(carry, vget_low_u16(hi));
+        uint32x4_t s3 = vaddw_high_u16(carry, hi);
+
+        uint32_t* dst = out + i * 16;
+        if (exclusive) {
+            vst1q_u32(dst, vextq_u32(carry, s0, 3));
+            vst1q_u32(dst + 4, vextq_u32(s0, s1, 3));
+            vst1q_u32(dst + 8, vextq_u32(s1, s2, 3));
+            vst1q_u32(dst + 12, vextq_u32(s2, s3, 3));
+        } else {
+            vst1q_u32(dst, s0);
+            vst1q_u32(dst + 4, s1);
+            vst1q_u32(dst + 8, s2);
+            vst1q_u32(dst + 12, s3);
+        }
+        carry = vdupq_laneq_u32(s3, 3);
+    }
+
+    // Handle remaining elements
+    uint32_t run = vgetq_lane_u32(carry, 0);
+    for (size_t i = vec_size * 16; i < len; i++) {
+        uint32_t v = in[i];
+        out[i] = exclusive ? run : run + v;
+        run += v;
+    }
+    return run;
+}
+
+static int32_t scan_range_s32(const int32_t* in, int32_t* out, size_t len, bool exclusive, int32_t carry_in) {
+    int32x4_t carry = vdupq_n_s32(carry_in);
+
+    // Process 8 elements at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        int32x4_t a = vld1q_s32(in + i * 8);
+        int32x4_t b = vld1q_s32(in + i * 8 + 4);
+        int32x4_t sa = vaddq_s32(scan_s32x4(a), carry);
+        int32x4_t sb = vaddq_s32(scan_s32x4(b), vdupq_laneq_s32(sa, 3));
+
+        if (exclusive) {
+            vst1q_s32(out + i * 8, vextq_s32(carry, sa, 3));
+            vst1q_s32(out + i * 8 + 4, vextq_s32(sa, sb, 3));
+        } else {
+            vst1q_s32(out + i * 8, sa);
+            vst1q_s32(out + i * 8 + 4, sb);
+        }
+        carry = vdupq_laneq_s32(sb, 3);
+    }
+
+    // Handle remaining elements (unsigned arithmetic wraps like the vector adds)
+    uint32_t run = (uint32_t)vgetq_lane_s32(carry, 0);
+    for (size_t i = vec_size * 8; i < len; i++) {
+        uint32_t v = (uint32_t)in[i];
+        out[i] = (int32_t)(exclusive ? run : run + v);
+        run += v;
+    }
+    return (int32_t)run;
+}
+
+static float scan_range_f32(const float* in, float* out, size_t len, bool exclusive, float carry_in) {
+    float32x4_t carry = vdupq_n_f32(carry_in);
+
+    // Process 8 elements at a time using NEON
+    size_t vec_size = len / 8;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        float32x4_t a = vld1q_f32(in + i * 8);
+        float32x4_t b = vld1q_f32(in + i * 8 + 4);
+        float32x4_t sa = vaddq_f32(scan_f32x4(a), carry);
+        float32x4_t sb = vaddq_f32(scan_f32x4(b), vdupq_laneq_f32(sa, 3));
+
+        if (exclusive) {
+            vst1q_f32(out + i * 8, vextq_f32(carry, sa, 3));
+            vst1q_f32(out + i * 8 + 4, vextq_f32(sa, sb, 3));
+        } else {
+            vst1q_f32(out + i * 8, sa);
+            vst1q_f32(out + i * 8 + 4, sb);
+        }
+        carry = vdupq_laneq_f32(sb, 3);
+    }
+
+    // Handle remaining elements
+    float run = vgetq_lane_f32(carry, 0);
+    for (size_t i = vec_size * 8; i < len; i++) {
+        float v = in[i];
+        out[i] = exclusive ? run : run + v;
+        run += v;
+    }
+    return run;
+}
+
+static double scan_range_f64(const double* in, double* out, size_t len, bool exclusive, double carry_in) {
+    float64x2_t carry = vdupq_n_f64(carry_in);
+
+    // Process 4 elements at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        float64x2_t a = vld1q_f64(in + i * 4);
+        float64x2_t b = vld1q_f64(in + i * 4 + 2);
+        float64x2_t sa = vaddq_f64(scan_f64x2(a), carry);
+        float64x2_t sb = vaddq_f64(scan_f64x2(b), vdupq_laneq_f64(sa, 1));
+
+        if (exclusive) {
+            vst1q_f64(out + i * 4, vextq_f64(carry, sa, 1));
+            vst1q_f64(out + i * 4 + 2, vextq_f64(sa, sb, 1));
+        } else {
+            vst1q_f64(out + i * 4, sa);
+            vst1q_f64(out + i * 4 + 2, sb);
+        }
+        carry = vdupq_laneq_f64(sb, 1);
+    }
+
+    // Handle remaining elements
+    double run = vgetq_lane_f64(carry, 0);
+    for (size_t i = vec_size * 4; i < len; i++) {
+        double v = in[i];
+        out[i] = exclusive ? run : run + v;
+        run += v;
+    }
+    return run;
+}
+
+uint32_t simd_scan_u8_u32(const uint8_t* in, uint32_t* out, size_t len, simd_scan_kind_t kind) {
+    return scan_range_u8_u32(in, out, len, kind == SIMD_SCAN_EXCLUSIVE, 0);
+}
+
+int32_t simd_scan_s32(const int32_t* in, int32_t* out, size_t len, simd_scan_kind_t kind) {
+    return scan_range_s32(in, out, len, kind == SIMD_SCAN_EXCLUSIVE, 0);
+}
+
+float simd_scan_f32(const float* in, float* out, size_t len, simd_scan_kind_t kind) {
+    return scan_range_f32(in, out, len, kind == SIMD_SCAN_EXCLUSIVE, 0.0f);
+}
+
+double simd_scan_f64(const double* in, double* out, size_t len, simd_scan_kind_t kind) {
+    return scan_range_f64(in, out, len, kind == SIMD_SCAN_EXCLUSIVE, 0.0);
+}
+
+/*
+ * Range Reductions (first pass of the parallel scan)
+ */
+
+static uint32_t reduce_u8_u32(const uint8_t* in, size_t len) {
+    uint32x4_t acc = vdupq_n_u32(0);
+
+    // Process 16 elements at a time using NEON
+    size_t vec_size = len / 16;
+    for (size_t i = 0; i < vec_size; i++) {
+        acc = vpadalq_u16(acc, vpaddlq_u8(vld1q_u8(in + i * 16)));
+    }
+
+    // Handle remaining elements
+    uint32_t sum = vaddvq_u32(acc);
+    for (size_t i = vec_size * 16; i < len; i++) sum += in[i];
+    return sum;
+}
+
+static int32_t reduce_s32(const int32_t* in, size_t len) {
+    int32x4_t acc0 = vdupq_n_s32(0);
+    int32x4_t acc1 = vdupq_n_s32(0);
+
+    // Process 8 elements at a time using NEON
+    size_t vec_size = len / 8;
+    for (size_t i = 0; i < vec_size; i++) {
+        acc0 = vaddq_s32(acc0, vld1q_s32(in + i * 8));
+        acc1 = vaddq_s32(acc1, vld1q_s32(in + i * 8 + 4));
+    }
+
+    // Handle remaining elements
+    uint32_t sum = (uint32_t)vaddvq_s32(vaddq_s32(acc0, acc1));
+    for (size_t i = vec_size * 8; i < len; i++) sum += (uint32_t)in[i];
+    return (int32_t)sum;
+}
+
+static float reduce_f32(const float* in, size_t len) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+    // Process 8 elements at a time using NEON
+    size_t vec_size = len / 8;
+    for (size_t i = 0; i < vec_size; i++) {
+        acc0 = vaddq_f32(acc0, vld1q_f32(in + i * 8));
+        acc1 = vaddq_f32(acc1, vld1q_f32(in + i * 8 + 4));
+    }
+
+    // Handle remaining elements
+    float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (size_t i = vec_size * 8; i < len; i++) sum += in[i];
+    return sum;
+}
+
+static double reduce_f64(const double* in, size_t len) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+
+    // Process 4 elements at a time using NEON
+    size_t vec_size = len / 4;
+    for (size_t i = 0; i < vec_size; i++) {
+        acc0 = vaddq_f64(acc0, vld1q_f64(in + i * 4));
+        acc1 = vaddq_f64(acc1, vld1q_f64(in + i * 4 + 2));
+    }
+
+    // Handle remaining elements
+    double sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (size_t i = vec_size * 4; i < len; i++) sum += in[i];
+    return sum;
+}
+
+/*
+ * Multi-threaded Two-Pass Scan
+ */
+
+// Elements per scheduling block; arrays under two blocks stay single-threaded
+#define SCAN_BLOCK ((size_t)1 << 16)
+
+typedef enum {
+    SCAN_U8_U32,
+    SCAN_S32,
+    SCAN_F32,
+    SCAN_F64
+} scan_type_t;
+
+typedef union {
+    uint32_t u32;
+    int32_t s32;
+    float f32;
+    double f64;
+} scan_value_t;
+
+typedef struct {
+    scan_type_t type;
+    const void* in;
+    void* out;
+    size_t len;
+    int blocks;
+    bool exclusive;
+    scan_value_t totals[SIMD_PARALLEL_MAX_THREADS];   // Pass 1: band sums, then offsets
+    scan_value_t results[SIMD_PARALLEL_MAX_THREADS];  // Pass 2: running total after each band
+    scan_value_t total;
+} scan_job_t;
+
+static void band_range(const scan_job_t* job, int y0, int y1, size_t* begin, size_t* count) {
+    *begin = (size_t)y0 * SCAN_BLOCK;
+    size_t end = y1 == job->blocks ? job->len : (size_t)y1 * SCAN_BLOCK;
+    *count = end - *begin;
+}
+
+static void reduce_band(void* arg, int band, int y0, int y1) {
+    scan_job_t* job = (scan_job_t*)arg;
+    size_t begin, count;
+    band_range(job, y0, y1, &begin, &count);
+
+    // The last band's total is never needed as an offset
+    if (y1 == job->blocks) return;
+
+    switch (job->type) {
+        case SCAN_U8_U32: job->totals[band].u32 = reduce_u8_u32((const uint8_t*)job->in + begin, count); break;
+        case SCAN_S32:    job->totals[band].s32 = reduce_s32((const int32_t*)job->in + begin, count); break;
+        case SCAN_F32:    job->totals[band].f32 = reduce_f32((const float*)job->in + begin, count); break;
+        case SCAN_F64:    job->totals[band].f64 = reduce_f64((const double*)job->in + begin, count); break;
+    }
+}
+
+static void scan_band(void* arg, int band, int y0, int y1) {
+    scan_job_t* job = (scan_job_t*)arg;
+    size_t begin, count;
+    band_range(job, y0, y1, &begin, &count);
+    scan_value_t offset = job->totals[band];
+    scan_value_t* result = &job->results[band];
+    bool ex = job->exclusive;
+
+    switch (job->type) {
+        case SCAN_U8_U32:
+            result->u32 = scan_range_u8_u32((const uint8_t*)job->in + begin, (uint32_t*)job->out + begin,
+                                            count, ex, offset.u32);
+            break;
+        case SCAN_S32:
+            result->s32 = scan_range_s32((const int32_t*)job->in + begin, (int32_t*)job->out + begin,
+                                         count, ex, offset.s32);
+            break;
+        case SCAN_F32:
+            result->f32 = scan_range_f32((const float*)job->in + begin, (float*)job->out + begin,
+                                         count, ex, offset.f32);
+            break;
+        case SCAN_F64:
+            result->f64 = scan_range_f64((const double*)job->in + begin, (double*)job->out + begin,
+                                         count, ex, offset.f64);
+            break;
+    }
+}
+
+// Returns false when the array is too small to split
+static bool scan_parallel(scan_job_t* job, int threads) {
+    size_t blocks = job->len / SCAN_BLOCK;
+    job->blocks = blocks > INT32_MAX ? INT32_MAX : (int)blocks;
+    if (simd_parallel_band_count(job->blocks, threads) < 2) return false;
+
+    int bands = simd_parallel_bands(job->blocks, threads, reduce_band, job);
+
+    // Exclusive scan of the band totals gives each band's starting offset
+    scan_value_t run;
+    memset(&run, 0, sizeof(run));
+    for (int b = 0; b < bands; b++) {
+        scan_value_t total = job->totals[b];
+        job->totals[b] = run;
+        switch (job->type) {
+            case SCAN_U8_U32:
+            case SCAN_S32:    run.u32 += total.u32; break;
+            case SCAN_F32:    run.f32 += total.f32; break;
+            case SCAN_F64:    run.f64 += total.f64; break;
+        }
+    }
+
+    simd_parallel_bands(job->blocks, threads, scan_band, job);
+    job->total = job->results[bands - 1];
+    return true;
+}
+
+static void scan_job_init(scan_job_t* job, scan_type_t type, const void* in, void* out,
+                          size_t len, simd_scan_kind_t kind) {
+    job->type = type;
+    job->in = in;
+    job->out = out;
+    job->len = len;
+    job->blocks = 0;
+    job->exclusive = kind == SIMD_SCAN_EXCLUSIVE;
+}
+
+uint32_t simd_scan_parallel_u8_u32(const uint8_t* in, uint32_t* out, size_t len,
+                                   simd_scan_kind_t kind, int threads) {
+    scan_job_t job;
+    scan_job_init(&job, SCAN_U8_U32, in, out, len, kind);
+    if (!scan_parallel(&job, threads)) return simd_scan_u8_u32(in, out, len, kind);
+    return job.total.u32;
+}
+
+int32_t simd_scan_parallel_s32(const int32_t* in, int32_t* out, size_t len,
+                               simd_scan_kind_t kind, int threads) {
+    scan_job_t job;
+    scan_job_init(&job, SCAN_S32, in, out, len, kind);
+    if (!scan_parallel(&job, threads)) return simd_scan_s32(in, out, len, kind);
+    return job.total.s32;
+}
+
+float simd_scan_parallel_f32(const float* in, float* out, size_t len,
+                             simd_scan_kind_t kind, int threads) {
+    scan_job_t job;
+    scan_job_init(&job, SCAN_F32, in, out, len, kind);
+    if (!scan_parallel(&job, threads)) return simd_scan_f32(in, out, len, kind);
+    return job.total.f32;
+}
+
+double simd_scan_parallel_f64(const double* in, double* out, size_t len,
+                              simd_scan_kind_t kind, int threads) {
+    scan_job_t job;
+    scan_job_init(&job, SCAN_F64, in, out, len, kind);
+    if (!scan_parallel(&job, threads)) return simd_scan_f64(in, out, len, kind);
+    return job.total.f64;
+}
+
+/*
+ * Segmented Scans
+ */
+
+// Lane masks (all ones) for the nonzero bytes among FLAGS[0..3]
+static inline uint32x4_t flag_mask4(const uint8_t* flags) {
+    uint32_t word;
+    memcpy(&word, flags, sizeof(word));
+    uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(word));
+    int8x8_t nonzero = vreinterpret_s8_u8(vtst_u8(bytes, bytes));
+    return vreinterpretq_u32_s32(vmovl_s16(vget_low_s16(vmovl_s8(nonzero))));
+}
+
+// Segmented log-step scan: a lane only accumulates from the left while no
+// segment start has been seen between the two lanes
+static inline uint32x4_t seg_scan_u32x4(uint32x4_t v, uint32x4_t* mask) {
+    uint32x4_t zero = vdupq_n_u32(0);
+    uint32x4_t m = *mask;
+    v = vaddq_u32(v, vbicq_u32(vextq_u32(zero, v, 3), m));
+    m = vorrq_u32(m, vextq_u32(zero, m, 3));
+    v = vaddq_u32(v, vbicq_u32(vextq_u32(zero, v, 2), m));
+    m = vorrq_u32(m, vextq_u32(zero, m, 2));
+    *mask = m;
+    return v;
+}
+
+static inline float32x4_t seg_scan_f32x4(float32x4_t v, uint32x4_t* mask) {
+    uint32x4_t zero = vdupq_n_u32(0);
+    uint32x4_t m = *mask;
+    float32x4_t shifted = vextq_f32(vdupq_n_f32(0.0f), v, 3);
+    v = vaddq_f32(v, vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(shifted), m)));
+    m = vorrq_u32(m, vextq_u32(zero, m, 3));
+    shifted = vextq_f32(vdupq_n_f32(0.0f), v, 2);
+    v = vaddq_f32(v, vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(shifted), m)));
+    m = vorrq_u32(m, vextq_u32(zero, m, 2));
+    *mask = m;
+    return v;
+}
+
+void simd_segmented_scan_s32(const int32_t* in, const uint8_t* flags, int32_t* out,
+                             size_t len, simd_scan_kind_t kind) {
+    bool exclusive = kind == SIMD_SCAN_EXCLUSIVE;
+    uint32x4_t carry = vdupq_n_u32(0);
+
+    // Process 4 elements at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint32x4_t starts = flag_mask4(flags + i * 4);
+        uint32x4_t m = starts;
+        uint32x4_t v = seg_scan_u32x4(vreinterpretq_u32_s32(vld1q_s32(in + i * 4)), &m);
+
+        // Lanes before the first segment start continue the previous total
+        v = vaddq_u32(v, vbicq_u32(carry, m));
+
+        uint32x4_t result = exclusive ? vbicq_u32(vextq_u32(carry, v, 3), starts) : v;
+        vst1q_s32(out + i * 4, vreinterpretq_s32_u32(result));
+        carry = vdupq_laneq_u32(v, 3);
+    }
+
+    // Handle remaining elements
+    uint32_t run = vgetq_lane_u32(carry, 0);
+    for (size_t i = vec_size * 4; i < len; i++) {
+        if (flags[i]) run = 0;
+        uint32_t v = (uint32_t)in[i];
+        out[i] = (int32_t)(exclusive ? run : run + v);
+        run += v;
+    }
+}
+
+void simd_segmented_scan_f32(const float* in, const uint8_t* flags, float* out,
+                             size_t len, simd_scan_kind_t kind) {
+    bool exclusive = kind == SIMD_SCAN_EXCLUSIVE;
+    float32x4_t carry = vdupq_n_f32(0.0f);
+
+    // Process 4 elements at a time using NEON
+    size_t vec_size = len / 4;
+
+    for (size_t i = 0; i < vec_size; i++) {
+        uint32x4_t starts = flag_mask4(flags + i * 4);
+        uint32x4_t m = starts;
+        float32x4_t v = seg_scan_f32x4(vld1q_f32(in + i * 4), &m);
+
+        // Lanes before the first segment start continue the previous total
+        v = vaddq_f32(v, vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(carry), m)));
+
+        float32x4_t result = v;
+        if (exclusive) {
+            uint32x4_t shifted = vreinterpretq_u32_f32(vextq_f32(carry, v, 3));
+            result = vreinterpretq_f32_u32(vbicq_u32(shifted, starts));
+        }
+        vst1q_f32(out + i * 4, result);
+        carry = vdupq_laneq_f32(v, 3);
+    }
+
+    // Handle remaining elements
+    float run = vgetq_lane_f32(carry, 0);
+    for (size_t i = vec_size * 4; i < len; i++) {
+        if (flags[i]) run = 0.0f;
+        float v = in[i];
+        out[i] = exclusive ? run : run + v;
+        run += v;
+    }
+}
@@ -0,0 +1,863 @@
+/**
+ * simd_sched.c
+ * Work-stealing scheduler: per-thread Chase-Lev deques over a persistent pool
+ *
+ * Each deque is a fixed ring of task pointers. Its owner pushes and pops
+ * at the bottom, which costs plain loads and stores plus one fence on
+ * pop; thieves take from the top with a CAS, so the two ends only contend
+ * over the last task. Owners work depth-first on their newest (smallest)
+ * tasks while thieves take the oldest (largest), which keeps steals rare.
+ *
+ * Tasks live on the stack of the thread that spawned them: every spawn is
+ * joined before its frame returns, so no task is ever allocated. A join
+ * whose task was stolen keeps the thread busy by stealing other work
+ * until the thief marks the task done.
+ *
+ * Idle workers scan the deques, yield a few rounds, then sleep on a
+ * condition variable; a spawn wakes one sleeper only when any are asleep,
+ * so spawning under load stays free of system calls.
+ *
+ * Node placement hands each node's part of a loop to one of its workers
+ * through a single-entry inbox. While a worker runs node work its slot is
+ * marked bound, and thieves from other nodes pass bound deques by, so the
+ * part is split and stolen only within the node whose memory it touches.
+ */
+#define _GNU_SOURCE
+#include "simd_sched.h"
+#include "simd_parallel.h"
+#include "simd_numa.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+// Tasks per deque (power of two); a spawn into a full deque runs inline
+#define DEQUE_SIZE 1024
+
+// Pool workers besides the external slots
+#define MAX_WORKERS (SIMD_PARALLEL_MAX_THREADS - SIMD_SCHED_EXTERNAL_SLOTS)
+
+// Empty steal rounds before an idle worker sleeps
+#define IDLE_ROUNDS 64
+
+/*
+ * CPU Topology
+ */
+
+static int read_int(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+    long v = -1;
+    if (fscanf(f, "%ld", &v) != 1) v = -1;
+    fclose(f);
+    return v > 0 && v <= INT32_MAX ? (int)v : -1;
+}
+
+int simd_cpu_topology(const char* root, simd_cpu_t* cpus, int max) {
+    if (!root) root = "/sys/devices/system/cpu";
+    char path[256], list[1024];
+
+    snprintf(path, sizeof(path), "%s/online", root);
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    bool ok = fgets(list, sizeof(list), f) != NULL;
+    fclose(f);
+    if (!ok) return 0;
+
+    // Comma-separated ids and ranges: "0-3,6,8-11"
+    int count = 0;
+    char* p = list;
+    while (count < max) {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0) break;
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first) break;
+            p = end;
+        }
+        for (long id = first; id <= last && count < max; id++) {
+            cpus[count].id = (int)id;
+            snprintf(path, sizeof(path), "%s/cpu%ld/cpu_capacity", root, id);
+            int capacity = read_int(path);
+            if (capacity < 0) {
+                snprintf(path, sizeof(path), "%s/cpu%ld/cpufreq/cpuinfo_max_freq", root, id);
+                capacity = read_int(path);
+            }
+            cpus[count].capacity = capacity > 0 ? capacity : 1024;
+            count++;
+        }
+        if (*p != ',') break;
+        p++;
+    }
+
+    // Big cores are those above the midpoint of the capacity range
+    int lo = INT32_MAX, hi = 0;
+    for (int i = 0; i < count; i++) {
+        if (cpus[i].capacity < lo) lo = cpus[i].capacity;
+        if (cpus[i].capacity > hi) hi = cpus[i].capacity;
+    }
+    for (int i = 0; i < count; i++) {
+        cpus[i].big = lo == hi || 2 * (int64_t)cpus[i].capacity > (int64_t)lo + hi;
+    }
+    return count;
+}
+
+/*
+ * Deques
+ */
+
+typedef struct {
+    simd_task_fn_t fn;
+    void* ctx;
+    atomic_int done;            // Set by a thief once it has run the task
+} task_t;
+
+// One deque and its owner's counters, each end on its own cache line
+typedef struct {
+    atomic_llong top;           // Next task to steal
+    char pad0[56];
+    atomic_llong bottom;        // Next free entry, owner only
+    char pad1[56];
+    _Atomic(task_t*) tasks[DEQUE_SIZE];
+    atomic_ullong spawned;
+    atomic_ullong stolen;
+    atomic_ullong steal_failures;
+    atomic_ullong inline_runs;
+    atomic_int in_use;          // External slots: claimed by a calling thread
+    int node;                   // Node index of a worker, -1 for external slots
+    atomic_int bound;           // Nesting depth of node work, owner only
+    _Atomic(task_t*) inbox;     // Node work posted by another thread
+    uint32_t rng;
+    char pad2[64];
+} slot_t;
+
+static bool deque_push(slot_t* s, task_t* task) {
+    long long b = atomic_load_explicit(&s->bottom, memory_order_relaxed);
+    long long t = atomic_load_explicit(&s->top, memory_order_acquire);
+    if (b - t >= DEQUE_SIZE) return false;
+    atomic_store_explicit(&s->tasks[b & (DEQUE_SIZE - 1)], task, memory_order_release);
+    atomic_store_explicit(&s->bottom, b + 1, memory_order_release);
+    return true;
+}
+
+static task_t* deque_pop(slot_t* s) {
+    long long b = atomic_load_explicit(&s->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&s->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long t = atomic_load_explicit(&s->top, memory_order_relaxed);
+
+    task_t* task = NULL;
+    if (t <= b) {
+        task = atomic_load_explicit(&s->tasks[b & (DEQUE_SIZE - 1)], memory_order_relaxed);
+        if (t == b) {
+            // Last task: race the thieves for it
+            if (!atomic_compare_exchange_strong_explicit(&s->top, &t, t + 1, memory_order_seq_cst,
+                                                         memory_order_relaxed)) task = NULL;
+            atomic_store_explicit(&s->bottom, b + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&s->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static task_t* deque_steal(slot_t* s, const slot_t* thief) {
+    long long t = atomic_load_explicit(&s->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long b = atomic_load_explicit(&s->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+
+    // Node work stays on its node (the owner marks itself bound before
+    // pushing, so the acquire on bottom makes the mark visible)
+    if (s->node != thief->node && atomic_load_explicit(&s->bound, memory_order_relaxed) > 0) return NULL;
+
+    task_t* task = atomic_load_explicit(&s->tasks[t & (DEQUE_SIZE - 1)], memory_order_acquire);
+    if (!atomic_compare_exchange_strong_explicit(&s->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+static long long deque_size(slot_t* s) {
+    return atomic_load_explicit(&s->bottom, memory_order_relaxed) -
+           atomic_load_explicit(&s->top, memory_order_relaxed);
+}
+
+// Counters are written by the slot's current owner only
+static void bump(atomic_ullong* counter) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+/*
+ * Pool
+ */
+
+// External slots first, then one per worker
+static slot_t slots[SIMD_PARALLEL_MAX_THREADS];
+static atomic_int active_slots = SIMD_SCHED_EXTERNAL_SLOTS;
+static _Thread_local slot_t* current;
+
+static pthread_t handles[MAX_WORKERS];
+static int worker_cpu[MAX_WORKERS];
+static int workers;
+
+// Node placement: node i owns workers [node_first[i], node_first[i] + node_workers[i])
+static int node_count = 1;
+static int node_first[SIMD_NUMA_MAX_NODES];
+static int node_workers[SIMD_NUMA_MAX_NODES];
+static atomic_bool running;
+static atomic_bool stopping;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_mutex_t sleep_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sleep_cond = PTHREAD_COND_INITIALIZER;
+static atomic_int sleepers;
+
+// Detached jobs, oldest first
+static pthread_mutex_t post_lock = PTHREAD_MUTEX_INITIALIZER;
+static simd_job_t* post_head;
+static simd_job_t* post_tail;
+static atomic_int posted;
+
+static void run_task(task_t* task) {
+    task->fn(task->ctx);
+    atomic_store_explicit(&task->done, 1, memory_order_release);
+}
+
+// Run node work with the slot marked bound
+static void run_bound(slot_t* self, task_t* task) {
+    int depth = atomic_load_explicit(&self->bound, memory_order_relaxed);
+    atomic_store_explicit(&self->bound, depth + 1, memory_order_relaxed);
+    run_task(task);
+    atomic_store_explicit(&self->bound, depth, memory_order_relaxed);
+}
+
+// Run one task: posted node work first, else a steal from every other
+// deque once, from a random victim on. Returns false when none was found.
+static bool work_one(slot_t* self) {
+    if (atomic_load_explicit(&self->inbox, memory_order_relaxed)) {
+        task_t* task = atomic_exchange(&self->inbox, NULL);
+        if (task) {
+            run_bound(self, task);
+            return true;
+        }
+    }
+
+    int n = atomic_load_explicit(&active_slots, memory_order_acquire);
+    uint32_t r = self->rng;
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    self->rng = r;
+
+    for (int i = 0; i < n; i++) {
+        slot_t* victim = &slots[(r + (uint32_t)i) % (uint32_t)n];
+        if (victim == self) continue;
+        task_t* task = deque_steal(victim, self);
+        if (task) {
+            bump(&self->stolen);
+            // A task split from node work is node work (the victim stays
+            // bound until the task is joined)
+            if (atomic_load_explicit(&victim->bound, memory_order_relaxed) > 0) run_bound(self, task);
+            else run_task(task);
+            return true;
+        }
+    }
+    bump(&self->steal_failures);
+    return false;
+}
+
+static simd_job_t* take_job(void) {
+    if (atomic_load_explicit(&posted, memory_order_relaxed) == 0) return NULL;
+    pthread_mutex_lock(&post_lock);
+    simd_job_t* job = post_head;
+    if (job) {
+        post_head = job->next;
+        if (!post_head) post_tail = NULL;
+        atomic_fetch_sub(&posted, 1);
+    }
+    pthread_mutex_unlock(&post_lock);
+    return job;
+}
+
+static bool any_work(void) {
+    if (atomic_load(&posted) > 0) return true;
+    int n = atomic_load(&active_slots);
+    for (int i = 0; i < n; i++) {
+        if (atomic_load(&slots[i].bottom) - atomic_load(&slots[i].top) > 0) return true;
+        if (atomic_load(&slots[i].inbox)) return true;
+    }
+    return false;
+}
+
+static void* worker_main(void* arg) {
+    slot_t* self = (slot_t*)arg;
+    current = self;
+
+#ifdef __linux__
+    int cpu = worker_cpu[self - slots - SIMD_SCHED_EXTERNAL_SLOTS];
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+#endif
+
+    int idle = 0;
+    while (!atomic_load_explicit(&stopping, memory_order_acquire)) {
+        simd_job_t* job = take_job();
+        if (job) {
+            job->fn(job->ctx);
+            idle = 0;
+            continue;
+        }
+        if (work_one(self)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+
+        // Announce the sleep, then look once more: a spawner either sees
+        // the sleeper count or its task is found here
+        pthread_mutex_lock(&sleep_lock);
+        atomic_fetch_add(&sleepers, 1);
+        if (!atomic_load(&stopping) && !any_work()) pthread_cond_wait(&sleep_cond, &sleep_lock);
+        atomic_fetch_sub(&sleepers, 1);
+        pthread_mutex_unlock(&sleep_lock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+static void stop_pool(void) {
+    if (!atomic_load(&running)) return;
+    atomic_store(&stopping, true);
+    pthread_mutex_lock(&sleep_lock);
+    pthread_cond_broadcast(&sleep_cond);
+    pthread_mutex_unlock(&sleep_lock);
+    for (int i = 0; i < workers; i++) pthread_join(handles[i], NULL);
+
+    // Jobs left behind run here (they may post more)
+    node_count = 1;
+    simd_job_t* job;
+    while ((job = take_job()) != NULL) job->fn(job->ctx);
+
+    workers = 0;
+    atomic_store(&active_slots, SIMD_SCHED_EXTERNAL_SLOTS);
+    atomic_store(&stopping, false);
+    atomic_store(&running, false);
+}
+
+// Pin workers to the nodes' CPUs in even shares, each node's workers in
+// consecutive slots; returns the worker count
+static int place_numa(const simd_sched_config_t* config, int* node_of) {
+    simd_numa_node_t nodes[SIMD_NUMA_MAX_NODES];
+    int found = simd_numa_topology(config->numa_root, nodes, SIMD_NUMA_MAX_NODES);
+
+    // Memory-only nodes get no workers
+    int count = 0, cpus = 0;
+    for (int i = 0; i < found; i++) {
+        if (nodes[i].cpu_count == 0) continue;
+        cpus += nodes[i].cpu_count;
+        if (count != i) nodes[count] = nodes[i];
+        count++;
+    }
+
+    int threads = config->threads;
+    if (threads <= 0) threads = (cpus ? cpus : simd_parallel_cpu_count()) - 1;
+    if (threads > MAX_WORKERS) threads = MAX_WORKERS;
+    if (count == 0 || threads == 0) {
+        for (int i = 0; i < threads; i++) {
+            worker_cpu[i] = -1;
+            node_of[i] = 0;
+        }
+        return threads;
+    }
+
+    int w = 0;
+    node_count = threads < count ? threads : count;
+    for (int k = 0; k < node_count; k++) {
+        node_first[k] = w;
+        node_workers[k] = threads / count + (k < threads % count);
+        for (int j = 0; j < node_workers[k]; j++, w++) {
+            worker_cpu[w] = nodes[k].cpus[j % nodes[k].cpu_count];
+            node_of[w] = k;
+        }
+    }
+    return threads;
+}
+
+// Pin workers to the CPUs the policy selects, big cores first for SPREAD;
+// returns the worker count
+static int place_cpus(const simd_sched_config_t* config, int* node_of) {
+    simd_cpu_t cpus[SIMD_PARALLEL_MAX_THREADS * 4];
+    int found = config->affinity == SIMD_AFFINITY_NONE ? 0 :
+                simd_cpu_topology(config->topology_root, cpus, SIMD_PARALLEL_MAX_THREADS * 4);
+    int selected[SIMD_PARALLEL_MAX_THREADS * 4];
+    int count = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        bool want_big = pass == 0;
+        if (config->affinity == SIMD_AFFINITY_BIG && !want_big) continue;
+        if (config->affinity == SIMD_AFFINITY_LITTLE && want_big) continue;
+        for (int i = 0; i < found; i++) {
+            if (cpus[i].big == want_big) selected[count++] = cpus[i].id;
+        }
+    }
+
+    // A policy with no matching CPUs (LITTLE on a homogeneous system) floats
+    int threads = config->threads;
+    if (threads <= 0) threads = (count ? count : simd_parallel_cpu_count()) - 1;
+    if (threads > MAX_WORKERS) threads = MAX_WORKERS;
+    for (int i = 0; i < threads; i++) {
+        worker_cpu[i] = count ? selected[i % count] : -1;
+        node_of[i] = 0;
+    }
+    return threads;
+}
+
+static bool start_pool(const simd_sched_config_t* config) {
+    simd_sched_config_t defaults = { 0, SIMD_AFFINITY_NONE, NULL, NULL };
+    if (!config) config = &defaults;
+
+    int node_of[MAX_WORKERS];
+    node_count = 1;
+    int threads = config->affinity == SIMD_AFFINITY_NUMA ? place_numa(config, node_of) : place_cpus(config, node_of);
+    if (node_count == 1) {
+        node_first[0] = 0;
+        node_workers[0] = threads;
+    }
+
+    for (int i = 0; i < SIMD_PARALLEL_MAX_THREADS; i++) {
+        slots[i].rng = 2654435761u * (uint32_t)(i + 1);
+        slots[i].node = -1;
+    }
+    for (int i = 0; i < threads; i++) slots[SIMD_SCHED_EXTERNAL_SLOTS + i].node = node_of[i];
+
+    // Workers start in slot order; nodes left short of workers after a
+    // failure run their part on the calling thread
+    int started = 0;
+    while (started < threads &&
+           pthread_create(&handles[started], NULL, worker_main, &slots[SIMD_SCHED_EXTERNAL_SLOTS + started]) == 0) {
+        started++;
+    }
+    for (int k = 0; k < node_count; k++) {
+        int left = started - node_first[k];
+        if (node_workers[k] > left) node_workers[k] = left > 0 ? left : 0;
+    }
+    workers = started;
+    atomic_store(&active_slots, SIMD_SCHED_EXTERNAL_SLOTS + started);
+    atomic_store(&running, true);
+    return threads == 0 || started > 0;
+}
+
+static void ensure_started(void) {
+    if (atomic_load_explicit(&running, memory_order_acquire)) return;
+    pthread_mutex_lock(&pool_lock);
+    if (!atomic_load(&running)) start_pool(NULL);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+bool simd_sched_init(const simd_sched_config_t* config) {
+    pthread_mutex_lock(&pool_lock);
+    stop_pool();
+    bool ok = start_pool(config);
+    pthread_mutex_unlock(&pool_lock);
+    return ok;
+}
+
+void simd_sched_shutdown(void) {
+    pthread_mutex_lock(&pool_lock);
+    stop_pool();
+    pthread_mutex_unlock(&pool_lock);
+}
+
+int simd_sched_workers(void) {
+    ensure_started();
+    return workers;
+}
+
+int simd_sched_slot(void) {
+    return current ? (int)(current - slots) : -1;
+}
+
+void simd_sched_get_stats(simd_sched_stats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < SIMD_PARALLEL_MAX_THREADS; i++) {
+        stats->spawned += atomic_load_explicit(&slots[i].spawned, memory_order_relaxed);
+        stats->stolen += atomic_load_explicit(&slots[i].stolen, memory_order_relaxed);
+        stats->steal_failures += atomic_load_explicit(&slots[i].steal_failures, memory_order_relaxed);
+        stats->inline_runs += atomic_load_explicit(&slots[i].inline_runs, memory_order_relaxed);
+    }
+}
+
+void simd_sched_reset_stats(void) {
+    for (int i = 0; i < SIMD_PARALLEL_MAX_THREADS; i++) {
+        atomic_store(&slots[i].spawned, 0);
+        atomic_store(&slots[i].stolen, 0);
+        atomic_store(&slots[i].steal_failures, 0);
+        atomic_store(&slots[i].inline_runs, 0);
+    }
+}
+
+/*
+ * Spawn and Join
+ */
+
+// The calling thread's slot, claiming an external one if it has none;
+// NULL when all are taken (the work then runs serially)
+static slot_t* enter(bool* claimed) {
+    *claimed = false;
+    if (current) return current;
+    ensure_started();
+    for (int i = 0; i < SIMD_SCHED_EXTERNAL_SLOTS; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&slots[i].in_use, &expected, 1)) {
+            current = &slots[i];
+            *claimed = true;
+            return current;
+        }
+    }
+    return NULL;
+}
+
+static void leave(bool claimed) {
+    if (!claimed) return;
+    atomic_store_explicit(&current->in_use, 0, memory_order_release);
+    current = NULL;
+}
+
+static bool spawn(slot_t* self, task_t* task) {
+    if (!deque_push(self, task)) {
+        bump(&self->inline_runs);
+        return false;
+    }
+    bump(&self->spawned);
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&sleepers, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&sleep_lock);
+        pthread_cond_signal(&sleep_cond);
+        pthread_mutex_unlock(&sleep_lock);
+    }
+    return true;
+}
+
+static void join(slot_t* self, task_t* task) {
+    // Not stolen: it is the newest task of our own deque
+    task_t* top;
+    while ((top = deque_pop(self)) != NULL) {
+        if (top == task) {
+            task->fn(task->ctx);
+            return;
+        }
+        run_task(top);
+    }
+
+    // Stolen: help with other work until the thief finishes it
+    int spins = 0;
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        if (work_one(self)) {
+            spins = 0;
+        } else if (++spins > 16) {
+            sched_yield();
+        }
+    }
+}
+
+void simd_parallel_invoke(simd_task_fn_t a, void* ctx_a, simd_task_fn_t b, void* ctx_b) {
+    bool claimed;
+    slot_t* self = enter(&claimed);
+
+    task_t task;
+    task.fn = b;
+    task.ctx = ctx_b;
+    atomic_init(&task.done, 0);
+    if (self && spawn(self, &task)) {
+        a(ctx_a);
+        join(self, &task);
+    } else {
+        a(ctx_a);
+        b(ctx_b);
+    }
+    leave(claimed);
+}
+
+/*
+ * Parallel Loops
+ */
+
+typedef struct {
+    simd_range_fn_t fn;
+    void* ctx;
+    size_t grain;
+} for_job_t;
+
+typedef struct {
+    const for_job_t* job;
+    size_t begin;
+    size_t end;
+} for_range_t;
+
+static void for_task(void* arg);
+
+static void for_range(const for_job_t* job, size_t begin, size_t end) {
+    while (current && end - begin > job->grain) {
+        // Thieves still have our older work to take: stay serial
+        if (deque_size(current) > 0) {
+            job->fn(job->ctx, begin, begin + job->grain);
+            begin += job->grain;
+            continue;
+        }
+
+        size_t mid = begin + (end - begin) / 2;
+        for_range_t left = { job, begin, mid };
+        for_range_t right = { job, mid, end };
+        simd_parallel_invoke(for_task, &left, for_task, &right);
+        return;
+    }
+    if (end > begin) job->fn(job->ctx, begin, end);
+}
+
+static void for_task(void* arg) {
+    for_range_t* r = (for_range_t*)arg;
+    for_range(r->job, r->begin, r->end);
+}
+
+// Chunks of about 1/32 of each thread's share when not given
+static size_t default_grain(size_t n, size_t grain) {
+    if (grain) return grain;
+    grain = n / (32 * ((size_t)workers + 1));
+    return grain ? grain : 1;
+}
+
+void simd_parallel_for(size_t begin, size_t end, size_t grain, simd_range_fn_t fn, void* ctx) {
+    if (!fn || end <= begin) return;
+    bool claimed;
+    enter(&claimed);
+
+    for_job_t job = { fn, ctx, default_grain(end - begin, grain) };
+    for_range(&job, begin, end);
+    leave(claimed);
+}
+
+typedef struct {
+    simd_reduce_fn_t fn;
+    simd_combine_fn_t combine;
+    void* ctx;
+    size_t grain;
+    size_t size;
+    _Alignas(16) unsigned char identity[SIMD_PARALLEL_REDUCE_MAX];
+} reduce_job_t;
+
+typedef struct {
+    const reduce_job_t* job;
+    size_t begin;
+    size_t end;
+    void* acc;
+} reduce_range_t;
+
+static void reduce_task(void* arg);
+
+static void reduce_range(const reduce_job_t* job, size_t begin, size_t end, void* acc) {
+    while (current && end - begin > job->grain) {
+        if (deque_size(current) > 0) {
+            job->fn(job->ctx, begin, begin + job->grain, acc);
+            begin += job->grain;
+            continue;
+        }
+
+        // The right half starts from the identity and is merged after it
+        _Alignas(16) unsigned char right_acc[SIMD_PARALLEL_REDUCE_MAX];
+        memcpy(right_acc, job->identity, job->size);
+        size_t mid = begin + (end - begin) / 2;
+        reduce_range_t left = { job, begin, mid, acc };
+        reduce_range_t right = { job, mid, end, right_acc };
+        simd_parallel_invoke(reduce_task, &left, reduce_task, &right);
+        job->combine(job->ctx, acc, right_acc);
+        return;
+    }
+    if (end > begin) job->fn(job->ctx, begin, end, acc);
+}
+
+static void reduce_task(void* arg) {
+    reduce_range_t* r = (reduce_range_t*)arg;
+    reduce_range(r->job, r->begin, r->end, r->acc);
+}
+
+void simd_parallel_reduce(size_t begin, size_t end, size_t grain, void* result, size_t size,
+                          simd_reduce_fn_t fn, simd_combine_fn_t combine, void* ctx) {
+    if (!fn || !combine || !result || end <= begin) return;
+    if (size > SIMD_PARALLEL_REDUCE_MAX) {
+        fn(ctx, begin, end, result);
+        return;
+    }
+
+    bool claimed;
+    enter(&claimed);
+
+    reduce_job_t job;
+    job.fn = fn;
+    job.combine = combine;
+    job.ctx = ctx;
+    job.grain = default_grain(end - begin, grain);
+    job.size = size;
+    memcpy(job.identity, result, size);
+    reduce_range(&job, begin, end, result);
+    leave(claimed);
+}
+
+/*
+ * Detached Jobs
+ */
+
+void simd_sched_post(simd_job_t* job) {
+    if (!job || !job->fn) return;
+    ensure_started();
+    if (workers == 0) {
+        job->fn(job->ctx);
+        return;
+    }
+
+    job->next = NULL;
+    pthread_mutex_lock(&post_lock);
+    if (post_tail) post_tail->next = job;
+    else post_head = job;
+    post_tail = job;
+    atomic_fetch_add(&posted, 1);
+    pthread_mutex_unlock(&post_lock);
+
+    if (atomic_load(&sleepers) > 0) {
+        pthread_mutex_lock(&sleep_lock);
+        pthread_cond_signal(&sleep_cond);
+        pthread_mutex_unlock(&sleep_lock);
+    }
+}
+
+/*
+ * NUMA Placement
+ */
+
+int simd_sched_nodes(void) {
+    ensure_started();
+    return node_count;
+}
+
+int simd_sched_node(void) {
+    return current ? current->node : -1;
+}
+
+size_t simd_sched_node_start(size_t n, int node) {
+    if (node >= node_count || (node > 0 && node_first[node] >= workers)) return n;
+    if (node <= 0) return 0;
+    return (size_t)((unsigned long long)n * (unsigned long long)node_first[node] / (unsigned long long)workers);
+}
+
+typedef struct {
+    task_t task;
+    for_job_t job;
+    size_t begin;
+    size_t end;
+} node_part_t;
+
+static void node_task(void* arg) {
+    node_part_t* part = (node_part_t*)arg;
+    for_range(&part->job, part->begin, part->end);
+}
+
+// Hand PART to an idle inbox of NODE, waking the sleepers
+static bool post(int node, node_part_t* part) {
+    for (int i = 0; i < node_workers[node]; i++) {
+        slot_t* s = &slots[SIMD_SCHED_EXTERNAL_SLOTS + node_first[node] + i];
+        task_t* expected = NULL;
+        if (s == current || !atomic_compare_exchange_strong(&s->inbox, &expected, &part->task)) continue;
+
+        if (atomic_load(&sleepers) > 0) {
+            pthread_mutex_lock(&sleep_lock);
+            pthread_cond_broadcast(&sleep_cond);
+            pthread_mutex_unlock(&sleep_lock);
+        }
+        return true;
+    }
+    return false;
+}
+
+// Run parts [first, first + count) on their nodes and wait for all of them.
+// A part no inbox takes runs here, off its node; while waiting, the caller
+// only takes work that is not bound to a node.
+static void run_parts(node_part_t* parts, int first, int count) {
+    bool claimed;
+    slot_t* self = enter(&claimed);
+
+    bool posted[SIMD_NUMA_MAX_NODES];
+    for (int i = 0; i < count; i++) {
+        node_part_t* p = &parts[i];
+        p->task.fn = node_task;
+        p->task.ctx = p;
+        atomic_init(&p->task.done, 0);
+        size_t n = p->end - p->begin;
+        if (p->job.grain == 0) {
+            int share = node_workers[first + i] > 0 ? node_workers[first + i] : 1;
+            p->job.grain = n / (32 * (size_t)share);
+            if (p->job.grain == 0) p->job.grain = 1;
+        }
+        posted[i] = n > 0 && post(first + i, p);
+    }
+    for (int i = 0; i < count; i++) {
+        if (!posted[i] && parts[i].end > parts[i].begin) node_task(&parts[i]);
+    }
+
+    int spins = 0;
+    for (int i = 0; i < count; i++) {
+        while (posted[i] && !atomic_load_explicit(&parts[i].task.done, memory_order_acquire)) {
+            if (self && work_one(self)) {
+                spins = 0;
+            } else if (++spins > 16) {
+                sched_yield();
+            }
+        }
+    }
+    leave(claimed);
+}
+
+void simd_parallel_for_node(int node, size_t begin, size_t end, size_t grain, simd_range_fn_t fn, void* ctx) {
+    if (!fn || end <= begin) return;
+    ensure_started();
+    if (node < 0 || node >= node_count) return;
+
+    node_part_t part;
+    part.job.fn = fn;
+    part.job.ctx = ctx;
+    part.job.grain = grain;
+    part.begin = begin;
+    part.end = end;
+    run_parts(&part, node, 1);
+}
+
+void simd_parallel_for_nodes(size_t begin, size_t end, size_t grain, simd_range_fn_t fn, void* ctx) {
+    if (!fn || end <= begin) return;
+    ensure_started();
+    if (node_count <= 1 || (current && atomic_load_explicit(&current->bound, memory_order_relaxed) > 0)) {
+        simd_parallel_for(begin, end, grain, fn, ctx);
+        return;
+    }
+
+    node_part_t parts[SIMD_NUMA_MAX_NODES];
+    for (int k = 0; k < node_count; k++) {
+        parts[k].job.fn = fn;
+        parts[k].job.ctx = ctx;
+        parts[k].job.grain = grain;
+        parts[k].begin = begin + simd_sched_node_start(end - begin, k);
+        parts[k].end = begin + simd_sched_node_start(end - begin, k + 1);
+    }
+    run_parts(parts, 0, node_count);
+}
@@ -0,0 +1,354 @@
+/**
+ * simd_tile.c
+ * Tiled execution of stencil kernels on the work-stealing scheduler
+ *
+ * Tiles are sized so that a tile's source (with halo) and destination
+ * stay resident in L2 while the kernel runs over them. Interior tiles,
+ * whose halo lies inside the image, are handed to the kernel in place;
+ * only tiles touching the image edge are copied into a per-worker staging
+ * buffer with the border extended, so kernels never special-case borders.
+ *
+ * Tiles are numbered in raster order and run as a parallel loop on the
+ * work-stealing scheduler, whose thieves take the largest remaining run
+ * of tiles: neighbouring tiles (and their shared halo rows) mostly stay
+ * on one core, and a core that runs dry takes over half of another's.
+ * Under NUMA placement each node first gets its share of the raster
+ * order, i.e. the rows whose pages it first touched.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "simd_tile.h"
+#include "simd_parallel.h"
+#include "simd_sched.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <arm_neon.h>
+
+// L2 size assumed when the system does not report one
+#define TILE_DEFAULT_L2 (512 * 1024)
+
+// Minimum tiles per worker, for load balance
+#define TILE_MIN_PER_WORKER 4
+
+/*
+ * Cache Size
+ */
+
+size_t simd_tile_l2_size(void) {
+    static size_t cached;
+    if (cached) return cached;
+
+    size_t size = 0;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long n = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (n > 0) size = (size_t)n;
+#endif
+
+    // The cache index holding the level-2 data or unified cache
+    for (int i = 0; size == 0 && i < 8; i++) {
+        char path[96], buf[32];
+        int level = 0;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", i);
+        FILE* f = fopen(path, "r");
+        if (!f) break;
+        if (fscanf(f, "%d", &level) != 1) level = 0;
+        fclose(f);
+        if (level != 2) continue;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", i);
+        f = fopen(path, "r");
+        if (!f) continue;
+        if (fgets(buf, sizeof(buf), f)) {
+            char* end;
+            unsigned long v = strtoul(buf, &end, 10);
+            if (*end == 'K') v *= 1024;
+            else if (*end == 'M') v *= 1024 * 1024;
+            size = (size_t)v;
+        }
+        fclose(f);
+    }
+
+    cached = size ? size : TILE_DEFAULT_L2;
+    return cached;
+}
+
+/*
+ * Executor
+ */
+
+typedef struct {
+    const uint8_t* src;
+    size_t src_stride;
+    uint8_t* dst;
+    size_t dst_stride;
+    int width;
+    int height;
+    int pixel_size;
+    int halo;
+    simd_border_t border;
+    uint8_t border_value;
+    int tile_width;
+    int tile_height;
+    int tiles_x;
+    simd_tile_fn_t fn;
+    void* ctx;
+    size_t staging_size;
+    uint8_t* staging[SIMD_PARALLEL_MAX_THREADS];   // Per scheduler slot, allocated on first edge tile
+    atomic_bool failed;
+} tile_exec_t;
+
+// Copy source rows/columns around the tile into BUF, extending the border
+static void stage_tile(const tile_exec_t* e, int x0, int y0, int tw, int th, uint8_t* buf, size_t stride) {
+    int h = e->halo;
+    int ps = e->pixel_size;
+
+    // Columns of the staged row that lie inside the image
+    int in0 = x0 - h < 0 ? 0 : x0 - h;
+    int in1 = x0 + tw + h > e->width ? e->width : x0 + tw + h;
+
+    for (int j = -h; j < th + h; j++) {
+        uint8_t* out = buf + (size_t)(j + h) * stride;
+        int sy = simd_border_index(y0 + j, e->height, e->border);
+        if (sy < 0) {
+            memset(out, e->border_value, stride);
+            continue;
+        }
+
+        const uint8_t* row = e->src + (size_t)sy * e->src_stride;
+        memcpy(out + (size_t)(in0 - (x0 - h)) * ps, row + (size_t)in0 * ps, (size_t)(in1 - in0) * ps);
+        for (int x = x0 - h; x < x0 + tw + h; x++) {
+            if (x >= in0 && x < in1) {
+                x = in1 - 1;
+                continue;
+            }
+            int sx = simd_border_index(x, e->width, e->border);
+            uint8_t* p = out + (size_t)(x - (x0 - h)) * ps;
+            if (sx < 0) {
+                memset(p, e->border_value, (size_t)ps);
+            } else {
+                memcpy(p, row + (size_t)sx * ps, (size_t)ps);
+            }
+        }
+    }
+}
+
+static void run_tile(tile_exec_t* e, int worker, int index) {
+    int h = e->halo;
+    int ps = e->pixel_size;
+    simd_tile_t t;
+    t.x0 = (index % e->tiles_x) * e->tile_width;
+    t.y0 = (index / e->tiles_x) * e->tile_height;
+    t.width = e->width - t.x0 < e->tile_width ? e->width - t.x0 : e->tile_width;
+    t.height = e->height - t.y0 < e->tile_height ? e->height - t.y0 : e->tile_height;
+    t.halo = h;
+    t.worker = worker;
+    t.dst_stride = e->dst_stride;
+    t.dst = e->dst + (size_t)t.y0 * t.dst_stride + (size_t)t.x0 * ps;
+
+    if (t.x0 >= h && t.y0 >= h && t.x0 + t.width + h <= e->width && t.y0 + t.height + h <= e->height) {
+        t.src_stride = e->src_stride;
+        t.src = e->src + (size_t)t.y0 * t.src_stride + (size_t)t.x0 * ps;
+    } else {
+        if (!e->staging[worker]) e->staging[worker] = (uint8_t*)neon_malloc(e->staging_size);
+        if (!e->staging[worker]) {
+            atomic_store(&e->failed, true);
+            return;
+        }
+        t.src_stride = (size_t)(e->tile_width + 2 * h) * ps;
+        stage_tile(e, t.x0, t.y0, t.width, t.height, e->staging[worker], t.src_stride);
+        t.src = e->staging[worker] + (size_t)h * t.src_stride + (size_t)h * ps;
+    }
+
+    e->fn(e->ctx, &t);
+}
+
+// Tiles [begin, end); a thread without a scheduler slot runs the whole
+// loop alone, so it can use slot 0's staging buffer
+static void tile_range(void* arg, size_t begin, size_t end) {
+    tile_exec_t* e = (tile_exec_t*)arg;
+    int slot = simd_sched_slot();
+    if (slot < 0) slot = 0;
+    for (size_t i = begin; i < end; i++) run_tile(e, slot, (int)i);
+}
+
+static bool tiling_valid(const simd_tiling_t* tiling) {
+    return tiling && tiling->halo >= 0 && tiling->halo <= SIMD_TILE_MAX_HALO && tiling->pixel_size >= 0 &&
+           tiling->tile_width >= 0 && tiling->tile_height >= 0;
+}
+
+static int tile_run(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride, int width, int height,
+                    const simd_tiling_t* tiling, simd_tile_fn_t fn, void* ctx) {
+    tile_exec_t* e = (tile_exec_t*)calloc(1, sizeof(tile_exec_t));
+    if (!e) return 0;
+    e->src = src;
+    e->src_stride = src_stride;
+    e->dst = dst;
+    e->dst_stride = dst_stride;
+    e->width = width;
+    e->height = height;
+    e->pixel_size = tiling->pixel_size ? tiling->pixel_size : 1;
+    e->halo = tiling->halo;
+    e->border = tiling->border;
+    e->border_value = tiling->border_value;
+    e->fn = fn;
+    e->ctx = ctx;
+
+    int threads = tiling->threads > 0 ? tiling->threads : simd_sched_workers() + 1;
+    if (threads > SIMD_PARALLEL_MAX_THREADS) threads = SIMD_PARALLEL_MAX_THREADS;
+
+    // Default tiles: up to 512 pixels wide, with source and destination
+    // sharing half of L2, and at least a few tiles per worker
+    int tw = tiling->tile_width;
+    int th = tiling->tile_height;
+    if (tw == 0) tw = width < 512 ? width : 512;
+    if (th == 0) {
+        size_t budget = simd_tile_l2_size() / 2;
+        th = (int)(budget / (2 * (size_t)(tw + 2 * e->halo) * e->pixel_size)) - 2 * e->halo;
+        int tiles_x = (width + tw - 1) / tw;
+        int balanced = (int)(((int64_t)height * tiles_x + threads * TILE_MIN_PER_WORKER - 1) /
+                             (threads * TILE_MIN_PER_WORKER));
+        if (th > balanced) th = balanced;
+        if (th < 8) th = 8;
+    }
+    if (tw > width) tw = width;
+    if (th > height) th = height;
+    e->tile_width = tw;
+    e->tile_height = th;
+    e->tiles_x = (width + tw - 1) / tw;
+    int tiles = e->tiles_x * ((height + th - 1) / th);
+
+    e->staging_size = (size_t)(tw + 2 * e->halo) * (th + 2 * e->halo) * e->pixel_size;
+    atomic_init(&e->failed, false);
+
+    // One thread runs inline; otherwise at least TILE_MIN_PER_WORKER
+    // chunks per requested thread, or the adaptive grain
+    if (threads == 1) {
+        tile_range(e, 0, (size_t)tiles);
+    } else {
+        size_t grain = tiling->threads > 0 ? (size_t)(tiles + threads * TILE_MIN_PER_WORKER - 1) /
+                                                 (size_t)(threads * TILE_MIN_PER_WORKER) : 0;
+        simd_parallel_for_nodes(0, (size_t)tiles, grain, tile_range, e);
+    }
+
+    bool ok = !atomic_load(&e->failed);
+    for (int i = 0; i < SIMD_PARALLEL_MAX_THREADS; i++) free(e->staging[i]);
+    free(e);
+    return ok ? tiles : 0;
+}
+
+int simd_tile_run(const uint8_t* src, uint8_t* dst, int width, int height,
+                  const simd_tiling_t* tiling, simd_tile_fn_t fn, void* ctx) {
+    if (!src || !dst || !tiling_valid(tiling) || !fn || width <= 0 || height <= 0) return 0;
+
+    size_t stride = (size_t)width * (tiling->pixel_size ? tiling->pixel_size : 1);
+    return tile_run(src, stride, dst, stride, width, height, tiling, fn, ctx);
+}
+
+int simd_tile_run_view(const simd_image_t* src, const simd_image_t* dst,
+                       const simd_tiling_t* tiling, simd_tile_fn_t fn, void* ctx) {
+    if (!tiling_valid(tiling) || !fn) return 0;
+    if (!src || !dst || !src->data || !dst->data || src->width <= 0 || src->height <= 0) return 0;
+    if (dst->width != src->width || dst->height != src->height) return 0;
+
+    size_t row_bytes = (size_t)src->width * (tiling->pixel_size ? tiling->pixel_size : 1);
+    if (src->stride < row_bytes || dst->stride < row_bytes) return 0;
+
+    return tile_run(src->data, src->stride, dst->data, dst->stride, src->width, src->height, tiling, fn, ctx);
+}
+
+/*
+ * Stencil Tile Kernels
+ */
+
+void simd_tile_box3x3_u8(void* ctx, const simd_tile_t* t) {
+    (void)ctx;
+    size_t ss = t->src_stride;
+
+    for (int y = 0; y < t->height; y++) {
+        const uint8_t* r0 = t->src + (ptrdiff_t)(y - 1) * (ptrdiff_t)ss - 1;
+        const uint8_t* r1 = r0 + ss;
+        const uint8_t* r2 = r1 + ss;
+        uint8_t* out = t->dst + (size_t)y * t->dst_stride;
+
+        if (t->width < 16) {
+            for (int x = 0; x < t->width; x++) {
+                uint32_t sum = 0;
+                for (int k = 0; k < 3; k++) sum += r0[x + k] + r1[x + k] + r2[x + k];
+                out[x] = (uint8_t)((sum * 7282 + 32768) >> 16);
+            }
+            continue;
+        }
+
+        // Process 16 pixels at a time; the last block overlaps the previous one
+        for (int x = 0; x < t->width; x += 16) {
+            int j = x + 16 <= t->width ? x : t->width - 16;
+            uint16x8_t lo = vdupq_n_u16(0);
+            uint16x8_t hi = vdupq_n_u16(0);
+            for (int k = 0; k < 3; k++) {
+                uint8x16_t a = vld1q_u8(r0 + j + k);
+                uint8x16_t b = vld1q_u8(r1 + j + k);
+                uint8x16_t c = vld1q_u8(r2 + j + k);
+                lo = vaddq_u16(lo, vaddl_u8(vget_low_u8(a), vget_low_u8(b)));
+                hi = vaddq_u16(hi, vaddl_high_u8(a, b));
+                lo = vaddw_u8(lo, vget_low_u8(c));
+                hi = vaddw_high_u8(hi, c);
+            }
+
+            // round(sum / 9) = (sum * 7282 + 2^15) >> 16 for sum <= 9 * 255
+            uint16x4_t q0 = vrshrn_n_u32(vmull_n_u16(vget_low_u16(lo), 7282), 16);
+            uint16x4_t q1 = vrshrn_n_u32(vmull_n_u16(vget_high_u16(lo), 7282), 16);
+            uint16x4_t q2 = vrshrn_n_u32(vmull_n_u16(vget_low_u16(hi), 7282), 16);
+            uint16x4_t q3 = vrshrn_n_u32(vmull_n_u16(vget_high_u16(hi), 7282), 16);
+            vst1q_u8(out + j, vcombine_u8(vmovn_u16(vcombine_u16(q0, q1)), vmovn_u16(vcombine_u16(q2, q3))));
+        }
+    }
+}
+
+static inline int16x8_t widen_s16(uint8x8_t v) {
+    return vreinterpretq_s16_u16(vmovl_u8(v));
+}
+
+// (|Gx| + |Gy|) / 2 for 8 pixels starting at column j
+static inline uint8x8_t sobel_u8x8(const uint8_t* r0, const uint8_t* r1, const uint8_t* r2, int j) {
+    int16x8_t t0 = widen_s16(vld1_u8(r0 + j)), t1 = widen_s16(vld1_u8(r0 + j + 1)), t2 = widen_s16(vld1_u8(r0 + j + 2));
+    int16x8_t m0 = widen_s16(vld1_u8(r1 + j)), m2 = widen_s16(vld1_u8(r1 + j + 2));
+    int16x8_t b0 = widen_s16(vld1_u8(r2 + j)), b1 = widen_s16(vld1_u8(r2 + j + 1)), b2 = widen_s16(vld1_u8(r2 + j + 2));
+
+    // Gx = (t2 + 2 m2 + b2) - (t0 + 2 m0 + b0), Gy = (b0 + 2 b1 + b2) - (t0 + 2 t1 + t2)
+    int16x8_t gx = vsubq_s16(vaddq_s16(vaddq_s16(t2, b2), vshlq_n_s16(m2, 1)),
+                             vaddq_s16(vaddq_s16(t0, b0), vshlq_n_s16(m0, 1)));
+    int16x8_t gy = vsubq_s16(vaddq_s16(vaddq_s16(b0, b2), vshlq_n_s16(b1, 1)),
+                             vaddq_s16(vaddq_s16(t0, t2), vshlq_n_s16(t1, 1)));
+    int16x8_t sum = vaddq_s16(vabsq_s16(gx), vabsq_s16(gy));
+    return vqmovun_s16(vshrq_n_s16(sum, 1));
+}
+
+void simd_tile_sobel_u8(void* ctx, const simd_tile_t* t) {
+    (void)ctx;
+    size_t ss = t->src_stride;
+
+    for (int y = 0; y < t->height; y++) {
+        const uint8_t* r0 = t->src + (ptrdiff_t)(y - 1) * (ptrdiff_t)ss - 1;
+        const uint8_t* r1 = r0 + ss;
+        const uint8_t* r2 = r1 + ss;
+        uint8_t* out = t->dst + (size_t)y * t->dst_stride;
+
+        if (t->width < 8) {
+            for (int x = 0; x < t->width; x++) {
+                int gx = (r0[x + 2] + 2 * r1[x + 2] + r2[x + 2]) - (r0[x] + 2 * r1[x] + r2[x]);
+                int gy = (r2[x] + 2 * r2[x + 1] + r2[x + 2]) - (r0[x] + 2 * r0[x + 1] + r0[x + 2]);
+                int v = ((gx < 0 ? -gx : gx) + (gy < 0 ? -gy : gy)) >> 1;
+                out[x] = (uint8_t)(v > 255 ? 255 : v);
+            }
+            continue;
+        }
+
+        // Process 8 pixels at a time; the last block overlaps the previous one
+        for (int x = 0; x < t->width; x += 8) {
+            int j = x + 8 <= t->width ? x : t->width - 8;
+            vst1_u8(out + j, sobel_u8x8(r0, r1, r2, j));
+        }
+    }
+}
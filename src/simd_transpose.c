@@ -0,0 +1,359 @@
+/**
+ * simd_transpose.c
+ * Implementation of matrix transpose kernels using NEON
+ *
+ * Each micro-transpose is a log2(N)-step butterfly: step d exchanges
+ * elements of width (d * element size) between rows i and i + d with
+ * vtrn1q/vtrn2q, and the final 64-bit step uses vzip1q/vzip2q. A 4x4 f32
+ * block takes 2 steps, an 8x8 u16 block 3 and a 16x16 u8 block 4, all on
+ * registers loaded and stored with full-width row accesses.
+ */
+#include "simd_transpose.h"
+#include <arm_neon.h>
+
+// Tile edge (in elements) at which the recursion stops: source and
+// destination tiles together stay within L1
+#define TRANSPOSE_TILE_F32 64
+#define TRANSPOSE_TILE_U16 64
+#define TRANSPOSE_TILE_U8 128
+
+// Leaf kernel: transpose rows [r0, r1) x cols [c0, c1) of a rows x cols matrix
+typedef void (*transpose_leaf_fn)(const void* src, void* dst, size_t rows, size_t cols,
+                                  size_t r0, size_t r1, size_t c0, size_t c1);
+
+/*
+ * Register Micro-transposes
+ */
+
+static inline void transpose_4x4_f32(float32x4_t r[4]) {
+    // Step 1: exchange 32-bit elements between rows (0,1) and (2,3)
+    float32x4_t t0 = vtrn1q_f32(r[0], r[1]);
+    float32x4_t t1 = vtrn2q_f32(r[0], r[1]);
+    float32x4_t t2 = vtrn1q_f32(r[2], r[3]);
+    float32x4_t t3 = vtrn2q_f32(r[2], r[3]);
+
+    // Step 2: exchange 64-bit halves between rows (0,2) and (1,3)
+    float64x2_t d0 = vreinterpretq_f64_f32(t0);
+    float64x2_t d1 = vreinterpretq_f64_f32(t1);
+    float64x2_t d2 = vreinterpretq_f64_f32(t2);
+    float64x2_t d3 = vreinterpretq_f64_f32(t3);
+    r[0] = vreinterpretq_f32_f64(vzip1q_f64(d0, d2));
+    r[1] = vreinterpretq_f32_f64(vzip1q_f64(d1, d3));
+    r[2] = vreinterpretq_f32_f64(vzip2q_f64(d0, d2));
+    r[3] = vreinterpretq_f32_f64(vzip2q_f64(d1, d3));
+}
+
+static inline void transpose_8x8_u16(uint16x8_t r[8]) {
+    // Step 1: exchange 16-bit elements between rows (i, i+1)
+    for (int i = 0; i < 8; i += 2) {
+        uint16x8_t t0 = vtrn1q_u16(r[i], r[i + 1]);
+        uint16x8_t t1 = vtrn2q_u16(r[i], r[i + 1]);
+        r[i] = t0;
+        r[i + 1] = t1;
+    }
+
+    // Step 2: exchange 32-bit pairs between rows (i, i+2)
+    for (int i = 0; i < 8; i++) {
+        if (i & 2) continue;
+        uint32x4_t a = vreinterpretq_u32_u16(r[i]);
+        uint32x4_t b = vreinterpretq_u32_u16(r[i + 2]);
+        r[i] = vreinterpretq_u16_u32(vtrn1q_u32(a, b));
+        r[i + 2] = vreinterpretq_u16_u32(vtrn2q_u32(a, b));
+    }
+
+    // Step 3: exchange 64-bit halves between rows (i, i+4)
+    for (int i = 0; i < 4; i++) {
+        uint64x2_t a = vreinterpretq_u64_u16(r[i]);
+        uint64x2_t b = vreinterpretq_u64_u16(r[i + 4]);
+        r[i] = vreinterpretq_u16_u64(vzip1q_u64(a, b));
+        r[i + 4] = vreinterpretq_u16_u64(vzip2q_u64(a, b));
+    }
+}
+
+static inline void transpose_16x16_u8(uint8x16_t r[16]) {
+    // Step 1: exchange bytes between rows (i, i+1)
+    for (int i = 0; i < 16; i += 2) {
+        uint8x16_t t0 = vtrn1q_u8(r[i], r[i + 1]);
+        uint8x16_t t1 = vtrn2q_u8(r[i], r[i + 1]);
+        r[i] = t0;
+        r[i + 1] = t1;
+    }
+
+    // Step 2: exchange 16-bit pairs between rows (i, i+2)
+    for (int i = 0; i < 16; i++) {
+        if (i & 2) continue;
+        uint16x8_t a = vreinterpretq_u16_u8(r[i]);
+        uint16x8_t b = vreinterpretq_u16_u8(r[i + 2]);
+        r[i] = vreinterpretq_u8_u16(vtrn1q_u16(a, b));
+        r[i + 2] = vreinterpretq_u8_u16(vtrn2q_u16(a, b));
+    }
+
+    // Step 3: exchange 32-bit groups between rows (i, i+4)
+    for (int i = 0; i < 16; i++) {
+        if (i & 4) continue;
+        uint32x4_t a = vreinterpretq_u32_u8(r[i]);
+        uint32x4_t b = vreinterpretq_u32_u8(r[i + 4]);
+        r[i] = vreinterpretq_u8_u32(vtrn1q_u32(a, b));
+        r[i + 4] = vreinterpretq_u8_u32(vtrn2q_u32(a, b));
+    }
+
+    // Step 4: exchange 64-bit halves between rows (i, i+8)
+    for (int i = 0; i < 8; i++) {
+        uint64x2_t a = vreinterpretq_u64_u8(r[i]);
+        uint64x2_t b = vreinterpretq_u64_u8(r[i + 8]);
+        r[i] = vreinterpretq_u8_u64(vzip1q_u64(a, b));
+        r[i + 8] = vreinterpretq_u8_u64(vzip2q_u64(a, b));
+    }
+}
+
+/*
+ * Block Load / Transpose / Store
+ */
+
+static inline void transpose_block_f32(const float* src, size_t src_stride, float* dst, size_t dst_stride) {
+    float32x4_t r[4];
+    for (int i = 0; i < 4; i++) r[i] = vld1q_f32(src + i * src_stride);
+    transpose_4x4_f32(r);
+    for (int i = 0; i < 4; i++) vst1q_f32(dst + i * dst_stride, r[i]);
+}
+
+static inline void transpose_block_u16(const uint16_t* src, size_t src_stride, uint16_t* dst, size_t dst_stride) {
+    uint16x8_t r[8];
+    for (int i = 0; i < 8; i++) r[i] = vld1q_u16(src + i * src_stride);
+    transpose_8x8_u16(r);
+    for (int i = 0; i < 8; i++) vst1q_u16(dst + i * dst_stride, r[i]);
+}
+
+static inline void transpose_block_u8(const uint8_t* src, size_t src_stride, uint8_t* dst, size_t dst_stride) {
+    uint8x16_t r[16];
+    for (int i = 0; i < 16; i++) r[i] = vld1q_u8(src + i * src_stride);
+    transpose_16x16_u8(r);
+    for (int i = 0; i < 16; i++) vst1q_u8(dst + i * dst_stride, r[i]);
+}
+
+/*
+ * Tile Leaves
+ */
+
+static void transpose_leaf_f32(const void* src_v, void* dst_v, size_t rows, size_t cols,
+                               size_t r0, size_t r1, size_t c0, size_t c1) {
+    const float* src = (const float*)src_v;
+    float* dst = (float*)dst_v;
+
+    // Full 4x4 blocks
+    size_t r_full = r0 + (r1 - r0) / 4 * 4;
+    size_t c_full = c0 + (c1 - c0) / 4 * 4;
+    for (size_t r = r0; r < r_full; r += 4) {
+        for (size_t c = c0; c < c_full; c += 4) {
+            transpose_block_f32(src + r * cols + c, cols, dst + c * rows + r, rows);
+        }
+    }
+
+    // Handle remaining columns and rows
+    for (size_t r = r0; r < r1; r++) {
+        for (size_t c = (r < r_full) ? c_full : c0; c < c1; c++) {
+            dst[c * rows + r] = src[r * cols + c];
+        }
+    }
+}
+
+static void transpose_leaf_u16(const void* src_v, void* dst_v, size_t rows, size_t cols,
+                               size_t r0, size_t r1, size_t c0, size_t c1) {
+    const uint16_t* src = (const uint16_t*)src_v;
+    uint16_t* dst = (uint16_t*)dst_v;
+
+    // Full 8x8 blocks
+    size_t r_full = r0 + (r1 - r0) / 8 * 8;
+    size_t c_full = c0 + (c1 - c0) / 8 * 8;
+    for (size_t r = r0; r < r_full; r += 8) {
+        for (size_t c = c0; c < c_full; c += 8) {
+            transpose_block_u16(src + r * cols + c, cols, dst + c * rows + r, rows);
+        }
+    }
+
+    // Handle remaining columns and rows
+    for (size_t r = r0; r < r1; r++) {
+        for (size_t c = (r < r_full) ? c_full : c0; c < c1; c++) {
+            dst[c * rows + r] = src[r * cols + c];
+        }
+    }
+}
+
+static void transpose_leaf_u8(const void* src_v, void* dst_v, size_t rows, size_t cols,
+                              size_t r0, size_t r1, size_t c0, size_t c1) {
+    const uint8_t* src = (const uint8_t*)src_v;
+    uint8_t* dst = (uint8_t*)dst_v;
+
+    // Full 16x16 blocks
+    size_t r_full = r0 + (r1 - r0) / 16 * 16;
+    size_t c_full = c0 + (c1 - c0) / 16 * 16;
+    for (size_t r = r0; r < r_full; r += 16) {
+        for (size_t c = c0; c < c_full; c += 16) {
+            transpose_block_u8(src + r * cols + c, cols, dst + c * rows + r, rows);
+        }
+    }
+
+    // Handle remaining columns and rows
+    for (size_t r = r0; r < r1; r++) {
+        for (size_t c = (r < r_full) ? c_full : c0; c < c1; c++) {
+            dst[c * rows + r] = src[r * cols + c];
+        }
+    }
+}
+
+/*
+ * Cache-oblivious Recursion
+ */
+
+// Halve the longer side until the region fits a tile. Split points are
+// kept on block boundaries so only the matrix edge has partial blocks.
+static void transpose_recursive(const void* src, void* dst, size_t rows, size_t cols,
+                                size_t r0, size_t r1, size_t c0, size_t c1,
+                                size_t block, size_t tile, transpose_leaf_fn leaf) {
+    size_t h = r1 - r0;
+    size_t w = c1 - c0;
+
+    if ((h <= tile && w <= tile) || (h < 2 * block && w < 2 * block)) {
+        leaf(src, dst, rows, cols, r0, r1, c0, c1);
+        return;
+    }
+
+    if (h >= w && h >= 2 * block) {
+        size_t mid = r0 + (h / 2) / block * block;
+        transpose_recursive(src, dst, rows, cols, r0, mid, c0, c1, block, tile, leaf);
+        transpose_recursive(src, dst, rows, cols, mid, r1, c0, c1, block, tile, leaf);
+    } else {
+        size_t mid = c0 + (w / 2) / block * block;
+        transpose_recursive(src, dst, rows, cols, r0, r1, c0, mid, block, tile, leaf);
+        transpose_recursive(src, dst, rows, cols, r0, r1, mid, c1, block, tile, leaf);
+    }
+}
+
+/*
+ * Out-of-place Transpose
+ */
+
+void simd_transpose_f32(const float* src, float* dst, size_t rows, size_t cols) {
+    transpose_recursive(src, dst, rows, cols, 0, rows, 0, cols, 4, TRANSPOSE_TILE_F32, transpose_leaf_f32);
+}
+
+void simd_transpose_u16(const uint16_t* src, uint16_t* dst, size_t rows, size_t cols) {
+    transpose_recursive(src, dst, rows, cols, 0, rows, 0, cols, 8, TRANSPOSE_TILE_U16, transpose_leaf_u16);
+}
+
+void simd_transpose_u8(const uint8_t* src, uint8_t* dst, size_t rows, size_t cols) {
+    transpose_recursive(src, dst, rows, cols, 0, rows, 0, cols, 16, TRANSPOSE_TILE_U8, transpose_leaf_u8);
+}
+
+/*
+ * In-place Transpose
+ */
+
+// Blocks (i,j) and (j,i) are both loaded before either is stored, so the
+// pair can be transposed and swapped through registers. Pairs are visited
+// tile by tile to keep both blocks' rows in cache.
+
+void simd_transpose_inplace_f32(float* data, size_t n) {
+    size_t n_full = n / 4 * 4;
+
+    for (size_t ti = 0; ti < n_full; ti += TRANSPOSE_TILE_F32) {
+        size_t ti_end = (ti + TRANSPOSE_TILE_F32 < n_full) ? ti + TRANSPOSE_TILE_F32 : n_full;
+        for (size_t tj = ti; tj < n_full; tj += TRANSPOSE_TILE_F32) {
+            size_t tj_end = (tj + TRANSPOSE_TILE_F32 < n_full) ? tj + TRANSPOSE_TILE_F32 : n_full;
+            for (size_t i = ti; i < ti_end; i += 4) {
+                for (size_t j = (tj == ti) ? i : tj; j < tj_end; j += 4) {
+                    float32x4_t a[4], b[4];
+                    for (int k = 0; k < 4; k++) {
+                        a[k] = vld1q_f32(data + (i + k) * n + j);
+                        b[k] = vld1q_f32(data + (j + k) * n + i);
+                    }
+                    transpose_4x4_f32(a);
+                    transpose_4x4_f32(b);
+                    for (int k = 0; k < 4; k++) {
+                        vst1q_f32(data + (j + k) * n + i, a[k]);
+                        if (i != j) vst1q_f32(data + (i + k) * n + j, b[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Handle remaining rows and columns
+    for (size_t i = n_full; i < n; i++) {
+        for (size_t j = 0; j < i; j++) {
+            float t = data[i * n + j];
+            data[i * n + j] = data[j * n + i];
+            data[j * n + i] = t;
+        }
+    }
+}
+
+void simd_transpose_inplace_u16(uint16_t* data, size_t n) {
+    size_t n_full = n / 8 * 8;
+
+    for (size_t ti = 0; ti < n_full; ti += TRANSPOSE_TILE_U16) {
+        size_t ti_end = (ti + TRANSPOSE_TILE_U16 < n_full) ? ti + TRANSPOSE_TILE_U16 : n_full;
+        for (size_t tj = ti; tj < n_full; tj += TRANSPOSE_TILE_U16) {
+            size_t tj_end = (tj + TRANSPOSE_TILE_U16 < n_full) ? tj + TRANSPOSE_TILE_U16 : n_full;
+            for (size_t i = ti; i < ti_end; i += 8) {
+                for (size_t j = (tj == ti) ? i : tj; j < tj_end; j += 8) {
+                    uint16x8_t a[8], b[8];
+                    for (int k = 0; k < 8; k++) {
+                        a[k] = vld1q_u16(data + (i + k) * n + j);
+                        b[k] = vld1q_u16(data + (j + k) * n + i);
+                    }
+                    transpose_8x8_u16(a);
+                    transpose_8x8_u16(b);
+                    for (int k = 0; k < 8; k++) {
+                        vst1q_u16(data + (j + k) * n + i, a[k]);
+                        if (i != j) vst1q_u16(data + (i + k) * n + j, b[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Handle remaining rows and columns
+    for (size_t i = n_full; i < n; i++) {
+        for (size_t j = 0; j < i; j++) {
+            uint16_t t = data[i * n + j];
+            data[i * n + j] = data[j * n + i];
+            data[j * n + i] = t;
+        }
+    }
+}
+
+void simd_transpose_inplace_u8(uint8_t* data, size_t n) {
+    size_t n_full = n / 16 * 16;
+
+    for (size_t ti = 0; ti < n_full; ti += TRANSPOSE_TILE_U8) {
+        size_t ti_end = (ti + TRANSPOSE_TILE_U8 < n_full) ? ti + TRANSPOSE_TILE_U8 : n_full;
+        for (size_t tj = ti; tj < n_full; tj += TRANSPOSE_TILE_U8) {
+            size_t tj_end = (tj + TRANSPOSE_TILE_U8 < n_full) ? tj + TRANSPOSE_TILE_U8 : n_full;
+            for (size_t i = ti; i < ti_end; i += 16) {
+                for (size_t j = (tj == ti) ? i : tj; j < tj_end; j += 16) {
+                    uint8x16_t a[16], b[16];
+                    for (int k = 0; k < 16; k++) {
+                        a[k] = vld1q_u8(data + (i + k) * n + j);
+                        b[k] = vld1q_u8(data + (j + k) * n + i);
+                    }
+                    transpose_16x16_u8(a);
+                    transpose_16x16_u8(b);
+                    for (int k = 0; k < 16; k++) {
+                        vst1q_u8(data + (j + k) * n + i, a[k]);
+                        if (i != j) vst1q_u8(data + (i + k) * n + j, b[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Handle remaining rows and columns
+    for (size_t i = n_full; i < n; i++) {
+        for (size_t j = 0; j < i; j++) {
+            uint8_t t = data[i * n + j];
+            data[i * n + j] = data[j * n + i];
+            data[j * n + i] = t;
+        }
+    }
+}
@@ -0,0 +1,235 @@
+/**
+ * test_async_ops.c
+ * Unit tests for asynchronous kernel calls: completion, ordering,
+ * batching, cancellation and the latency histogram
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "../include/simd_async.h"
+#include "../include/simd_sched.h"
+#include "../include/test_framework.h"
+
+#define CALLS 1000
+
+typedef struct {
+    atomic_int ran;             // Calls that ran
+    atomic_int finished;        // Completion callbacks
+    atomic_int cancelled;
+    atomic_int next;            // Execution order
+    int order[CALLS];
+    atomic_int gate;            // Holds the blocking call while nonzero
+} tracker_t;
+
+typedef struct {
+    tracker_t* t;
+    int index;
+} call_t;
+
+static void record_call(void* ctx) {
+    call_t* c = (call_t*)ctx;
+    c->t->order[atomic_fetch_add(&c->t->next, 1)] = c->index;
+    atomic_fetch_add(&c->t->ran, 1);
+}
+
+static void block_call(void* ctx) {
+    tracker_t* t = (tracker_t*)ctx;
+    while (atomic_load(&t->gate)) sched_yield();
+}
+
+static void on_done(void* ctx, simd_async_status_t status) {
+    call_t* c = (call_t*)ctx;
+    atomic_fetch_add(status == SIMD_ASYNC_DONE ? &c->t->finished : &c->t->cancelled, 1);
+}
+
+static void wait_for(atomic_int* counter, int value) {
+    while (atomic_load(counter) < value) sched_yield();
+}
+
+static void start_pool(int threads) {
+    simd_sched_config_t config = { threads, SIMD_AFFINITY_NONE, NULL, NULL };
+    simd_sched_init(&config);
+}
+
+// Test calls run inline, before submit returns, without pool workers
+void test_inline(test_suite_t* suite) {
+    start_pool(0);
+    simd_async_reset_stats();
+    tracker_t* t = (tracker_t*)calloc(1, sizeof(tracker_t));
+    call_t c = { t, 7 };
+    simd_async_op_t op;
+    simd_async_submit(&op, record_call, &c, 16, on_done, &c);
+
+    simd_async_stats_t stats;
+    simd_async_get_stats(&stats);
+    bool passed = atomic_load(&t->ran) == 1 && atomic_load(&t->finished) == 1 && t->order[0] == 7 &&
+                  stats.submitted == 1 && stats.completed == 1 && stats.dispatches == 0 && !simd_async_cancel(&op);
+    test_suite_add_result(suite, "Async - Inline", passed, passed ? "Done before submit returned" : "Not inline");
+    free(t);
+}
+
+// Test many small calls on a single worker: all complete, in order, batched
+void test_ordered(test_suite_t* suite) {
+    start_pool(1);
+    simd_async_reset_stats();
+    tracker_t* t = (tracker_t*)calloc(1, sizeof(tracker_t));
+    call_t* calls = (call_t*)malloc(CALLS * sizeof(call_t));
+    simd_async_op_t* ops = (simd_async_op_t*)malloc(CALLS * sizeof(simd_async_op_t));
+
+    // Hold the worker so the small calls queue up behind the blocker
+    atomic_store(&t->gate, 1);
+    simd_async_op_t blocker;
+    simd_async_submit(&blocker, block_call, t, SIMD_ASYNC_BATCH_BYTES, NULL, NULL);
+    for (int i = 0; i < CALLS; i++) {
+        calls[i].t = t;
+        calls[i].index = i;
+        simd_async_submit(&ops[i], record_call, &calls[i], 64, on_done, &calls[i]);
+    }
+    atomic_store(&t->gate, 0);
+    wait_for(&t->finished, CALLS);
+
+    bool passed = atomic_load(&t->ran) == CALLS;
+    for (int i = 0; passed && i < CALLS; i++) passed = t->order[i] == i;
+
+    simd_async_stats_t stats;
+    simd_async_get_stats(&stats);
+    uint64_t histogram = 0;
+    for (int i = 0; i < SIMD_ASYNC_LATENCY_BUCKETS; i++) histogram += stats.latency[i];
+    passed = passed && stats.submitted == CALLS + 1 && stats.completed == CALLS + 1 && histogram == CALLS + 1 &&
+             stats.batched == CALLS && stats.dispatches == 1 + (CALLS + SIMD_ASYNC_BATCH_MAX - 1) / SIMD_ASYNC_BATCH_MAX;
+    test_suite_add_result(suite, "Async - Ordered Batches", passed,
+                          passed ? "1000 calls in 32 dispatches, in order" : "Wrong order or batching");
+    free(t);
+    free(calls);
+    free(ops);
+}
+
+// Test large calls get dispatches of their own and byte budgets split batches
+void test_large(test_suite_t* suite) {
+    start_pool(1);
+    simd_async_reset_stats();
+    tracker_t* t = (tracker_t*)calloc(1, sizeof(tracker_t));
+    call_t calls[8];
+    simd_async_op_t ops[8];
+
+    atomic_store(&t->gate, 1);
+    simd_async_op_t blocker;
+    simd_async_submit(&blocker, block_call, t, 0, NULL, NULL);
+
+    // Two large calls, then six small calls of a third of the budget each
+    for (int i = 0; i < 8; i++) {
+        calls[i].t = t;
+        calls[i].index = i;
+        size_t bytes = i < 2 ? SIMD_ASYNC_BATCH_BYTES : SIMD_ASYNC_BATCH_BYTES / 3;
+        simd_async_submit(&ops[i], record_call, &calls[i], bytes, on_done, &calls[i]);
+    }
+    atomic_store(&t->gate, 0);
+    wait_for(&t->finished, 8);
+
+    simd_async_stats_t stats;
+    simd_async_get_stats(&stats);
+    bool passed = stats.dispatches == 5 && stats.batched == 6;
+    test_suite_add_result(suite, "Async - Large Calls", passed, passed ? "Blocker, 2 alone, 2 batches of 3" :
+                          "Wrong dispatches");
+    free(t);
+}
+
+// Test cancelling queued calls, and that started calls cannot be cancelled
+void test_cancel(test_suite_t* suite) {
+    start_pool(1);
+    simd_async_reset_stats();
+    tracker_t* t = (tracker_t*)calloc(1, sizeof(tracker_t));
+    call_t calls[10];
+    simd_async_op_t ops[10];
+
+    atomic_store(&t->gate, 1);
+    simd_async_op_t blocker;
+    simd_async_submit(&blocker, block_call, t, SIMD_ASYNC_BATCH_BYTES, NULL, NULL);
+    for (int i = 0; i < 10; i++) {
+        calls[i].t = t;
+        calls[i].index = i;
+        simd_async_submit(&ops[i], record_call, &calls[i], 64, on_done, &calls[i]);
+    }
+
+    // Cancel the even calls from the back, then the head again
+    bool passed = true;
+    for (int i = 8; i >= 0; i -= 2) passed &= simd_async_cancel(&ops[i]);
+    passed &= !simd_async_cancel(&ops[0]);
+    passed &= atomic_load(&t->cancelled) == 5 && atomic_load(&t->ran) == 0;
+    atomic_store(&t->gate, 0);
+    wait_for(&t->finished, 5);
+
+    for (int i = 0; i < 5; i++) passed &= t->order[i] == 2 * i + 1;
+    for (int i = 0; i < 10; i++) passed &= !simd_async_cancel(&ops[i]);
+
+    simd_async_stats_t stats;
+    simd_async_get_stats(&stats);
+    passed &= atomic_load(&t->ran) == 5 && stats.cancelled == 5 && stats.completed == 6;
+    test_suite_add_result(suite, "Async - Cancel", passed, passed ? "5 of 10 cancelled while queued" : "Cancel failed");
+    free(t);
+}
+
+// Test many calls, a third of them cancelled, on several workers
+void test_concurrent(test_suite_t* suite) {
+    start_pool(3);
+    simd_async_reset_stats();
+    tracker_t* t = (tracker_t*)calloc(1, sizeof(tracker_t));
+    call_t* calls = (call_t*)malloc(CALLS * sizeof(call_t));
+    simd_async_op_t* ops = (simd_async_op_t*)malloc(CALLS * sizeof(simd_async_op_t));
+    for (int i = 0; i < CALLS; i++) {
+        calls[i].t = t;
+        calls[i].index = i;
+        simd_async_submit(&ops[i], record_call, &calls[i], i % 10 == 0 ? SIMD_ASYNC_BATCH_BYTES : 256, on_done,
+                          &calls[i]);
+        if (i % 3 == 0) simd_async_cancel(&ops[i]);
+    }
+    wait_for(&t->finished, CALLS - atomic_load(&t->cancelled));
+
+    simd_async_stats_t stats;
+    simd_async_get_stats(&stats);
+    bool passed = atomic_load(&t->ran) + atomic_load(&t->cancelled) == CALLS &&
+                  stats.completed + stats.cancelled == CALLS && stats.dispatches <= stats.completed;
+    test_suite_add_result(suite, "Async - Concurrent", passed, passed ? "Every call ran or was cancelled once" :
+                          "Lost or repeated calls");
+    free(t);
+    free(calls);
+    free(ops);
+}
+
+// Test the histogram buckets
+void test_buckets(test_suite_t* suite) {
+    bool passed = simd_async_latency_bucket(0) == 0 && simd_async_latency_bucket(1999) == 0 &&
+                  simd_async_latency_bucket(2000) == 1 && simd_async_latency_bucket(1000000) == 9 &&
+                  simd_async_latency_bucket(UINT64_MAX) == SIMD_ASYNC_LATENCY_BUCKETS - 1;
+    test_suite_add_result(suite, "Async - Latency Buckets", passed, passed ? "Powers of two in us" : "Wrong bucket");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for asynchronous calls...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Asynchronous Calls");
+
+    // Run tests
+    test_inline(suite);
+    test_ordered(suite);
+    test_large(suite);
+    test_cancel(suite);
+    test_concurrent(suite);
+    test_buckets(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+    simd_sched_shutdown();
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * test_batch_ops.c
+ * Unit tests for batched small-vector kernels: many-to-many dot products,
+ * pointer-array batches and the call coalescer
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/simd_batch.h"
+#include "../include/simd_ops.h"
+#include "../include/test_framework.h"
+
+static void fill(float* v, size_t n, unsigned seed) {
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        v[i] = (float)((seed >> 16) & 0x7fff) / 16384.0f - 1.0f;
+    }
+}
+
+// Test every shape against single simd_dot_product_f32 calls, bit for bit
+void test_dot_many(test_suite_t* suite) {
+    static const size_t dims[] = { 0, 1, 3, 4, 7, 32, 37, 128, 256, 5000 };
+    bool passed = true;
+    for (size_t k = 0; k < sizeof(dims) / sizeof(dims[0]) && passed; k++) {
+        size_t dim = dims[k], nq = 13, nd = 11;
+        float* q = (float*)malloc((nq * dim + 1) * sizeof(float));
+        float* db = (float*)malloc((nd * dim + 1) * sizeof(float));
+        float* out = (float*)malloc(nq * nd * sizeof(float));
+        fill(q, nq * dim, 1 + (unsigned)k);
+        fill(db, nd * dim, 100 + (unsigned)k);
+
+        simd_dot_many_f32(q, db, out, nq, nd, dim);
+        for (size_t i = 0; i < nq && passed; i++) {
+            for (size_t j = 0; j < nd && passed; j++) {
+                passed = out[i * nd + j] == simd_dot_product_f32(q + i * dim, db + j * dim, dim);
+            }
+        }
+        free(q);
+        free(db);
+        free(out);
+    }
+    test_suite_add_result(suite, "Batch - Dot Many", passed, passed ? "13x11 blocks match single calls" :
+                          "Mismatch against simd_dot_product_f32");
+}
+
+// Test pointer-array dot products on scattered, repeated vectors
+void test_dot_batch(test_suite_t* suite) {
+    size_t len = 45, count = 23;
+    float* pool = (float*)malloc(8 * len * sizeof(float));
+    fill(pool, 8 * len, 7);
+    const float* a[23];
+    const float* b[23];
+    float out[23];
+    for (size_t i = 0; i < count; i++) {
+        a[i] = pool + (i % 8) * len;
+        b[i] = pool + ((i * 3 + 1) % 8) * len;
+    }
+
+    simd_dot_batch_f32(a, b, out, count, len);
+    bool passed = true;
+    for (size_t i = 0; i < count; i++) passed &= out[i] == simd_dot_product_f32(a[i], b[i], len);
+    test_suite_add_result(suite, "Batch - Dot Pointer Arrays", passed, passed ? "23 pairs match single calls" :
+                          "Mismatch against simd_dot_product_f32");
+    free(pool);
+}
+
+// Test add and mul batches, including outputs aliasing their inputs
+void test_binary_batch(test_suite_t* suite) {
+    size_t len = 37, count = 6;
+    float* a = (float*)malloc(count * len * sizeof(float));
+    float* b = (float*)malloc(count * len * sizeof(float));
+    float* sum = (float*)malloc(count * len * sizeof(float));
+    float* prod = (float*)malloc(count * len * sizeof(float));
+    float* expect = (float*)malloc(len * sizeof(float));
+    fill(a, count * len, 3);
+    fill(b, count * len, 4);
+
+    const float* pa[6];
+    const float* pb[6];
+    float* ps[6];
+    float* pp[6];
+    for (size_t i = 0; i < count; i++) {
+        pa[i] = a + i * len;
+        pb[i] = b + i * len;
+        ps[i] = sum + i * len;
+        pp[i] = prod + i * len;
+    }
+    simd_add_batch_f32(pa, pb, ps, count, len);
+    simd_mul_batch_f32(pa, pb, pp, count, len);
+
+    bool passed = true;
+    for (size_t i = 0; i < count; i++) {
+        simd_add_f32(pa[i], pb[i], expect, len);
+        passed &= memcmp(expect, ps[i], len * sizeof(float)) == 0;
+        simd_mul_f32(pa[i], pb[i], expect, len);
+        passed &= memcmp(expect, pp[i], len * sizeof(float)) == 0;
+    }
+
+    // In place: a += b
+    simd_add_batch_f32(pa, pb, (float* const*)pa, count, len);
+    passed &= memcmp(a, sum, count * len * sizeof(float)) == 0;
+
+    test_suite_add_result(suite, "Batch - Add/Mul Pointer Arrays", passed, passed ? "Match single calls, in place too" :
+                          "Wrong results");
+    free(a);
+    free(b);
+    free(sum);
+    free(prod);
+    free(expect);
+}
+
+// Test full buffers flush on their own and the rest waits for flush
+void test_coalescer_dots(test_suite_t* suite) {
+    size_t len = 64, calls = 100;
+    float* vecs = (float*)malloc(10 * len * sizeof(float));
+    float out[100];
+    fill(vecs, 10 * len, 11);
+    for (size_t i = 0; i < calls; i++) out[i] = -1.0f;
+
+    simd_coalescer_t* co = simd_coalescer_create(len, 32);
+    bool passed = co != NULL;
+    for (size_t i = 0; passed && i < calls; i++) {
+        simd_coalescer_dot_f32(co, vecs + (i % 10) * len, vecs + (i / 10) * len, &out[i]);
+    }
+    passed = passed && simd_coalescer_pending(co) == 4 && out[95] != -1.0f && out[96] == -1.0f;
+    passed = passed && simd_coalescer_flush(co) == 4 && simd_coalescer_pending(co) == 0 &&
+             simd_coalescer_flush(co) == 0;
+    for (size_t i = 0; passed && i < calls; i++) {
+        passed = out[i] == simd_dot_product_f32(vecs + (i % 10) * len, vecs + (i / 10) * len, len);
+    }
+
+    simd_coalescer_stats_t stats = { 0, 0, 0 };
+    simd_coalescer_get_stats(co, &stats);
+    passed = passed && stats.calls == 100 && stats.flushes == 4 && stats.full == 3;
+    test_suite_add_result(suite, "Batch - Coalescer Dots", passed, passed ? "3 full flushes, 4 left for flush" :
+                          "Wrong results or flushes");
+    simd_coalescer_destroy(co);
+    free(vecs);
+}
+
+// Test mixed kinds share flushes and destroy runs what is pending
+void test_coalescer_mixed(test_suite_t* suite) {
+    size_t len = 19;
+    float a[19], b[19], sum[19], prod[19], expect[19], dot = 0.0f;
+    fill(a, len, 21);
+    fill(b, len, 22);
+
+    simd_coalescer_t* co = simd_coalescer_create(len, 8);
+    bool passed = co != NULL && simd_coalescer_create(len, 0) == NULL;
+    if (passed) {
+        simd_coalescer_add_f32(co, a, b, sum);
+        simd_coalescer_mul_f32(co, a, b, prod);
+        simd_coalescer_dot_f32(co, a, b, &dot);
+        passed = simd_coalescer_pending(co) == 3;
+        simd_coalescer_destroy(co);
+    }
+
+    simd_add_f32(a, b, expect, len);
+    passed = passed && memcmp(expect, sum, sizeof(expect)) == 0;
+    simd_mul_f32(a, b, expect, len);
+    passed = passed && memcmp(expect, prod, sizeof(expect)) == 0 && dot == simd_dot_product_f32(a, b, len);
+    test_suite_add_result(suite, "Batch - Coalescer Mixed", passed, passed ? "Add, mul and dot run on destroy" :
+                          "Pending calls lost");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for batched kernels...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Batched Kernels");
+
+    // Run tests
+    test_dot_many(suite);
+    test_dot_batch(suite);
+    test_binary_batch(suite);
+    test_coalescer_dots(suite);
+    test_coalescer_mixed(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
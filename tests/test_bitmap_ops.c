@@ -0,0 +1,196 @@
+/**
+ * test_bitmap_ops.c
+ * Unit tests for packed bitmaps and predicate algebra
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_bitmap.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Check every bit of a bitmap against an expected boolean array
+static bool bitmap_matches(const simd_bitmap_t* bm, const bool* expected) {
+    for (size_t i = 0; i < bm->len; i++) {
+        if (simd_bitmap_get(bm, i) != (int)expected[i]) return false;
+    }
+    // Bits past len must stay clear
+    if (bm->len % 64 && (bm->words[bm->word_count - 1] >> (bm->len % 64))) return false;
+    return true;
+}
+
+// Record whether a bitmap matches the expected predicate results
+static void check_bitmap(test_suite_t* suite, const char* name, const simd_bitmap_t* bm, const bool* expected) {
+    bool passed = bitmap_matches(bm, expected);
+    test_suite_add_result(suite, name, passed, passed ? "Bits match predicate" : "Bit mismatch");
+}
+
+// Test bitmap construction from comparisons
+void test_bitmap_compare(test_suite_t* suite) {
+    const size_t test_size = 1001;
+
+    float* f = (float*)neon_malloc(test_size * sizeof(float));
+    int32_t* s = (int32_t*)neon_malloc(test_size * sizeof(int32_t));
+    uint8_t* u = (uint8_t*)neon_malloc(test_size);
+    bool* expected = (bool*)malloc(test_size * sizeof(bool));
+    simd_bitmap_t* bm = simd_bitmap_create(test_size);
+
+    if (!f || !s || !u || !expected || !bm) {
+        test_suite_add_result(suite, "Bitmap Compare - Allocation", false, "Memory allocation failed");
+        return;
+    }
+
+    for (size_t i = 0; i < test_size; i++) {
+        f[i] = (float)((int)((i * 31) % 200) - 100);
+        s[i] = (int32_t)((i * 17) % 50) - 25;
+        u[i] = (uint8_t)((i * 7) % 256);
+    }
+
+    simd_bitmap_cmp_f32(bm, f, SIMD_CMP_GT, 10.0f);
+    for (size_t i = 0; i < test_size; i++) expected[i] = f[i] > 10.0f;
+    check_bitmap(suite, "Bitmap Compare - F32 GT", bm, expected);
+
+    simd_bitmap_cmp_f32(bm, f, SIMD_CMP_LE, -3.0f);
+    for (size_t i = 0; i < test_size; i++) expected[i] = f[i] <= -3.0f;
+    check_bitmap(suite, "Bitmap Compare - F32 LE", bm, expected);
+
+    simd_bitmap_cmp_s32(bm, s, SIMD_CMP_NE, 0);
+    for (size_t i = 0; i < test_size; i++) expected[i] = s[i] != 0;
+    check_bitmap(suite, "Bitmap Compare - S32 NE", bm, expected);
+
+    simd_bitmap_cmp_u8(bm, u, SIMD_CMP_GE, 200);
+    for (size_t i = 0; i < test_size; i++) expected[i] = u[i] >= 200;
+    check_bitmap(suite, "Bitmap Compare - U8 GE", bm, expected);
+
+    free(f);
+    free(s);
+    free(u);
+    free(expected);
+    simd_bitmap_destroy(bm);
+}
+
+// Test bitwise algebra, counting and iteration
+void test_bitmap_algebra(test_suite_t* suite) {
+    const size_t test_size = 777;
+
+    int32_t* col = (int32_t*)neon_malloc(test_size * sizeof(int32_t));
+    uint32_t* indices = (uint32_t*)neon_malloc(test_size * sizeof(uint32_t));
+    bool* expected = (bool*)malloc(test_size * sizeof(bool));
+    simd_bitmap_t* a = simd_bitmap_create(test_size);
+    simd_bitmap_t* b = simd_bitmap_create(test_size);
+    simd_bitmap_t* c = simd_bitmap_create(test_size);
+
+    if (!col || !indices || !expected || !a || !b || !c) {
+        test_suite_add_result(suite, "Bitmap Algebra - Allocation", false, "Memory allocation failed");
+        return;
+    }
+
+    for (size_t i = 0; i < test_size; i++) {
+        col[i] = (int32_t)((i * 13) % 100);
+    }
+
+    simd_bitmap_cmp_s32(a, col, SIMD_CMP_GE, 20);
+    simd_bitmap_cmp_s32(b, col, SIMD_CMP_LT, 70);
+
+    simd_bitmap_and(c, a, b);
+    size_t expected_count = 0;
+    for (size_t i = 0; i < test_size; i++) {
+        expected[i] = col[i] >= 20 && col[i] < 70;
+        if (expected[i]) expected_count++;
+    }
+    check_bitmap(suite, "Bitmap Algebra - AND", c, expected);
+    ASSERT_INT_EQ(suite, "Bitmap Algebra - Count", (int)simd_bitmap_count(c), (int)expected_count);
+
+    simd_bitmap_or(c, a, b);
+    for (size_t i = 0; i < test_size; i++) expected[i] = col[i] >= 20 || col[i] < 70;
+    check_bitmap(suite, "Bitmap Algebra - OR", c, expected);
+
+    simd_bitmap_xor(c, a, b);
+    for (size_t i = 0; i < test_size; i++) expected[i] = (col[i] >= 20) != (col[i] < 70);
+    check_bitmap(suite, "Bitmap Algebra - XOR", c, expected);
+
+    simd_bitmap_andnot(c, a, b);
+    for (size_t i = 0; i < test_size; i++) expected[i] = col[i] >= 70;
+    check_bitmap(suite, "Bitmap Algebra - ANDNOT", c, expected);
+
+    simd_bitmap_not(c, c);
+    for (size_t i = 0; i < test_size; i++) expected[i] = col[i] < 70;
+    check_bitmap(suite, "Bitmap Algebra - NOT (in place)", c, expected);
+
+    // Indices and iterator must agree and be ascending
+    size_t n = simd_bitmap_to_indices(c, indices);
+    simd_bitmap_iter_t it;
+    simd_bitmap_iter_init(&it, c);
+    size_t index = 0;
+    size_t visited = 0;
+    bool passed = true;
+    while (simd_bitmap_iter_next(&it, &index)) {
+        if (visited >= n || indices[visited] != index || !expected[index]) passed = false;
+        visited++;
+    }
+    passed = passed && visited == n && n == simd_bitmap_count(c);
+    test_suite_add_result(suite, "Bitmap Iteration - Set Bits", passed,
+                          passed ? "Iterator and index list agree" : "Iteration mismatch");
+
+    free(col);
+    free(indices);
+    free(expected);
+    simd_bitmap_destroy(a);
+    simd_bitmap_destroy(b);
+    simd_bitmap_destroy(c);
+}
+
+// Test masked blend
+void test_bitmap_select(test_suite_t* suite) {
+    const size_t test_size = 203;
+
+    float* a = (float*)neon_malloc(test_size * sizeof(float));
+    float* b = (float*)neon_malloc(test_size * sizeof(float));
+    float* c = (float*)neon_malloc(test_size * sizeof(float));
+    float* expected = (float*)neon_malloc(test_size * sizeof(float));
+    simd_bitmap_t* bm = simd_bitmap_create(test_size);
+
+    if (!a || !b || !c || !expected || !bm) {
+        test_suite_add_result(suite, "Bitmap Select - Allocation", false, "Memory allocation failed");
+        return;
+    }
+
+    for (size_t i = 0; i < test_size; i++) {
+        a[i] = (float)i;
+        b[i] = -(float)i;
+        if (i % 3 == 0) simd_bitmap_set(bm, i);
+        expected[i] = (i % 3 == 0) ? a[i] : b[i];
+    }
+
+    simd_bitmap_select_f32(bm, a, b, c);
+    ASSERT_FLOAT_ARRAY_EQ(suite, "Bitmap Select - F32", c, expected, (int)test_size, 0.0f);
+
+    free(a);
+    free(b);
+    free(c);
+    free(expected);
+    simd_bitmap_destroy(bm);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for bitmap operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Bitmap Operations");
+
+    // Run tests
+    test_bitmap_compare(suite);
+    test_bitmap_algebra(suite);
+    test_bitmap_select(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
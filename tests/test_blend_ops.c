@@ -0,0 +1,185 @@
+/**
+ * test_blend_ops.c
+ * Unit tests for alpha blending and compositing
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_blend.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// round(x / 255), computed independently of the kernels' shift trick
+static uint32_t ref_div255(uint32_t x) {
+    return (2 * x + 255) / 510;
+}
+
+static void fill_bytes(uint8_t* buf, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        buf[i] = (uint8_t)(seed >> 24);
+    }
+}
+
+// Straight pixels with a mix of transparent, opaque and partial alpha
+static void fill_pixels(uint8_t* px, size_t count, uint32_t seed) {
+    fill_bytes(px, count * 4, seed);
+    for (size_t i = 0; i < count; i++) {
+        if (i % 5 == 0) px[i * 4 + 3] = 0;
+        if (i % 5 == 1) px[i * 4 + 3] = 255;
+    }
+}
+
+static void ref_premultiply(const uint8_t* src, uint8_t* dst, size_t count) {
+    for (size_t i = 0; i < count * 4; i += 4) {
+        for (int c = 0; c < 3; c++) dst[i + c] = (uint8_t)ref_div255(src[i + c] * src[i + 3]);
+        dst[i + 3] = src[i + 3];
+    }
+}
+
+// Test the divide-by-255 rounding on every (value, alpha) pair
+void test_premultiply(test_suite_t* suite) {
+    const size_t count = 65536;
+    uint8_t* src = (uint8_t*)neon_malloc(count * 4);
+    uint8_t* out = (uint8_t*)neon_malloc(count * 4);
+    uint8_t* ref = (uint8_t*)neon_malloc(count * 4);
+
+    for (size_t i = 0; i < count; i++) {
+        src[i * 4 + 0] = (uint8_t)(i & 255);
+        src[i * 4 + 1] = (uint8_t)(255 - (i & 255));
+        src[i * 4 + 2] = (uint8_t)(i * 7);
+        src[i * 4 + 3] = (uint8_t)(i >> 8);
+    }
+
+    simd_premultiply_rgba(src, out, count);
+    ref_premultiply(src, ref, count);
+    bool passed = memcmp(out, ref, count * 4) == 0;
+
+    // Odd count exercises the scalar tail; in place
+    simd_premultiply_rgba(src, src, 37);
+    if (memcmp(src, ref, 37 * 4) != 0) passed = false;
+
+    test_suite_add_result(suite, "Premultiply - Exact /255", passed, passed ? "All 65536 pairs round correctly" : "Mismatch");
+
+    free(src);
+    free(out);
+    free(ref);
+}
+
+// Test straight and premultiplied over and cross-fade against scalar formulas
+void test_blend_over(test_suite_t* suite) {
+    static const size_t counts[] = { 1, 15, 16, 33, 1000 };
+    bool straight_ok = true, premul_ok = true, fade_ok = true;
+
+    for (int n = 0; n < 5; n++) {
+        size_t count = counts[n];
+        uint8_t* fg = (uint8_t*)neon_malloc(count * 4);
+        uint8_t* bg = (uint8_t*)neon_malloc(count * 4);
+        uint8_t* out = (uint8_t*)neon_malloc(count * 4);
+        fill_pixels(fg, count, 1 + n);
+        fill_pixels(bg, count, 100 + n);
+
+        simd_blend_over_rgba(fg, bg, out, count);
+        for (size_t i = 0; i < count * 4; i += 4) {
+            uint32_t a = fg[i + 3];
+            for (int c = 0; c < 3; c++) {
+                if (out[i + c] != ref_div255(fg[i + c] * a + bg[i + c] * (255 - a))) straight_ok = false;
+            }
+            if (out[i + 3] != a + ref_div255(bg[i + 3] * (255 - a))) straight_ok = false;
+        }
+
+        // Premultiplied inputs
+        ref_premultiply(fg, fg, count);
+        ref_premultiply(bg, bg, count);
+        simd_blend_over_premul_rgba(fg, bg, out, count);
+        for (size_t i = 0; i < count * 4; i += 4) {
+            for (int c = 0; c < 4; c++) {
+                if (out[i + c] != fg[i + c] + ref_div255(bg[i + c] * (255 - fg[i + 3]))) premul_ok = false;
+            }
+        }
+
+        static const uint8_t alphas[] = { 0, 1, 128, 254, 255 };
+        for (int a = 0; a < 5; a++) {
+            simd_crossfade_rgba(fg, bg, alphas[a], out, count);
+            for (size_t i = 0; i < count * 4; i++) {
+                if (out[i] != ref_div255(fg[i] * (255u - alphas[a]) + bg[i] * (uint32_t)alphas[a])) fade_ok = false;
+            }
+        }
+
+        // Output aliasing the background
+        memcpy(out, bg, count * 4);
+        simd_blend_over_premul_rgba(fg, out, out, count);
+        for (size_t i = 0; i < count * 4; i++) {
+            if (out[i] != fg[i] + ref_div255(bg[i] * (255 - fg[i / 4 * 4 + 3]))) premul_ok = false;
+        }
+
+        free(fg);
+        free(bg);
+        free(out);
+    }
+
+    test_suite_add_result(suite, "Blend - Straight Over", straight_ok, straight_ok ? "Matches scalar" : "Mismatch");
+    test_suite_add_result(suite, "Blend - Premultiplied Over", premul_ok, premul_ok ? "Matches scalar" : "Mismatch");
+    test_suite_add_result(suite, "Blend - Cross-Fade", fade_ok, fade_ok ? "Matches scalar" : "Mismatch");
+}
+
+// Test every Porter-Duff operator on premultiplied pixels
+void test_composite(test_suite_t* suite) {
+    static const char* names[] = { "Clear", "Src", "Dst", "Src Over", "Dst Over", "Src In", "Dst In",
+                                   "Src Out", "Dst Out", "Src Atop", "Dst Atop", "Xor", "Plus" };
+    const size_t count = 203;
+    uint8_t* fg = (uint8_t*)neon_malloc(count * 4);
+    uint8_t* bg = (uint8_t*)neon_malloc(count * 4);
+    uint8_t* out = (uint8_t*)neon_malloc(count * 4);
+    fill_pixels(fg, count, 5);
+    fill_pixels(bg, count, 6);
+    ref_premultiply(fg, fg, count);
+    ref_premultiply(bg, bg, count);
+
+    bool passed = true;
+    for (int op = SIMD_COMPOSITE_CLEAR; op <= SIMD_COMPOSITE_PLUS; op++) {
+        simd_composite_rgba(fg, bg, (simd_composite_op_t)op, out, count);
+        bool op_ok = true;
+        for (size_t i = 0; i < count * 4; i += 4) {
+            uint32_t as = fg[i + 3], ad = bg[i + 3];
+            uint32_t fs[] = { 0, 255, 0, 255, 255 - ad, ad, 0, 255 - ad, 0, ad, 255 - ad, 255 - ad, 255 };
+            uint32_t fd[] = { 0, 0, 255, 255 - as, 255, 0, as, 0, 255 - as, 255 - as, as, 255 - as, 255 };
+            for (int c = 0; c < 4; c++) {
+                uint32_t v = ref_div255(fg[i + c] * fs[op] + bg[i + c] * fd[op]);
+                if (out[i + c] != (v > 255 ? 255 : v)) op_ok = false;
+            }
+        }
+        if (!op_ok) {
+            passed = false;
+            printf("  %s mismatch\n", names[op]);
+        }
+    }
+    test_suite_add_result(suite, "Composite - Porter-Duff Ops", passed, passed ? "All 13 operators match" : "Mismatch");
+
+    free(fg);
+    free(bg);
+    free(out);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for alpha blending...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Alpha Blending");
+
+    // Run tests
+    test_premultiply(suite);
+    test_blend_over(suite);
+    test_composite(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
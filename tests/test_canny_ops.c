@@ -0,0 +1,199 @@
+/**
+ * test_canny_ops.c
+ * Unit tests for Canny edge detection
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_canny.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Reference Canny on top of the (separately tested) gradient module:
+// scalar suppression, thresholds and recursive-free flood fill
+static void ref_canny(const uint8_t* src, uint8_t* out, int width, int height,
+                      uint16_t low, uint16_t high, simd_magnitude_t norm) {
+    size_t n = (size_t)width * height;
+    uint16_t* mag = (uint16_t*)malloc(n * sizeof(uint16_t));
+    uint8_t* dir = (uint8_t*)malloc(n);
+    uint8_t* state = (uint8_t*)calloc(n, 1);   // 1 = candidate, 2 = edge
+    int* stack = (int*)malloc(n * sizeof(int));
+    int top = 0;
+
+    simd_gradient(src, width, height, SIMD_GRADIENT_SOBEL, SIMD_BORDER_REPLICATE, 0,
+                  NULL, NULL, mag, norm, dir, 4);
+
+    static const int offsets[4][4] = {
+        { -1, 0, 1, 0 }, { -1, -1, 1, 1 }, { 0, -1, 0, 1 }, { 1, -1, -1, 1 }
+    };
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int* o = offsets[dir[y * width + x]];
+            int bx = x + o[0], by = y + o[1], ax = x + o[2], ay = y + o[3];
+            int before = (bx < 0 || bx >= width || by < 0 || by >= height) ? 0 : mag[by * width + bx];
+            int after = (ax < 0 || ax >= width || ay < 0 || ay >= height) ? 0 : mag[ay * width + ax];
+            int m = mag[y * width + x];
+            if (m > before && m >= after && m > low) {
+                state[y * width + x] = m > high ? 2 : 1;
+                if (m > high) stack[top++] = y * width + x;
+            }
+        }
+    }
+
+    while (top > 0) {
+        int p = stack[--top];
+        int x = p % width, y = p / width;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = x + dx, ny = y + dy;
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                if (state[ny * width + nx] == 1) {
+                    state[ny * width + nx] = 2;
+                    stack[top++] = ny * width + nx;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) out[i] = state[i] == 2 ? 255 : 0;
+    free(mag);
+    free(dir);
+    free(state);
+    free(stack);
+}
+
+// Concentric rings plus noise: edges in every direction
+static void fill_rings(uint8_t* img, int width, int height) {
+    unsigned seed = 12345;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int dx = x - width / 3, dy = y - height / 2;
+            int r = (int)sqrt((double)(dx * dx + dy * dy));
+            seed = seed * 1103515245u + 12345u;
+            int v = ((r / 7) & 1 ? 200 : 40) + (int)((seed >> 16) % 40);
+            img[y * width + x] = (uint8_t)v;
+        }
+    }
+}
+
+// Test against the reference for several sizes and thread counts
+void test_canny_reference(test_suite_t* suite) {
+    static const int sizes[][2] = { { 131, 77 }, { 64, 64 }, { 200, 9 }, { 7, 5 } };
+    static const int threads[] = { 1, 2, 3, 8 };
+
+    for (int norm = 0; norm < 2; norm++) {
+        bool passed = true;
+        for (int s = 0; s < 4; s++) {
+            int width = sizes[s][0], height = sizes[s][1];
+            size_t n = (size_t)width * height;
+            uint8_t* src = (uint8_t*)neon_malloc(n);
+            uint8_t* out = (uint8_t*)neon_malloc(n);
+            uint8_t* ref = (uint8_t*)neon_malloc(n);
+            fill_rings(src, width, height);
+
+            uint16_t low = norm == SIMD_MAGNITUDE_L1 ? 120 : 90;
+            uint16_t high = norm == SIMD_MAGNITUDE_L1 ? 400 : 300;
+            ref_canny(src, ref, width, height, low, high, (simd_magnitude_t)norm);
+            for (int t = 0; t < 4; t++) {
+                memset(out, 0x55, n);
+                simd_canny(src, out, width, height, low, high, (simd_magnitude_t)norm, threads[t]);
+                if (memcmp(out, ref, n) != 0) {
+                    passed = false;
+                    printf("  Mismatch at %dx%d with %d threads\n", width, height, threads[t]);
+                }
+            }
+
+            free(src);
+            free(out);
+            free(ref);
+        }
+        test_suite_add_result(suite, norm == SIMD_MAGNITUDE_L1 ? "Canny - L1" : "Canny - L2", passed,
+                              passed ? "Matches reference for all thread counts" : "Mismatch");
+    }
+}
+
+// A weak chain spanning every band is only reachable from one strong end
+void test_canny_band_seams(test_suite_t* suite) {
+    const int width = 40;
+    const int height = 96;
+    size_t n = (size_t)width * height;
+    uint8_t* src = (uint8_t*)neon_malloc(n);
+    uint8_t* out = (uint8_t*)neon_malloc(n);
+    uint8_t* ref = (uint8_t*)neon_malloc(n);
+
+    // Weak vertical step edge over the full height, strong only at the bottom
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int step = y >= height - 4 ? 200 : 40;
+            src[y * width + x] = (uint8_t)(x < 20 ? 10 : 10 + step);
+        }
+    }
+
+    ref_canny(src, ref, width, height, 100, 500, SIMD_MAGNITUDE_L1);
+    simd_canny(src, out, width, height, 100, 500, SIMD_MAGNITUDE_L1, 6);
+    bool passed = memcmp(out, ref, n) == 0 && out[19] == 255;
+    test_suite_add_result(suite, "Canny - Band Seams", passed,
+                          passed ? "Chains propagate across bands" : "Chain broken at band boundary");
+
+    free(src);
+    free(out);
+    free(ref);
+}
+
+// Packed output agrees with the byte map; flat images have no edges
+void test_canny_bitmap(test_suite_t* suite) {
+    const int width = 99;
+    const int height = 41;
+    size_t n = (size_t)width * height;
+    uint8_t* src = (uint8_t*)neon_malloc(n);
+    uint8_t* out = (uint8_t*)neon_malloc(n);
+    simd_bitmap_t* bm = simd_bitmap_create(n);
+    fill_rings(src, width, height);
+
+    simd_canny(src, out, width, height, 120, 400, SIMD_MAGNITUDE_L1, 3);
+    simd_canny_bitmap(src, bm, width, height, 120, 400, SIMD_MAGNITUDE_L1, 2);
+    bool passed = true;
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (simd_bitmap_get(bm, i) != (out[i] == 255)) passed = false;
+        count += out[i] == 255;
+    }
+    passed = passed && count > 0 && simd_bitmap_count(bm) == count;
+    test_suite_add_result(suite, "Canny - Packed Output", passed,
+                          passed ? "Bitmap matches byte map" : "Mismatch");
+
+    memset(src, 77, n);
+    simd_canny(src, out, width, height, 1, 2, SIMD_MAGNITUDE_L2, 0);
+    passed = true;
+    for (size_t i = 0; i < n; i++) if (out[i]) passed = false;
+    test_suite_add_result(suite, "Canny - Flat Image", passed,
+                          passed ? "No edges detected" : "Spurious edges");
+
+    simd_bitmap_destroy(bm);
+    free(src);
+    free(out);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for Canny edge detection...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Canny Operations");
+
+    // Run tests
+    test_canny_reference(suite);
+    test_canny_band_seams(suite);
+    test_canny_bitmap(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
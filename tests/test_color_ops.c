@@ -0,0 +1,352 @@
+/**
+ * test_color_ops.c
+ * Unit tests for color-space conversion
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_color.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Odd dimensions exercise the vector body, the scalar tail and partial chroma blocks
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_PIXELS (TEST_WIDTH * TEST_HEIGHT)
+
+static const simd_pixel_format_t formats[] = {
+    SIMD_PIXEL_RGB, SIMD_PIXEL_BGR, SIMD_PIXEL_RGBA, SIMD_PIXEL_BGRA
+};
+
+// Deterministic test image covering primaries, grays and random colors
+static void fill_test_rgb(uint8_t* rgb, size_t pixel_count) {
+    static const uint8_t fixed[][3] = {
+        { 0, 0, 0 }, { 255, 255, 255 }, { 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 },
+        { 255, 255, 0 }, { 0, 255, 255 }, { 255, 0, 255 }, { 128, 128, 128 }, { 1, 2, 3 }
+    };
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < pixel_count; i++) {
+        for (int c = 0; c < 3; c++) {
+            if (i < 10) {
+                rgb[i * 3 + c] = fixed[i][c];
+            } else {
+                seed = seed * 1103515245u + 12345u;
+                rgb[i * 3 + c] = (uint8_t)(seed >> 16);
+            }
+        }
+    }
+}
+
+static uint8_t clamp_round(double x) {
+    if (x < 0.0) return 0;
+    if (x > 255.0) return 255;
+    return (uint8_t)lrint(x);
+}
+
+static void matrix_weights(simd_yuv_matrix_t matrix, double* kr, double* kb) {
+    *kr = matrix == SIMD_YUV_BT709 ? 0.2126 : 0.299;
+    *kb = matrix == SIMD_YUV_BT709 ? 0.0722 : 0.114;
+}
+
+// Reference RGB -> YUV in double precision
+static void ref_rgb_to_yuv(double r, double g, double b, simd_yuv_matrix_t matrix, simd_yuv_range_t range,
+                           uint8_t* y, uint8_t* u, uint8_t* v) {
+    double kr, kb;
+    matrix_weights(matrix, &kr, &kb);
+    double yf = kr * r + (1.0 - kr - kb) * g + kb * b;
+    double cb = (b - yf) / (2.0 * (1.0 - kb));
+    double cr = (r - yf) / (2.0 * (1.0 - kr));
+    if (range == SIMD_YUV_FULL) {
+        *y = clamp_round(yf);
+        *u = clamp_round(cb + 128.0);
+        *v = clamp_round(cr + 128.0);
+    } else {
+        *y = clamp_round(16.0 + yf * 219.0 / 255.0);
+        *u = clamp_round(128.0 + cb * 224.0 / 255.0);
+        *v = clamp_round(128.0 + cr * 224.0 / 255.0);
+    }
+}
+
+// Reference YUV -> RGB in double precision
+static void ref_yuv_to_rgb(int y, int u, int v, simd_yuv_matrix_t matrix, simd_yuv_range_t range, uint8_t* rgb) {
+    double kr, kb;
+    matrix_weights(matrix, &kr, &kb);
+    double kg = 1.0 - kr - kb;
+    double yf = range == SIMD_YUV_FULL ? y : (y - 16) * 255.0 / 219.0;
+    double cb = range == SIMD_YUV_FULL ? u - 128 : (u - 128) * 255.0 / 224.0;
+    double cr = range == SIMD_YUV_FULL ? v - 128 : (v - 128) * 255.0 / 224.0;
+    rgb[0] = clamp_round(yf + 2.0 * (1.0 - kr) * cr);
+    rgb[1] = clamp_round(yf - 2.0 * kb * (1.0 - kb) / kg * cb - 2.0 * kr * (1.0 - kr) / kg * cr);
+    rgb[2] = clamp_round(yf + 2.0 * (1.0 - kb) * cb);
+}
+
+static int abs_diff(int a, int b) {
+    return a > b ? a - b : b - a;
+}
+
+// Test packed format conversions
+void test_convert_pixels(test_suite_t* suite) {
+    uint8_t rgb[TEST_PIXELS * 3], back[TEST_PIXELS * 3], tmp[TEST_PIXELS * 4];
+    fill_test_rgb(rgb, TEST_PIXELS);
+
+    bool passed = true;
+    for (int f = 0; f < 4; f++) {
+        memset(tmp, 0, sizeof(tmp));
+        simd_convert_pixels(rgb, SIMD_PIXEL_RGB, tmp, formats[f], TEST_PIXELS);
+        simd_convert_pixels(tmp, formats[f], back, SIMD_PIXEL_RGB, TEST_PIXELS);
+        if (memcmp(rgb, back, sizeof(rgb)) != 0) passed = false;
+    }
+    test_suite_add_result(suite, "Convert Pixels - Round Trip", passed,
+                          passed ? "All formats round-trip" : "Channel mismatch");
+
+    // BGRA layout check, alpha filled with 255
+    simd_convert_pixels(rgb, SIMD_PIXEL_RGB, tmp, SIMD_PIXEL_BGRA, TEST_PIXELS);
+    passed = true;
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        if (tmp[i * 4] != rgb[i * 3 + 2] || tmp[i * 4 + 1] != rgb[i * 3 + 1] ||
+            tmp[i * 4 + 2] != rgb[i * 3] || tmp[i * 4 + 3] != 255) {
+            passed = false;
+        }
+    }
+    test_suite_add_result(suite, "Convert Pixels - RGB to BGRA", passed,
+                          passed ? "Channels swapped, alpha opaque" : "Layout incorrect");
+}
+
+// Test grayscale conversion accuracy and rounding
+void test_gray(test_suite_t* suite) {
+    uint8_t rgb[TEST_PIXELS * 3], tmp[TEST_PIXELS * 4];
+    uint8_t gray[TEST_PIXELS], gray_fmt[TEST_PIXELS];
+    fill_test_rgb(rgb, TEST_PIXELS);
+
+    simd_convert_to_gray(rgb, SIMD_PIXEL_RGB, gray, TEST_PIXELS);
+    bool passed = true;
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        double ref = 0.299 * rgb[i * 3] + 0.587 * rgb[i * 3 + 1] + 0.114 * rgb[i * 3 + 2];
+        if (abs_diff(gray[i], clamp_round(ref)) > 1) passed = false;
+    }
+    passed = passed && gray[0] == 0 && gray[1] == 255 && gray[8] == 128;
+    test_suite_add_result(suite, "Gray - BT.601 Accuracy", passed,
+                          passed ? "Within 1 LSB, white is 255" : "Gray values incorrect");
+
+    // Every input layout gives identical results
+    passed = true;
+    for (int f = 1; f < 4; f++) {
+        simd_convert_pixels(rgb, SIMD_PIXEL_RGB, tmp, formats[f], TEST_PIXELS);
+        simd_convert_to_gray(tmp, formats[f], gray_fmt, TEST_PIXELS);
+        if (memcmp(gray, gray_fmt, TEST_PIXELS) != 0) passed = false;
+    }
+    test_suite_add_result(suite, "Gray - Input Formats", passed,
+                          passed ? "Formats agree" : "Format mismatch");
+
+    // The original kernel rounds rather than truncates
+    uint8_t white[17 * 3];
+    uint8_t white_gray[17];
+    memset(white, 255, sizeof(white));
+    simd_rgb_to_gray(white, white_gray, 17);
+    passed = true;
+    for (int i = 0; i < 17; i++) if (white_gray[i] != 255) passed = false;
+    test_suite_add_result(suite, "Gray - simd_rgb_to_gray Rounding", passed,
+                          passed ? "White maps to 255" : "White truncated");
+}
+
+// Test RGB -> NV12/I420 against a double-precision reference
+void test_rgb_to_yuv420(test_suite_t* suite) {
+    const int cw = (TEST_WIDTH + 1) / 2;
+    const int ch = (TEST_HEIGHT + 1) / 2;
+    uint8_t rgb[TEST_PIXELS * 3], bgra[TEST_PIXELS * 4];
+    uint8_t y[TEST_PIXELS], y2[TEST_PIXELS];
+    uint8_t u[cw * ch], v[cw * ch], uv[cw * ch * 2];
+    fill_test_rgb(rgb, TEST_PIXELS);
+    simd_convert_pixels(rgb, SIMD_PIXEL_RGB, bgra, SIMD_PIXEL_BGRA, TEST_PIXELS);
+
+    static const char* names[2][2] = {
+        { "RGB->I420 - BT.601 Limited", "RGB->I420 - BT.601 Full" },
+        { "RGB->I420 - BT.709 Limited", "RGB->I420 - BT.709 Full" }
+    };
+
+    for (int m = 0; m < 2; m++) {
+        for (int rg = 0; rg < 2; rg++) {
+            simd_yuv_matrix_t matrix = m ? SIMD_YUV_BT709 : SIMD_YUV_BT601;
+            simd_yuv_range_t range = rg ? SIMD_YUV_FULL : SIMD_YUV_LIMITED;
+            simd_rgb_to_i420(rgb, SIMD_PIXEL_RGB, TEST_WIDTH, TEST_HEIGHT, y, u, v, matrix, range);
+
+            bool passed = true;
+            for (int i = 0; i < TEST_PIXELS; i++) {
+                uint8_t ry, ru, rv;
+                ref_rgb_to_yuv(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2], matrix, range, &ry, &ru, &rv);
+                if (abs_diff(y[i], ry) > 1) passed = false;
+            }
+            for (int cy = 0; cy < ch; cy++) {
+                for (int cx = 0; cx < cw; cx++) {
+                    // Rounded average of the pixels inside the image
+                    int sum[3] = { 0, 0, 0 };
+                    int n = 0;
+                    for (int dy = 0; dy < 2; dy++) {
+                        for (int dx = 0; dx < 2; dx++) {
+                            int px = cx * 2 + dx, py = cy * 2 + dy;
+                            if (px >= TEST_WIDTH || py >= TEST_HEIGHT) continue;
+                            for (int c = 0; c < 3; c++) sum[c] += rgb[(py * TEST_WIDTH + px) * 3 + c];
+                            n++;
+                        }
+                    }
+                    uint8_t ry, ru, rv;
+                    ref_rgb_to_yuv((sum[0] + n / 2) / n, (sum[1] + n / 2) / n, (sum[2] + n / 2) / n,
+                                   matrix, range, &ry, &ru, &rv);
+                    if (abs_diff(u[cy * cw + cx], ru) > 1 || abs_diff(v[cy * cw + cx], rv) > 1) passed = false;
+                }
+            }
+            test_suite_add_result(suite, names[m][rg], passed,
+                                  passed ? "Y, U, V within 1 LSB" : "YUV values incorrect");
+        }
+    }
+
+    // White and black hit the range limits exactly; grays are colorless
+    uint8_t limits[6 * 3] = { 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 128, 128, 128, 128, 128, 128 };
+    uint8_t ly[6], lu[3], lv[3];
+    simd_rgb_to_i420(limits, SIMD_PIXEL_RGB, 2, 3, ly, lu, lv, SIMD_YUV_BT709, SIMD_YUV_LIMITED);
+    bool passed = ly[0] == 235 && ly[2] == 16 && lu[0] == 128 && lv[0] == 128 && lu[1] == 128 && lv[1] == 128;
+    test_suite_add_result(suite, "RGB->I420 - Range Limits", passed,
+                          passed ? "White 235, black 16, gray chroma 128" : "Range limits incorrect");
+
+    // NV12 carries the same samples as I420, from any input layout
+    simd_rgb_to_i420(rgb, SIMD_PIXEL_RGB, TEST_WIDTH, TEST_HEIGHT, y, u, v, SIMD_YUV_BT601, SIMD_YUV_LIMITED);
+    simd_rgb_to_nv12(bgra, SIMD_PIXEL_BGRA, TEST_WIDTH, TEST_HEIGHT, y2, uv, SIMD_YUV_BT601, SIMD_YUV_LIMITED);
+    passed = memcmp(y, y2, sizeof(y)) == 0;
+    for (int i = 0; i < cw * ch; i++) {
+        if (uv[i * 2] != u[i] || uv[i * 2 + 1] != v[i]) passed = false;
+    }
+    test_suite_add_result(suite, "RGB->NV12 - Matches I420", passed,
+                          passed ? "Planes identical" : "NV12 differs from I420");
+}
+
+// Test NV12/I420 -> RGB against a double-precision reference
+void test_yuv420_to_rgb(test_suite_t* suite) {
+    const int cw = (TEST_WIDTH + 1) / 2;
+    const int ch = (TEST_HEIGHT + 1) / 2;
+    uint8_t y[TEST_PIXELS], u[cw * ch], v[cw * ch], uv[cw * ch * 2];
+    uint8_t rgb[TEST_PIXELS * 3], rgba[TEST_PIXELS * 4], rgb2[TEST_PIXELS * 3];
+
+    uint32_t seed = 777;
+    for (int i = 0; i < TEST_PIXELS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        y[i] = (uint8_t)(seed >> 16);
+    }
+    for (int i = 0; i < cw * ch; i++) {
+        seed = seed * 1103515245u + 12345u;
+        u[i] = (uint8_t)(seed >> 16);
+        v[i] = (uint8_t)(seed >> 8);
+        uv[i * 2] = u[i];
+        uv[i * 2 + 1] = v[i];
+    }
+
+    static const char* names[2][2] = {
+        { "I420->RGB - BT.601 Limited", "I420->RGB - BT.601 Full" },
+        { "I420->RGB - BT.709 Limited", "I420->RGB - BT.709 Full" }
+    };
+
+    for (int m = 0; m < 2; m++) {
+        for (int rg = 0; rg < 2; rg++) {
+            simd_yuv_matrix_t matrix = m ? SIMD_YUV_BT709 : SIMD_YUV_BT601;
+            simd_yuv_range_t range = rg ? SIMD_YUV_FULL : SIMD_YUV_LIMITED;
+            simd_i420_to_rgb(y, u, v, rgb, SIMD_PIXEL_RGB, TEST_WIDTH, TEST_HEIGHT, matrix, range);
+
+            bool passed = true;
+            for (int py = 0; py < TEST_HEIGHT; py++) {
+                for (int px = 0; px < TEST_WIDTH; px++) {
+                    int i = py * TEST_WIDTH + px;
+                    int ci = (py / 2) * cw + px / 2;
+                    uint8_t ref[3];
+                    ref_yuv_to_rgb(y[i], u[ci], v[ci], matrix, range, ref);
+                    for (int c = 0; c < 3; c++) {
+                        if (abs_diff(rgb[i * 3 + c], ref[c]) > 1) passed = false;
+                    }
+                }
+            }
+            test_suite_add_result(suite, names[m][rg], passed,
+                                  passed ? "RGB within 1 LSB" : "RGB values incorrect");
+        }
+    }
+
+    // NV12 into RGBA matches I420 into RGB
+    simd_i420_to_rgb(y, u, v, rgb, SIMD_PIXEL_RGB, TEST_WIDTH, TEST_HEIGHT, SIMD_YUV_BT709, SIMD_YUV_FULL);
+    simd_nv12_to_rgb(y, uv, rgba, SIMD_PIXEL_RGBA, TEST_WIDTH, TEST_HEIGHT, SIMD_YUV_BT709, SIMD_YUV_FULL);
+    simd_convert_pixels(rgba, SIMD_PIXEL_RGBA, rgb2, SIMD_PIXEL_RGB, TEST_PIXELS);
+    bool passed = memcmp(rgb, rgb2, sizeof(rgb)) == 0;
+    for (int i = 0; i < TEST_PIXELS; i++) if (rgba[i * 4 + 3] != 255) passed = false;
+    test_suite_add_result(suite, "NV12->RGBA - Matches I420", passed,
+                          passed ? "Pixels identical, alpha opaque" : "NV12 differs from I420");
+}
+
+// Test RGB <-> HSV against a double-precision reference
+void test_hsv(test_suite_t* suite) {
+    uint8_t rgb[TEST_PIXELS * 3], hsv[TEST_PIXELS * 3], back[TEST_PIXELS * 3];
+    fill_test_rgb(rgb, TEST_PIXELS);
+
+    simd_rgb_to_hsv(rgb, SIMD_PIXEL_RGB, hsv, TEST_PIXELS);
+    bool passed = true;
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        double r = rgb[i * 3], g = rgb[i * 3 + 1], b = rgb[i * 3 + 2];
+        double max = fmax(r, fmax(g, b));
+        double min = fmin(r, fmin(g, b));
+        double delta = max - min;
+        double h = 0.0;
+        if (delta > 0.0) {
+            if (max == r) h = 60.0 * (g - b) / delta;
+            else if (max == g) h = 120.0 + 60.0 * (b - r) / delta;
+            else h = 240.0 + 60.0 * (r - g) / delta;
+            if (h < 0.0) h += 360.0;
+        }
+        int ref_h = (int)lrint(h / 2.0) % 180;
+        int ref_s = max > 0.0 ? (int)lrint(255.0 * delta / max) : 0;
+        int dh = abs_diff(hsv[i * 3], ref_h);
+        if (dh > 1 && dh != 179) passed = false;
+        if (abs_diff(hsv[i * 3 + 1], ref_s) > 1 || hsv[i * 3 + 2] != (uint8_t)max) passed = false;
+    }
+    // Red, green, blue land on hue 0, 60, 120
+    passed = passed && hsv[6] == 0 && hsv[9] == 60 && hsv[12] == 120 && hsv[7] == 255 && hsv[25] == 0;
+    test_suite_add_result(suite, "RGB->HSV - Accuracy", passed,
+                          passed ? "H, S within 1 step, V exact" : "HSV values incorrect");
+
+    simd_hsv_to_rgb(hsv, back, SIMD_PIXEL_RGB, TEST_PIXELS);
+    passed = true;
+    for (size_t i = 0; i < TEST_PIXELS; i++) {
+        double h = hsv[i * 3] * 2.0, s = hsv[i * 3 + 1] / 255.0, v = hsv[i * 3 + 2];
+        double n[3] = { 5.0, 3.0, 1.0 };
+        for (int c = 0; c < 3; c++) {
+            double k = fmod(n[c] + h / 60.0, 6.0);
+            double t = fmax(0.0, fmin(fmin(k, 4.0 - k), 1.0));
+            if (abs_diff(back[i * 3 + c], clamp_round(v - v * s * t)) > 1) passed = false;
+        }
+    }
+    // Primaries survive the round trip exactly
+    passed = passed && memcmp(back, rgb, 10 * 3) == 0;
+    test_suite_add_result(suite, "HSV->RGB - Accuracy", passed,
+                          passed ? "Within 1 LSB, primaries exact" : "RGB values incorrect");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for color operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Color Operations");
+
+    // Run tests
+    test_convert_pixels(suite);
+    test_gray(suite);
+    test_rgb_to_yuv420(suite);
+    test_yuv420_to_rgb(suite);
+    test_hsv(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * test_convolve_ops.c
+ * Unit tests for 2D convolution and border handling
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_convolve.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static const simd_border_t borders[] = {
+    SIMD_BORDER_REPLICATE, SIMD_BORDER_REFLECT, SIMD_BORDER_CONSTANT, SIMD_BORDER_WRAP
+};
+static const char* border_names[] = { "Replicate", "Reflect", "Constant", "Wrap" };
+
+// Reference convolution straight from the definition
+static void ref_convolve_u8(const uint8_t* src, uint8_t* dst, int width, int height,
+                            const int16_t* kernel, int ksize, int shift, simd_border_t border, uint8_t value) {
+    int r = ksize / 2;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int32_t sum = 0;
+            for (int i = 0; i < ksize; i++) {
+                for (int j = 0; j < ksize; j++) {
+                    int sy = simd_border_index(y + i - r, height, border);
+                    int sx = simd_border_index(x + j - r, width, border);
+                    int p = (sy < 0 || sx < 0) ? value : src[sy * width + sx];
+                    sum += kernel[i * ksize + j] * p;
+                }
+            }
+            if (shift > 0) sum = (sum + (1 << (shift - 1))) >> shift;
+            dst[y * width + x] = (uint8_t)(sum < 0 ? 0 : (sum > 255 ? 255 : sum));
+        }
+    }
+}
+
+static void ref_convolve_f32(const float* src, float* dst, int width, int height,
+                             const float* kernel, int ksize, simd_border_t border, float value) {
+    int r = ksize / 2;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double sum = 0.0;
+            for (int i = 0; i < ksize; i++) {
+                for (int j = 0; j < ksize; j++) {
+                    int sy = simd_border_index(y + i - r, height, border);
+                    int sx = simd_border_index(x + j - r, width, border);
+                    float p = (sy < 0 || sx < 0) ? value : src[sy * width + sx];
+                    sum += (double)kernel[i * ksize + j] * p;
+                }
+            }
+            dst[y * width + x] = (float)sum;
+        }
+    }
+}
+
+// Test the border index mapping itself
+void test_border_index(test_suite_t* suite) {
+    // Row "abcdef" (n = 6) extended by 3 on each side
+    static const int expected[4][12] = {
+        { 0, 0, 0, 0, 1, 2, 3, 4, 5, 5, 5, 5 },
+        { 2, 1, 0, 0, 1, 2, 3, 4, 5, 5, 4, 3 },
+        { -1, -1, -1, 0, 1, 2, 3, 4, 5, -1, -1, -1 },
+        { 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2 }
+    };
+
+    bool passed = true;
+    for (int b = 0; b < 4; b++) {
+        for (int i = -3; i < 9; i++) {
+            if (simd_border_index(i, 6, borders[b]) != expected[b][i + 3]) passed = false;
+        }
+    }
+    // Reflection further than the image size keeps bouncing
+    passed = passed && simd_border_index(-5, 2, SIMD_BORDER_REFLECT) == 0 &&
+             simd_border_index(7, 3, SIMD_BORDER_WRAP) == 1;
+    test_suite_add_result(suite, "Border Index", passed,
+                          passed ? "All modes map correctly" : "Mapping incorrect");
+}
+
+// Test separability detection
+void test_separability(test_suite_t* suite) {
+    static const int16_t gauss5[25] = {
+        1, 4, 6, 4, 1, 4, 16, 24, 16, 4, 6, 24, 36, 24, 6, 4, 16, 24, 16, 4, 1, 4, 6, 4, 1
+    };
+    static const int16_t sobel_x[9] = { -1, 0, 1, -2, 0, 2, -1, 0, 1 };
+    static const int16_t laplace[9] = { 0, 1, 0, 1, -4, 1, 0, 1, 0 };
+    int16_t kx[5], ky[5];
+
+    bool passed = simd_kernel_separable_s16(gauss5, 5, kx, ky);
+    for (int i = 0; i < 5 && passed; i++) {
+        for (int j = 0; j < 5; j++) {
+            if (ky[i] * kx[j] != gauss5[i * 5 + j]) passed = false;
+        }
+    }
+    passed = passed && simd_kernel_separable_s16(sobel_x, 3, kx, ky) && !simd_kernel_separable_s16(laplace, 3, kx, ky);
+    test_suite_add_result(suite, "Separability - Integer", passed,
+                          passed ? "Gaussian/Sobel factor, Laplacian does not" : "Detection incorrect");
+
+    float fk[9], fx[3], fy[3];
+    for (int i = 0; i < 9; i++) fk[i] = (float)sobel_x[i] * 0.125f;
+    passed = simd_kernel_separable_f32(fk, 3, fx, fy);
+    for (int i = 0; i < 9; i++) fk[i] = (float)laplace[i];
+    passed = passed && !simd_kernel_separable_f32(fk, 3, fx, fy);
+    test_suite_add_result(suite, "Separability - Float", passed,
+                          passed ? "Rank-1 detected" : "Detection incorrect");
+}
+
+// Test 8-bit convolution against the reference for every border mode
+void test_convolve_u8(test_suite_t* suite) {
+    const int width = 45;
+    const int height = 31;
+    uint8_t* src = (uint8_t*)neon_malloc(width * height);
+    uint8_t* out = (uint8_t*)neon_malloc(width * height);
+    uint8_t* ref = (uint8_t*)neon_malloc(width * height);
+
+    for (int i = 0; i < width * height; i++) src[i] = (uint8_t)((i * 37 + (i / width) * 11) & 0xFF);
+
+    // Non-separable 5x5 with mixed signs, and separable 5x5 Gaussian
+    int16_t random5[25];
+    for (int i = 0; i < 25; i++) random5[i] = (int16_t)((i * 7) % 13 - 4);
+    int16_t gauss5[25];
+    static const int16_t g[5] = { 1, 4, 6, 4, 1 };
+    for (int i = 0; i < 25; i++) gauss5[i] = g[i / 5] * g[i % 5];
+
+    char name[64];
+    for (int b = 0; b < 4; b++) {
+        simd_convolve_u8(src, out, width, height, random5, 5, 5, borders[b], 200);
+        ref_convolve_u8(src, ref, width, height, random5, 5, 5, borders[b], 200);
+        bool passed = memcmp(out, ref, width * height) == 0;
+
+        simd_convolve_u8(src, out, width, height, gauss5, 5, 8, borders[b], 200);
+        ref_convolve_u8(src, ref, width, height, gauss5, 5, 8, borders[b], 200);
+        passed = passed && memcmp(out, ref, width * height) == 0;
+
+        snprintf(name, sizeof(name), "Convolve U8 5x5 - %s", border_names[b]);
+        test_suite_add_result(suite, name, passed, passed ? "Matches reference" : "Mismatch");
+    }
+
+    // 15x15 box (separable) and a kernel wider than the image
+    int16_t box15[225];
+    for (int i = 0; i < 225; i++) box15[i] = 1;
+    simd_convolve_u8(src, out, width, height, box15, 15, 0, SIMD_BORDER_REFLECT, 0);
+    ref_convolve_u8(src, ref, width, height, box15, 15, 0, SIMD_BORDER_REFLECT, 0);
+    bool passed = memcmp(out, ref, width * height) == 0;
+
+    simd_convolve_u8(src, out, 5, height, random5, 5, 3, SIMD_BORDER_WRAP, 0);
+    ref_convolve_u8(src, ref, 5, height, random5, 5, 3, SIMD_BORDER_WRAP, 0);
+    passed = passed && memcmp(out, ref, 5 * height) == 0;
+
+    int16_t wide7[49];
+    for (int i = 0; i < 49; i++) wide7[i] = (int16_t)(i % 5);
+    simd_convolve_u8(src, out, 3, 4, wide7, 7, 6, SIMD_BORDER_REFLECT, 0);
+    ref_convolve_u8(src, ref, 3, 4, wide7, 7, 6, SIMD_BORDER_REFLECT, 0);
+    passed = passed && memcmp(out, ref, 3 * 4) == 0;
+    test_suite_add_result(suite, "Convolve U8 - Large/Small", passed,
+                          passed ? "15x15 and narrow images match" : "Mismatch");
+
+    free(src);
+    free(out);
+    free(ref);
+}
+
+// Test float convolution against the reference
+void test_convolve_f32(test_suite_t* suite) {
+    const int width = 53;
+    const int height = 19;
+    float* src = (float*)neon_malloc(width * height * sizeof(float));
+    float* out = (float*)neon_malloc(width * height * sizeof(float));
+    float* ref = (float*)neon_malloc(width * height * sizeof(float));
+
+    for (int i = 0; i < width * height; i++) src[i] = sinf((float)i * 0.37f) * 10.0f;
+
+    float random7[49], gauss7[49];
+    static const float g[7] = { 0.03f, 0.11f, 0.22f, 0.28f, 0.22f, 0.11f, 0.03f };
+    for (int i = 0; i < 49; i++) {
+        random7[i] = cosf((float)i * 1.3f);
+        gauss7[i] = g[i / 7] * g[i % 7];
+    }
+
+    for (int b = 0; b < 4; b++) {
+        simd_convolve_f32(src, out, width, height, random7, 7, borders[b], -1.5f);
+        ref_convolve_f32(src, ref, width, height, random7, 7, borders[b], -1.5f);
+        bool passed = true;
+        for (int i = 0; i < width * height; i++) if (fabsf(out[i] - ref[i]) > 1e-3f) passed = false;
+
+        simd_convolve_f32(src, out, width, height, gauss7, 7, borders[b], -1.5f);
+        ref_convolve_f32(src, ref, width, height, gauss7, 7, borders[b], -1.5f);
+        for (int i = 0; i < width * height; i++) if (fabsf(out[i] - ref[i]) > 1e-4f) passed = false;
+
+        char name[64];
+        snprintf(name, sizeof(name), "Convolve F32 7x7 - %s", border_names[b]);
+        test_suite_add_result(suite, name, passed, passed ? "Matches reference" : "Mismatch");
+    }
+
+    free(src);
+    free(out);
+    free(ref);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for convolution operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Convolution Operations");
+
+    // Run tests
+    test_border_index(suite);
+    test_separability(suite);
+    test_convolve_u8(suite);
+    test_convolve_f32(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
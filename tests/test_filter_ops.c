@@ -0,0 +1,205 @@
+/**
+ * test_filter_ops.c
+ * Unit tests for stream compaction and packed comparison masks
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_filter.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Scalar implementation for filtering A[i] > threshold
+size_t scalar_filter_gt_f32(const float* a, float threshold, float* values, uint32_t* indices, size_t len) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (a[i] > threshold) {
+            values[count] = a[i];
+            indices[count] = (uint32_t)i;
+            count++;
+        }
+    }
+    return count;
+}
+
+// Test filtering across several selectivities and sizes
+void test_filter_gt(test_suite_t* suite) {
+    const size_t test_size = 1027;  // Not a multiple of the vector width
+
+    float* a = (float*)neon_malloc(test_size * sizeof(float));
+    float* values_simd = (float*)neon_malloc(test_size * sizeof(float));
+    float* values_scalar = (float*)neon_malloc(test_size * sizeof(float));
+    uint32_t* idx_simd = (uint32_t*)neon_malloc(test_size * sizeof(uint32_t));
+    uint32_t* idx_scalar = (uint32_t*)neon_malloc(test_size * sizeof(uint32_t));
+
+    if (!a || !values_simd || !values_scalar || !idx_simd || !idx_scalar) {
+        test_suite_add_result(suite, "Filter GT - Allocation", false, "Memory allocation failed");
+        return;
+    }
+
+    // Values in [0, 100) so threshold t selects roughly (100 - t)%
+    for (size_t i = 0; i < test_size; i++) {
+        a[i] = (float)((i * 37) % 100);
+    }
+
+    const float thresholds[] = { 99.0f, 50.0f, -1.0f };
+    const char* names[] = { "Filter GT - 0% Selected", "Filter GT - 50% Selected", "Filter GT - 100% Selected" };
+
+    for (int t = 0; t < 3; t++) {
+        size_t n_simd = simd_filter_gt_f32(a, thresholds[t], values_simd, idx_simd, test_size);
+        size_t n_scalar = scalar_filter_gt_f32(a, thresholds[t], values_scalar, idx_scalar, test_size);
+
+        bool passed = n_simd == n_scalar &&
+                      memcmp(values_simd, values_scalar, n_scalar * sizeof(float)) == 0 &&
+                      memcmp(idx_simd, idx_scalar, n_scalar * sizeof(uint32_t)) == 0;
+        char message[256];
+        snprintf(message, sizeof(message), "Selected %zu (expected %zu)", n_simd, n_scalar);
+        test_suite_add_result(suite, names[t], passed, message);
+    }
+
+    // Values-only and indices-only outputs
+    size_t n_values = simd_filter_gt_f32(a, 50.0f, values_simd, NULL, test_size);
+    size_t n_indices = simd_filter_gt_f32(a, 50.0f, NULL, idx_simd, test_size);
+    size_t n_scalar = scalar_filter_gt_f32(a, 50.0f, values_scalar, idx_scalar, test_size);
+    ASSERT_INT_EQ(suite, "Filter GT - Values Only Count", (int)n_values, (int)n_scalar);
+    ASSERT_INT_EQ(suite, "Filter GT - Indices Only Count", (int)n_indices, (int)n_scalar);
+    ASSERT_ARRAY_EQ(suite, "Filter GT - Indices Only", idx_simd, idx_scalar, (int)n_scalar, uint32_t, "%u");
+
+    // Small arrays (smaller than SIMD width)
+    size_t n_small = simd_filter_gt_f32(a, 10.0f, values_simd, idx_simd, 3);
+    size_t n_small_scalar = scalar_filter_gt_f32(a, 10.0f, values_scalar, idx_scalar, 3);
+    ASSERT_INT_EQ(suite, "Filter GT - Small Arrays", (int)n_small, (int)n_small_scalar);
+
+    free(a);
+    free(values_simd);
+    free(values_scalar);
+    free(idx_simd);
+    free(idx_scalar);
+}
+
+// Test range filtering and compaction from comparison masks
+void test_filter_range_and_compact(test_suite_t* suite) {
+    const size_t test_size = 515;
+
+    float* a = (float*)neon_malloc(test_size * sizeof(float));
+    float* b = (float*)neon_malloc(test_size * sizeof(float));
+    uint32_t* mask = (uint32_t*)neon_malloc(test_size * sizeof(uint32_t));
+    float* values = (float*)neon_malloc(test_size * sizeof(float));
+    uint32_t* indices = (uint32_t*)neon_malloc(test_size * sizeof(uint32_t));
+
+    if (!a || !b || !mask || !values || !indices) {
+        test_suite_add_result(suite, "Filter Range - Allocation", false, "Memory allocation failed");
+        return;
+    }
+
+    for (size_t i = 0; i < test_size; i++) {
+        a[i] = (float)((i * 13) % 64);
+        b[i] = 31.5f;
+    }
+
+    // Range [16, 47]
+    size_t n = simd_filter_range_f32(a, 16.0f, 47.0f, values, indices, test_size);
+    bool passed = true;
+    size_t expected = 0;
+    for (size_t i = 0; i < test_size; i++) {
+        if (a[i] >= 16.0f && a[i] <= 47.0f) {
+            if (expected >= n || indices[expected] != i || values[expected] != a[i]) passed = false;
+            expected++;
+        }
+    }
+    ASSERT_INT_EQ(suite, "Filter Range - Count", (int)n, (int)expected);
+    test_suite_add_result(suite, "Filter Range - Results", passed && n == expected,
+                          passed ? "Selected elements in order" : "Selected elements differ");
+
+    // Compaction driven by simd_cmpgt_f32 masks must match the threshold filter
+    simd_cmpgt_f32(a, b, mask, test_size);
+    size_t n_mask = simd_compact_f32(a, mask, values, indices, test_size);
+    size_t n_thresh = simd_filter_gt_f32(a, 31.5f, NULL, NULL, test_size);
+    ASSERT_INT_EQ(suite, "Compact From Mask - Count", (int)n_mask, (int)n_thresh);
+
+    free(a);
+    free(b);
+    free(mask);
+    free(values);
+    free(indices);
+}
+
+// Test packed bitmask output and selectivity statistics
+void test_packed_bits(test_suite_t* suite) {
+    const size_t test_size = 1000;  // Partial last word
+    const size_t words = (test_size + 63) / 64;
+
+    float* a = (float*)neon_malloc(test_size * sizeof(float));
+    float* b = (float*)neon_malloc(test_size * sizeof(float));
+    uint32_t* mask = (uint32_t*)neon_malloc(test_size * sizeof(uint32_t));
+    uint64_t* bits = (uint64_t*)neon_malloc(words * sizeof(uint64_t));
+    uint64_t* bits_from_mask = (uint64_t*)neon_malloc(words * sizeof(uint64_t));
+
+    if (!a || !b || !mask || !bits || !bits_from_mask) {
+        test_suite_add_result(suite, "Packed Bits - Allocation", false, "Memory allocation failed");
+        return;
+    }
+
+    size_t expected = 0;
+    for (size_t i = 0; i < test_size; i++) {
+        a[i] = (float)((i * 7) % 10);
+        b[i] = 6.0f;
+        if (a[i] > b[i]) expected++;
+    }
+
+    simd_cmpgt_bits_f32(a, b, bits, test_size);
+    bool passed = true;
+    for (size_t i = 0; i < test_size; i++) {
+        bool bit = (bits[i / 64] >> (i % 64)) & 1;
+        if (bit != (a[i] > b[i])) passed = false;
+    }
+    if (bits[words - 1] >> (test_size % 64)) passed = false;  // Unused bits must be clear
+    test_suite_add_result(suite, "Packed Bits - CmpGT", passed,
+                          passed ? "One bit per element matches" : "Bit mismatch");
+
+    simd_cmpgt_f32(a, b, mask, test_size);
+    simd_mask_to_bits_u32(mask, bits_from_mask, test_size);
+    ASSERT_ARRAY_EQ(suite, "Packed Bits - From Mask", bits_from_mask, bits, (int)words, uint64_t, "%lx");
+
+    simd_cmpgt_n_bits_f32(a, 6.0f, bits_from_mask, test_size);
+    ASSERT_ARRAY_EQ(suite, "Packed Bits - Threshold", bits_from_mask, bits, (int)words, uint64_t, "%lx");
+
+    ASSERT_INT_EQ(suite, "Popcount Bits", (int)simd_popcount_bits(bits, test_size), (int)expected);
+
+    simd_filter_stats_t stats = simd_selectivity_gt_f32(a, 6.0f, test_size);
+    ASSERT_INT_EQ(suite, "Selectivity - Selected", (int)stats.selected, (int)expected);
+    ASSERT_FLOAT_EQ(suite, "Selectivity - Ratio", stats.selectivity, (double)expected / test_size, 1e-9);
+
+    simd_filter_stats_t bit_stats = simd_selectivity_bits(bits, test_size);
+    ASSERT_INT_EQ(suite, "Selectivity Bits - Selected", (int)bit_stats.selected, (int)expected);
+
+    free(a);
+    free(b);
+    free(mask);
+    free(bits);
+    free(bits_from_mask);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for filter operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Filter Operations");
+
+    // Run tests
+    test_filter_gt(suite);
+    test_filter_range_and_compact(suite);
+    test_packed_bits(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,311 @@
+/**
+ * test_gradient_ops.c
+ * Unit tests for Sobel/Scharr gradients, magnitude and orientation
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_gradient.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static const simd_border_t borders[] = {
+    SIMD_BORDER_REPLICATE, SIMD_BORDER_REFLECT, SIMD_BORDER_CONSTANT, SIMD_BORDER_WRAP
+};
+static const char* border_names[] = { "Replicate", "Reflect", "Constant", "Wrap" };
+
+// Reference 3x3 gradients straight from the kernel definition
+static void ref_gradient(const uint8_t* src, int16_t* gx, int16_t* gy, int width, int height,
+                         simd_gradient_op_t op, simd_border_t border, uint8_t value) {
+    int w = op == SIMD_GRADIENT_SCHARR ? 10 : 2;
+    int c = op == SIMD_GRADIENT_SCHARR ? 3 : 1;
+    int smooth[3] = { c, w, c };
+    int deriv[3] = { -1, 0, 1 };
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int sx_sum = 0, sy_sum = 0;
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    int sy = simd_border_index(y + i - 1, height, border);
+                    int sx = simd_border_index(x + j - 1, width, border);
+                    int p = (sy < 0 || sx < 0) ? value : src[sy * width + sx];
+                    sx_sum += smooth[i] * deriv[j] * p;
+                    sy_sum += deriv[i] * smooth[j] * p;
+                }
+            }
+            gx[y * width + x] = (int16_t)sx_sum;
+            gy[y * width + x] = (int16_t)sy_sum;
+        }
+    }
+}
+
+// Reference bin from atan2; returns -1 when the angle sits within 1e-6
+// degrees of a sector boundary (either neighbour is accepted there)
+static int ref_bin(int gx, int gy, int bins) {
+    if (gx == 0 && gy == 0) return 0;
+    double deg = atan2((double)gy, (double)gx) * 180.0 / 3.14159265358979323846;
+    if (deg < 0.0) deg += 180.0;
+    if (deg >= 180.0) deg -= 180.0;
+    double pos = deg * bins / 180.0 + 0.5;
+    if (fabs(pos - floor(pos + 0.5)) < 1e-6 * bins / 180.0) return -1;
+    return (int)floor(pos) % bins;
+}
+
+static void fill_pattern(uint8_t* img, int width, int height) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            img[y * width + x] = (uint8_t)((x * 37 + y * 11 + (x * y) % 23) & 0xFF);
+        }
+    }
+}
+
+// Test Sobel and Scharr planes against the reference for every border mode
+void test_gradient_xy(test_suite_t* suite) {
+    const int width = 45;
+    const int height = 17;
+    size_t n = (size_t)width * height;
+    uint8_t* src = (uint8_t*)neon_malloc(n);
+    int16_t* gx = (int16_t*)neon_malloc(n * sizeof(int16_t));
+    int16_t* gy = (int16_t*)neon_malloc(n * sizeof(int16_t));
+    int16_t* rx = (int16_t*)neon_malloc(n * sizeof(int16_t));
+    int16_t* ry = (int16_t*)neon_malloc(n * sizeof(int16_t));
+    fill_pattern(src, width, height);
+
+    for (int op = 0; op < 2; op++) {
+        bool passed = true;
+        for (int b = 0; b < 4; b++) {
+            simd_gradient_xy(src, gx, gy, width, height, (simd_gradient_op_t)op, borders[b], 250);
+            ref_gradient(src, rx, ry, width, height, (simd_gradient_op_t)op, borders[b], 250);
+            if (memcmp(gx, rx, n * sizeof(int16_t)) != 0 || memcmp(gy, ry, n * sizeof(int16_t)) != 0) {
+                passed = false;
+                printf("  Mismatch with %s border\n", border_names[b]);
+            }
+        }
+        test_suite_add_result(suite, op == SIMD_GRADIENT_SOBEL ? "Gradient XY - Sobel" : "Gradient XY - Scharr",
+                              passed, passed ? "All border modes match reference" : "Mismatch");
+    }
+
+    // Images narrower than one vector and a single row
+    bool passed = true;
+    static const int sizes[][2] = { { 1, 1 }, { 3, 5 }, { 7, 1 }, { 9, 2 } };
+    for (int s = 0; s < 4; s++) {
+        int w = sizes[s][0], h = sizes[s][1];
+        simd_gradient_xy(src, gx, gy, w, h, SIMD_GRADIENT_SCHARR, SIMD_BORDER_REFLECT, 0);
+        ref_gradient(src, rx, ry, w, h, SIMD_GRADIENT_SCHARR, SIMD_BORDER_REFLECT, 0);
+        if (memcmp(gx, rx, (size_t)w * h * sizeof(int16_t)) != 0 ||
+            memcmp(gy, ry, (size_t)w * h * sizeof(int16_t)) != 0) passed = false;
+    }
+    test_suite_add_result(suite, "Gradient XY - Small Images", passed,
+                          passed ? "Tiny images match reference" : "Mismatch");
+
+    free(src);
+    free(gx);
+    free(gy);
+    free(rx);
+    free(ry);
+}
+
+// Test L1 and exact L2 magnitude over the full Scharr range
+void test_magnitude(test_suite_t* suite) {
+    const size_t len = 4099;
+    int16_t* gx = (int16_t*)neon_malloc(len * sizeof(int16_t));
+    int16_t* gy = (int16_t*)neon_malloc(len * sizeof(int16_t));
+    uint16_t* mag = (uint16_t*)neon_malloc(len * sizeof(uint16_t));
+
+    for (size_t i = 0; i < len; i++) {
+        gx[i] = (int16_t)((int)(i * 2654435761u % 8161) - 4080);
+        gy[i] = (int16_t)((int)(i * 40503u % 8161) - 4080);
+    }
+    // Extremes and values whose exact root lies right next to a .5 boundary
+    gx[0] = 4080; gy[0] = 4080;
+    gx[1] = -4080; gy[1] = 0;
+    gx[2] = 0; gy[2] = 0;
+    gx[3] = 3; gy[3] = 4;
+
+    simd_gradient_magnitude(gx, gy, mag, len, SIMD_MAGNITUDE_L1);
+    bool passed = true;
+    for (size_t i = 0; i < len; i++) {
+        if (mag[i] != abs(gx[i]) + abs(gy[i])) passed = false;
+    }
+    test_suite_add_result(suite, "Magnitude - L1", passed, passed ? "Exact" : "Mismatch");
+
+    simd_gradient_magnitude(gx, gy, mag, len, SIMD_MAGNITUDE_L2);
+    passed = true;
+    for (size_t i = 0; i < len; i++) {
+        double r = sqrt((double)gx[i] * gx[i] + (double)gy[i] * gy[i]);
+        if (mag[i] != (uint16_t)floor(r + 0.5)) passed = false;
+    }
+    test_suite_add_result(suite, "Magnitude - L2", passed, passed ? "Correctly rounded" : "Mismatch");
+
+    // Every n near k^2 + k for large k, where a plain float sqrt can misround
+    passed = true;
+    for (int k = 5000; k < 5800 && passed; k++) {
+        for (int d = -1; d <= 1; d++) {
+            int n = k * k + k + d;
+            int16_t a = (int16_t)k, b = 0;
+            // Find gx, gy with gx^2 + gy^2 == n when possible
+            for (int x = (int)sqrt((double)n); x > 0 && x > k - 200; x--) {
+                int rem = n - x * x;
+                int y = (int)sqrt((double)rem);
+                while (y * y < rem) y++;
+                if (y * y == rem && y <= 4080 && x <= 4080) {
+                    a = (int16_t)x;
+                    b = (int16_t)y;
+                    break;
+                }
+            }
+            uint16_t m;
+            simd_gradient_magnitude(&a, &b, &m, 1, SIMD_MAGNITUDE_L2);
+            int16_t va[8] = { a, a, a, a, a, a, a, a }, vb[8] = { b, b, b, b, b, b, b, b };
+            uint16_t vm[8];
+            simd_gradient_magnitude(va, vb, vm, 8, SIMD_MAGNITUDE_L2);
+            uint16_t expect = (uint16_t)floor(sqrt((double)a * a + (double)b * b) + 0.5);
+            if (m != expect || vm[0] != expect) passed = false;
+        }
+    }
+    test_suite_add_result(suite, "Magnitude - L2 Rounding Edges", passed,
+                          passed ? "Near-tie roots rounded correctly" : "Misrounded");
+
+    // Full int16 range, in the vector body and the scalar tail alike
+    static const int16_t ex[11] = { -32768, -32768, 32767, -32768, 32767, 0, -32768, 1, -1, 32767, -32768 };
+    static const int16_t ey[11] = { -32768, 32767, 32767, 0, -32767, -32768, 1, 32767, -1, 32767, -32768 };
+    uint16_t em[11];
+    passed = true;
+    simd_gradient_magnitude(ex, ey, em, 11, SIMD_MAGNITUDE_L1);
+    for (int i = 0; i < 11; i++) {
+        int sum = abs(ex[i]) + abs(ey[i]);
+        if (em[i] != (sum > 65535 ? 65535 : sum)) passed = false;
+    }
+    simd_gradient_magnitude(ex, ey, em, 11, SIMD_MAGNITUDE_L2);
+    for (int i = 0; i < 11; i++) {
+        if (em[i] != (uint16_t)floor(sqrt((double)ex[i] * ex[i] + (double)ey[i] * ey[i]) + 0.5)) passed = false;
+    }
+
+    // Orientation of every pair from a grid that includes both extremes:
+    // 9 equal elements put lanes 0-7 in the vector body and 8 in the tail
+    static const int16_t grid[9] = { -32768, -32767, -20000, -1, 0, 1, 20000, 32766, 32767 };
+    for (int bins = 2; bins <= 9 && passed; bins++) {
+        for (int i = 0; i < 81; i++) {
+            int16_t ox[9], oy[9];
+            uint8_t bin[9];
+            for (int e = 0; e < 9; e++) {
+                ox[e] = grid[i / 9];
+                oy[e] = grid[i % 9];
+            }
+            simd_gradient_orientation(ox, oy, bin, 9, bins);
+            int ref = ref_bin(ox[0], oy[0], bins);
+            if (bin[0] != bin[8] || (ref >= 0 && bin[0] != ref)) passed = false;
+        }
+    }
+    test_suite_add_result(suite, "Magnitude and Orientation - Int16 Extremes", passed,
+                          passed ? "L1 saturates, L2 exact, orientation folded" : "Overflow or mismatch");
+
+    free(gx);
+    free(gy);
+    free(mag);
+}
+
+// Test orientation binning against atan2
+void test_orientation(test_suite_t* suite) {
+    const size_t len = 2051;
+    int16_t* gx = (int16_t*)neon_malloc(len * sizeof(int16_t));
+    int16_t* gy = (int16_t*)neon_malloc(len * sizeof(int16_t));
+    uint8_t* bins_out = (uint8_t*)neon_malloc(len);
+
+    for (size_t i = 0; i < len; i++) {
+        gx[i] = (int16_t)((int)(i * 2654435761u % 2041) - 1020);
+        gy[i] = (int16_t)((int)(i * 40503u % 2041) - 1020);
+    }
+    // Axis and diagonal directions, including the zero gradient
+    static const int16_t axes[][2] = { { 0, 0 }, { 5, 0 }, { -5, 0 }, { 0, 5 }, { 0, -5 },
+                                       { 7, 7 }, { -7, 7 }, { 7, -7 }, { -7, -7 } };
+    for (int i = 0; i < 9; i++) {
+        gx[i] = axes[i][0];
+        gy[i] = axes[i][1];
+    }
+
+    static const int bin_counts[] = { 1, 4, 8, 9, 18 };
+    for (int c = 0; c < 5; c++) {
+        int nb = bin_counts[c];
+        simd_gradient_orientation(gx, gy, bins_out, len, nb);
+        bool passed = true;
+        for (size_t i = 0; i < len; i++) {
+            int expect = ref_bin(gx[i], gy[i], nb);
+            if (bins_out[i] >= nb || (expect >= 0 && bins_out[i] != expect)) passed = false;
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "Orientation - %d Bins", nb);
+        test_suite_add_result(suite, name, passed, passed ? "Matches atan2 reference" : "Mismatch");
+    }
+
+    // Canny directions: 0 horizontal, 1 = 45, 2 vertical, 3 = 135 degrees
+    simd_gradient_orientation(gx, gy, bins_out, 9, 4);
+    static const uint8_t expect4[9] = { 0, 0, 0, 2, 2, 1, 3, 3, 1 };
+    bool passed = memcmp(bins_out, expect4, 9) == 0;
+    test_suite_add_result(suite, "Orientation - Canny Sectors", passed,
+                          passed ? "Axis and diagonal directions binned" : "Wrong sector");
+
+    free(gx);
+    free(gy);
+    free(bins_out);
+}
+
+// Test that the fused pass agrees with the standalone operations
+void test_fused(test_suite_t* suite) {
+    const int width = 67;
+    const int height = 23;
+    size_t n = (size_t)width * height;
+    uint8_t* src = (uint8_t*)neon_malloc(n);
+    int16_t* gx = (int16_t*)neon_malloc(n * sizeof(int16_t));
+    int16_t* gy = (int16_t*)neon_malloc(n * sizeof(int16_t));
+    uint16_t* mag = (uint16_t*)neon_malloc(n * sizeof(uint16_t));
+    uint16_t* mag_ref = (uint16_t*)neon_malloc(n * sizeof(uint16_t));
+    uint8_t* dir = (uint8_t*)neon_malloc(n);
+    uint8_t* dir_ref = (uint8_t*)neon_malloc(n);
+    fill_pattern(src, width, height);
+
+    simd_gradient_xy(src, gx, gy, width, height, SIMD_GRADIENT_SOBEL, SIMD_BORDER_REPLICATE, 0);
+    simd_gradient_magnitude(gx, gy, mag_ref, n, SIMD_MAGNITUDE_L2);
+    simd_gradient_orientation(gx, gy, dir_ref, n, 4);
+
+    // Magnitude and orientation only, without the Gx/Gy planes
+    simd_gradient(src, width, height, SIMD_GRADIENT_SOBEL, SIMD_BORDER_REPLICATE, 0,
+                  NULL, NULL, mag, SIMD_MAGNITUDE_L2, dir, 4);
+    bool passed = memcmp(mag, mag_ref, n * sizeof(uint16_t)) == 0 && memcmp(dir, dir_ref, n) == 0;
+    test_suite_add_result(suite, "Fused Gradient", passed,
+                          passed ? "Matches standalone operations" : "Mismatch");
+
+    free(src);
+    free(gx);
+    free(gy);
+    free(mag);
+    free(mag_ref);
+    free(dir);
+    free(dir_ref);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for gradient operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Gradient Operations");
+
+    // Run tests
+    test_gradient_xy(suite);
+    test_magnitude(suite);
+    test_orientation(suite);
+    test_fused(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,540 @@
+/**
+ * test_image_ops.c
+ * Unit tests for strided image views: every view kernel must match its
+ * packed counterpart on a packed copy and leave the padding untouched
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_image.h"
+#include "../include/simd_ops.h"
+#include "../include/simd_color.h"
+#include "../include/simd_convolve.h"
+#include "../include/simd_gradient.h"
+#include "../include/simd_canny.h"
+#include "../include/simd_integral.h"
+#include "../include/simd_resize.h"
+#include "../include/simd_morph.h"
+#include "../include/simd_median.h"
+#include "../include/simd_lut.h"
+#include "../include/simd_blend.h"
+#include "../include/simd_tile.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+#define SENTINEL 0xA5
+
+/**
+ * Padded View Helpers
+ * A view sits at pixel (3, 2) of a larger buffer whose rows carry extra
+ * bytes, like an ROI of a padded capture frame. Everything around it is
+ * filled with SENTINEL so stray writes show up.
+ */
+
+typedef struct {
+    uint8_t* base;
+    size_t size;
+    size_t elem_size;
+    simd_image_t view;
+} padded_t;
+
+static void fill_bytes(uint8_t* buf, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        buf[i] = (uint8_t)(seed >> 24);
+    }
+}
+
+static padded_t padded_create(int width, int height, int channels, size_t elem_size) {
+    padded_t p;
+    size_t pixel = (size_t)channels * elem_size;
+    size_t stride = (size_t)(width + 8) * pixel + 8 * elem_size;
+    p.size = stride * (size_t)(height + 4);
+    p.elem_size = elem_size;
+    p.base = (uint8_t*)neon_malloc(p.size);
+    memset(p.base, SENTINEL, p.size);
+    p.view = simd_image_make(p.base + 2 * stride + 3 * pixel, width, height, stride, channels);
+    return p;
+}
+
+// Random u8 pixels (or floats in [0, 255]) inside the view only
+static void padded_fill(padded_t* p, uint32_t seed) {
+    for (int y = 0; y < p->view.height; y++) {
+        uint8_t* row = (uint8_t*)simd_image_row(&p->view, y);
+        size_t bytes = simd_image_row_bytes(&p->view, p->elem_size);
+        if (p->elem_size == sizeof(float)) {
+            float* f = (float*)row;
+            for (size_t i = 0; i < bytes / sizeof(float); i++) {
+                seed = seed * 1664525u + 1013904223u;
+                f[i] = (float)(seed >> 24);
+            }
+        } else {
+            fill_bytes(row, bytes, seed + (uint32_t)y * 7919u);
+        }
+    }
+}
+
+// Packed copy of the view
+static uint8_t* padded_pack(const padded_t* p) {
+    size_t bytes = simd_image_row_bytes(&p->view, p->elem_size);
+    uint8_t* out = (uint8_t*)neon_malloc(bytes * p->view.height);
+    for (int y = 0; y < p->view.height; y++) {
+        memcpy(out + (size_t)y * bytes, simd_image_row(&p->view, y), bytes);
+    }
+    return out;
+}
+
+// View contents equal PACKED and every byte outside the view is intact
+static bool padded_check(const padded_t* p, const uint8_t* packed) {
+    size_t bytes = simd_image_row_bytes(&p->view, p->elem_size);
+    size_t begin = (size_t)(p->view.data - p->base);
+    for (size_t i = 0; i < p->size; i++) {
+        size_t rel = i - begin;
+        bool inside = i >= begin && rel / p->view.stride < (size_t)p->view.height && rel % p->view.stride < bytes;
+        if (!inside && p->base[i] != SENTINEL) return false;
+    }
+    for (int y = 0; y < p->view.height; y++) {
+        if (memcmp(simd_image_row(&p->view, y), packed + (size_t)y * bytes, bytes) != 0) return false;
+    }
+    return true;
+}
+
+static void padded_destroy(padded_t* p) {
+    free(p->base);
+}
+
+// Test the view helpers themselves
+void test_image_helpers(test_suite_t* suite) {
+    uint8_t buf[64 * 8];
+    simd_image_t img = simd_image_make(buf, 20, 8, 64, 3);
+    simd_image_t roi = simd_image_roi(&img, 2, 3, 5, 4, 1);
+    simd_image_t packed = simd_image_packed(buf, 20, 8, 3, 1);
+
+    bool passed = roi.data == buf + 3 * 64 + 2 * 3 && roi.stride == 64 && roi.width == 5 && roi.channels == 3;
+    passed = passed && (uint8_t*)simd_image_row(&roi, 1) == roi.data + 64;
+    passed = passed && simd_image_row_bytes(&img, 1) == 60 && !simd_image_is_packed(&img, 1);
+    passed = passed && packed.stride == 60 && simd_image_is_packed(&packed, 1);
+    passed = passed && simd_image_valid(&img, 3, 1) && simd_image_valid(&img, 0, 1);
+    passed = passed && !simd_image_valid(&img, 1, 1) && !simd_image_valid(&img, 3, 2);
+    passed = passed && !simd_image_valid(NULL, 0, 1);
+    test_suite_add_result(suite, "Image - View Helpers", passed, passed ? "ROI, packed and validity checks" : "Mismatch");
+}
+
+// Test the color conversions, including YUV planes with padded rows
+void test_image_color(test_suite_t* suite) {
+    const int w = 37, h = 11, cw = (w + 1) / 2, ch = (h + 1) / 2;
+    bool passed = true;
+
+    padded_t rgb = padded_create(w, h, 3, 1);
+    padded_t rgba = padded_create(w, h, 4, 1);
+    padded_t gray = padded_create(w, h, 1, 1);
+    padded_t hsv = padded_create(w, h, 3, 1);
+    padded_fill(&rgb, 1);
+    uint8_t* rgb_p = padded_pack(&rgb);
+    uint8_t* ref = (uint8_t*)neon_malloc((size_t)w * h * 4);
+
+    simd_convert_pixels_view(&rgb.view, SIMD_PIXEL_RGB, &rgba.view, SIMD_PIXEL_BGRA);
+    simd_convert_pixels(rgb_p, SIMD_PIXEL_RGB, ref, SIMD_PIXEL_BGRA, (size_t)w * h);
+    passed = passed && padded_check(&rgba, ref);
+
+    simd_convert_to_gray_view(&rgb.view, SIMD_PIXEL_RGB, &gray.view);
+    simd_convert_to_gray(rgb_p, SIMD_PIXEL_RGB, ref, (size_t)w * h);
+    passed = passed && padded_check(&gray, ref);
+
+    simd_rgb_to_gray_view(&rgb.view, &gray.view);
+    simd_rgb_to_gray(rgb_p, ref, (size_t)w * h);
+    passed = passed && padded_check(&gray, ref);
+
+    simd_rgb_to_hsv_view(&rgb.view, SIMD_PIXEL_RGB, &hsv.view);
+    simd_rgb_to_hsv(rgb_p, SIMD_PIXEL_RGB, ref, (size_t)w * h);
+    passed = passed && padded_check(&hsv, ref);
+
+    uint8_t* hsv_p = padded_pack(&hsv);
+    simd_hsv_to_rgb_view(&hsv.view, &rgba.view, SIMD_PIXEL_RGBA);
+    simd_hsv_to_rgb(hsv_p, ref, SIMD_PIXEL_RGBA, (size_t)w * h);
+    passed = passed && padded_check(&rgba, ref);
+
+    // NV12 and I420 round trips
+    padded_t y = padded_create(w, h, 1, 1);
+    padded_t uv = padded_create(cw, ch, 2, 1);
+    padded_t u = padded_create(cw, ch, 1, 1);
+    padded_t v = padded_create(cw, ch, 1, 1);
+    uint8_t* yp = (uint8_t*)neon_malloc((size_t)w * h);
+    uint8_t* uvp = (uint8_t*)neon_malloc((size_t)cw * ch * 2);
+    uint8_t* vp = (uint8_t*)neon_malloc((size_t)cw * ch);
+
+    simd_rgb_to_nv12_view(&rgb.view, SIMD_PIXEL_RGB, &y.view, &uv.view, SIMD_YUV_BT709, SIMD_YUV_LIMITED);
+    simd_rgb_to_nv12(rgb_p, SIMD_PIXEL_RGB, w, h, yp, uvp, SIMD_YUV_BT709, SIMD_YUV_LIMITED);
+    passed = passed && padded_check(&y, yp) && padded_check(&uv, uvp);
+    simd_nv12_to_rgb_view(&y.view, &uv.view, &rgba.view, SIMD_PIXEL_BGRA, SIMD_YUV_BT709, SIMD_YUV_LIMITED);
+    simd_nv12_to_rgb(yp, uvp, ref, SIMD_PIXEL_BGRA, w, h, SIMD_YUV_BT709, SIMD_YUV_LIMITED);
+    passed = passed && padded_check(&rgba, ref);
+
+    simd_rgb_to_i420_view(&rgb.view, SIMD_PIXEL_RGB, &y.view, &u.view, &v.view, SIMD_YUV_BT601, SIMD_YUV_FULL);
+    simd_rgb_to_i420(rgb_p, SIMD_PIXEL_RGB, w, h, yp, uvp, vp, SIMD_YUV_BT601, SIMD_YUV_FULL);
+    passed = passed && padded_check(&y, yp) && padded_check(&u, uvp) && padded_check(&v, vp);
+    simd_i420_to_rgb_view(&y.view, &u.view, &v.view, &rgb.view, SIMD_PIXEL_RGB, SIMD_YUV_BT601, SIMD_YUV_FULL);
+    simd_i420_to_rgb(yp, uvp, vp, ref, SIMD_PIXEL_RGB, w, h, SIMD_YUV_BT601, SIMD_YUV_FULL);
+    passed = passed && padded_check(&rgb, ref);
+
+    test_suite_add_result(suite, "Image - Color Views", passed, passed ? "Packed, gray, HSV, NV12, I420" : "Mismatch");
+
+    padded_destroy(&rgb);
+    padded_destroy(&rgba);
+    padded_destroy(&gray);
+    padded_destroy(&hsv);
+    padded_destroy(&y);
+    padded_destroy(&uv);
+    padded_destroy(&u);
+    padded_destroy(&v);
+    free(rgb_p);
+    free(hsv_p);
+    free(ref);
+    free(yp);
+    free(uvp);
+    free(vp);
+}
+
+// Test the convolutions, gradient and Canny views
+void test_image_filters(test_suite_t* suite) {
+    const int w = 45, h = 19;
+    bool conv_ok = true, grad_ok = true;
+
+    padded_t src = padded_create(w, h, 1, 1);
+    padded_t dst = padded_create(w, h, 1, 1);
+    padded_t srcf = padded_create(w, h, 1, sizeof(float));
+    padded_t dstf = padded_create(w, h, 1, sizeof(float));
+    padded_fill(&src, 2);
+    padded_fill(&srcf, 3);
+    uint8_t* sp = padded_pack(&src);
+    float* sfp = (float*)padded_pack(&srcf);
+    uint8_t* ref = (uint8_t*)neon_malloc((size_t)w * h * 4);
+    float* reff = (float*)ref;
+
+    // Non-separable 3x3 and separable 5x5 kernels
+    const int16_t k3[9] = { 1, 2, 0, -1, 4, 1, 0, 3, 1 };
+    const float k3f[9] = { 0.1f, 0.2f, 0.0f, -0.1f, 0.4f, 0.1f, 0.0f, 0.3f, 0.1f };
+    const int16_t k5[5] = { 1, 4, 6, 4, 1 };
+    const float k5f[5] = { 0.0625f, 0.25f, 0.375f, 0.25f, 0.0625f };
+
+    simd_convolve_u8_view(&src.view, &dst.view, k3, 3, 3, SIMD_BORDER_REFLECT, 0);
+    simd_convolve_u8(sp, ref, w, h, k3, 3, 3, SIMD_BORDER_REFLECT, 0);
+    conv_ok = conv_ok && padded_check(&dst, ref);
+
+    simd_convolve_sep_u8_view(&src.view, &dst.view, k5, k5, 5, 8, SIMD_BORDER_CONSTANT, 9);
+    simd_convolve_sep_u8(sp, ref, w, h, k5, k5, 5, 8, SIMD_BORDER_CONSTANT, 9);
+    conv_ok = conv_ok && padded_check(&dst, ref);
+
+    simd_convolve_f32_view(&srcf.view, &dstf.view, k3f, 3, SIMD_BORDER_REPLICATE, 0.0f);
+    simd_convolve_f32(sfp, reff, w, h, k3f, 3, SIMD_BORDER_REPLICATE, 0.0f);
+    conv_ok = conv_ok && padded_check(&dstf, ref);
+
+    simd_convolve_sep_f32_view(&srcf.view, &dstf.view, k5f, k5f, 5, SIMD_BORDER_WRAP, 0.0f);
+    simd_convolve_sep_f32(sfp, reff, w, h, k5f, k5f, 5, SIMD_BORDER_WRAP, 0.0f);
+    conv_ok = conv_ok && padded_check(&dstf, ref);
+
+    simd_blur_gray_3x3_view(&src.view, &dst.view);
+    simd_blur_gray_3x3(sp, ref, w, h);
+    conv_ok = conv_ok && padded_check(&dst, ref);
+
+    test_suite_add_result(suite, "Image - Convolution Views", conv_ok, conv_ok ? "u8/f32, direct/separable, box" : "Mismatch");
+
+    // Gradient planes of different element sizes, one of them skipped
+    padded_t gx = padded_create(w, h, 1, sizeof(int16_t));
+    padded_t mag = padded_create(w, h, 1, sizeof(uint16_t));
+    int16_t* gxp = (int16_t*)neon_malloc((size_t)w * h * sizeof(int16_t));
+    uint16_t* magp = (uint16_t*)neon_malloc((size_t)w * h * sizeof(uint16_t));
+    uint8_t* orip = (uint8_t*)neon_malloc((size_t)w * h);
+
+    simd_gradient_view(&src.view, SIMD_GRADIENT_SCHARR, SIMD_BORDER_REFLECT, 0,
+                       &gx.view, NULL, &mag.view, SIMD_MAGNITUDE_L2, &dst.view, 8);
+    simd_gradient(sp, w, h, SIMD_GRADIENT_SCHARR, SIMD_BORDER_REFLECT, 0,
+                  gxp, NULL, magp, SIMD_MAGNITUDE_L2, orip, 8);
+    grad_ok = padded_check(&gx, (uint8_t*)gxp) && padded_check(&mag, (uint8_t*)magp) && padded_check(&dst, orip);
+
+    simd_canny_view(&src.view, &dst.view, 100, 300, SIMD_MAGNITUDE_L1, 3);
+    simd_canny(sp, ref, w, h, 100, 300, SIMD_MAGNITUDE_L1, 3);
+    grad_ok = grad_ok && padded_check(&dst, ref);
+
+    test_suite_add_result(suite, "Image - Gradient Views", grad_ok, grad_ok ? "Gradient planes and Canny" : "Mismatch");
+
+    padded_destroy(&src);
+    padded_destroy(&dst);
+    padded_destroy(&srcf);
+    padded_destroy(&dstf);
+    padded_destroy(&gx);
+    padded_destroy(&mag);
+    free(sp);
+    free(sfp);
+    free(ref);
+    free(gxp);
+    free(magp);
+    free(orip);
+}
+
+// Test integral images of an ROI against its packed copy
+void test_image_integral(test_suite_t* suite) {
+    const int w = 33, h = 14;
+    size_t n = (size_t)(w + 1) * (h + 1);
+    padded_t src = padded_create(w, h, 1, 1);
+    padded_t srcf = padded_create(w, h, 1, sizeof(float));
+    padded_fill(&src, 4);
+    padded_fill(&srcf, 5);
+    uint8_t* sp = padded_pack(&src);
+    float* sfp = (float*)padded_pack(&srcf);
+
+    uint32_t* sum = (uint32_t*)neon_malloc(n * sizeof(uint32_t));
+    uint32_t* sum_ref = (uint32_t*)neon_malloc(n * sizeof(uint32_t));
+    uint64_t* sq = (uint64_t*)neon_malloc(n * sizeof(uint64_t));
+    uint64_t* sq_ref = (uint64_t*)neon_malloc(n * sizeof(uint64_t));
+    double* fsum = (double*)neon_malloc(n * sizeof(double));
+    double* fsum_ref = (double*)neon_malloc(n * sizeof(double));
+    double* fsq = (double*)neon_malloc(n * sizeof(double));
+    double* fsq_ref = (double*)neon_malloc(n * sizeof(double));
+
+    simd_integral_sq_u8_view(&src.view, sum, sq);
+    simd_integral_sq_u8(sp, sum_ref, sq_ref, w, h);
+    bool passed = memcmp(sum, sum_ref, n * sizeof(uint32_t)) == 0 && memcmp(sq, sq_ref, n * sizeof(uint64_t)) == 0;
+
+    simd_integral_u8_view(&src.view, sum);
+    passed = passed && memcmp(sum, sum_ref, n * sizeof(uint32_t)) == 0;
+
+    simd_integral_sq_f32_view(&srcf.view, fsum, fsq);
+    simd_integral_sq_f32(sfp, fsum_ref, fsq_ref, w, h);
+    passed = passed && memcmp(fsum, fsum_ref, n * sizeof(double)) == 0 && memcmp(fsq, fsq_ref, n * sizeof(double)) == 0;
+
+    simd_integral_f32_view(&srcf.view, fsum);
+    passed = passed && memcmp(fsum, fsum_ref, n * sizeof(double)) == 0;
+    passed = passed && padded_check(&src, sp);
+
+    test_suite_add_result(suite, "Image - Integral Views", passed, passed ? "u8 and f32 sources" : "Mismatch");
+
+    padded_destroy(&src);
+    padded_destroy(&srcf);
+    free(sp);
+    free(sfp);
+    free(sum);
+    free(sum_ref);
+    free(sq);
+    free(sq_ref);
+    free(fsum);
+    free(fsum_ref);
+    free(fsq);
+    free(fsq_ref);
+}
+
+// Test the resize family for 1, 3 and 4 channels
+void test_image_resize(test_suite_t* suite) {
+    static const int channels[] = { 1, 3, 4 };
+    const int w = 41, h = 17;
+    bool passed = true;
+
+    for (int k = 0; k < 3; k++) {
+        int c = channels[k];
+        padded_t src = padded_create(w, h, c, 1);
+        padded_fill(&src, 6 + (uint32_t)c);
+        uint8_t* sp = padded_pack(&src);
+        uint8_t* ref = (uint8_t*)neon_malloc((size_t)(2 * w) * (2 * h) * c);
+
+        padded_t half = padded_create(w / 2, h / 2, c, 1);
+        simd_downsample2x_u8_view(&src.view, &half.view);
+        simd_downsample2x_u8(sp, ref, w, h, c);
+        passed = passed && padded_check(&half, ref);
+
+        padded_t down = padded_create((w + 1) / 2, (h + 1) / 2, c, 1);
+        simd_pyr_down_u8_view(&src.view, &down.view);
+        simd_pyr_down_u8(sp, ref, w, h, c);
+        passed = passed && padded_check(&down, ref);
+
+        padded_t up = padded_create(2 * w, 2 * h, c, 1);
+        simd_pyr_up_u8_view(&src.view, &up.view);
+        simd_pyr_up_u8(sp, ref, w, h, c);
+        passed = passed && padded_check(&up, ref);
+
+        padded_t other = padded_create(29, 23, c, 1);
+        simd_resize_u8_view(&src.view, &other.view, SIMD_RESIZE_BILINEAR);
+        simd_resize_u8(sp, ref, w, h, 29, 23, c, SIMD_RESIZE_BILINEAR);
+        passed = passed && padded_check(&other, ref);
+
+        simd_resize_u8_view(&src.view, &half.view, SIMD_RESIZE_AREA);
+        simd_resize_u8(sp, ref, w, h, w / 2, h / 2, c, SIMD_RESIZE_AREA);
+        passed = passed && padded_check(&half, ref);
+
+        padded_destroy(&src);
+        padded_destroy(&half);
+        padded_destroy(&down);
+        padded_destroy(&up);
+        padded_destroy(&other);
+        free(sp);
+        free(ref);
+    }
+
+    test_suite_add_result(suite, "Image - Resize Views", passed, passed ? "2x, pyramids, bilinear, area" : "Mismatch");
+}
+
+// Test morphology and median filters for every code path
+void test_image_rank(test_suite_t* suite) {
+    static const simd_morph_op_t ops[] = { SIMD_MORPH_ERODE, SIMD_MORPH_OPEN, SIMD_MORPH_GRADIENT,
+                                           SIMD_MORPH_TOPHAT, SIMD_MORPH_BLACKHAT };
+    const int w = 53, h = 37;
+    padded_t src = padded_create(w, h, 1, 1);
+    padded_t dst = padded_create(w, h, 1, 1);
+    padded_fill(&src, 7);
+    uint8_t* sp = padded_pack(&src);
+    uint8_t* ref = (uint8_t*)neon_malloc((size_t)w * h);
+
+    bool morph_ok = true;
+    for (int i = 0; i < 5; i++) {
+        int kw = 1 + 2 * i, kh = 5 - i;
+        simd_morphology_u8_view(&src.view, &dst.view, ops[i], kw, kh, 3);
+        simd_morphology_u8(sp, ref, w, h, ops[i], kw, kh, 3);
+        morph_ok = morph_ok && padded_check(&dst, ref);
+    }
+    test_suite_add_result(suite, "Image - Morphology Views", morph_ok, morph_ok ? "All ops, 3 threads" : "Mismatch");
+
+    bool median_ok = true;
+    static const int radii[] = { 1, 2, 4 };
+    for (int i = 0; i < 3; i++) {
+        simd_median_u8_view(&src.view, &dst.view, radii[i], 2);
+        simd_median_u8(sp, ref, w, h, radii[i], 2);
+        median_ok = median_ok && padded_check(&dst, ref);
+    }
+    test_suite_add_result(suite, "Image - Median Views", median_ok, median_ok ? "Radius 1, 2 and 4" : "Mismatch");
+
+    padded_destroy(&src);
+    padded_destroy(&dst);
+    free(sp);
+    free(ref);
+}
+
+// Test the per-pixel LUT and blending views
+void test_image_pointwise(test_suite_t* suite) {
+    const int w = 31, h = 9;
+    size_t n = (size_t)w * h;
+    padded_t src = padded_create(w, h, 3, 1);
+    padded_t dst = padded_create(w, h, 3, 1);
+    padded_fill(&src, 8);
+    uint8_t* sp = padded_pack(&src);
+    uint8_t* ref = (uint8_t*)neon_malloc(n * 4);
+
+    uint8_t luts[3 * 256];
+    simd_lut_gamma(luts, 0.5f);
+    simd_lut_gamma(luts + 256, 2.2f);
+    simd_lut_linear(luts + 512, 1.5f, -20.0f);
+
+    simd_lut_u8_view(&src.view, luts, &dst.view);
+    simd_lut_u8(sp, luts, ref, n * 3);
+    bool passed = padded_check(&dst, ref);
+
+    simd_lut_channels_u8_view(&src.view, luts, &dst.view);
+    simd_lut_channels_u8(sp, luts, ref, n, 3);
+    passed = passed && padded_check(&dst, ref);
+
+    simd_threshold_u8_view(&src.view, 100, 200, &dst.view);
+    simd_threshold_u8(sp, 100, 200, ref, n * 3);
+    passed = passed && padded_check(&dst, ref);
+
+    // In place
+    simd_lut_u8_view(&src.view, luts + 256, &src.view);
+    simd_lut_u8(sp, luts + 256, ref, n * 3);
+    passed = passed && padded_check(&src, ref);
+
+    padded_t fg = padded_create(w, h, 4, 1);
+    padded_t bg = padded_create(w, h, 4, 1);
+    padded_t out = padded_create(w, h, 4, 1);
+    padded_fill(&fg, 9);
+    padded_fill(&bg, 10);
+    uint8_t* fgp = padded_pack(&fg);
+    uint8_t* bgp = padded_pack(&bg);
+
+    simd_blend_over_rgba_view(&fg.view, &bg.view, &out.view);
+    simd_blend_over_rgba(fgp, bgp, ref, n);
+    passed = passed && padded_check(&out, ref);
+
+    simd_blend_over_premul_rgba_view(&fg.view, &bg.view, &out.view);
+    simd_blend_over_premul_rgba(fgp, bgp, ref, n);
+    passed = passed && padded_check(&out, ref);
+
+    simd_crossfade_rgba_view(&fg.view, &bg.view, 77, &out.view);
+    simd_crossfade_rgba(fgp, bgp, 77, ref, n);
+    passed = passed && padded_check(&out, ref);
+
+    simd_premultiply_rgba_view(&fg.view, &out.view);
+    simd_premultiply_rgba(fgp, ref, n);
+    passed = passed && padded_check(&out, ref);
+
+    simd_composite_rgba_view(&fg.view, &bg.view, SIMD_COMPOSITE_XOR, &out.view);
+    simd_composite_rgba(fgp, bgp, SIMD_COMPOSITE_XOR, ref, n);
+    passed = passed && padded_check(&out, ref);
+
+    test_suite_add_result(suite, "Image - Pointwise Views", passed, passed ? "LUTs, threshold, blending" : "Mismatch");
+
+    padded_destroy(&src);
+    padded_destroy(&dst);
+    padded_destroy(&fg);
+    padded_destroy(&bg);
+    padded_destroy(&out);
+    free(sp);
+    free(ref);
+    free(fgp);
+    free(bgp);
+}
+
+// Test tiled execution on views: in-place interior tiles and staged edges
+void test_image_tiles(test_suite_t* suite) {
+    const int w = 70, h = 41;
+    padded_t src = padded_create(w, h, 1, 1);
+    padded_t dst = padded_create(w, h, 1, 1);
+    padded_fill(&src, 11);
+    uint8_t* sp = padded_pack(&src);
+    uint8_t* ref = (uint8_t*)neon_malloc((size_t)w * h);
+
+    bool passed = true;
+    static const simd_border_t borders[] = { SIMD_BORDER_REPLICATE, SIMD_BORDER_CONSTANT };
+    for (int b = 0; b < 2; b++) {
+        simd_tiling_t tiling = { .halo = 1, .border = borders[b], .border_value = 3,
+                                 .tile_width = 16, .tile_height = 8, .threads = 3 };
+        int tiles = simd_tile_run_view(&src.view, &dst.view, &tiling, simd_tile_sobel_u8, NULL);
+        simd_tile_run(sp, ref, w, h, &tiling, simd_tile_sobel_u8, NULL);
+        passed = passed && tiles > 0 && padded_check(&dst, ref);
+    }
+
+    // Mismatched views run nothing
+    simd_tiling_t tiling = { .halo = 1 };
+    simd_image_t small = simd_image_roi(&dst.view, 0, 0, w - 1, h, 1);
+    passed = passed && simd_tile_run_view(&src.view, &small, &tiling, simd_tile_box3x3_u8, NULL) == 0;
+    test_suite_add_result(suite, "Image - Tiled Views", passed, passed ? "Sobel, two borders" : "Mismatch");
+
+    padded_destroy(&src);
+    padded_destroy(&dst);
+    free(sp);
+    free(ref);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for strided image views...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Strided Image Views");
+
+    // Run tests
+    test_image_helpers(suite);
+    test_image_color(suite);
+    test_image_filters(suite);
+    test_image_integral(suite);
+    test_image_resize(suite);
+    test_image_rank(suite);
+    test_image_pointwise(suite);
+    test_image_tiles(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * test_integral_ops.c
+ * Unit tests for integral images and rectangle queries
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_integral.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static const int widths[] = { 1, 5, 16, 37, 64, 100 };
+
+// Test 8-bit sums and squared sums against a direct double loop
+void test_integral_u8(test_suite_t* suite) {
+    const int height = 23;
+    bool passed = true;
+    bool sq_passed = true;
+
+    for (int w = 0; w < 6; w++) {
+        int width = widths[w];
+        size_t table = (size_t)(width + 1) * (height + 1);
+        uint8_t* src = (uint8_t*)neon_malloc((size_t)width * height);
+        uint32_t* sum = (uint32_t*)neon_malloc(table * sizeof(uint32_t));
+        uint32_t* sum2 = (uint32_t*)neon_malloc(table * sizeof(uint32_t));
+        uint64_t* sqsum = (uint64_t*)neon_malloc(table * sizeof(uint64_t));
+
+        for (int i = 0; i < width * height; i++) src[i] = (uint8_t)(i % 7 == 0 ? 255 : (i * 131) & 0xFF);
+
+        memset(sum, 0xAB, table * sizeof(uint32_t));
+        simd_integral_u8(src, sum, width, height);
+        simd_integral_sq_u8(src, sum2, sqsum, width, height);
+
+        for (int y = 0; y <= height; y++) {
+            for (int x = 0; x <= width; x++) {
+                uint64_t s = 0, sq = 0;
+                for (int j = 0; j < y; j++) {
+                    for (int i = 0; i < x; i++) {
+                        s += src[j * width + i];
+                        sq += (uint64_t)src[j * width + i] * src[j * width + i];
+                    }
+                }
+                size_t k = (size_t)y * (width + 1) + x;
+                if (sum[k] != s || sum2[k] != s) passed = false;
+                if (sqsum[k] != sq) sq_passed = false;
+            }
+        }
+
+        free(src);
+        free(sum);
+        free(sum2);
+        free(sqsum);
+    }
+
+    test_suite_add_result(suite, "Integral U8", passed, passed ? "Matches reference" : "Mismatch");
+    test_suite_add_result(suite, "Integral U8 - Squared", sq_passed, sq_passed ? "Matches reference" : "Mismatch");
+}
+
+// Test float tables; quarter-integer inputs keep every partial sum exact
+void test_integral_f32(test_suite_t* suite) {
+    const int height = 19;
+    bool passed = true;
+
+    for (int w = 0; w < 6; w++) {
+        int width = widths[w];
+        size_t table = (size_t)(width + 1) * (height + 1);
+        float* src = (float*)neon_malloc((size_t)width * height * sizeof(float));
+        double* sum = (double*)neon_malloc(table * sizeof(double));
+        double* sum2 = (double*)neon_malloc(table * sizeof(double));
+        double* sqsum = (double*)neon_malloc(table * sizeof(double));
+
+        for (int i = 0; i < width * height; i++) src[i] = (float)((i * 37) % 29 - 14) * 0.25f;
+
+        simd_integral_f32(src, sum, width, height);
+        simd_integral_sq_f32(src, sum2, sqsum, width, height);
+
+        for (int y = 0; y <= height; y++) {
+            for (int x = 0; x <= width; x++) {
+                double s = 0.0, sq = 0.0;
+                for (int j = 0; j < y; j++) {
+                    for (int i = 0; i < x; i++) {
+                        double v = src[j * width + i];
+                        s += v;
+                        sq += v * v;
+                    }
+                }
+                size_t k = (size_t)y * (width + 1) + x;
+                if (sum[k] != s || sum2[k] != s || sqsum[k] != sq) passed = false;
+            }
+        }
+
+        free(src);
+        free(sum);
+        free(sum2);
+        free(sqsum);
+    }
+
+    test_suite_add_result(suite, "Integral F32", passed, passed ? "Sums and squared sums exact" : "Mismatch");
+}
+
+// Test rectangle sum/mean/variance queries against brute force
+void test_rect_queries(test_suite_t* suite) {
+    const int width = 53;
+    const int height = 31;
+    size_t table = (size_t)(width + 1) * (height + 1);
+    uint8_t* src = (uint8_t*)neon_malloc((size_t)width * height);
+    float* fsrc = (float*)neon_malloc((size_t)width * height * sizeof(float));
+    uint32_t* sum = (uint32_t*)neon_malloc(table * sizeof(uint32_t));
+    uint64_t* sqsum = (uint64_t*)neon_malloc(table * sizeof(uint64_t));
+    double* fsum = (double*)neon_malloc(table * sizeof(double));
+    double* fsqsum = (double*)neon_malloc(table * sizeof(double));
+
+    for (int i = 0; i < width * height; i++) {
+        src[i] = (uint8_t)((i * 97 + (i / width) * 13) & 0xFF);
+        fsrc[i] = sinf((float)i * 0.1f) * 3.0f;
+    }
+    simd_integral_sq_u8(src, sum, sqsum, width, height);
+    simd_integral_sq_f32(fsrc, fsum, fsqsum, width, height);
+
+    static const int rects[][4] = {
+        { 0, 0, 53, 31 }, { 3, 4, 1, 1 }, { 10, 2, 17, 9 }, { 52, 30, 1, 1 }, { 0, 5, 40, 26 }
+    };
+
+    bool passed = true;
+    for (int r = 0; r < 5; r++) {
+        int x = rects[r][0], y = rects[r][1], w = rects[r][2], h = rects[r][3];
+        double s = 0.0, sq = 0.0, fs = 0.0, fsq = 0.0;
+        for (int j = y; j < y + h; j++) {
+            for (int i = x; i < x + w; i++) {
+                s += src[j * width + i];
+                sq += (double)src[j * width + i] * src[j * width + i];
+                fs += fsrc[j * width + i];
+                fsq += (double)fsrc[j * width + i] * fsrc[j * width + i];
+            }
+        }
+        double n = (double)w * h;
+        double var = sq / n - (s / n) * (s / n);
+        double fvar = fsq / n - (fs / n) * (fs / n);
+
+        if (simd_integral_rect_sum_u32(sum, width, x, y, w, h) != (uint32_t)s) passed = false;
+        if (fabs(simd_integral_rect_mean_u8(sum, width, x, y, w, h) - s / n) > 1e-9) passed = false;
+        if (fabs(simd_integral_rect_variance_u8(sum, sqsum, width, x, y, w, h) - var) > 1e-6) passed = false;
+        if (fabs(simd_integral_rect_mean_f64(fsum, width, x, y, w, h) - fs / n) > 1e-9) passed = false;
+        if (fabs(simd_integral_rect_variance_f64(fsum, fsqsum, width, x, y, w, h) - (fvar > 0 ? fvar : 0)) > 1e-6) {
+            passed = false;
+        }
+    }
+    test_suite_add_result(suite, "Rectangle Queries", passed,
+                          passed ? "Sum, mean and variance correct" : "Query mismatch");
+
+    free(src);
+    free(fsrc);
+    free(sum);
+    free(sqsum);
+    free(fsum);
+    free(fsqsum);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for integral images...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Integral Image Operations");
+
+    // Run tests
+    test_integral_u8(suite);
+    test_integral_f32(suite);
+    test_rect_queries(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * test_interleave_ops.c
+ * Unit tests for interleave/deinterleave (zip/unzip) kernels
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_ops.h"
+#include "../include/simd_interleave.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Test the even/odd interleave operations from simd_ops.h
+void test_interleave_even_odd(test_suite_t* suite) {
+    const size_t test_size = 38;  // Vector body plus a remainder
+
+    float a[38], b[38], c[38], expected[38];
+    for (size_t i = 0; i < test_size; i++) {
+        a[i] = (float)i;
+        b[i] = 100.0f + (float)i;
+    }
+
+    // Even: [A[0], B[0], A[2], B[2], ...]
+    for (size_t k = 0; k < test_size / 2; k++) {
+        expected[k * 2] = a[k * 2];
+        expected[k * 2 + 1] = b[k * 2];
+    }
+    simd_interleave_even_f32(a, b, c, test_size);
+    ASSERT_FLOAT_ARRAY_EQ(suite, "Interleave Even", c, expected, (int)test_size, 0.0f);
+
+    // Odd: [A[1], B[1], A[3], B[3], ...]
+    for (size_t k = 0; k < test_size / 2; k++) {
+        expected[k * 2] = a[k * 2 + 1];
+        expected[k * 2 + 1] = b[k * 2 + 1];
+    }
+    simd_interleave_odd_f32(a, b, c, test_size);
+    ASSERT_FLOAT_ARRAY_EQ(suite, "Interleave Odd", c, expected, (int)test_size, 0.0f);
+}
+
+// Test zip/unzip for 2, 3 and 4 channels of float
+void test_zip_unzip_f32(test_suite_t* suite) {
+    const size_t len = 103;
+
+    float* planes[4];
+    float* back[4];
+    float* packed = (float*)neon_malloc(len * 4 * sizeof(float));
+    float* expected = (float*)neon_malloc(len * 4 * sizeof(float));
+    for (int c = 0; c < 4; c++) {
+        planes[c] = (float*)neon_malloc(len * sizeof(float));
+        back[c] = (float*)neon_malloc(len * sizeof(float));
+        for (size_t i = 0; i < len; i++) planes[c][i] = (float)(c * 1000 + i);
+    }
+
+    static const char* zip_names[] = { "Zip2 F32", "Zip3 F32", "Zip4 F32" };
+    static const char* unzip_names[] = { "Unzip2 F32", "Unzip3 F32", "Unzip4 F32" };
+
+    for (int k = 2; k <= 4; k++) {
+        for (size_t i = 0; i < len; i++) {
+            for (int c = 0; c < k; c++) expected[i * k + c] = planes[c][i];
+        }
+
+        if (k == 2) simd_zip2_f32(planes[0], planes[1], packed, len);
+        if (k == 3) simd_zip3_f32(planes[0], planes[1], planes[2], packed, len);
+        if (k == 4) simd_zip4_f32(planes[0], planes[1], planes[2], planes[3], packed, len);
+        ASSERT_FLOAT_ARRAY_EQ(suite, zip_names[k - 2], packed, expected, (int)(len * k), 0.0f);
+
+        if (k == 2) simd_unzip2_f32(packed, back[0], back[1], len);
+        if (k == 3) simd_unzip3_f32(packed, back[0], back[1], back[2], len);
+        if (k == 4) simd_unzip4_f32(packed, back[0], back[1], back[2], back[3], len);
+
+        bool passed = true;
+        for (int c = 0; c < k; c++) {
+            if (memcmp(back[c], planes[c], len * sizeof(float)) != 0) passed = false;
+        }
+        test_suite_add_result(suite, unzip_names[k - 2], passed,
+                              passed ? "Planes round-trip" : "Planes differ");
+    }
+
+    for (int c = 0; c < 4; c++) {
+        free(planes[c]);
+        free(back[c]);
+    }
+    free(packed);
+    free(expected);
+}
+
+// Test zip/unzip round trips for int16 and uint8
+void test_zip_unzip_integer(test_suite_t* suite) {
+    const size_t len = 77;
+
+    int16_t s[4][77], s_back[4][77], s_packed[77 * 4];
+    uint8_t u[4][77], u_back[4][77], u_packed[77 * 4];
+    for (int c = 0; c < 4; c++) {
+        for (size_t i = 0; i < len; i++) {
+            s[c][i] = (int16_t)(c * 1000 - (int)i);
+            u[c][i] = (uint8_t)(c * 50 + i);
+        }
+    }
+
+    simd_zip3_s16(s[0], s[1], s[2], s_packed, len);
+    bool passed = true;
+    for (size_t i = 0; i < len; i++) {
+        for (int c = 0; c < 3; c++) if (s_packed[i * 3 + c] != s[c][i]) passed = false;
+    }
+    simd_unzip3_s16(s_packed, s_back[0], s_back[1], s_back[2], len);
+    for (int c = 0; c < 3; c++) if (memcmp(s_back[c], s[c], sizeof(s[c])) != 0) passed = false;
+    test_suite_add_result(suite, "Zip/Unzip3 S16", passed, passed ? "Round-trip exact" : "Mismatch");
+
+    simd_zip4_u8(u[0], u[1], u[2], u[3], u_packed, len);
+    passed = true;
+    for (size_t i = 0; i < len; i++) {
+        for (int c = 0; c < 4; c++) if (u_packed[i * 4 + c] != u[c][i]) passed = false;
+    }
+    simd_unzip4_u8(u_packed, u_back[0], u_back[1], u_back[2], u_back[3], len);
+    for (int c = 0; c < 4; c++) if (memcmp(u_back[c], u[c], sizeof(u[c])) != 0) passed = false;
+    test_suite_add_result(suite, "Zip/Unzip4 U8", passed, passed ? "Round-trip exact" : "Mismatch");
+
+    simd_zip2_u8(u[0], u[1], u_packed, len);
+    simd_unzip2_u8(u_packed, u_back[0], u_back[1], len);
+    passed = memcmp(u_back[0], u[0], len) == 0 && memcmp(u_back[1], u[1], len) == 0;
+    test_suite_add_result(suite, "Zip/Unzip2 U8", passed, passed ? "Round-trip exact" : "Mismatch");
+}
+
+// Test complex interleaved <-> split conversions
+void test_complex_conversions(test_suite_t* suite) {
+    const size_t n = 29;
+
+    int16_t iq[29 * 2], iq_back[29 * 2];
+    float re[29], im[29], re_expected[29], im_expected[29];
+    const float scale = 1.0f / 32768.0f;
+
+    for (size_t i = 0; i < n; i++) {
+        iq[i * 2] = (int16_t)(i * 1000 - 14000);
+        iq[i * 2 + 1] = (int16_t)(14000 - i * 997);
+        re_expected[i] = iq[i * 2] * scale;
+        im_expected[i] = iq[i * 2 + 1] * scale;
+    }
+
+    simd_complex_split_s16_f32(iq, re, im, scale, n);
+    ASSERT_FLOAT_ARRAY_EQ(suite, "Complex Split S16->F32 (re)", re, re_expected, (int)n, 1e-7f);
+    ASSERT_FLOAT_ARRAY_EQ(suite, "Complex Split S16->F32 (im)", im, im_expected, (int)n, 1e-7f);
+
+    simd_complex_merge_f32_s16(re, im, iq_back, 32768.0f, n);
+    ASSERT_ARRAY_EQ(suite, "Complex Merge F32->S16", iq_back, iq, (int)(n * 2), int16_t, "%d");
+
+    // Saturation on overflow
+    float big[8] = { 2.0f, -2.0f, 0.5f, -0.5f, 1.5f, -1.5f, 0.0f, 1.0f };
+    int16_t sat[16];
+    simd_complex_merge_f32_s16(big, big, sat, 32768.0f, 8);
+    bool passed = sat[0] == INT16_MAX && sat[2] == INT16_MIN && sat[4] == 16384 && sat[14] == INT16_MAX;
+    test_suite_add_result(suite, "Complex Merge - Saturation", passed,
+                          passed ? "Out-of-range values saturate" : "Saturation incorrect");
+
+    float iqf[29 * 2], iqf_back[29 * 2];
+    for (size_t i = 0; i < n * 2; i++) iqf[i] = (float)i * 0.5f;
+    simd_complex_split_f32(iqf, re, im, n);
+    simd_complex_merge_f32(re, im, iqf_back, n);
+    ASSERT_FLOAT_ARRAY_EQ(suite, "Complex Split/Merge F32", iqf_back, iqf, (int)(n * 2), 0.0f);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for interleave operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Interleave Operations");
+
+    // Run tests
+    test_interleave_even_odd(suite);
+    test_zip_unzip_f32(suite);
+    test_zip_unzip_integer(suite);
+    test_complex_conversions(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
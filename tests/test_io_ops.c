@@ -0,0 +1,257 @@
+/**
+ * test_io_ops.c
+ * Unit tests for memory-mapped PGM/PPM and raw array files and the
+ * double-buffered streaming reader
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/simd_io.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Fresh temporary file name in PATH (the file exists, empty)
+static void temp_path(char* path, size_t size) {
+    snprintf(path, size, "/tmp/test_io_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd >= 0) close(fd);
+}
+
+static uint8_t* make_bytes(size_t n, uint32_t seed) {
+    uint8_t* data = (uint8_t*)neon_malloc(n);
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = (uint8_t)(seed >> 24);
+    }
+    return data;
+}
+
+// Test PGM/PPM writing from strided views and zero-copy mapping
+void test_pnm_map(test_suite_t* suite) {
+    char path[64];
+    temp_path(path, sizeof(path));
+
+    for (int channels = 1; channels <= 3; channels += 2) {
+        const int width = 37, height = 23, pitch = 64;
+        uint8_t* frame = make_bytes((size_t)pitch * channels * height, 7u + channels);
+        simd_image_t src = simd_image_make(frame, width, height, (size_t)pitch * channels, channels);
+
+        bool passed = simd_pnm_write(path, &src);
+        simd_mapped_t file;
+        simd_image_t img;
+        passed = passed && simd_pnm_map(path, &file, &img);
+        if (passed) {
+            passed = img.width == width && img.height == height && img.channels == channels &&
+                     simd_image_is_packed(&img, 1) && img.data > file.data &&
+                     img.data + (size_t)img.stride * height == file.data + file.size;
+            for (int y = 0; passed && y < height; y++) {
+                passed = memcmp(simd_image_row(&img, y), simd_image_row(&src, y), simd_image_row_bytes(&img, 1)) == 0;
+            }
+
+            // Copy-on-write: writes through the mapping do not reach the file
+            img.data[0] ^= 0xFF;
+            simd_unmap_file(&file);
+            passed = passed && simd_pnm_map(path, &file, &img) && img.data[0] == frame[0];
+            simd_unmap_file(&file);
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "IO - PNM Map %s", channels == 1 ? "P5" : "P6");
+        test_suite_add_result(suite, name, passed, passed ? "Strided write, copy-on-write map" : "Mapped pixels differ");
+        free(frame);
+    }
+    unlink(path);
+}
+
+// Test header parsing: comments, whitespace and rejected inputs
+void test_pnm_parse(test_suite_t* suite) {
+    static const char good[] = "P5 # comment\n# another\n 4\t2\r\n255\nABCDEFGH";
+    simd_image_t img;
+    size_t header = simd_pnm_parse((const uint8_t*)good, sizeof(good) - 1, &img);
+    bool passed = header == sizeof(good) - 9 && img.width == 4 && img.height == 2 && img.channels == 1 &&
+                  img.stride == 4 && img.data[0] == 'A' && img.data[7] == 'H';
+    test_suite_add_result(suite, "IO - PNM Header Comments", passed,
+                          passed ? "Fields and pixel offset" : "Header fields or pixel offset wrong");
+
+    static const char* bad[] = {
+        "P5\n4 2\n255\nABCDEFG",        // One pixel short
+        "P2\n4 2\n255\nABCDEFGH",       // ASCII format
+        "P5\n4 2\n65535\nABCDEFGHIJKLMNOP", // 16-bit samples
+        "P5\n0 2\n255\n",               // Empty image
+        "P5\n4 -2\n255\nABCDEFGH",      // Negative size
+        "P6\n4 2\n255",                 // Truncated header
+        "P5 4 2 255XABCDEFGH",          // No whitespace before the pixels
+    };
+    passed = true;
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        if (simd_pnm_parse((const uint8_t*)bad[i], strlen(bad[i]), &img) != 0) passed = false;
+    }
+    test_suite_add_result(suite, "IO - PNM Invalid Headers", passed, passed ? "Rejected" : "Accepted");
+}
+
+// Test raw f32 arrays and mapping failures
+void test_raw_map(test_suite_t* suite) {
+    char path[64];
+    temp_path(path, sizeof(path));
+
+    const size_t n = 1003;
+    float* values = (float*)neon_malloc(n * sizeof(float));
+    for (size_t i = 0; i < n; i++) values[i] = (float)i * 0.25f - 100.0f;
+
+    simd_mapped_t file = { NULL, 0 };
+    size_t count = 0;
+    bool passed = simd_raw_write(path, values, n * sizeof(float)) && simd_map_file(path, &file);
+    float* mapped = passed ? simd_mapped_f32(&file, &count) : NULL;
+    passed = mapped && count == n && memcmp(mapped, values, n * sizeof(float)) == 0;
+    if (file.data) simd_unmap_file(&file);
+    test_suite_add_result(suite, "IO - Raw f32 Map", passed, passed ? "1003 floats" : "Mapped array differs");
+
+    // Sizes that are not whole floats, empty and missing files
+    passed = simd_raw_write(path, values, 6) && simd_map_file(path, &file) && !simd_mapped_f32(&file, &count);
+    simd_unmap_file(&file);
+    passed = passed && simd_raw_write(path, values, 0) && !simd_map_file(path, &file) && !file.data;
+    unlink(path);
+    passed = passed && !simd_map_file(path, &file);
+    test_suite_add_result(suite, "IO - Raw Map Invalid Files", passed,
+                          passed ? "Rejected" : "Accepted");
+    free(values);
+}
+
+// Test that streamed chunks reassemble the file for several chunk sizes
+void test_stream_chunks(test_suite_t* suite) {
+    char path[64];
+    temp_path(path, sizeof(path));
+
+    const size_t size = 100000;
+    uint8_t* data = make_bytes(size, 42u);
+    uint8_t* joined = (uint8_t*)neon_malloc(size);
+    simd_raw_write(path, data, size);
+
+    static const size_t chunks[] = { 1, 7, 4096, 33333, 100000, 1 << 20 };
+    static const uint64_t offsets[] = { 0, 0, 0, 5, 0, 99999 };
+    bool passed = true;
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        simd_stream_t* stream = simd_stream_open(path, offsets[c], chunks[c]);
+        if (!stream) {
+            passed = false;
+            continue;
+        }
+        size_t total = 0, len, count = 0, expected = size - offsets[c];
+        const uint8_t* chunk;
+        while ((chunk = simd_stream_next(stream, &len)) != NULL) {
+            bool last = total + len == expected;
+            if (len == 0 || (len != chunks[c] && !last) || total + len > expected) {
+                passed = false;
+                break;
+            }
+            memcpy(joined + total, chunk, len);
+            total += len;
+            count++;
+        }
+        passed = passed && !simd_stream_failed(stream) && total == expected &&
+                 count == (expected + chunks[c] - 1) / chunks[c] &&
+                 memcmp(joined, data + offsets[c], expected) == 0;
+
+        // Past the end stays at the end
+        passed = passed && simd_stream_next(stream, &len) == NULL;
+        simd_stream_close(stream);
+    }
+    test_suite_add_result(suite, "IO - Stream Chunks", passed,
+                          passed ? "Chunk sizes 1 to 1 MiB, offsets" : "Chunks missing, reordered or wrongly sized");
+
+    // Closing early, before or while the reader fills buffers
+    simd_stream_t* stream = simd_stream_open(path, 0, 64);
+    size_t len;
+    passed = stream && simd_stream_next(stream, &len) && len == 64;
+    simd_stream_close(stream);
+    stream = simd_stream_open(path, 0, 64);
+    passed = passed && stream;
+    simd_stream_close(stream);
+    test_suite_add_result(suite, "IO - Stream Early Close", passed, passed ? "Reader stopped" : "Stream failed");
+
+    unlink(path);
+    passed = simd_stream_open(path, 0, 64) == NULL && simd_stream_open("/tmp", 0, 0) == NULL;
+    test_suite_add_result(suite, "IO - Stream Invalid Arguments", passed, passed ? "Rejected" : "Accepted");
+    free(data);
+    free(joined);
+}
+
+// Test row-band streaming of PGM/PPM pixels
+void test_stream_pnm(test_suite_t* suite) {
+    char path[64];
+    temp_path(path, sizeof(path));
+
+    const int width = 45, height = 31, rows = 8;
+    uint8_t* pixels = make_bytes((size_t)width * 3 * height, 9u);
+    simd_image_t src = simd_image_packed(pixels, width, height, 3, 1);
+    simd_pnm_write(path, &src);
+
+    simd_image_t format;
+    simd_stream_t* stream = simd_pnm_stream_open(path, rows, &format);
+    bool passed = stream && format.data == NULL && format.width == width && format.height == height &&
+                  format.channels == 3 && format.stride == (size_t)width * 3;
+
+    int y = 0;
+    size_t len;
+    const uint8_t* chunk;
+    while (passed && (chunk = simd_stream_next(stream, &len)) != NULL) {
+        int band = (int)(len / format.stride);
+        passed = len % format.stride == 0 && band == (height - y < rows ? height - y : rows) &&
+                 memcmp(chunk, pixels + (size_t)y * format.stride, len) == 0;
+        y += band;
+    }
+    passed = passed && y == height;
+    simd_stream_close(stream);
+    test_suite_add_result(suite, "IO - PNM Stream Bands", passed, passed ? "8-row bands" : "Row bands differ from the image");
+
+    // Trailing bytes (a second image) are not streamed as extra rows
+    FILE* f = fopen(path, "ab");
+    passed = f && fwrite("P5\n1 1\n255\nZ", 1, 13, f) == 13;
+    if (f) fclose(f);
+    stream = simd_pnm_stream_open(path, height, &format);
+    passed = passed && stream && simd_stream_next(stream, &len) && len == (size_t)height * format.stride &&
+             simd_stream_next(stream, &len) == NULL && !simd_stream_failed(stream);
+    simd_stream_close(stream);
+
+    // A file one byte short of the pixel rows is rejected
+    struct stat st;
+    simd_pnm_write(path, &src);
+    passed = passed && stat(path, &st) == 0 && truncate(path, st.st_size - 1) == 0 &&
+             simd_pnm_stream_open(path, rows, &format) == NULL;
+    test_suite_add_result(suite, "IO - PNM Stream Bounds", passed, passed ? "Trailing bytes ignored, short file rejected" :
+                          "Streamed past the pixels or accepted a short file");
+
+    simd_raw_write(path, "P7\n1 1\n255\nA", 12);
+    passed = simd_pnm_stream_open(path, rows, &format) == NULL;
+    unlink(path);
+    test_suite_add_result(suite, "IO - PNM Stream Invalid Header", passed, passed ? "Rejected" : "Accepted");
+    free(pixels);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for mapped and streamed file I/O...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("File I/O");
+
+    // Run tests
+    test_pnm_map(suite);
+    test_pnm_parse(suite);
+    test_raw_map(suite);
+    test_stream_chunks(suite);
+    test_stream_pnm(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * test_knn_ops.c
+ * Unit tests for brute-force k-nearest-neighbor search: top-k selection,
+ * the three metrics, quantized storage and multi-threaded queries
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/simd_knn.h"
+#include "../include/simd_sched.h"
+#include "../include/test_framework.h"
+
+#define DIM 37
+#define COUNT 1001
+#define QUERIES 37
+#define K 10
+
+static void fill(float* v, size_t n, unsigned seed) {
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        v[i] = (float)((seed >> 16) & 0x7fff) / 16384.0f - 1.0f;
+    }
+}
+
+static void start_pool(int threads) {
+    simd_sched_config_t config = { threads, SIMD_AFFINITY_NONE, NULL, NULL };
+    simd_sched_init(&config);
+}
+
+// Exact score in double precision
+static double reference(const float* q, const float* x, simd_knn_metric_t metric) {
+    double dot = 0.0, qq = 0.0, xx = 0.0, l2 = 0.0;
+    for (int i = 0; i < DIM; i++) {
+        dot += (double)q[i] * x[i];
+        qq += (double)q[i] * q[i];
+        xx += (double)x[i] * x[i];
+        l2 += ((double)q[i] - x[i]) * ((double)q[i] - x[i]);
+    }
+    if (metric == SIMD_KNN_L2) return l2;
+    if (metric == SIMD_KNN_COSINE) return dot / sqrt(qq * xx);
+    return dot;
+}
+
+// Every result holds its true score, and nothing better was left out
+static bool check_exact(const float* db, const float* queries, const int64_t* ids, const float* scores,
+                        simd_knn_metric_t metric) {
+    double sign = metric == SIMD_KNN_L2 ? 1.0 : -1.0;
+    for (int q = 0; q < QUERIES; q++) {
+        const float* qv = queries + q * DIM;
+        for (int r = 0; r < K; r++) {
+            int64_t id = ids[q * K + r];
+            if (id < 0 || id >= COUNT) return false;
+            double s = reference(qv, db + id * DIM, metric);
+            if (fabs(s - scores[q * K + r]) > 1e-4) return false;
+            if (r > 0 && sign * scores[q * K + r] < sign * scores[q * K + r - 1]) return false;
+        }
+        double last = sign * scores[q * K + K - 1];
+        int better = 0;
+        for (int i = 0; i < COUNT; i++) better += sign * reference(qv, db + i * DIM, metric) < last - 1e-4;
+        if (better > K - 1) return false;
+    }
+    return true;
+}
+
+// Test selection order, padding and ties of the bounded heap
+void test_select(test_suite_t* suite) {
+    float d[11] = { 5, 3, 9, 1, 7, 3, 8, 0, 6, 2, 4 };
+    int64_t ids[14];
+    float best[14];
+    simd_knn_select(d, ids, best, 11, 4);
+    bool passed = ids[0] == 7 && ids[1] == 3 && ids[2] == 9 && (ids[3] == 1 || ids[3] == 5) && best[3] == 3.0f;
+
+    simd_knn_select(d, ids, best, 11, 14);
+    static const float sorted[11] = { 0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9 };
+    for (int i = 0; i < 11; i++) passed &= best[i] == sorted[i];
+    passed &= ids[11] == -1 && ids[13] == -1 && isinf(best[12]);
+    test_suite_add_result(suite, "KNN - Top-k Select", passed, passed ? "Ascending, padded with -1" :
+                          "Wrong order or padding");
+}
+
+// Test each metric on f32 storage against double-precision scores
+void test_metrics(test_suite_t* suite) {
+    float* db = (float*)malloc(COUNT * DIM * sizeof(float));
+    float* queries = (float*)malloc(QUERIES * DIM * sizeof(float));
+    int64_t* ids = (int64_t*)malloc(QUERIES * K * sizeof(int64_t));
+    float* scores = (float*)malloc(QUERIES * K * sizeof(float));
+    fill(db, COUNT * DIM, 1);
+    fill(queries, QUERIES * DIM, 2);
+
+    static const simd_knn_metric_t metrics[] = { SIMD_KNN_L2, SIMD_KNN_INNER_PRODUCT, SIMD_KNN_COSINE };
+    bool passed = true;
+    for (int m = 0; m < 3; m++) {
+        simd_knn_index_t* index = simd_knn_create(DIM, metrics[m], SIMD_KNN_F32);
+        passed &= simd_knn_add(index, db, COUNT) && simd_knn_size(index) == COUNT;
+        passed &= simd_knn_search(index, queries, ids, scores, QUERIES, K);
+        passed &= check_exact(db, queries, ids, scores, metrics[m]);
+        simd_knn_destroy(index);
+    }
+    test_suite_add_result(suite, "KNN - L2, Inner Product, Cosine", passed, passed ? "Exact top-10 on f32 storage" :
+                          "Wrong neighbors");
+    free(db);
+    free(queries);
+    free(ids);
+    free(scores);
+}
+
+// Test f16 and int8 storage keep most of the exact neighbors in less memory
+void test_quantized(test_suite_t* suite) {
+    float* db = (float*)malloc(COUNT * DIM * sizeof(float));
+    float* queries = (float*)malloc(QUERIES * DIM * sizeof(float));
+    int64_t exact[QUERIES * K], ids[QUERIES * K];
+    float scores[QUERIES * K];
+    fill(db, COUNT * DIM, 3);
+    fill(queries, QUERIES * DIM, 4);
+
+    simd_knn_index_t* index = simd_knn_create(DIM, SIMD_KNN_L2, SIMD_KNN_F32);
+    simd_knn_add(index, db, COUNT);
+    simd_knn_search(index, queries, exact, scores, QUERIES, K);
+    simd_knn_destroy(index);
+
+    bool passed = true;
+    double recall[2];
+    for (int s = 0; s < 2; s++) {
+        simd_knn_storage_t storage = s == 0 ? SIMD_KNN_F16 : SIMD_KNN_INT8;
+        index = simd_knn_create(DIM, SIMD_KNN_L2, storage);
+        simd_knn_add(index, db, COUNT);
+        passed &= simd_knn_bytes(index) == (s == 0 ? COUNT * DIM * 2 : COUNT * DIM + COUNT * sizeof(float));
+        passed &= simd_knn_search(index, queries, ids, scores, QUERIES, K);
+        simd_knn_destroy(index);
+
+        int hits = 0;
+        for (int q = 0; q < QUERIES; q++) {
+            for (int i = 0; i < K; i++) {
+                for (int j = 0; j < K; j++) hits += ids[q * K + i] == exact[q * K + j];
+            }
+        }
+        recall[s] = (double)hits / (QUERIES * K);
+    }
+    passed &= recall[0] >= 0.98 && recall[1] >= 0.9;
+    test_suite_add_result(suite, "KNN - F16/Int8 Storage", passed, passed ? "Recall@10 within bounds" :
+                          "Low recall or wrong size");
+    free(db);
+    free(queries);
+}
+
+// Test several workers and several adds give the serial single-add results
+void test_threads(test_suite_t* suite) {
+    float* db = (float*)malloc(COUNT * DIM * sizeof(float));
+    float* queries = (float*)malloc(QUERIES * 4 * DIM * sizeof(float));
+    int64_t* ids[2];
+    float* scores[2];
+    fill(db, COUNT * DIM, 5);
+    fill(queries, QUERIES * 4 * DIM, 6);
+
+    bool passed = true;
+    for (int t = 0; t < 2; t++) {
+        start_pool(t == 0 ? 0 : 3);
+        ids[t] = (int64_t*)malloc(QUERIES * 4 * K * sizeof(int64_t));
+        scores[t] = (float*)malloc(QUERIES * 4 * K * sizeof(float));
+        simd_knn_index_t* index = simd_knn_create(DIM, SIMD_KNN_COSINE, SIMD_KNN_INT8);
+        if (t == 0) {
+            passed &= simd_knn_add(index, db, COUNT);
+        } else {
+            passed &= simd_knn_add(index, db, 400) && simd_knn_add(index, db + 400 * DIM, 0) &&
+                      simd_knn_add(index, db + 400 * DIM, COUNT - 400);
+        }
+        passed &= simd_knn_search(index, queries, ids[t], scores[t], QUERIES * 4, K);
+        simd_knn_destroy(index);
+    }
+    passed &= memcmp(ids[0], ids[1], QUERIES * 4 * K * sizeof(int64_t)) == 0 &&
+              memcmp(scores[0], scores[1], QUERIES * 4 * K * sizeof(float)) == 0;
+    test_suite_add_result(suite, "KNN - Threads", passed, passed ? "3 workers match the serial search" :
+                          "Results depend on workers");
+    for (int t = 0; t < 2; t++) {
+        free(ids[t]);
+        free(scores[t]);
+    }
+    free(db);
+    free(queries);
+}
+
+// Test an index smaller than k and invalid arguments
+void test_small(test_suite_t* suite) {
+    float db[3 * DIM], query[DIM];
+    int64_t ids[5];
+    float scores[5];
+    fill(db, 3 * DIM, 7);
+    memcpy(query, db + DIM, sizeof(query));
+
+    simd_knn_index_t* index = simd_knn_create(DIM, SIMD_KNN_INNER_PRODUCT, SIMD_KNN_F32);
+    simd_knn_add(index, db, 3);
+    bool passed = simd_knn_search(index, query, ids, scores, 1, 5);
+    passed &= ids[3] == -1 && ids[4] == -1 && isinf(scores[4]) && scores[4] < 0.0f;
+    passed &= scores[0] >= scores[1] && scores[1] >= scores[2];
+    passed &= !simd_knn_search(index, query, ids, scores, 1, 0) && simd_knn_create(0, SIMD_KNN_L2, SIMD_KNN_F32) == NULL;
+    simd_knn_destroy(index);
+    test_suite_add_result(suite, "KNN - Small Index", passed, passed ? "3 found, 2 padded" : "Wrong padding");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for k-nearest-neighbor search...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("K-Nearest-Neighbor Search");
+
+    // Run tests
+    test_select(suite);
+    test_metrics(suite);
+    test_quantized(suite);
+    test_threads(suite);
+    test_small(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+    simd_sched_shutdown();
+
+    return failed ? 1 : 0;
+}
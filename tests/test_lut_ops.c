@@ -0,0 +1,187 @@
+/**
+ * test_lut_ops.c
+ * Unit tests for lookup tables and point operations
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_lut.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static void fill_bytes(uint8_t* buf, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        buf[i] = (uint8_t)(seed >> 24);
+    }
+}
+
+// Test the table lookup against a scalar loop for lengths around the vector width
+void test_lut_apply(test_suite_t* suite) {
+    static const size_t lengths[] = { 0, 1, 15, 16, 17, 63, 64, 1000, 4099 };
+    uint8_t lut[256];
+    fill_bytes(lut, 256, 7);
+
+    bool passed = true;
+    for (int l = 0; l < 9; l++) {
+        size_t len = lengths[l];
+        uint8_t* src = (uint8_t*)neon_malloc(len + 1);
+        uint8_t* out = (uint8_t*)neon_malloc(len + 1);
+        fill_bytes(src, len, 11 + l);
+
+        simd_lut_u8(src, lut, out, len);
+        for (size_t i = 0; i < len; i++) {
+            if (out[i] != lut[src[i]]) passed = false;
+        }
+
+        // In place
+        simd_lut_u8(src, lut, src, len);
+        if (memcmp(src, out, len) != 0) passed = false;
+
+        free(src);
+        free(out);
+    }
+
+    // Every index reaches its own entry (covers all four 64-byte quarters)
+    uint8_t all[256], mapped[256];
+    for (int i = 0; i < 256; i++) all[i] = (uint8_t)i;
+    simd_lut_u8(all, lut, mapped, 256);
+    if (memcmp(mapped, lut, 256) != 0) passed = false;
+
+    test_suite_add_result(suite, "LUT - Apply", passed, passed ? "Matches scalar lookup" : "Mismatch");
+}
+
+// Test per-channel tables for interleaved gray, RGB and RGBA
+void test_lut_channels(test_suite_t* suite) {
+    static const int channel_counts[] = { 1, 3, 4 };
+    static const size_t pixel_counts[] = { 5, 16, 300, 1031 };
+    uint8_t luts[4 * 256];
+    fill_bytes(luts, sizeof(luts), 3);
+
+    bool passed = true;
+    for (int c = 0; c < 3; c++) {
+        int ch = channel_counts[c];
+        for (int p = 0; p < 4; p++) {
+            size_t len = pixel_counts[p] * ch;
+            uint8_t* src = (uint8_t*)neon_malloc(len);
+            uint8_t* out = (uint8_t*)neon_malloc(len);
+            fill_bytes(src, len, 21 + p);
+
+            simd_lut_channels_u8(src, luts, out, pixel_counts[p], ch);
+            for (size_t i = 0; i < len; i++) {
+                if (out[i] != luts[(i % ch) * 256 + src[i]]) passed = false;
+            }
+
+            free(src);
+            free(out);
+        }
+    }
+
+    test_suite_add_result(suite, "LUT - Per Channel", passed, passed ? "Gray, RGB and RGBA match" : "Mismatch");
+}
+
+// Test the table builders and point operations against direct formulas
+void test_point_ops(test_suite_t* suite) {
+    const size_t len = 777;
+    uint8_t* src = (uint8_t*)neon_malloc(len);
+    uint8_t* out = (uint8_t*)neon_malloc(len);
+    fill_bytes(src, len, 99);
+
+    // Gamma
+    bool passed = true;
+    simd_gamma_u8(src, 2.2f, out, len);
+    for (size_t i = 0; i < len; i++) {
+        int expected = (int)(255.0f * powf(src[i] / 255.0f, 2.2f) + 0.5f);
+        if (out[i] != expected) passed = false;
+    }
+    test_suite_add_result(suite, "Point - Gamma", passed, passed ? "Matches powf" : "Mismatch");
+
+    // Contrast/brightness with saturation at both ends
+    passed = true;
+    simd_contrast_u8(src, 1.5f, -40.0f, out, len);
+    for (size_t i = 0; i < len; i++) {
+        float v = 1.5f * src[i] - 40.0f;
+        int expected = v <= 0.0f ? 0 : (v >= 255.0f ? 255 : (int)(v + 0.5f));
+        if (out[i] != expected) passed = false;
+    }
+    test_suite_add_result(suite, "Point - Contrast/Brightness", passed, passed ? "Saturates correctly" : "Mismatch");
+
+    // Binary threshold
+    passed = true;
+    simd_threshold_u8(src, 100, 200, out, len);
+    for (size_t i = 0; i < len; i++) {
+        if (out[i] != (src[i] > 100 ? 200 : 0)) passed = false;
+    }
+    uint8_t lut[256];
+    simd_lut_threshold(lut, 100, 200);
+    for (int i = 0; i < 256; i++) {
+        if (lut[i] != (i > 100 ? 200 : 0)) passed = false;
+    }
+    test_suite_add_result(suite, "Point - Threshold", passed, passed ? "Matches compare" : "Mismatch");
+
+    // Multi-level threshold
+    static const uint8_t thresholds[] = { 50, 100, 100, 220 };
+    static const uint8_t levels[] = { 10, 60, 0, 140, 250 };
+    passed = true;
+    simd_multi_threshold_u8(src, thresholds, levels, 4, out, len);
+    for (size_t i = 0; i < len; i++) {
+        int k = 0;
+        while (k < 4 && thresholds[k] <= src[i]) k++;
+        if (out[i] != levels[k]) passed = false;
+    }
+    test_suite_add_result(suite, "Point - Multi Threshold", passed, passed ? "Matches level search" : "Mismatch");
+
+    free(src);
+    free(out);
+}
+
+// Test histogram equalization tables
+void test_lut_equalize(test_suite_t* suite) {
+    uint32_t hist[256];
+    uint8_t lut[256];
+    bool passed = true;
+
+    // Values 100..131 only: stretched to the full range, monotonic
+    memset(hist, 0, sizeof(hist));
+    for (int i = 100; i < 132; i++) hist[i] = 10;
+    simd_lut_equalize(hist, lut);
+    if (lut[100] != 0 || lut[131] != 255) passed = false;
+    for (int i = 1; i < 256; i++) {
+        if (lut[i] < lut[i - 1]) passed = false;
+    }
+
+    // Constant image: identity
+    memset(hist, 0, sizeof(hist));
+    hist[42] = 1000;
+    simd_lut_equalize(hist, lut);
+    for (int i = 0; i < 256; i++) {
+        if (lut[i] != i) passed = false;
+    }
+
+    test_suite_add_result(suite, "LUT - Equalize", passed, passed ? "Full range, monotonic" : "Mismatch");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for lookup tables...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Lookup Tables and Point Ops");
+
+    // Run tests
+    test_lut_apply(suite);
+    test_lut_channels(suite);
+    test_point_ops(suite);
+    test_lut_equalize(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * test_median_ops.c
+ * Unit tests for median filtering
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_median.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static int compare_u8(const void* a, const void* b) {
+    return (int)*(const uint8_t*)a - (int)*(const uint8_t*)b;
+}
+
+// Sort every window, replicating border pixels
+static void ref_median(const uint8_t* src, uint8_t* dst, int width, int height, int r) {
+    int n = 2 * r + 1;
+    uint8_t* window = (uint8_t*)malloc((size_t)n * n);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int count = 0;
+            for (int j = y - r; j <= y + r; j++) {
+                int yy = j < 0 ? 0 : (j >= height ? height - 1 : j);
+                for (int i = x - r; i <= x + r; i++) {
+                    int xx = i < 0 ? 0 : (i >= width ? width - 1 : i);
+                    window[count++] = src[yy * width + xx];
+                }
+            }
+            qsort(window, (size_t)count, 1, compare_u8);
+            dst[y * width + x] = window[count / 2];
+        }
+    }
+    free(window);
+}
+
+static void fill_image(uint8_t* img, int width, int height) {
+    for (int i = 0; i < width * height; i++) {
+        img[i] = (uint8_t)((i * 2654435761u) >> 24);
+    }
+    // Salt-and-pepper noise over a flat block
+    for (int y = height / 4; y < height / 2; y++) {
+        for (int x = width / 4; x < width / 2; x++) {
+            int k = (x * 7 + y * 13) % 11;
+            img[y * width + x] = k == 0 ? 0 : (k == 1 ? 255 : 128);
+        }
+    }
+}
+
+// Test every radius path against sorted windows on several image shapes
+void test_median_radii(test_suite_t* suite) {
+    static const int shapes[][2] = { { 67, 45 }, { 16, 9 }, { 5, 3 }, { 1, 7 }, { 300, 12 } };
+    static const int radii[] = { 1, 2, 3, 5, 9 };
+    static const char* names[] = { "Median 3x3", "Median 5x5", "Median 7x7 (Histogram)",
+                                   "Median 11x11 (Histogram)", "Median 19x19 (Histogram)" };
+
+    for (int r = 0; r < 5; r++) {
+        bool passed = true;
+        for (int s = 0; s < 5; s++) {
+            int w = shapes[s][0], h = shapes[s][1];
+            uint8_t* src = (uint8_t*)neon_malloc(w * h);
+            uint8_t* out = (uint8_t*)neon_malloc(w * h);
+            uint8_t* ref = (uint8_t*)neon_malloc(w * h);
+            fill_image(src, w, h);
+
+            simd_median_u8(src, out, w, h, radii[r], 1);
+            ref_median(src, ref, w, h, radii[r]);
+            if (memcmp(out, ref, w * h) != 0) {
+                passed = false;
+                printf("  Mismatch: %dx%d image, radius %d\n", w, h, radii[r]);
+            }
+
+            free(src);
+            free(out);
+            free(ref);
+        }
+        test_suite_add_result(suite, names[r], passed, passed ? "Matches sorted windows" : "Mismatch");
+    }
+}
+
+// Test that band splitting does not change the result
+void test_median_threads(test_suite_t* suite) {
+    const int w = 97, h = 83;
+    uint8_t* src = (uint8_t*)neon_malloc(w * h);
+    uint8_t* out = (uint8_t*)neon_malloc(w * h);
+    uint8_t* ref = (uint8_t*)neon_malloc(w * h);
+    fill_image(src, w, h);
+
+    static const int threads[] = { 2, 3, 7, 0 };
+    static const int radii[] = { 1, 2, 4 };
+    bool passed = true;
+    for (int r = 0; r < 3; r++) {
+        ref_median(src, ref, w, h, radii[r]);
+        for (int t = 0; t < 4; t++) {
+            simd_median_u8(src, out, w, h, radii[r], threads[t]);
+            if (memcmp(out, ref, w * h) != 0) passed = false;
+        }
+    }
+
+    test_suite_add_result(suite, "Median - Threads", passed, passed ? "Identical for all thread counts" : "Mismatch");
+
+    // Out-of-range radii leave the output untouched
+    memset(out, 7, w * h);
+    simd_median_u8(src, out, w, h, 0, 1);
+    simd_median_u8(src, out, w, h, SIMD_MEDIAN_MAX_RADIUS + 1, 1);
+    passed = true;
+    for (int i = 0; i < w * h; i++) if (out[i] != 7) passed = false;
+    test_suite_add_result(suite, "Median - Invalid Radius", passed, passed ? "Rejected" : "Output modified");
+
+    free(src);
+    free(out);
+    free(ref);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for median filtering...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Median Filter");
+
+    // Run tests
+    test_median_radii(suite);
+    test_median_threads(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/**
+ * test_morph_ops.c
+ * Unit tests for grayscale morphology
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_morph.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static const int kernel_sizes[][2] = { { 1, 1 }, { 3, 3 }, { 5, 3 }, { 4, 6 }, { 2, 1 },
+                                       { 1, 17 }, { 31, 1 }, { 31, 31 }, { 9, 13 } };
+#define NUM_SIZES (int)(sizeof(kernel_sizes) / sizeof(kernel_sizes[0]))
+
+// Window min/max scan, ignoring pixels outside the image
+static void ref_morph(const uint8_t* src, uint8_t* dst, int width, int height, int kw, int kh, int dilate) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int v = dilate ? 0 : 255;
+            for (int j = y - kh / 2; j < y - kh / 2 + kh; j++) {
+                for (int i = x - kw / 2; i < x - kw / 2 + kw; i++) {
+                    if (i < 0 || i >= width || j < 0 || j >= height) continue;
+                    int p = src[j * width + i];
+                    if (dilate ? p > v : p < v) v = p;
+                }
+            }
+            dst[y * width + x] = (uint8_t)v;
+        }
+    }
+}
+
+static void ref_subtract(const uint8_t* a, const uint8_t* b, uint8_t* dst, int len) {
+    for (int i = 0; i < len; i++) dst[i] = a[i] > b[i] ? (uint8_t)(a[i] - b[i]) : 0;
+}
+
+static void fill_image(uint8_t* img, int width, int height) {
+    for (int i = 0; i < width * height; i++) {
+        img[i] = (uint8_t)((i * 2654435761u) >> 24);
+    }
+    // A few flat blocks so openings and closings keep and remove structure
+    for (int y = height / 4; y < height / 2; y++) {
+        for (int x = width / 4; x < width / 2; x++) img[y * width + x] = 200;
+    }
+}
+
+// Test erosion and dilation against the naive window scan for many element sizes
+void test_erode_dilate(test_suite_t* suite) {
+    static const int shapes[][2] = { { 67, 45 }, { 300, 20 }, { 5, 3 } };
+    bool erode_ok = true, dilate_ok = true;
+
+    for (int s = 0; s < 3; s++) {
+        int w = shapes[s][0], h = shapes[s][1];
+        uint8_t* src = (uint8_t*)neon_malloc(w * h);
+        uint8_t* out = (uint8_t*)neon_malloc(w * h);
+        uint8_t* ref = (uint8_t*)neon_malloc(w * h);
+        fill_image(src, w, h);
+
+        for (int k = 0; k < NUM_SIZES; k++) {
+            int kw = kernel_sizes[k][0], kh = kernel_sizes[k][1];
+
+            simd_erode_u8(src, out, w, h, kw, kh, 1);
+            ref_morph(src, ref, w, h, kw, kh, 0);
+            if (memcmp(out, ref, w * h) != 0) {
+                erode_ok = false;
+                printf("  Erode mismatch: %dx%d image, %dx%d element\n", w, h, kw, kh);
+            }
+
+            simd_dilate_u8(src, out, w, h, kw, kh, 1);
+            ref_morph(src, ref, w, h, kw, kh, 1);
+            if (memcmp(out, ref, w * h) != 0) {
+                dilate_ok = false;
+                printf("  Dilate mismatch: %dx%d image, %dx%d element\n", w, h, kw, kh);
+            }
+        }
+
+        free(src);
+        free(out);
+        free(ref);
+    }
+
+    test_suite_add_result(suite, "Erode - Element Sizes 1..31", erode_ok, erode_ok ? "Matches window scan" : "Mismatch");
+    test_suite_add_result(suite, "Dilate - Element Sizes 1..31", dilate_ok, dilate_ok ? "Matches window scan" : "Mismatch");
+}
+
+// Test that band splitting does not change the result
+void test_morph_threads(test_suite_t* suite) {
+    const int w = 97, h = 83;
+    uint8_t* src = (uint8_t*)neon_malloc(w * h);
+    uint8_t* out = (uint8_t*)neon_malloc(w * h);
+    uint8_t* ref = (uint8_t*)neon_malloc(w * h);
+    fill_image(src, w, h);
+
+    static const int threads[] = { 2, 3, 7, 0 };
+    bool passed = true;
+    for (int t = 0; t < 4; t++) {
+        simd_erode_u8(src, out, w, h, 15, 21, threads[t]);
+        ref_morph(src, ref, w, h, 15, 21, 0);
+        if (memcmp(out, ref, w * h) != 0) passed = false;
+
+        simd_dilate_u8(src, out, w, h, 7, 31, threads[t]);
+        ref_morph(src, ref, w, h, 7, 31, 1);
+        if (memcmp(out, ref, w * h) != 0) passed = false;
+    }
+
+    test_suite_add_result(suite, "Morphology - Threads", passed, passed ? "Identical for all thread counts" : "Mismatch");
+
+    free(src);
+    free(out);
+    free(ref);
+}
+
+// Test open, close, gradient, top-hat and black-hat against compositions
+void test_morph_composite(test_suite_t* suite) {
+    const int w = 70, h = 50, kw = 5, kh = 7;
+    uint8_t* src = (uint8_t*)neon_malloc(w * h);
+    uint8_t* out = (uint8_t*)neon_malloc(w * h);
+    uint8_t* ref = (uint8_t*)neon_malloc(w * h);
+    uint8_t* t1 = (uint8_t*)neon_malloc(w * h);
+    uint8_t* t2 = (uint8_t*)neon_malloc(w * h);
+    fill_image(src, w, h);
+
+    static const char* names[] = { "Open", "Close", "Gradient", "Top-Hat", "Black-Hat" };
+    static const simd_morph_op_t ops[] = { SIMD_MORPH_OPEN, SIMD_MORPH_CLOSE, SIMD_MORPH_GRADIENT,
+                                           SIMD_MORPH_TOPHAT, SIMD_MORPH_BLACKHAT };
+    for (int o = 0; o < 5; o++) {
+        switch (ops[o]) {
+            case SIMD_MORPH_OPEN:
+                ref_morph(src, t1, w, h, kw, kh, 0);
+                ref_morph(t1, ref, w, h, kw, kh, 1);
+                break;
+            case SIMD_MORPH_CLOSE:
+                ref_morph(src, t1, w, h, kw, kh, 1);
+                ref_morph(t1, ref, w, h, kw, kh, 0);
+                break;
+            case SIMD_MORPH_GRADIENT:
+                ref_morph(src, t1, w, h, kw, kh, 1);
+                ref_morph(src, t2, w, h, kw, kh, 0);
+                ref_subtract(t1, t2, ref, w * h);
+                break;
+            case SIMD_MORPH_TOPHAT:
+                ref_morph(src, t1, w, h, kw, kh, 0);
+                ref_morph(t1, t2, w, h, kw, kh, 1);
+                ref_subtract(src, t2, ref, w * h);
+                break;
+            default:
+                ref_morph(src, t1, w, h, kw, kh, 1);
+                ref_morph(t1, t2, w, h, kw, kh, 0);
+                ref_subtract(t2, src, ref, w * h);
+                break;
+        }
+
+        simd_morphology_u8(src, out, w, h, ops[o], kw, kh, 3);
+        bool passed = memcmp(out, ref, w * h) == 0;
+        test_suite_add_result(suite, names[o], passed, passed ? "Matches composition" : "Mismatch");
+    }
+
+    // Out-of-range element sizes leave the output untouched
+    memset(out, 7, w * h);
+    simd_erode_u8(src, out, w, h, 32, 3, 1);
+    simd_dilate_u8(src, out, w, h, 3, 0, 1);
+    bool passed = true;
+    for (int i = 0; i < w * h; i++) if (out[i] != 7) passed = false;
+    test_suite_add_result(suite, "Morphology - Invalid Size", passed, passed ? "Rejected" : "Output modified");
+
+    free(src);
+    free(out);
+    free(ref);
+    free(t1);
+    free(t2);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for morphology operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Morphology Operations");
+
+    // Run tests
+    test_erode_dilate(suite);
+    test_morph_threads(suite);
+    test_morph_composite(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * test_numa_ops.c
+ * Unit tests for NUMA topology, node placement of the scheduler and
+ * node-local allocation, on fake node trees
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/simd_numa.h"
+#include "../include/simd_sched.h"
+#include "../include/simd_parallel.h"
+#include "../include/test_framework.h"
+
+/**
+ * Fake sysfs Trees
+ */
+
+static void write_file(const char* root, const char* name, const char* text) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+
+    // Create the parent directories
+    for (char* p = path + strlen(root) + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(path, 0755);
+            *p = '/';
+        }
+    }
+    FILE* f = fopen(path, "w");
+    if (f) {
+        fputs(text, f);
+        fclose(f);
+    }
+}
+
+static void remove_tree(const char* root) {
+    char cmd[300];
+    snprintf(cmd, sizeof(cmd), "rm -rf '%s'", root);
+    if (system(cmd) != 0) printf("Could not remove %s\n", root);
+}
+
+// Two sockets of two CPUs each, as on a (much smaller) dual-socket server
+static char two_nodes[] = "/tmp/test_numa_XXXXXX";
+
+static bool make_two_nodes(void) {
+    if (!mkdtemp(two_nodes)) return false;
+    write_file(two_nodes, "online", "0-1\n");
+    write_file(two_nodes, "node0/cpulist", "0-1\n");
+    write_file(two_nodes, "node0/meminfo", "Node 0 MemTotal:       65536000 kB\nNode 0 MemFree:        1000 kB\n");
+    write_file(two_nodes, "node1/cpulist", "2-3\n");
+    write_file(two_nodes, "node1/meminfo", "Node 1 MemTotal:       32768000 kB\n");
+    return true;
+}
+
+// Test node lists, CPU lists, memory and memory-only nodes
+void test_topology(test_suite_t* suite) {
+    simd_numa_node_t nodes[SIMD_NUMA_MAX_NODES];
+    int n = simd_numa_topology(two_nodes, nodes, SIMD_NUMA_MAX_NODES);
+    bool passed = n == 2 && nodes[0].id == 0 && nodes[0].cpu_count == 2 && nodes[0].cpus[1] == 1 &&
+                  nodes[0].memory == 65536000ull * 1024 && nodes[1].id == 1 && nodes[1].cpu_count == 2 &&
+                  nodes[1].cpus[0] == 2 && nodes[1].memory == 32768000ull * 1024;
+    test_suite_add_result(suite, "NUMA - Topology", passed, passed ? "2 nodes x 2 CPUs" : "Wrong nodes");
+
+    // Gaps in both lists, a memory-only node and a node without meminfo
+    char root[] = "/tmp/test_numa_XXXXXX";
+    passed = mkdtemp(root) != NULL;
+    write_file(root, "online", "0,2-3\n");
+    write_file(root, "node0/cpulist", "0,2,4-5\n");
+    write_file(root, "node2/cpulist", "\n");
+    write_file(root, "node2/meminfo", "Node 2 MemTotal:       1024 kB\n");
+    write_file(root, "node3/cpulist", "1,3\n");
+    n = simd_numa_topology(root, nodes, SIMD_NUMA_MAX_NODES);
+    passed = passed && n == 3 && nodes[0].cpu_count == 4 && nodes[0].cpus[1] == 2 && nodes[0].cpus[3] == 5 &&
+             nodes[1].id == 2 && nodes[1].cpu_count == 0 && nodes[1].memory == 1024 * 1024 &&
+             nodes[2].id == 3 && nodes[2].cpu_count == 2 && nodes[2].memory == 0;
+
+    // Memory-only nodes get no workers
+    simd_sched_config_t config = { 4, SIMD_AFFINITY_NUMA, NULL, root };
+    passed = passed && simd_sched_init(&config) && simd_sched_nodes() == 2;
+    remove_tree(root);
+
+    passed = passed && simd_numa_topology(root, nodes, SIMD_NUMA_MAX_NODES) == 0;
+    test_suite_add_result(suite, "NUMA - Topology Gaps", passed,
+                          passed ? "Lists, memory-only node, missing tree" : "Wrong nodes");
+}
+
+// Test worker shares and the node partition
+void test_placement(test_suite_t* suite) {
+    simd_sched_config_t config = { 3, SIMD_AFFINITY_NUMA, NULL, two_nodes };
+    bool passed = simd_sched_init(&config) && simd_sched_nodes() == 2 && simd_sched_workers() == 3 &&
+                  simd_sched_node_start(99, 0) == 0 && simd_sched_node_start(99, 1) == 66 &&
+                  simd_sched_node_start(99, 2) == 99 && simd_sched_node() == -1;
+
+    config.threads = 4;
+    passed = passed && simd_sched_init(&config) && simd_sched_node_start(100, 1) == 50;
+
+    // One worker cannot cover two nodes
+    config.threads = 1;
+    passed = passed && simd_sched_init(&config) && simd_sched_nodes() == 1 && simd_sched_node_start(10, 1) == 10;
+    test_suite_add_result(suite, "NUMA - Placement", passed, passed ? "Shares 2+1, 2+2, 1" : "Wrong partition");
+}
+
+/**
+ * Node-Bound Loops
+ */
+
+typedef struct {
+    atomic_int* hits;
+    atomic_int* node;           // Node that ran each index
+} where_t;
+
+static void record(void* ctx, size_t begin, size_t end) {
+    where_t* w = (where_t*)ctx;
+    int node = simd_sched_node();
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&w->hits[i], 1);
+        atomic_store(&w->node[i], node);
+    }
+}
+
+// Nested loops inside node work stay on the node
+static void record_nested(void* ctx, size_t begin, size_t end) {
+    where_t* w = (where_t*)ctx;
+    for (size_t i = begin; i < end; i += 16) {
+        size_t stop = i + 16 < end ? i + 16 : end;
+        simd_parallel_for(i, stop, 1, record, w);
+    }
+}
+
+// Test every index runs once, on the workers of the node that owns it
+void test_for_nodes(test_suite_t* suite) {
+    simd_sched_config_t config = { 4, SIMD_AFFINITY_NUMA, NULL, two_nodes };
+    bool passed = simd_sched_init(&config);
+
+    const size_t n = 50000;
+    where_t w = { (atomic_int*)calloc(n, sizeof(atomic_int)), (atomic_int*)calloc(n, sizeof(atomic_int)) };
+    for (int nested = 0; nested < 2; nested++) {
+        memset(w.hits, 0, n * sizeof(atomic_int));
+        simd_parallel_for_nodes(0, n, 0, nested ? record_nested : record, &w);
+        size_t half = simd_sched_node_start(n, 1);
+        for (size_t i = 0; i < n; i++) {
+            passed &= atomic_load(&w.hits[i]) == 1 && atomic_load(&w.node[i]) == (i < half ? 0 : 1);
+        }
+    }
+    test_suite_add_result(suite, "NUMA - For Nodes", passed, passed ? "Each index once, on its node" : "Wrong node");
+
+    // A single node, with an offset range
+    memset(w.hits, 0, n * sizeof(atomic_int));
+    simd_parallel_for_node(1, 100, n, 7, record, &w);
+    passed = true;
+    for (size_t i = 0; i < n; i++) {
+        passed &= atomic_load(&w.hits[i]) == (i >= 100) && (i < 100 || atomic_load(&w.node[i]) == 1);
+    }
+    test_suite_add_result(suite, "NUMA - For Node", passed, passed ? "All on node 1" : "Wrong node");
+    free(w.hits);
+    free(w.node);
+}
+
+typedef struct {
+    int rows;
+    int bands;
+    atomic_int node[SIMD_PARALLEL_MAX_THREADS];
+} band_nodes_t;
+
+static void band_node(void* ctx, int band, int y0, int y1) {
+    (void)y0;
+    (void)y1;
+    band_nodes_t* b = (band_nodes_t*)ctx;
+    atomic_store(&b->node[band], simd_sched_node());
+}
+
+// Test node-local allocation and banded kernels under node placement
+void test_alloc(test_suite_t* suite) {
+    simd_sched_config_t config = { 4, SIMD_AFFINITY_NUMA, NULL, two_nodes };
+    bool passed = simd_sched_init(&config);
+
+    size_t size = 10 * 1024 * 1024 + 123;
+    unsigned char* buf = (unsigned char*)simd_numa_alloc(size);
+    passed = passed && buf && ((uintptr_t)buf % (uintptr_t)sysconf(_SC_PAGESIZE)) == 0;
+    for (size_t i = 0; passed && i < size; i += 4093) passed = buf[i] == 0;
+    if (buf) {
+        memset(buf, 0xAB, size);
+        passed = passed && buf[size - 1] == 0xAB;
+    }
+    simd_numa_free(buf, size);
+    passed = passed && simd_numa_alloc(0) == NULL;
+    test_suite_add_result(suite, "NUMA - Alloc", passed, passed ? "Zeroed, page aligned" : "Allocation failed");
+
+    band_nodes_t b;
+    memset(&b, 0, sizeof(b));
+    b.rows = 1080;
+    b.bands = simd_parallel_bands(b.rows, 8, band_node, &b);
+    passed = b.bands == 8;
+    for (int i = 0; i < b.bands; i++) passed &= atomic_load(&b.node[i]) == (i < 4 ? 0 : 1);
+    test_suite_add_result(suite, "NUMA - Bands", passed, passed ? "Bands 0-3 on node 0, 4-7 on node 1" :
+                          "Band on wrong node");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for NUMA placement...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("NUMA Placement");
+    if (!make_two_nodes()) {
+        printf("ERROR: Could not create a fake node tree.\n");
+        return 1;
+    }
+
+    // Run tests
+    test_topology(suite);
+    test_placement(suite);
+    test_for_nodes(suite);
+    test_alloc(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+    simd_sched_shutdown();
+    remove_tree(two_nodes);
+
+    return failed ? 1 : 0;
+}
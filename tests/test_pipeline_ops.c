@@ -0,0 +1,255 @@
+/**
+ * test_pipeline_ops.c
+ * Unit tests for the SPSC queue and the frame pipeline executor
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../include/simd_pipeline.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Test FIFO order, capacity rounding and full/empty on one thread
+void test_spsc_basic(test_suite_t* suite) {
+    simd_spsc_t* q = simd_spsc_create(5);
+    bool passed = q && simd_spsc_capacity(q) == 8 && simd_spsc_pop(q) == NULL;
+
+    uintptr_t next = 1, expect = 1;
+    for (int round = 0; passed && round < 5; round++) {
+        // Fill to the brim across the wrap-around point, then drain part
+        while (simd_spsc_push(q, (void*)next)) next++;
+        passed = simd_spsc_size(q) == 8;
+        for (int i = 0; passed && i < 3 + round; i++) passed = simd_spsc_pop(q) == (void*)expect++;
+    }
+    while (passed && expect < next) passed = simd_spsc_pop(q) == (void*)expect++;
+    passed = passed && simd_spsc_pop(q) == NULL && simd_spsc_size(q) == 0;
+    simd_spsc_destroy(q);
+
+    passed = passed && simd_spsc_create(0) == NULL;
+    test_suite_add_result(suite, "Pipeline - SPSC Order", passed, passed ? "FIFO across wrap-around" : "Order broken");
+}
+
+typedef struct {
+    simd_spsc_t* q;
+    size_t count;
+} spsc_producer_t;
+
+static void* spsc_producer(void* arg) {
+    spsc_producer_t* p = (spsc_producer_t*)arg;
+    for (uintptr_t i = 1; i <= p->count; i++) {
+        while (!simd_spsc_push(p->q, (void*)i)) sched_yield();
+    }
+    return NULL;
+}
+
+// Test that items cross threads intact and in order
+void test_spsc_threads(test_suite_t* suite) {
+    spsc_producer_t prod = { simd_spsc_create(16), 200000 };
+    pthread_t thread;
+    bool passed = prod.q && pthread_create(&thread, NULL, spsc_producer, &prod) == 0;
+    if (passed) {
+        uintptr_t expect = 1;
+        while (expect <= prod.count) {
+            void* item = simd_spsc_pop(prod.q);
+            if (!item) {
+                sched_yield();
+                continue;
+            }
+            if (item != (void*)expect) passed = false;
+            expect++;
+        }
+        pthread_join(thread, NULL);
+    }
+    simd_spsc_destroy(prod.q);
+    test_suite_add_result(suite, "Pipeline - SPSC Threads", passed, passed ? "200000 items in order" : "Lost or reordered");
+}
+
+/**
+ * Test Stages
+ * The source writes the frame index into the buffer, each later stage
+ * adds its number to every byte, and the sink records what it received.
+ */
+
+#define TEST_FRAME_SIZE 1000
+#define TEST_FRAMES 500
+
+typedef struct {
+    uint64_t produced;
+    uint64_t limit;
+} source_ctx_t;
+
+static bool source_stage(void* ctx, simd_frame_t* frame) {
+    source_ctx_t* s = (source_ctx_t*)ctx;
+    if (s->produced == s->limit) return false;
+    memset(frame->data, (int)(s->produced & 0x3F), frame->size);
+    s->produced++;
+    return true;
+}
+
+typedef struct {
+    uint8_t add;
+    int drop_every;             // Drop frames whose index is a multiple (0 = none)
+} add_ctx_t;
+
+static bool add_stage(void* ctx, simd_frame_t* frame) {
+    add_ctx_t* a = (add_ctx_t*)ctx;
+    if (a->drop_every && frame->index % a->drop_every == 0) return false;
+    for (size_t i = 0; i < frame->size; i++) frame->data[i] += a->add;
+    return true;
+}
+
+typedef struct {
+    uint64_t received;
+    uint64_t last_index;
+    bool in_order;
+    bool content_ok;
+    uint8_t add;                // Sum of the adds before the sink
+    uint8_t* buffers[64];       // Distinct frame buffers seen
+    int buffer_count;
+} sink_ctx_t;
+
+static bool sink_stage(void* ctx, simd_frame_t* frame) {
+    sink_ctx_t* s = (sink_ctx_t*)ctx;
+    if (s->received && frame->index <= s->last_index) s->in_order = false;
+    s->last_index = frame->index;
+    s->received++;
+    uint8_t expect = (uint8_t)((frame->index & 0x3F) + s->add);
+    for (size_t i = 0; i < frame->size; i++) {
+        if (frame->data[i] != expect) s->content_ok = false;
+    }
+    int known = 0;
+    for (int i = 0; i < s->buffer_count; i++) known |= s->buffers[i] == frame->data;
+    if (!known && s->buffer_count < 64) s->buffers[s->buffer_count++] = frame->data;
+    return true;
+}
+
+// Run source -> +1 -> +2 -> sink with the given fusion pattern and pool
+static bool run_chain(const bool fuse[4], int frames, int capacity, int drop_every, sink_ctx_t* sink,
+                      simd_pipeline_stats_t* stats) {
+    source_ctx_t src = { 0, TEST_FRAMES };
+    add_ctx_t add1 = { 1, drop_every }, add2 = { 2, 0 };
+    memset(sink, 0, sizeof(*sink));
+    sink->in_order = true;
+    sink->content_ok = true;
+    sink->add = 3;
+
+    simd_stage_t stages[4] = {
+        { "source", source_stage, &src, fuse[0] },
+        { "add 1", add_stage, &add1, fuse[1] },
+        { "add 2", add_stage, &add2, fuse[2] },
+        { "sink", sink_stage, sink, fuse[3] },
+    };
+    simd_pipeline_config_t config = { TEST_FRAME_SIZE, frames, capacity };
+    return simd_pipeline_run(stages, 4, &config, stats);
+}
+
+// Test every frame passes every stage in order, for several thread mappings
+void test_pipeline_order(test_suite_t* suite) {
+    static const bool fusions[][4] = {
+        { false, false, false, false },     // One thread per stage
+        { false, true, true, true },        // Everything on the calling thread
+        { false, true, false, true },       // Two threads of two stages
+        { true, false, true, false },       // Fuse flag on the first stage is ignored
+    };
+    static const int threads[] = { 4, 1, 2, 3 };
+    static const int pools[][2] = { { 0, 0 }, { 1, 0 }, { 3, 1 }, { 16, 2 } };
+
+    bool passed = true;
+    for (size_t f = 0; f < sizeof(fusions) / sizeof(fusions[0]); f++) {
+        for (size_t p = 0; p < sizeof(pools) / sizeof(pools[0]); p++) {
+            sink_ctx_t sink;
+            simd_pipeline_stats_t stats;
+            int frames = pools[p][0];
+            bool ok = run_chain(fusions[f], frames, pools[p][1], 0, &sink, &stats);
+            int expected_threads = threads[f];
+            int pool = frames ? frames : 2 * expected_threads;
+            ok = ok && sink.received == TEST_FRAMES && sink.in_order && sink.content_ok &&
+                 stats.frames == TEST_FRAMES && stats.dropped == 0 && stats.threads == expected_threads &&
+                 sink.buffer_count <= pool;
+            for (int s = 0; ok && s < 4; s++) ok = stats.stage[s].frames == TEST_FRAMES;
+            if (!ok) passed = false;
+        }
+    }
+    test_suite_add_result(suite, "Pipeline - Order and Content", passed,
+                          passed ? "4 thread mappings, pools of 1 to 16 frames" : "Frames lost, reordered or corrupted");
+}
+
+// Test dropped frames skip later stages and are counted
+void test_pipeline_drops(test_suite_t* suite) {
+    static const bool separate[4] = { false, false, false, false };
+    sink_ctx_t sink;
+    simd_pipeline_stats_t stats;
+    bool passed = run_chain(separate, 4, 0, 3, &sink, &stats);
+
+    uint64_t dropped = (TEST_FRAMES + 2) / 3;
+    passed = passed && stats.dropped == dropped && stats.frames == TEST_FRAMES - dropped &&
+             sink.received == TEST_FRAMES - dropped && sink.in_order && sink.content_ok &&
+             stats.stage[0].frames == TEST_FRAMES && stats.stage[1].frames == TEST_FRAMES &&
+             stats.stage[2].frames == TEST_FRAMES - dropped;
+    test_suite_add_result(suite, "Pipeline - Dropped Frames", passed,
+                          passed ? "Every third frame dropped" : "Drop count or content wrong");
+}
+
+// Test reported queue depths respect the pool and queue sizes
+void test_pipeline_stats(test_suite_t* suite) {
+    static const bool separate[4] = { false, false, false, false };
+    sink_ctx_t sink;
+    simd_pipeline_stats_t stats;
+    bool passed = run_chain(separate, 6, 2, 0, &sink, &stats);
+
+    passed = passed && stats.stages == 4 && stats.fps > 0.0 && stats.seconds > 0.0 &&
+             stats.latency_max_us >= stats.latency_avg_us;
+
+    // The first stage sees free frames (pool of 6), the others a queue of 2
+    for (int i = 0; passed && i < 4; i++) {
+        const simd_stage_stats_t* st = &stats.stage[i];
+        int bound = i == 0 ? 6 : 2;
+        passed = st->queue_max >= 1 && st->queue_max <= bound && st->queue_avg >= 1.0 &&
+                 st->queue_avg <= st->queue_max && st->latency_max_us >= st->latency_avg_us &&
+                 st->starved_ms >= 0.0 && st->blocked_ms >= 0.0 && st->name != NULL;
+    }
+    test_suite_add_result(suite, "Pipeline - Statistics", passed, passed ? "Bounded depths" : "Out of range");
+}
+
+// Test invalid configurations are rejected
+void test_pipeline_invalid(test_suite_t* suite) {
+    source_ctx_t src = { 0, 1 };
+    simd_stage_t stages[2] = { { "source", source_stage, &src, false }, { "none", NULL, NULL, false } };
+    simd_pipeline_config_t config = { 16, 0, 0 };
+    simd_pipeline_config_t empty = { 0, 0, 0 };
+    simd_pipeline_config_t negative = { 16, -1, 0 };
+
+    bool passed = !simd_pipeline_run(stages, 2, &config, NULL) && !simd_pipeline_run(stages, 0, &config, NULL) &&
+                  !simd_pipeline_run(stages, 1, &empty, NULL) && !simd_pipeline_run(stages, 1, &negative, NULL) &&
+                  !simd_pipeline_run(stages, SIMD_PIPELINE_MAX_STAGES + 1, &config, NULL) &&
+                  simd_pipeline_run(stages, 1, &config, NULL) && src.produced == 1;
+    test_suite_add_result(suite, "Pipeline - Invalid Arguments", passed, passed ? "Rejected" : "Accepted");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for the frame pipeline...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Frame Pipeline");
+
+    // Run tests
+    test_spsc_basic(suite);
+    test_spsc_threads(suite);
+    test_pipeline_order(suite);
+    test_pipeline_drops(suite);
+    test_pipeline_stats(suite);
+    test_pipeline_invalid(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * test_pq_ops.c
+ * Unit tests for product quantization: codebook training, the fast-scan
+ * code layout, byte distance tables and search
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/simd_pq.h"
+#include "../include/simd_sched.h"
+#include "../include/test_framework.h"
+
+#define DIM 32
+#define M 8
+#define COUNT 2000
+#define QUERIES 20
+#define K 10
+
+static unsigned rng = 1;
+
+static float next_float(void) {
+    rng = rng * 1103515245u + 12345u;
+    return (float)((rng >> 16) & 0x7fff) / 16384.0f - 1.0f;
+}
+
+static void start_pool(int threads) {
+    simd_sched_config_t config = { threads, SIMD_AFFINITY_NONE, NULL, NULL };
+    simd_sched_init(&config);
+}
+
+// Each subvector near one of 16 per-position centers: what PQ models exactly
+static float* make_corpus(size_t n) {
+    float centers[M][16][DIM / M];
+    for (int j = 0; j < M; j++) {
+        for (int c = 0; c < 16; c++) {
+            for (int e = 0; e < DIM / M; e++) centers[j][c][e] = next_float();
+        }
+    }
+    float* v = (float*)malloc(n * DIM * sizeof(float));
+    for (size_t i = 0; i < n; i++) {
+        for (int j = 0; j < M; j++) {
+            int c = (int)((rng >> 8) % 16);
+            next_float();
+            for (int e = 0; e < DIM / M; e++) v[i * DIM + j * (DIM / M) + e] = centers[j][c][e] + 0.02f * next_float();
+        }
+    }
+    return v;
+}
+
+static double reconstruction_error(const simd_pq_t* pq, const float* v, const uint8_t* codes, size_t n) {
+    float r[DIM];
+    double err = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        simd_pq_decode(pq, codes, r, i);
+        for (int e = 0; e < DIM; e++) err += (v[i * DIM + e] - r[e]) * (v[i * DIM + e] - r[e]);
+    }
+    return err / (double)n;
+}
+
+// Test argument checks and code sizes
+void test_create(test_suite_t* suite) {
+    simd_pq_t* pq = simd_pq_create(DIM, M, SIMD_KNN_L2);
+    bool passed = pq && simd_pq_code_bytes(pq, 33) == 2 * M * 16 && simd_pq_code_bytes(pq, 32) == M * 16;
+    passed &= simd_pq_centroid(pq, 0, 0) == NULL;
+    passed &= simd_pq_create(DIM, 5, SIMD_KNN_L2) == NULL && simd_pq_create(DIM, 0, SIMD_KNN_L2) == NULL &&
+              simd_pq_create(DIM, M, SIMD_KNN_COSINE) == NULL && simd_pq_create(512, 512, SIMD_KNN_L2) == NULL;
+    simd_pq_destroy(pq);
+    test_suite_add_result(suite, "PQ - Create", passed, passed ? "Sizes and argument checks" : "Wrong checks");
+}
+
+// Test k-means finds the planted centers and the codes reconstruct the data
+void test_train(test_suite_t* suite) {
+    float* v = make_corpus(COUNT);
+    simd_pq_t* pq = simd_pq_create(DIM, M, SIMD_KNN_L2);
+    uint8_t* codes = (uint8_t*)malloc(simd_pq_code_bytes(pq, COUNT));
+
+    bool passed = simd_pq_train(pq, v, COUNT, 0) && simd_pq_encode(pq, v, codes, COUNT);
+    double initial = reconstruction_error(pq, v, codes, COUNT);
+    passed &= simd_pq_train(pq, v, COUNT, 20) && simd_pq_encode(pq, v, codes, COUNT);
+    double trained = reconstruction_error(pq, v, codes, COUNT);
+    passed &= trained < initial && trained < 0.05 && !simd_pq_train(pq, v, 15, 10);
+
+    test_suite_add_result(suite, "PQ - K-means Training", passed, passed ? "Error falls to the planted noise" :
+                          "Codebooks did not converge");
+    simd_pq_destroy(pq);
+    free(codes);
+    free(v);
+}
+
+// Test the scan against codes packed by hand as documented
+void test_scan(test_suite_t* suite) {
+    size_t n = 70, blocks = 3;
+    uint8_t code[70][M];
+    uint8_t* packed = (uint8_t*)calloc(blocks * M * 16, 1);
+    uint8_t lut[M * 16];
+    for (size_t i = 0; i < n; i++) {
+        for (int j = 0; j < M; j++) {
+            code[i][j] = (uint8_t)((rng >> 12) & 15);
+            next_float();
+            size_t byte = (i / 32) * M * 16 + j * 16 + i % 16;
+            packed[byte] |= (uint8_t)(i % 32 < 16 ? code[i][j] : code[i][j] << 4);
+        }
+    }
+    for (int i = 0; i < M * 16; i++) lut[i] = (uint8_t)(255 - (i * 37) % 256);
+
+    uint16_t out[71];
+    out[70] = 0xBEEF;
+    simd_pq_scan_u8(lut, packed, out, M, n);
+    bool passed = out[70] == 0xBEEF;
+    for (size_t i = 0; i < n; i++) {
+        unsigned sum = 0;
+        for (int j = 0; j < M; j++) sum += lut[j * 16 + code[i][j]];
+        passed &= out[i] == sum;
+    }
+    test_suite_add_result(suite, "PQ - Fast Scan", passed, passed ? "70 vectors in 3 nibble blocks" :
+                          "Wrong sums or layout");
+    free(packed);
+}
+
+// Test byte tables stay within half a step per subquantizer of the floats
+void test_lut(test_suite_t* suite) {
+    float table[M * 16];
+    uint8_t lut[M * 16];
+    float scale, bias;
+    for (int i = 0; i < M * 16; i++) table[i] = 10.0f * next_float() + (float)(i / 16);
+    simd_pq_lut_u8(table, lut, &scale, &bias, M);
+
+    bool passed = true;
+    for (int trial = 0; trial < 100; trial++) {
+        float exact = 0.0f;
+        unsigned sum = 0;
+        for (int j = 0; j < M; j++) {
+            int c = (int)((rng >> 12) & 15);
+            next_float();
+            exact += table[j * 16 + c];
+            sum += lut[j * 16 + c];
+        }
+        passed &= fabsf((float)sum * scale + bias - exact) <= M * scale * 0.5f + 1e-3f;
+    }
+    test_suite_add_result(suite, "PQ - Byte Tables", passed, passed ? "Within rounding of the float table" :
+                          "Quantization error too large");
+}
+
+// Test search returns table distances, ranks like the float tables, and
+// does not depend on the number of workers
+void test_search(test_suite_t* suite) {
+    float* v = make_corpus(COUNT);
+    float queries[QUERIES * DIM];
+    for (int i = 0; i < QUERIES * DIM; i++) queries[i] = v[(i / DIM) * 97 * DIM + i % DIM] + 0.05f * next_float();
+
+    bool passed = true;
+    static const simd_knn_metric_t metrics[] = { SIMD_KNN_L2, SIMD_KNN_INNER_PRODUCT };
+    double hits = 0;
+    for (int mi = 0; mi < 2; mi++) {
+        int64_t ids[2][QUERIES * K];
+        float scores[2][QUERIES * K];
+        simd_pq_t* pq = NULL;
+        uint8_t* codes = NULL;
+        for (int t = 0; t < 2; t++) {
+            start_pool(t == 0 ? 0 : 3);
+            simd_pq_destroy(pq);
+            free(codes);
+            pq = simd_pq_create(DIM, M, metrics[mi]);
+            codes = (uint8_t*)malloc(simd_pq_code_bytes(pq, COUNT));
+            passed &= simd_pq_train(pq, v, COUNT, 10) && simd_pq_encode(pq, v, codes, COUNT);
+            passed &= simd_pq_search(pq, codes, queries, ids[t], scores[t], COUNT, QUERIES, K);
+        }
+        passed &= memcmp(ids[0], ids[1], sizeof(ids[0])) == 0 && memcmp(scores[0], scores[1], sizeof(scores[0])) == 0;
+
+        // Reference: every decoded vector scored exactly
+        float* ref = (float*)malloc(COUNT * sizeof(float));
+        for (int q = 0; q < QUERIES; q++) {
+            const float* qv = queries + q * DIM;
+            for (int i = 0; i < COUNT; i++) {
+                float r[DIM], s = 0.0f;
+                simd_pq_decode(pq, codes, r, (size_t)i);
+                for (int e = 0; e < DIM; e++) s += metrics[mi] == SIMD_KNN_L2 ? (qv[e] - r[e]) * (qv[e] - r[e]) : -qv[e] * r[e];
+                ref[i] = s;
+            }
+            int64_t best[K];
+            float best_d[K];
+            simd_knn_select(ref, best, best_d, COUNT, K);
+            for (int r = 0; r < K; r++) {
+                float d = metrics[mi] == SIMD_KNN_L2 ? scores[0][q * K + r] : -scores[0][q * K + r];
+                passed &= fabsf(d - ref[ids[0][q * K + r]]) < 1e-3f * (1.0f + fabsf(d));
+                passed &= r == 0 || d >= (metrics[mi] == SIMD_KNN_L2 ? scores[0][q * K + r - 1] : -scores[0][q * K + r - 1]);
+                for (int b = 0; b < K; b++) hits += ids[0][q * K + r] == best[b];
+            }
+        }
+        free(ref);
+        simd_pq_destroy(pq);
+        free(codes);
+    }
+    double recall = hits / (2.0 * QUERIES * K);
+    passed &= recall >= 0.9;
+    test_suite_add_result(suite, "PQ - Search", passed, passed ? "L2 and inner product, re-ranked, 3 workers" :
+                          "Wrong scores, order or recall");
+    free(v);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for product quantization...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Product Quantization");
+
+    // Run tests
+    test_create(suite);
+    test_train(suite);
+    test_scan(suite);
+    test_lut(suite);
+    test_search(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+    simd_sched_shutdown();
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * test_resize_ops.c
+ * Unit tests for image resizing and pyramids
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_resize.h"
+#include "../include/simd_border.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static const int channel_counts[] = { 1, 3, 4 };
+
+static void fill_pattern(uint8_t* img, int width, int height, int channels) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            for (int c = 0; c < channels; c++) {
+                img[((size_t)y * width + x) * channels + c] = (uint8_t)((x * 37 + y * 101 + c * 59 + x * y) & 0xFF);
+            }
+        }
+    }
+}
+
+static inline int pixel(const uint8_t* img, int width, int height, int channels, int x, int y, int c) {
+    x = simd_border_index(x, width, SIMD_BORDER_REFLECT);
+    y = simd_border_index(y, height, SIMD_BORDER_REFLECT);
+    return img[((size_t)y * width + x) * channels + c];
+}
+
+static int max_abs_diff(const uint8_t* a, const uint8_t* b, size_t len) {
+    int max_diff = 0;
+    for (size_t i = 0; i < len; i++) {
+        int d = abs((int)a[i] - (int)b[i]);
+        if (d > max_diff) max_diff = d;
+    }
+    return max_diff;
+}
+
+// Test 2x box downsampling against the rounded 2x2 mean
+void test_downsample2x(test_suite_t* suite) {
+    static const int sizes[][2] = { { 37, 21 }, { 64, 8 }, { 2, 2 } };
+    bool passed = true;
+
+    for (int s = 0; s < 3; s++) {
+        int w = sizes[s][0], h = sizes[s][1];
+        for (int k = 0; k < 3; k++) {
+            int ch = channel_counts[k];
+            uint8_t* src = (uint8_t*)neon_malloc((size_t)w * h * ch);
+            uint8_t* dst = (uint8_t*)neon_malloc((size_t)(w / 2) * (h / 2) * ch);
+            fill_pattern(src, w, h, ch);
+            simd_downsample2x_u8(src, dst, w, h, ch);
+
+            for (int y = 0; y < h / 2; y++) {
+                for (int x = 0; x < w / 2; x++) {
+                    for (int c = 0; c < ch; c++) {
+                        int sum = pixel(src, w, h, ch, 2 * x, 2 * y, c) + pixel(src, w, h, ch, 2 * x + 1, 2 * y, c) +
+                                  pixel(src, w, h, ch, 2 * x, 2 * y + 1, c) + pixel(src, w, h, ch, 2 * x + 1, 2 * y + 1, c);
+                        if (dst[((size_t)y * (w / 2) + x) * ch + c] != (sum + 2) / 4) passed = false;
+                    }
+                }
+            }
+            free(src);
+            free(dst);
+        }
+    }
+
+    test_suite_add_result(suite, "Downsample 2x - 1/3/4 Channels", passed, passed ? "Exact" : "Mismatch");
+}
+
+// Test pyrDown and pyrUp against the direct 5x5 definitions
+void test_pyramid(test_suite_t* suite) {
+    static const int kernel[5] = { 1, 4, 6, 4, 1 };
+    static const int sizes[][2] = { { 45, 23 }, { 40, 17 }, { 1, 1 }, { 3, 2 } };
+    bool down_ok = true, up_ok = true;
+
+    for (int s = 0; s < 4; s++) {
+        int w = sizes[s][0], h = sizes[s][1];
+        for (int k = 0; k < 3; k++) {
+            int ch = channel_counts[k];
+            int dw = (w + 1) / 2, dh = (h + 1) / 2;
+            uint8_t* src = (uint8_t*)neon_malloc((size_t)w * h * ch);
+            uint8_t* down = (uint8_t*)neon_malloc((size_t)dw * dh * ch);
+            uint8_t* up = (uint8_t*)neon_malloc((size_t)4 * w * h * ch);
+            fill_pattern(src, w, h, ch);
+
+            simd_pyr_down_u8(src, down, w, h, ch);
+            for (int y = 0; y < dh; y++) {
+                for (int x = 0; x < dw; x++) {
+                    for (int c = 0; c < ch; c++) {
+                        int sum = 0;
+                        for (int i = 0; i < 5; i++) {
+                            for (int j = 0; j < 5; j++) {
+                                sum += kernel[i] * kernel[j] * pixel(src, w, h, ch, 2 * x + j - 2, 2 * y + i - 2, c);
+                            }
+                        }
+                        if (down[((size_t)y * dw + x) * ch + c] != (sum + 128) >> 8) down_ok = false;
+                    }
+                }
+            }
+
+            // Upsampled image is zero at odd coordinates, so only taps that
+            // land on even ones contribute
+            simd_pyr_up_u8(src, up, w, h, ch);
+            for (int y = 0; y < 2 * h; y++) {
+                for (int x = 0; x < 2 * w; x++) {
+                    for (int c = 0; c < ch; c++) {
+                        int sum = 0;
+                        for (int i = -2; i <= 2; i++) {
+                            for (int j = -2; j <= 2; j++) {
+                                if ((y + i) & 1 || (x + j) & 1) continue;
+                                sum += kernel[i + 2] * kernel[j + 2] *
+                                       pixel(src, w, h, ch, (x + j) / 2, (y + i) / 2, c);
+                            }
+                        }
+                        if (up[((size_t)y * 2 * w + x) * ch + c] != (sum + 32) >> 6) up_ok = false;
+                    }
+                }
+            }
+
+            free(src);
+            free(down);
+            free(up);
+        }
+    }
+
+    test_suite_add_result(suite, "Pyramid Down - 1/3/4 Channels", down_ok, down_ok ? "Exact" : "Mismatch");
+    test_suite_add_result(suite, "Pyramid Up - 1/3/4 Channels", up_ok, up_ok ? "Exact" : "Mismatch");
+}
+
+// Double-precision bilinear with the same pixel-center alignment
+static void reference_bilinear(const uint8_t* src, uint8_t* dst, int sw, int sh, int dw, int dh, int ch) {
+    for (int y = 0; y < dh; y++) {
+        double sy = (y + 0.5) * sh / dh - 0.5;
+        if (sy < 0) sy = 0;
+        int y0 = (int)sy;
+        if (y0 > sh - 1) y0 = sh - 1;
+        int y1 = y0 + 1 < sh ? y0 + 1 : y0;
+        double fy = sy - y0;
+        for (int x = 0; x < dw; x++) {
+            double sx = (x + 0.5) * sw / dw - 0.5;
+            if (sx < 0) sx = 0;
+            int x0 = (int)sx;
+            if (x0 > sw - 1) x0 = sw - 1;
+            int x1 = x0 + 1 < sw ? x0 + 1 : x0;
+            double fx = sx - x0;
+            for (int c = 0; c < ch; c++) {
+                double top = src[((size_t)y0 * sw + x0) * ch + c] * (1 - fx) + src[((size_t)y0 * sw + x1) * ch + c] * fx;
+                double bot = src[((size_t)y1 * sw + x0) * ch + c] * (1 - fx) + src[((size_t)y1 * sw + x1) * ch + c] * fx;
+                dst[((size_t)y * dw + x) * ch + c] = (uint8_t)lround(top * (1 - fy) + bot * fy);
+            }
+        }
+    }
+}
+
+// Double-precision area average
+static void reference_area(const uint8_t* src, uint8_t* dst, int sw, int sh, int dw, int dh, int ch) {
+    double sx = (double)sw / dw, sy = (double)sh / dh;
+    for (int y = 0; y < dh; y++) {
+        for (int x = 0; x < dw; x++) {
+            for (int c = 0; c < ch; c++) {
+                double sum = 0.0;
+                for (int j = (int)(y * sy); j < sh && j < (y + 1) * sy; j++) {
+                    double wy = fmin(j + 1, (y + 1) * sy) - fmax(j, y * sy);
+                    for (int i = (int)(x * sx); i < sw && i < (x + 1) * sx; i++) {
+                        double wx = fmin(i + 1, (x + 1) * sx) - fmax(i, x * sx);
+                        sum += wx * wy * src[((size_t)j * sw + i) * ch + c];
+                    }
+                }
+                dst[((size_t)y * dw + x) * ch + c] = (uint8_t)lround(sum / (sx * sy));
+            }
+        }
+    }
+}
+
+// Test bilinear and area resize against double precision, flat images and copies
+void test_resize(test_suite_t* suite) {
+    // The last three shrink by about 6x and 11x and enlarge by 7x: wide,
+    // narrow and scalar-only horizontal gathers
+    static const int cases[][4] = { { 100, 60, 37, 29 }, { 100, 60, 211, 97 }, { 96, 48, 32, 16 },
+                                    { 100, 70, 33, 29 }, { 64, 36, 64, 18 }, { 400, 40, 67, 13 },
+                                    { 640, 30, 58, 10 }, { 50, 20, 333, 41 } };
+    const int case_count = (int)(sizeof(cases) / sizeof(cases[0]));
+    static const char* mode_names[] = { "Bilinear", "Area" };
+
+    for (int m = 0; m < 2; m++) {
+        simd_resize_mode_t mode = (simd_resize_mode_t)m;
+        int worst = 0;
+        bool flat_ok = true;
+
+        for (int t = 0; t < case_count; t++) {
+            int sw = cases[t][0], sh = cases[t][1], dw = cases[t][2], dh = cases[t][3];
+            for (int k = 0; k < 3; k++) {
+                int ch = channel_counts[k];
+                uint8_t* src = (uint8_t*)neon_malloc((size_t)sw * sh * ch);
+                uint8_t* dst = (uint8_t*)neon_malloc((size_t)dw * dh * ch);
+                uint8_t* ref = (uint8_t*)neon_malloc((size_t)dw * dh * ch);
+
+                fill_pattern(src, sw, sh, ch);
+                simd_resize_u8(src, dst, sw, sh, dw, dh, ch, mode);
+                if (mode == SIMD_RESIZE_AREA && dw <= sw && dh <= sh) {
+                    reference_area(src, ref, sw, sh, dw, dh, ch);
+                } else {
+                    reference_bilinear(src, ref, sw, sh, dw, dh, ch);
+                }
+                int d = max_abs_diff(dst, ref, (size_t)dw * dh * ch);
+                if (d > worst) worst = d;
+
+                memset(src, 201, (size_t)sw * sh * ch);
+                simd_resize_u8(src, dst, sw, sh, dw, dh, ch, mode);
+                for (size_t i = 0; i < (size_t)dw * dh * ch; i++) {
+                    if (dst[i] != 201) flat_ok = false;
+                }
+
+                free(src);
+                free(dst);
+                free(ref);
+            }
+        }
+
+        int tolerance = mode == SIMD_RESIZE_AREA ? 1 : 2;
+        bool passed = worst <= tolerance && flat_ok;
+        char name[64], message[96];
+        snprintf(name, sizeof(name), "Resize %s - 1/3/4 Channels", mode_names[m]);
+        snprintf(message, sizeof(message), "Max error %d (tolerance %d)%s", worst, tolerance,
+                 flat_ok ? "" : ", flat image changed");
+        test_suite_add_result(suite, name, passed, message);
+    }
+
+    // Same size copies; exact 2x area reduction matches the box kernel
+    const int w = 50, h = 30;
+    uint8_t* src = (uint8_t*)neon_malloc((size_t)w * h * 3);
+    uint8_t* dst = (uint8_t*)neon_malloc((size_t)w * h * 3);
+    uint8_t* ref = (uint8_t*)neon_malloc((size_t)w * h * 3);
+    fill_pattern(src, w, h, 3);
+
+    simd_resize_u8(src, dst, w, h, w, h, 3, SIMD_RESIZE_BILINEAR);
+    bool passed = memcmp(src, dst, (size_t)w * h * 3) == 0;
+
+    simd_resize_u8(src, dst, w, h, w / 2, h / 2, 3, SIMD_RESIZE_AREA);
+    simd_downsample2x_u8(src, ref, w, h, 3);
+    passed = passed && memcmp(dst, ref, (size_t)(w / 2) * (h / 2) * 3) == 0;
+
+    test_suite_add_result(suite, "Resize - Identity and 2x Area", passed, passed ? "Correct" : "Mismatch");
+
+    free(src);
+    free(dst);
+    free(ref);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for resize operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Resize Operations");
+
+    // Run tests
+    test_downsample2x(suite);
+    test_pyramid(suite);
+    test_resize(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
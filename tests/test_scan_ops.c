@@ -0,0 +1,246 @@
+/**
+ * test_scan_ops.c
+ * Unit tests for prefix sums (scans)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "../include/simd_scan.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static const size_t lengths[] = { 0, 1, 3, 7, 16, 31, 100, 1027 };
+static const char* kind_names[] = { "Inclusive", "Exclusive" };
+
+// Test the widening and 32-bit integer scans against a sequential loop
+void test_scan_integer(test_suite_t* suite) {
+    const size_t max_len = 1027;
+    uint8_t* in8 = (uint8_t*)neon_malloc(max_len);
+    uint32_t* out32 = (uint32_t*)neon_malloc(max_len * sizeof(uint32_t));
+    int32_t* in = (int32_t*)neon_malloc(max_len * sizeof(int32_t));
+    int32_t* out = (int32_t*)neon_malloc(max_len * sizeof(int32_t));
+
+    for (size_t i = 0; i < max_len; i++) {
+        in8[i] = (uint8_t)(i % 5 ? (i * 53) & 0xFF : 255);
+        in[i] = (int32_t)((i * 7919) % 2001) - 1000;
+    }
+
+    for (int k = 0; k < 2; k++) {
+        simd_scan_kind_t kind = (simd_scan_kind_t)k;
+        bool passed = true;
+        for (int l = 0; l < 8; l++) {
+            size_t len = lengths[l];
+            uint32_t total8 = simd_scan_u8_u32(in8, out32, len, kind);
+            int32_t total = simd_scan_s32(in, out, len, kind);
+
+            uint32_t run8 = 0;
+            int32_t run = 0;
+            for (size_t i = 0; i < len; i++) {
+                if (out32[i] != (kind == SIMD_SCAN_INCLUSIVE ? run8 + in8[i] : run8)) passed = false;
+                if (out[i] != (kind == SIMD_SCAN_INCLUSIVE ? run + in[i] : run)) passed = false;
+                run8 += in8[i];
+                run += in[i];
+            }
+            if (total8 != run8 || total != run) passed = false;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "Scan U8->U32/S32 - %s", kind_names[k]);
+        test_suite_add_result(suite, name, passed, passed ? "Matches sequential scan" : "Mismatch");
+    }
+
+    // In-place scan
+    int32_t ref[100];
+    int32_t run = 0;
+    for (int i = 0; i < 100; i++) {
+        run += in[i];
+        ref[i] = run;
+    }
+    simd_scan_s32(in, in, 100, SIMD_SCAN_INCLUSIVE);
+    bool passed = memcmp(in, ref, sizeof(ref)) == 0;
+    test_suite_add_result(suite, "Scan S32 - In Place", passed, passed ? "Correct" : "Mismatch");
+
+    free(in8);
+    free(out32);
+    free(in);
+    free(out);
+}
+
+// Test float scans; small integer values keep every partial sum exact
+void test_scan_float(test_suite_t* suite) {
+    const size_t max_len = 1027;
+    float* in = (float*)neon_malloc(max_len * sizeof(float));
+    float* out = (float*)neon_malloc(max_len * sizeof(float));
+    double* din = (double*)neon_malloc(max_len * sizeof(double));
+    double* dout = (double*)neon_malloc(max_len * sizeof(double));
+
+    for (size_t i = 0; i < max_len; i++) {
+        in[i] = (float)((int)((i * 31) % 17) - 8);
+        din[i] = (double)((int)((i * 13) % 101) - 50) * 0.5;
+    }
+
+    for (int k = 0; k < 2; k++) {
+        simd_scan_kind_t kind = (simd_scan_kind_t)k;
+        bool passed = true;
+        for (int l = 0; l < 8; l++) {
+            size_t len = lengths[l];
+            float total = simd_scan_f32(in, out, len, kind);
+            double dtotal = simd_scan_f64(din, dout, len, kind);
+
+            float run = 0.0f;
+            double drun = 0.0;
+            for (size_t i = 0; i < len; i++) {
+                if (out[i] != (kind == SIMD_SCAN_INCLUSIVE ? run + in[i] : run)) passed = false;
+                if (dout[i] != (kind == SIMD_SCAN_INCLUSIVE ? drun + din[i] : drun)) passed = false;
+                run += in[i];
+                drun += din[i];
+            }
+            if (total != run || dtotal != drun) passed = false;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "Scan F32/F64 - %s", kind_names[k]);
+        test_suite_add_result(suite, name, passed, passed ? "Matches sequential scan" : "Mismatch");
+    }
+
+    free(in);
+    free(out);
+    free(din);
+    free(dout);
+}
+
+// Test the multi-threaded block scan against the single-threaded one
+void test_scan_parallel(test_suite_t* suite) {
+    const size_t len = 300007;
+    uint8_t* in8 = (uint8_t*)neon_malloc(len);
+    uint32_t* out32 = (uint32_t*)neon_malloc(len * sizeof(uint32_t));
+    uint32_t* ref32 = (uint32_t*)neon_malloc(len * sizeof(uint32_t));
+    int32_t* in = (int32_t*)neon_malloc(len * sizeof(int32_t));
+    int32_t* out = (int32_t*)neon_malloc(len * sizeof(int32_t));
+    int32_t* ref = (int32_t*)neon_malloc(len * sizeof(int32_t));
+    double* din = (double*)neon_malloc(len * sizeof(double));
+    double* dout = (double*)neon_malloc(len * sizeof(double));
+    double* dref = (double*)neon_malloc(len * sizeof(double));
+
+    for (size_t i = 0; i < len; i++) {
+        in8[i] = (uint8_t)(i * 97);
+        in[i] = (int32_t)(i * 2654435761u);   // Wraps freely
+        din[i] = (double)(i % 9);
+    }
+
+    static const int threads[] = { 1, 2, 3, 0 };
+    bool passed = true;
+    for (int k = 0; k < 2; k++) {
+        simd_scan_kind_t kind = (simd_scan_kind_t)k;
+        uint32_t t8 = simd_scan_u8_u32(in8, ref32, len, kind);
+        int32_t t32 = simd_scan_s32(in, ref, len, kind);
+        double t64 = simd_scan_f64(din, dref, len, kind);
+
+        for (int t = 0; t < 4; t++) {
+            if (simd_scan_parallel_u8_u32(in8, out32, len, kind, threads[t]) != t8) passed = false;
+            if (simd_scan_parallel_s32(in, out, len, kind, threads[t]) != t32) passed = false;
+            if (simd_scan_parallel_f64(din, dout, len, kind, threads[t]) != t64) passed = false;
+            if (memcmp(out32, ref32, len * sizeof(uint32_t)) != 0) passed = false;
+            if (memcmp(out, ref, len * sizeof(int32_t)) != 0) passed = false;
+            if (memcmp(dout, dref, len * sizeof(double)) != 0) passed = false;
+        }
+    }
+    test_suite_add_result(suite, "Scan - Parallel", passed,
+                          passed ? "Identical for all thread counts" : "Mismatch");
+
+    // Floats: rounding may differ across block boundaries, but not by much
+    float* fin = (float*)neon_malloc(len * sizeof(float));
+    float* fout = (float*)neon_malloc(len * sizeof(float));
+    for (size_t i = 0; i < len; i++) fin[i] = sinf((float)i) * 0.5f + 0.5f;
+    double exact = 0.0;
+    for (size_t i = 0; i < len; i++) exact += fin[i];
+    float total = simd_scan_parallel_f32(fin, fout, len, SIMD_SCAN_INCLUSIVE, 4);
+    passed = fabs((double)total - exact) < 1e-4 * exact && fabs((double)fout[len - 1] - exact) < 1e-4 * exact;
+    test_suite_add_result(suite, "Scan F32 - Parallel", passed,
+                          passed ? "Total within tolerance" : "Total inaccurate");
+
+    free(in8);
+    free(out32);
+    free(ref32);
+    free(in);
+    free(out);
+    free(ref);
+    free(din);
+    free(dout);
+    free(dref);
+    free(fin);
+    free(fout);
+}
+
+// Test segmented scans against a sequential loop that restarts at flags
+void test_segmented_scan(test_suite_t* suite) {
+    const size_t len = 203;
+    int32_t* in = (int32_t*)neon_malloc(len * sizeof(int32_t));
+    int32_t* out = (int32_t*)neon_malloc(len * sizeof(int32_t));
+    float* fin = (float*)neon_malloc(len * sizeof(float));
+    float* fout = (float*)neon_malloc(len * sizeof(float));
+    uint8_t* flags = (uint8_t*)neon_malloc(len);
+
+    for (size_t i = 0; i < len; i++) {
+        in[i] = (int32_t)(i % 11) - 3;
+        fin[i] = (float)((int)(i % 7) - 2);
+        // Runs of flags, isolated flags and long segments spanning vectors
+        flags[i] = (uint8_t)((i % 13 == 0 || (i > 40 && i < 44) || i % 29 == 5) ? (i % 2 ? 1 : 7) : 0);
+    }
+    flags[1] = 1;
+
+    for (int k = 0; k < 2; k++) {
+        simd_scan_kind_t kind = (simd_scan_kind_t)k;
+        simd_segmented_scan_s32(in, flags, out, len, kind);
+        simd_segmented_scan_f32(fin, flags, fout, len, kind);
+
+        bool passed = true;
+        int32_t run = 0;
+        float frun = 0.0f;
+        for (size_t i = 0; i < len; i++) {
+            if (flags[i]) {
+                run = 0;
+                frun = 0.0f;
+            }
+            if (out[i] != (kind == SIMD_SCAN_INCLUSIVE ? run + in[i] : run)) passed = false;
+            if (fout[i] != (kind == SIMD_SCAN_INCLUSIVE ? frun + fin[i] : frun)) passed = false;
+            run += in[i];
+            frun += fin[i];
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "Segmented Scan - %s", kind_names[k]);
+        test_suite_add_result(suite, name, passed, passed ? "Segments restart correctly" : "Mismatch");
+    }
+
+    free(in);
+    free(out);
+    free(fin);
+    free(fout);
+    free(flags);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for scan operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Scan Operations");
+
+    // Run tests
+    test_scan_integer(suite);
+    test_scan_float(suite);
+    test_scan_parallel(suite);
+    test_segmented_scan(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
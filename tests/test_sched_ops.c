@@ -0,0 +1,336 @@
+/**
+ * test_sched_ops.c
+ * Unit tests for the work-stealing scheduler, its parallel loops and the
+ * CPU topology reader
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/simd_sched.h"
+#include "../include/simd_parallel.h"
+#include "../include/test_framework.h"
+
+/**
+ * Fake sysfs Trees
+ */
+
+static void write_file(const char* root, const char* name, const char* text) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+
+    // Create the parent directories
+    for (char* p = path + strlen(root) + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(path, 0755);
+            *p = '/';
+        }
+    }
+    FILE* f = fopen(path, "w");
+    if (f) {
+        fputs(text, f);
+        fclose(f);
+    }
+}
+
+static void remove_tree(const char* root) {
+    char cmd[300];
+    snprintf(cmd, sizeof(cmd), "rm -rf '%s'", root);
+    if (system(cmd) != 0) printf("Could not remove %s\n", root);
+}
+
+// Test big.LITTLE detection from cpu_capacity and cpufreq, and fallbacks
+void test_topology(test_suite_t* suite) {
+    char root[] = "/tmp/test_sched_XXXXXX";
+    bool passed = mkdtemp(root) != NULL;
+
+    // Four little cores, a gap in the online list, one big core
+    write_file(root, "online", "0-3,6\n");
+    for (int i = 0; i < 4; i++) {
+        char name[64];
+        snprintf(name, sizeof(name), "cpu%d/cpu_capacity", i);
+        write_file(root, name, "446\n");
+    }
+    write_file(root, "cpu6/cpu_capacity", "1024\n");
+
+    simd_cpu_t cpus[16];
+    int n = simd_cpu_topology(root, cpus, 16);
+    passed = passed && n == 5 && cpus[4].id == 6 && cpus[4].big && cpus[4].capacity == 1024;
+    for (int i = 0; passed && i < 4; i++) passed = cpus[i].id == i && !cpus[i].big && cpus[i].capacity == 446;
+
+    // MAX caps the count
+    passed = passed && simd_cpu_topology(root, cpus, 2) == 2 && cpus[1].id == 1;
+    test_suite_add_result(suite, "Sched - Topology Capacity", passed, passed ? "4 little + 1 big" : "Wrong cores");
+    remove_tree(root);
+
+    // Frequencies only, three clusters: mid and big cores count as big
+    passed = mkdtemp(strcpy(root, "/tmp/test_sched_XXXXXX")) != NULL;
+    write_file(root, "online", "0-5\n");
+    static const char* freqs[] = { "1800000", "1800000", "2600000", "2600000", "3000000", "3000000" };
+    for (int i = 0; i < 6; i++) {
+        char name[64];
+        snprintf(name, sizeof(name), "cpu%d/cpufreq/cpuinfo_max_freq", i);
+        write_file(root, name, freqs[i]);
+    }
+    n = simd_cpu_topology(root, cpus, 16);
+    passed = passed && n == 6 && !cpus[0].big && !cpus[1].big && cpus[2].big && cpus[5].big &&
+             cpus[5].capacity == 3000000;
+    remove_tree(root);
+
+    // Nothing but the online list: homogeneous, all big
+    passed = passed && mkdtemp(strcpy(root, "/tmp/test_sched_XXXXXX")) != NULL;
+    write_file(root, "online", "0\n");
+    n = simd_cpu_topology(root, cpus, 16);
+    passed = passed && n == 1 && cpus[0].big && cpus[0].capacity == 1024;
+    remove_tree(root);
+    passed = passed && simd_cpu_topology(root, cpus, 16) == 0;
+    test_suite_add_result(suite, "Sched - Topology Fallbacks", passed,
+                          passed ? "cpufreq, homogeneous, missing" : "Wrong cores");
+}
+
+/**
+ * Parallel Loops
+ */
+
+typedef struct {
+    atomic_int* hits;
+    size_t begin;
+} hits_ctx_t;
+
+static void count_hits(void* ctx, size_t begin, size_t end) {
+    hits_ctx_t* h = (hits_ctx_t*)ctx;
+    for (size_t i = begin; i < end; i++) atomic_fetch_add(&h->hits[i - h->begin], 1);
+}
+
+static bool check_for(size_t begin, size_t end, size_t grain) {
+    size_t n = end - begin;
+    atomic_int* hits = (atomic_int*)calloc(n ? n : 1, sizeof(atomic_int));
+    hits_ctx_t h = { hits, begin };
+    simd_parallel_for(begin, end, grain, count_hits, &h);
+    bool ok = true;
+    for (size_t i = 0; i < n; i++) ok &= atomic_load(&hits[i]) == 1;
+    free(hits);
+    return ok;
+}
+
+// Test every index runs exactly once for various ranges and grains
+void test_parallel_for(test_suite_t* suite) {
+    static const size_t ranges[][2] = { { 0, 1 }, { 5, 1000 }, { 0, 100000 }, { 1000, 1001 }, { 7, 7 } };
+    static const size_t grains[] = { 0, 1, 7, 1000, 1 << 20 };
+    bool passed = true;
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+            passed &= check_for(ranges[r][0], ranges[r][1], grains[g]);
+        }
+    }
+    test_suite_add_result(suite, "Sched - Parallel For", passed, passed ? "Each index once" : "Index missed or repeated");
+}
+
+typedef struct {
+    atomic_int* hits;
+    size_t cols;
+} grid_ctx_t;
+
+static void grid_row(void* ctx, size_t begin, size_t end) {
+    grid_ctx_t* g = (grid_ctx_t*)ctx;
+    for (size_t y = begin; y < end; y++) {
+        hits_ctx_t h = { g->hits + y * g->cols, 0 };
+        simd_parallel_for(0, g->cols, 3, count_hits, &h);
+    }
+}
+
+// Test nested loops: rows in parallel, each row's columns in parallel
+void test_parallel_nested(test_suite_t* suite) {
+    const size_t rows = 97, cols = 211;
+    atomic_int* hits = (atomic_int*)calloc(rows * cols, sizeof(atomic_int));
+    grid_ctx_t g = { hits, cols };
+    simd_parallel_for(0, rows, 1, grid_row, &g);
+    bool passed = true;
+    for (size_t i = 0; i < rows * cols; i++) passed &= atomic_load(&hits[i]) == 1;
+    free(hits);
+    test_suite_add_result(suite, "Sched - Nested For", passed, passed ? "97 x 211 grid" : "Cell missed or repeated");
+}
+
+// Sum and contiguity check: each partial covers [first, last)
+typedef struct {
+    uint64_t sum;
+    size_t first;
+    size_t last;
+    bool ordered;
+} span_acc_t;
+
+static void span_reduce(void* ctx, size_t begin, size_t end, void* acc) {
+    (void)ctx;
+    span_acc_t* a = (span_acc_t*)acc;
+    if (a->last == SIZE_MAX) a->first = begin;
+    else if (a->last != begin) a->ordered = false;
+    a->last = end;
+    for (size_t i = begin; i < end; i++) a->sum += i;
+}
+
+static void span_combine(void* ctx, void* acc, const void* other) {
+    (void)ctx;
+    span_acc_t* a = (span_acc_t*)acc;
+    const span_acc_t* b = (const span_acc_t*)other;
+    if (b->last == SIZE_MAX) return;
+    if (a->last == SIZE_MAX) {
+        *a = *b;
+        return;
+    }
+    a->ordered = a->ordered && b->ordered && a->last == b->first;
+    a->last = b->last;
+    a->sum += b->sum;
+}
+
+// Test reductions are complete and combined in index order
+void test_parallel_reduce(test_suite_t* suite) {
+    static const size_t sizes[] = { 1, 10, 1000, 123457 };
+    static const size_t grains[] = { 0, 1, 64 };
+    bool passed = true;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+            size_t n = sizes[s];
+            span_acc_t acc = { 0, 0, SIZE_MAX, true };
+            simd_parallel_reduce(0, n, grains[g], &acc, sizeof(acc), span_reduce, span_combine, NULL);
+            passed &= acc.sum == (uint64_t)n * (n - 1) / 2 && acc.ordered && acc.first == 0 && acc.last == n;
+        }
+    }
+    test_suite_add_result(suite, "Sched - Parallel Reduce", passed,
+                          passed ? "Complete, in index order" : "Wrong sum or order");
+}
+
+typedef struct {
+    int n;
+    long result;
+} fib_t;
+
+static void fib_task(void* arg) {
+    fib_t* f = (fib_t*)arg;
+    if (f->n < 2) {
+        f->result = f->n;
+        return;
+    }
+    fib_t a = { f->n - 1, 0 }, b = { f->n - 2, 0 };
+    simd_parallel_invoke(fib_task, &a, fib_task, &b);
+    f->result = a.result + b.result;
+}
+
+// Test deep fork-join recursion and the spawn counters
+void test_parallel_invoke(test_suite_t* suite) {
+    simd_sched_reset_stats();
+    fib_t f = { 22, 0 };
+    fib_task(&f);
+    simd_sched_stats_t stats;
+    simd_sched_get_stats(&stats);
+    bool passed = f.result == 17711 && stats.spawned + stats.inline_runs > 0 && stats.stolen <= stats.spawned;
+    test_suite_add_result(suite, "Sched - Invoke", passed, passed ? "fib(22) = 17711" : "Wrong result or counters");
+}
+
+static void* external_caller(void* arg) {
+    bool* ok = (bool*)arg;
+    *ok = true;
+    for (int i = 0; i < 20 && *ok; i++) *ok = check_for(0, 5000 + (size_t)i, 0);
+    return NULL;
+}
+
+// Test concurrent callers, more of them than there are external slots
+void test_external_callers(test_suite_t* suite) {
+    enum { CALLERS = SIMD_SCHED_EXTERNAL_SLOTS + 4 };
+    pthread_t threads[CALLERS];
+    bool ok[CALLERS];
+    bool passed = true;
+    for (int i = 0; i < CALLERS; i++) passed &= pthread_create(&threads[i], NULL, external_caller, &ok[i]) == 0;
+    for (int i = 0; passed && i < CALLERS; i++) pthread_join(threads[i], NULL);
+    for (int i = 0; passed && i < CALLERS; i++) passed = ok[i];
+    test_suite_add_result(suite, "Sched - Concurrent Callers", passed,
+                          passed ? "12 threads, 8 external slots" : "Loop results wrong");
+}
+
+// Test band partitions keep their exact boundaries
+typedef struct {
+    int rows;
+    int bands;
+    atomic_int seen[SIMD_PARALLEL_MAX_THREADS];
+    atomic_bool ok;
+} band_check_t;
+
+static void check_band(void* ctx, int band, int y0, int y1) {
+    band_check_t* c = (band_check_t*)ctx;
+    if (y0 != simd_parallel_band_start(c->rows, c->bands, band) ||
+        y1 != simd_parallel_band_start(c->rows, c->bands, band + 1)) atomic_store(&c->ok, false);
+    atomic_fetch_add(&c->seen[band], 1);
+}
+
+void test_bands(test_suite_t* suite) {
+    bool passed = true;
+    static const int cases[][2] = { { 1, 4 }, { 100, 1 }, { 100, 7 }, { 1080, 0 }, { 5, 64 } };
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        band_check_t c;
+        memset(&c, 0, sizeof(c));
+        c.rows = cases[k][0];
+        c.bands = simd_parallel_band_count(c.rows, cases[k][1]);
+        atomic_init(&c.ok, true);
+        passed &= simd_parallel_bands(c.rows, cases[k][1], check_band, &c) == c.bands && atomic_load(&c.ok);
+        for (int b = 0; b < c.bands; b++) passed &= atomic_load(&c.seen[b]) == 1;
+    }
+    test_suite_add_result(suite, "Sched - Bands", passed, passed ? "Fixed boundaries, each band once" : "Wrong bands");
+}
+
+// Test restarting the pool with explicit sizes and affinity policies
+void test_init(test_suite_t* suite) {
+    char root[] = "/tmp/test_sched_XXXXXX";
+    bool passed = mkdtemp(root) != NULL;
+    write_file(root, "online", "0-1\n");
+    write_file(root, "cpu0/cpu_capacity", "512\n");
+    write_file(root, "cpu1/cpu_capacity", "1024\n");
+
+    static const simd_affinity_t policies[] = { SIMD_AFFINITY_NONE, SIMD_AFFINITY_SPREAD, SIMD_AFFINITY_BIG,
+                                                SIMD_AFFINITY_LITTLE };
+    for (int p = 0; p < 4; p++) {
+        simd_sched_config_t config = { 3, policies[p], root, NULL };
+        passed &= simd_sched_init(&config) && simd_sched_workers() == 3 && check_for(0, 20000, 0);
+    }
+    remove_tree(root);
+
+    // Shutdown, then lazy restart with the defaults on the next loop
+    simd_sched_shutdown();
+    passed &= check_for(0, 20000, 0) && simd_sched_workers() >= 0 && simd_sched_slot() == -1;
+
+    simd_sched_config_t none = { 0, SIMD_AFFINITY_NONE, NULL, NULL };
+    passed &= simd_sched_init(&none) && simd_sched_workers() == simd_parallel_cpu_count() - 1;
+    test_suite_add_result(suite, "Sched - Init Policies", passed, passed ? "Restart with 4 policies" : "Init failed");
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for the work-stealing scheduler...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Work-Stealing Scheduler");
+
+    // Run tests
+    test_topology(suite);
+    test_parallel_for(suite);
+    test_parallel_nested(suite);
+    test_parallel_reduce(suite);
+    test_parallel_invoke(suite);
+    test_external_callers(suite);
+    test_bands(suite);
+    test_init(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+    simd_sched_shutdown();
+
+    return failed ? 1 : 0;
+}
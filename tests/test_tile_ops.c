@@ -0,0 +1,174 @@
+/**
+ * test_tile_ops.c
+ * Unit tests for the tiled stencil executor
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_tile.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+static const simd_border_t borders[] = { SIMD_BORDER_REPLICATE, SIMD_BORDER_REFLECT,
+                                         SIMD_BORDER_CONSTANT, SIMD_BORDER_WRAP };
+
+// Source pixel with border extension (CONSTANT gives the border value)
+static int ref_pixel(const uint8_t* src, int width, int height, int x, int y, simd_border_t border, uint8_t value) {
+    int sx = simd_border_index(x, width, border);
+    int sy = simd_border_index(y, height, border);
+    if (sx < 0 || sy < 0) return value;
+    return src[sy * width + sx];
+}
+
+static void ref_box3x3(const uint8_t* src, uint8_t* dst, int width, int height, simd_border_t border, uint8_t value) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int sum = 0;
+            for (int j = -1; j <= 1; j++) {
+                for (int i = -1; i <= 1; i++) sum += ref_pixel(src, width, height, x + i, y + j, border, value);
+            }
+            dst[y * width + x] = (uint8_t)((2 * sum + 9) / 18);
+        }
+    }
+}
+
+static void ref_sobel(const uint8_t* src, uint8_t* dst, int width, int height, simd_border_t border, uint8_t value) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int p[3][3];
+            for (int j = 0; j < 3; j++) {
+                for (int i = 0; i < 3; i++) p[j][i] = ref_pixel(src, width, height, x + i - 1, y + j - 1, border, value);
+            }
+            int gx = (p[0][2] + 2 * p[1][2] + p[2][2]) - (p[0][0] + 2 * p[1][0] + p[2][0]);
+            int gy = (p[2][0] + 2 * p[2][1] + p[2][2]) - (p[0][0] + 2 * p[0][1] + p[0][2]);
+            int v = (abs(gx) + abs(gy)) / 2;
+            dst[y * width + x] = (uint8_t)(v > 255 ? 255 : v);
+        }
+    }
+}
+
+static void fill_image(uint8_t* img, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        img[i] = (uint8_t)((i * 2654435761u) >> 24);
+    }
+}
+
+// Test the stencil kernels for every border mode, tile size and thread count
+void test_tile_stencils(test_suite_t* suite) {
+    static const int shapes[][2] = { { 67, 45 }, { 16, 16 }, { 3, 2 }, { 130, 9 } };
+    static const int tiles[][2] = { { 0, 0 }, { 16, 8 }, { 5, 3 }, { 1, 1 }, { 64, 64 } };
+    static const int threads[] = { 1, 3, 0 };
+    bool box_ok = true, sobel_ok = true;
+
+    for (int s = 0; s < 4; s++) {
+        int w = shapes[s][0], h = shapes[s][1];
+        uint8_t* src = (uint8_t*)neon_malloc(w * h);
+        uint8_t* out = (uint8_t*)neon_malloc(w * h);
+        uint8_t* ref = (uint8_t*)neon_malloc(w * h);
+        fill_image(src, w * h);
+
+        for (int b = 0; b < 4; b++) {
+            simd_tiling_t tiling = { .halo = 1, .border = borders[b], .border_value = 77 };
+            for (int t = 0; t < 5; t++) {
+                tiling.tile_width = tiles[t][0];
+                tiling.tile_height = tiles[t][1];
+                tiling.threads = threads[t % 3];
+
+                ref_box3x3(src, ref, w, h, borders[b], 77);
+                if (simd_tile_run(src, out, w, h, &tiling, simd_tile_box3x3_u8, NULL) == 0 ||
+                    memcmp(out, ref, w * h) != 0) {
+                    box_ok = false;
+                    printf("  Box mismatch: %dx%d, border %d, tile %dx%d\n", w, h, b, tiles[t][0], tiles[t][1]);
+                }
+
+                ref_sobel(src, ref, w, h, borders[b], 77);
+                if (simd_tile_run(src, out, w, h, &tiling, simd_tile_sobel_u8, NULL) == 0 ||
+                    memcmp(out, ref, w * h) != 0) {
+                    sobel_ok = false;
+                    printf("  Sobel mismatch: %dx%d, border %d, tile %dx%d\n", w, h, b, tiles[t][0], tiles[t][1]);
+                }
+            }
+        }
+
+        free(src);
+        free(out);
+        free(ref);
+    }
+
+    test_suite_add_result(suite, "Tile - Box 3x3", box_ok, box_ok ? "All borders, tiles and threads" : "Mismatch");
+    test_suite_add_result(suite, "Tile - Sobel", sobel_ok, sobel_ok ? "All borders, tiles and threads" : "Mismatch");
+}
+
+// Copies the pixel `halo` up and left of each output (4-byte pixels)
+static void halo_probe(void* ctx, const simd_tile_t* t) {
+    (void)ctx;
+    for (int y = 0; y < t->height; y++) {
+        const uint8_t* row = t->src + (ptrdiff_t)(y - t->halo) * (ptrdiff_t)t->src_stride;
+        for (int x = 0; x < t->width; x++) {
+            memcpy(t->dst + (size_t)y * t->dst_stride + (size_t)x * 4, row + (ptrdiff_t)(x - t->halo) * 4, 4);
+        }
+    }
+}
+
+// Test halo filling for multi-byte pixels and wide halos
+void test_tile_halo(test_suite_t* suite) {
+    const int w = 23, h = 17;
+    uint8_t* src = (uint8_t*)neon_malloc(w * h * 4);
+    uint8_t* out = (uint8_t*)neon_malloc(w * h * 4);
+    fill_image(src, w * h * 4);
+
+    bool passed = true;
+    static const int halos[] = { 1, 3, 9 };
+    for (int b = 0; b < 4; b++) {
+        for (int k = 0; k < 3; k++) {
+            int halo = halos[k];
+            simd_tiling_t tiling = { .pixel_size = 4, .halo = halo, .border = borders[b], .border_value = 5,
+                                     .tile_width = 6, .tile_height = 4, .threads = 2 };
+            simd_tile_run(src, out, w, h, &tiling, halo_probe, NULL);
+            for (int y = 0; y < h; y++) {
+                for (int x = 0; x < w; x++) {
+                    int sx = simd_border_index(x - halo, w, borders[b]);
+                    int sy = simd_border_index(y - halo, h, borders[b]);
+                    for (int c = 0; c < 4; c++) {
+                        int expected = (sx < 0 || sy < 0) ? 5 : src[(sy * w + sx) * 4 + c];
+                        if (out[(y * w + x) * 4 + c] != expected) passed = false;
+                    }
+                }
+            }
+        }
+    }
+    test_suite_add_result(suite, "Tile - Halo Extension", passed, passed ? "4-byte pixels, halo 1..9" : "Mismatch");
+
+    // Invalid arguments run nothing
+    simd_tiling_t bad = { .halo = SIMD_TILE_MAX_HALO + 1 };
+    passed = simd_tile_run(src, out, w, h, &bad, halo_probe, NULL) == 0;
+    bad.halo = 1;
+    passed = passed && simd_tile_run(src, out, 0, h, &bad, halo_probe, NULL) == 0;
+    passed = passed && simd_tile_run(src, out, w, h, &bad, NULL, NULL) == 0;
+    test_suite_add_result(suite, "Tile - Invalid Arguments", passed, passed ? "Rejected" : "Accepted");
+
+    free(src);
+    free(out);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for tiled execution...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Tiled Execution");
+
+    // Run tests
+    test_tile_stencils(suite);
+    test_tile_halo(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}
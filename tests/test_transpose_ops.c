@@ -0,0 +1,180 @@
+/**
+ * test_transpose_ops.c
+ * Unit tests for matrix transpose kernels
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/simd_transpose.h"
+#include "../include/neon_utils.h"
+#include "../include/test_framework.h"
+
+// Shapes covering square, tall, wide, tile-crossing and non-multiple-of-block sizes
+static const size_t shapes[][2] = {
+    { 1, 1 }, { 4, 4 }, { 3, 7 }, { 16, 16 }, { 17, 33 }, { 64, 1 },
+    { 130, 67 }, { 200, 300 }, { 255, 129 }
+};
+#define SHAPE_COUNT (sizeof(shapes) / sizeof(shapes[0]))
+
+// Test out-of-place transpose for float
+void test_transpose_f32(test_suite_t* suite) {
+    bool passed = true;
+
+    for (size_t s = 0; s < SHAPE_COUNT && passed; s++) {
+        size_t rows = shapes[s][0];
+        size_t cols = shapes[s][1];
+        float* src = (float*)neon_malloc(rows * cols * sizeof(float));
+        float* dst = (float*)neon_malloc(rows * cols * sizeof(float));
+
+        for (size_t i = 0; i < rows * cols; i++) src[i] = (float)i;
+        simd_transpose_f32(src, dst, rows, cols);
+
+        for (size_t r = 0; r < rows && passed; r++) {
+            for (size_t c = 0; c < cols; c++) {
+                if (dst[c * rows + r] != src[r * cols + c]) {
+                    printf("  f32 %zux%zu mismatch at (%zu, %zu)\n", rows, cols, r, c);
+                    passed = false;
+                    break;
+                }
+            }
+        }
+
+        free(src);
+        free(dst);
+    }
+
+    test_suite_add_result(suite, "Transpose F32", passed,
+                          passed ? "All shapes match" : "Element mismatch");
+}
+
+// Test out-of-place transpose for uint16 and uint8
+void test_transpose_integer(test_suite_t* suite) {
+    bool passed16 = true;
+    bool passed8 = true;
+
+    for (size_t s = 0; s < SHAPE_COUNT; s++) {
+        size_t rows = shapes[s][0];
+        size_t cols = shapes[s][1];
+        uint16_t* src16 = (uint16_t*)neon_malloc(rows * cols * sizeof(uint16_t));
+        uint16_t* dst16 = (uint16_t*)neon_malloc(rows * cols * sizeof(uint16_t));
+        uint8_t* src8 = (uint8_t*)neon_malloc(rows * cols);
+        uint8_t* dst8 = (uint8_t*)neon_malloc(rows * cols);
+
+        for (size_t i = 0; i < rows * cols; i++) {
+            src16[i] = (uint16_t)(i * 7);
+            src8[i] = (uint8_t)(i * 13 + i / 256);
+        }
+        simd_transpose_u16(src16, dst16, rows, cols);
+        simd_transpose_u8(src8, dst8, rows, cols);
+
+        for (size_t r = 0; r < rows; r++) {
+            for (size_t c = 0; c < cols; c++) {
+                if (dst16[c * rows + r] != src16[r * cols + c]) passed16 = false;
+                if (dst8[c * rows + r] != src8[r * cols + c]) passed8 = false;
+            }
+        }
+
+        free(src16);
+        free(dst16);
+        free(src8);
+        free(dst8);
+    }
+
+    test_suite_add_result(suite, "Transpose U16", passed16,
+                          passed16 ? "All shapes match" : "Element mismatch");
+    test_suite_add_result(suite, "Transpose U8", passed8,
+                          passed8 ? "All shapes match" : "Element mismatch");
+}
+
+// Test in-place square transpose against the out-of-place result
+void test_transpose_inplace(test_suite_t* suite) {
+    static const size_t sizes[] = { 1, 5, 16, 35, 64, 150, 259 };
+    bool passed_f32 = true;
+    bool passed_u16 = true;
+    bool passed_u8 = true;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        float* f = (float*)neon_malloc(n * n * sizeof(float));
+        float* f_ref = (float*)neon_malloc(n * n * sizeof(float));
+        uint16_t* h = (uint16_t*)neon_malloc(n * n * sizeof(uint16_t));
+        uint16_t* h_ref = (uint16_t*)neon_malloc(n * n * sizeof(uint16_t));
+        uint8_t* b = (uint8_t*)neon_malloc(n * n);
+        uint8_t* b_ref = (uint8_t*)neon_malloc(n * n);
+
+        for (size_t i = 0; i < n * n; i++) {
+            f[i] = (float)i * 0.5f;
+            h[i] = (uint16_t)(i * 3);
+            b[i] = (uint8_t)(i * 11 + i / 256);
+        }
+        simd_transpose_f32(f, f_ref, n, n);
+        simd_transpose_u16(h, h_ref, n, n);
+        simd_transpose_u8(b, b_ref, n, n);
+
+        simd_transpose_inplace_f32(f, n);
+        simd_transpose_inplace_u16(h, n);
+        simd_transpose_inplace_u8(b, n);
+
+        if (memcmp(f, f_ref, n * n * sizeof(float)) != 0) passed_f32 = false;
+        if (memcmp(h, h_ref, n * n * sizeof(uint16_t)) != 0) passed_u16 = false;
+        if (memcmp(b, b_ref, n * n) != 0) passed_u8 = false;
+
+        free(f);
+        free(f_ref);
+        free(h);
+        free(h_ref);
+        free(b);
+        free(b_ref);
+    }
+
+    test_suite_add_result(suite, "Transpose In-place F32", passed_f32,
+                          passed_f32 ? "Matches out-of-place" : "Mismatch");
+    test_suite_add_result(suite, "Transpose In-place U16", passed_u16,
+                          passed_u16 ? "Matches out-of-place" : "Mismatch");
+    test_suite_add_result(suite, "Transpose In-place U8", passed_u8,
+                          passed_u8 ? "Matches out-of-place" : "Mismatch");
+}
+
+// Test that transposing twice restores the original matrix
+void test_transpose_round_trip(test_suite_t* suite) {
+    const size_t rows = 97;
+    const size_t cols = 45;
+
+    float* a = (float*)neon_malloc(rows * cols * sizeof(float));
+    float* t = (float*)neon_malloc(rows * cols * sizeof(float));
+    float* back = (float*)neon_malloc(rows * cols * sizeof(float));
+
+    for (size_t i = 0; i < rows * cols; i++) a[i] = (float)(i % 1000) - 500.0f;
+
+    simd_transpose_f32(a, t, rows, cols);
+    simd_transpose_f32(t, back, cols, rows);
+    ASSERT_FLOAT_ARRAY_EQ(suite, "Transpose Round Trip", back, a, (int)(rows * cols), 0.0f);
+
+    free(a);
+    free(t);
+    free(back);
+}
+
+// Main test function
+int main() {
+    printf("Running unit tests for transpose operations...\n");
+
+    // Create test suite
+    test_suite_t* suite = test_suite_create("Transpose Operations");
+
+    // Run tests
+    test_transpose_f32(suite);
+    test_transpose_integer(suite);
+    test_transpose_inplace(suite);
+    test_transpose_round_trip(suite);
+
+    // Print results
+    test_suite_print_results(suite);
+
+    // Clean up
+    int failed = suite->failed;
+    test_suite_destroy(suite);
+
+    return failed ? 1 : 0;
+}